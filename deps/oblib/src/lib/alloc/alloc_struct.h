@@ -163,6 +163,12 @@ struct AChunk {
     struct {
       struct {
         uint8_t is_hugetlb_ : 1;
+        // advised with MADV_HUGEPAGE
+        uint8_t is_thp_ : 1;
+        // page type decided by the huge page policy of its ctx, never cached in the free list
+        uint8_t is_ctx_huge_page_ : 1;
+        // mbind to the numa node of its tenant, reset before it is cached in the free list
+        uint8_t is_numa_bound_ : 1;
       };
     };
   };
@@ -228,6 +234,9 @@ struct AObject {
   uint16_t obj_offset_;
 
   uint32_t alloc_bytes_;
+  // alloc_bytes_ accounted by the ObjectSet, differs only for an object
+  // reused from the object cache of ObjectMgr
+  uint32_t set_alloc_bytes_;
   uint64_t tenant_id_;
   char label_[AOBJECT_LABEL_SIZE + 1];
 
@@ -460,7 +469,7 @@ char *ABlock::data() const
 AObject::AObject()
     : MAGIC_CODE_(FREE_AOBJECT_MAGIC_CODE),
       nobjs_(0), nobjs_prev_(0), obj_offset_(0),
-      alloc_bytes_(0), tenant_id_(0)
+      alloc_bytes_(0), set_alloc_bytes_(0), tenant_id_(0)
 {
 }
 
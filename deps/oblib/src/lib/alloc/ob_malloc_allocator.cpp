@@ -622,6 +622,18 @@ int64_t ObMallocAllocator::sync_wash()
   return washed_size;
 }
 
+void ObMallocAllocator::flush_object_cache(const int64_t idle_us)
+{
+  for (uint64_t tenant_id = 1; tenant_id <= max_used_tenant_id_; ++tenant_id) {
+    for (int64_t ctx_id = 0; ctx_id < ObCtxIds::MAX_CTX_ID; ctx_id++) {
+      auto allocator = get_tenant_ctx_allocator(tenant_id, ctx_id);
+      if (NULL != allocator) {
+        static_cast<ObjectMgr&>(allocator->get_block_mgr()).flush_object_cache(idle_us);
+      }
+    }
+  }
+}
+
 ObTenantCtxAllocatorGuard ObMallocAllocator::get_tenant_ctx_allocator_unrecycled(
   uint64_t tenant_id, uint64_t ctx_id) const
 {
@@ -136,6 +136,9 @@ public:
   int get_chunks(AChunk** chunks, int cap, int& cnt);
   int64_t sync_wash(uint64_t tenant_id, uint64_t from_ctx_id, int64_t wash_size);
   int64_t sync_wash();
+  // return the objects cached by the ObjectMgr of every tenant ctx to their sets,
+  // see ObjectMgr::flush_object_cache
+  void flush_object_cache(const int64_t idle_us = 0);
   int recycle_tenant_allocator(uint64_t tenant_id);
   int64_t get_max_used_tenant_id() { return max_used_tenant_id_; }
   void make_allocator_create_on_demand() { create_on_demand_ = true; }
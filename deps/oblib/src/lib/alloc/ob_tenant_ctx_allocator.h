@@ -128,6 +128,17 @@ public:
     return hold;
   }
 
+  int64_t get_huge_page_hold() const
+  {
+    int64_t hold = 0;
+    uint64_t ctx_id = ctx_id_;
+    with_resource_handle_invoke([&ctx_id, &hold](const ObTenantMemoryMgr *mgr) {
+      mgr->get_ctx_huge_page_hold(ctx_id, hold);
+      return common::OB_SUCCESS;
+    });
+    return hold;
+  }
+
   int64_t get_used() const;
 
   int64_t get_tenant_limit() const
@@ -13,10 +13,14 @@
 #include "object_mgr.h"
 #include "lib/alloc/ob_malloc_allocator.h"
 #include "lib/alloc/memory_sanity.h"
+#include "lib/utility/utility.h"
+#include "lib/time/ob_time_utility.h"
 
 using namespace oceanbase;
 using namespace lib;
 
+bool ObjectMgr::enable_object_cache_ = false;
+
 SubObjectMgr::SubObjectMgr(const bool for_logger, const int64_t tenant_id, const int64_t ctx_id)
   : IBlockMgr(tenant_id, ctx_id), mutex_(common::ObLatchIds::ALLOC_OBJECT_LOCK),
     normal_locker_(mutex_), logger_locker_(mutex_),
@@ -63,11 +67,18 @@ ObjectMgr::ObjectMgr(ObTenantCtxAllocator &allocator, uint64_t tenant_id, uint64
   : IBlockMgr(tenant_id, ctx_id), ta_(allocator),
     sub_cnt_(1),
     root_mgr_(common::ObCtxIds::LOGGER_CTX_ID == ctx_id, tenant_id, ctx_id),
-    last_wash_ts_(0), last_washed_size_(0)
+    last_wash_ts_(0), last_washed_size_(0), cacheable_(false)
 {
   root_mgr_.set_tenant_ctx_allocator(allocator);
   MEMSET(sub_mgrs_, 0, sizeof(sub_mgrs_));
   sub_mgrs_[0] = &root_mgr_;
+  MEMSET(caches_, 0, sizeof(caches_));
+#ifndef ENABLE_SANITY
+  // the sets of these ctx have their own locking
+  cacheable_ = common::ObCtxIds::LOGGER_CTX_ID != ctx_id
+      && common::ObCtxIds::LIBEASY != ctx_id
+      && common::ObCtxIds::CO_STACK != ctx_id;
+#endif
 }
 
 ObjectMgr::~ObjectMgr()
@@ -76,6 +87,13 @@ ObjectMgr::~ObjectMgr()
 }
 
 void ObjectMgr::reset() {
+  flush_object_cache();
+  for (int i = 0; i < CACHE_SHARD_CNT; i++) {
+    if (caches_[i] != nullptr) {
+      destroy_object_cache(caches_[i]);
+      ATOMIC_STORE(&caches_[i], nullptr);
+    }
+  }
   for (int i = 1; i < ATOMIC_LOAD(&sub_cnt_); i++) {
     if (sub_mgrs_[i] != nullptr) {
       destroy_sub_mgr(sub_mgrs_[i]);
@@ -87,7 +105,7 @@ void ObjectMgr::reset() {
 
 AObject *ObjectMgr::alloc_object(uint64_t size, const ObMemAttr &attr)
 {
-  AObject *obj = NULL;
+  AObject *obj = use_object_cache() ? alloc_from_cache(size, attr) : NULL;
   const uint64_t start = common::get_itid();
   SubObjectMgr *sub_mgr = nullptr;
   for (uint64_t i = 0; NULL == obj && i < ATOMIC_LOAD(&sub_cnt_); i++) {
@@ -139,6 +157,11 @@ AObject *ObjectMgr::realloc_object(
 
     ObjectSet *os = block->obj_set_;
     abort_unless(os);
+    // the set frees the object by the bytes it accounted, the copy of a normal
+    // object only depends on its cells
+    if (!obj->is_large_) {
+      restore_set_alloc_bytes(obj);
+    }
     if (os != NULL) {
       os->lock();
       new_obj = os->realloc_object(obj, size, attr);
@@ -158,8 +181,9 @@ void ObjectMgr::free_object(AObject *obj)
   abort_unless(block->in_use_);
   abort_unless(block->obj_set_ != NULL);
 
-  ObjectSet *set = block->obj_set_;
-  set->free_object(obj);
+  if (!use_object_cache() || !free_to_cache(obj)) {
+    free_to_set(obj);
+  }
   // TODO by fengshuo.fs: when object_set is empty, try free the sub_mgr of it.
 }
 
@@ -251,9 +275,182 @@ void ObjectMgr::destroy_sub_mgr(SubObjectMgr *sub_mgr)
   }
 }
 
+
+AObject *ObjectMgr::alloc_from_cache(const uint64_t size, const ObMemAttr &attr)
+{
+  AObject *obj = NULL;
+  const uint64_t all_size = align_up2(MAX(size, MIN_AOBJECT_SIZE) + AOBJECT_META_SIZE, 16);
+  const uint64_t cells = all_size / AOBJECT_CELL_BYTES;
+  ObjectCache *cache = NULL;
+  if (OB_UNLIKELY(0 == size) || cells > ObjectCache::MAX_CELLS) {
+    // do nothing
+  } else if (OB_ISNULL(cache = ATOMIC_LOAD(&caches_[common::get_cpu_id() % CACHE_SHARD_CNT]))) {
+    // do nothing
+  } else if (cache->trylock()) {
+    if (cache->cnts_[cells] > 0) {
+      obj = cache->objs_[cells][--cache->cnts_[cells]];
+    }
+    cache->unlock();
+  }
+  if (NULL != obj) {
+    // the same as ObjectSet::alloc_object except for set_alloc_bytes_
+    reinterpret_cast<uint64_t&>(obj->data_[size]) = AOBJECT_TAIL_MAGIC_CODE;
+    obj->alloc_bytes_ = static_cast<uint32_t>(size);
+    if (attr.label_.str_ != nullptr) {
+      STRNCPY(&obj->label_[0], attr.label_.str_, sizeof(obj->label_));
+      obj->label_[sizeof(obj->label_) - 1] = '\0';
+    } else {
+      obj->label_[0] = '\0';
+    }
+  }
+  return obj;
+}
+
+bool ObjectMgr::free_to_cache(AObject *obj)
+{
+  bool cached = false;
+  const int64_t cells = obj->nobjs_;
+  ObjectCache *cache = NULL;
+  if (obj->is_large_ || cells > ObjectCache::MAX_CELLS) {
+    // do nothing
+  } else if (OB_ISNULL(cache = get_object_cache())) {
+    // do nothing
+  } else if (cache->trylock()) {
+    abort_unless(AOBJECT_TAIL_MAGIC_CODE
+                 == reinterpret_cast<uint64_t&>(obj->data_[obj->alloc_bytes_]));
+    // a cached object is still in use for its set, catch the double free here
+    for (int64_t i = 0; i < cache->cnts_[cells]; i++) {
+      abort_unless(obj != cache->objs_[cells][i]);
+    }
+    if (cache->cnts_[cells] >= ObjectCache::MAGAZINE_SIZE) {
+      // the older half goes back
+      flush_cache_cells(*cache, cells, ObjectCache::MAGAZINE_SIZE / 2);
+    }
+    // a cached object keeps the label it was freed with, so the label stats
+    // still count it to its last user until it is reused or flushed
+    cache->objs_[cells][cache->cnts_[cells]++] = obj;
+    cached = true;
+    if (0 == ++cache->ops_ % ObjectCache::FLUSH_CHECK_OPS) {
+      const int64_t now = common::ObTimeUtility::fast_current_time();
+      if (now - cache->last_flush_ts_ > ObjectCache::FLUSH_INTERVAL_US) {
+        for (int64_t i = 0; i <= ObjectCache::MAX_CELLS; i++) {
+          flush_cache_cells(*cache, i, cache->cnts_[i]);
+        }
+        cache->last_flush_ts_ = now;
+      }
+    }
+    cache->unlock();
+  }
+  return cached;
+}
+
+// return the first %cnt objects of the magazine of %cells, the caller holds the lock
+void ObjectMgr::flush_cache_cells(ObjectCache &cache, const int64_t cells, const int64_t cnt)
+{
+  const int64_t total = cache.cnts_[cells];
+  AObject **objs = cache.objs_[cells];
+  for (int64_t i = 0; i < cnt; i++) {
+    free_to_set(objs[i]);
+  }
+  for (int64_t i = cnt; i < total; i++) {
+    objs[i - cnt] = objs[i];
+  }
+  cache.cnts_[cells] = static_cast<int32_t>(total - cnt);
+}
+
+ObjectMgr::ObjectCache *ObjectMgr::get_object_cache()
+{
+  const uint64_t idx = common::get_cpu_id() % CACHE_SHARD_CNT;
+  ObjectCache *cache = ATOMIC_LOAD(&caches_[idx]);
+  if (OB_ISNULL(cache) && OB_NOT_NULL(cache = create_object_cache())) {
+    if (!ATOMIC_BCAS(&caches_[idx], nullptr, cache)) {
+      destroy_object_cache(cache);
+      cache = ATOMIC_LOAD(&caches_[idx]);
+    }
+  }
+  return cache;
+}
+
+void ObjectMgr::flush_object_cache(const int64_t idle_us)
+{
+  const int64_t now = common::ObTimeUtility::fast_current_time();
+  for (int64_t idx = 0; idx < CACHE_SHARD_CNT; idx++) {
+    ObjectCache *cache = ATOMIC_LOAD(&caches_[idx]);
+    if (OB_ISNULL(cache)) {
+      // do nothing
+    } else if (idle_us > 0 && now - ATOMIC_LOAD(&cache->last_flush_ts_) <= idle_us) {
+      // still flushed by its own frees
+    } else {
+      cache->lock();
+      for (int64_t i = 0; i <= ObjectCache::MAX_CELLS; i++) {
+        flush_cache_cells(*cache, i, cache->cnts_[i]);
+      }
+      cache->last_flush_ts_ = now;
+      cache->unlock();
+    }
+  }
+}
+
+void ObjectMgr::restore_set_alloc_bytes(AObject *obj)
+{
+  if (OB_UNLIKELY(obj->alloc_bytes_ != obj->set_alloc_bytes_)) {
+    // reused from the cache, give the set back what it accounted
+    abort_unless(AOBJECT_TAIL_MAGIC_CODE
+                 == reinterpret_cast<uint64_t&>(obj->data_[obj->alloc_bytes_]));
+    obj->alloc_bytes_ = obj->set_alloc_bytes_;
+    reinterpret_cast<uint64_t&>(obj->data_[obj->alloc_bytes_]) = AOBJECT_TAIL_MAGIC_CODE;
+  }
+}
+
+void ObjectMgr::free_to_set(AObject *obj)
+{
+  restore_set_alloc_bytes(obj);
+  ObjectSet *set = obj->block()->obj_set_;
+  set->free_object(obj);
+}
+
+// from the server tenant, the same as the sub mgrs
+ObjectMgr::ObjectCache *ObjectMgr::create_object_cache()
+{
+  ObjectCache *cache = nullptr;
+  auto ta = ObMallocAllocator::get_instance()->get_tenant_ctx_allocator(OB_SERVER_TENANT_ID,
+                                                                        ObCtxIds::DEFAULT_CTX_ID);
+  if (OB_NOT_NULL(ta.ref_allocator())) {
+    auto &root_mgr = static_cast<ObjectMgr&>(ta->get_block_mgr()).root_mgr_;
+    ObMemAttr attr;
+    attr.tenant_id_ = OB_SERVER_TENANT_ID;
+    attr.label_ = common::ObModIds::OB_TENANT_CTX_ALLOCATOR;
+    attr.ctx_id_ = ObCtxIds::DEFAULT_CTX_ID;
+    root_mgr.lock();
+    auto *obj = root_mgr.alloc_object(sizeof(ObjectCache), attr);
+    root_mgr.unlock();
+    if (OB_NOT_NULL(obj)) {
+      SANITY_UNPOISON(obj->data_, obj->alloc_bytes_);
+      cache = new (obj->data_) ObjectCache();
+    }
+  }
+  return cache;
+}
+
+void ObjectMgr::destroy_object_cache(ObjectCache *cache)
+{
+  if (cache != nullptr) {
+    auto ta = ObMallocAllocator::get_instance()->get_tenant_ctx_allocator(OB_SERVER_TENANT_ID,
+                                                                          ObCtxIds::DEFAULT_CTX_ID);
+    auto &root_mgr = static_cast<ObjectMgr&>(ta->get_block_mgr()).root_mgr_;
+    cache->~ObjectCache();
+    auto *obj = reinterpret_cast<AObject*>((char*)cache - AOBJECT_HEADER_SIZE);
+    abort_unless(obj->MAGIC_CODE_ == AOBJECT_MAGIC_CODE
+                 || obj->MAGIC_CODE_ == BIG_AOBJECT_MAGIC_CODE);
+    SANITY_POISON(obj->data_, obj->alloc_bytes_);
+    root_mgr.free_object(obj);
+  }
+}
+
 int64_t ObjectMgr::sync_wash(int64_t wash_size)
 {
   int64_t washed_size = 0;
+  flush_object_cache();
   const uint64_t start = common::get_itid();
   for (uint64_t i = 0; washed_size < wash_size && i < ATOMIC_LOAD(&sub_cnt_); i++) {
     uint64_t idx = (start + i) % sub_cnt_;
@@ -299,6 +496,7 @@ ObjectMgr::Stat ObjectMgr::get_stat()
 bool ObjectMgr::check_has_unfree(const char **first_label)
 {
   bool has_unfree = false;
+  flush_object_cache();
   for (uint64_t idx = 0; idx < ATOMIC_LOAD(&sub_cnt_) && !has_unfree; idx++) {
     auto sub_mgr = ATOMIC_LOAD(&sub_mgrs_[idx]);
     if (OB_ISNULL(sub_mgr)) {
@@ -76,6 +76,36 @@ private:
 class ObjectMgr : public IBlockMgr
 {
   static const int N = 32;
+public:
+  static const int64_t OBJECT_CACHE_IDLE_US = 1000L * 1000L;
+private:
+  // Per core magazines of the small objects freed recently. A cached object stays
+  // in use for its ObjectSet, so a hit takes neither the lock nor the counters of
+  // the set. Objects go back to their sets when a magazine overflows, once in a
+  // while on free, on wash, and from ObMallocAllocator::flush_object_cache for
+  // the caches nobody frees to any more.
+  struct ObjectCache
+  {
+    static const int MAX_CELLS = 64; // 512 bytes with meta
+    static const int MAGAZINE_SIZE = 8;
+    static const int64_t FLUSH_CHECK_OPS = 1024;
+    static const int64_t FLUSH_INTERVAL_US = OBJECT_CACHE_IDLE_US;
+    ObjectCache() : lock_(0), ops_(0), last_flush_ts_(0)
+    {
+      MEMSET(cnts_, 0, sizeof(cnts_));
+      MEMSET(objs_, 0, sizeof(objs_));
+    }
+    OB_INLINE bool trylock() { return ATOMIC_BCAS(&lock_, 0, 1); }
+    OB_INLINE void lock() { while (!trylock()) { PAUSE(); } }
+    OB_INLINE void unlock() { ATOMIC_STORE(&lock_, 0); }
+    int64_t lock_;
+    int64_t ops_;
+    int64_t last_flush_ts_;
+    // indexed by the cells of the objects
+    int32_t cnts_[MAX_CELLS + 1];
+    AObject *objs_[MAX_CELLS + 1][MAGAZINE_SIZE];
+  };
+  static const int CACHE_SHARD_CNT = 32;
 public:
   struct Stat
   {
@@ -102,9 +132,29 @@ public:
   int64_t sync_wash(int64_t wash_size) override;
   Stat get_stat();
   bool check_has_unfree(const char **first_label);
+  // return the cached objects to their sets, only those of the caches not
+  // flushed for %idle_us if it is positive
+  void flush_object_cache(const int64_t idle_us = 0);
+  static void set_enable_object_cache(const bool enable)
+  {
+    ATOMIC_STORE(&enable_object_cache_, enable);
+  }
+  static bool is_object_cache_enabled() { return ATOMIC_LOAD(&enable_object_cache_); }
 private:
   SubObjectMgr *create_sub_mgr();
   void destroy_sub_mgr(SubObjectMgr *sub_mgr);
+  OB_INLINE bool use_object_cache() const
+  {
+    return OB_LIKELY(ATOMIC_LOAD(&enable_object_cache_)) && cacheable_;
+  }
+  AObject *alloc_from_cache(const uint64_t size, const ObMemAttr &attr);
+  bool free_to_cache(AObject *obj);
+  void flush_cache_cells(ObjectCache &cache, const int64_t cells, const int64_t cnt);
+  ObjectCache *get_object_cache();
+  ObjectCache *create_object_cache();
+  void destroy_object_cache(ObjectCache *cache);
+  static void restore_set_alloc_bytes(AObject *obj);
+  static void free_to_set(AObject *obj);
 
 public:
   ObTenantCtxAllocator &ta_;
@@ -113,6 +163,9 @@ public:
   SubObjectMgr *sub_mgrs_[N];
   int64_t last_wash_ts_;
   int64_t last_washed_size_;
+  bool cacheable_;
+  ObjectCache *caches_[CACHE_SHARD_CNT];
+  static bool enable_object_cache_;
 }; // end of class ObjectMgr
 
 } // end of namespace lib
@@ -86,6 +86,7 @@ AObject *ObjectSet::alloc_object(
 
     reinterpret_cast<uint64_t&>(obj->data_[size]) = AOBJECT_TAIL_MAGIC_CODE;
     obj->alloc_bytes_ = static_cast<uint32_t>(size);
+    obj->set_alloc_bytes_ = obj->alloc_bytes_;
 
     if (attr.label_.str_ != nullptr) {
       STRNCPY(&obj->label_[0], attr.label_.str_, sizeof(obj->label_));
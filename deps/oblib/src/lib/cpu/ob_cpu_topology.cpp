@@ -15,7 +15,11 @@
 #include <stdio.h>
 #include <string.h>
 #include <pthread.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/mempolicy.h>
 #include "lib/ob_define.h"
+#include "lib/oblog/ob_log.h"
 
 using namespace oceanbase::common;
 
@@ -26,6 +30,248 @@ int64_t __attribute__((weak)) get_cpu_count()
 {
   return get_cpu_num();
 }
+
+ObCpuTopology &ObCpuTopology::get_instance()
+{
+  static ObCpuTopology instance;
+  return instance;
+}
+
+ObCpuTopology::ObCpuTopology()
+  : cpu_cnt_(0), socket_cnt_(1), numa_node_cnt_(1)
+{
+  MEMSET(node_load_, 0, sizeof(node_load_));
+  init();
+}
+
+int ObCpuTopology::read_int(const char *path, int64_t &value)
+{
+  int ret = OB_SUCCESS;
+  FILE *file = fopen(path, "r");
+  if (NULL == file) {
+    ret = OB_FILE_NOT_EXIST;
+  } else {
+    if (1 != fscanf(file, "%ld", &value)) {
+      ret = OB_ERR_UNEXPECTED;
+    }
+    fclose(file);
+  }
+  return ret;
+}
+
+// the format is like "0-3,8-11"
+int ObCpuTopology::read_cpu_list(const char *path, cpu_set_t &cpus)
+{
+  int ret = OB_SUCCESS;
+  char buf[4096];
+  FILE *file = fopen(path, "r");
+  CPU_ZERO(&cpus);
+  if (NULL == file) {
+    ret = OB_FILE_NOT_EXIST;
+  } else {
+    if (NULL == fgets(buf, sizeof(buf), file)) {
+      ret = OB_ERR_UNEXPECTED;
+    } else {
+      char *p = buf;
+      while (OB_SUCC(ret) && '\0' != *p && '\n' != *p) {
+        char *end = NULL;
+        const int64_t first = strtol(p, &end, 10);
+        int64_t last = first;
+        if (end == p) {
+          ret = OB_ERR_UNEXPECTED;
+        } else if ('-' == *end) {
+          p = end + 1;
+          last = strtol(p, &end, 10);
+        }
+        for (int64_t cpu = first; OB_SUCC(ret) && cpu <= last && cpu < MAX_CPU_CNT; ++cpu) {
+          CPU_SET(cpu, &cpus);
+        }
+        p = (',' == *end) ? end + 1 : end;
+      }
+    }
+    fclose(file);
+  }
+  return ret;
+}
+
+void ObCpuTopology::init()
+{
+  char path[128];
+  int64_t max_socket = 0;
+  int64_t max_node = 0;
+  bool has_node = false;
+  cpu_cnt_ = get_cpu_num() < MAX_CPU_CNT ? get_cpu_num() : MAX_CPU_CNT;
+  if (0 != sched_getaffinity(0, sizeof(process_cpus_), &process_cpus_)) {
+    CPU_ZERO(&process_cpus_);
+    for (int64_t cpu = 0; cpu < cpu_cnt_; ++cpu) {
+      CPU_SET(cpu, &process_cpus_);
+    }
+  }
+  for (int64_t node = 0; node < MAX_NUMA_NODE_CNT; ++node) {
+    snprintf(path, sizeof(path), "/sys/devices/system/node/node%ld/cpulist", node);
+    if (OB_SUCCESS == read_cpu_list(path, node_cpus_[node]) && CPU_COUNT(&node_cpus_[node]) > 0) {
+      has_node = true;
+      max_node = node;
+    }
+  }
+  if (!has_node) {
+    CPU_ZERO(&node_cpus_[0]);
+    for (int64_t cpu = 0; cpu < cpu_cnt_; ++cpu) {
+      CPU_SET(cpu, &node_cpus_[0]);
+    }
+  }
+  numa_node_cnt_ = max_node + 1;
+  for (int64_t cpu = 0; cpu < cpu_cnt_; ++cpu) {
+    int64_t socket = 0;
+    cpu_set_t siblings;
+    snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%ld/topology/physical_package_id", cpu);
+    if (OB_SUCCESS != read_int(path, socket) || socket < 0) {
+      socket = 0;
+    }
+    socket_[cpu] = static_cast<int16_t>(socket);
+    if (socket > max_socket) {
+      max_socket = socket;
+    }
+    core_[cpu] = static_cast<int16_t>(cpu);
+    snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%ld/topology/thread_siblings_list", cpu);
+    if (OB_SUCCESS == read_cpu_list(path, siblings)) {
+      for (int64_t i = 0; i < cpu; ++i) {
+        if (CPU_ISSET(i, &siblings)) {
+          core_[cpu] = static_cast<int16_t>(i);
+          break;
+        }
+      }
+    }
+    numa_node_[cpu] = 0;
+    for (int64_t node = 0; node < numa_node_cnt_; ++node) {
+      if (CPU_ISSET(cpu, &node_cpus_[node])) {
+        numa_node_[cpu] = static_cast<int16_t>(node);
+        break;
+      }
+    }
+  }
+  socket_cnt_ = max_socket + 1;
+  _OB_LOG(INFO, "cpu topology, cpu_cnt=%ld socket_cnt=%ld numa_node_cnt=%ld",
+          cpu_cnt_, socket_cnt_, numa_node_cnt_);
+}
+
+int64_t ObCpuTopology::get_socket(const int64_t cpu) const
+{
+  return cpu >= 0 && cpu < cpu_cnt_ ? socket_[cpu] : -1;
+}
+
+int64_t ObCpuTopology::get_numa_node(const int64_t cpu) const
+{
+  return cpu >= 0 && cpu < cpu_cnt_ ? numa_node_[cpu] : -1;
+}
+
+int64_t ObCpuTopology::get_core(const int64_t cpu) const
+{
+  return cpu >= 0 && cpu < cpu_cnt_ ? core_[cpu] : -1;
+}
+
+int64_t ObCpuTopology::get_numa_node_cpu_count(const int64_t node) const
+{
+  return node >= 0 && node < numa_node_cnt_ ? CPU_COUNT(&node_cpus_[node]) : 0;
+}
+
+int ObCpuTopology::get_numa_node_cpus(const int64_t node, cpu_set_t &cpus) const
+{
+  int ret = OB_SUCCESS;
+  if (node < 0 || node >= numa_node_cnt_) {
+    ret = OB_INVALID_ARGUMENT;
+    LIB_LOG(WARN, "invalid numa node", K(ret), K(node), K_(numa_node_cnt));
+  } else {
+    cpus = node_cpus_[node];
+  }
+  return ret;
+}
+
+int64_t ObCpuTopology::acquire_numa_node(const double cpu)
+{
+  int64_t node = -1;
+  const int64_t load = static_cast<int64_t>(cpu * 100);
+  if (numa_node_cnt_ > 1) {
+    for (int64_t i = 0; i < numa_node_cnt_; ++i) {
+      if (get_numa_node_cpu_count(i) >= cpu
+          && (-1 == node || ATOMIC_LOAD(&node_load_[i]) < ATOMIC_LOAD(&node_load_[node]))) {
+        node = i;
+      }
+    }
+    if (-1 != node) {
+      (void)ATOMIC_AAF(&node_load_[node], load);
+    }
+  }
+  return node;
+}
+
+void ObCpuTopology::release_numa_node(const int64_t node, const double cpu)
+{
+  if (node >= 0 && node < numa_node_cnt_) {
+    (void)ATOMIC_AAF(&node_load_[node], -static_cast<int64_t>(cpu * 100));
+  }
+}
+
+bool ObCpuTopology::resize_numa_node(const int64_t node, const double old_cpu, const double new_cpu)
+{
+  bool fit = false;
+  if (node >= 0 && node < numa_node_cnt_) {
+    fit = get_numa_node_cpu_count(node) >= new_cpu;
+    const int64_t delta = (fit ? static_cast<int64_t>(new_cpu * 100) : 0)
+                          - static_cast<int64_t>(old_cpu * 100);
+    (void)ATOMIC_AAF(&node_load_[node], delta);
+  }
+  return fit;
+}
+
+int ObCpuTopology::bind_thread_to_numa_node(const int64_t node) const
+{
+  int ret = OB_SUCCESS;
+  const cpu_set_t *cpus = &process_cpus_;
+  if (node >= numa_node_cnt_) {
+    ret = OB_INVALID_ARGUMENT;
+    LIB_LOG(WARN, "invalid numa node", K(ret), K(node), K_(numa_node_cnt));
+  } else if (node >= 0) {
+    cpus = &node_cpus_[node];
+  }
+  if (OB_SUCC(ret) && 0 != pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), cpus)) {
+    ret = OB_ERR_SYS;
+    LIB_LOG(WARN, "bind thread to numa node failed", K(ret), K(node), K(errno));
+  }
+  return ret;
+}
+
+int ObCpuTopology::bind_memory_to_numa_node(void *ptr, const int64_t size, const int64_t node) const
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(ptr) || size <= 0 || node < 0 || node >= numa_node_cnt_) {
+    ret = OB_INVALID_ARGUMENT;
+    LIB_LOG(WARN, "invalid argument", K(ret), KP(ptr), K(size), K(node), K_(numa_node_cnt));
+  } else {
+    const unsigned long nodemask = 1UL << node;
+    // no MPOL_MF_MOVE, the pages already faulted stay where they are
+    if (0 != syscall(SYS_mbind, ptr, static_cast<unsigned long>(size), MPOL_PREFERRED,
+                     &nodemask, static_cast<unsigned long>(MAX_NUMA_NODE_CNT + 1), 0)) {
+      ret = OB_ERR_SYS;
+      LIB_LOG(WARN, "bind memory to numa node failed", K(ret), KP(ptr), K(size), K(node), K(errno));
+    }
+  }
+  return ret;
+}
+
+int ObCpuTopology::reset_memory_policy(void *ptr, const int64_t size) const
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(ptr) || size <= 0) {
+    ret = OB_INVALID_ARGUMENT;
+    LIB_LOG(WARN, "invalid argument", K(ret), KP(ptr), K(size));
+  } else if (0 != syscall(SYS_mbind, ptr, static_cast<unsigned long>(size), MPOL_DEFAULT,
+                          NULL, 0UL, 0)) {
+    ret = OB_ERR_SYS;
+    LIB_LOG(WARN, "reset memory policy failed", K(ret), KP(ptr), K(size), K(errno));
+  }
+  return ret;
+}
 } // common
 } // oceanbase
 
@@ -14,6 +14,7 @@
 #define OCEANBASE_LIB_OB_CPU_TOPOLOGY_
 
 #include <stdint.h>
+#include <sched.h>
 #include "lib/utility/ob_macro_utils.h"
 #include "lib/utility/utility.h"
 
@@ -22,6 +23,64 @@ namespace oceanbase
 namespace common
 {
 int64_t get_cpu_count();
+
+// Sockets, NUMA nodes and SMT siblings of the online cpus, read from sysfs once.
+// A host without /sys/devices/system/node is treated as a single node.
+class ObCpuTopology
+{
+public:
+  static const int64_t MAX_CPU_CNT = CPU_SETSIZE;
+  static const int64_t MAX_NUMA_NODE_CNT = 64;
+
+  static ObCpuTopology &get_instance();
+
+  int64_t get_cpu_count() const { return cpu_cnt_; }
+  int64_t get_socket_count() const { return socket_cnt_; }
+  int64_t get_numa_node_count() const { return numa_node_cnt_; }
+  // -1 for an invalid cpu
+  int64_t get_socket(const int64_t cpu) const;
+  int64_t get_numa_node(const int64_t cpu) const;
+  // the smallest cpu among the SMT siblings of %cpu, i.e. its physical core
+  int64_t get_core(const int64_t cpu) const;
+  int64_t get_numa_node_cpu_count(const int64_t node) const;
+  int get_numa_node_cpus(const int64_t node, cpu_set_t &cpus) const;
+
+  // Place a load of %cpu cores on the least loaded node which has that many cpus,
+  // %node is -1 if there is no such node or only one node.
+  int64_t acquire_numa_node(const double cpu);
+  void release_numa_node(const int64_t node, const double cpu);
+  // Move the load placed on %node from %old_cpu to %new_cpu cores. Returns false and
+  // releases the old load if %node does not have %new_cpu cpus.
+  bool resize_numa_node(const int64_t node, const double old_cpu, const double new_cpu);
+
+  // Run the calling thread on the cpus of %node only, -1 restores the affinity
+  // the process started with.
+  int bind_thread_to_numa_node(const int64_t node) const;
+  // Prefer %node for the pages of [ptr, ptr + size) not faulted yet, %ptr must be page aligned.
+  int bind_memory_to_numa_node(void *ptr, const int64_t size, const int64_t node) const;
+  // Back to the default policy for the pages of [ptr, ptr + size) faulted afterwards.
+  int reset_memory_policy(void *ptr, const int64_t size) const;
+
+  TO_STRING_KV(K_(cpu_cnt), K_(socket_cnt), K_(numa_node_cnt));
+private:
+  ObCpuTopology();
+  ~ObCpuTopology() {}
+  void init();
+  static int read_int(const char *path, int64_t &value);
+  static int read_cpu_list(const char *path, cpu_set_t &cpus);
+
+  int64_t cpu_cnt_;
+  int64_t socket_cnt_;
+  int64_t numa_node_cnt_;
+  int16_t socket_[MAX_CPU_CNT];
+  int16_t numa_node_[MAX_CPU_CNT];
+  int16_t core_[MAX_CPU_CNT];
+  cpu_set_t node_cpus_[MAX_NUMA_NODE_CNT];
+  cpu_set_t process_cpus_;
+  // cpu placed on each node by acquire_numa_node, in 1/100 core
+  int64_t node_load_[MAX_NUMA_NODE_CNT];
+  DISALLOW_COPY_AND_ASSIGN(ObCpuTopology);
+};
 } // namespace common
 } // namespace oceanbase
 
@@ -203,6 +203,169 @@ private:
   int64_t limit_ CACHE_ALIGNED;
   DISALLOW_COPY_AND_ASSIGN(ObPriorityQueue2);
 };
+
+// Same interface and priority semantics as ObPriorityQueue2, but every priority is split
+// into shard_cnt_ sub queues. A push goes to the shard picked by its hint, e.g. the
+// connection, so the requests of the same connection stay in the same sub queue. A pop
+// looks into the home shard of the consumer first and steals from the other shards only
+// when it is empty, a higher priority is always drained before a lower one no matter
+// which shard it is in.
+// With a single shard every call goes to an unchanged ObPriorityQueue2, so the default
+// behaves exactly as before. shard_cnt_ must be set before the first push and never
+// changes afterwards.
+template <int HIGH_HIGH_PRIOS, int HIGH_PRIOS=0, int LOW_PRIOS=0, int MAX_SHARD_CNT=16>
+class ObShardedPriorityQueue2
+{
+public:
+  enum { PRIO_CNT = HIGH_HIGH_PRIOS + HIGH_PRIOS + LOW_PRIOS };
+
+  ObShardedPriorityQueue2()
+    : single_queue_(), shard_cnt_(1), shards_(), size_(0), limit_(INT64_MAX) {}
+  ~ObShardedPriorityQueue2() {}
+
+  void set_limit(int64_t limit)
+  {
+    single_queue_.set_limit(limit);
+    limit_ = limit;
+  }
+  void set_shard_cnt(int64_t shard_cnt)
+  {
+    shard_cnt_ = shard_cnt < 1 ? 1 : (shard_cnt > MAX_SHARD_CNT ? MAX_SHARD_CNT : shard_cnt);
+  }
+  int64_t get_shard_cnt() const { return shard_cnt_; }
+  inline int64_t size() const
+  {
+    return 1 == shard_cnt_ ? single_queue_.size() : ATOMIC_LOAD(&size_);
+  }
+  int64_t queue_size(const int i) const
+  {
+    int64_t size = 0;
+    if (1 == shard_cnt_) {
+      size = single_queue_.queue_size(i);
+    } else {
+      for (int64_t s = 0; s < shard_cnt_; s++) {
+        size += ATOMIC_LOAD(&shards_[s].size_[i]);
+      }
+    }
+    return size;
+  }
+  int64_t to_string(char *buf, const int64_t buf_len) const
+  {
+    int64_t pos = 0;
+    if (1 == shard_cnt_) {
+      pos = single_queue_.to_string(buf, buf_len);
+    } else {
+      common::databuff_printf(buf, buf_len, pos, "total_size=%ld shard_cnt=%ld ", size(), shard_cnt_);
+      for(int i = 0; i < PRIO_CNT; i++) {
+        common::databuff_printf(buf, buf_len, pos, "queue[%d]=%ld ", i, queue_size(i));
+      }
+    }
+    return pos;
+  }
+
+  int push(ObLink* data, int priority, uint64_t shard_hint = 0)
+  {
+    int ret = OB_SUCCESS;
+    if (1 == shard_cnt_) {
+      ret = single_queue_.push(data, priority);
+    } else if (ATOMIC_FAA(&size_, 1) > limit_) {
+      ret = OB_SIZE_OVERFLOW;
+    } else if (OB_UNLIKELY(NULL == data) || OB_UNLIKELY(priority < 0) || OB_UNLIKELY(priority >= PRIO_CNT)) {
+      ret = OB_INVALID_ARGUMENT;
+      COMMON_LOG(WARN, "push error, invalid argument", KP(data), K(priority));
+    } else {
+      Shard &shard = shards_[shard_hint % shard_cnt_];
+      if (OB_FAIL(shard.queue_[priority].push(data))) {
+        // do nothing
+      } else {
+        (void)ATOMIC_FAA(&shard.size_[priority], 1);
+        if (priority < HIGH_HIGH_PRIOS) {
+          cond_.signal(1, 0);
+        } else if (priority < HIGH_PRIOS + HIGH_HIGH_PRIOS) {
+          cond_.signal(1, 1);
+        } else {
+          cond_.signal(1, 2);
+        }
+      }
+    }
+
+    if (OB_FAIL(ret) && 1 != shard_cnt_) {
+      (void)ATOMIC_FAA(&size_, -1);
+    }
+    return ret;
+  }
+
+  int pop(ObLink*& data, int64_t timeout_us, uint64_t home_shard = 0)
+  {
+    return 1 == shard_cnt_ ? single_queue_.pop(data, timeout_us)
+        : do_pop(data, PRIO_CNT, timeout_us, home_shard);
+  }
+
+  int pop_high(ObLink*& data, int64_t timeout_us, uint64_t home_shard = 0)
+  {
+    return 1 == shard_cnt_ ? single_queue_.pop_high(data, timeout_us)
+        : do_pop(data, HIGH_HIGH_PRIOS + HIGH_PRIOS, timeout_us, home_shard);
+  }
+
+  int pop_high_high(ObLink*& data, int64_t timeout_us, uint64_t home_shard = 0)
+  {
+    return 1 == shard_cnt_ ? single_queue_.pop_high_high(data, timeout_us)
+        : do_pop(data, HIGH_HIGH_PRIOS, timeout_us, home_shard);
+  }
+
+private:
+  struct Shard
+  {
+    Shard() : queue_(), size_() {}
+    ObSpLinkQueue queue_[PRIO_CNT];
+    int64_t size_[PRIO_CNT];
+  } CACHE_ALIGNED;
+
+  inline int do_pop(ObLink*& data, int64_t plimit, int64_t timeout_us, uint64_t home_shard)
+  {
+    int ret = OB_ENTRY_NOT_EXIST;
+    if (OB_UNLIKELY(timeout_us < 0)) {
+      ret = OB_INVALID_ARGUMENT;
+      COMMON_LOG(ERROR, "timeout is invalid", K(ret), K(timeout_us));
+    } else {
+      if (plimit <= HIGH_HIGH_PRIOS) {
+        cond_.prepare(0);
+      } else if (plimit <= HIGH_PRIOS + HIGH_HIGH_PRIOS) {
+        cond_.prepare(1);
+      } else {
+        cond_.prepare(2);
+      }
+      const int64_t shard_cnt = shard_cnt_;
+      const int64_t home = home_shard % shard_cnt;
+      for(int i = 0; OB_ENTRY_NOT_EXIST == ret && i < plimit; i++) {
+        for (int64_t s = 0; OB_ENTRY_NOT_EXIST == ret && s < shard_cnt; s++) {
+          Shard &shard = shards_[(home + s) % shard_cnt];
+          // a read only check first, popping an empty queue takes its head
+          if (!shard.queue_[i].is_empty() && OB_SUCCESS == shard.queue_[i].pop(data)) {
+            (void)ATOMIC_FAA(&shard.size_[i], -1);
+            ret = OB_SUCCESS;
+          }
+        }
+      }
+      if (OB_FAIL(ret)) {
+        cond_.wait(timeout_us);
+        data = NULL;
+      } else {
+        (void)ATOMIC_FAA(&size_, -1);
+      }
+    }
+    return ret;
+  }
+
+  // used instead of the shards when shard_cnt_ is 1
+  ObPriorityQueue2<HIGH_HIGH_PRIOS, HIGH_PRIOS, LOW_PRIOS> single_queue_;
+  SCondTemp<3> cond_;
+  int64_t shard_cnt_;
+  Shard shards_[MAX_SHARD_CNT];
+  int64_t size_ CACHE_ALIGNED;
+  int64_t limit_ CACHE_ALIGNED;
+  DISALLOW_COPY_AND_ASSIGN(ObShardedPriorityQueue2);
+};
 } // end namespace common
 } // end namespace oceanbase
 
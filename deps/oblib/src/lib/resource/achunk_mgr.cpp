@@ -24,10 +24,12 @@
 #include "lib/alloc/alloc_failed_reason.h"
 #include "lib/alloc/memory_sanity.h"
 #include "lib/stat/ob_diagnose_info.h"
+#include "lib/cpu/ob_cpu_topology.h"
 
 using namespace oceanbase::lib;
 
 int ObLargePageHelper::large_page_type_ = INVALID_LARGE_PAGE_TYPE;
+int ObLargePageHelper::ctx_large_page_types_[common::ObCtxIds::MAX_CTX_ID] = {};
 
 void ObLargePageHelper::set_param(const char *param)
 {
@@ -52,6 +54,57 @@ int ObLargePageHelper::get_type()
 #endif
 }
 
+void ObLargePageHelper::set_ctx_param(const char *param)
+{
+  int types[common::ObCtxIds::MAX_CTX_ID] = {};
+  if (OB_NOT_NULL(param)) {
+    char buf[1024];
+    STRNCPY(buf, param, sizeof(buf));
+    buf[sizeof(buf) - 1] = '\0';
+    char *save_ptr = nullptr;
+    for (char *item = strtok_r(buf, ", ", &save_ptr); item != nullptr;
+         item = strtok_r(nullptr, ", ", &save_ptr)) {
+      char *policy = strchr(item, ':');
+      uint64_t ctx_id = 0;
+      if (nullptr == policy) {
+        LOG_WARN("invalid ctx huge page policy", K(item));
+      } else {
+        *policy++ = '\0';
+        if (!common::get_global_ctx_info().is_valid_ctx_name(item, ctx_id)
+            || common::ObCtxIds::MAX_CTX_ID == ctx_id) {
+          LOG_WARN("invalid ctx name", K(item));
+        } else if (0 == strcasecmp(policy, "thp")) {
+          types[ctx_id] = CTX_TRANSPARENT_HUGE_PAGE;
+        } else if (0 == strcasecmp(policy, "hugetlb")) {
+          types[ctx_id] = CTX_HUGETLB_PAGE;
+        } else if (0 == strcasecmp(policy, "none")) {
+          types[ctx_id] = CTX_DEFAULT_PAGE;
+        } else {
+          LOG_WARN("invalid huge page policy", K(item), K(policy));
+        }
+      }
+    }
+  }
+  for (int64_t i = 0; i < common::ObCtxIds::MAX_CTX_ID; i++) {
+    if (types[i] != ATOMIC_LOAD(&ctx_large_page_types_[i])) {
+      LOG_INFO("set ctx large page type", "ctx", common::get_global_ctx_info().get_ctx_name(i),
+               "type", types[i]);
+      ATOMIC_STORE(&ctx_large_page_types_[i], types[i]);
+    }
+  }
+}
+
+int ObLargePageHelper::get_ctx_type(const uint64_t ctx_id)
+{
+#ifndef ENABLE_SANITY
+  return OB_LIKELY(ctx_id < common::ObCtxIds::MAX_CTX_ID) ?
+      ATOMIC_LOAD(&ctx_large_page_types_[ctx_id]) : CTX_DEFAULT_PAGE;
+#else
+  UNUSED(ctx_id);
+  return CTX_DEFAULT_PAGE;
+#endif
+}
+
 AChunkMgr &AChunkMgr::instance()
 {
   static AChunkMgr mgr;
@@ -64,7 +117,8 @@ AChunkMgr::AChunkMgr()
 {
 }
 
-void *AChunkMgr::direct_alloc(const uint64_t size, const bool can_use_huge_page, bool &huge_page_used, const bool alloc_shadow)
+void *AChunkMgr::direct_alloc(const uint64_t size, const bool can_use_huge_page, bool &huge_page_used, const bool alloc_shadow,
+                              const int ctx_large_page_type)
 {
   common::ObTimeGuard time_guard(__func__, 1000 * 1000);
   int orig_errno = errno;
@@ -72,14 +126,14 @@ void *AChunkMgr::direct_alloc(const uint64_t size, const bool can_use_huge_page,
   EVENT_ADD(MMAP_SIZE, size);
 
   void *ptr = nullptr;
-  ptr = low_alloc(size, can_use_huge_page, huge_page_used, alloc_shadow);
+  ptr = low_alloc(size, can_use_huge_page, huge_page_used, alloc_shadow, ctx_large_page_type);
   if (nullptr != ptr) {
     if (((uint64_t)ptr & (INTACT_ACHUNK_SIZE - 1)) != 0) {
       // not aligned
       low_free(ptr, size);
 
       uint64_t new_size = size + INTACT_ACHUNK_SIZE;
-      ptr = low_alloc(new_size, can_use_huge_page, huge_page_used, alloc_shadow);
+      ptr = low_alloc(new_size, can_use_huge_page, huge_page_used, alloc_shadow, ctx_large_page_type);
       if (nullptr != ptr) {
         const uint64_t addr = align_up2((uint64_t)ptr, INTACT_ACHUNK_SIZE);
         if (addr - (uint64_t)ptr > 0) {
@@ -125,7 +179,8 @@ void AChunkMgr::direct_free(const void *ptr, const uint64_t size)
 
 static int64_t global_canonical_addr = SANITY_MIN_CANONICAL_ADDR;
 
-void *AChunkMgr::low_alloc(const uint64_t size, const bool can_use_huge_page, bool &huge_page_used, const bool alloc_shadow)
+void *AChunkMgr::low_alloc(const uint64_t size, const bool can_use_huge_page, bool &huge_page_used, const bool alloc_shadow,
+                           const int ctx_large_page_type)
 {
   void *ptr = nullptr;
   huge_page_used = false;
@@ -139,7 +194,12 @@ void *AChunkMgr::low_alloc(const uint64_t size, const bool can_use_huge_page, bo
 #endif
   const int fd = -1;
   const int offset = 0;
-  const int large_page_type = ObLargePageHelper::get_type();
+  int large_page_type = ObLargePageHelper::get_type();
+  if (ObLargePageHelper::CTX_HUGETLB_PAGE == ctx_large_page_type) {
+    large_page_type = ObLargePageHelper::PREFER_LARGE_PAGE;
+  } else if (ObLargePageHelper::CTX_TRANSPARENT_HUGE_PAGE == ctx_large_page_type) {
+    large_page_type = ObLargePageHelper::NO_LARGE_PAGE;
+  }
   if (SANITY_BOOL_EXPR(alloc_shadow)) {
     int64_t new_addr = ATOMIC_FAA(&global_canonical_addr, size);
     if (!SANITY_ADDR_IN_RANGE((void*)new_addr)) {
@@ -169,6 +229,13 @@ void *AChunkMgr::low_alloc(const uint64_t size, const bool can_use_huge_page, bo
       huge_page_used = huge_flags != flags;
     }
   }
+#ifdef MADV_HUGEPAGE
+  if (ptr && ObLargePageHelper::CTX_TRANSPARENT_HUGE_PAGE == ctx_large_page_type) {
+    if (0 != ::madvise(ptr, size, MADV_HUGEPAGE)) {
+      LOG_WARN("madvise hugepage failed", K(errno), KP(ptr), K(size));
+    }
+  }
+#endif
   if (ptr && SANITY_ADDR_IN_RANGE(ptr)) {
     void *shad_ptr  = SANITY_TO_SHADOW(ptr);
     ssize_t shad_size = SANITY_TO_SHADOW_SIZE(size);
@@ -196,7 +263,29 @@ void AChunkMgr::low_free(const void *ptr, const uint64_t size)
   ::munmap((void*)ptr, size);
 }
 
-AChunk *AChunkMgr::alloc_chunk(const uint64_t size, bool high_prio)
+AChunk *AChunkMgr::new_chunk(const uint64_t all_size, const int ctx_large_page_type,
+                             const int64_t numa_node)
+{
+  AChunk *chunk = nullptr;
+  bool hugetlb_used = false;
+  bool numa_bound = false;
+  void *ptr = direct_alloc(all_size, true, hugetlb_used, SANITY_BOOL_EXPR(true), ctx_large_page_type);
+  if (ptr != nullptr) {
+    if (numa_node >= 0) {
+      numa_bound = OB_SUCCESS == ObCpuTopology::get_instance().bind_memory_to_numa_node(
+          ptr, static_cast<int64_t>(all_size), numa_node);
+    }
+    chunk = new (ptr) AChunk();
+    chunk->is_hugetlb_ = hugetlb_used;
+    chunk->is_thp_ = ObLargePageHelper::CTX_TRANSPARENT_HUGE_PAGE == ctx_large_page_type;
+    chunk->is_ctx_huge_page_ = ObLargePageHelper::CTX_DEFAULT_PAGE != ctx_large_page_type;
+    chunk->is_numa_bound_ = numa_bound;
+  }
+  return chunk;
+}
+
+AChunk *AChunkMgr::alloc_chunk(const uint64_t size, bool high_prio, const int ctx_large_page_type,
+                               const int64_t numa_node)
 {
   const int64_t hold_size = hold(size);
   const int64_t all_size = aligned(size);
@@ -204,20 +293,18 @@ AChunk *AChunkMgr::alloc_chunk(const uint64_t size, bool high_prio)
   bool is_allocated = true;
 
   AChunk *chunk = nullptr;
-  if (achunk_size == hold_size) {
+  // the cached chunks were faulted on any node, a chunk bound to a numa node is always
+  // mapped fresh
+  if (achunk_size == hold_size && numa_node < 0) {
     // TODO by fengshuo.fs: chunk cached by freelist may not use all memory in it,
     //                      so update_hold can use hold_size too.
-    if (free_list_.count() > 0) {
+    // the free list only holds chunks of the default page type
+    if (ObLargePageHelper::CTX_DEFAULT_PAGE == ctx_large_page_type && free_list_.count() > 0) {
       chunk = free_list_.pop();
     }
     if (OB_ISNULL(chunk)) {
       if (update_hold(hold_size, high_prio)) {
-        bool hugetlb_used = false;
-        void *ptr = direct_alloc(all_size, true, hugetlb_used, SANITY_BOOL_EXPR(true));
-        if (ptr != nullptr) {
-          chunk = new (ptr) AChunk();
-          chunk->is_hugetlb_ = hugetlb_used;
-        } else {
+        if (OB_ISNULL(chunk = new_chunk(all_size, ctx_large_page_type))) {
           IGNORE_RETURN update_hold(-hold_size, high_prio);
         }
       }
@@ -235,12 +322,7 @@ AChunk *AChunkMgr::alloc_chunk(const uint64_t size, bool high_prio)
       }
     }
     if (updated) {
-      bool hugetlb_used = false;
-      void *ptr = direct_alloc(all_size, true, hugetlb_used, SANITY_BOOL_EXPR(true));
-      if (ptr != nullptr) {
-        chunk = new (ptr) AChunk();
-        chunk->is_hugetlb_ = hugetlb_used;
-      } else {
+      if (OB_ISNULL(chunk = new_chunk(all_size, ctx_large_page_type, numa_node))) {
         IGNORE_RETURN update_hold(-hold_size, high_prio);
       }
     }
@@ -268,7 +350,12 @@ void AChunkMgr::free_chunk(AChunk *chunk)
     const int64_t achunk_size = INTACT_ACHUNK_SIZE;
     bool freed = true;
     if (achunk_size == hold_size) {
-      if (hold_ + hold_size <= limit_) {
+      if (!chunk->is_ctx_huge_page_ && hold_ + hold_size <= limit_) {
+        if (OB_UNLIKELY(chunk->is_numa_bound_)) {
+          // the next owner of a cached chunk may run on another node
+          IGNORE_RETURN ObCpuTopology::get_instance().reset_memory_policy(chunk, all_size);
+          chunk->is_numa_bound_ = false;
+        }
         freed = !free_list_.push(chunk);
       }
       if (freed) {
@@ -22,6 +22,7 @@
 #include "lib/atomic/ob_atomic.h"
 #include "lib/ob_define.h"
 #include "lib/lock/ob_mutex.h"
+#include "lib/allocator/ob_mod_define.h"
 
 namespace oceanbase
 {
@@ -156,11 +157,20 @@ public:
   static const int NO_LARGE_PAGE = 0;
   static const int PREFER_LARGE_PAGE = 1;
   static const int ONLY_LARGE_PAGE = 2;
+  // huge page policy of the chunks of a ctx, overrides the type above
+  static const int CTX_DEFAULT_PAGE = 0;
+  static const int CTX_TRANSPARENT_HUGE_PAGE = 1;  // MADV_HUGEPAGE
+  static const int CTX_HUGETLB_PAGE = 2;           // MAP_HUGETLB, prefer only
 public:
   static void set_param(const char *param);
   static int get_type();
+  // %param is a list of ctx_name:policy, policy is one of thp, hugetlb and none,
+  // e.g. "KVSTORE_CACHE_ID:thp,MEMSTORE_CTX_ID:hugetlb". ctx not listed are reset to none.
+  static void set_ctx_param(const char *param);
+  static int get_ctx_type(const uint64_t ctx_id);
 private:
   static int large_page_type_;
+  static int ctx_large_page_types_[common::ObCtxIds::MAX_CTX_ID];
 };
 
 class AChunkMgr
@@ -177,7 +187,9 @@ public:
 
   AChunk *alloc_chunk(
       const uint64_t size = ACHUNK_SIZE,
-      bool high_prio = false);
+      bool high_prio = false,
+      const int ctx_large_page_type = ObLargePageHelper::CTX_DEFAULT_PAGE,
+      const int64_t numa_node = -1);
   void free_chunk(AChunk *chunk);
   AChunk *alloc_co_chunk(const uint64_t size = ACHUNK_SIZE);
   void free_co_chunk(AChunk *chunk);
@@ -210,10 +222,15 @@ private:
   typedef ABitSet ChunkBitMap;
 
 private:
-  void *direct_alloc(const uint64_t size, const bool can_use_huge_page, bool &huge_page_used, const bool alloc_shadow);
+  void *direct_alloc(const uint64_t size, const bool can_use_huge_page, bool &huge_page_used, const bool alloc_shadow,
+                     const int ctx_large_page_type = ObLargePageHelper::CTX_DEFAULT_PAGE);
   void direct_free(const void *ptr, const uint64_t size);
   // wrap for mmap
-  void *low_alloc(const uint64_t size, const bool can_use_huge_page, bool &huge_page_used, const bool alloc_shadow);
+  void *low_alloc(const uint64_t size, const bool can_use_huge_page, bool &huge_page_used, const bool alloc_shadow,
+                  const int ctx_large_page_type);
+  // %numa_node >= 0 binds the fresh mapping to that node before any page is faulted
+  AChunk *new_chunk(const uint64_t all_size, const int ctx_large_page_type,
+                    const int64_t numa_node = -1);
   void low_free(const void *ptr, const uint64_t size);
 
 protected:
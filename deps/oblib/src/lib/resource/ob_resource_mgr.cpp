@@ -20,6 +20,7 @@
 #include "lib/stat/ob_diagnose_info.h"
 #include "lib/utility/utility.h"
 #include "lib/alloc/alloc_failed_reason.h"
+#include "lib/cpu/ob_cpu_topology.h"
 
 namespace oceanbase
 {
@@ -27,24 +28,26 @@ using namespace common;
 namespace lib
 {
 ObTenantMemoryMgr::ObTenantMemoryMgr()
-  : cache_washer_(NULL), tenant_id_(common::OB_INVALID_ID),
+  : cache_washer_(NULL), tenant_id_(common::OB_INVALID_ID), numa_node_(-1),
     limit_(INT64_MAX), sum_hold_(0), rpc_hold_(0), cache_hold_(0),
     cache_item_count_(0)
 {
   for (uint64_t i = 0; i < common::ObCtxIds::MAX_CTX_ID; i++) {
     ATOMIC_STORE(&(hold_bytes_[i]), 0);
     ATOMIC_STORE(&(limit_bytes_[i]), INT64_MAX);
+    ATOMIC_STORE(&(huge_page_hold_bytes_[i]), 0);
   }
 }
 
 ObTenantMemoryMgr::ObTenantMemoryMgr(const uint64_t tenant_id)
-  : cache_washer_(NULL), tenant_id_(tenant_id),
+  : cache_washer_(NULL), tenant_id_(tenant_id), numa_node_(-1),
     limit_(INT64_MAX), sum_hold_(0), rpc_hold_(0), cache_hold_(0),
     cache_item_count_(0)
 {
   for (uint64_t i = 0; i < common::ObCtxIds::MAX_CTX_ID; i++) {
     ATOMIC_STORE(&(hold_bytes_[i]), 0);
     ATOMIC_STORE(&(limit_bytes_[i]), INT64_MAX);
+    ATOMIC_STORE(&(huge_page_hold_bytes_[i]), 0);
   }
 }
 void ObTenantMemoryMgr::set_cache_washer(ObICacheWasher &cache_washer)
@@ -95,10 +98,27 @@ AChunk *ObTenantMemoryMgr::alloc_chunk(const int64_t size, const ObMemAttr &attr
         } else if (NULL != washed_blocks->next_) {
           ret = OB_ERR_UNEXPECTED;
           LOG_WARN("not single memory block washed", K(ret), K(wash_single_mb));
+        } else if (FALSE_IT(chunk = ptr2chunk(washed_blocks))) {
+        } else if (get_large_page_type(*chunk)
+                   != ObLargePageHelper::get_ctx_type(huge_page_ctx_id(attr))) {
+          // the washed memblock keeps the pages of the cache policy, return it to the os and
+          // map a chunk of the policy of this ctx, so that huge pages stay in their ctx
+          ObMemAttr cache_attr;
+          cache_attr.tenant_id_ = tenant_id_;
+          cache_attr.label_ = ObNewModIds::OB_KVSTORE_CACHE_MB;
+          free_chunk(chunk, cache_attr);
+          chunk = NULL;
+          if (update_hold(hold_size, attr.ctx_id_, attr.label_, reach_ctx_limit)) {
+            chunk = alloc_chunk_(size, attr);
+            if (NULL == chunk) {
+              update_hold(-hold_size, attr.ctx_id_, attr.label_, reach_ctx_limit);
+            }
+          }
         } else {
-          chunk = ptr2chunk(washed_blocks);
           const int64_t chunk_hold = static_cast<int64_t>(chunk->hold());
           update_cache_hold(-chunk_hold);
+          update_huge_page_hold(*chunk, ObCtxIds::KVSTORE_CACHE_ID, false);
+          update_huge_page_hold(*chunk, attr.ctx_id_, true);
           if (!update_ctx_hold(attr.ctx_id_, chunk_hold)) {
             // reach ctx limit
             // The ctx_id here can be given freely, because ctx_id is meaningless when the label is OB_KVSTORE_CACHE_MB
@@ -239,6 +259,18 @@ int ObTenantMemoryMgr::get_ctx_hold(const uint64_t ctx_id, int64_t &hold) const
   return ret;
 }
 
+int ObTenantMemoryMgr::get_ctx_huge_page_hold(const uint64_t ctx_id, int64_t &hold) const
+{
+  int ret = OB_SUCCESS;
+  if (ctx_id >= ObCtxIds::MAX_CTX_ID) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid arguemnt", K(ret), K(ctx_id));
+  } else {
+    hold = huge_page_hold_bytes_[ctx_id];
+  }
+  return ret;
+}
+
 void ObTenantMemoryMgr::update_cache_hold(const int64_t size)
 {
   if (0 != size) {
@@ -324,13 +356,42 @@ AChunk *ObTenantMemoryMgr::ptr2chunk(void *ptr)
   return chunk;
 }
 
+// kvcache memblocks are allocated by label, they follow the policy of KVSTORE_CACHE_ID
+uint64_t ObTenantMemoryMgr::huge_page_ctx_id(const ObMemAttr &attr)
+{
+  return attr.label_ == ObNewModIds::OB_KVSTORE_CACHE_MB ? ObCtxIds::KVSTORE_CACHE_ID : attr.ctx_id_;
+}
+
+int ObTenantMemoryMgr::get_large_page_type(const AChunk &chunk)
+{
+  return !chunk.is_ctx_huge_page_ ? ObLargePageHelper::CTX_DEFAULT_PAGE
+      : chunk.is_thp_ ? ObLargePageHelper::CTX_TRANSPARENT_HUGE_PAGE
+      : ObLargePageHelper::CTX_HUGETLB_PAGE;
+}
+
+// by the mapped size, the hold of a chunk changes with washing
+void ObTenantMemoryMgr::update_huge_page_hold(AChunk &chunk, const uint64_t ctx_id, const bool inc)
+{
+  if ((chunk.is_hugetlb_ || chunk.is_thp_) && ctx_id < ObCtxIds::MAX_CTX_ID) {
+    const int64_t size = static_cast<int64_t>(chunk.aligned());
+    ATOMIC_AAF(&huge_page_hold_bytes_[ctx_id], inc ? size : -size);
+  }
+}
+
 AChunk *ObTenantMemoryMgr::alloc_chunk_(const int64_t size, const ObMemAttr &attr)
 {
   AChunk *chunk = nullptr;
   if (OB_UNLIKELY(attr.ctx_id_ == ObCtxIds::CO_STACK)) {
     chunk = CHUNK_MGR.alloc_co_chunk(static_cast<uint64_t>(size));
   } else {
-    chunk = CHUNK_MGR.alloc_chunk(static_cast<uint64_t>(size), OB_HIGH_ALLOC == attr.prio_);
+    const uint64_t ctx_id = huge_page_ctx_id(attr);
+    // the ctx allocators and the kvcache memblocks of the tenant all come here
+    chunk = CHUNK_MGR.alloc_chunk(static_cast<uint64_t>(size), OB_HIGH_ALLOC == attr.prio_,
+                                  ObLargePageHelper::get_ctx_type(ctx_id),
+                                  ATOMIC_LOAD(&numa_node_));
+    if (OB_NOT_NULL(chunk)) {
+      update_huge_page_hold(*chunk, ctx_id, true);
+    }
   }
   return chunk;
 }
@@ -340,6 +401,7 @@ void ObTenantMemoryMgr::free_chunk_(AChunk *chunk, const ObMemAttr &attr)
   if (OB_UNLIKELY(attr.ctx_id_ == ObCtxIds::CO_STACK)) {
     CHUNK_MGR.free_co_chunk(chunk);
   } else {
+    update_huge_page_hold(*chunk, huge_page_ctx_id(attr), false);
     CHUNK_MGR.free_chunk(chunk);
   }
 }
@@ -47,6 +47,9 @@ public:
   void free_cache_mb(void *ptr);
 
   uint64_t get_tenant_id() const { return tenant_id_; }
+  // the chunks allocated afterwards prefer the memory of %numa_node, -1 for no preference
+  void set_numa_node(const int64_t numa_node) { numa_node_ = numa_node; }
+  int64_t get_numa_node() const { return numa_node_; }
   void set_limit(const int64_t limit) { limit_ = limit; }
   int64_t get_limit() const { return limit_; }
   int64_t get_sum_hold() const { return sum_hold_; }
@@ -63,16 +66,23 @@ public:
   int set_ctx_limit(const uint64_t ctx_id, const int64_t limit);
   int get_ctx_limit(const uint64_t ctx_id, int64_t &limit) const;
   int get_ctx_hold(const uint64_t ctx_id, int64_t &hold) const;
+  // hold of the chunks on huge pages, hugetlb or advised transparent huge pages
+  int get_ctx_huge_page_hold(const uint64_t ctx_id, int64_t &hold) const;
   bool update_hold(const int64_t size, const uint64_t ctx_id, const lib::ObLabel &label,
       bool &reach_ctx_limit);
 private:
   void update_cache_hold(const int64_t size);
   bool update_ctx_hold(const uint64_t ctx_id, const int64_t size);
   AChunk *ptr2chunk(void *ptr);
+  static uint64_t huge_page_ctx_id(const ObMemAttr &attr);
+  // the ctx huge page policy the chunk is mapped with
+  static int get_large_page_type(const AChunk &chunk);
+  void update_huge_page_hold(AChunk &chunk, const uint64_t ctx_id, const bool inc);
   AChunk *alloc_chunk_(const int64_t size, const ObMemAttr &attr);
   void free_chunk_(AChunk *chunk, const ObMemAttr &attr);
   ObICacheWasher *cache_washer_;
   uint64_t tenant_id_;
+  int64_t numa_node_;
   int64_t limit_;
   int64_t sum_hold_;
   int64_t rpc_hold_;
@@ -80,6 +90,7 @@ private:
   int64_t cache_item_count_;
   volatile int64_t hold_bytes_[common::ObCtxIds::MAX_CTX_ID];
   volatile int64_t limit_bytes_[common::ObCtxIds::MAX_CTX_ID];
+  volatile int64_t huge_page_hold_bytes_[common::ObCtxIds::MAX_CTX_ID];
 };
 
 struct ObTenantResourceMgr : public common::ObLink
@@ -49,7 +49,7 @@ public:
   // Return:
   //   1. true    wait successfully
   //   2. false   wait fail, should cancel this invocation
-  bool sched_wait();
+  virtual bool sched_wait();
 
   // This function is opposite to `omt_sched_wait'. It notify
   // Multi-Tenancy that this worker has got enough resource and want to
@@ -59,7 +59,7 @@ public:
   // Return:
   //   1. true   the worker has right to go ahead
   //   2. false  the worker hasn't right to go ahead
-  bool sched_run(int64_t waittime=0);
+  virtual bool sched_run(int64_t waittime=0);
 
   ObIAllocator &get_sql_arena_allocator() ;
   ObIAllocator &get_allocator() ;
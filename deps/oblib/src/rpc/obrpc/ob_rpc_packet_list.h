@@ -594,6 +594,7 @@ PCODE_DEF(OB_TRANS_RESP, 0x706)
 PCODE_DEF(OB_DUP_TABLE_LEASE_REQUEST, 0x707)
 // transaction check for change leader by rpc
 PCODE_DEF(OB_CHANGE_LEADER, 0x708)
+PCODE_DEF(OB_GET_GTS_BATCH_REQUEST, 0x709)
 PCODE_DEF(OB_GET_GTS_REQUEST, 0x710)
 PCODE_DEF(OB_GET_GTS_RESPONSE, 0x711)
 PCODE_DEF(OB_GET_GTS_ERR_RESPONSE, 0x712)
@@ -82,3 +82,25 @@ TEST_F(TestChunkMgr, FreeListManyChunk)
   EXPECT_EQ(500*2, free_list_.get_pushes());
   EXPECT_EQ(500, free_list_.get_pops());
 }
+
+TEST_F(TestChunkMgr, CtxHugePage)
+{
+  ObLargePageHelper::set_ctx_param("KVSTORE_CACHE_ID:thp,MEMSTORE_CTX_ID:hugetlb,NO_SUCH_CTX:thp");
+  EXPECT_EQ(ObLargePageHelper::CTX_TRANSPARENT_HUGE_PAGE,
+            ObLargePageHelper::get_ctx_type(ObCtxIds::KVSTORE_CACHE_ID));
+  EXPECT_EQ(ObLargePageHelper::CTX_HUGETLB_PAGE,
+            ObLargePageHelper::get_ctx_type(ObCtxIds::MEMSTORE_CTX_ID));
+  EXPECT_EQ(ObLargePageHelper::CTX_DEFAULT_PAGE,
+            ObLargePageHelper::get_ctx_type(ObCtxIds::DEFAULT_CTX_ID));
+  // chunks of a ctx policy bypass the free list
+  const int64_t pushes = free_list_.get_pushes();
+  AChunk *chunk = alloc_chunk(0, false, ObLargePageHelper::CTX_TRANSPARENT_HUGE_PAGE);
+  ASSERT_NE(nullptr, chunk);
+  EXPECT_TRUE(chunk->is_ctx_huge_page_);
+  EXPECT_TRUE(chunk->is_thp_);
+  free_chunk(chunk);
+  EXPECT_EQ(pushes, free_list_.get_pushes());
+  ObLargePageHelper::set_ctx_param("");
+  EXPECT_EQ(ObLargePageHelper::CTX_DEFAULT_PAGE,
+            ObLargePageHelper::get_ctx_type(ObCtxIds::KVSTORE_CACHE_ID));
+}
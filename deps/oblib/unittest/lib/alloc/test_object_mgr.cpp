@@ -19,6 +19,7 @@
 #include "lib/utility/ob_test_util.h"
 #include "lib/coro/testing.h"
 #include <gtest/gtest.h>
+#include <sched.h>
 
 using namespace oceanbase::lib;
 using namespace oceanbase::common;
@@ -236,6 +237,129 @@ TEST_F(TestObjectMgr, TestFragmentWash)
 }
 
 
+// caches are per cpu, stay on one so that a free is seen by the next alloc
+static void pin_to_current_cpu()
+{
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  CPU_SET(sched_getcpu(), &cpus);
+  abort_unless(0 == sched_setaffinity(0, sizeof(cpus), &cpus));
+}
+
+static int64_t cached_cnt(ObjectMgr &om)
+{
+  int64_t cnt = 0;
+  for (int i = 0; i < ObjectMgr::CACHE_SHARD_CNT; i++) {
+    if (om.caches_[i] != nullptr) {
+      for (int j = 0; j <= ObjectMgr::ObjectCache::MAX_CELLS; j++) {
+        cnt += om.caches_[i]->cnts_[j];
+      }
+    }
+  }
+  return cnt;
+}
+
+TEST_F(TestObjectMgr, TestObjectCache)
+{
+  pin_to_current_cpu();
+  auto ta = ObMallocAllocator::get_instance()->get_tenant_ctx_allocator(
+      OB_SERVER_TENANT_ID, ObCtxIds::DEFAULT_CTX_ID);
+  ObjectMgr &om = static_cast<ObjectMgr&>(ta->get_block_mgr());
+  ObMemAttr attr_a(OB_SERVER_TENANT_ID, "CacheTestA");
+  ObMemAttr attr_b(OB_SERVER_TENANT_ID, "CacheTestB");
+  const uint64_t size = 100;
+  ObjectMgr::set_enable_object_cache(true);
+  om.flush_object_cache();
+
+  // the freed object keeps its label and stays in use for its set
+  AObject *obj = om.alloc_object(size, attr_a);
+  ASSERT_TRUE(obj != nullptr);
+  ASSERT_EQ(size, obj->alloc_bytes_);
+  ASSERT_EQ(size, obj->set_alloc_bytes_);
+  om.free_object(obj);
+  ASSERT_EQ(1, cached_cnt(om));
+  ASSERT_EQ(AOBJECT_MAGIC_CODE, obj->MAGIC_CODE_);
+  ASSERT_STREQ("CacheTestA", obj->label_);
+
+  // reused with the label and the size of the new user, a smaller size of the
+  // same cells keeps what the set accounted
+  uint64_t small_size = size;
+  while (small_size > 1 && obj->nobjs_ * AOBJECT_CELL_BYTES
+         == align_up2(MAX(small_size - 1, MIN_AOBJECT_SIZE) + AOBJECT_META_SIZE, 16)) {
+    small_size--;
+  }
+  AObject *reused = om.alloc_object(small_size, attr_b);
+  ASSERT_EQ(obj, reused);
+  ASSERT_EQ(0, cached_cnt(om));
+  ASSERT_EQ(small_size, reused->alloc_bytes_);
+  ASSERT_EQ(size, reused->set_alloc_bytes_);
+  ASSERT_STREQ("CacheTestB", reused->label_);
+
+  // realloc copies out of an object reused from the cache
+  MEMSET(reused->data_, 0xAB, small_size);
+  AObject *grown = om.realloc_object(reused, 4096, attr_b);
+  ASSERT_TRUE(grown != nullptr);
+  ASSERT_EQ(4096, grown->alloc_bytes_);
+  for (uint64_t i = 0; i < small_size; i++) {
+    ASSERT_EQ(static_cast<char>(0xAB), grown->data_[i]);
+  }
+  // large enough objects never go to the cache
+  om.free_object(grown);
+  ASSERT_EQ(0, cached_cnt(om));
+
+  // a flush gives the objects back with the bytes their sets accounted
+  reused = om.alloc_object(size, attr_a);
+  ASSERT_TRUE(reused != nullptr);
+  om.free_object(reused);
+  reused = om.alloc_object(small_size, attr_b);
+  om.free_object(reused);
+  ASSERT_EQ(1, cached_cnt(om));
+  om.flush_object_cache();
+  ASSERT_EQ(0, cached_cnt(om));
+  ObjectMgr::set_enable_object_cache(false);
+}
+
+TEST_F(TestObjectMgr, TestObjectCacheFlush)
+{
+  pin_to_current_cpu();
+  auto ta = ObMallocAllocator::get_instance()->get_tenant_ctx_allocator(
+      OB_SERVER_TENANT_ID, ObCtxIds::DEFAULT_CTX_ID);
+  ObjectMgr &om = static_cast<ObjectMgr&>(ta->get_block_mgr());
+  ObMemAttr attr(OB_SERVER_TENANT_ID, "CacheTest");
+  ObjectMgr::set_enable_object_cache(true);
+  om.flush_object_cache();
+
+  AObject *objs[ObjectMgr::ObjectCache::MAGAZINE_SIZE + 1];
+  for (int i = 0; i < ARRAYSIZEOF(objs); i++) {
+    objs[i] = om.alloc_object(64, attr);
+    ASSERT_TRUE(objs[i] != nullptr);
+  }
+  for (int i = 0; i < ARRAYSIZEOF(objs); i++) {
+    om.free_object(objs[i]);
+  }
+  // the older half went back when the magazine overflowed
+  ASSERT_EQ(ObjectMgr::ObjectCache::MAGAZINE_SIZE / 2 + 1, cached_cnt(om));
+
+  // a cache flushed recently is left alone by the idle flush
+  om.flush_object_cache(ObjectMgr::OBJECT_CACHE_IDLE_US);
+  ASSERT_EQ(ObjectMgr::ObjectCache::MAGAZINE_SIZE / 2 + 1, cached_cnt(om));
+  // but not once it stays idle
+  for (int i = 0; i < ObjectMgr::CACHE_SHARD_CNT; i++) {
+    if (om.caches_[i] != nullptr) {
+      om.caches_[i]->last_flush_ts_ = 0;
+    }
+  }
+  ObMallocAllocator::get_instance()->flush_object_cache(ObjectMgr::OBJECT_CACHE_IDLE_US);
+  ASSERT_EQ(0, cached_cnt(om));
+
+  // frees go to the sets once the cache is off
+  ObjectMgr::set_enable_object_cache(false);
+  AObject *obj = om.alloc_object(64, attr);
+  ASSERT_TRUE(obj != nullptr);
+  om.free_object(obj);
+  ASSERT_EQ(0, cached_cnt(om));
+}
+
 TEST_F(TestObjectMgr, TestSubObjectMgr)
 {
   AChunkMgr::instance().set_max_chunk_cache_cnt(0);
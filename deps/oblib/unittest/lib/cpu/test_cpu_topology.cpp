@@ -0,0 +1,126 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include <stdio.h>
+#include <unistd.h>
+#define private public
+#define protected public
+#include "lib/cpu/ob_cpu_topology.h"
+#undef protected
+#undef private
+
+using namespace oceanbase::common;
+
+class TestCpuTopology : public ::testing::Test
+{
+public:
+  virtual void SetUp()
+  {
+    snprintf(path_, sizeof(path_), "/tmp/test_cpu_topology.XXXXXX");
+    int fd = mkstemp(path_);
+    ASSERT_GE(fd, 0);
+    close(fd);
+  }
+
+  virtual void TearDown()
+  {
+    unlink(path_);
+  }
+
+  int read(const char *content, cpu_set_t &cpus)
+  {
+    FILE *file = fopen(path_, "w");
+    EXPECT_TRUE(NULL != file);
+    fputs(content, file);
+    fclose(file);
+    return ObCpuTopology::read_cpu_list(path_, cpus);
+  }
+
+  // two nodes of 4 cpus
+  static void fake_nodes(ObCpuTopology &topo)
+  {
+    topo.numa_node_cnt_ = 2;
+    for (int64_t node = 0; node < 2; ++node) {
+      CPU_ZERO(&topo.node_cpus_[node]);
+      for (int64_t cpu = node * 4; cpu < node * 4 + 4; ++cpu) {
+        CPU_SET(cpu, &topo.node_cpus_[node]);
+      }
+      topo.node_load_[node] = 0;
+    }
+  }
+
+protected:
+  char path_[64];
+};
+
+TEST_F(TestCpuTopology, read_cpu_list)
+{
+  cpu_set_t cpus;
+  ASSERT_EQ(OB_SUCCESS, read("0-3,8-11", cpus));
+  ASSERT_EQ(8, CPU_COUNT(&cpus));
+  ASSERT_TRUE(CPU_ISSET(0, &cpus));
+  ASSERT_TRUE(CPU_ISSET(3, &cpus));
+  ASSERT_FALSE(CPU_ISSET(4, &cpus));
+  ASSERT_TRUE(CPU_ISSET(11, &cpus));
+
+  ASSERT_EQ(OB_SUCCESS, read("5", cpus));
+  ASSERT_EQ(1, CPU_COUNT(&cpus));
+  ASSERT_TRUE(CPU_ISSET(5, &cpus));
+
+  ASSERT_EQ(OB_SUCCESS, read("0,2,4\n", cpus));
+  ASSERT_EQ(3, CPU_COUNT(&cpus));
+  ASSERT_TRUE(CPU_ISSET(2, &cpus));
+  ASSERT_FALSE(CPU_ISSET(1, &cpus));
+
+  // cpus beyond the cpu_set_t are dropped
+  char buf[64];
+  snprintf(buf, sizeof(buf), "1,%ld-%ld", ObCpuTopology::MAX_CPU_CNT - 1,
+           ObCpuTopology::MAX_CPU_CNT + 3);
+  ASSERT_EQ(OB_SUCCESS, read(buf, cpus));
+  ASSERT_EQ(2, CPU_COUNT(&cpus));
+
+  ASSERT_NE(OB_SUCCESS, read("", cpus));
+  ASSERT_NE(OB_SUCCESS, read("a-b", cpus));
+  ASSERT_NE(OB_SUCCESS, read("0-x", cpus));
+  ASSERT_NE(OB_SUCCESS, read("0,,1", cpus));
+  ASSERT_NE(OB_SUCCESS, ObCpuTopology::read_cpu_list("/not/exist/cpulist", cpus));
+  ASSERT_EQ(0, CPU_COUNT(&cpus));
+}
+
+TEST_F(TestCpuTopology, numa_node_load)
+{
+  ObCpuTopology topo;
+  fake_nodes(topo);
+  ASSERT_EQ(-1, topo.acquire_numa_node(5));
+  const int64_t node = topo.acquire_numa_node(2);
+  ASSERT_EQ(0, node);
+  ASSERT_EQ(1, topo.acquire_numa_node(1.5));
+  ASSERT_EQ(200, topo.node_load_[0]);
+  // grows within the node
+  ASSERT_TRUE(topo.resize_numa_node(node, 2, 4));
+  ASSERT_EQ(400, topo.node_load_[0]);
+  ASSERT_TRUE(topo.resize_numa_node(node, 4, 1));
+  ASSERT_EQ(100, topo.node_load_[0]);
+  // outgrows the node, the load placed is released
+  ASSERT_FALSE(topo.resize_numa_node(node, 1, 6));
+  ASSERT_EQ(0, topo.node_load_[0]);
+  topo.release_numa_node(1, 1.5);
+  ASSERT_EQ(0, topo.node_load_[1]);
+  ASSERT_FALSE(topo.resize_numa_node(-1, 1, 2));
+}
+
+int main(int argc, char *argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -126,6 +126,57 @@ TEST(TestPriorityQueue, WithCoro)
   tq.do_stress();
 }
 
+TEST(TestPriorityQueue, ShardedSteal)
+{
+  typedef TestQueue::QData QData;
+  ObShardedPriorityQueue2<1, 1, 1, 4> queue;
+  queue.set_shard_cnt(4);
+  QData low(1), high(2), other(3);
+  ObLink *data = NULL;
+  ASSERT_EQ(OB_SUCCESS, queue.push(&low, 2, 0));
+  ASSERT_EQ(OB_SUCCESS, queue.push(&high, 1, 3));
+  ASSERT_EQ(OB_SUCCESS, queue.push(&other, 2, 1));
+  ASSERT_EQ(3, queue.size());
+  ASSERT_EQ(2, queue.queue_size(2));
+  // a higher priority in another shard goes first
+  ASSERT_EQ(OB_SUCCESS, queue.pop(data, 0, 0));
+  ASSERT_EQ(&high, data);
+  // then the home shard
+  ASSERT_EQ(OB_SUCCESS, queue.pop(data, 0, 1));
+  ASSERT_EQ(&other, data);
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, queue.pop_high(data, 0, 1));
+  // steal from the neighbor
+  ASSERT_EQ(OB_SUCCESS, queue.pop(data, 0, 1));
+  ASSERT_EQ(&low, data);
+  ASSERT_EQ(0, queue.size());
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, queue.pop(data, 0, 2));
+}
+
+TEST(TestPriorityQueue, ShardedSingle)
+{
+  typedef TestQueue::QData QData;
+  ObShardedPriorityQueue2<1, 1, 1, 4> queue;
+  QData low(1), high(2), other(3);
+  ObLink *data = NULL;
+  queue.set_limit(2);
+  ASSERT_EQ(1, queue.get_shard_cnt());
+  // hints and home shards are ignored by the single queue
+  ASSERT_EQ(OB_SUCCESS, queue.push(&low, 2, 3));
+  ASSERT_EQ(OB_SUCCESS, queue.push(&high, 1, 1));
+  ASSERT_EQ(OB_SUCCESS, queue.push(&other, 2, 2));
+  ASSERT_EQ(OB_SIZE_OVERFLOW, queue.push(&other, 2, 2));
+  ASSERT_EQ(3, queue.size());
+  ASSERT_EQ(2, queue.queue_size(2));
+  ASSERT_EQ(OB_SUCCESS, queue.pop(data, 0, 2));
+  ASSERT_EQ(&high, data);
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, queue.pop_high(data, 0, 3));
+  ASSERT_EQ(OB_SUCCESS, queue.pop(data, 0, 3));
+  ASSERT_EQ(&low, data);
+  ASSERT_EQ(OB_SUCCESS, queue.pop(data, 0, 0));
+  ASSERT_EQ(&other, data);
+  ASSERT_EQ(0, queue.size());
+}
+
 int main(int argc, char *argv[])
 {
   oceanbase::common::ObLogger::get_logger().set_log_level("debug");
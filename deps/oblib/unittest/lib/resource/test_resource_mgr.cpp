@@ -310,6 +310,85 @@ TEST(TestTenantMemoryMgr, DISABLED_large_sync_wash)
   ASSERT_EQ(0, memory_mgr.get_sum_hold());
 }
 
+static int64_t get_huge_page_hold(const ObTenantMemoryMgr &memory_mgr, const uint64_t ctx_id)
+{
+  int64_t hold = -1;
+  EXPECT_EQ(OB_SUCCESS, memory_mgr.get_ctx_huge_page_hold(ctx_id, hold));
+  return hold;
+}
+
+TEST(TestTenantMemoryMgr, huge_page_hold)
+{
+  // thp chunks are always mapped, hugetlb ones depend on the reserved pages of the os
+  ObLargePageHelper::set_ctx_param("KVSTORE_CACHE_ID:thp,MEMSTORE_CTX_ID:thp");
+  const int64_t aligned_size = CHUNK_MGR.aligned(ACHUNK_SIZE);
+  const int64_t mb_count = 4;
+  FakeCacheWasher washer(1, ACHUNK_SIZE);
+  ObTenantMemoryMgr memory_mgr(1);
+  memory_mgr.set_limit(mb_count * aligned_size);
+  int64_t hold = 0;
+  ASSERT_EQ(OB_INVALID_ARGUMENT,
+            memory_mgr.get_ctx_huge_page_hold(ObCtxIds::MAX_CTX_ID, hold));
+  ObMemAttr attr;
+  attr.tenant_id_ = 1;
+  ObMemAttr memstore_attr;
+  memstore_attr.tenant_id_ = 1;
+  memstore_attr.ctx_id_ = ObCtxIds::MEMSTORE_CTX_ID;
+
+  // only the ctx with a policy hold huge pages
+  AChunk *chunk = memory_mgr.alloc_chunk(ACHUNK_SIZE, attr);
+  ASSERT_TRUE(NULL != chunk);
+  ASSERT_FALSE(chunk->is_ctx_huge_page_);
+  AChunk *memstore_chunk = memory_mgr.alloc_chunk(ACHUNK_SIZE, memstore_attr);
+  ASSERT_TRUE(NULL != memstore_chunk);
+  ASSERT_TRUE(memstore_chunk->is_thp_);
+  ASSERT_EQ(0, get_huge_page_hold(memory_mgr, ObCtxIds::DEFAULT_CTX_ID));
+  ASSERT_EQ(aligned_size, get_huge_page_hold(memory_mgr, ObCtxIds::MEMSTORE_CTX_ID));
+  memory_mgr.free_chunk(chunk, attr);
+  memory_mgr.free_chunk(memstore_chunk, memstore_attr);
+  ASSERT_EQ(0, get_huge_page_hold(memory_mgr, ObCtxIds::MEMSTORE_CTX_ID));
+
+  // the cache memblocks follow the policy of KVSTORE_CACHE_ID
+  for (int64_t i = 0; i < mb_count; ++i) {
+    ASSERT_EQ(OB_SUCCESS, washer.alloc_mb(memory_mgr));
+  }
+  ASSERT_EQ(mb_count * aligned_size, get_huge_page_hold(memory_mgr, ObCtxIds::KVSTORE_CACHE_ID));
+  memory_mgr.set_cache_washer(washer);
+
+  // a washed memblock is handed over to a ctx of the same policy
+  memstore_chunk = memory_mgr.alloc_chunk(ACHUNK_SIZE, memstore_attr);
+  ASSERT_TRUE(NULL != memstore_chunk);
+  ASSERT_TRUE(memstore_chunk->is_thp_);
+  ASSERT_EQ((mb_count - 1) * aligned_size, memory_mgr.get_cache_hold());
+  ASSERT_EQ((mb_count - 1) * aligned_size,
+            get_huge_page_hold(memory_mgr, ObCtxIds::KVSTORE_CACHE_ID));
+  ASSERT_EQ(aligned_size, get_huge_page_hold(memory_mgr, ObCtxIds::MEMSTORE_CTX_ID));
+
+  // but returned to the os for a ctx of another policy, which gets a chunk of its own
+  const int64_t pushes = CHUNK_MGR.free_list_.get_pushes();
+  chunk = memory_mgr.alloc_chunk(ACHUNK_SIZE, attr);
+  ASSERT_TRUE(NULL != chunk);
+  ASSERT_FALSE(chunk->is_thp_);
+  ASSERT_FALSE(chunk->is_ctx_huge_page_);
+  ASSERT_EQ(pushes, CHUNK_MGR.free_list_.get_pushes());
+  ASSERT_EQ((mb_count - 2) * aligned_size, memory_mgr.get_cache_hold());
+  ASSERT_EQ((mb_count - 2) * aligned_size,
+            get_huge_page_hold(memory_mgr, ObCtxIds::KVSTORE_CACHE_ID));
+  ASSERT_EQ(0, get_huge_page_hold(memory_mgr, ObCtxIds::DEFAULT_CTX_ID));
+  ASSERT_EQ(mb_count * aligned_size, memory_mgr.get_sum_hold());
+
+  memory_mgr.free_chunk(chunk, attr);
+  memory_mgr.free_chunk(memstore_chunk, memstore_attr);
+  washer.free_mbs(memory_mgr);
+  for (int64_t i = 0; i < ObCtxIds::MAX_CTX_ID; ++i) {
+    ASSERT_EQ(0, get_huge_page_hold(memory_mgr, i));
+    ASSERT_EQ(0, memory_mgr.get_ctx_hold_bytes()[i]);
+  }
+  ASSERT_EQ(0, memory_mgr.get_cache_hold());
+  ASSERT_EQ(0, memory_mgr.get_sum_hold());
+  ObLargePageHelper::set_ctx_param("");
+}
+
 TEST(TestResourceMgr, basic)
 {
   ObResourceMgr mgr;
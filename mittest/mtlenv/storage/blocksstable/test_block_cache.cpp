@@ -33,6 +33,17 @@ public:
 
   virtual void SetUp();
   virtual void TearDown();
+  virtual void prepare_schema();
+  static void fill_callback(
+      const ObMicroIndexInfo &idx_info,
+      ObIMicroBlockCache &cache,
+      const ObTableReadInfo &read_info,
+      ObSingleMicroBlockIOCallback &callback);
+  static void read_block(
+      const MacroBlockId &macro_id,
+      const int64_t align_offset,
+      const int64_t align_size,
+      char *io_buf);
 protected:
   ObDataMicroBlockCache *data_block_cache_;
   ObIndexMicroBlockCache *index_block_cache_;
@@ -81,6 +92,60 @@ void TestObMicroBlockCache::TearDown()
   TestIndexBlockDataPrepare::TearDown();
 }
 
+void TestObMicroBlockCache::prepare_schema()
+{
+  TestIndexBlockDataPrepare::prepare_schema();
+  // data blocks of the default size, which are read into cache slots directly
+  table_schema_.set_block_size(OB_DEFAULT_SSTABLE_BLOCK_SIZE);
+}
+
+// fill the callback as ObIMicroBlockCache::prefetch does
+void TestObMicroBlockCache::fill_callback(
+    const ObMicroIndexInfo &idx_info,
+    ObIMicroBlockCache &cache,
+    const ObTableReadInfo &read_info,
+    ObSingleMicroBlockIOCallback &callback)
+{
+  const ObIndexBlockRowHeader *idx_header = idx_info.row_header_;
+  ASSERT_NE(nullptr, idx_header);
+  ASSERT_EQ(OB_SUCCESS, cache.get_allocator(callback.allocator_));
+  callback.cache_ = &cache;
+  callback.put_size_stat_ = &cache;
+  callback.read_info_ = &read_info;
+  callback.tenant_id_ = MTL_ID();
+  callback.block_id_ = idx_info.get_macro_id();
+  callback.offset_ = idx_info.get_block_offset();
+  callback.size_ = idx_info.get_block_size();
+  callback.row_store_type_ = idx_info.get_row_store_type();
+  callback.block_des_meta_.compressor_type_ = idx_header->get_compressor_type();
+  callback.block_des_meta_.encrypt_id_ = idx_header->get_encrypt_id();
+  callback.block_des_meta_.master_key_id_ = idx_header->get_master_key_id();
+  callback.block_des_meta_.encrypt_key_ = idx_header->get_encrypt_key();
+  callback.use_block_cache_ = true;
+  callback.need_write_extra_buf_ = idx_header->is_data_index()
+                                   && (!idx_header->is_data_block()
+                                       || (ObStoreFormat::is_row_store_type_with_encoding(idx_header->get_row_store_type())));
+}
+
+// the io into the buffer given by the callback
+void TestObMicroBlockCache::read_block(
+    const MacroBlockId &macro_id,
+    const int64_t align_offset,
+    const int64_t align_size,
+    char *io_buf)
+{
+  ObMacroBlockReadInfo read_info;
+  ObMacroBlockHandle macro_handle;
+  read_info.macro_block_id_ = macro_id;
+  read_info.io_desc_.set_wait_event(ObWaitEventIds::DB_FILE_DATA_READ);
+  read_info.offset_ = align_offset;
+  read_info.size_ = align_size;
+  ASSERT_NE(nullptr, io_buf);
+  ASSERT_EQ(OB_SUCCESS, ObBlockManager::read_block(read_info, macro_handle));
+  ASSERT_EQ(align_size, macro_handle.get_data_size());
+  MEMCPY(io_buf, macro_handle.get_buffer(), align_size);
+}
+
 TEST_F(TestObMicroBlockCache, test_block_cache)
 {
   // cache key basic func
@@ -284,6 +349,129 @@ TEST_F(TestObMicroBlockCache, test_block_cache)
   ASSERT_TRUE(loaded_index_data.get_micro_header()->is_valid());
 }
 
+TEST_F(TestObMicroBlockCache, test_read_into_cache)
+{
+  ObMacroBlockHandle idx_io_handle;
+  ObIndexBlockRowScanner idx_row_scanner;
+  ObMicroBlockData root_block;
+  ObMicroIndexInfo micro_idx_info;
+  ObMicroIndexInfo data_idx_info;
+  ObArray<int32_t> agg_projector;
+  ObArray<ObColumnSchemaV2> agg_column_schema;
+  ObDatumRange full_range;
+  full_range.set_whole_range();
+  sstable_.get_index_tree_root(tablet_handle_.get_obj()->get_index_read_info(), root_block);
+  ASSERT_EQ(OB_SUCCESS, idx_row_scanner.init(
+      agg_projector,
+      agg_column_schema,
+      &tablet_handle_.get_obj()->get_index_read_info(),
+      allocator_,
+      context_.query_flag_,
+      0));
+  ASSERT_EQ(OB_SUCCESS, idx_row_scanner.open(
+      ObIndexBlockRowHeader::DEFAULT_IDX_ROW_MACRO_ID, root_block, ObDatumRowkey::MIN_ROWKEY));
+  ASSERT_EQ(OB_SUCCESS, idx_row_scanner.get_next(micro_idx_info));
+  ASSERT_TRUE(micro_idx_info.is_leaf_block());
+  ASSERT_EQ(OB_SUCCESS, index_block_cache_->prefetch(
+      MTL_ID(),
+      micro_idx_info.get_macro_id(),
+      micro_idx_info,
+      context_.query_flag_,
+      tablet_handle_.get_obj()->get_index_read_info(),
+      tablet_handle_,
+      idx_io_handle));
+  ASSERT_EQ(OB_SUCCESS, idx_io_handle.wait(DEFAULT_IO_WAIT_TIME_MS));
+  ObMicroBlockData leaf_block = *reinterpret_cast<const ObMicroBlockData*>(idx_io_handle.get_buffer());
+  idx_row_scanner.reuse();
+  ASSERT_EQ(OB_SUCCESS, idx_row_scanner.open(
+      micro_idx_info.get_macro_id(), leaf_block, full_range, 0, true, true));
+  // the largest data block of the leaf
+  int tmp_ret = OB_SUCCESS;
+  while (OB_SUCCESS == (tmp_ret = idx_row_scanner.get_next(micro_idx_info))) {
+    if (!data_idx_info.is_valid() || micro_idx_info.get_block_size() > data_idx_info.get_block_size()) {
+      data_idx_info = micro_idx_info;
+    }
+  }
+  ASSERT_EQ(OB_ITER_END, tmp_ret);
+  ASSERT_TRUE(data_idx_info.is_data_block());
+  ASSERT_LE(3 * DIO_READ_ALIGN_SIZE, data_idx_info.get_block_size());
+  const MacroBlockId &macro_id = data_idx_info.get_macro_id();
+  const int64_t offset = data_idx_info.get_block_offset();
+  const int64_t size = data_idx_info.get_block_size();
+  const ObTableReadInfo &full_read_info = tablet_handle_.get_obj()->get_full_read_info();
+  ObIMicroBlockCache::BaseBlockCache *kvcache = nullptr;
+  ASSERT_EQ(OB_SUCCESS, data_block_cache_->get_cache(kvcache));
+  const ObMicroBlockCacheKey key(MTL_ID(), macro_id, offset, size);
+  const int erase_ret = kvcache->erase(key);
+  ASSERT_TRUE(OB_SUCCESS == erase_ret || OB_ENTRY_NOT_EXIST == erase_ret);
+  ObMicroBlockBufferHandle buf_handle;
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, data_block_cache_->get_cache_block(MTL_ID(), macro_id, offset, size, buf_handle));
+
+  // fallback, the block is not read into cache
+  char *io_buf = nullptr;
+  int64_t align_size = 0;
+  int64_t align_offset = 0;
+  {
+    ObSingleMicroBlockIOCallback callback;
+    fill_callback(data_idx_info, *data_block_cache_, full_read_info, callback);
+    callback.use_block_cache_ = false;
+    ASSERT_EQ(OB_SUCCESS, callback.alloc_io_buf(io_buf, align_size, align_offset));
+    ASSERT_EQ(nullptr, callback.kvpair_);
+    ASSERT_NE(nullptr, callback.io_buffer_);
+    read_block(macro_id, align_offset, align_size, io_buf);
+    ASSERT_EQ(OB_SUCCESS, callback.inner_process(true));
+    ASSERT_NE(nullptr, callback.micro_block_);
+    ASSERT_FALSE(callback.cache_handle_.is_valid());
+    ASSERT_EQ(data_idx_info.get_row_count(), callback.micro_block_->get_block_data().get_micro_header()->row_count_);
+    ASSERT_EQ(OB_ENTRY_NOT_EXIST, data_block_cache_->get_cache_block(MTL_ID(), macro_id, offset, size, buf_handle));
+    // compressed blocks, small blocks and index blocks take the old path too
+    callback.use_block_cache_ = true;
+    ASSERT_TRUE(callback.can_read_into_cache(align_size));
+    callback.block_des_meta_.compressor_type_ = ObCompressorType::LZ4_COMPRESSOR;
+    ASSERT_FALSE(callback.can_read_into_cache(align_size));
+    callback.block_des_meta_.compressor_type_ = ObCompressorType::NONE_COMPRESSOR;
+    callback.size_ = DIO_READ_ALIGN_SIZE / 2;
+    ASSERT_FALSE(callback.can_read_into_cache(DIO_READ_ALIGN_SIZE));
+    callback.size_ = size;
+    callback.cache_ = index_block_cache_;
+    ASSERT_FALSE(callback.can_read_into_cache(align_size));
+    callback.cache_ = data_block_cache_;
+  }
+
+  // miss, the block is read into the reserved slot, which is put as is
+  const ObMicroBlockCacheValue *cached_block = nullptr;
+  ObSingleMicroBlockIOCallback miss_callback;
+  fill_callback(data_idx_info, *data_block_cache_, full_read_info, miss_callback);
+  ASSERT_EQ(OB_SUCCESS, miss_callback.alloc_io_buf(io_buf, align_size, align_offset));
+  ASSERT_NE(nullptr, miss_callback.kvpair_);
+  ASSERT_EQ(nullptr, miss_callback.io_buffer_);
+  ASSERT_EQ(io_buf + (offset - align_offset), miss_callback.data_buffer_);
+  read_block(macro_id, align_offset, align_size, io_buf);
+  ASSERT_EQ(OB_SUCCESS, miss_callback.inner_process(true));
+  ASSERT_EQ(nullptr, miss_callback.kvpair_);
+  ASSERT_TRUE(miss_callback.cache_handle_.is_valid());
+  ASSERT_NE(nullptr, cached_block = miss_callback.micro_block_);
+  ASSERT_EQ(miss_callback.data_buffer_, cached_block->get_block_data().get_buf());
+  ASSERT_EQ(size, cached_block->get_block_data().get_buf_size());
+  ASSERT_EQ(data_idx_info.get_row_count(), cached_block->get_block_data().get_micro_header()->row_count_);
+  ASSERT_EQ(OB_SUCCESS, data_block_cache_->get_cache_block(MTL_ID(), macro_id, offset, size, buf_handle));
+  ASSERT_EQ(cached_block->get_block_data().get_buf(), buf_handle.get_block_data()->get_buf());
+  ASSERT_EQ(cached_block->get_block_data().get_extra_size(), buf_handle.get_block_data()->get_extra_size());
+
+  // hit, no slot is reserved and the cached block is kept
+  ObSingleMicroBlockIOCallback hit_callback;
+  fill_callback(data_idx_info, *data_block_cache_, full_read_info, hit_callback);
+  ASSERT_EQ(OB_SUCCESS, hit_callback.alloc_io_buf(io_buf, align_size, align_offset));
+  ASSERT_EQ(nullptr, hit_callback.kvpair_);
+  ASSERT_NE(nullptr, hit_callback.io_buffer_);
+  ASSERT_EQ(cached_block, hit_callback.micro_block_);
+  ASSERT_TRUE(hit_callback.cache_handle_.is_valid());
+  read_block(macro_id, align_offset, align_size, io_buf);
+  ASSERT_EQ(OB_SUCCESS, hit_callback.inner_process(true));
+  ASSERT_EQ(nullptr, hit_callback.io_buffer_);
+  ASSERT_EQ(cached_block, hit_callback.micro_block_);
+  ASSERT_EQ(reinterpret_cast<const char *>(&cached_block->get_block_data()), hit_callback.get_data());
+}
 
 } // blocksstable
 } // oceanbase
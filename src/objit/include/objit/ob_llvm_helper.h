@@ -395,6 +395,10 @@ public:
   int create_add(ObLLVMValue &value1, int64_t &value2, ObLLVMValue &result);
   int create_sub(ObLLVMValue &value1, ObLLVMValue &value2, ObLLVMValue &result);
   int create_sub(ObLLVMValue &value1, int64_t &value2, ObLLVMValue &result);
+  int create_and(ObLLVMValue &value1, ObLLVMValue &value2, ObLLVMValue &result);
+  int create_or(ObLLVMValue &value1, ObLLVMValue &value2, ObLLVMValue &result);
+  int create_shl(ObLLVMValue &value1, ObLLVMValue &value2, ObLLVMValue &result);
+  int create_lshr(ObLLVMValue &value1, ObLLVMValue &value2, ObLLVMValue &result);
   int create_ret(ObLLVMValue &value);
   int create_gep(const common::ObString &name, ObLLVMValue &value, common::ObIArray<int64_t> &idxs, ObLLVMValue &result);
   int create_gep(const common::ObString &name, ObLLVMValue &value, common::ObIArray<ObLLVMValue> &idxs, ObLLVMValue &result);
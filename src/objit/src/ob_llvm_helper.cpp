@@ -1242,6 +1242,33 @@ int ObLLVMHelper::create_##name(ObLLVMValue &value1, int64_t &value2, ObLLVMValu
 DEFINE_CREATE_ARITH_INT(add)
 DEFINE_CREATE_ARITH_INT(sub)
 
+#define DEFINE_CREATE_BINARY_OP(name, builder_func) \
+int ObLLVMHelper::create_##name(ObLLVMValue &value1, ObLLVMValue &value2, ObLLVMValue &result) \
+{ \
+  int ret = OB_SUCCESS; \
+  if (OB_ISNULL(jc_)) { \
+    ret = OB_NOT_INIT; \
+    LOG_WARN("jc is NULL", K(ret)); \
+  } else if (OB_ISNULL(value1.get_v()) || OB_ISNULL(value2.get_v())) { \
+    ret = OB_INVALID_ARGUMENT; \
+    LOG_WARN("value is NULL", K(value1), K(value2), K(ret)); \
+  } else { \
+    llvm::Value *value = jc_->get_builder().builder_func(value1.get_v(), value2.get_v()); \
+    if (OB_ISNULL(value)) { \
+      ret = OB_ERR_UNEXPECTED; \
+      LOG_WARN("failed to create " #name, K(ret)); \
+    } else { \
+      result.set_v(value); \
+    } \
+  } \
+  return ret; \
+}
+
+DEFINE_CREATE_BINARY_OP(and, CreateAnd)
+DEFINE_CREATE_BINARY_OP(or, CreateOr)
+DEFINE_CREATE_BINARY_OP(shl, CreateShl)
+DEFINE_CREATE_BINARY_OP(lshr, CreateLShr)
+
 int ObLLVMHelper::create_ret(ObLLVMValue &value)
 {
   int ret = OB_SUCCESS;
@@ -0,0 +1,413 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SERVER
+#include "observer/mysql/ob_hot_row_update_combiner.h"
+#include "lib/hash_func/murmur_hash.h"
+#include "lib/mysqlclient/ob_mysql_proxy.h"
+#include "lib/time/ob_time_utility.h"
+#include "lib/worker.h"
+#include "share/schema/ob_schema_getter_guard.h"
+#include "sql/session/ob_sql_session_info.h"
+#include "observer/ob_server_struct.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace share::schema;
+using namespace sql;
+namespace observer
+{
+
+bool ObHotRowUpdateCombiner::Group::can_join(const uint64_t tenant_id,
+                                             const uint64_t hash,
+                                             const ObString &key,
+                                             const int64_t delta) const
+{
+  return tenant_id_ == tenant_id
+      && hash_ == hash
+      && key_ == key
+      && member_cnt_ < MAX_GROUP_SIZE
+      && ((delta_ > 0 && delta > 0 && delta_ <= INT64_MAX - delta)
+          || (delta_ < 0 && delta < 0 && delta_ >= INT64_MIN - delta));
+}
+
+ObHotRowUpdateCombiner &ObHotRowUpdateCombiner::get_instance()
+{
+  static ObHotRowUpdateCombiner instance;
+  return instance;
+}
+
+int ObHotRowUpdateCombiner::combine(const ObSQLSessionInfo &session,
+                                    const ObHotRowUpdateInfo &info,
+                                    const common::ParamStore &params,
+                                    ObSchemaGetterGuard &schema_guard,
+                                    const int64_t window_us,
+                                    bool &combined,
+                                    int &result_code,
+                                    int64_t &affected_rows)
+{
+  int ret = OB_SUCCESS;
+  const uint64_t tenant_id = session.get_effective_tenant_id();
+  ObSqlString prefix;
+  ObSqlString suffix;
+  ObSqlString key;
+  int64_t delta = 0;
+  bool is_valid = false;
+  combined = false;
+  result_code = OB_SUCCESS;
+  affected_rows = 0;
+  if (OB_UNLIKELY(!info.is_valid() || window_us <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(info), K(window_us));
+  } else if (OB_FAIL(build_sql_(tenant_id, info, params, schema_guard,
+                                prefix, suffix, delta, is_valid))) {
+    LOG_WARN("failed to build sql", K(ret), K(info));
+  } else if (!is_valid) {
+    // not combinable, e.g. a null or long rowkey value
+  } else if (OB_FAIL(build_key_(prefix, suffix, session.get_sql_mode(),
+                                session.get_local_collation_connection(),
+                                session.get_tz_info_wrap(), key))) {
+    LOG_WARN("failed to build key", K(ret));
+  } else {
+    const uint64_t hash = murmurhash(key.ptr(), key.length(), tenant_id);
+    Slot &slot = slots_[hash % SLOT_CNT];
+    Group group;
+    Group *joined = NULL;
+    bool is_leader = false;
+    group.sql_mode_ = static_cast<int64_t>(session.get_sql_mode());
+    group.tz_info_wrap_ = &session.get_tz_info_wrap();
+    if (OB_FAIL(group.cond_.init(ObWaitEventIds::DEFAULT_COND_WAIT))) {
+      LOG_WARN("failed to init cond", K(ret));
+    } else {
+      ObSpinLockGuard guard(slot.lock_);
+      enter_slot_(slot, group, tenant_id, hash, key.string(), delta, window_us,
+                  joined, is_leader);
+    }
+    if (OB_FAIL(ret)) {
+    } else if (is_leader) {
+      lead_group_(slot, group, prefix, suffix, window_us);
+      combined = group.combined_;
+      result_code = group.result_code_;
+      affected_rows = group.affected_rows_;
+    } else if (NULL != joined) {
+      wait_group_(slot, *joined, delta, combined, result_code, affected_rows);
+    }
+  }
+  return ret;
+}
+
+void ObHotRowUpdateCombiner::enter_slot_(Slot &slot,
+                                         Group &group,
+                                         const uint64_t tenant_id,
+                                         const uint64_t hash,
+                                         const ObString &key,
+                                         const int64_t delta,
+                                         const int64_t window_us,
+                                         Group *&joined,
+                                         bool &is_leader)
+{
+  const int64_t now = ObTimeUtility::current_time();
+  joined = NULL;
+  is_leader = false;
+  if (NULL == slot.group_) {
+    if (slot.last_hash_ == hash && now - slot.last_arrival_ts_ < window_us) {
+      group.tenant_id_ = tenant_id;
+      group.hash_ = hash;
+      group.key_ = key;
+      group.delta_ = delta;
+      group.member_cnt_ = 1;
+      slot.group_ = &group;
+      is_leader = true;
+    } else {
+      // no other update on the row lately, waiting would only add latency
+    }
+  } else if (slot.group_->can_join(tenant_id, hash, key, delta)) {
+    joined = slot.group_;
+    joined->delta_ += delta;
+    joined->member_cnt_++;
+    joined->waiter_cnt_++;
+  } else {
+    // another row or a delta of the other sign, execute by itself
+  }
+  slot.last_hash_ = hash;
+  slot.last_arrival_ts_ = now;
+}
+
+void ObHotRowUpdateCombiner::lead_group_(Slot &slot,
+                                         Group &group,
+                                         const ObSqlString &prefix,
+                                         const ObSqlString &suffix,
+                                         const int64_t window_us)
+{
+  int ret = OB_SUCCESS;
+  ObSqlString sql;
+  ObSessionParam session_param;
+  ObTimeZoneInfoWrap tz_info_wrap;
+  int64_t affected_rows = 0;
+  const int64_t sleep_us = MIN(window_us, THIS_WORKER.get_timeout_remain());
+  if (sleep_us > 0) {
+    // the run slot of the tenant is not held while collecting the members
+    THIS_WORKER.sched_wait();
+    ob_usleep(static_cast<useconds_t>(sleep_us));
+    THIS_WORKER.sched_run();
+  }
+  {
+    // close the group, its delta and members are final from now on
+    ObSpinLockGuard guard(slot.lock_);
+    slot.group_ = NULL;
+    if (1 == group.member_cnt_) {
+      // nobody joined, the row has to show contention again before the next window
+      slot.last_arrival_ts_ = 0;
+    }
+  }
+  if (1 == group.member_cnt_) {
+    // nothing to merge
+  } else if (OB_FAIL(check_status_())) {
+    // the members execute by themselves
+    LOG_WARN("leader stopped before the combined update", K(ret), K(group));
+  } else if (OB_ISNULL(GCTX.sql_proxy_) || OB_ISNULL(group.tz_info_wrap_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("sql proxy or time zone is null", K(ret), KP(group.tz_info_wrap_));
+  } else if (OB_FAIL(tz_info_wrap.deep_copy(*group.tz_info_wrap_))) {
+    LOG_WARN("failed to copy time zone", K(ret));
+  } else if (OB_FAIL(sql.append_fmt("%.*s%ld%.*s",
+                                    static_cast<int>(prefix.length()), prefix.ptr(),
+                                    group.delta_,
+                                    static_cast<int>(suffix.length()), suffix.ptr()))) {
+    LOG_WARN("failed to build sql", K(ret));
+  } else if (FALSE_IT(session_param.sql_mode_ = &group.sql_mode_)) {
+  } else if (FALSE_IT(session_param.tz_info_wrap_ = &tz_info_wrap)) {
+  } else if (OB_FAIL(GCTX.sql_proxy_->write(group.tenant_id_, sql.string(), affected_rows,
+                                            ObCompatibilityMode::MYSQL_MODE,
+                                            &session_param))) {
+    LOG_WARN("failed to execute combined update", K(ret), K(sql), K(group));
+  } else {
+    LOG_TRACE("combined hot row update", K(sql), K(group), K(affected_rows));
+  }
+  ObThreadCondGuard guard(group.cond_);
+  if (1 == group.member_cnt_) {
+    group.combined_ = false;
+  } else if (OB_SUCC(ret)) {
+    group.combined_ = true;
+    group.affected_rows_ = affected_rows;
+  } else if (OB_TRANS_UNKNOWN == ret) {
+    // the deltas may have been applied, none of the members can execute again
+    group.combined_ = true;
+    group.result_code_ = ret;
+  } else {
+    group.combined_ = false;
+  }
+  group.is_done_ = true;
+  group.cond_.broadcast();
+  while (group.waiter_cnt_ > 0) {
+    group.cond_.wait(WAIT_INTERVAL_MS);
+  }
+}
+
+void ObHotRowUpdateCombiner::wait_group_(Slot &slot,
+                                         Group &group,
+                                         const int64_t delta,
+                                         bool &combined,
+                                         int &result_code,
+                                         int64_t &affected_rows)
+{
+  int ret = OB_SUCCESS;
+  bool is_withdrawn = false;
+  // the slot is given back out of the group lock, not to hold the lock while waiting for it
+  THIS_WORKER.sched_wait();
+  {
+    ObThreadCondGuard guard(group.cond_);
+    while (OB_SUCC(ret) && !group.is_done_) {
+      group.cond_.wait(WAIT_INTERVAL_MS);
+      if (!group.is_done_ && OB_FAIL(check_status_())) {
+        LOG_WARN("stop waiting for the combined update", K(ret), K(group));
+      }
+    }
+  }
+  THIS_WORKER.sched_run();
+  if (OB_FAIL(ret)) {
+    // the leader does not leave before all the members, so the group is still there
+    ObSpinLockGuard guard(slot.lock_);
+    if (slot.group_ == &group) {
+      group.delta_ -= delta;
+      group.member_cnt_--;
+      group.waiter_cnt_--;
+      is_withdrawn = true;
+    }
+  }
+  if (is_withdrawn) {
+    // executed by itself, which fails the same way
+    combined = false;
+  } else {
+    ObThreadCondGuard guard(group.cond_);
+    if (group.is_done_) {
+      combined = group.combined_;
+      result_code = group.result_code_;
+      affected_rows = group.affected_rows_;
+    } else {
+      // the combined update is running and may still apply the delta
+      combined = true;
+      result_code = OB_TRANS_UNKNOWN;
+    }
+    if (0 == --group.waiter_cnt_) {
+      group.cond_.broadcast();
+    }
+  }
+}
+
+int ObHotRowUpdateCombiner::check_status_()
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(SS_STOPPING == GCTX.status_ || SS_STOPPED == GCTX.status_)) {
+    ret = OB_SERVER_IS_STOPPING;
+  } else if (THIS_WORKER.is_timeout()) {
+    ret = OB_TIMEOUT;
+  } else if (OB_FAIL(THIS_WORKER.check_status())) {
+    // killed
+  }
+  return ret;
+}
+
+int ObHotRowUpdateCombiner::build_sql_(const uint64_t tenant_id,
+                                       const ObHotRowUpdateInfo &info,
+                                       const common::ParamStore &params,
+                                       ObSchemaGetterGuard &schema_guard,
+                                       ObSqlString &prefix,
+                                       ObSqlString &suffix,
+                                       int64_t &delta,
+                                       bool &is_valid)
+{
+  int ret = OB_SUCCESS;
+  const ObTableSchema *table_schema = NULL;
+  const ObDatabaseSchema *database_schema = NULL;
+  const ObColumnSchemaV2 *column_schema = NULL;
+  is_valid = false;
+  delta = 0;
+  if (OB_UNLIKELY(info.delta_param_idx_ < 0 || info.delta_param_idx_ >= params.count())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("invalid delta param idx", K(ret), K(info), K(params.count()));
+  } else if (!ob_is_int_tc(params.at(info.delta_param_idx_).get_type())) {
+    // e.g. c = c + 1.5, not merged
+  } else if (FALSE_IT(delta = params.at(info.delta_param_idx_).get_int())) {
+  } else if (0 == delta || INT64_MIN == delta) {
+    // a zero delta changes nothing, it is not merged to keep the affected rows right
+  } else if (OB_FAIL(schema_guard.get_table_schema(tenant_id, info.table_id_, table_schema))) {
+    LOG_WARN("failed to get table schema", K(ret), K(info));
+  } else if (OB_ISNULL(table_schema)) {
+    ret = OB_TABLE_NOT_EXIST;
+    LOG_WARN("table schema is null", K(ret), K(info));
+  } else if (OB_FAIL(schema_guard.get_database_schema(tenant_id,
+                                                      table_schema->get_database_id(),
+                                                      database_schema))) {
+    LOG_WARN("failed to get database schema", K(ret), K(info));
+  } else if (OB_ISNULL(database_schema)
+             || OB_ISNULL(column_schema = table_schema->get_column_schema(info.column_id_))) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("schema is null", K(ret), K(info), KP(database_schema), KP(column_schema));
+  } else {
+    delta = info.is_minus_ ? -delta : delta;
+    is_valid = true;
+    if (OB_FAIL(prefix.append("UPDATE "))) {
+    } else if (OB_FAIL(append_name_(database_schema->get_database_name_str(), prefix, is_valid))) {
+    } else if (OB_FAIL(prefix.append("."))) {
+    } else if (OB_FAIL(append_name_(table_schema->get_table_name_str(), prefix, is_valid))) {
+    } else if (OB_FAIL(prefix.append(" SET "))) {
+    } else if (OB_FAIL(append_name_(column_schema->get_column_name_str(), prefix, is_valid))) {
+    } else if (OB_FAIL(prefix.append(" = "))) {
+    } else if (OB_FAIL(append_name_(column_schema->get_column_name_str(), prefix, is_valid))) {
+    } else if (OB_FAIL(prefix.append(" + "))) {
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && is_valid && i < info.rowkey_cnt_; ++i) {
+      const int64_t param_idx = info.rowkey_param_idxs_[i];
+      if (OB_UNLIKELY(param_idx < 0 || param_idx >= params.count())) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("invalid rowkey param idx", K(ret), K(info), K(i), K(params.count()));
+      } else if (OB_ISNULL(column_schema = table_schema->get_column_schema(
+                      info.rowkey_column_ids_[i]))) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("rowkey column schema is null", K(ret), K(info), K(i));
+      } else if (OB_FAIL(append_predicate_(column_schema->get_column_name_str(),
+                                           params.at(param_idx), suffix, is_valid))) {
+      }
+    }
+    if (OB_FAIL(ret)) {
+      LOG_WARN("failed to build sql", K(ret), K(info));
+    }
+  }
+  return ret;
+}
+
+// The literals are printed in utf8mb4, the charset of the inner session, and compare in
+// the collation of their columns, still only the statements of the same connection
+// collation are merged.
+int ObHotRowUpdateCombiner::build_key_(const ObSqlString &prefix,
+                                       const ObSqlString &suffix,
+                                       const uint64_t sql_mode,
+                                       const ObCollationType collation,
+                                       const ObTimeZoneInfoWrap &tz_info_wrap,
+                                       ObSqlString &key)
+{
+  int ret = OB_SUCCESS;
+  const ObTimeZoneInfo *tz_info = tz_info_wrap.get_time_zone_info();
+  key.reset();
+  if (OB_FAIL(key.append_fmt("%.*s?%.*s",
+                             static_cast<int>(prefix.length()), prefix.ptr(),
+                             static_cast<int>(suffix.length()), suffix.ptr()))) {
+    LOG_WARN("failed to append sql", K(ret));
+  } else if (OB_FAIL(key.append_fmt(" /* %lu %d %d %d */", sql_mode,
+                                    static_cast<int>(collation),
+                                    NULL == tz_info ? -1 : tz_info->get_tz_id(),
+                                    NULL == tz_info ? 0 : tz_info->get_offset()))) {
+    LOG_WARN("failed to append session settings", K(ret));
+  }
+  return ret;
+}
+
+int ObHotRowUpdateCombiner::append_predicate_(const ObString &column_name,
+                                              const ObObjParam &value,
+                                              ObSqlString &suffix,
+                                              bool &is_valid)
+{
+  int ret = OB_SUCCESS;
+  char buf[MAX_LITERAL_LEN];
+  int64_t pos = 0;
+  if (!ob_is_int_tc(value.get_type())
+      && !ob_is_uint_tc(value.get_type())
+      && !ob_is_varchar_char_type(value.get_type(), value.get_collation_type())) {
+    is_valid = false;
+  } else if (OB_SUCCESS != value.print_sql_literal(buf, sizeof(buf), pos)) {
+    // too long to be worth merging
+    is_valid = false;
+  } else if (OB_FAIL(suffix.append(suffix.empty() ? " WHERE " : " AND "))) {
+  } else if (OB_FAIL(append_name_(column_name, suffix, is_valid))) {
+  } else if (OB_FAIL(suffix.append(" = "))) {
+  } else if (OB_FAIL(suffix.append(buf, pos))) {
+  }
+  return ret;
+}
+
+int ObHotRowUpdateCombiner::append_name_(const ObString &name,
+                                         ObSqlString &sql,
+                                         bool &is_valid)
+{
+  int ret = OB_SUCCESS;
+  if (NULL != name.find('`')) {
+    is_valid = false;
+  } else if (OB_FAIL(sql.append_fmt("`%.*s`", name.length(), name.ptr()))) {
+    LOG_WARN("failed to append name", K(ret), K(name));
+  }
+  return ret;
+}
+
+} // namespace observer
+} // namespace oceanbase
@@ -0,0 +1,180 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_OBSERVER_MYSQL_OB_HOT_ROW_UPDATE_COMBINER_H_
+#define OCEANBASE_OBSERVER_MYSQL_OB_HOT_ROW_UPDATE_COMBINER_H_
+
+#include "lib/lock/ob_spin_lock.h"
+#include "lib/lock/ob_thread_cond.h"
+#include "lib/string/ob_sql_string.h"
+#include "sql/engine/ob_physical_plan.h"
+
+namespace oceanbase
+{
+namespace common
+{
+class ObTimeZoneInfoWrap;
+}
+namespace sql
+{
+class ObSQLSessionInfo;
+}
+namespace share
+{
+namespace schema
+{
+class ObSchemaGetterGuard;
+}
+}
+namespace observer
+{
+
+// Merges the autocommit UPDATE t SET c = c +/- ? WHERE pk = ? on the same row.
+//
+// A statement on a row updated by another one less than a window ago becomes the leader
+// of a group and waits the window, the ones arriving in the window join the group by
+// adding their delta, the others are executed at once without waiting. The leader then
+// applies the sum of the deltas in one inner transaction, so the row lock and the commit
+// log are paid once for the whole group, and every member answers its client with the
+// result of the merged update. Only deltas of the same sign are merged, the row matched
+// by all of them is then changed by each of them as well. Only statements of sessions
+// sharing the sql_mode, the connection collation and the time zone are merged, and the
+// merged update runs with the sql_mode and the time zone of the leader.
+//
+// If the merged update fails, each member executes its own statement as usual, except
+// when the outcome of the merged transaction is unknown, then all of them report it.
+// A member timed out or killed while waiting takes its delta back if the group is still
+// open, otherwise it reports the outcome as unknown.
+class ObHotRowUpdateCombiner
+{
+public:
+  static const int64_t SLOT_CNT = 1024;
+  static const int64_t MAX_GROUP_SIZE = 1024;
+
+  static ObHotRowUpdateCombiner &get_instance();
+
+  // %combined is false when the statement is not merged and should be executed by itself,
+  // otherwise %result_code and %affected_rows are its result.
+  int combine(const sql::ObSQLSessionInfo &session,
+              const sql::ObHotRowUpdateInfo &info,
+              const common::ParamStore &params,
+              share::schema::ObSchemaGetterGuard &schema_guard,
+              const int64_t window_us,
+              bool &combined,
+              int &result_code,
+              int64_t &affected_rows);
+
+private:
+  static const int64_t WAIT_INTERVAL_MS = 10;
+  static const int64_t MAX_LITERAL_LEN = 512;
+  struct Group
+  {
+    Group()
+      : tenant_id_(common::OB_INVALID_TENANT_ID), hash_(0), key_(), delta_(0),
+        member_cnt_(0), waiter_cnt_(0), is_done_(false), combined_(false),
+        result_code_(common::OB_SUCCESS), affected_rows_(0), sql_mode_(0),
+        tz_info_wrap_(NULL) {}
+    bool can_join(const uint64_t tenant_id,
+                  const uint64_t hash,
+                  const common::ObString &key,
+                  const int64_t delta) const;
+    TO_STRING_KV(K_(tenant_id), K_(key), K_(delta), K_(member_cnt), K_(waiter_cnt),
+                 K_(is_done), K_(combined), K_(result_code), K_(affected_rows));
+
+    common::ObThreadCond cond_;
+    uint64_t tenant_id_;
+    uint64_t hash_;
+    // the update with the delta left out, identifies the row
+    common::ObString key_;
+    int64_t delta_;
+    int64_t member_cnt_;
+    // members other than the leader that still refer to the group
+    int64_t waiter_cnt_;
+    bool is_done_;
+    bool combined_;
+    int result_code_;
+    int64_t affected_rows_;
+    // the session settings of the leader the merged update runs with
+    int64_t sql_mode_;
+    const common::ObTimeZoneInfoWrap *tz_info_wrap_;
+  };
+  struct Slot
+  {
+    Slot() : lock_(), group_(NULL), last_hash_(0), last_arrival_ts_(0) {}
+    common::ObSpinLock lock_;
+    // the group still open for joining
+    Group *group_;
+    // the row and the time of the latest statement, a group is only opened on a row
+    // updated again within the window
+    uint64_t last_hash_;
+    int64_t last_arrival_ts_;
+  };
+
+  ObHotRowUpdateCombiner() {}
+  ~ObHotRowUpdateCombiner() {}
+  // "UPDATE `db`.`t` SET `c` = `c` + " and " WHERE `k` = v"
+  static int build_sql_(const uint64_t tenant_id,
+                        const sql::ObHotRowUpdateInfo &info,
+                        const common::ParamStore &params,
+                        share::schema::ObSchemaGetterGuard &schema_guard,
+                        common::ObSqlString &prefix,
+                        common::ObSqlString &suffix,
+                        int64_t &delta,
+                        bool &is_valid);
+  // "prefix?suffix" followed by the session settings the statements are merged under
+  static int build_key_(const common::ObSqlString &prefix,
+                        const common::ObSqlString &suffix,
+                        const uint64_t sql_mode,
+                        const common::ObCollationType collation,
+                        const common::ObTimeZoneInfoWrap &tz_info_wrap,
+                        common::ObSqlString &key);
+  // appends " AND `k` = v", or " WHERE `k` = v" to an empty %suffix
+  static int append_predicate_(const common::ObString &column_name,
+                               const common::ObObjParam &value,
+                               common::ObSqlString &suffix,
+                               bool &is_valid);
+  static int append_name_(const common::ObString &name,
+                          common::ObSqlString &sql,
+                          bool &is_valid);
+  // OB_TIMEOUT, killed session or stopping server end the waits
+  static int check_status_();
+  // under the slot lock, either joins the open group of the row, or opens %group when the
+  // row is contended, or leaves both %joined and %is_leader unset
+  static void enter_slot_(Slot &slot,
+                          Group &group,
+                          const uint64_t tenant_id,
+                          const uint64_t hash,
+                          const common::ObString &key,
+                          const int64_t delta,
+                          const int64_t window_us,
+                          Group *&joined,
+                          bool &is_leader);
+  void wait_group_(Slot &slot,
+                   Group &group,
+                   const int64_t delta,
+                   bool &combined,
+                   int &result_code,
+                   int64_t &affected_rows);
+  void lead_group_(Slot &slot,
+                   Group &group,
+                   const common::ObSqlString &prefix,
+                   const common::ObSqlString &suffix,
+                   const int64_t window_us);
+
+  Slot slots_[SLOT_CNT];
+  DISALLOW_COPY_AND_ASSIGN(ObHotRowUpdateCombiner);
+};
+
+} // namespace observer
+} // namespace oceanbase
+
+#endif // OCEANBASE_OBSERVER_MYSQL_OB_HOT_ROW_UPDATE_COMBINER_H_
@@ -23,6 +23,8 @@
 #include <string.h>
 #include "share/ob_lob_access_utils.h"
 #include "lib/charset/ob_charset.h"
+#include "sql/engine/ob_operator.h"
+#include "share/config/ob_server_config.h"
 
 namespace oceanbase
 {
@@ -140,7 +142,31 @@ int ObQueryDriver::response_query_result(ObResultSet &result,
       LOG_WARN("fields is null", K(ret), KP(fields));
     }
   }
-  while (OB_SUCC(ret) && row_num < limit_count && !OB_FAIL(result.get_next_row(result_row)) ) {
+  // encode the rows of a vectorized root from its batch datums when every column has
+  // a datum formatter, see ObSMDatumRow
+  ObOperator *batch_root = NULL;
+  ObSEArray<ObSMDatumRow::ColumnFormat, 16> formats;
+  bool by_batch = false;
+  if (OB_SUCC(ret) && !is_ps_protocol && !is_packed && !is_prexecute_ && !is_cac_found_rows
+      && OB_INVALID_COUNT == fetch_limit && !lib::is_oracle_mode()
+      && GCONF._enable_mysql_batch_result_encode
+      && NULL != (batch_root = result.get_batch_fetch_root())) {
+    ObCharsetType charset_type = CHARSET_INVALID;
+    if (OB_FAIL(session_.get_character_set_results(charset_type))) {
+      LOG_WARN("fail to get result charset", K(ret));
+    } else if (OB_FAIL(ObSMDatumRow::init_formats(batch_root->get_spec().output_, *fields,
+                                                  charset_type, formats, by_batch))) {
+      LOG_WARN("fail to init column formats", K(ret));
+    } else if (by_batch && OB_FAIL(response_query_result_by_batch(result, *batch_root, formats,
+                                                                  has_more_result, can_retry,
+                                                                  limit_count, row_num))) {
+      if (OB_ITER_END != ret) {
+        LOG_WARN("fail to response query result by batch", K(ret), K(row_num), K(can_retry));
+      }
+    }
+  }
+  while (OB_SUCC(ret) && !by_batch && row_num < limit_count
+         && !OB_FAIL(result.get_next_row(result_row)) ) {
     ObNewRow *row = const_cast<ObNewRow*>(result_row);
     if (is_prexecute_ && row_num == limit_count - 1) {
       LOG_DEBUG("is_prexecute_ and row_num is equal with limit_count", K(limit_count));
@@ -242,6 +268,53 @@ int ObQueryDriver::response_query_result(ObResultSet &result,
   return ret;
 }
 
+// returns OB_ITER_END after the last batch, like ObResultSet::get_next_row()
+int ObQueryDriver::response_query_result_by_batch(ObResultSet &result,
+                                                  ObOperator &root,
+                                                  const ObSMDatumRow::ColumnFormatIArray &formats,
+                                                  bool has_more_result,
+                                                  bool &can_retry,
+                                                  int64_t limit_count,
+                                                  int64_t &row_num)
+{
+  int ret = OB_SUCCESS;
+  const ObBatchRows *brs = NULL;
+  bool iter_end = false;
+  ObSMDatumRow sm(formats, root.get_eval_ctx());
+  while (OB_SUCC(ret) && !iter_end && row_num < limit_count) {
+    if (OB_FAIL(result.get_next_batch(INT64_MAX, brs))) {
+      LOG_WARN("fail to get next batch", K(ret));
+    } else {
+      for (int64_t i = 0; OB_SUCC(ret) && i < brs->size_ && row_num < limit_count; ++i) {
+        if (brs->skip_->at(i)) {
+          continue;
+        }
+        // 如果是第一行，则先给客户端回复field等信息
+        if (0 == row_num) {
+          can_retry = false;
+          if (OB_FAIL(response_query_header(result, has_more_result, false, false))) {
+            LOG_WARN("fail to response query header", K(ret), K(row_num), K(can_retry));
+          }
+        }
+        if (OB_SUCC(ret)) {
+          sm.set_batch_idx(i);
+          OMPKRow rp(sm);
+          if (OB_FAIL(sender_.response_packet(rp, &result.get_session()))) {
+            LOG_WARN("response packet fail", K(ret), K(i), K(row_num), K(can_retry));
+          } else {
+            ++row_num;
+          }
+        }
+      }
+      iter_end = brs->end_;
+    }
+  }
+  if (OB_SUCC(ret) && iter_end) {
+    ret = OB_ITER_END;
+  }
+  return ret;
+}
+
 int ObQueryDriver::convert_field_charset(ObIAllocator& allocator,
                                          const ObCollationType& from_collation,
                                          const ObCollationType& dest_collation,
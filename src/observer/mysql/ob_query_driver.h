@@ -16,6 +16,7 @@
 #include "share/ob_define.h"
 #include "lib/charset/ob_charset.h"
 #include "lib/string/ob_string.h"
+#include "observer/mysql/obsm_row.h"
 
 namespace oceanbase
 {
@@ -25,6 +26,7 @@ namespace sql
 struct ObSqlCtx;
 class ObSQLSessionInfo;
 class ObResultSet;
+class ObOperator;
 }
 
 
@@ -94,6 +96,13 @@ public:
                                         ObIAllocator &allocator,
                                         const sql::ObSQLSessionInfo *session_info);
 private:
+  int response_query_result_by_batch(sql::ObResultSet &result,
+                                     sql::ObOperator &root,
+                                     const common::ObSMDatumRow::ColumnFormatIArray &formats,
+                                     bool has_more_result,
+                                     bool &can_retry,
+                                     int64_t limit_count,
+                                     int64_t &row_num);
   int convert_field_charset(common::ObIAllocator& allocator,
       const common::ObCollationType& from_collation,
       const common::ObCollationType& dest_collation,
@@ -46,8 +46,10 @@
 #include "observer/mysql/ob_sync_cmd_driver.h"
 #include "observer/mysql/ob_async_cmd_driver.h"
 #include "observer/mysql/ob_async_plan_driver.h"
+#include "observer/mysql/ob_hot_row_update_combiner.h"
 #include "observer/ob_req_time_service.h"
 #include "observer/omt/ob_tenant.h"
+#include "observer/omt/ob_tenant_config_mgr.h"
 #include "observer/ob_server.h"
 #include "observer/virtual_table/ob_virtual_table_iterator_factory.h"
 #include "sql/monitor/ob_phy_plan_monitor_info.h"
@@ -1215,11 +1217,17 @@ OB_INLINE int ObMPQuery::response_result(ObMySQLResultSet &result,
   CHECK_COMPATIBILITY_MODE(&session);
 
   bool need_trans_cb  = result.need_end_trans_callback() && (!force_sync_resp);
+  bool combined = false;
 
   // 通过判断 plan 是否为 null 来确定是 plan 还是 cmd
   // 针对 plan 和 cmd 分开处理，逻辑会较为清晰。
   if (OB_LIKELY(NULL != result.get_physical_plan())) {
-    if (need_trans_cb) {
+    if (OB_UNLIKELY(result.get_physical_plan()->get_hot_row_update_info().is_valid())
+        && OB_FAIL(response_hot_row_update_(result, combined))) {
+      LOG_WARN("fail response hot row update", K(ret));
+    } else if (combined) {
+      // answered with the result of the merged update
+    } else if (need_trans_cb) {
       ObAsyncPlanDriver drv(gctx_, ctx_, session, retry_ctrl_, *this);
       // NOTE: sql_end_cb必须在drv.response_result()之前初始化好
       ObSqlEndTransCb &sql_end_cb = session.get_mysql_end_trans_cb();
@@ -1256,6 +1264,81 @@ OB_INLINE int ObMPQuery::response_result(ObMySQLResultSet &result,
   return ret;
 }
 
+// An autocommit update merged with the others on the same row is not executed by itself,
+// the client gets the result of the merged one.
+int ObMPQuery::response_hot_row_update_(ObMySQLResultSet &result, bool &combined)
+{
+  int ret = OB_SUCCESS;
+  ObSQLSessionInfo &session = result.get_session();
+  const ObPhysicalPlan *plan = result.get_physical_plan();
+  ObPhysicalPlanCtx *plan_ctx = result.get_exec_context().get_physical_plan_ctx();
+  int64_t window_us = 0;
+  int result_code = OB_SUCCESS;
+  int64_t affected_rows = 0;
+  combined = false;
+  if (OB_ISNULL(plan) || OB_ISNULL(plan_ctx) || OB_ISNULL(ctx_.schema_guard_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("invalid result", K(ret), KP(plan), KP(plan_ctx), KP(ctx_.schema_guard_));
+  } else if (!session.get_local_autocommit()
+             || session.is_in_transaction()
+             || result.has_more_result()
+             || ctx_.multi_stmt_item_.is_batched_multi_stmt()
+             || retry_ctrl_.get_retry_times() > 0) {
+    // a retried statement is executed by itself
+  } else {
+    omt::ObTenantConfigGuard tenant_config(TENANT_CONF(session.get_effective_tenant_id()));
+    if (tenant_config.is_valid()) {
+      window_us = tenant_config->_hot_row_update_batch_window;
+    }
+  }
+  if (OB_SUCC(ret) && window_us > 0) {
+    int tmp_ret = OB_SUCCESS;
+    if (OB_SUCCESS != (tmp_ret = ObHotRowUpdateCombiner::get_instance().combine(
+                session,
+                plan->get_hot_row_update_info(),
+                plan_ctx->get_param_store(),
+                *ctx_.schema_guard_,
+                window_us,
+                combined,
+                result_code,
+                affected_rows))) {
+      LOG_WARN("failed to combine hot row update, execute by itself", K(tmp_ret));
+      combined = false;
+    }
+  }
+  // The merged statement is not opened, the result set and the plan ctx are filled as
+  // if it was, so that do_process records its sql audit and plan stat the same way.
+  if (OB_FAIL(ret) || !combined) {
+  } else if (OB_SUCCESS != result_code) {
+    result.set_errcode(result_code);
+    ret = result_code;
+    int err = send_error_packet(ret, NULL);
+    if (OB_SUCCESS != err) {
+      LOG_WARN("send error packet failed", K(ret), K(err));
+    }
+  } else {
+    char message[MSG_SIZE];
+    ObOKPParam ok_param;
+    if (OB_UNLIKELY(snprintf(message, MSG_SIZE, OB_UPDATE_MSG_FMT,
+                             affected_rows, affected_rows, 0L) < 0)) {
+      message[0] = '\0';
+    }
+    result.set_message(message);
+    result.set_affected_rows(affected_rows);
+    plan_ctx->set_affected_rows(affected_rows);
+    IGNORE_RETURN plan_ctx->set_row_matched_count(affected_rows);
+    session.set_affected_rows(affected_rows);
+    ok_param.message_ = const_cast<char*>(result.get_message());
+    ok_param.affected_rows_ = affected_rows;
+    ok_param.is_partition_hit_ = session.partition_hit().get_bool();
+    ok_param.has_more_result_ = false;
+    if (OB_FAIL(send_ok_packet(session, ok_param))) {
+      LOG_WARN("send ok packet fail", K(ok_param), K(ret));
+    }
+  }
+  return ret;
+}
+
 inline void ObMPQuery::record_stat(const stmt::StmtType type, const int64_t end_time) const
 {
 #define ADD_STMT_STAT(type)                     \
@@ -66,6 +66,7 @@ protected:
   int is_readonly_stmt(ObMySQLResultSet &result, bool &is_readonly);
 private:
   int response_result(ObMySQLResultSet &result, bool force_sync_resp, bool &async_resp_used);
+  int response_hot_row_update_(ObMySQLResultSet &result, bool &combined);
   int get_tenant_schema_info_(const uint64_t tenant_id,
                       ObTenantCachedSchemaGuardInfo *cache_info,
                       share::schema::ObSchemaGetterGuard *&schema_guard,
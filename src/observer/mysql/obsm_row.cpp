@@ -15,6 +15,8 @@
 #include "observer/mysql/obsm_utils.h"
 #include "common/ob_accuracy.h"
 #include "share/schema/ob_schema_getter_guard.h"
+#include "lib/charset/ob_charset.h"
+#include "sql/engine/expr/ob_expr.h"
 
 using namespace oceanbase::share::schema;
 using namespace oceanbase::common;
@@ -71,3 +73,116 @@ int ObSMRow::encode_cell(
 
   return ret;
 }
+
+ObSMDatumRow::ObSMDatumRow(const ColumnFormatIArray &formats, sql::ObEvalCtx &eval_ctx)
+    : ObMySQLRow(TEXT),
+      formats_(formats),
+      eval_ctx_(eval_ctx),
+      batch_idx_(0)
+{
+}
+
+int ObSMDatumRow::init_formats(const ObIArray<sql::ObExpr *> &exprs,
+                               const ColumnsFieldIArray &fields,
+                               const ObCharsetType result_charset,
+                               ObIArray<ColumnFormat> &formats,
+                               bool &is_supported)
+{
+  int ret = OB_SUCCESS;
+  is_supported = exprs.count() > 0 && exprs.count() == fields.count();
+  formats.reuse();
+  const bool need_convert_string = ObCharset::is_valid_charset(result_charset)
+                                   && CHARSET_BINARY != result_charset;
+  for (int64_t i = 0; OB_SUCC(ret) && is_supported && i < exprs.count(); ++i) {
+    const sql::ObExpr *expr = exprs.at(i);
+    const ObField &field = fields.at(i);
+    ColumnFormat format;
+    if (OB_ISNULL(expr)) {
+      ret = OB_ERR_UNEXPECTED;
+      SQL_ENG_LOG(WARN, "null expr", K(ret), K(i));
+    } else {
+      format.expr_ = expr;
+      format.scale_ = field.accuracy_.get_scale();
+      format.zerofill_ = field.flags_ & ZEROFILL_FLAG;
+      format.zflength_ = field.length_;
+      switch (expr->obj_meta_.get_type_class()) {
+        case ObIntTC:
+          format.format_ = CELL_INT;
+          break;
+        case ObUIntTC:
+          format.format_ = CELL_UINT;
+          break;
+        case ObNumberTC:
+          format.format_ = CELL_NUMBER;
+          break;
+        case ObStringTC: {
+          // the same condition as ObQueryDriver::convert_string_value_charset
+          const ObCollationType cs_type = expr->obj_meta_.get_collation_type();
+          const ObCharsetInfo *from_cs = ObCharset::get_charset(cs_type);
+          const ObCharsetInfo *to_cs = need_convert_string
+              ? ObCharset::get_charset(ObCharset::get_default_collation(result_charset))
+              : NULL;
+          format.format_ = CELL_STRING;
+          if (CS_TYPE_INVALID == cs_type || NULL == from_cs) {
+            is_supported = false;
+          } else if (!need_convert_string || CS_TYPE_BINARY == cs_type) {
+            // no conversion
+          } else if (NULL == to_cs || 0 != strcmp(from_cs->csname, to_cs->csname)) {
+            is_supported = false;
+          }
+          break;
+        }
+        default:
+          is_supported = false;
+          break;
+      }
+      if (OB_SUCC(ret) && is_supported && OB_FAIL(formats.push_back(format))) {
+        SQL_ENG_LOG(WARN, "failed to push back column format", K(ret));
+      }
+    }
+  }
+  if (OB_FAIL(ret) || !is_supported) {
+    is_supported = false;
+    formats.reuse();
+  }
+  return ret;
+}
+
+int ObSMDatumRow::encode_cell(
+    int64_t idx, char *buf,
+    int64_t len, int64_t &pos, char *bitmap) const
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(idx >= formats_.count() || idx < 0)) {
+    ret = OB_INVALID_ARGUMENT;
+  } else {
+    const ColumnFormat &format = formats_.at(idx);
+    const sql::ObExpr &expr = *format.expr_;
+    const ObDatum &datum = expr.locate_batch_datums(eval_ctx_)[expr.is_batch_result() ? batch_idx_ : 0];
+    if (datum.is_null()) {
+      ret = ObMySQLUtil::null_cell_str(buf, len, type_, pos, idx, bitmap);
+    } else {
+      switch (format.format_) {
+        case CELL_INT:
+          ret = ObMySQLUtil::int_cell_str(buf, len, datum.get_int(), expr.obj_meta_.get_type(),
+                                          false, type_, pos, format.zerofill_, format.zflength_);
+          break;
+        case CELL_UINT:
+          ret = ObMySQLUtil::int_cell_str(buf, len, datum.get_int(), expr.obj_meta_.get_type(),
+                                          true, type_, pos, format.zerofill_, format.zflength_);
+          break;
+        case CELL_NUMBER:
+          ret = ObMySQLUtil::number_cell_str(buf, len, number::ObNumber(datum.get_number()), pos,
+                                             format.scale_, format.zerofill_, format.zflength_);
+          break;
+        case CELL_STRING:
+          ret = ObMySQLUtil::varchar_cell_str(buf, len, datum.get_string(), false, pos);
+          break;
+        default:
+          ret = OB_ERR_UNEXPECTED;
+          break;
+      }
+    }
+  }
+  return ret;
+}
@@ -17,10 +17,18 @@
 #include "rpc/obmysql/ob_mysql_row.h"
 #include "common/row/ob_row.h"
 #include "common/ob_field.h"
+#include "lib/container/ob_iarray.h"
+#include "lib/charset/ob_charset.h"
 
 namespace oceanbase
 {
 
+namespace sql
+{
+class ObExpr;
+struct ObEvalCtx;
+}
+
 namespace share
 {
 namespace schema
@@ -66,6 +74,60 @@ private:
   DISALLOW_COPY_AND_ASSIGN(ObSMRow);
 }; // end of class OBMP
 
+// Text protocol row encoded from the datums of the output exprs of a vectorized root
+// operator at one index of the batch. The format of each column is decided once for
+// the result set by init_formats(), so a cell is written without the datum to ObObj
+// conversion and the type class switch of ObSMUtils::cell_str.
+class ObSMDatumRow
+    : public obmysql::ObMySQLRow
+{
+public:
+  enum CellFormat
+  {
+    CELL_INT = 0,
+    CELL_UINT,
+    CELL_NUMBER,
+    CELL_STRING,
+  };
+  struct ColumnFormat
+  {
+    ColumnFormat()
+      : expr_(NULL), format_(CELL_INT), scale_(0), zerofill_(false), zflength_(0) {}
+    TO_STRING_KV(KP_(expr), K_(format), K_(scale), K_(zerofill), K_(zflength));
+    const sql::ObExpr *expr_;
+    CellFormat format_;
+    int16_t scale_;
+    bool zerofill_;
+    int32_t zflength_;
+  };
+  typedef common::ObIArray<ColumnFormat> ColumnFormatIArray;
+
+  ObSMDatumRow(const ColumnFormatIArray &formats, sql::ObEvalCtx &eval_ctx);
+  virtual ~ObSMDatumRow() {}
+
+  // %is_supported is false if any column needs the ObObj path, e.g. a type without
+  // datum formatter or a string that is converted to the result charset
+  static int init_formats(const common::ObIArray<sql::ObExpr *> &exprs,
+                          const ColumnsFieldIArray &fields,
+                          const ObCharsetType result_charset,
+                          common::ObIArray<ColumnFormat> &formats,
+                          bool &is_supported);
+  void set_batch_idx(const int64_t batch_idx) { batch_idx_ = batch_idx; }
+
+protected:
+  virtual int64_t get_cells_cnt() const { return formats_.count(); }
+  virtual int encode_cell(
+      int64_t idx, char *buf,
+      int64_t len, int64_t &pos, char *bitmap) const;
+
+private:
+  const ColumnFormatIArray &formats_;
+  sql::ObEvalCtx &eval_ctx_;
+  int64_t batch_idx_;
+
+  DISALLOW_COPY_AND_ASSIGN(ObSMDatumRow);
+};
+
 } // end of namespace common
 } // end of namespace oceanbase
 
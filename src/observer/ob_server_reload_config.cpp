@@ -139,6 +139,13 @@ int ObServerReloadConfig::operator()()
 #ifdef OB_USE_ASAN
     __MemoryContext__::set_enable_asan_allocator(GCONF.enable_asan_for_memory_context);
 #endif
+    const bool object_cache_was_enabled = lib::ObjectMgr::is_object_cache_enabled();
+    lib::ObjectMgr::set_enable_object_cache(GCONF._enable_alloc_object_cache);
+    if (object_cache_was_enabled && !GCONF._enable_alloc_object_cache) {
+      // nothing frees to the caches any more, give back what they hold
+      ObMallocAllocator::get_instance()->flush_object_cache();
+    }
+    ObLargePageHelper::set_ctx_param(GCONF._ctx_huge_page_policy);
 
     ObIOConfig io_config;
     int64_t cpu_cnt = GCONF.cpu_count;
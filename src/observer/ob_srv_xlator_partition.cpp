@@ -148,6 +148,7 @@ void oceanbase::observer::init_srv_xlator_for_migration(ObSrvRpcXlator *xlator)
 void oceanbase::observer::init_srv_xlator_for_others(ObSrvRpcXlator *xlator) {
   RPC_PROCESSOR(ObGtsP);
   RPC_PROCESSOR(ObGtsErrRespP);
+  RPC_PROCESSOR(ObGtsBatchP);
   RPC_PROCESSOR(ObGtiP);
   RPC_PROCESSOR(ObDASIDP);
 
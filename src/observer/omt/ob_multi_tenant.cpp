@@ -1996,6 +1996,13 @@ void ObMultiTenant::run1()
     }
     ob_usleep(TIME_SLICE_PERIOD);
 
+    if (REACH_TIME_INTERVAL(lib::ObjectMgr::OBJECT_CACHE_IDLE_US)) {
+      // the object caches of the ctx nobody allocates from any more, also the
+      // frees raced with turning _enable_alloc_object_cache off
+      ObMallocAllocator::get_instance()->flush_object_cache(
+          lib::ObjectMgr::is_object_cache_enabled() ? lib::ObjectMgr::OBJECT_CACHE_IDLE_US : 0);
+    }
+
     if (REACH_TIME_INTERVAL(30000000L)) {  // every 30s
       SpinRLockGuard guard(lock_);
       for (TenantList::iterator it = tenants_.begin(); it != tenants_.end(); it++) {
@@ -18,6 +18,9 @@
 #include "lib/time/ob_time_utility.h"
 #include "lib/stat/ob_diagnose_info.h"
 #include "lib/stat/ob_session_stat.h"
+#include "lib/hash_func/murmur_hash.h"
+#include "lib/cpu/ob_cpu_topology.h"
+#include "lib/resource/ob_resource_mgr.h"
 #include "share/config/ob_server_config.h"
 #include "sql/engine/px/ob_px_admission.h"
 #include "share/interrupt/ob_global_interrupt_call.h"
@@ -584,6 +587,8 @@ ObTenant::ObTenant(const int64_t id,
       times_of_workers_(times_of_workers),
       unit_max_cpu_(0),
       unit_min_cpu_(0),
+      numa_node_(-1),
+      numa_node_cpu_(0),
       slice_(0),
       slice_remain_(0),
       slice_remain_lock_(),
@@ -593,6 +598,8 @@ ObTenant::ObTenant(const int64_t id,
       ass_token_cnt_(0),
       lq_tokens_(0),
       used_lq_tokens_(0),
+      run_slot_limit_(0),
+      run_slots_(),
       last_calibrate_worker_ts_(0),
       last_calibrate_token_ts_(0),
       last_pop_normal_cnt_(0),
@@ -661,6 +668,8 @@ int ObTenant::init(const ObTenantMeta &meta)
   if (OB_FAIL(ObTenantBase::init(&cgroup_ctrl_))) {
     LOG_WARN("fail to init tenant base", K(ret));
   } else if (FALSE_IT(req_queue_.set_limit(common::ObServerConfig::get_instance().tenant_task_queue_size))) {
+  } else if (FALSE_IT(req_queue_.set_shard_cnt(GCONF._tenant_req_queue_shard_cnt))) {
+  } else if (FALSE_IT(bind_numa_node(meta))) {
   } else if (worker_pool_.init(1, 1)) {
     // useless now, but maybe useful later
     LOG_WARN("init worker pool fail", K(ret));
@@ -958,6 +967,7 @@ void ObTenant::destroy()
   }
   worker_pool_.destroy();
   group_map_.destroy_group();
+  unbind_numa_node();
   ObTenantSwitchGuard guard(this);
   ObTenantBase::destroy();
 
@@ -975,10 +985,69 @@ void ObTenant::destroy()
   }
 }
 
+void ObTenant::bind_numa_node(const ObTenantMeta &meta)
+{
+  int ret = OB_SUCCESS;
+  ObTenantResourceMgrHandle resource_handle;
+  const double cpu = meta.unit_.config_.max_cpu();
+  if (!GCONF._enable_tenant_numa_affinity || is_virtual_tenant_id(id_)) {
+    // do nothing
+  } else if (-1 == (numa_node_ = ObCpuTopology::get_instance().acquire_numa_node(cpu))) {
+    // a single node host, or the tenant does not fit in any node
+  } else if (FALSE_IT(numa_node_cpu_ = cpu)) {
+  } else if (OB_FAIL(ObResourceMgr::get_instance().get_tenant_resource_mgr(id_, resource_handle))) {
+    LOG_WARN("get tenant resource mgr failed", K(ret), K_(id));
+  } else {
+    resource_handle.get_memory_mgr()->set_numa_node(numa_node_);
+  }
+  if (-1 != numa_node_) {
+    LOG_INFO("bind tenant to numa node", K(ret), K_(id), K_(numa_node), K(cpu),
+             "topology", ObCpuTopology::get_instance());
+  }
+}
+
+void ObTenant::unbind_numa_node()
+{
+  int ret = OB_SUCCESS;
+  ObTenantResourceMgrHandle resource_handle;
+  if (-1 != numa_node_) {
+    if (OB_FAIL(ObResourceMgr::get_instance().get_tenant_resource_mgr(id_, resource_handle))) {
+      LOG_WARN("get tenant resource mgr failed", K(ret), K_(id));
+    } else {
+      resource_handle.get_memory_mgr()->set_numa_node(-1);
+    }
+    ObCpuTopology::get_instance().release_numa_node(numa_node_, numa_node_cpu_);
+    numa_node_ = -1;
+    numa_node_cpu_ = 0;
+  }
+}
+
+void ObTenant::resize_numa_node(const double cpu)
+{
+  int ret = OB_SUCCESS;
+  ObTenantResourceMgrHandle resource_handle;
+  if (ObCpuTopology::get_instance().resize_numa_node(numa_node_, numa_node_cpu_, cpu)) {
+    numa_node_cpu_ = cpu;
+  } else {
+    // the unit outgrew its node, the workers go back to all the cpus on their next loop
+    LOG_INFO("unbind tenant from numa node", K_(id), K_(numa_node), K_(numa_node_cpu), K(cpu));
+    if (OB_FAIL(ObResourceMgr::get_instance().get_tenant_resource_mgr(id_, resource_handle))) {
+      LOG_WARN("get tenant resource mgr failed", K(ret), K_(id));
+    } else {
+      resource_handle.get_memory_mgr()->set_numa_node(-1);
+    }
+    ATOMIC_STORE(&numa_node_, -1);
+    numa_node_cpu_ = 0;
+  }
+}
+
 void ObTenant::set_unit_max_cpu(double cpu)
 {
   int tmp_ret = OB_SUCCESS;
   unit_max_cpu_ = cpu;
+  if (-1 != numa_node_ && cpu != numa_node_cpu_) {
+    resize_numa_node(cpu);
+  }
   const double default_cfs_period_us = 100000.0;
   int32_t cfs_quota_us = static_cast<int32_t>(default_cfs_period_us * cpu);
   if (cgroup_ctrl_.is_valid()
@@ -1090,6 +1159,10 @@ int ObTenant::get_new_request(
           = w.Worker::get_tidx() == 1 && workers_.get_size() > 2;
       const bool only_high_prio
           = w.Worker::get_tidx() == 0 && workers_.get_size() > 1;
+      // workers are spread over the sub queues of req_queue_ by tidx, each starts from
+      // that one and steals from the others. A sub queue is not owned by a worker, several
+      // workers may share one and the tidx of a worker may change as the pool is resized.
+      const uint64_t home_shard = static_cast<uint64_t>(w.Worker::get_tidx());
 
 
     if (!only_high_high_prio && !only_high_prio) {
@@ -1107,11 +1180,11 @@ int ObTenant::get_new_request(
       if (OB_UNLIKELY(only_high_high_prio)) {
         // We must ensure at least one worker can process the highest
         // priority task.
-        ret = req_queue_.pop_high_high(task, timeout);
+        ret = req_queue_.pop_high_high(task, timeout, home_shard);
       } else if (OB_UNLIKELY(only_high_prio)) {
         // We must ensure at least number of tokens of workers which don't
         // process low priority task.
-        ret = req_queue_.pop_high(task, timeout);
+        ret = req_queue_.pop_high(task, timeout, home_shard);
       } else {
         // If large requests exist and this worker doesn't have LQT but
         // can acquire, do it.
@@ -1122,7 +1195,7 @@ int ObTenant::get_new_request(
           w.set_lq_token();
         }
         if (OB_LIKELY(!w.has_lq_token())) {
-          ret = req_queue_.pop(task, 0L);
+          ret = req_queue_.pop(task, 0L, home_shard);
         }
         if (OB_UNLIKELY(nullptr == task)) {
           // If large query flag is set, we prefer large query.
@@ -1131,7 +1204,7 @@ int ObTenant::get_new_request(
           } else {
             // Ignore return code from large queue and get request from
             // normal queue.
-            ret = req_queue_.pop(task, timeout);
+            ret = req_queue_.pop(task, timeout, home_shard);
           }
         }
       }
@@ -1189,6 +1262,20 @@ inline bool is_warmup(const ObRpcPacket &pkt)
   return pkt.get_priority() == 11;
 }
 
+// requests of the same connection go to the same sub queue of req_queue_,
+// the others are spread by the receiving thread
+inline uint64_t get_req_shard_hint(const ObRequest &req)
+{
+  uint64_t hint = 0;
+  const void *conn = req.get_server_handle_context();
+  if (req.get_type() == ObRequest::OB_MYSQL && nullptr != conn) {
+    hint = murmurhash(&conn, sizeof(conn), 0);
+  } else {
+    hint = static_cast<uint64_t>(GETTID());
+  }
+  return hint;
+}
+
 int ObTenant::recv_request(ObRequest &req)
 {
   int ret = OB_SUCCESS;
@@ -1223,6 +1310,7 @@ int ObTenant::recv_request(ObRequest &req)
     //
     req.set_enqueue_timestamp(ObTimeUtility::current_time());
     req.set_trace_point(ObRequest::OB_EASY_REQUEST_TENANT_RECEIVED);
+    const uint64_t shard_hint = get_req_shard_hint(req);
     if (req.get_type() == ObRequest::OB_RPC) {
       using obrpc::ObRpcPacket;
       const ObRpcPacket &pkt
@@ -1243,19 +1331,19 @@ int ObTenant::recv_request(ObRequest &req)
         //  11 Ultra-low priority for preheating
         if (is_high_prio(pkt)) {  // the less number the higher priority
           ATOMIC_INC(&recv_hp_rpc_cnt_);
-          if (OB_FAIL(req_queue_.push(&req, QQ_HIGH))) {
+          if (OB_FAIL(req_queue_.push(&req, QQ_HIGH, shard_hint))) {
             if (REACH_TIME_INTERVAL(5 * 1000 * 1000)) {
               LOG_WARN("push request to queue fail", K(ret), K(*this));
             }
           }
         } else if (req.is_retry_on_lock())  {
           ATOMIC_INC(&recv_retry_on_lock_rpc_cnt_);
-          if (OB_FAIL(req_queue_.push(&req, QQ_PRIOR_TO_NORMAL))) {
+          if (OB_FAIL(req_queue_.push(&req, QQ_PRIOR_TO_NORMAL, shard_hint))) {
             LOG_WARN("push request to QQ_PRIOR_TO_NORMAL queue fail", K(ret), K(this));
           }
         } else if (is_normal_prio(pkt) || is_low_prio(pkt)) {
           ATOMIC_INC(&recv_np_rpc_cnt_);
-          if (OB_FAIL(req_queue_.push(&req, QQ_NORMAL))) {
+          if (OB_FAIL(req_queue_.push(&req, QQ_NORMAL, shard_hint))) {
             LOG_WARN("push request to queue fail", K(ret), K(this));
           }
         } else if (is_ddl(pkt)) {
@@ -1263,7 +1351,7 @@ int ObTenant::recv_request(ObRequest &req)
           LOG_WARN("priority 10 should not come here", K(ret));
         } else if (is_warmup(pkt)) {
           ATOMIC_INC(&recv_lp_rpc_cnt_);
-          if (OB_FAIL(req_queue_.push(&req, RQ_LOW))) {
+          if (OB_FAIL(req_queue_.push(&req, RQ_LOW, shard_hint))) {
             LOG_WARN("push request to queue fail", K(ret), K(this));
           }
         } else {
@@ -1275,24 +1363,24 @@ int ObTenant::recv_request(ObRequest &req)
       const obmysql::ObMySQLRawPacket &pkt = reinterpret_cast<const obmysql::ObMySQLRawPacket &>(req.get_packet());
       if (req.is_retry_on_lock())  {
         ATOMIC_INC(&recv_retry_on_lock_mysql_cnt_);
-        if (OB_FAIL(req_queue_.push(&req, RQ_HIGH))) {
+        if (OB_FAIL(req_queue_.push(&req, RQ_HIGH, shard_hint))) {
           LOG_WARN("push request to RQ_HIGH queue fail", K(ret), K(this));
         }
       } else {
         ATOMIC_INC(&recv_mysql_cnt_);
-        if (OB_FAIL(req_queue_.push(&req, RQ_NORMAL))) {
+        if (OB_FAIL(req_queue_.push(&req, RQ_NORMAL, shard_hint))) {
           LOG_WARN("push request to queue fail", K(ret), K(this));
         }
       }
 
     } else if (req.get_type() == ObRequest::OB_TASK || req.get_type() == ObRequest::OB_TS_TASK) {
       ATOMIC_INC(&recv_task_cnt_);
-      if (OB_FAIL(req_queue_.push(&req, RQ_HIGH))) {
+      if (OB_FAIL(req_queue_.push(&req, RQ_HIGH, shard_hint))) {
         LOG_WARN("push request to queue fail", K(ret), K(this));
       }
     } else if (req.get_type() == ObRequest::OB_SQL_TASK) {
       ATOMIC_INC(&recv_sql_task_cnt_);
-      if (OB_FAIL(req_queue_.push(&req, RQ_NORMAL))) {
+      if (OB_FAIL(req_queue_.push(&req, RQ_NORMAL, shard_hint))) {
         LOG_WARN("push request to queue fail", K(ret), K(this));
       }
     } else {
@@ -1335,6 +1423,57 @@ int ObTenant::push_retry_queue(rpc::ObRequest &req, const uint64_t timestamp)
   return retry_queue_.push(req, timestamp);
 }
 
+void ObTenant::update_run_slot_limit()
+{
+  const int64_t slots_per_cpu = GCONF._tenant_worker_run_slots_per_cpu;
+  const int64_t limit = slots_per_cpu <= 0 ? 0 :
+      slots_per_cpu * std::max(1L, static_cast<int64_t>(ceil(unit_max_cpu())));
+  if (limit != ATOMIC_LOAD(&run_slot_limit_)) {
+    LOG_INFO("tenant update run slot limit", K_(id), K_(run_slot_limit), K(limit));
+    ATOMIC_STORE(&run_slot_limit_, limit);
+    // waiters recheck against the new limit
+    run_slots_.wake(INT32_MAX);
+  }
+}
+
+bool ObTenant::acquire_run_slot()
+{
+  bool bret = true;
+  const int64_t limit = ATOMIC_LOAD(&run_slot_limit_);
+  int32_t &running = run_slots_.val();
+  if (limit > 0) {
+    const int64_t deadline = ObTimeUtility::current_time() + RUN_SLOT_WAIT_TIME;
+    bool got = false;
+    while (!got && bret) {
+      const int32_t v = ATOMIC_LOAD(&running);
+      const int64_t remain = deadline - ObTimeUtility::current_time();
+      if (v < limit) {
+        got = ATOMIC_BCAS(&running, v, v + 1);
+      } else if (remain <= 0) {
+        // never wait longer, a slot holder may wait for this one without a sched_wait
+        bret = false;
+      } else {
+        IGNORE_RETURN run_slots_.wait(v, remain);
+      }
+    }
+    if (!got) {
+      ATOMIC_INC(&running);
+    }
+  } else {
+    ATOMIC_INC(&running);
+  }
+  return bret;
+}
+
+void ObTenant::release_run_slot()
+{
+  const int32_t v = ATOMIC_FAA(&run_slots_.val(), -1);
+  const int64_t limit = ATOMIC_LOAD(&run_slot_limit_);
+  if (limit > 0 && v >= limit) {
+    run_slots_.wake(1);
+  }
+}
+
 int ObTenant::timeup()
 {
   int ret = OB_SUCCESS;
@@ -1343,6 +1482,7 @@ int ObTenant::timeup()
   check_worker_count();
   update_token_usage();
   calibrate_worker_count();
+  update_run_slot_limit();
   handle_retry_req();
   calibrate_token_count();
   return ret;
@@ -21,6 +21,7 @@
 #include "lib/queue/ob_fixed_queue.h"
 #include "lib/lock/ob_spin_lock.h"
 #include "lib/lock/ob_mutex.h"
+#include "lib/lock/ob_futex.h"
 #include "lib/atomic/ob_atomic.h"
 #include "lib/thread/ob_thread_name.h"
 #include "lib/rc/ob_rc.h"
@@ -397,6 +398,8 @@ class ObTenant : public share::ObTenantBase
   static constexpr int64_t PRESERVE_INACTIVE_WORKER_TIME = 10 * 1000L * 1000L;
   enum { CALIBRATE_WORKER_INTERVAL = 30 * 1000 * 1000 };
   enum { CALIBRATE_TOKEN_INTERVAL = 100 * 1000 };
+  // How long a worker waits for a run slot before overcommitting.
+  static constexpr int64_t RUN_SLOT_WAIT_TIME = 10 * 1000L;
 
 public:
   // Quick Queue Priorities
@@ -444,6 +447,14 @@ public:
   double unit_max_cpu() const;
   void set_unit_min_cpu(double cpu);
   double unit_min_cpu() const;
+  // -1 if the tenant is not bound to a numa node
+  int64_t get_numa_node() const { return ATOMIC_LOAD(&numa_node_); }
+  // Run slots bound the workers running requests at the same time. A worker gives
+  // its slot out while it waits in sched_wait, e.g. for a sync rpc, gts or a lock
+  // retry, so blocked workers neither count against the slots nor keep the others
+  // from the cpu. Return false if no slot frees in time and the worker overcommits.
+  bool acquire_run_slot();
+  void release_run_slot();
   void set_token(const int64_t token);
   void set_sug_token(const int64_t token);
   int64_t token_cnt() const;
@@ -480,6 +491,7 @@ public:
   void calibrate_token_count();
   void calibrate_group_token_count();
   void calibrate_worker_count();
+  void update_run_slot_limit();
   int timeup();
 
   TO_STRING_KV(K_(id),
@@ -585,6 +597,11 @@ private:
   void check_das();
 
   int construct_mtl_init_ctx(const ObTenantMeta &meta, share::ObTenantModuleInitCtx *&ctx);
+  // keep the workers and the memory of a tenant that fits in a numa node on that node
+  void bind_numa_node(const ObTenantMeta &meta);
+  void unbind_numa_node();
+  // follows a change of the unit max cpu, unbinds the tenant if it no longer fits its node
+  void resize_numa_node(const double cpu);
 
 protected:
 
@@ -597,6 +614,9 @@ protected:
   // max/min cpu read from unit
   double unit_max_cpu_;
   double unit_min_cpu_;
+  // numa node chosen by _enable_tenant_numa_affinity and the cpu placed on it
+  int64_t numa_node_;
+  double numa_node_cpu_;
 
   // tenant slice, it is calculated by quota. The slice is the average
   // number of token a tenant can get in every 10ms.
@@ -615,6 +635,10 @@ protected:
   int64_t ass_token_cnt_;
   int64_t lq_tokens_;
   int64_t used_lq_tokens_;
+  // 0 for no limit, by _tenant_worker_run_slots_per_cpu
+  int64_t run_slot_limit_;
+  // value is the number of workers holding a run slot
+  lib::ObFutex run_slots_;
   int64_t last_calibrate_worker_ts_;
   int64_t last_calibrate_token_ts_;
   int64_t last_pop_normal_cnt_;
@@ -624,8 +648,9 @@ protected:
   bool wait_mtl_finished_;
 
   /// tenant task queue,
-  // 'hp' for high priority and 'np' for normal priority
-  common::ObPriorityQueue2<1, QQ_MAX_PRIO - 1, RQ_MAX_PRIO - QQ_MAX_PRIO> req_queue_;
+  // 'hp' for high priority and 'np' for normal priority,
+  // sharded by _tenant_req_queue_shard_cnt
+  common::ObShardedPriorityQueue2<1, QQ_MAX_PRIO - 1, RQ_MAX_PRIO - QQ_MAX_PRIO> req_queue_;
   common::ObLinkQueue large_req_queue_;
 
   //Create a request queue for each level of nested requests
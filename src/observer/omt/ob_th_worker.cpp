@@ -21,6 +21,7 @@
 #include "lib/allocator/ob_page_manager.h"
 #include "lib/rc/context.h"
 #include "lib/thread/ob_thread_name.h"
+#include "lib/cpu/ob_cpu_topology.h"
 #include "ob_tenant.h"
 #include "ob_worker_processor.h"
 #include "share/config/ob_server_config.h"
@@ -52,7 +53,11 @@ ObThWorker::ObThWorker()
       query_start_time_(0), last_check_time_(0),
       can_retry_(true), need_retry_(false),
       active_(false), waiting_active_(false),
-      active_inactive_ts_(0L), lq_token_(false), has_add_to_cgroup_(false)
+      active_inactive_ts_(0L), lq_token_(false), has_add_to_cgroup_(false),
+      numa_node_(-1),
+      has_run_slot_(false),
+      run_slot_released_(false),
+      sched_wait_depth_(0)
 {
 }
 
@@ -381,6 +386,11 @@ void ObThWorker::worker(int64_t &tenant_id, int64_t &req_recv_timestamp, int32_t
           GCTX.cgroup_ctrl_->add_thread_to_cgroup(get_tid(), tenant_->id(), get_group_id());
           has_add_to_cgroup_ = true;
         }
+        if (OB_UNLIKELY(numa_node_ != tenant_->get_numa_node())) {
+          // a reused thread restores the process affinity for an unbound tenant
+          numa_node_ = tenant_->get_numa_node();
+          IGNORE_RETURN ObCpuTopology::get_instance().bind_thread_to_numa_node(numa_node_);
+        }
         if (OB_LIKELY(pm != nullptr)) {
           if (pm->get_used() != 0) {
             LOG_ERROR("page manager's used should be 0, unexpected!!!", KP(pm));
@@ -442,7 +452,9 @@ void ObThWorker::worker(int64_t &tenant_id, int64_t &req_recv_timestamp, int32_t
                   last_check_time_ = wait_end_time;
                   set_rpc_stat_srv(&(tenant_->rpc_stat_info_->rpc_stat_srv_));
                   req_start_time = ObTimeUtility::current_time();
+                  acquire_run_slot();
                   process_request(*req);
+                  release_run_slot();
                   req_end_time = ObTimeUtility::current_time();
                   tenant_->add_worker_time(req_end_time - req_start_time);
                   query_enqueue_time_ = INT64_MAX;
@@ -519,6 +531,47 @@ void ObThWorker::th_destroy()
   procor_.th_destroy();
 }
 
+void ObThWorker::acquire_run_slot()
+{
+  IGNORE_RETURN tenant_->acquire_run_slot();
+  has_run_slot_ = true;
+  run_slot_released_ = false;
+  sched_wait_depth_ = 0;
+}
+
+void ObThWorker::release_run_slot()
+{
+  if (has_run_slot_) {
+    tenant_->release_run_slot();
+    has_run_slot_ = false;
+  }
+  run_slot_released_ = false;
+  sched_wait_depth_ = 0;
+}
+
+// Waits nest, e.g. a sync rpc inside a lock retry, only the outermost pair gives
+// the slot out and takes it back.
+bool ObThWorker::sched_wait()
+{
+  if (0 == sched_wait_depth_++ && has_run_slot_ && OB_NOT_NULL(tenant_)) {
+    tenant_->release_run_slot();
+    has_run_slot_ = false;
+    run_slot_released_ = true;
+  }
+  return Worker::sched_wait();
+}
+
+bool ObThWorker::sched_run(int64_t waittime)
+{
+  if (sched_wait_depth_ > 0 && 0 == --sched_wait_depth_
+      && run_slot_released_ && OB_NOT_NULL(tenant_)) {
+    IGNORE_RETURN tenant_->acquire_run_slot();
+    has_run_slot_ = true;
+    run_slot_released_ = false;
+  }
+  return Worker::sched_run(waittime);
+}
+
 int ObThWorker::check_status()
 {
   int ret = OB_SUCCESS;
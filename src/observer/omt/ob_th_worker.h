@@ -71,6 +71,10 @@ public:
   virtual int check_status() override;
   virtual int check_large_query_quota();
 
+  // give the run slot out while blocking and take it back after
+  virtual bool sched_wait() override;
+  virtual bool sched_run(int64_t waittime=0) override;
+
   // retry relating
   virtual bool can_retry() const;
   virtual void set_need_retry();
@@ -104,6 +108,9 @@ private:
   void set_th_worker_thread_name(uint64_t tenant_id);
   void wait_runnable();
   void process_request(rpc::ObRequest &req);
+  // around process_request
+  void acquire_run_slot();
+  void release_run_slot();
 
   void th_created();
   void th_destroy();
@@ -142,6 +149,14 @@ private:
   int64_t active_inactive_ts_;
   bool lq_token_;
   bool has_add_to_cgroup_;
+  // numa node the thread is bound to, kept across tenants
+  int64_t numa_node_;
+  // holds a run slot of the tenant while processing a request
+  bool has_run_slot_;
+  // the run slot is given out in sched_wait
+  bool run_slot_released_;
+  // sched_wait not matched by a sched_run yet
+  int64_t sched_wait_depth_;
 
 private:
   DISALLOW_COPY_AND_ASSIGN(ObThWorker);
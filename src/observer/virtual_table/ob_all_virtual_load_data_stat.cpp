@@ -231,6 +231,66 @@ int ObAllVirtualLoadDataStat::inner_get_next_row(ObNewRow *&row)
           cells[i].set_collation_type(ObCharset::get_default_collation(ObCharset::get_default_charset()));
           break;
         }
+        case READ_STAGE_THREADS: {
+          cells[i].set_int(job_status->read_stage_.threads_);
+          break;
+        }
+        case READ_STAGE_BUSY_TIME: {
+          cells[i].set_int(job_status->read_stage_.busy_time_);
+          break;
+        }
+        case READ_STAGE_WAIT_TIME: {
+          cells[i].set_int(job_status->read_stage_.wait_time_);
+          break;
+        }
+        case READ_STAGE_QUEUE_SIZE: {
+          cells[i].set_int(job_status->read_stage_.queue_size_);
+          break;
+        }
+        case SPLIT_STAGE_THREADS: {
+          cells[i].set_int(job_status->split_stage_.threads_);
+          break;
+        }
+        case SPLIT_STAGE_BUSY_TIME: {
+          cells[i].set_int(job_status->split_stage_.busy_time_);
+          break;
+        }
+        case SPLIT_STAGE_WAIT_TIME: {
+          cells[i].set_int(job_status->split_stage_.wait_time_);
+          break;
+        }
+        case SPLIT_STAGE_QUEUE_SIZE: {
+          cells[i].set_int(job_status->split_stage_.queue_size_);
+          break;
+        }
+        case PARSE_STAGE_THREADS: {
+          cells[i].set_int(job_status->parse_stage_.threads_);
+          break;
+        }
+        case PARSE_STAGE_BUSY_TIME: {
+          cells[i].set_int(job_status->parse_stage_.busy_time_);
+          break;
+        }
+        case PARSE_STAGE_WAIT_TIME: {
+          cells[i].set_int(job_status->parse_stage_.wait_time_);
+          break;
+        }
+        case PARSE_STAGE_QUEUE_SIZE: {
+          cells[i].set_int(job_status->parse_stage_.queue_size_);
+          break;
+        }
+        case ROUTE_STAGE_THREADS: {
+          cells[i].set_int(job_status->route_stage_.threads_);
+          break;
+        }
+        case ROUTE_STAGE_BUSY_TIME: {
+          cells[i].set_int(job_status->route_stage_.busy_time_);
+          break;
+        }
+        case ROUTE_STAGE_WAIT_TIME: {
+          cells[i].set_int(job_status->route_stage_.wait_time_);
+          break;
+        }
         default: {
           ret = OB_ERR_UNEXPECTED;
           SERVER_LOG(WARN, "invalid col_id", K(ret), K(col_id));
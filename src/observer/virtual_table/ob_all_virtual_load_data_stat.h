@@ -74,7 +74,22 @@ private:
     STORE_PROCESSED_ROWS,
     STORE_LAST_COMMIT_SEGMENT_ID,
     STORE_STATUS,
-    STORE_TRANS_STATUS
+    STORE_TRANS_STATUS,
+    READ_STAGE_THREADS,
+    READ_STAGE_BUSY_TIME,
+    READ_STAGE_WAIT_TIME,
+    READ_STAGE_QUEUE_SIZE,
+    SPLIT_STAGE_THREADS,
+    SPLIT_STAGE_BUSY_TIME,
+    SPLIT_STAGE_WAIT_TIME,
+    SPLIT_STAGE_QUEUE_SIZE,
+    PARSE_STAGE_THREADS,
+    PARSE_STAGE_BUSY_TIME,
+    PARSE_STAGE_WAIT_TIME,
+    PARSE_STAGE_QUEUE_SIZE,
+    ROUTE_STAGE_THREADS,
+    ROUTE_STAGE_BUSY_TIME,
+    ROUTE_STAGE_WAIT_TIME
   };
   common::ObAddr addr_;
   char ip_buf_[common::OB_IP_STR_BUFF];
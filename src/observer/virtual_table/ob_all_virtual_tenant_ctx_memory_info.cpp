@@ -65,7 +65,8 @@ int ObAllVirtualTenantCtxMemoryInfo::inner_get_next_row(ObNewRow *&row)
         if (OB_ISNULL(ta)) {
           // do nothing
         } else {
-          ret = add_row(tenant_id, ctx_id, ta->get_hold(), ta->get_used(), ta->get_limit());
+          ret = add_row(tenant_id, ctx_id, ta->get_hold(), ta->get_used(), ta->get_limit(),
+                        ta->get_huge_page_hold());
         }
       }
     }
@@ -87,7 +88,8 @@ int ObAllVirtualTenantCtxMemoryInfo::inner_get_next_row(ObNewRow *&row)
   return ret;
 }
 
-int ObAllVirtualTenantCtxMemoryInfo::add_row(uint64_t tenant_id, int64_t ctx_id, int64_t hold, int64_t used, int64_t limit)
+int ObAllVirtualTenantCtxMemoryInfo::add_row(uint64_t tenant_id, int64_t ctx_id, int64_t hold, int64_t used, int64_t limit,
+                                             int64_t huge_page_hold)
 {
   int ret = OB_SUCCESS;
   ObObj *cells = nullptr;
@@ -134,6 +136,10 @@ int ObAllVirtualTenantCtxMemoryInfo::add_row(uint64_t tenant_id, int64_t ctx_id,
           cells[i].set_int(limit);
           break;
         }
+        case HUGE_PAGE_HOLD: {
+          cells[i].set_int(huge_page_hold);
+          break;
+        }
         default: {
           ret = OB_ERR_UNEXPECTED;
           SERVER_LOG(WARN, "unexpected column id", K(col_id), K(i), K(ret));
@@ -29,7 +29,8 @@ public:
   virtual void reset();
   virtual int inner_get_next_row(common::ObNewRow *&row);
 private:
-  int add_row(uint64_t tenant_id, int64_t ctx_id, int64_t hold, int64_t used, int64_t limit);
+  int add_row(uint64_t tenant_id, int64_t ctx_id, int64_t hold, int64_t used, int64_t limit,
+              int64_t huge_page_hold);
 private:
   enum CACHE_COLUMN
   {
@@ -41,6 +42,7 @@ private:
     HOLD,
     USED,
     LIMIT,
+    HUGE_PAGE_HOLD,
   };
   uint64_t tenant_ids_[OB_MAX_SERVER_TENANT_CNT];
   char ip_buf_[common::OB_IP_STR_BUFF];
@@ -328,6 +328,11 @@ public:
     other.mb_handle_ = nullptr;
     other.reset();
   }
+  // the memory block holding the value and its sequence number, which changes once the
+  // memory block is washed and reused, together they identify this copy of the value
+  inline const void *get_mb_handle() const { return mb_handle_; }
+  inline uint32_t get_mb_seq_num() const
+  { return NULL == mb_handle_ ? 0 : mb_handle_->get_seq_num(); }
   TO_STRING_KV(KP_(mb_handle));
 private:
   template<class Key, class Value> friend class ObIKVCache;
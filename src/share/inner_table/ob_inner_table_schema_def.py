@@ -9696,6 +9696,7 @@ def_table_schema(
   ('hold', 'int'),
   ('used', 'int'),
   ('limit', 'int'),
+  ('huge_page_hold', 'int'),
   ],
   partition_columns = ['svr_ip', 'svr_port'],
   vtable_route_policy = 'distributed',
@@ -10025,7 +10026,22 @@ def_table_schema(
     ('store_processed_rows', 'int'),
     ('store_last_commit_segment_id', 'int'),
     ('store_status', 'varchar:OB_MAX_PARAMETERS_NAME_LENGTH'),
-    ('store_trans_status', 'varchar:OB_MAX_PARAMETERS_NAME_LENGTH')
+    ('store_trans_status', 'varchar:OB_MAX_PARAMETERS_NAME_LENGTH'),
+    ('read_stage_threads', 'int'),
+    ('read_stage_busy_time', 'int'),
+    ('read_stage_wait_time', 'int'),
+    ('read_stage_queue_size', 'int'),
+    ('split_stage_threads', 'int'),
+    ('split_stage_busy_time', 'int'),
+    ('split_stage_wait_time', 'int'),
+    ('split_stage_queue_size', 'int'),
+    ('parse_stage_threads', 'int'),
+    ('parse_stage_busy_time', 'int'),
+    ('parse_stage_wait_time', 'int'),
+    ('parse_stage_queue_size', 'int'),
+    ('route_stage_threads', 'int'),
+    ('route_stage_busy_time', 'int'),
+    ('route_stage_wait_time', 'int')
   ],
   partition_columns = ['svr_ip', 'svr_port'],
   vtable_route_policy = 'distributed',
@@ -238,6 +238,14 @@ DEF_CAP(_hash_area_size, OB_TENANT_PARAMETER, "100M", "[4M,]",
 DEF_BOOL(_enable_partition_level_retry, OB_CLUSTER_PARAMETER, "True",
          "specifies whether allow the partition level retry when the leader changes",
          ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_index_lookup_mrr, OB_CLUSTER_PARAMETER, "False",
+         "specifies whether the local index lookup sorts the rowkeys of a batch, "
+         "coalesces consecutive rowkeys into ranges and restores the index order afterwards",
+         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_regexp_fast_path, OB_CLUSTER_PARAMETER, "False",
+         "specifies whether REGEXP and REGEXP_LIKE try a literal prefilter and a byte level DFA "
+         "on the utf8mb4 text before ICU",
+         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 //https://yuque.antfin-inc.com/ob/product_functionality_review/zlp56c
 DEF_INT_WITH_CHECKER(_enable_defensive_check, OB_CLUSTER_PARAMETER, "1",
                      common::ObConfigEnableDefensiveChecker,
@@ -321,6 +329,10 @@ DEF_INT(_rowsets_target_maxsize, OB_TENANT_PARAMETER, "524288", "[262144, 838860
 DEF_INT(_rowsets_max_rows, OB_TENANT_PARAMETER, "256", "[0, 65535]",
         "the row number processed by vectorized sql engine within one batch. Range: [0, 65535]",
         ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_INT(_sql_filter_jit_threshold, OB_CLUSTER_PARAMETER, "0", "[0,)",
+        "the plan cache hit count after which the vectorized filters of a plan are compiled "
+        "into native code by the plan cache evict task. 0 means disabled. Range: [0, +∞)",
+        ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_STR_WITH_CHECKER(_ctx_memory_limit, OB_TENANT_PARAMETER, "",
         common::ObCtxMemoryLimitChecker,
         "specifies tenant ctx memory limit.",
@@ -380,6 +392,15 @@ DEF_BOOL(_px_message_compression, OB_TENANT_PARAMETER, "True",
 DEF_INT(_px_chunklist_count_ratio, OB_CLUSTER_PARAMETER, "1", "[1, 128]",
         "the ratio of the dtl buffer manager list. Range: [1, 128]",
         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_INT(_px_adaptive_granule_factor, OB_CLUSTER_PARAMETER, "1", "[1, 64]",
+        "the block granules of a random GI are split this many times finer and merged back into "
+        "large granules at the head of the shared pool, so that the granules shrink as the scan "
+        "nears the end. 1 means disabled. Range: [1, 64]",
+        ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_px_enable_local_swizzled_exchange, OB_CLUSTER_PARAMETER, "False",
+         "specifies whether the datum rows sent through a local DTL channel keep their absolute "
+         "pointers, so that the receiver reads the block without swizzling it",
+         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_BOOL(_sqlexec_disable_hash_based_distagg_tiv, OB_TENANT_PARAMETER, "False",
          "disable hash based distinct aggregation in the second stage of three stage aggregation for gby queries"
          "Value:  True:turned on  False: turned off",
@@ -400,6 +421,10 @@ DEF_INT(_enable_hash_join_processor, OB_TENANT_PARAMETER, "7", "[1, 7]",
          "which path to process for hash join, default 7 to auto choose "
          "1: nest loop, 2: recursive, 4: in-memory",
          ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_INT(_hash_join_index_probe_threshold, OB_TENANT_PARAMETER, "0", "[0, 4096]",
+        "the max count of distinct build keys for which a hash join restricts the scan of "
+        "its probe side table to the index prefixes of these keys, 0 to disable",
+        ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_INT(_pushdown_storage_level, OB_TENANT_PARAMETER, "3", "[0, 3]",
         "the level of storage pushdown. Range: [0, 3] "
         "0: disabled, 1:blockscan, 2: blockscan & filter, 3: blockscan & filter & aggregate",
@@ -661,10 +686,20 @@ DEF_INT(_tx_result_retention, OB_TENANT_PARAMETER, "300", "[0, 36000]",
         "The tx data can be recycled after at least _tx_result_retention seconds. "
         "Range: [0, 36000]",
         ObParameterAttr(Section::TRANS, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_TIME(_hot_row_update_batch_window, OB_TENANT_PARAMETER, "0ms", "[0ms, 10ms]",
+         "how long an autocommit UPDATE t SET c = c + ? WHERE pk = ? on a row updated again within "
+         "the window waits for the updates on the same row to be merged into one transaction, "
+         "0 means disabled. Range: [0ms, 10ms]",
+         ObParameterAttr(Section::TRANS, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 
 DEF_TIME(_ob_get_gts_ahead_interval, OB_CLUSTER_PARAMETER, "0s", "[0s, 1s]",
          "get gts ahead interval. Range: [0s, 1s]",
          ObParameterAttr(Section::TRANS, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_gts_batch_request, OB_CLUSTER_PARAMETER, "False",
+         "specifies whether the periodic gts refresh of all tenants towards the same server "
+         "is coalesced into one batch rpc, turn it on only after every server is upgraded. "
+         "Value: True:enable; False: disable",
+         ObParameterAttr(Section::TRANS, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 
 //// rpc config
 DEF_TIME(rpc_timeout, OB_CLUSTER_PARAMETER, "2s",
@@ -957,6 +992,11 @@ DEF_INT(_px_max_pipeline_depth, OB_CLUSTER_PARAMETER, "2", "[2,3]",
         "max parallel execution pipeline depth, "
         "range: [2,3]",
         ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_px_enable_bushy_dfo_scheduling, OB_CLUSTER_PARAMETER, "False",
+         "specifies whether PX schedules independent DFO pairs concurrently as long as the "
+         "admitted workers of the query are enough, and lets blocking operators stream into the "
+         "next DFO when the three DFOs fit into the admitted workers",
+         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 //ssl
 DEF_BOOL(ssl_client_authentication, OB_CLUSTER_PARAMETER, "False",
          "enable server SSL support. Takes effect after ca/cert/key file is configured correctly. ",
@@ -1090,6 +1130,11 @@ DEF_STR_WITH_CHECKER(use_large_pages, OB_CLUSTER_PARAMETER, "false",
                      "used to manage the database's use of large pages, "
                      "values: false, true, only",
                      ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::STATIC_EFFECTIVE));
+DEF_STR(_ctx_huge_page_policy, OB_CLUSTER_PARAMETER, "",
+        "huge page policy of the memory chunks allocated afterwards by a ctx, overrides use_large_pages, "
+        "a list of ctx_name:policy and policy is one of thp, hugetlb and none, "
+        "e.g. KVSTORE_CACHE_ID:thp,MEMSTORE_CTX_ID:thp",
+        ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 
 DEF_STR(ob_ssl_invited_common_names, OB_TENANT_PARAMETER, "NONE",
         "when server use ssl, use it to control client identity with ssl subject common name. default NONE",
@@ -1224,6 +1269,31 @@ DEF_BOOL(_enable_trace_session_leak, OB_CLUSTER_PARAMETER, "False",
 DEF_BOOL(_ob_enable_fast_parser, OB_CLUSTER_PARAMETER, "True",
          "control if enable fast parser",
          ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_raw_sql_cache, OB_CLUSTER_PARAMETER, "False",
+         "enable caching the plan cache keys of the text statements without parameters by their "
+         "raw sql, so that exact repeats skip the fast parser. Value: True:turned on  False: turned off",
+         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_mysql_batch_result_encode, OB_CLUSTER_PARAMETER, "True",
+         "enable encoding the text protocol rows of a vectorized plan from its batch datums directly, "
+         "skipping the conversion to ObObj. Value: True:turned on  False: turned off",
+         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_INT(_tenant_req_queue_shard_cnt, OB_CLUSTER_PARAMETER, "1", "[1,16]",
+        "the number of sub queues the request queue of each tenant is split into, requests of a "
+        "connection stay in the same sub queue and idle workers steal from the others. Range: [1,16]",
+        ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::STATIC_EFFECTIVE));
+DEF_INT(_tenant_worker_run_slots_per_cpu, OB_CLUSTER_PARAMETER, "0", "[0,64]",
+        "the number of tenant workers per cpu of max_cpu allowed to run requests at the same time, "
+        "a worker waiting for a sync rpc, gts or a lock retry gives its slot to the others. "
+        "0 for no limit. Range: [0,64]",
+        ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_tenant_numa_affinity, OB_CLUSTER_PARAMETER, "False",
+         "bind the worker threads and the memory of a tenant whose unit fits in a numa node to "
+         "that node. Value: True:turned on  False: turned off",
+         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::STATIC_EFFECTIVE));
+DEF_BOOL(_enable_alloc_object_cache, OB_CLUSTER_PARAMETER, "False",
+         "enable the per core caches of the small objects freed recently in front of the object "
+         "sets of the tenant ctx allocators. Value: True:turned on  False: turned off",
+         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 
 DEF_TIME(_ob_obj_dep_maint_task_interval, OB_CLUSTER_PARAMETER, "1ms", "[0,10s]",
          "The execution interval of the task of maintaining the dependency of the object. "\
@@ -1340,12 +1410,21 @@ DEF_TIME(_ob_plan_cache_auto_flush_interval, OB_CLUSTER_PARAMETER, "0s", "[0s,)"
 DEF_BOOL(_ob_enable_direct_load, OB_CLUSTER_PARAMETER, "True",
          "Enable or disable direct path load",
          ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_INT(_load_data_parse_thread_count, OB_TENANT_PARAMETER, "0", "[0, 256]",
+        "the number of threads of the parse and route stages of direct path load data, "
+        "used when the statement has no PARALLEL hint, 0 means the built-in default. "
+        "The read and split stages always run one thread each. Range: [0, 256]",
+        ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_BOOL(_px_join_skew_handling, OB_TENANT_PARAMETER, "True",
         "enables skew handling for parallel joins. The  default value is True.",
         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_INT(_px_join_skew_minfreq, OB_TENANT_PARAMETER, "30", "[1,100]",
         "sets minimum frequency(%) for skewed value for parallel joins. Range: [1, 100] in integer",
         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_px_join_skew_sampling, OB_TENANT_PARAMETER, "False",
+        "enables detecting skewed values of parallel hash joins by sampling the build side at runtime, "
+        "when the histogram is missing or stale. The default value is False.",
+        ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_BOOL(_enable_protocol_diagnose, OB_CLUSTER_PARAMETER, "True",
         "enables protocol layer diagnosis. The default value is False.",
         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
@@ -2917,6 +2917,59 @@ int ObStaticEngineCG::generate_spec(ObLogExchange &op, ObPxDistTransmitSpec &spe
     } else if (OB_FAIL(generate_popular_values_hash(
                 spec.dist_hash_funcs_.at(0), *op.get_popular_values(), spec.popular_values_hash_))){
       LOG_WARN("fail generate popular values", K(ret));
+    } else if (op.need_skew_sample()
+               && OB_FAIL(get_skew_sample_op_id(op, spec.skew_sample_op_id_))) {
+      LOG_WARN("fail to get skew sample op id", K(ret));
+    }
+  }
+  return ret;
+}
+
+// Both sides of the hybrid hash join talk to the datahub with the op id of the build
+// side transmit. The probe side finds it in the build child of the join, and samples
+// nothing if it's not found, which is always correct, see ObSkewKeyPieceMsg.
+int ObStaticEngineCG::get_skew_sample_op_id(ObLogExchange &op, uint64_t &op_id)
+{
+  int ret = OB_SUCCESS;
+  op_id = OB_INVALID_ID;
+  if (ObPQDistributeMethod::HYBRID_HASH_BROADCAST == op.get_dist_method()) {
+    op_id = op.get_op_id();
+  } else {
+    ObLogicalOperator *join = op.get_parent();
+    ObLogExchange *build_exchange = NULL;
+    while (NULL != join && log_op_def::LOG_JOIN != join->get_type()) {
+      join = join->get_parent();
+    }
+    if (NULL == join || join->get_num_of_child() < 2) {
+      // do nothing
+    } else if (OB_FAIL(find_hybrid_hash_build_exchange(join->get_child(0), build_exchange))) {
+      LOG_WARN("fail to find build side exchange", K(ret));
+    } else if (NULL != build_exchange && build_exchange->need_skew_sample()) {
+      op_id = build_exchange->get_op_id();
+    }
+  }
+  return ret;
+}
+
+int ObStaticEngineCG::find_hybrid_hash_build_exchange(ObLogicalOperator *op,
+                                                      ObLogExchange *&exchange)
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(op)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("op is null", K(ret));
+  } else if (log_op_def::LOG_EXCHANGE == op->get_type()
+             && static_cast<ObLogExchange *>(op)->is_producer()) {
+    // operators below belong to other dfos
+    if (ObPQDistributeMethod::HYBRID_HASH_BROADCAST
+        == static_cast<ObLogExchange *>(op)->get_dist_method()) {
+      exchange = static_cast<ObLogExchange *>(op);
+    }
+  } else {
+    for (int64_t i = 0; OB_SUCC(ret) && NULL == exchange && i < op->get_num_of_child(); ++i) {
+      if (OB_FAIL(SMART_CALL(find_hybrid_hash_build_exchange(op->get_child(i), exchange)))) {
+        LOG_WARN("fail to find build side exchange", K(ret));
+      }
     }
   }
   return ret;
@@ -4125,6 +4178,7 @@ int ObStaticEngineCG::generate_spec(ObLogJoin &op, ObHashJoinSpec &spec, const b
   spec.is_shared_ht_ = HASH_JOIN == op.get_join_algo()
                     && DIST_BC2HOST_NONE == op.get_join_distributed_method();
   OZ (generate_join_spec(op, spec));
+  OZ (check_probe_by_build_keys(op, spec));
   return ret;
 }
 int ObStaticEngineCG::generate_spec(ObLogJoin &op,
@@ -4520,6 +4574,64 @@ int ObStaticEngineCG::calc_equal_cond_opposite(const ObLogJoin &op,
   return ret;
 }
 
+// A tiny build side can restrict the right table scan to the index prefixes of the
+// build keys at runtime, which needs a single integer equal join key that is the first
+// range column of a local table scan right below the hash join.
+int ObStaticEngineCG::check_probe_by_build_keys(const ObLogJoin &op, ObHashJoinSpec &spec)
+{
+  int ret = OB_SUCCESS;
+  const ObLogicalOperator *right_child = op.get_child(1);
+  const ObJoinType join_type = op.get_join_type();
+  spec.probe_by_build_keys_ = false;
+  if (spec.is_naaj_ || spec.is_shared_ht_
+      || 1 != spec.equal_join_conds_.count()
+      || 2 != spec.all_join_keys_.count()
+      || 1 != op.get_equal_join_conditions().count()
+      || (INNER_JOIN != join_type && LEFT_SEMI_JOIN != join_type
+          && LEFT_ANTI_JOIN != join_type && LEFT_OUTER_JOIN != join_type)
+      || OB_ISNULL(right_child)
+      || log_op_def::LOG_TABLE_SCAN != right_child->get_type()
+      || OB_ISNULL(spec.get_right())
+      || PHY_TABLE_SCAN != spec.get_right()->get_type()) {
+    // do nothing
+  } else {
+    const ObLogTableScan *scan = static_cast<const ObLogTableScan *>(right_child);
+    const ObRawExpr *equal_expr = op.get_equal_join_conditions().at(0);
+    const ObExpr *left_key = spec.all_join_keys_.at(0);
+    const ObExpr *right_key = spec.all_join_keys_.at(1);
+    const ObRawExpr *raw_right_key = NULL;
+    bool is_opposite = false;
+    if (OB_ISNULL(equal_expr) || OB_ISNULL(left_key) || OB_ISNULL(right_key)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("unexpected null join key", K(ret), KP(equal_expr), KP(left_key), KP(right_key));
+    } else if (T_OP_EQ != equal_expr->get_expr_type()) {
+      // null safe equal matches null keys
+    } else if (OB_FAIL(calc_equal_cond_opposite(op, *equal_expr, is_opposite))) {
+      LOG_WARN("failed to calc equal condition opposite", K(ret));
+    } else if (OB_ISNULL(raw_right_key = equal_expr->get_param_expr(is_opposite ? 0 : 1))) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("right join key is null", K(ret));
+    } else if (!raw_right_key->is_column_ref_expr()
+               || left_key->datum_meta_.type_ != right_key->datum_meta_.type_
+               || !(ob_is_int_tc(right_key->datum_meta_.type_)
+                    || ob_is_uint_tc(right_key->datum_meta_.type_))
+               || scan->get_is_index_global()
+               || scan->use_batch()
+               || scan->is_skip_scan()
+               || scan->get_is_spatial_index()
+               || is_virtual_table(scan->get_ref_table_id())
+               || scan->get_range_columns().empty()) {
+      // do nothing
+    } else {
+      const ObColumnRefRawExpr *col = static_cast<const ObColumnRefRawExpr *>(raw_right_key);
+      const ColumnItem &first_range_col = scan->get_range_columns().at(0);
+      spec.probe_by_build_keys_ = col->get_table_id() == scan->get_table_id()
+                                  && col->get_column_id() == first_range_col.column_id_;
+    }
+  }
+  return ret;
+}
+
 int ObStaticEngineCG::set_optimization_info(ObLogTableScan &op, ObTableScanSpec &spec)
 {
   int ret = OB_SUCCESS;
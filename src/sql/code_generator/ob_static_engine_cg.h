@@ -404,6 +404,7 @@ private:
   int calc_equal_cond_opposite(const ObLogJoin &op,
                                const ObRawExpr &raw_expr,
                                bool &is_opposite);
+  int check_probe_by_build_keys(const ObLogJoin &op, ObHashJoinSpec &spec);
   int fill_sort_info(
     const ObIArray<OrderItem> &sort_keys,
     ObSortCollations &collations,
@@ -440,6 +441,8 @@ private:
       const common::ObHashFunc &hash_func,
       const ObIArray<common::ObObj> &popular_values_expr,
       common::ObFixedArray<uint64_t, common::ObIAllocator> &popular_values_hash);
+  int get_skew_sample_op_id(ObLogExchange &op, uint64_t &op_id);
+  int find_hybrid_hash_build_exchange(ObLogicalOperator *op, ObLogExchange *&exchange);
   int generate_delete_with_das(ObLogDelete &op, ObTableDeleteSpec &spec);
 
   int fill_wf_info(ObIArray<ObExpr *> &all_expr, ObWinFunRawExpr &win_expr,
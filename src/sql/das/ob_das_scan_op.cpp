@@ -767,6 +767,7 @@ int ObLocalIndexLookupOp::init(const ObDASScanCtDef *lookup_ctdef,
   tx_desc_ = tx_desc;
   snapshot_ = snapshot;
   state_ = INDEX_SCAN;
+  enable_mrr_ = GCONF._enable_index_lookup_mrr;
   if (OB_ISNULL(lookup_memctx_)) {
     lib::ContextParam param;
     param.set_mem_attr(MTL_ID(), ObModIds::OB_SQL_TABLE_LOOKUP, ObCtxIds::DEFAULT_CTX_ID)
@@ -915,6 +916,8 @@ int ObLocalIndexLookupOp::do_index_lookup()
     //first index lookup, init scan param and do table scan
     if (OB_FAIL(init_scan_param())) {
       LOG_WARN("init scan param failed", K(ret));
+    } else if (OB_FAIL(prepare_mrr_ranges())) {
+      LOG_WARN("prepare mrr ranges failed", K(ret));
     } else if (OB_FAIL(tsc_service.table_scan(scan_param_,
                        storage_iter))) {
       if (OB_SNAPSHOT_DISCARDED == ret && scan_param_.fb_snapshot_.is_valid()) {
@@ -928,6 +931,8 @@ int ObLocalIndexLookupOp::do_index_lookup()
     scan_param_.ls_id_ = ls_id_;
     if (OB_FAIL(reuse_iter())) {
       LOG_WARN("failed to reuse iter", K(ret));
+    } else if (OB_FAIL(prepare_mrr_ranges())) {
+      LOG_WARN("prepare mrr ranges failed", K(ret));
     } else if (OB_FAIL(tsc_service.table_rescan(scan_param_, storage_iter))) {
       LOG_WARN("table_rescan scan iter failed", K(ret));
     }
@@ -942,6 +947,16 @@ int ObLocalIndexLookupOp::get_next_row_from_data_table()
   if (scan_param_.key_ranges_.empty()) {
     ret= OB_ITER_END;
     state_ = FINISHED;
+  } else if (is_mrr_reordered_ && !is_mrr_filled_
+             && OB_FAIL(fill_mrr_rows(false/*is_vectorized*/, 1))) {
+    // fill_mrr_rows falls back to lookup in index order when the rows mismatch the keys
+    LOG_WARN("fill mrr rows failed", K(ret));
+  } else if (is_mrr_reordered_) {
+    if (OB_FAIL(get_next_row_from_mrr_rows())) {
+      if (OB_ITER_END != ret) {
+        LOG_WARN("get next row from mrr rows failed", K(ret));
+      }
+    }
   } else if (OB_FAIL(lookup_iter_->get_next_row())) {
     if (OB_ITER_END != ret) {
       LOG_WARN("get next row from data table failed", K(ret));
@@ -960,6 +975,15 @@ int ObLocalIndexLookupOp::get_next_rows_from_data_table(int64_t &count, int64_t
   if (scan_param_.key_ranges_.empty()) {
     ret = OB_ITER_END;
     state_ = FINISHED;
+  } else if (is_mrr_reordered_ && !is_mrr_filled_
+             && OB_FAIL(fill_mrr_rows(true/*is_vectorized*/, capacity))) {
+    LOG_WARN("fill mrr rows failed", K(ret), K(capacity));
+  } else if (is_mrr_reordered_) {
+    if (OB_FAIL(get_next_rows_from_mrr_rows(count, capacity))) {
+      if (OB_ITER_END != ret) {
+        LOG_WARN("get next rows from mrr rows failed", K(ret));
+      }
+    }
   } else {
     ret = lookup_iter_->get_next_rows(count, capacity);
     if (OB_ITER_END == ret && count > 0) {
@@ -1163,6 +1187,8 @@ int ObLocalIndexLookupOp::reset_lookup_state(bool need_switch_param)
     scan_param_.key_ranges_.reuse();
     scan_param_.ss_key_ranges_.reuse();
   }
+  is_mrr_reordered_ = false;
+  is_mrr_filled_ = false;
   if (OB_SUCC(ret) && lookup_memctx_ != nullptr) {
     lookup_memctx_->reset_remain_one_page();
   }
@@ -1170,6 +1196,275 @@ int ObLocalIndexLookupOp::reset_lookup_state(bool need_switch_param)
   return ret;
 }
 
+bool ObLocalIndexLookupOp::can_use_mrr() const
+{
+  // restoring the index order relies on each lookup key outputting exactly one row,
+  // so the lookup must be neither filtered nor limited
+  return enable_mrr_
+      && !is_group_scan_
+      && !is_virtual_table(lookup_ctdef_->ref_table_id_)
+      && lookup_ctdef_->pd_expr_spec_.pushdown_filters_.empty()
+      && !scan_param_.limit_param_.is_valid()
+      && scan_param_.key_ranges_.count() > 1;
+}
+
+// two rowkeys are consecutive if they differ only in the last column, which is an
+// integer and increases by exactly one, so the range between them holds no other row
+static int is_consecutive_rowkey(const ObRowkey &prev, const ObRowkey &next, bool &is_consecutive)
+{
+  int ret = OB_SUCCESS;
+  const int64_t cnt = prev.get_obj_cnt();
+  is_consecutive = false;
+  if (cnt > 0 && cnt == next.get_obj_cnt()) {
+    const ObObj &prev_last = prev.get_obj_ptr()[cnt - 1];
+    const ObObj &next_last = next.get_obj_ptr()[cnt - 1];
+    if (prev_last.get_type() != next_last.get_type()) {
+    } else if (ob_is_int_tc(prev_last.get_type())) {
+      is_consecutive = prev_last.get_int() != INT64_MAX
+          && next_last.get_int() == prev_last.get_int() + 1;
+    } else if (ob_is_uint_tc(prev_last.get_type())) {
+      is_consecutive = prev_last.get_uint64() != UINT64_MAX
+          && next_last.get_uint64() == prev_last.get_uint64() + 1;
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && is_consecutive && i < cnt - 1; ++i) {
+      int cmp = 0;
+      if (OB_FAIL(prev.get_obj_ptr()[i].compare(next.get_obj_ptr()[i], cmp))) {
+        LOG_WARN("compare rowkey obj failed", K(ret), K(i), K(prev), K(next));
+      } else {
+        is_consecutive = (0 == cmp);
+      }
+    }
+  }
+  return ret;
+}
+
+int ObLocalIndexLookupOp::prepare_mrr_ranges()
+{
+  int ret = OB_SUCCESS;
+  is_mrr_reordered_ = false;
+  is_mrr_filled_ = false;
+  // lookup to main table invokes multi get unless consecutive keys are coalesced
+  scan_param_.is_get_ = true;
+  if (can_use_mrr()) {
+    ObRangeArray &key_ranges = scan_param_.key_ranges_;
+    const int64_t range_cnt = key_ranges.count();
+    int cmp_ret = OB_SUCCESS;
+    mrr_positions_.reuse();
+    for (int64_t i = 0; OB_SUCC(ret) && i < range_cnt; ++i) {
+      if (OB_FAIL(mrr_positions_.push_back(i))) {
+        LOG_WARN("store mrr position failed", K(ret), K(i));
+      }
+    }
+    if (OB_SUCC(ret)) {
+      std::sort(mrr_positions_.begin(), mrr_positions_.end(),
+                [&key_ranges, &cmp_ret](int64_t l, int64_t r) {
+                  int cmp = 0;
+                  if (OB_SUCCESS == cmp_ret) {
+                    cmp_ret = key_ranges.at(l).start_key_.compare(key_ranges.at(r).start_key_, cmp);
+                  }
+                  return cmp < 0;
+                });
+      if (OB_FAIL(cmp_ret)) {
+        LOG_WARN("sort lookup rowkeys failed", K(ret));
+      }
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && !is_mrr_reordered_ && i < range_cnt; ++i) {
+      is_mrr_reordered_ = (mrr_positions_.at(i) != i);
+    }
+    // coalesce consecutive keys only when it at least halves the ranges,
+    // otherwise multi get with row cache and bloom filter is cheaper
+    ObRangeArray sorted_ranges;
+    int64_t coalesced_cnt = 0;
+    for (int64_t i = 0; OB_SUCC(ret) && i < range_cnt; ++i) {
+      const ObNewRange &range = key_ranges.at(mrr_positions_.at(i));
+      bool is_consecutive = false;
+      if (i > 0 && OB_FAIL(is_consecutive_rowkey(sorted_ranges.at(i - 1).start_key_,
+                                                 range.start_key_,
+                                                 is_consecutive))) {
+        LOG_WARN("check consecutive rowkey failed", K(ret));
+      } else if (OB_FAIL(sorted_ranges.push_back(range))) {
+        LOG_WARN("store sorted range failed", K(ret));
+      } else if (!is_consecutive) {
+        ++coalesced_cnt;
+      }
+    }
+    if (OB_SUCC(ret) && coalesced_cnt * 2 <= range_cnt) {
+      int64_t last = 0;
+      ObRowkey prev_key = sorted_ranges.at(0).start_key_;
+      for (int64_t i = 1; OB_SUCC(ret) && i < range_cnt; ++i) {
+        const ObRowkey cur_key = sorted_ranges.at(i).start_key_;
+        bool is_consecutive = false;
+        if (OB_FAIL(is_consecutive_rowkey(prev_key, cur_key, is_consecutive))) {
+          LOG_WARN("check consecutive rowkey failed", K(ret));
+        } else if (is_consecutive) {
+          sorted_ranges.at(last).end_key_ = sorted_ranges.at(i).end_key_;
+        } else {
+          sorted_ranges.at(++last) = sorted_ranges.at(i);
+        }
+        prev_key = cur_key;
+      }
+      while (OB_SUCC(ret) && sorted_ranges.count() > last + 1) {
+        sorted_ranges.pop_back();
+      }
+      scan_param_.is_get_ = false;
+    }
+    if (OB_SUCC(ret) && (is_mrr_reordered_ || !scan_param_.is_get_)) {
+      if (is_mrr_reordered_ && OB_FAIL(mrr_origin_ranges_.assign(key_ranges))) {
+        LOG_WARN("store origin ranges failed", K(ret));
+      } else if (OB_FAIL(key_ranges.assign(sorted_ranges))) {
+        LOG_WARN("assign sorted ranges failed", K(ret));
+      }
+    }
+    LOG_DEBUG("prepare mrr ranges", K(ret), K(range_cnt), K(coalesced_cnt),
+              K(is_mrr_reordered_), K(scan_param_.is_get_));
+  }
+  return ret;
+}
+
+int ObLocalIndexLookupOp::fill_mrr_rows(const bool is_vectorized, const int64_t capacity)
+{
+  int ret = OB_SUCCESS;
+  const ExprFixedArray &exprs = get_output_expr();
+  ObEvalCtx &eval_ctx = get_eval_ctx();
+  const int64_t row_cnt = mrr_positions_.count();
+  int64_t row_idx = 0;
+  // a key outputs other than one row, the rows can not be matched to the keys by position
+  bool is_mrr_mismatched = false;
+  ObBitVector *skip = nullptr;
+  ObChunkDatumStore::StoredRow **stored_rows = nullptr;
+  mrr_store_.reset();
+  mrr_rows_.reuse();
+  mrr_output_idx_ = 0;
+  if (OB_FAIL(mrr_store_.init(INT64_MAX,
+                              MTL_ID(),
+                              ObCtxIds::DEFAULT_CTX_ID,
+                              "SqlLookupMRR",
+                              false/*enable_dump*/))) {
+    LOG_WARN("init mrr store failed", K(ret));
+  } else if (OB_FAIL(mrr_rows_.prepare_allocate(row_cnt))) {
+    LOG_WARN("prepare allocate mrr rows failed", K(ret), K(row_cnt));
+  } else if (is_vectorized) {
+    ObIAllocator &alloc = lookup_memctx_->get_arena_allocator();
+    void *skip_buf = nullptr;
+    void *rows_buf = nullptr;
+    if (OB_ISNULL(skip_buf = alloc.alloc(ObBitVector::memory_size(capacity)))
+        || OB_ISNULL(rows_buf = alloc.alloc(sizeof(ObChunkDatumStore::StoredRow *) * capacity))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("allocate mrr batch buffer failed", K(ret), K(capacity));
+    } else {
+      skip = to_bit_vector(skip_buf);
+      skip->reset(capacity);
+      stored_rows = static_cast<ObChunkDatumStore::StoredRow **>(rows_buf);
+    }
+  }
+  while (OB_SUCC(ret)) {
+    lookup_rtdef_->p_pd_expr_op_->clear_evaluated_flag();
+    if (!is_vectorized) {
+      ObChunkDatumStore::StoredRow *stored_row = nullptr;
+      if (OB_FAIL(lookup_iter_->get_next_row())) {
+        if (OB_ITER_END != ret) {
+          LOG_WARN("get next row from data table failed", K(ret));
+        }
+      } else if (OB_UNLIKELY(row_idx >= row_cnt)) {
+        is_mrr_mismatched = true;
+        break;
+      } else if (OB_FAIL(mrr_store_.add_row(exprs, &eval_ctx, &stored_row))) {
+        LOG_WARN("add row to mrr store failed", K(ret));
+      } else {
+        mrr_rows_.at(mrr_positions_.at(row_idx++)) = stored_row;
+      }
+    } else {
+      int64_t count = 0;
+      int64_t stored_cnt = 0;
+      ret = lookup_iter_->get_next_rows(count, capacity);
+      if (OB_ITER_END == ret && count > 0) {
+        ret = OB_SUCCESS;
+      }
+      if (OB_FAIL(ret)) {
+        if (OB_ITER_END != ret) {
+          LOG_WARN("get next rows from data table failed", K(ret));
+        }
+      } else if (OB_UNLIKELY(row_idx + count > row_cnt)) {
+        is_mrr_mismatched = true;
+        break;
+      } else if (OB_FAIL(mrr_store_.add_batch(exprs, eval_ctx, *skip, count,
+                                              stored_cnt, stored_rows))) {
+        LOG_WARN("add batch to mrr store failed", K(ret), K(count));
+      } else {
+        for (int64_t i = 0; i < stored_cnt; ++i) {
+          mrr_rows_.at(mrr_positions_.at(row_idx++)) = stored_rows[i];
+        }
+      }
+    }
+  }
+  if (OB_ITER_END == ret) {
+    ret = OB_SUCCESS;
+    if (OB_UNLIKELY(row_idx != row_cnt)) {
+      is_mrr_mismatched = true;
+    } else {
+      is_mrr_filled_ = true;
+    }
+  }
+  if (OB_SUCC(ret) && is_mrr_mismatched) {
+    LOG_TRACE("mrr lookup row count mismatch, lookup again in index order",
+              K(row_idx), K(row_cnt), "scan_range", scan_param_.key_ranges_);
+    if (OB_FAIL(fallback_from_mrr())) {
+      LOG_WARN("fallback from mrr failed", K(ret));
+    }
+  }
+  return ret;
+}
+
+int ObLocalIndexLookupOp::fallback_from_mrr()
+{
+  int ret = OB_SUCCESS;
+  ObITabletScan &tsc_service = get_tsc_service();
+  mrr_store_.reset();
+  mrr_rows_.reuse();
+  is_mrr_reordered_ = false;
+  is_mrr_filled_ = false;
+  scan_param_.is_get_ = true;
+  if (OB_FAIL(scan_param_.key_ranges_.assign(mrr_origin_ranges_))) {
+    LOG_WARN("restore origin ranges failed", K(ret));
+  } else if (OB_FAIL(reuse_iter())) {
+    LOG_WARN("failed to reuse iter", K(ret));
+  } else if (OB_FAIL(tsc_service.table_rescan(scan_param_, get_lookup_storage_iter()))) {
+    LOG_WARN("table_rescan scan iter failed", K(ret));
+  }
+  return ret;
+}
+
+int ObLocalIndexLookupOp::get_next_row_from_mrr_rows()
+{
+  int ret = OB_SUCCESS;
+  if (mrr_output_idx_ >= mrr_rows_.count()) {
+    ret = OB_ITER_END;
+  } else if (OB_FAIL(mrr_rows_.at(mrr_output_idx_)->to_expr<true>(get_output_expr(),
+                                                                   get_eval_ctx()))) {
+    LOG_WARN("convert mrr row to expr failed", K(ret), K(mrr_output_idx_));
+  } else {
+    ++mrr_output_idx_;
+  }
+  return ret;
+}
+
+int ObLocalIndexLookupOp::get_next_rows_from_mrr_rows(int64_t &count, int64_t capacity)
+{
+  int ret = OB_SUCCESS;
+  count = 0;
+  if (mrr_output_idx_ >= mrr_rows_.count()) {
+    ret = OB_ITER_END;
+  } else {
+    count = min(capacity, mrr_rows_.count() - mrr_output_idx_);
+    ObChunkDatumStore::Iterator::attach_rows<true>(get_output_expr(),
+                                                   get_eval_ctx(),
+                                                   &mrr_rows_.at(mrr_output_idx_),
+                                                   count);
+    mrr_output_idx_ += count;
+  }
+  return ret;
+}
+
 int ObLocalIndexLookupOp::revert_iter()
 {
   int ret = OB_SUCCESS;
@@ -1182,6 +1477,12 @@ int ObLocalIndexLookupOp::revert_iter()
   lookup_iter_ = NULL;
   scan_param_.destroy_schema_guard();
   scan_param_.~ObTableScanParam();
+  mrr_store_.reset();
+  mrr_positions_.reset();
+  mrr_rows_.reset();
+  mrr_origin_ranges_.reset();
+  is_mrr_reordered_ = false;
+  is_mrr_filled_ = false;
   if (lookup_memctx_ != nullptr) {
     lookup_memctx_->reset_remain_one_page();
     DESTROY_CONTEXT(lookup_memctx_);
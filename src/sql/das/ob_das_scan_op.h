@@ -253,6 +253,11 @@ public:
       ls_id_(),
       scan_param_(),
       lookup_memctx_(),
+      mrr_store_(),
+      mrr_positions_(),
+      mrr_rows_(),
+      mrr_origin_ranges_(),
+      mrr_output_idx_(0),
       status_(0)
   {}
   ObLocalIndexLookupOp(const ObNewRowIterator::IterType iter_type)
@@ -270,6 +275,11 @@ public:
       ls_id_(),
       scan_param_(),
       lookup_memctx_(),
+      mrr_store_(),
+      mrr_positions_(),
+      mrr_rows_(),
+      mrr_origin_ranges_(),
+      mrr_output_idx_(0),
       status_(0)
   {}
 
@@ -341,6 +351,15 @@ public:
 private:
   int init_scan_param();
   common::ObITabletScan &get_tsc_service();
+  // multi-range-read lookup: sort the lookup keys of a batch by rowkey,
+  // coalesce consecutive integer keys into ranges and restore the index order
+  // when the data table rows are output.
+  bool can_use_mrr() const;
+  int prepare_mrr_ranges();
+  int fill_mrr_rows(const bool is_vectorized, const int64_t capacity);
+  int fallback_from_mrr();
+  int get_next_row_from_mrr_rows();
+  int get_next_rows_from_mrr_rows(int64_t &count, int64_t capacity);
 protected:
   const ObDASScanCtDef *lookup_ctdef_; //lookup ctdef
   ObDASScanRtDef *lookup_rtdef_; //lookup rtdef
@@ -380,10 +399,23 @@ protected:
   share::ObLSID ls_id_;
   storage::ObTableScanParam scan_param_;
   lib::MemoryContext lookup_memctx_;
+  // rows of the current lookup batch buffered for order restoring,
+  // mrr_positions_[i] is the index order of the i-th sorted lookup key and
+  // mrr_rows_[j] is the stored row of the j-th index row.
+  ObChunkDatumStore mrr_store_;
+  common::ObSEArray<int64_t, 16> mrr_positions_;
+  common::ObSEArray<const ObChunkDatumStore::StoredRow *, 16> mrr_rows_;
+  // lookup keys of the current batch in index order, to lookup again when a key
+  // does not output exactly one row
+  common::ObRangeArray mrr_origin_ranges_;
+  int64_t mrr_output_idx_;
   union {
     uint32_t status_;
     struct {
       uint32_t is_group_scan_     : 1;
+      uint32_t enable_mrr_        : 1; //lookup keys can be sorted and coalesced
+      uint32_t is_mrr_reordered_  : 1; //lookup keys of current batch are reordered
+      uint32_t is_mrr_filled_     : 1; //rows of current batch are buffered in mrr_store_
       //add status here
     };
   };
@@ -53,6 +53,8 @@ int ObSpatialIndexLookupOp::init(const ObDASScanCtDef *lookup_ctdef,
   } else {
     mbr_filters_ = mbr_filters;
     is_inited_ = false;
+    // rowkeys are sorted and deduplicated by sorter_ already
+    enable_mrr_ = false;
   }
   return ret;
 }
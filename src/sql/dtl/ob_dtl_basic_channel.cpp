@@ -998,6 +998,11 @@ int ObDtlBasicChannel::switch_writer(const ObDtlMsg &msg)
         msg_writer_ = &row_msg_writer_;
       } else if (DtlWriterType::CHUNK_DATUM_WRITER == msg_writer_map[px_row.get_data_type()]) {
         msg_writer_ = &datum_msg_writer_;
+        // the receiver of a local channel reads the block in place, skip the unswizzling
+        // unless the buffer may be kept as interm result.
+        datum_msg_writer_.set_unswizzling(!(DtlChannelType::LOCAL_CHANNEL == get_channel_type()
+                                            && !use_interm_result_
+                                            && GCONF._px_enable_local_swizzled_exchange));
       } else {
         ret = OB_ERR_UNEXPECTED;
         LOG_WARN("unkown msg writer", K(msg.get_type()),
@@ -1246,7 +1251,8 @@ int ObDtlRowMsgWriter::serialize()
 //-----------------start ObDtlDatumMsgWrite-------------
 ObDtlDatumMsgWriter::ObDtlDatumMsgWriter() :
   type_(CHUNK_DATUM_WRITER), write_buffer_(nullptr), block_(nullptr),
-  register_block_ptr_(NULL), register_block_buf_ptr_(NULL), write_ret_(OB_SUCCESS)
+  register_block_ptr_(NULL), register_block_buf_ptr_(NULL), write_ret_(OB_SUCCESS),
+  unswizzling_(true)
 {}
 
 ObDtlDatumMsgWriter::~ObDtlDatumMsgWriter()
@@ -1268,6 +1274,7 @@ int ObDtlDatumMsgWriter::init(ObDtlLinkedBuffer *buffer, uint64_t tenant_id)
       LOG_WARN("init shrink buffer failed", K(ret));
     } else {
       write_buffer_ = buffer;
+      write_buffer_->set_swizzled(!unswizzling_);
       if (NULL != register_block_ptr_) {
         *register_block_ptr_ = block_;
       }
@@ -1275,6 +1282,7 @@ int ObDtlDatumMsgWriter::init(ObDtlLinkedBuffer *buffer, uint64_t tenant_id)
         register_block_buf_ptr_->set_block(block_);
         register_block_buf_ptr_->set_data_size(block_->data_size());
         register_block_buf_ptr_->set_capacity(block_->blk_size_);
+        register_block_buf_ptr_->set_unswizzling(unswizzling_);
       }
     }
   }
@@ -99,6 +99,8 @@ static DtlWriterType msg_writer_map[] =
   CONTROL_WRITER, // DH_SECOND_STAGE_REPORTING_WF_WHOLE_MSG,
   CONTROL_WRITER, // DH_OPT_STATS_GATHER_PIECE_MSG,
   CONTROL_WRITER, // DH_OPT_STATS_GATHER_WHOLE_MSG,
+  CONTROL_WRITER, // DH_SKEW_KEY_PIECE_MSG,
+  CONTROL_WRITER, // DH_SKEW_KEY_WHOLE_MSG,
 };
 
 static_assert(ARRAYSIZEOF(msg_writer_map) == ObDtlMsgType::MAX, "invalid ms_writer_map size");
@@ -252,6 +254,10 @@ public:
   {
     register_block_ptr_ = block_ptr;
   }
+  // rows written with absolute pointers can only be handed to a receiver of the same
+  // process, the buffer is marked as swizzled then, see ObDtlLocalChannel.
+  void set_unswizzling(const bool unswizzling) { unswizzling_ = unswizzling; }
+  bool is_unswizzling() const { return unswizzling_; }
   virtual void write_msg_type(ObDtlLinkedBuffer* buffer)
   {
     buffer->msg_type() = ObDtlMsgType::PX_DATUM_ROW;
@@ -263,6 +269,7 @@ private:
   ObChunkDatumStore::Block** register_block_ptr_;
   ObChunkDatumStore::BlockBufferWrap* register_block_buf_ptr_;
   int write_ret_;
+  bool unswizzling_;
 };
 
 OB_INLINE int ObDtlDatumMsgWriter::write(
@@ -272,7 +279,8 @@ OB_INLINE int ObDtlDatumMsgWriter::write(
   const ObPxNewRow &px_row = static_cast<const ObPxNewRow&>(msg);
   const ObIArray<ObExpr *> *row = px_row.get_exprs();
   if (nullptr != row) {
-    if (OB_FAIL(block_->append_row(*row, eval_ctx, block_->get_buffer(), 0, nullptr, true))) {
+    if (OB_FAIL(block_->append_row(*row, eval_ctx, block_->get_buffer(), 0, nullptr,
+                                   unswizzling_))) {
       if (OB_BUF_NOT_ENOUGH != ret) {
         SQL_DTL_LOG(WARN, "failed to add row", K(ret));
       } else {
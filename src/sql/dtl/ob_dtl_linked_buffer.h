@@ -22,6 +22,8 @@ namespace sql {
 namespace dtl {
 
 #define DTL_BROADCAST (1ULL)
+// rows of the datum block keep the absolute pointers, only for the local channel
+#define DTL_SWIZZLED (1ULL << 1)
 
 struct ObDtlMsgHeader;
 class ObDtlChannel;
@@ -260,6 +262,18 @@ public:
     remove_flag(DTL_BROADCAST);
   }
 
+  bool is_swizzled() const {
+    return has_flag(DTL_SWIZZLED);
+  }
+
+  void set_swizzled(const bool swizzled) {
+    if (swizzled) {
+      add_flag(DTL_SWIZZLED);
+    } else {
+      remove_flag(DTL_SWIZZLED);
+    }
+  }
+
   uint64_t enable_channel_sync() const { return enable_channel_sync_; }
   void set_enable_channel_sync(const bool enable_channel_sync) { enable_channel_sync_ = enable_channel_sync; }
 
@@ -16,6 +16,7 @@
 #include "lib/oblog/ob_log_module.h"
 #include "sql/dtl/ob_dtl_flow_control.h"
 #include "sql/engine/basic/ob_chunk_row_store.h"
+#include "sql/engine/basic/ob_chunk_datum_store.h"
 #include "ob_dtl_interm_result_manager.h"
 #include "sql/engine/px/datahub/components/ob_dh_init_channel.h"
 
@@ -66,6 +67,25 @@ int ObDtlLocalChannel::feedup(ObDtlLinkedBuffer *&linked_buffer)
   return attach(linked_buffer);
 }
 
+// 本地channel的datum行保留绝对地址(见ObDtlDatumMsgWriter::set_unswizzling)，
+// receive端直接使用buffer中的行，无需swizzling；buffer被拷贝前需要先转换回偏移
+int ObDtlLocalChannel::unswizzling_buffer(ObDtlLinkedBuffer &buf)
+{
+  int ret = OB_SUCCESS;
+  if (buf.is_swizzled()) {
+    if (PX_DATUM_ROW == buf.msg_type() && buf.pos() > 0) {
+      auto block = reinterpret_cast<ObChunkDatumStore::Block *>(buf.buf());
+      if (block->rows_ > 0 && OB_FAIL(block->unswizzling())) {
+        LOG_WARN("block unswizzling failed", K(ret));
+      }
+    }
+    if (OB_SUCC(ret)) {
+      buf.set_swizzled(false);
+    }
+  }
+  return ret;
+}
+
 // 每一条return路径都必须设置on_finish否则后续会卡死
 int ObDtlLocalChannel::send_shared_message(ObDtlLinkedBuffer *&buf)
 {
@@ -81,7 +101,9 @@ int ObDtlLocalChannel::send_shared_message(ObDtlLinkedBuffer *&buf)
     is_first = buf->is_data_msg() && 1 == buf->seq_no();
     is_eof = buf->is_eof();
     if (buf->is_data_msg() && buf->use_interm_result()) {
-      if (OB_FAIL(ObDTLIntermResultManager::process_interm_result(buf, peer_id_))) {
+      if (OB_FAIL(unswizzling_buffer(*buf))) {
+        LOG_WARN("fail to unswizzling buffer", K(ret));
+      } else if (OB_FAIL(ObDTLIntermResultManager::process_interm_result(buf, peer_id_))) {
         LOG_WARN("fail to process internal result", K(ret));
       }
     } else if (OB_FAIL(DTL.get_channel(peer_id_, chan))) {
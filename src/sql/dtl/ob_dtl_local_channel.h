@@ -50,6 +50,8 @@ public:
   virtual int send_message(ObDtlLinkedBuffer *&buf);
 private:
   int send_shared_message(ObDtlLinkedBuffer *&buf);
+  // convert the swizzled datum block back to offsets before it's copied.
+  static int unswizzling_buffer(ObDtlLinkedBuffer &buf);
 };
 
 }  // dtl
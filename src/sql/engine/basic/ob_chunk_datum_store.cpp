@@ -279,6 +279,9 @@ int ObChunkDatumStore::BlockBufferWrap::append_row(
             K(max_size), K(in_datum));
         }
       } else {
+        if (!unswizzling_ && !datum->null_) {
+          chunk_datum_store::off2pointer(*(const char **)&datum->ptr_, head());
+        }
         LOG_DEBUG("succ to copy_datums", K(sr->cnt_), K(i), K(max_size), K(pos), K(in_datum));
       }
     }
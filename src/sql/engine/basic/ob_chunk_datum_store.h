@@ -583,14 +583,17 @@ public:
 
   class BlockBufferWrap : public BlockBuffer {
   public:
-    BlockBufferWrap() : BlockBuffer(), rows_(0) {}
+    BlockBufferWrap() : BlockBuffer(), rows_(0), unswizzling_(true) {}
 
     int append_row(const common::ObIArray<ObExpr*> &exprs,
                    ObEvalCtx *ctx, int64_t row_extend_size);
     void reset() { rows_ = 0; BlockBuffer::reset(); }
+    void set_unswizzling(const bool unswizzling) { unswizzling_ = unswizzling; }
 
   public:
     uint32_t rows_;
+    // false to keep the absolute pointers, the block is then only valid in this process.
+    bool unswizzling_;
   };
 
   class ChunkIterator;
@@ -19,6 +19,7 @@
 #include "storage/blocksstable/encoding/ob_encoding_query_util.h"
 #include "storage/blocksstable/ob_datum_row.h"
 #include "sql/engine/expr/ob_expr_lob_utils.h"
+#include "sql/engine/expr/ob_expr_join_filter.h"
 
 namespace oceanbase
 {
@@ -139,6 +140,10 @@ int ObPushdownWhiteFilterNode::set_op_type(const ObItemType &type)
     case T_FUN_SYS_ISNULL:
       op_type_ = WHITE_OP_NU;
       break;
+    case T_OP_JOIN_BLOOM_FILTER:
+      // runtime filter, reset to between or in once the join filter is ready.
+      op_type_ = WHITE_OP_BT;
+      break;
     default:
       ret = OB_ERR_UNEXPECTED;
       break;
@@ -197,6 +202,52 @@ int ObPushdownFilterConstructor::is_white_mode(const ObRawExpr* raw_expr, bool &
   return ret;
 }
 
+int ObPushdownFilterConstructor::is_runtime_white_mode(const ObRawExpr *raw_expr, bool &is_white)
+{
+  int ret = OB_SUCCESS;
+  const ObRawExpr *child = nullptr;
+  is_white = false;
+  if (OB_ISNULL(raw_expr)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("Invalid null argument", K(ret));
+  } else if (T_OP_JOIN_BLOOM_FILTER != raw_expr->get_expr_type() || 1 != raw_expr->get_param_count()) {
+  } else if (OB_ISNULL(child = raw_expr->get_param_expr(0))) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("Unexpected null child expr", K(ret));
+  } else if (ObRawExpr::EXPR_COLUMN_REF == child->get_expr_class()) {
+    const ObObjTypeClass tc = child->get_result_meta().get_type_class();
+    is_white = (ObIntTC == tc || ObUIntTC == tc);
+  }
+  return ret;
+}
+
+// The range and in-list of the join filter go first as a runtime white filter,
+// micro blocks rejected by them on the encoded column skip the bloom filter.
+int ObPushdownFilterConstructor::create_runtime_filter_node(
+    ObRawExpr *raw_expr,
+    ObPushdownFilterNode *&filter_node)
+{
+  int ret = OB_SUCCESS;
+  ObPushdownFilterNode *white_node = nullptr;
+  ObPushdownFilterNode *black_node = nullptr;
+  if (OB_FAIL(create_white_filter_node(raw_expr, white_node))) {
+    LOG_WARN("Failed to create runtime white filter node", K(ret));
+  } else if (OB_FAIL(create_black_filter_node(raw_expr, black_node))) {
+    LOG_WARN("Failed to create black filter node", K(ret));
+  } else if (OB_FAIL(black_node->postprocess())) {
+    LOG_WARN("Failed to postprocess black filter node", K(ret));
+  } else if (OB_FAIL(factory_.alloc(PushdownFilterType::AND_FILTER, 2, filter_node))) {
+    LOG_WARN("Failed to alloc and pushdown filter node", K(ret));
+  } else if (OB_ISNULL(filter_node)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("And filter node is null", K(ret));
+  } else {
+    filter_node->childs_[0] = white_node;
+    filter_node->childs_[1] = black_node;
+  }
+  return ret;
+}
+
 int ObPushdownFilterConstructor::create_black_filter_node(
     ObRawExpr *raw_expr,
     ObPushdownFilterNode *&filter_node)
@@ -378,6 +429,12 @@ int ObPushdownFilterConstructor::generate(ObRawExpr *raw_expr, ObPushdownFilterN
   if (OB_ISNULL(raw_expr) || OB_ISNULL(alloc_)) {
     ret = OB_INVALID_ARGUMENT;
     LOG_WARN("Invalid null parameter", K(ret), KP(raw_expr), KP(alloc_));
+  } else if (OB_FAIL(is_runtime_white_mode(raw_expr, is_white))) {
+    LOG_WARN("Failed to check runtime filter type", K(ret));
+  } else if (is_white) {
+    if (OB_FAIL(create_runtime_filter_node(raw_expr, filter_node))) {
+      LOG_WARN("Failed to create runtime pushdown filter node", K(ret));
+    }
   } else if (OB_FAIL(is_white_mode(raw_expr, is_white))) {
     LOG_WARN("Failed to get filter type", K(ret));
   } else if (is_white) {
@@ -955,6 +1012,11 @@ int ObWhiteFilterExecutor::init_evaluated_datums()
   if (OB_ISNULL(filter_.expr_)) {
     ret = OB_ERR_UNEXPECTED;
     LOG_WARN("Unexpected null expr", K(ret));
+  } else if (filter_.is_runtime_filter()) {
+    // params are set by prepare_runtime_filter() once the join filter is ready.
+    params_.clear();
+    op_type_ = filter_.get_op_type();
+    runtime_filter_state_ = RUNTIME_FILTER_WAITING;
   } else if (OB_FAIL(init_array_param(params_, filter_.expr_->arg_cnt_))) {
     LOG_WARN("Failed to alloc params", K(ret));
   } else {
@@ -980,7 +1042,7 @@ int ObWhiteFilterExecutor::init_evaluated_datums()
     LOG_DEBUG("[PUSHDOWN], white pushdown filter inited params", K(params_));
   }
 
-  if (OB_SUCC(ret)) {
+  if (OB_SUCC(ret) && !filter_.is_runtime_filter()) {
     check_null_params();
     if (WHITE_OP_IN == filter_.get_op_type() && OB_FAIL(init_obj_set())) {
       LOG_WARN("Failed to init Object hash set in filter node", K(ret));
@@ -989,6 +1051,69 @@ int ObWhiteFilterExecutor::init_evaluated_datums()
   return ret;
 }
 
+int ObWhiteFilterExecutor::prepare_runtime_filter(bool &filter_all_pass)
+{
+  int ret = OB_SUCCESS;
+  filter_all_pass = false;
+  if (!filter_.is_runtime_filter() || RUNTIME_FILTER_APPLIED == runtime_filter_state_) {
+  } else if (RUNTIME_FILTER_ALL_PASS == runtime_filter_state_) {
+    filter_all_pass = true;
+  } else {
+    const ObPxRangeInFilter *range_filter = nullptr;
+    bool is_ready = false;
+    if (OB_FAIL(ObExprJoinFilter::get_ready_range_filter(
+                *filter_.expr_, op_.get_eval_ctx(), range_filter, is_ready))) {
+      LOG_WARN("Failed to get range filter of join filter", K(ret));
+    } else if (nullptr == range_filter) {
+      filter_all_pass = true;
+      if (is_ready) {
+        // the join filter has no range to apply, e.g. NULL or mixed type keys
+        // on the build side, no need to check it again for the next blocks.
+        runtime_filter_state_ = RUNTIME_FILTER_ALL_PASS;
+        LOG_DEBUG("[PUSHDOWN] runtime white filter passes all", K_(filter));
+      }
+    } else if (OB_FAIL(init_runtime_params(*range_filter))) {
+      LOG_WARN("Failed to init runtime filter params", K(ret), KPC(range_filter));
+    } else {
+      runtime_filter_state_ = RUNTIME_FILTER_APPLIED;
+      LOG_DEBUG("[PUSHDOWN] runtime white filter applied", KPC(range_filter), K_(op_type), K_(params));
+    }
+  }
+  return ret;
+}
+
+int ObWhiteFilterExecutor::init_runtime_params(const ObPxRangeInFilter &range_filter)
+{
+  int ret = OB_SUCCESS;
+  const ObObjType col_type = filter_.expr_->args_[0]->datum_meta_.type_;
+  const bool use_in = range_filter.has_in_list();
+  const int64_t param_cnt = use_in ? range_filter.get_in_cnt() : 2;
+  ObObj param;
+  if (OB_FAIL(init_array_param(params_, param_cnt))) {
+    LOG_WARN("Failed to alloc params", K(ret), K(param_cnt));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < param_cnt; ++i) {
+    const int64_t v = use_in ? range_filter.get_in_value(i)
+        : (0 == i ? range_filter.get_min() : range_filter.get_max());
+    if (range_filter.is_unsigned()) {
+      param.set_uint(col_type, static_cast<uint64_t>(v));
+    } else {
+      param.set_int(col_type, v);
+    }
+    if (OB_FAIL(params_.push_back(param))) {
+      LOG_WARN("Failed to push back param", K(ret));
+    }
+  }
+  if (OB_SUCC(ret)) {
+    op_type_ = use_in ? WHITE_OP_IN : WHITE_OP_BT;
+    null_param_contained_ = false;
+    if (use_in && OB_FAIL(init_obj_set())) {
+      LOG_WARN("Failed to init Object hash set in filter node", K(ret));
+    }
+  }
+  return ret;
+}
+
 void ObWhiteFilterExecutor::check_null_params()
 {
   null_param_contained_ = false;
@@ -45,6 +45,7 @@ namespace sql
 {
 class ObRawExpr;
 class ObStaticEngineCG;
+class ObPxRangeInFilter;
 class ObPushdownOperator;
 struct ObExprFrameInfo;
 typedef common::ObFixedArray<const share::schema::ObColumnParam*, common::ObIAllocator> ColumnParamFixedArray;
@@ -187,6 +188,9 @@ public:
   ~ObPushdownWhiteFilterNode() {}
   OB_INLINE int set_op_type(const ObItemType &type);
   OB_INLINE ObWhiteFilterOperatorType get_op_type() const { return op_type_; }
+  // range and in-list of a join filter, the params are known at runtime.
+  OB_INLINE bool is_runtime_filter() const
+  { return nullptr != expr_ && T_OP_JOIN_BLOOM_FILTER == expr_->type_; }
 
   // mapping array from white filter's operation type to common::ObCmpOp
   static const common::ObCmpOp WHITE_OP_TO_CMP_OP[WHITE_OP_MAX];
@@ -246,8 +250,10 @@ public:
 
 private:
   int is_white_mode(const ObRawExpr* raw_expr, bool &is_white);
+  int is_runtime_white_mode(const ObRawExpr *raw_expr, bool &is_white);
   int create_black_filter_node(ObRawExpr *raw_expr, ObPushdownFilterNode *&filter_tree);
   int create_white_filter_node(ObRawExpr *raw_expr, ObPushdownFilterNode *&filter_tree);
+  int create_runtime_filter_node(ObRawExpr *raw_expr, ObPushdownFilterNode *&filter_tree);
   int merge_filter_node(
       ObPushdownFilterNode *dst,
       ObPushdownFilterNode *other,
@@ -435,7 +441,8 @@ public:
                         ObPushdownWhiteFilterNode &filter,
                         ObPushdownOperator &op)
       : ObPushdownFilterExecutor(alloc, op, PushdownExecutorType::WHITE_FILTER_EXECUTOR),
-      null_param_contained_(false), params_(alloc), filter_(filter) {}
+      null_param_contained_(false), params_(alloc), filter_(filter),
+      op_type_(filter.get_op_type()), runtime_filter_state_(RUNTIME_FILTER_WAITING) {}
   ~ObWhiteFilterExecutor()
   {
     params_.reset();
@@ -454,18 +461,33 @@ public:
   int exist_in_obj_set(const common::ObObj &obj, bool &is_exist) const;
   bool is_obj_set_created() const { return param_set_.created(); };
   OB_INLINE ObWhiteFilterOperatorType get_op_type() const
-  { return filter_.get_op_type(); }
+  { return op_type_; }
+  OB_INLINE bool is_runtime_filter() const { return filter_.is_runtime_filter(); }
+  // Called before filtering each micro block. Params of the runtime filter are
+  // set once the join filter is ready, %filter_all_pass is true before that or
+  // if the join filter has no range to apply.
+  int prepare_runtime_filter(bool &filter_all_pass);
   INHERIT_TO_STRING_KV("ObPushdownWhiteFilterExecutor", ObPushdownFilterExecutor,
                        K_(null_param_contained), K_(params), K(param_set_.created()),
-                       K_(filter));
+                       K_(filter), K_(op_type), K_(runtime_filter_state));
 private:
+  enum RuntimeFilterState
+  {
+    RUNTIME_FILTER_WAITING = 0,
+    RUNTIME_FILTER_APPLIED,
+    RUNTIME_FILTER_ALL_PASS,
+  };
   void check_null_params();
   int init_obj_set();
+  int init_runtime_params(const ObPxRangeInFilter &range_filter);
 private:
   bool null_param_contained_;
   common::ObFixedArray<common::ObObj, common::ObIAllocator> params_;
   common::hash::ObHashSet<common::ObObj> param_set_;
   ObPushdownWhiteFilterNode &filter_;
+  // same as the filter node except for the runtime filter.
+  ObWhiteFilterOperatorType op_type_;
+  RuntimeFilterState runtime_filter_state_;
 };
 
 class ObAndFilterExecutor : public ObPushdownFilterExecutor
@@ -6,6 +6,7 @@
 
 #include "sql/engine/cmd/ob_load_data_direct_impl.h"
 #include "observer/omt/ob_tenant.h"
+#include "observer/omt/ob_tenant_config_mgr.h"
 #include "observer/table_load/ob_table_load_coordinator.h"
 #include "observer/table_load/ob_table_load_coordinator_ctx.h"
 #include "observer/table_load/ob_table_load_service.h"
@@ -595,12 +596,292 @@ void ObLoadDataDirectImpl::DataBuffer::swap(DataBuffer &other)
   std::swap(pos_, other.pos_);
 }
 
+/**
+ * DataPrefetcher
+ */
+
+class ObLoadDataDirectImpl::DataPrefetcher::PrefetchTaskProcessor
+  : public ObITableLoadTaskProcessor
+{
+public:
+  PrefetchTaskProcessor(ObTableLoadTask &task, DataPrefetcher *prefetcher)
+    : ObITableLoadTaskProcessor(task), prefetcher_(prefetcher)
+  {
+  }
+  virtual ~PrefetchTaskProcessor() = default;
+  int process() override { return prefetcher_->prefetch(); }
+private:
+  DataPrefetcher *prefetcher_;
+};
+
+class ObLoadDataDirectImpl::DataPrefetcher::PrefetchTaskCallback
+  : public ObITableLoadTaskCallback
+{
+public:
+  PrefetchTaskCallback(DataPrefetcher *prefetcher) : prefetcher_(prefetcher) {}
+  virtual ~PrefetchTaskCallback() = default;
+  void callback(int ret_code, ObTableLoadTask *task) override
+  {
+    UNUSED(task);
+    prefetcher_->on_prefetch_finished(ret_code);
+  }
+private:
+  DataPrefetcher *prefetcher_;
+};
+
+ObLoadDataDirectImpl::DataPrefetcher::DataPrefetcher()
+  : execute_ctx_(nullptr),
+    io_accessor_(nullptr),
+    end_offset_(0),
+    buffers_(nullptr),
+    buffer_count_(0),
+    cur_buffer_(nullptr),
+    task_scheduler_(nullptr),
+    task_(nullptr),
+    prefetch_ret_(OB_SUCCESS),
+    is_finished_(false),
+    is_stop_(false),
+    is_inited_(false)
+{
+}
+
+ObLoadDataDirectImpl::DataPrefetcher::~DataPrefetcher()
+{
+  stop();
+  if (nullptr != task_scheduler_) {
+    task_scheduler_->stop();
+    task_scheduler_->wait();
+    task_scheduler_->~ObITableLoadTaskScheduler();
+    execute_ctx_->allocator_->free(task_scheduler_);
+    task_scheduler_ = nullptr;
+  }
+  if (nullptr != task_) {
+    task_->~ObTableLoadTask();
+    execute_ctx_->allocator_->free(task_);
+    task_ = nullptr;
+  }
+  if (nullptr != buffers_) {
+    for (int64_t i = 0; i < buffer_count_; ++i) {
+      buffers_[i].~DataBuffer();
+    }
+    execute_ctx_->allocator_->free(buffers_);
+    buffers_ = nullptr;
+  }
+}
+
+int ObLoadDataDirectImpl::DataPrefetcher::init(LoadExecuteContext &execute_ctx,
+                                               SequentialDataAccessor &io_accessor,
+                                               int64_t end_offset, int64_t buffer_count)
+{
+  int ret = OB_SUCCESS;
+  if (IS_INIT) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("ObLoadDataDirectImpl::DataPrefetcher init twice", KR(ret), KP(this));
+  } else if (OB_UNLIKELY(!execute_ctx.is_valid() || end_offset < 0 || buffer_count <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid args", KR(ret), K(execute_ctx), K(end_offset), K(buffer_count));
+  } else {
+    execute_ctx_ = &execute_ctx;
+    io_accessor_ = &io_accessor;
+    end_offset_ = end_offset;
+    if (OB_FAIL(init_buffers(buffer_count))) {
+      LOG_WARN("fail to init buffers", KR(ret), K(buffer_count));
+    } else if (OB_FAIL(ready_queue_.init(buffer_count, "TLD_ReadQueue", MTL_ID()))) {
+      LOG_WARN("fail to init ready queue", KR(ret), K(buffer_count));
+    } else if (OB_ISNULL(task_scheduler_ =
+                           OB_NEWx(ObTableLoadTaskThreadPoolScheduler, (execute_ctx_->allocator_),
+                                   1 /*thread_count*/, *execute_ctx_->allocator_))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("fail to new ObTableLoadTaskThreadPoolScheduler", KR(ret));
+    } else if (OB_FAIL(task_scheduler_->init())) {
+      LOG_WARN("fail to init task scheduler", KR(ret));
+    } else if (OB_ISNULL(task_ = OB_NEWx(ObTableLoadTask, (execute_ctx_->allocator_), MTL_ID()))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("fail to new ObTableLoadTask", KR(ret));
+    } else if (OB_FAIL(task_->set_processor<PrefetchTaskProcessor>(this))) {
+      LOG_WARN("fail to set prefetch task processor", KR(ret));
+    } else if (OB_FAIL(task_->set_callback<PrefetchTaskCallback>(this))) {
+      LOG_WARN("fail to set prefetch task callback", KR(ret));
+    } else {
+      execute_ctx_->job_stat_->read_stage_.threads_ = 1;
+      is_inited_ = true;
+    }
+  }
+  return ret;
+}
+
+int ObLoadDataDirectImpl::DataPrefetcher::init_buffers(int64_t buffer_count)
+{
+  int ret = OB_SUCCESS;
+  void *buf = nullptr;
+  if (OB_FAIL(free_queue_.init(buffer_count, "TLD_ReadQueue", MTL_ID()))) {
+    LOG_WARN("fail to init free queue", KR(ret), K(buffer_count));
+  } else if (OB_ISNULL(buf = execute_ctx_->allocator_->alloc(sizeof(DataBuffer) * buffer_count))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to allocate memory", KR(ret), K(buffer_count));
+  } else {
+    buffers_ = new (buf) DataBuffer[buffer_count];
+    buffer_count_ = buffer_count;
+    for (int64_t i = 0; OB_SUCC(ret) && i < buffer_count_; ++i) {
+      if (OB_FAIL(buffers_[i].init())) {
+        LOG_WARN("fail to init data buffer", KR(ret));
+      } else if (OB_FAIL(free_queue_.push(buffers_ + i))) {
+        LOG_WARN("fail to push free buffer", KR(ret));
+      }
+    }
+  }
+  return ret;
+}
+
+int ObLoadDataDirectImpl::DataPrefetcher::start()
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("ObLoadDataDirectImpl::DataPrefetcher not init", KR(ret), KP(this));
+  } else if (OB_FAIL(task_scheduler_->start())) {
+    LOG_WARN("fail to start task scheduler", KR(ret));
+  } else if (OB_FAIL(task_scheduler_->add_task(0, task_))) {
+    LOG_WARN("fail to add prefetch task", KR(ret));
+  }
+  return ret;
+}
+
+void ObLoadDataDirectImpl::DataPrefetcher::stop()
+{
+  ATOMIC_STORE(&is_stop_, true);
+}
+
+int ObLoadDataDirectImpl::DataPrefetcher::prefetch()
+{
+  int ret = OB_SUCCESS;
+  ObLoadDataStat *job_stat = execute_ctx_->job_stat_;
+  while (OB_SUCC(ret) && io_accessor_->get_offset() < end_offset_) {
+    void *ptr = nullptr;
+    int64_t start_ts = ObTimeUtil::current_time();
+    if (OB_UNLIKELY(ATOMIC_LOAD(&is_stop_))) {
+      ret = OB_CANCELED;
+      LOG_WARN("prefetch is stopped", KR(ret));
+    } else if (OB_FAIL(free_queue_.pop(ptr, WAIT_INTERVAL_US))) {
+      if (OB_UNLIKELY(OB_ENTRY_NOT_EXIST != ret)) {
+        LOG_WARN("fail to pop free buffer", KR(ret));
+      } else {
+        ret = OB_SUCCESS;
+      }
+    } else {
+      DataBuffer *buffer = static_cast<DataBuffer *>(ptr);
+      const int64_t read_start_ts = ObTimeUtil::current_time();
+      int64_t read_count = 0;
+      int64_t read_size = 0;
+      ATOMIC_AAF(&job_stat->read_stage_.wait_time_, read_start_ts - start_ts);
+      buffer->reuse();
+      read_count = MIN(buffer->get_remain_length(), end_offset_ - io_accessor_->get_offset());
+      if (OB_FAIL(io_accessor_->read(buffer->data(), read_count, read_size))) {
+        LOG_WARN("fail to read file", KR(ret));
+      } else if (OB_UNLIKELY(read_count != read_size)) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("unexpected read size", KR(ret), K(read_count), K(read_size), K(end_offset_));
+      } else {
+        buffer->update_data_length(read_size);
+        ATOMIC_AAF(&job_stat->read_stage_.busy_time_, ObTimeUtil::current_time() - read_start_ts);
+        if (OB_FAIL(ready_queue_.push(buffer))) {
+          LOG_WARN("fail to push ready buffer", KR(ret));
+        }
+      }
+      if (OB_FAIL(ret)) {
+        free_queue_.push(buffer);
+      }
+    }
+    job_stat->read_stage_.queue_size_ = free_queue_.size();
+    job_stat->split_stage_.queue_size_ = ready_queue_.size();
+  }
+  return ret;
+}
+
+void ObLoadDataDirectImpl::DataPrefetcher::on_prefetch_finished(int ret_code)
+{
+  ATOMIC_STORE(&prefetch_ret_, ret_code);
+  MEM_BARRIER();
+  ATOMIC_STORE(&is_finished_, true);
+}
+
+int ObLoadDataDirectImpl::DataPrefetcher::pop_ready_buffer(DataBuffer *&buffer)
+{
+  int ret = OB_SUCCESS;
+  const int64_t start_ts = ObTimeUtil::current_time();
+  buffer = nullptr;
+  while (OB_SUCC(ret) && nullptr == buffer) {
+    void *ptr = nullptr;
+    if (OB_SUCC(ready_queue_.pop(ptr, WAIT_INTERVAL_US))) {
+      buffer = static_cast<DataBuffer *>(ptr);
+    } else if (OB_UNLIKELY(OB_ENTRY_NOT_EXIST != ret)) {
+      LOG_WARN("fail to pop ready buffer", KR(ret));
+    } else {
+      ret = OB_SUCCESS;
+      if (ATOMIC_LOAD(&is_finished_) && 0 == ready_queue_.size()) {
+        if (OB_FAIL(ATOMIC_LOAD(&prefetch_ret_))) {
+          LOG_WARN("prefetch failed", KR(ret));
+        } else {
+          ret = OB_ITER_END;
+        }
+      } else if (OB_FAIL(execute_ctx_->check_status())) {
+        LOG_WARN("fail to check status", KR(ret));
+      }
+    }
+  }
+  ATOMIC_AAF(&execute_ctx_->job_stat_->split_stage_.wait_time_,
+             ObTimeUtil::current_time() - start_ts);
+  return ret;
+}
+
+int ObLoadDataDirectImpl::DataPrefetcher::read(char *buf, int64_t count, int64_t &read_size)
+{
+  int ret = OB_SUCCESS;
+  read_size = 0;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("ObLoadDataDirectImpl::DataPrefetcher not init", KR(ret), KP(this));
+  } else if (OB_UNLIKELY(nullptr == buf || count <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid args", KR(ret), KP(buf), K(count));
+  }
+  while (OB_SUCC(ret) && read_size < count) {
+    if (nullptr == cur_buffer_ && OB_FAIL(pop_ready_buffer(cur_buffer_))) {
+      if (OB_UNLIKELY(OB_ITER_END != ret)) {
+        LOG_WARN("fail to pop ready buffer", KR(ret));
+      } else {
+        ret = OB_SUCCESS;
+        break;
+      }
+    } else {
+      const int64_t copy_size = MIN(count - read_size, cur_buffer_->get_data_length());
+      MEMCPY(buf + read_size, cur_buffer_->data(), copy_size);
+      cur_buffer_->advance(copy_size);
+      read_size += copy_size;
+      if (cur_buffer_->empty()) {
+        if (OB_FAIL(free_queue_.push(cur_buffer_))) {
+          LOG_WARN("fail to push free buffer", KR(ret));
+        } else {
+          cur_buffer_ = nullptr;
+        }
+      }
+    }
+  }
+  return ret;
+}
+
 /**
  * DataReader
  */
 
 ObLoadDataDirectImpl::DataReader::DataReader()
-  : execute_ctx_(nullptr), end_offset_(0), read_raw_(false), is_iter_end_(false), is_inited_(false)
+  : execute_ctx_(nullptr),
+    prefetcher_(nullptr),
+    offset_(0),
+    end_offset_(0),
+    read_raw_(false),
+    is_iter_end_(false),
+    is_inited_(false)
 {
 }
 
@@ -634,6 +915,7 @@ int ObLoadDataDirectImpl::DataReader::init(const DataAccessParam &data_access_pa
         LOG_WARN("fail to get file size", KR(ret), K(data_desc));
       } else {
         io_accessor_.seek(data_desc.start_);
+        offset_ = data_desc.start_;
         ATOMIC_AAF(&execute_ctx_->job_stat_->total_bytes_, (end_offset_ - data_desc.start_));
       }
     }
@@ -672,8 +954,8 @@ int ObLoadDataDirectImpl::DataReader::get_next_buffer(ObLoadFileBuffer &file_buf
       int64_t read_count = 0;
       int64_t read_size = 0;
       if (FALSE_IT(read_count =
-                     MIN(file_buffer.get_remain_len(), end_offset_ - io_accessor_.get_offset()))) {
-      } else if (OB_FAIL(io_accessor_.read(file_buffer.current_ptr(), read_count, read_size))) {
+                     MIN(file_buffer.get_remain_len(), end_offset_ - offset_))) {
+      } else if (OB_FAIL(read_data(file_buffer.current_ptr(), read_count, read_size))) {
         LOG_WARN("fail to read file", KR(ret));
       } else if (OB_UNLIKELY(read_count != read_size)) {
         ret = OB_ERR_UNEXPECTED;
@@ -723,10 +1005,10 @@ int ObLoadDataDirectImpl::DataReader::get_next_raw_buffer(DataBuffer &data_buffe
     ret = OB_ITER_END;
   } else if (data_buffer.get_remain_length() > 0) {
     const int64_t read_count =
-      MIN(data_buffer.get_remain_length(), end_offset_ - io_accessor_.get_offset());
+      MIN(data_buffer.get_remain_length(), end_offset_ - offset_);
     int64_t read_size = 0;
-    if (OB_FAIL(io_accessor_.read(data_buffer.data() + data_buffer.get_data_length(), read_count,
-                                  read_size))) {
+    if (OB_FAIL(read_data(data_buffer.data() + data_buffer.get_data_length(), read_count,
+                          read_size))) {
       LOG_WARN("fail to read file", KR(ret));
     } else if (OB_UNLIKELY(read_count != read_size)) {
       ret = OB_ERR_UNEXPECTED;
@@ -739,6 +1021,28 @@ int ObLoadDataDirectImpl::DataReader::get_next_raw_buffer(DataBuffer &data_buffe
   return ret;
 }
 
+int ObLoadDataDirectImpl::DataReader::read_data(char *buf, int64_t count, int64_t &read_size)
+{
+  int ret = OB_SUCCESS;
+  if (nullptr != prefetcher_) {
+    if (OB_FAIL(prefetcher_->read(buf, count, read_size))) {
+      LOG_WARN("fail to read from prefetcher", KR(ret));
+    } else {
+      offset_ += read_size;
+    }
+  } else {
+    const int64_t start_ts = ObTimeUtil::current_time();
+    if (OB_FAIL(io_accessor_.read(buf, count, read_size))) {
+      LOG_WARN("fail to read file", KR(ret));
+    } else {
+      offset_ += read_size;
+      ATOMIC_AAF(&execute_ctx_->job_stat_->read_stage_.busy_time_,
+                 ObTimeUtil::current_time() - start_ts);
+    }
+  }
+  return ret;
+}
+
 /**
  * DataParser
  */
@@ -1111,6 +1415,8 @@ int ObLoadDataDirectImpl::FileLoadExecutor::execute()
           LOG_WARN("fail to fill task", KR(ret));
         } else if (OB_FAIL(task_scheduler_->add_task(handle->session_id_ - 1, task))) {
           LOG_WARN("fail to add task", KR(ret), K(handle->session_id_), KPC(task));
+        } else {
+          ATOMIC_AAF(&execute_ctx_->job_stat_->parse_stage_.queue_size_, 1);
         }
         if (OB_FAIL(ret)) {
           if (nullptr != task) {
@@ -1189,6 +1495,11 @@ int ObLoadDataDirectImpl::FileLoadExecutor::fetch_task_handle(TaskHandle *&handl
   return ret;
 }
 
+void ObLoadDataDirectImpl::FileLoadExecutor::on_task_done()
+{
+  ATOMIC_AAF(&execute_ctx_->job_stat_->parse_stage_.queue_size_, -1);
+}
+
 void ObLoadDataDirectImpl::FileLoadExecutor::task_finished(TaskHandle *handle)
 {
   int ret = OB_SUCCESS;
@@ -1268,6 +1579,8 @@ int ObLoadDataDirectImpl::FileLoadExecutor::process_task_handle(int64_t worker_i
     WorkerContext &worker_ctx = worker_ctx_array_[worker_idx];
     const int64_t column_count = execute_param_->data_access_param_.file_column_num_;
     const int64_t data_buffer_length = handle->data_buffer_.get_data_length();
+    const int64_t start_ts = ObTimeUtil::current_time();
+    int64_t route_time = 0;
     int64_t parsed_bytes = 0;
     int64_t processed_line_count = 0;
     total_processed_line_count = 0;
@@ -1316,7 +1629,11 @@ int ObLoadDataDirectImpl::FileLoadExecutor::process_task_handle(int64_t worker_i
       } // end while()
 
       if (OB_SUCC(ret) && (processed_line_count > 0)) {
-        if (OB_FAIL(execute_ctx_->direct_loader_->write(handle->session_id_, obj_rows))) {
+        // route stage: cast and partition calc are done by the direct loader
+        const int64_t route_start_ts = ObTimeUtil::current_time();
+        ret = execute_ctx_->direct_loader_->write(handle->session_id_, obj_rows);
+        route_time += ObTimeUtil::current_time() - route_start_ts;
+        if (OB_FAIL(ret)) {
           LOG_WARN("fail to write objs", KR(ret));
         } else {
           total_processed_line_count += processed_line_count;
@@ -1330,6 +1647,9 @@ int ObLoadDataDirectImpl::FileLoadExecutor::process_task_handle(int64_t worker_i
     handle->result_.parsed_bytes_ += parsed_bytes;
     ATOMIC_AAF(&execute_ctx_->job_stat_->parsed_rows_, total_processed_line_count);
     ATOMIC_AAF(&execute_ctx_->job_stat_->parsed_bytes_, parsed_bytes);
+    ATOMIC_AAF(&execute_ctx_->job_stat_->parse_stage_.busy_time_,
+               ObTimeUtil::current_time() - start_ts - route_time);
+    ATOMIC_AAF(&execute_ctx_->job_stat_->route_stage_.busy_time_, route_time);
   }
   return ret;
 }
@@ -1348,6 +1668,7 @@ public:
   virtual ~FileLoadTaskCallback() = default;
   void callback(int ret_code, ObTableLoadTask *task) override
   {
+    load_executor_->on_task_done();
     handle_->result_.ret_ = ret_code;
     load_executor_->task_finished(handle_);
     load_executor_->free_task(task);
@@ -1385,6 +1706,8 @@ int ObLoadDataDirectImpl::LargeFileLoadTaskProcessor::process()
 {
   int ret = OB_SUCCESS;
   handle_->result_.start_process_ts_ = ObTimeUtil::current_time();
+  ATOMIC_AAF(&file_load_executor_->get_job_stat()->parse_stage_.wait_time_,
+             handle_->result_.start_process_ts_ - handle_->result_.created_ts_);
   int64_t line_count = 0;
   if (OB_FAIL(file_load_executor_->process_task_handle(worker_idx_, handle_, line_count))) {
     LOG_WARN("fail to process task handle", KR(ret));
@@ -1437,8 +1760,18 @@ int ObLoadDataDirectImpl::LargeFileLoadExecutor::init(const LoadExecuteParam &ex
     else if (OB_FAIL(
                data_reader_.init(execute_param_->data_access_param_, *execute_ctx_, data_desc))) {
       LOG_WARN("fail to init data reader", KR(ret));
+    }
+    // data_prefetcher_, reads ahead through the accessor of data_reader_
+    else if (OB_FAIL(data_prefetcher_.init(*execute_ctx_, data_reader_.get_io_accessor(),
+                                           data_reader_.get_end_offset()))) {
+      LOG_WARN("fail to init data prefetcher", KR(ret));
     } else {
+      ObLoadDataStat *job_stat = execute_ctx_->job_stat_;
+      data_reader_.set_prefetcher(&data_prefetcher_);
       data_desc_ = data_desc;
+      job_stat->split_stage_.threads_ = 1;
+      job_stat->parse_stage_.threads_ = execute_param_->parallel_;
+      job_stat->route_stage_.threads_ = execute_param_->parallel_;
       is_inited_ = true;
     }
   }
@@ -1448,7 +1781,9 @@ int ObLoadDataDirectImpl::LargeFileLoadExecutor::init(const LoadExecuteParam &ex
 int ObLoadDataDirectImpl::LargeFileLoadExecutor::prepare_execute()
 {
   int ret = OB_SUCCESS;
-  if (OB_FAIL(skip_ignore_rows())) {
+  if (OB_FAIL(data_prefetcher_.start())) {
+    LOG_WARN("fail to start data prefetcher", KR(ret));
+  } else if (OB_FAIL(skip_ignore_rows())) {
     LOG_WARN("fail to skip ignore rows", KR(ret));
   }
   return ret;
@@ -1457,23 +1792,34 @@ int ObLoadDataDirectImpl::LargeFileLoadExecutor::prepare_execute()
 int ObLoadDataDirectImpl::LargeFileLoadExecutor::get_next_task_handle(TaskHandle *&handle)
 {
   int ret = OB_SUCCESS;
+  ObLoadDataStat *job_stat = execute_ctx_->job_stat_;
   int64_t current_line_count = 0;
+  const int64_t start_ts = ObTimeUtil::current_time();
+  const int64_t start_wait_time = ATOMIC_LOAD(&job_stat->split_stage_.wait_time_);
   expr_buffer_.reuse();
   if (OB_FAIL(data_reader_.get_next_buffer(*expr_buffer_.file_buffer_, current_line_count))) {
     if (OB_UNLIKELY(OB_ITER_END != ret)) {
       LOG_WARN("fail to get next buffer", KR(ret));
     }
-  } else if (OB_FAIL(fetch_task_handle(handle))) {
-    LOG_WARN("fail to fetch task handle", KR(ret));
   } else {
-    handle->task_id_ = task_controller_.get_next_task_id();
-    handle->session_id_ = get_session_id();
-    handle->data_desc_ = data_desc_;
-    handle->start_line_no_ = total_line_count_ + 1;
-    handle->result_.created_ts_ = ObTimeUtil::current_time();
-    handle->data_buffer_.swap(expr_buffer_);
-    handle->data_buffer_.is_end_file_ = data_reader_.is_end_file();
-    total_line_count_ += current_line_count;
+    // time waiting for the read stage is already counted by the prefetcher
+    const int64_t split_end_ts = ObTimeUtil::current_time();
+    const int64_t read_wait_time = ATOMIC_LOAD(&job_stat->split_stage_.wait_time_) - start_wait_time;
+    ATOMIC_AAF(&job_stat->split_stage_.busy_time_, split_end_ts - start_ts - read_wait_time);
+    if (OB_FAIL(fetch_task_handle(handle))) {
+      LOG_WARN("fail to fetch task handle", KR(ret));
+    } else {
+      // blocked by the parse stage when all handles are in use
+      ATOMIC_AAF(&job_stat->split_stage_.wait_time_, ObTimeUtil::current_time() - split_end_ts);
+      handle->task_id_ = task_controller_.get_next_task_id();
+      handle->session_id_ = get_session_id();
+      handle->data_desc_ = data_desc_;
+      handle->start_line_no_ = total_line_count_ + 1;
+      handle->result_.created_ts_ = ObTimeUtil::current_time();
+      handle->data_buffer_.swap(expr_buffer_);
+      handle->data_buffer_.is_end_file_ = data_reader_.is_end_file();
+      total_line_count_ += current_line_count;
+    }
   }
   return ret;
 }
@@ -1677,6 +2023,12 @@ int ObLoadDataDirectImpl::MultiFilesLoadExecutor::init(const LoadExecuteParam &e
     } else if (OB_FAIL(data_desc_iter_.copy(data_desc_iter))) {
       LOG_WARN("fail to copy data desc iter", KR(ret));
     } else {
+      // each worker runs all stages for its own file
+      ObLoadDataStat *job_stat = execute_ctx_->job_stat_;
+      job_stat->read_stage_.threads_ = execute_param_->parallel_;
+      job_stat->split_stage_.threads_ = execute_param_->parallel_;
+      job_stat->parse_stage_.threads_ = execute_param_->parallel_;
+      job_stat->route_stage_.threads_ = execute_param_->parallel_;
       is_inited_ = true;
     }
   }
@@ -1861,7 +2213,13 @@ int ObLoadDataDirectImpl::init_execute_param()
     } else if (OB_FAIL(GCTX.omt_->get_tenant(execute_param_.tenant_id_, tenant))) {
       LOG_WARN("fail to get tenant handle", KR(ret), K(execute_param_.tenant_id_));
     } else {
-      hint_parallel = hint_parallel > 0 ? hint_parallel : DEFAULT_PARALLEL_THREAD_COUNT;
+      // threads of the parse and route stages, the PARALLEL hint takes precedence
+      omt::ObTenantConfigGuard tenant_config(TENANT_CONF(execute_param_.tenant_id_));
+      const int64_t config_parallel =
+        tenant_config.is_valid() ? tenant_config->_load_data_parse_thread_count : 0;
+      hint_parallel = hint_parallel > 0
+                        ? hint_parallel
+                        : (config_parallel > 0 ? config_parallel : DEFAULT_PARALLEL_THREAD_COUNT);
       hint_parallel = load_args.file_iter_.count() > 1
                         ? MIN(hint_parallel, load_args.file_iter_.count())
                         : hint_parallel;
@@ -5,6 +5,7 @@
 #pragma once
 
 #include "lib/allocator/page_arena.h"
+#include "lib/queue/ob_lighty_queue.h"
 #include "observer/table_load/ob_table_load_object_allocator.h"
 #include "observer/table_load/ob_table_load_task.h"
 #include "share/table/ob_table_load_array.h"
@@ -237,6 +238,50 @@ private:
     DISALLOW_COPY_AND_ASSIGN(DataBuffer);
   };
 
+  // Read stage of the large file pipeline.
+  // A dedicated thread issues large sequential reads into a bounded queue of buffers,
+  // so that io overlaps with splitting and parsing. It reads through the accessor of the
+  // DataReader it is attached to, which no longer touches the accessor afterwards.
+  class DataPrefetcher
+  {
+    static const int64_t WAIT_INTERVAL_US = 100LL * 1000; // 100ms
+  public:
+    static const int64_t DEFAULT_BUFFER_COUNT = 4;
+    DataPrefetcher();
+    ~DataPrefetcher();
+    int init(LoadExecuteContext &execute_ctx, SequentialDataAccessor &io_accessor,
+             int64_t end_offset, int64_t buffer_count = DEFAULT_BUFFER_COUNT);
+    int start();
+    void stop();
+    // called by the split stage, read size is less than count only at the end of data
+    int read(char *buf, int64_t count, int64_t &read_size);
+    // called in prefetch thread
+    int prefetch();
+    void on_prefetch_finished(int ret_code);
+  private:
+    int pop_ready_buffer(DataBuffer *&buffer);
+    int init_buffers(int64_t buffer_count);
+  private:
+    class PrefetchTaskProcessor;
+    class PrefetchTaskCallback;
+  private:
+    LoadExecuteContext *execute_ctx_;
+    SequentialDataAccessor *io_accessor_;
+    int64_t end_offset_;
+    DataBuffer *buffers_;
+    int64_t buffer_count_;
+    common::LightyQueue free_queue_;
+    common::LightyQueue ready_queue_;
+    DataBuffer *cur_buffer_; // only accessed by the split stage
+    observer::ObITableLoadTaskScheduler *task_scheduler_;
+    observer::ObTableLoadTask *task_;
+    volatile int prefetch_ret_;
+    volatile bool is_finished_;
+    volatile bool is_stop_;
+    bool is_inited_;
+    DISALLOW_COPY_AND_ASSIGN(DataPrefetcher);
+  };
+
   // Read the buffer and align it by row.
   class DataReader
   {
@@ -244,18 +289,26 @@ private:
     DataReader();
     int init(const DataAccessParam &data_access_param, LoadExecuteContext &execute_ctx,
              const DataDesc &data_desc, bool read_raw = false);
+    // read through the prefetcher instead of issuing io in the caller thread
+    void set_prefetcher(DataPrefetcher *prefetcher) { prefetcher_ = prefetcher; }
     int get_next_buffer(ObLoadFileBuffer &file_buffer, int64_t &line_count,
                         int64_t limit = INT64_MAX);
     int get_next_raw_buffer(DataBuffer &data_buffer);
     int64_t get_lines_count() const { return data_trimer_.get_lines_count(); }
     bool has_incomplate_data() const { return data_trimer_.has_incomplate_data(); }
-    bool is_end_file() const { return io_accessor_.get_offset() >= end_offset_; }
+    bool is_end_file() const { return offset_ >= end_offset_; }
     ObCSVGeneralParser &get_csv_parser() { return csv_parser_; }
+    SequentialDataAccessor &get_io_accessor() { return io_accessor_; }
+    int64_t get_end_offset() const { return end_offset_; }
+  private:
+    int read_data(char *buf, int64_t count, int64_t &read_size);
   private:
     LoadExecuteContext *execute_ctx_;
     ObCSVGeneralParser csv_parser_; // 用来计算完整行
     ObLoadFileDataTrimer data_trimer_; // 缓存不完整行的数据
     SequentialDataAccessor io_accessor_;
+    DataPrefetcher *prefetcher_;
+    int64_t offset_; // offset of the data handed out, the accessor may be ahead of it
     int64_t end_offset_;
     bool read_raw_;
     bool is_iter_end_;
@@ -352,6 +405,8 @@ private:
     int alloc_task(observer::ObTableLoadTask *&task);
     void free_task(observer::ObTableLoadTask *task);
     void task_finished(TaskHandle *handle);
+    void on_task_done();
+    sql::ObLoadDataStat *get_job_stat() const { return execute_ctx_->job_stat_; }
     int process_task_handle(int64_t worker_idx, TaskHandle *handle, int64_t &line_count);
   protected:
     virtual int prepare_execute() = 0;
@@ -412,6 +467,9 @@ private:
     DataDesc data_desc_;
     DataBuffer expr_buffer_;
     DataReader data_reader_;
+    // declared after data_reader_ so that the prefetch thread is stopped before the
+    // accessor it reads through is destroyed
+    DataPrefetcher data_prefetcher_;
     int32_t next_session_id_;
     int64_t total_line_count_;
     DISALLOW_COPY_AND_ASSIGN(LargeFileLoadExecutor);
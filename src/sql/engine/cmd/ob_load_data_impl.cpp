@@ -438,6 +438,25 @@ int ObLoadDataBase::pre_parse_lines(ObLoadFileBuffer &buffer,
   if (OB_UNLIKELY(!buffer.is_valid())) {
     ret = OB_INVALID_ARGUMENT;
     LOG_WARN("invalid buffer", K(ret));
+  } else if (parser.get_opt_params().is_simple_format_
+             && INT64_MAX == parser.get_format().field_escaped_char_) {
+    // no escape char, line terminators can be located by memchr which is vectorized
+    const char line_term_c = parser.get_opt_params().line_term_c_;
+    char *cur_pos = buffer.begin_ptr();
+    char *end = buffer.current_ptr();
+    int64_t cur_lines = 0;
+    char *p = nullptr;
+    while (cur_lines < line_count && cur_pos < end
+           && nullptr != (p = static_cast<char *>(MEMCHR(cur_pos, line_term_c, end - cur_pos)))) {
+      cur_lines++;
+      cur_pos = p + 1;
+    }
+    if (is_last_buf && cur_lines < line_count && end > cur_pos) {
+      cur_lines++;
+      cur_pos = end;
+    }
+    valid_len = cur_pos - buffer.begin_ptr();
+    line_count = cur_lines;
   } else if (parser.get_opt_params().is_simple_format_) {
     const ObCSVGeneralFormat &format = parser.get_format();
     char *cur_pos = buffer.begin_ptr();
@@ -321,7 +321,11 @@ struct ObLoadDataStat
                      insert_rt_sum_(0),
                      total_wait_secs_(0),
                      max_allowed_error_rows_(0),
-                     detected_error_rows_(0) {}
+                     detected_error_rows_(0),
+                     read_stage_(),
+                     split_stage_(),
+                     parse_stage_(),
+                     route_stage_() {}
   int64_t aquire() {
     return ATOMIC_AAF(&ref_cnt_, 1);
   }
@@ -369,6 +373,21 @@ struct ObLoadDataStat
     common::ObString trans_status_;
   } store;
 
+  // direct load pipeline: read -> split -> parse -> route (cast and partition calc)
+  struct StageStat
+  {
+    StageStat() : threads_(0), busy_time_(0), wait_time_(0), queue_size_(0) {}
+    int64_t threads_;
+    volatile int64_t busy_time_;  // us spent on the stage's own work
+    volatile int64_t wait_time_;  // us blocked on the neighbouring stages
+    volatile int64_t queue_size_; // items buffered in front of the stage
+    TO_STRING_KV(K(threads_), K(busy_time_), K(wait_time_), K(queue_size_));
+  };
+  StageStat read_stage_;
+  StageStat split_stage_;
+  StageStat parse_stage_;
+  StageStat route_stage_;
+
   TO_STRING_KV(K(tenant_id_), K(job_id_), K(job_type_),
       K(table_name_), K(file_path_), K(table_column_), K(file_column_),
       K(batch_size_), K(parallel_), K(load_mode_),
@@ -380,7 +399,8 @@ struct ObLoadDataStat
       K(coordinator.received_rows_), K(coordinator.last_commit_segment_id_),
       K(coordinator.status_), K(coordinator.trans_status_),
       K(store.processed_rows_), K(store.last_commit_segment_id_),
-      K(store.status_), K(store.trans_status_));
+      K(store.status_), K(store.trans_status_),
+      K(read_stage_), K(split_stage_), K(parse_stage_), K(route_stage_));
 };
 
 class ObGetAllJobStatusOp
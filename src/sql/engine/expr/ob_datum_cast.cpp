@@ -2589,6 +2589,104 @@ CAST_FUNC_NAME(uint, double)
   return ret;
 }
 
+// Batch versions of the casts above which can not fail and need nothing but the argument:
+// the argument is evaluated for the whole batch, then converted row by row in one loop
+// instead of going through ObExpr::eval() for every row as cast_eval_arg_batch() does.
+// Chosen in ObDatumCast::choose_cast_function(), the row version of the same expr
+// must be the one named in the comment of each op.
+struct ObCastEvalArgOp // cast_eval_arg
+{
+  OB_INLINE static void cast(const ObDatum &arg, ObDatum &res) { res.set_datum(arg); }
+};
+
+struct ObCastIntIntOp // int_int, in_type <= out_type
+{
+  OB_INLINE static void cast(const ObDatum &arg, ObDatum &res) { res.set_int(arg.get_int()); }
+};
+
+struct ObCastUIntUIntOp // uint_uint, in_type <= out_type
+{
+  OB_INLINE static void cast(const ObDatum &arg, ObDatum &res) { res.set_uint(arg.get_uint()); }
+};
+
+struct ObCastIntDoubleOp // int_double, out_type is ObDoubleType
+{
+  OB_INLINE static void cast(const ObDatum &arg, ObDatum &res)
+  {
+    res.set_double(static_cast<double>(arg.get_int()));
+  }
+};
+
+struct ObCastUIntDoubleOp // uint_double
+{
+  OB_INLINE static void cast(const ObDatum &arg, ObDatum &res)
+  {
+    res.set_double(static_cast<double>(arg.get_uint()));
+  }
+};
+
+template <typename CastOp>
+static int cast_batch_by_op(const ObExpr &expr,
+                            ObEvalCtx &ctx,
+                            const ObBitVector &skip,
+                            const int64_t batch_size)
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(expr.args_[0]->eval_batch(ctx, skip, batch_size))) {
+    LOG_WARN("eval args_[0] failed", K(ret));
+  } else if (OB_FAIL(expr.args_[1]->eval_batch(ctx, skip, batch_size))) {
+    LOG_WARN("eval args_[1] failed", K(ret));
+  } else {
+    const ObExpr &arg = *expr.args_[0];
+    ObDatum *results = expr.locate_batch_datums(ctx);
+    ObBitVector &eval_flags = expr.get_evaluated_flags(ctx);
+    for (int64_t i = 0; i < batch_size; ++i) {
+      if (skip.at(i) || eval_flags.at(i)) {
+        continue;
+      } else {
+        const ObDatum &arg_datum = arg.locate_expr_datum(ctx, i);
+        if (arg_datum.is_null()) {
+          results[i].set_null();
+        } else {
+          CastOp::cast(arg_datum, results[i]);
+        }
+        eval_flags.set(i);
+      }
+    }
+  }
+  return ret;
+}
+
+int cast_eval_arg_batch_direct(const ObExpr &expr, ObEvalCtx &ctx,
+                               const ObBitVector &skip, const int64_t batch_size)
+{
+  return cast_batch_by_op<ObCastEvalArgOp>(expr, ctx, skip, batch_size);
+}
+
+int int_int_batch(const ObExpr &expr, ObEvalCtx &ctx,
+                  const ObBitVector &skip, const int64_t batch_size)
+{
+  return cast_batch_by_op<ObCastIntIntOp>(expr, ctx, skip, batch_size);
+}
+
+int uint_uint_batch(const ObExpr &expr, ObEvalCtx &ctx,
+                    const ObBitVector &skip, const int64_t batch_size)
+{
+  return cast_batch_by_op<ObCastUIntUIntOp>(expr, ctx, skip, batch_size);
+}
+
+int int_double_batch(const ObExpr &expr, ObEvalCtx &ctx,
+                     const ObBitVector &skip, const int64_t batch_size)
+{
+  return cast_batch_by_op<ObCastIntDoubleOp>(expr, ctx, skip, batch_size);
+}
+
+int uint_double_batch(const ObExpr &expr, ObEvalCtx &ctx,
+                      const ObBitVector &skip, const int64_t batch_size)
+{
+  return cast_batch_by_op<ObCastUIntDoubleOp>(expr, ctx, skip, batch_size);
+}
+
 CAST_FUNC_NAME(uint, float)
 {
   EVAL_ARG()
@@ -11911,9 +12009,20 @@ int ObDatumCast::choose_cast_function(const ObObjType in_type,
     }
   }
   if (OB_SUCC(ret)) {
-    // TODO:@xiaofeng.lby, need to modify cast expr in batch mode
-    // cast in batch mode will degrade into single row mode now
-    rt_expr.eval_batch_func_ = cast_eval_arg_batch;
+    // casts that can not fail have a batch kernel, the others degrade into single row mode
+    if (rt_expr.eval_func_ == cast_eval_arg) {
+      rt_expr.eval_batch_func_ = cast_eval_arg_batch_direct;
+    } else if (rt_expr.eval_func_ == int_int && in_type <= out_type) {
+      rt_expr.eval_batch_func_ = int_int_batch;
+    } else if (rt_expr.eval_func_ == uint_uint && in_type <= out_type) {
+      rt_expr.eval_batch_func_ = uint_uint_batch;
+    } else if (rt_expr.eval_func_ == int_double && ObDoubleType == out_type) {
+      rt_expr.eval_batch_func_ = int_double_batch;
+    } else if (rt_expr.eval_func_ == uint_double) {
+      rt_expr.eval_batch_func_ = uint_double_batch;
+    } else {
+      rt_expr.eval_batch_func_ = cast_eval_arg_batch;
+    }
   }
   LOG_DEBUG("in choose_cast_function", K(ret), K(in_type), K(out_type),
       K(in_cs_type), K(out_cs_type), K(CM_IS_EXPLICIT_CAST(cast_mode)),
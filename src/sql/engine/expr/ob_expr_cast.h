@@ -84,6 +84,11 @@ static const int32_t CAST_STRING_DEFUALT_LENGTH[50] = {
 static_assert(common::ObMaxType + 1 == sizeof(CAST_STRING_DEFUALT_LENGTH) / sizeof(int32_t),
   "Please keep the length of CAST_STRING_DEFUALT_LENGTH must equal to the number of types");
 extern int cast_eval_arg_batch(const ObExpr &, ObEvalCtx &, const ObBitVector &, const int64_t);
+extern int cast_eval_arg_batch_direct(const ObExpr &, ObEvalCtx &, const ObBitVector &, const int64_t);
+extern int int_int_batch(const ObExpr &, ObEvalCtx &, const ObBitVector &, const int64_t);
+extern int uint_uint_batch(const ObExpr &, ObEvalCtx &, const ObBitVector &, const int64_t);
+extern int int_double_batch(const ObExpr &, ObEvalCtx &, const ObBitVector &, const int64_t);
+extern int uint_double_batch(const ObExpr &, ObEvalCtx &, const ObBitVector &, const int64_t);
 class ObExprCast: public ObFuncExprOperator
 {
   OB_UNIS_VERSION_V(1);
@@ -81,6 +81,55 @@ int def_relational_eval_batch_func(BATCH_EVAL_FUNC_ARG_DECL, Args &...args)
   return ret;
 }
 
+// Compare raw values of fixed width type which compared by value directly,
+// used in batch evaluation to compare the contiguous reserved buffer of arguments.
+template <typename T, ObCmpOp CMP_OP>
+struct ObRelationalRawCmp : public ObArithOpRawType<int64_t, T, T>
+{
+  static void raw_op(int64_t &res, const T l, const T r)
+  {
+    res = get_cmp_ret<CMP_OP>(l == r ? 0 : (l < r ? -1 : 1));
+  }
+
+  static int raw_check(const int64_t &, const T &, const T &)
+  {
+    return OB_SUCCESS;
+  }
+};
+
+template <ObObjTypeClass L_TC, ObObjTypeClass R_TC>
+struct ObRelationalRawType
+{
+  constexpr static bool defined_ = false;
+  typedef int64_t TYPE;
+};
+
+template <> struct ObRelationalRawType<ObIntTC, ObIntTC>
+{
+  constexpr static bool defined_ = true;
+  typedef int64_t TYPE;
+};
+
+template <> struct ObRelationalRawType<ObUIntTC, ObUIntTC>
+{
+  constexpr static bool defined_ = true;
+  typedef uint64_t TYPE;
+};
+
+template <typename RawCmp>
+int def_relational_raw_eval_batch_func(BATCH_EVAL_FUNC_ARG_DECL)
+{
+  int ret = OB_SUCCESS;
+  const static bool short_circuit = true;
+  if (OB_FAIL(binary_operand_batch_eval(expr, ctx, skip, size, short_circuit))) {
+    LOG_WARN("binary operand batch evaluate failed", K(ret), K(expr));
+  } else {
+    ret = call_functor_with_arg_iter<ObArithOpWrap<RawCmp>, ObDoArithBatchEval>(
+        BATCH_EVAL_FUNC_ARG_LIST);
+  }
+  return ret;
+}
+
 struct ObDummyRelationalFunc
 {
   inline static int eval(const ObExpr &, ObEvalCtx &, ObDatum &) { return 0;};
@@ -138,6 +187,7 @@ struct ObRelationalTCFunc<true, L_TC, R_TC, CMP_OP>
       return OB_SUCCESS;
     }
   };
+  using RawType = ObRelationalRawType<L_TC, R_TC>;
 
   inline static int eval(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &expr_datum)
   {
@@ -147,7 +197,10 @@ struct ObRelationalTCFunc<true, L_TC, R_TC, CMP_OP>
 
   inline static int eval_batch(BATCH_EVAL_FUNC_ARG_DECL)
   {
-    return def_relational_eval_batch_func<DatumCmp>(BATCH_EVAL_FUNC_ARG_LIST);
+    return RawType::defined_
+        ? def_relational_raw_eval_batch_func<ObRelationalRawCmp<typename RawType::TYPE, CMP_OP>>(
+            BATCH_EVAL_FUNC_ARG_LIST)
+        : def_relational_eval_batch_func<DatumCmp>(BATCH_EVAL_FUNC_ARG_LIST);
   }
 };
 
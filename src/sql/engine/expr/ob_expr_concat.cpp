@@ -347,6 +347,13 @@ int ObExprConcat::cg_expr(ObExprCGCtx &, const ObRawExpr &, ObExpr &expr) const
   }
   if (OB_SUCC(ret)) {
     expr.eval_func_ = &eval_concat;
+    bool has_text_param = ob_is_text_tc(expr.datum_meta_.type_);
+    for (int64_t i = 0; !has_text_param && i < expr.arg_cnt_; i++) {
+      has_text_param = ob_is_text_tc(expr.args_[i]->datum_meta_.type_);
+    }
+    if (!lib::is_oracle_mode() && !has_text_param) {
+      expr.eval_batch_func_ = &eval_concat_batch;
+    }
   }
   return ret;
 }
@@ -482,5 +489,64 @@ int ObExprConcat::eval_concat(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &expr_
   return ret;
 }
 
+int ObExprConcat::eval_concat_batch(const ObExpr &expr, ObEvalCtx &ctx,
+                                    const ObBitVector &skip, const int64_t batch_size)
+{
+  int ret = OB_SUCCESS;
+  for (int64_t j = 0; OB_SUCC(ret) && j < expr.arg_cnt_; j++) {
+    if (OB_FAIL(expr.args_[j]->eval_batch(ctx, skip, batch_size))) {
+      LOG_WARN("evaluate parameter batch failed", K(ret), K(j));
+    }
+  }
+  if (OB_SUCC(ret)) {
+    ObDatum *res_datums = expr.locate_batch_datums(ctx);
+    ObBitVector &eval_flags = expr.get_evaluated_flags(ctx);
+    for (int64_t i = 0; OB_SUCC(ret) && i < batch_size; i++) {
+      if (skip.at(i) || eval_flags.at(i)) {
+        continue;
+      }
+      // any param is null, result is null in mysql mode
+      bool has_null = false;
+      int64_t res_len = 0;
+      for (int64_t j = 0; j < expr.arg_cnt_; j++) {
+        const ObDatum &v = expr.args_[j]->locate_expr_datum(ctx, i);
+        if (v.is_null()) {
+          has_null = true;
+        } else {
+          res_len += v.len_;
+        }
+      }
+      if (res_len > OB_MAX_VARCHAR_LENGTH) {
+        res_datums[i].set_null();
+        ret = OB_SIZE_OVERFLOW;
+        LOG_WARN("size overflow", K(ret), K(res_len));
+      } else if (has_null) {
+        res_datums[i].set_null();
+      } else if (1 == expr.arg_cnt_) {
+        // only one valid input, shadow copy
+        res_datums[i].set_datum(expr.args_[0]->locate_expr_datum(ctx, i));
+      } else {
+        char *buf = expr.get_str_res_mem(ctx, res_len, i);
+        if (OB_ISNULL(buf)) {
+          ret = OB_ALLOCATE_MEMORY_FAILED;
+          LOG_WARN("allocate memory failed", K(ret), K(res_len));
+        } else {
+          int64_t off = 0;
+          for (int64_t j = 0; j < expr.arg_cnt_; j++) {
+            const ObDatum &v = expr.args_[j]->locate_expr_datum(ctx, i);
+            MEMCPY(buf + off, v.ptr_, v.len_);
+            off += v.len_;
+          }
+          res_datums[i].set_string(buf, res_len);
+        }
+      }
+      if (OB_SUCC(ret)) {
+        eval_flags.set(i);
+      }
+    }
+  }
+  return ret;
+}
+
 }
 }
@@ -63,6 +63,9 @@ public:
                       ObExpr &rt_expr) const override;
 
   static int eval_concat(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &expr_datum);
+  // batch version of eval_concat, only for non text params in mysql mode
+  static int eval_concat_batch(const ObExpr &expr, ObEvalCtx &ctx,
+                               const ObBitVector &skip, const int64_t batch_size);
 
 private:
   // disallow copy
@@ -131,19 +131,74 @@ int ObExprDateAdjust::calc_date_adjust(const ObExpr &expr, ObEvalCtx &ctx, ObDat
 {
   int ret = OB_SUCCESS;
   const ObSQLSessionInfo *session = NULL;
-  const ObObjType res_type = expr.datum_meta_.type_;
-  const ObObjType date_type = expr.args_[0]->datum_meta_.type_;
   ObDatum *date = NULL;
   ObDatum *interval = NULL;
   ObDatum *unit = NULL;
-  bool is_json = (expr.args_[0]->args_ != NULL) && (expr.args_[0]->args_[0]->datum_meta_.type_ == ObJsonType);
   if (OB_ISNULL(session = ctx.exec_ctx_.get_my_session())) {
     ret = OB_ERR_UNEXPECTED;
     LOG_WARN("session is null", K(ret));
   } else if (OB_FAIL(expr.eval_param_value(ctx, date, interval, unit))) {
     LOG_WARN("eval param value failed");
-  } else if (OB_UNLIKELY(date->is_null() || interval->is_null())
-             || ObNullType == res_type) {
+  } else if (OB_FAIL(calc_date_adjust_datum(expr, ctx, *session, *date, *interval, *unit,
+                                            expr_datum, is_add))) {
+    LOG_WARN("calc date adjust failed", K(ret));
+  }
+  return ret;
+}
+
+int ObExprDateAdjust::calc_date_adjust_batch(const ObExpr &expr, ObEvalCtx &ctx,
+                                             const ObBitVector &skip, const int64_t batch_size,
+                                             bool is_add)
+{
+  int ret = OB_SUCCESS;
+  const ObSQLSessionInfo *session = NULL;
+  if (OB_ISNULL(session = ctx.exec_ctx_.get_my_session())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("session is null", K(ret));
+  } else if (OB_FAIL(expr.eval_batch_param_value(ctx, skip, batch_size))) {
+    LOG_WARN("eval param value failed", K(ret));
+  } else {
+    ObDatum *res = expr.locate_batch_datums(ctx);
+    ObBitVector &eval_flags = expr.get_evaluated_flags(ctx);
+    ObDatumVector dates = expr.args_[0]->locate_expr_datumvector(ctx);
+    ObDatumVector intervals = expr.args_[1]->locate_expr_datumvector(ctx);
+    ObDatumVector units = expr.args_[2]->locate_expr_datumvector(ctx);
+    // string results are allocated through get_str_res_mem(ctx, len), which
+    // locates the slot by the batch idx of ctx.
+    ObEvalCtx::BatchInfoScopeGuard batch_info_guard(ctx);
+    batch_info_guard.set_batch_size(batch_size);
+    for (int64_t i = 0; OB_SUCC(ret) && i < batch_size; ++i) {
+      if (skip.at(i) || eval_flags.at(i)) {
+        continue;
+      }
+      batch_info_guard.set_batch_idx(i);
+      if (OB_FAIL(calc_date_adjust_datum(expr, ctx, *session, *dates.at(i), *intervals.at(i),
+                                         *units.at(i), res[i], is_add))) {
+        LOG_WARN("calc date adjust failed", K(ret), K(i));
+      } else {
+        eval_flags.set(i);
+      }
+    }
+  }
+  return ret;
+}
+
+int ObExprDateAdjust::calc_date_adjust_datum(const ObExpr &expr, ObEvalCtx &ctx,
+                                             const ObSQLSessionInfo &session_info,
+                                             ObDatum &date_datum, const ObDatum &interval_datum,
+                                             const ObDatum &unit_datum, ObDatum &expr_datum,
+                                             bool is_add)
+{
+  int ret = OB_SUCCESS;
+  const ObSQLSessionInfo *session = &session_info;
+  const ObObjType res_type = expr.datum_meta_.type_;
+  const ObObjType date_type = expr.args_[0]->datum_meta_.type_;
+  ObDatum *date = &date_datum;
+  const ObDatum *interval = &interval_datum;
+  const ObDatum *unit = &unit_datum;
+  bool is_json = (expr.args_[0]->args_ != NULL) && (expr.args_[0]->args_[0]->datum_meta_.type_ == ObJsonType);
+  if (OB_UNLIKELY(date->is_null() || interval->is_null())
+      || ObNullType == res_type) {
     expr_datum.set_null();
   } else {
     int64_t dt_val = 0;
@@ -312,6 +367,7 @@ int ObExprDateAdd::cg_expr(ObExprCGCtx &op_cg_ctx, const ObRawExpr &raw_expr, Ob
                                               K(rt_expr.args_[1]), K(rt_expr.args_[2]));
   } else {
     rt_expr.eval_func_ = ObExprDateAdd::calc_date_add;
+    rt_expr.eval_batch_func_ = ObExprDateAdd::calc_date_add_batch;
   }
   return ret;
 }
@@ -321,6 +377,12 @@ int ObExprDateAdd::calc_date_add(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &ex
   return ObExprDateAdjust::calc_date_adjust(expr, ctx, expr_datum, true /* is_add */);
 }
 
+int ObExprDateAdd::calc_date_add_batch(const ObExpr &expr, ObEvalCtx &ctx,
+                                       const ObBitVector &skip, const int64_t batch_size)
+{
+  return ObExprDateAdjust::calc_date_adjust_batch(expr, ctx, skip, batch_size, true /* is_add */);
+}
+
 ObExprDateSub::ObExprDateSub(ObIAllocator &alloc)
     : ObExprDateAdjust(alloc, T_FUN_SYS_DATE_SUB, N_DATE_SUB, 3, NOT_ROW_DIMENSION)
 {}
@@ -344,6 +406,7 @@ int ObExprDateSub::cg_expr(ObExprCGCtx &op_cg_ctx, const ObRawExpr &raw_expr, Ob
               K(rt_expr.args_[1]), K(rt_expr.args_[2]));
   } else {
     rt_expr.eval_func_ = ObExprDateSub::calc_date_sub;
+    rt_expr.eval_batch_func_ = ObExprDateSub::calc_date_sub_batch;
   }
   return ret;
 }
@@ -353,6 +416,12 @@ int ObExprDateSub::calc_date_sub(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &ex
   return ObExprDateAdjust::calc_date_adjust(expr, ctx, expr_datum, false /* is_add */);
 }
 
+int ObExprDateSub::calc_date_sub_batch(const ObExpr &expr, ObEvalCtx &ctx,
+                                       const ObBitVector &skip, const int64_t batch_size)
+{
+  return ObExprDateAdjust::calc_date_adjust_batch(expr, ctx, skip, batch_size, false /* is_add */);
+}
+
 ObExprAddMonths::ObExprAddMonths(ObIAllocator &alloc)
     : ObFuncExprOperator(alloc, T_FUN_SYS_ADD_MONTHS, N_ADD_MONTHS, 2, NOT_ROW_DIMENSION)
 {}
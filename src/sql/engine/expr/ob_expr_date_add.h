@@ -34,7 +34,13 @@ public:
                                 ObExprResType &unit,
                                 common::ObExprTypeCtx &type_ctx) const;
   static int calc_date_adjust(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &expr_datum, bool is_add);
+  static int calc_date_adjust_batch(const ObExpr &expr, ObEvalCtx &ctx, const ObBitVector &skip,
+                                    const int64_t batch_size, bool is_add);
 private:
+  static int calc_date_adjust_datum(const ObExpr &expr, ObEvalCtx &ctx,
+                                    const ObSQLSessionInfo &session,
+                                    ObDatum &date, const ObDatum &interval,
+                                    const ObDatum &unit, ObDatum &expr_datum, bool is_add);
   DISALLOW_COPY_AND_ASSIGN(ObExprDateAdjust);
 };
 
@@ -47,6 +53,8 @@ public:
                       const ObRawExpr &raw_expr,
                       ObExpr &rt_expr) const override;
   static int calc_date_add(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &expr_datum);
+  static int calc_date_add_batch(const ObExpr &expr, ObEvalCtx &ctx, const ObBitVector &skip,
+                                 const int64_t batch_size);
 private:
   DISALLOW_COPY_AND_ASSIGN(ObExprDateAdd);
 };
@@ -60,6 +68,8 @@ public:
                       const ObRawExpr &raw_expr,
                       ObExpr &rt_expr) const override;
   static int calc_date_sub(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &expr_datum);
+  static int calc_date_sub_batch(const ObExpr &expr, ObEvalCtx &ctx, const ObBitVector &skip,
+                                 const int64_t batch_size);
 private:
   DISALLOW_COPY_AND_ASSIGN(ObExprDateSub);
 };
@@ -63,6 +63,7 @@ int ObExprDateFormat::cg_expr(ObExprCGCtx &op_cg_ctx,
     rt_expr.eval_func_ = ObExprDateFormat::calc_date_format_invalid;
   } else {
     rt_expr.eval_func_ = ObExprDateFormat::calc_date_format;
+    rt_expr.eval_batch_func_ = ObExprDateFormat::calc_date_format_batch;
   }
   return ret;
 }
@@ -124,6 +125,83 @@ int ObExprDateFormat::calc_date_format(const ObExpr &expr, ObEvalCtx &ctx, ObDat
   return ret;
 }
 
+int ObExprDateFormat::calc_date_format_batch(const ObExpr &expr, ObEvalCtx &ctx,
+                                             const ObBitVector &skip, const int64_t batch_size)
+{
+  int ret = OB_SUCCESS;
+  const ObSQLSessionInfo *session = NULL;
+  uint64_t cast_mode = 0;
+  if (OB_ISNULL(session = ctx.exec_ctx_.get_my_session())) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("session is null", K(ret), K(session));
+  } else if (OB_FAIL(ObSQLUtils::get_default_cast_mode(session->get_stmt_type(),
+                                                       session, cast_mode))) {
+    LOG_WARN("get default cast mode failed", K(ret));
+  } else if (OB_FAIL(expr.args_[0]->eval_batch(ctx, skip, batch_size))) {
+    LOG_WARN("calc date param batch failed", K(ret));
+  } else if (OB_FAIL(expr.args_[1]->eval_batch(ctx, skip, batch_size))) {
+    LOG_WARN("calc format param batch failed", K(ret));
+  } else {
+    ObDatum *res_datums = expr.locate_batch_datums(ctx);
+    ObDatumVector date_datums = expr.args_[0]->locate_expr_datumvector(ctx);
+    ObDatumVector format_datums = expr.args_[1]->locate_expr_datumvector(ctx);
+    ObBitVector &eval_flags = expr.get_evaluated_flags(ctx);
+    const ObTimeZoneInfo *tz_info = get_timezone_info(session);
+    const int64_t cur_ts_value = get_cur_time(ctx.exec_ctx_.get_physical_plan_ctx());
+    const int64_t buf_len = OB_MAX_DATE_FORMAT_BUF_LEN;
+    ObDateSqlMode date_sql_mode;
+    date_sql_mode.init(session->get_sql_mode());
+    for (int64_t i = 0; OB_SUCC(ret) && i < batch_size; ++i) {
+      if (skip.at(i) || eval_flags.at(i)) {
+        continue;
+      }
+      const ObDatum *date = date_datums.at(i);
+      const ObDatum *format = format_datums.at(i);
+      ObDatum &res_datum = res_datums[i];
+      ObTime ob_time;
+      char *buf = NULL;
+      int64_t pos = 0;
+      bool res_null = false;
+      if (date->is_null() || format->is_null()) {
+        res_datum.set_null();
+      } else if (OB_ISNULL(buf = expr.get_str_res_mem(ctx, buf_len, i))) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_ERROR("no more memory to alloc for buf");
+      } else if (OB_FAIL(ob_datum_to_ob_time_with_date(*date,
+                                                       expr.args_[0]->datum_meta_.type_,
+                                                       tz_info,
+                                                       ob_time,
+                                                       cur_ts_value,
+                                                       false,
+                                                       date_sql_mode,
+                                                       expr.args_[0]->obj_meta_.has_lob_header()))) {
+        LOG_WARN("failed to convert datum to ob time");
+        if (CM_IS_WARN_ON_FAIL(cast_mode) && OB_ALLOCATE_MEMORY_FAILED != ret) {
+          ret = OB_SUCCESS;
+          res_datum.set_null();
+        }
+      } else if (OB_UNLIKELY(format->get_string().empty())) {
+        res_datum.set_null();
+      } else if (OB_FAIL(ObTimeConverter::ob_time_to_str_format(ob_time,
+                                                                format->get_string(),
+                                                                buf,
+                                                                buf_len,
+                                                                pos,
+                                                                res_null))) {
+        LOG_WARN("failed to convert ob time to str with format");
+      } else if (res_null) {
+        res_datum.set_null();
+      } else {
+        res_datum.set_string(buf, static_cast<int32_t>(pos));
+      }
+      if (OB_SUCC(ret)) {
+        eval_flags.set(i);
+      }
+    }
+  }
+  return ret;
+}
+
 int ObExprDateFormat::calc_date_format_invalid(const ObExpr &expr, ObEvalCtx &ctx,
                                                ObDatum &expr_datum)
 {
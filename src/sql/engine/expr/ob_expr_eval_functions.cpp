@@ -386,6 +386,7 @@ extern int calc_convert_expr(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &res_da
 extern int calc_translate_using_expr(const ObExpr &, ObEvalCtx &, ObDatum &);
 extern int eval_question_mark_func(EVAL_FUNC_ARG_DECL);
 extern int cast_eval_arg_batch(const ObExpr &, ObEvalCtx &, const ObBitVector &, const int64_t);
+extern int calc_str_to_date_expr_batch(const ObExpr &, ObEvalCtx &, const ObBitVector &, const int64_t);
 extern int eval_batch_ceil_floor(const ObExpr &, ObEvalCtx &, const ObBitVector &, const int64_t);
 extern int eval_assign_question_mark_func(EVAL_FUNC_ARG_DECL);
 extern int calc_timestamp_to_scn_expr(const ObExpr &, ObEvalCtx &, ObDatum &);
@@ -1093,7 +1094,23 @@ static ObExpr::EvalBatchFunc g_expr_eval_batch_functions[] = {
   ObExprEncode::eval_encode_batch,                                    /* 107 */
   ObExprDecode::eval_decode_batch,                                    /* 108 */
   ObExprCoalesce::calc_batch_coalesce_expr,                           /* 109 */
-  ObExprIsNot::calc_batch_is_not_null                                 /* 110 */
+  ObExprIsNot::calc_batch_is_not_null,                                /* 110 */
+  ObExprLower::calc_lower_batch,                                      /* 111 */
+  ObExprUpper::calc_upper_batch,                                      /* 112 */
+  ObExprLength::calc_mysql_mode_batch,                                /* 113 */
+  ObExprMd5::calc_md5_batch,                                          /* 114 */
+  ObExprSha::eval_sha_batch,                                          /* 115 */
+  ObExprSha2::eval_sha2_batch,                                        /* 116 */
+  ObExprConcat::eval_concat_batch,                                    /* 117 */
+  ObExprDateFormat::calc_date_format_batch,                           /* 118 */
+  calc_str_to_date_expr_batch,                                        /* 119 */
+  ObExprDateAdd::calc_date_add_batch,                                 /* 120 */
+  ObExprDateSub::calc_date_sub_batch,                                 /* 121 */
+  cast_eval_arg_batch_direct,                                         /* 122 */
+  int_int_batch,                                                      /* 123 */
+  uint_uint_batch,                                                    /* 124 */
+  int_double_batch,                                                   /* 125 */
+  uint_double_batch                                                   /* 126 */
 };
 
 REG_SER_FUNC_ARRAY(OB_SFA_SQL_EXPR_EVAL,
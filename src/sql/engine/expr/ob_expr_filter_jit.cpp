@@ -0,0 +1,494 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_ENG
+#include "sql/engine/expr/ob_expr_filter_jit.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace jit;
+namespace sql
+{
+
+// The kernel addresses row i of a batch leaf by shifting i, and detects NULL by
+// the sign of ObDatumDesc::pack_ (null_ is the highest bit).
+STATIC_ASSERT(16 == sizeof(ObDatum), "datum size changed, fix ObExprFilterJit");
+static const int64_t DATUM_SIZE_SHIFT = 4;
+
+static bool is_datum_null_bit_signed()
+{
+  ObDatum datum;
+  datum.set_null();
+  return static_cast<int32_t>(datum.pack_) < 0;
+}
+
+ObExprFilterJit::ObExprFilterJit(const uint64_t tenant_id)
+  : allocator_("SqlFilterJit", OB_MALLOC_NORMAL_BLOCK_SIZE, tenant_id),
+    helper_(allocator_),
+    leaves_(),
+    kernel_(NULL)
+{
+}
+
+ObExprFilterJit::~ObExprFilterJit()
+{
+  kernel_ = NULL;
+  leaves_.reset();
+}
+
+bool ObExprFilterJit::is_supported_leaf(const ObExpr &expr)
+{
+  return 0 == expr.arg_cnt_
+      && (T_REF_COLUMN == expr.type_ || IS_DATATYPE_OR_QUESTIONMARK_OP(expr.type_));
+}
+
+bool ObExprFilterJit::is_supported_cmp(const ObExpr &expr)
+{
+  bool supported = false;
+  if (2 == expr.arg_cnt_
+      && (T_OP_EQ == expr.type_ || T_OP_NE == expr.type_
+          || T_OP_LT == expr.type_ || T_OP_LE == expr.type_
+          || T_OP_GT == expr.type_ || T_OP_GE == expr.type_)
+      && OB_NOT_NULL(expr.args_)
+      && OB_NOT_NULL(expr.args_[0]) && OB_NOT_NULL(expr.args_[1])
+      && is_supported_leaf(*expr.args_[0]) && is_supported_leaf(*expr.args_[1])) {
+    const ObObjType l_type = expr.args_[0]->datum_meta_.type_;
+    const ObObjType r_type = expr.args_[1]->datum_meta_.type_;
+    const ObObjTypeClass l_tc = ob_obj_type_class(l_type);
+    const ObObjTypeClass r_tc = ob_obj_type_class(r_type);
+    // all of them are stored as 8 bytes integer in datum
+    supported = (l_tc == r_tc)
+        && (ObIntTC == l_tc || ObUIntTC == l_tc || ObTimeTC == l_tc
+            || (ObDateTimeTC == l_tc && l_type == r_type));
+  }
+  return supported;
+}
+
+bool ObExprFilterJit::is_supported_tree(const ObExpr &expr, const int64_t depth)
+{
+  bool supported = false;
+  if (depth > MAX_TREE_DEPTH) {
+    // too deep, keep it interpreted
+  } else if (T_OP_AND == expr.type_ || T_OP_OR == expr.type_) {
+    supported = expr.arg_cnt_ > 0 && OB_NOT_NULL(expr.args_);
+    for (int64_t i = 0; supported && i < expr.arg_cnt_; i++) {
+      supported = OB_NOT_NULL(expr.args_[i]) && is_supported_tree(*expr.args_[i], depth + 1);
+    }
+  } else {
+    supported = is_supported_cmp(expr);
+  }
+  return supported;
+}
+
+bool ObExprFilterJit::is_supported(const ObIArray<ObExpr *> &filters)
+{
+  bool supported = !filters.empty() && is_datum_null_bit_signed();
+  for (int64_t i = 0; supported && i < filters.count(); i++) {
+    const ObExpr *e = filters.at(i);
+    supported = OB_NOT_NULL(e) && ob_is_int_tc(e->datum_meta_.type_)
+        && is_supported_tree(*e, 0);
+  }
+  // leaf count is checked in compile() after deduplication
+  return supported;
+}
+
+int ObExprFilterJit::collect_leaves(const ObExpr &expr)
+{
+  int ret = OB_SUCCESS;
+  if (0 == expr.arg_cnt_) {
+    if (get_leaf_idx(expr) < 0 && OB_FAIL(leaves_.push_back(&expr))) {
+      LOG_WARN("push back failed", K(ret));
+    }
+  } else {
+    for (int64_t i = 0; OB_SUCC(ret) && i < expr.arg_cnt_; i++) {
+      if (OB_FAIL(collect_leaves(*expr.args_[i]))) {
+        LOG_WARN("collect leaves failed", K(ret));
+      }
+    }
+  }
+  return ret;
+}
+
+int64_t ObExprFilterJit::get_leaf_idx(const ObExpr &leaf) const
+{
+  int64_t idx = -1;
+  for (int64_t i = 0; idx < 0 && i < leaves_.count(); i++) {
+    if (leaves_.at(i) == &leaf) {
+      idx = i;
+    }
+  }
+  return idx;
+}
+
+int ObExprFilterJit::compile(const ObIArray<ObExpr *> &filters, const uint64_t op_id)
+{
+  int ret = OB_SUCCESS;
+  char name_buf[64];
+  int64_t name_len = 0;
+  if (OB_UNLIKELY(NULL != kernel_)) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("filter kernel already compiled", K(ret));
+  } else if (OB_UNLIKELY(!is_supported(filters))) {
+    ret = OB_NOT_SUPPORTED;
+    LOG_WARN("filters not supported by jit", K(ret));
+  } else if (OB_FAIL(databuff_printf(name_buf, sizeof(name_buf), name_len,
+                                     "ob_filter_kernel_%lu", op_id))) {
+    LOG_WARN("print kernel name failed", K(ret));
+  } else if (OB_FAIL(helper_.init())) {
+    LOG_WARN("init llvm helper failed", K(ret));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < filters.count(); i++) {
+    if (OB_FAIL(collect_leaves(*filters.at(i)))) {
+      LOG_WARN("collect leaves failed", K(ret));
+    }
+  }
+  if (OB_SUCC(ret)) {
+    const ObString name(name_len, name_buf);
+    if (OB_UNLIKELY(leaves_.count() > MAX_LEAF_CNT)) {
+      ret = OB_NOT_SUPPORTED;
+      LOG_WARN("too many leaves", K(ret), K(leaves_.count()));
+    } else if (OB_FAIL(generate_kernel(filters, name))) {
+      LOG_WARN("generate filter kernel failed", K(ret));
+    } else if (OB_FAIL(helper_.verify_module())) {
+      LOG_WARN("verify module failed", K(ret));
+    } else {
+      helper_.compile_module(true);
+      kernel_ = reinterpret_cast<FilterKernel>(helper_.get_function_address(name));
+      if (OB_ISNULL(kernel_)) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("get kernel address failed", K(ret), K(name));
+      } else {
+        LOG_INFO("filter kernel compiled", K(name), K(leaves_.count()), K(filters.count()));
+      }
+    }
+  }
+  // the generated code is kept by the jit engine, the module is useless now.
+  helper_.final();
+  return ret;
+}
+
+int ObExprFilterJit::generate_load(ObLLVMValue &addr, ObLLVMType &ptr_type, ObLLVMValue &value)
+{
+  int ret = OB_SUCCESS;
+  ObLLVMValue ptr;
+  if (OB_FAIL(helper_.create_int_to_ptr(ObString("ptr"), addr, ptr_type, ptr))) {
+    LOG_WARN("create int to ptr failed", K(ret));
+  } else if (OB_FAIL(helper_.create_load(ObString("value"), ptr, value))) {
+    LOG_WARN("create load failed", K(ret));
+  }
+  return ret;
+}
+
+int ObExprFilterJit::generate_kernel(const ObIArray<ObExpr *> &filters, const ObString &name)
+{
+  int ret = OB_SUCCESS;
+  CodeGenCtx cg_ctx;
+  ObLLVMType int8_type;
+  ObLLVMType int8_ptr_type;
+  ObLLVMType int8_ptr_ptr_type;
+  ObLLVMType int32_type;
+  ObLLVMFunctionType func_type;
+  ObSEArray<ObLLVMType, 3> arg_types;
+  ObLLVMValue leaves_arg;
+  ObLLVMValue skip_arg;
+  ObLLVMValue size_arg;
+  ObLLVMBasicBlock entry_bb;
+  ObLLVMBasicBlock cond_bb;
+  ObLLVMBasicBlock body_bb;
+  ObLLVMBasicBlock eval_bb;
+  ObLLVMBasicBlock pass_bb;
+  ObLLVMBasicBlock fail_bb;
+  ObLLVMBasicBlock next_bb;
+  ObLLVMBasicBlock exit_bb;
+  ObLLVMValue idx_ptr;
+  ObLLVMValue cnt_ptr;
+  ObLLVMValue zero;
+  ObLLVMValue one;
+  ObLLVMValue idx;
+  ObLLVMValue word_ptr;
+  ObLLVMValue word;
+  ObLLVMValue bit;
+  // types
+  OZ (helper_.get_llvm_type(ObTinyIntType, int8_type));
+  OZ (int8_type.get_pointer_to(int8_ptr_type));
+  OZ (int8_ptr_type.get_pointer_to(int8_ptr_ptr_type));
+  OZ (helper_.get_llvm_type(ObInt32Type, int32_type));
+  OZ (int32_type.get_pointer_to(cg_ctx.int32_ptr_type_));
+  OZ (helper_.get_llvm_type(ObIntType, cg_ctx.int64_type_));
+  OZ (cg_ctx.int64_type_.get_pointer_to(cg_ctx.int64_ptr_type_));
+  OZ (cg_ctx.int64_ptr_type_.get_pointer_to(cg_ctx.int64_ptr_ptr_type_));
+  OZ (arg_types.push_back(int8_ptr_ptr_type));
+  OZ (arg_types.push_back(cg_ctx.int64_ptr_type_));
+  OZ (arg_types.push_back(cg_ctx.int64_type_));
+  OZ (ObLLVMFunctionType::get(cg_ctx.int64_type_, arg_types, func_type));
+  OZ (helper_.create_function(name, func_type, cg_ctx.func_));
+  OZ (cg_ctx.func_.get_argument(0, leaves_arg));
+  OZ (cg_ctx.func_.get_argument(1, skip_arg));
+  OZ (cg_ctx.func_.get_argument(2, size_arg));
+  OZ (helper_.create_block(ObString("entry"), cg_ctx.func_, entry_bb));
+  OZ (helper_.create_block(ObString("cond"), cg_ctx.func_, cond_bb));
+  OZ (helper_.create_block(ObString("body"), cg_ctx.func_, body_bb));
+  OZ (helper_.create_block(ObString("eval"), cg_ctx.func_, eval_bb));
+  OZ (helper_.create_block(ObString("pass"), cg_ctx.func_, pass_bb));
+  OZ (helper_.create_block(ObString("fail"), cg_ctx.func_, fail_bb));
+  OZ (helper_.create_block(ObString("next"), cg_ctx.func_, next_bb));
+  OZ (helper_.create_block(ObString("exit"), cg_ctx.func_, exit_bb));
+
+  // entry: init loop variables, locate leaves and load scalar leaves
+  OZ (helper_.set_insert_point(entry_bb));
+  OZ (helper_.get_int64(0, zero));
+  OZ (helper_.get_int64(1, one));
+  OZ (helper_.create_alloca(ObString("row_idx"), cg_ctx.int64_type_, idx_ptr));
+  OZ (helper_.create_store(zero, idx_ptr));
+  OZ (helper_.create_alloca(ObString("pass_cnt"), cg_ctx.int64_type_, cnt_ptr));
+  OZ (helper_.create_store(zero, cnt_ptr));
+  for (int64_t i = 0; OB_SUCC(ret) && i < leaves_.count(); i++) {
+    const bool is_batch = leaves_.at(i)->is_batch_result();
+    ObLLVMValue leaf_ptr;
+    ObLLVMValue datum_ptr;
+    ObLLVMValue datum_addr;
+    ObLLVMValue value;
+    OZ (helper_.create_const_gep1_64(ObString("leaf_ptr"), leaves_arg, i, leaf_ptr));
+    OZ (helper_.create_load(ObString("leaf_datum"), leaf_ptr, datum_ptr));
+    OZ (helper_.create_ptr_to_int(ObString("leaf_addr"), datum_ptr, cg_ctx.int64_type_,
+                                  datum_addr));
+    if (OB_SUCC(ret)) {
+      if (is_batch) {
+        value = datum_addr;
+      } else {
+        // scalar leaves are checked not null before calling the kernel.
+        ObLLVMValue value_ptr;
+        OZ (generate_load(datum_addr, cg_ctx.int64_ptr_ptr_type_, value_ptr));
+        OZ (helper_.create_load(ObString("scalar"), value_ptr, value));
+      }
+    }
+    OZ (cg_ctx.leaf_values_.push_back(value));
+    OZ (cg_ctx.leaf_is_batch_.push_back(is_batch));
+  }
+  OZ (helper_.create_br(cond_bb));
+
+  // cond: row_idx < batch_size
+  if (OB_SUCC(ret)) {
+    ObLLVMValue in_range;
+    OZ (helper_.set_insert_point(cond_bb));
+    OZ (helper_.create_load(ObString("idx"), idx_ptr, idx));
+    OZ (helper_.create_icmp(idx, size_arg, ObLLVMHelper::ICMP_SLT, in_range));
+    OZ (helper_.create_cond_br(in_range, body_bb, exit_bb));
+  }
+
+  // body: test the skip bit of the row
+  if (OB_SUCC(ret)) {
+    ObLLVMValue six;
+    ObLLVMValue three;
+    ObLLVMValue mask;
+    ObLLVMValue datum_shift;
+    ObLLVMValue word_idx;
+    ObLLVMValue word_offset;
+    ObLLVMValue skip_addr;
+    ObLLVMValue word_addr;
+    ObLLVMValue bit_idx;
+    ObLLVMValue skipped_bit;
+    ObLLVMValue is_skipped;
+    OZ (helper_.set_insert_point(body_bb));
+    OZ (helper_.get_int64(6, six));
+    OZ (helper_.get_int64(3, three));
+    OZ (helper_.get_int64(ObBitVector::WORD_BITS - 1, mask));
+    OZ (helper_.get_int64(DATUM_SIZE_SHIFT, datum_shift));
+    OZ (helper_.create_lshr(idx, six, word_idx));
+    OZ (helper_.create_shl(word_idx, three, word_offset));
+    OZ (helper_.create_ptr_to_int(ObString("skip_addr"), skip_arg, cg_ctx.int64_type_, skip_addr));
+    OZ (helper_.create_add(skip_addr, word_offset, word_addr));
+    OZ (helper_.create_int_to_ptr(ObString("word_ptr"), word_addr, cg_ctx.int64_ptr_type_,
+                                  word_ptr));
+    OZ (helper_.create_load(ObString("word"), word_ptr, word));
+    OZ (helper_.create_and(idx, mask, bit_idx));
+    OZ (helper_.create_shl(one, bit_idx, bit));
+    OZ (helper_.create_and(word, bit, skipped_bit));
+    OZ (helper_.create_icmp(skipped_bit, 0, ObLLVMHelper::ICMP_NE, is_skipped));
+    OZ (helper_.create_shl(idx, datum_shift, cg_ctx.datum_offset_));
+    OZ (helper_.create_cond_br(is_skipped, next_bb, eval_bb));
+  }
+
+  // eval: the filters are a conjunction
+  OZ (helper_.set_insert_point(eval_bb));
+  for (int64_t i = 0; OB_SUCC(ret) && i < filters.count(); i++) {
+    if (i == filters.count() - 1) {
+      OZ (generate_pred(cg_ctx, *filters.at(i), pass_bb, fail_bb));
+    } else {
+      ObLLVMBasicBlock and_next_bb;
+      OZ (helper_.create_block(ObString("filter_next"), cg_ctx.func_, and_next_bb));
+      OZ (generate_pred(cg_ctx, *filters.at(i), and_next_bb, fail_bb));
+      OZ (helper_.set_insert_point(and_next_bb));
+    }
+  }
+
+  // pass: ++pass_cnt
+  if (OB_SUCC(ret)) {
+    ObLLVMValue cnt;
+    ObLLVMValue new_cnt;
+    OZ (helper_.set_insert_point(pass_bb));
+    OZ (helper_.create_load(ObString("cnt"), cnt_ptr, cnt));
+    OZ (helper_.create_inc(cnt, new_cnt));
+    OZ (helper_.create_store(new_cnt, cnt_ptr));
+    OZ (helper_.create_br(next_bb));
+  }
+
+  // fail: set the skip bit
+  if (OB_SUCC(ret)) {
+    ObLLVMValue new_word;
+    OZ (helper_.set_insert_point(fail_bb));
+    OZ (helper_.create_or(word, bit, new_word));
+    OZ (helper_.create_store(new_word, word_ptr));
+    OZ (helper_.create_br(next_bb));
+  }
+
+  // next: ++row_idx
+  if (OB_SUCC(ret)) {
+    ObLLVMValue new_idx;
+    OZ (helper_.set_insert_point(next_bb));
+    OZ (helper_.create_inc(idx, new_idx));
+    OZ (helper_.create_store(new_idx, idx_ptr));
+    OZ (helper_.create_br(cond_bb));
+  }
+
+  // exit: return pass_cnt
+  if (OB_SUCC(ret)) {
+    ObLLVMValue cnt;
+    OZ (helper_.set_insert_point(exit_bb));
+    OZ (helper_.create_load(ObString("cnt"), cnt_ptr, cnt));
+    OZ (helper_.create_ret(cnt));
+  }
+  OZ (helper_.verify_function(cg_ctx.func_));
+  return ret;
+}
+
+int ObExprFilterJit::generate_pred(CodeGenCtx &cg_ctx,
+                                   const ObExpr &expr,
+                                   ObLLVMBasicBlock &true_bb,
+                                   ObLLVMBasicBlock &false_bb)
+{
+  int ret = OB_SUCCESS;
+  if (T_OP_AND == expr.type_ || T_OP_OR == expr.type_) {
+    const bool is_and = T_OP_AND == expr.type_;
+    for (int64_t i = 0; OB_SUCC(ret) && i < expr.arg_cnt_; i++) {
+      if (i == expr.arg_cnt_ - 1) {
+        OZ (generate_pred(cg_ctx, *expr.args_[i], true_bb, false_bb));
+      } else {
+        ObLLVMBasicBlock next_bb;
+        OZ (helper_.create_block(ObString(is_and ? "and_next" : "or_next"), cg_ctx.func_, next_bb));
+        if (is_and) {
+          OZ (generate_pred(cg_ctx, *expr.args_[i], next_bb, false_bb));
+        } else {
+          OZ (generate_pred(cg_ctx, *expr.args_[i], true_bb, next_bb));
+        }
+        OZ (helper_.set_insert_point(next_bb));
+      }
+    }
+  } else {
+    const bool is_unsigned = ObUIntTC == ob_obj_type_class(expr.args_[0]->datum_meta_.type_);
+    ObLLVMHelper::CMPTYPE cmp_type = ObLLVMHelper::ICMP_EQ;
+    ObLLVMValue left;
+    ObLLVMValue right;
+    ObLLVMValue result;
+    switch (expr.type_) {
+      case T_OP_EQ: cmp_type = ObLLVMHelper::ICMP_EQ; break;
+      case T_OP_NE: cmp_type = ObLLVMHelper::ICMP_NE; break;
+      case T_OP_LT: cmp_type = is_unsigned ? ObLLVMHelper::ICMP_ULT : ObLLVMHelper::ICMP_SLT; break;
+      case T_OP_LE: cmp_type = is_unsigned ? ObLLVMHelper::ICMP_ULE : ObLLVMHelper::ICMP_SLE; break;
+      case T_OP_GT: cmp_type = is_unsigned ? ObLLVMHelper::ICMP_UGT : ObLLVMHelper::ICMP_SGT; break;
+      case T_OP_GE: cmp_type = is_unsigned ? ObLLVMHelper::ICMP_UGE : ObLLVMHelper::ICMP_SGE; break;
+      default: {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("unexpected expr type", K(ret), K(expr.type_));
+        break;
+      }
+    }
+    OZ (generate_leaf_value(cg_ctx, *expr.args_[0], false_bb, left));
+    OZ (generate_leaf_value(cg_ctx, *expr.args_[1], false_bb, right));
+    OZ (helper_.create_icmp(left, right, cmp_type, result));
+    OZ (helper_.create_cond_br(result, true_bb, false_bb));
+  }
+  return ret;
+}
+
+int ObExprFilterJit::generate_leaf_value(CodeGenCtx &cg_ctx,
+                                         const ObExpr &leaf,
+                                         ObLLVMBasicBlock &null_bb,
+                                         ObLLVMValue &value)
+{
+  int ret = OB_SUCCESS;
+  const int64_t idx = get_leaf_idx(leaf);
+  if (OB_UNLIKELY(idx < 0 || idx >= cg_ctx.leaf_values_.count())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("leaf not found", K(ret), K(idx));
+  } else if (!cg_ctx.leaf_is_batch_.at(idx)) {
+    value = cg_ctx.leaf_values_.at(idx);
+  } else {
+    ObLLVMValue datum_addr;
+    ObLLVMValue pack_offset;
+    ObLLVMValue pack_addr;
+    ObLLVMValue pack;
+    ObLLVMValue is_null;
+    ObLLVMValue value_ptr;
+    ObLLVMBasicBlock not_null_bb;
+    OZ (helper_.create_add(cg_ctx.leaf_values_.at(idx), cg_ctx.datum_offset_, datum_addr));
+    OZ (helper_.get_int64(sizeof(ObDatumPtr), pack_offset));
+    OZ (helper_.create_add(datum_addr, pack_offset, pack_addr));
+    OZ (generate_load(pack_addr, cg_ctx.int32_ptr_type_, pack));
+    OZ (helper_.create_icmp(pack, 0, ObLLVMHelper::ICMP_SLT, is_null));
+    OZ (helper_.create_block(ObString("not_null"), cg_ctx.func_, not_null_bb));
+    OZ (helper_.create_cond_br(is_null, null_bb, not_null_bb));
+    OZ (helper_.set_insert_point(not_null_bb));
+    OZ (generate_load(datum_addr, cg_ctx.int64_ptr_ptr_type_, value_ptr));
+    OZ (helper_.create_load(ObString("leaf_value"), value_ptr, value));
+  }
+  return ret;
+}
+
+int ObExprFilterJit::filter_batch(ObEvalCtx &ctx,
+                                  ObBitVector &skip,
+                                  const int64_t batch_size,
+                                  bool &all_filtered,
+                                  bool &done) const
+{
+  int ret = OB_SUCCESS;
+  const char *leaf_datums[MAX_LEAF_CNT];
+  bool has_null_param = false;
+  all_filtered = false;
+  done = false;
+  if (OB_ISNULL(kernel_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("filter kernel not compiled", K(ret));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && !has_null_param && i < leaves_.count(); i++) {
+    const ObExpr *leaf = leaves_.at(i);
+    if (OB_FAIL(leaf->eval_batch(ctx, skip, batch_size))) {
+      LOG_WARN("evaluate batch failed", K(ret));
+    } else if (leaf->is_batch_result()) {
+      leaf_datums[i] = reinterpret_cast<const char *>(leaf->locate_batch_datums(ctx));
+    } else {
+      const ObDatum &datum = leaf->locate_expr_datum(ctx);
+      has_null_param = datum.is_null();
+      leaf_datums[i] = reinterpret_cast<const char *>(&datum);
+    }
+  }
+  if (OB_SUCC(ret) && !has_null_param) {
+    const int64_t output_rows = kernel_(leaf_datums, skip.data_, batch_size);
+    all_filtered = (0 == output_rows);
+    done = true;
+  }
+  return ret;
+}
+
+} // end namespace sql
+} // end namespace oceanbase
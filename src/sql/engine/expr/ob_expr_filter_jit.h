@@ -0,0 +1,106 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_EXPR_OB_EXPR_FILTER_JIT_H_
+#define OCEANBASE_EXPR_OB_EXPR_FILTER_JIT_H_
+
+#include "lib/allocator/page_arena.h"
+#include "lib/container/ob_se_array.h"
+#include "objit/ob_llvm_helper.h"
+#include "sql/engine/expr/ob_expr.h"
+
+namespace oceanbase
+{
+namespace sql
+{
+
+// Native batch kernel compiled from the filters of one operator.
+//
+// The filters are fused into a single loop over the batch. Supported trees are
+// AND/OR over comparisons (=, <>, <, <=, >, >=) between argument-less leaves
+// (column refs, parameters and constants) of fixed-width integer like types.
+// A filtered row is dropped on both NULL and FALSE, so the kernel only decides
+// whether the tree is TRUE and lowers it into branches: a NULL leaf jumps to
+// the false target of its comparison.
+//
+// Kernel signature:
+//   int64_t kernel(const char **leaf_datums, uint64_t *skip, int64_t batch_size)
+// %leaf_datums holds the datum (array) address of each leaf, rows not passed
+// are set in %skip and the count of passed rows is returned.
+class ObExprFilterJit
+{
+public:
+  typedef int64_t (*FilterKernel)(const char **, uint64_t *, int64_t);
+  const static int64_t MAX_LEAF_CNT = 64;
+  const static int64_t MAX_TREE_DEPTH = 16;
+
+  explicit ObExprFilterJit(const uint64_t tenant_id);
+  ~ObExprFilterJit();
+
+  static bool is_supported(const common::ObIArray<ObExpr *> &filters);
+  int compile(const common::ObIArray<ObExpr *> &filters, const uint64_t op_id);
+  // %done is false if the batch can not be handled by the kernel (NULL scalar
+  // parameter), the caller should evaluate the filters as usual then.
+  int filter_batch(ObEvalCtx &ctx,
+                   ObBitVector &skip,
+                   const int64_t batch_size,
+                   bool &all_filtered,
+                   bool &done) const;
+
+  TO_STRING_KV(KP_(kernel), "leaf_cnt", leaves_.count());
+
+private:
+  struct CodeGenCtx
+  {
+    CodeGenCtx() : leaf_values_(), leaf_is_batch_() {}
+    jit::ObLLVMFunction func_;
+    jit::ObLLVMType int32_ptr_type_;
+    jit::ObLLVMType int64_type_;
+    jit::ObLLVMType int64_ptr_type_;
+    jit::ObLLVMType int64_ptr_ptr_type_;
+    // current row, row_idx * sizeof(ObDatum)
+    jit::ObLLVMValue datum_offset_;
+    // address of the batch datums as int64 for batch leaves,
+    // loaded value for scalar leaves.
+    common::ObSEArray<jit::ObLLVMValue, 8> leaf_values_;
+    common::ObSEArray<bool, 8> leaf_is_batch_;
+  };
+
+  static bool is_supported_leaf(const ObExpr &expr);
+  static bool is_supported_cmp(const ObExpr &expr);
+  static bool is_supported_tree(const ObExpr &expr, const int64_t depth);
+  int collect_leaves(const ObExpr &expr);
+  int generate_kernel(const common::ObIArray<ObExpr *> &filters, const common::ObString &name);
+  int generate_pred(CodeGenCtx &cg_ctx,
+                    const ObExpr &expr,
+                    jit::ObLLVMBasicBlock &true_bb,
+                    jit::ObLLVMBasicBlock &false_bb);
+  int generate_leaf_value(CodeGenCtx &cg_ctx,
+                          const ObExpr &leaf,
+                          jit::ObLLVMBasicBlock &null_bb,
+                          jit::ObLLVMValue &value);
+  int generate_load(jit::ObLLVMValue &addr,
+                    jit::ObLLVMType &ptr_type,
+                    jit::ObLLVMValue &value);
+  int64_t get_leaf_idx(const ObExpr &leaf) const;
+
+private:
+  common::ObArenaAllocator allocator_;
+  jit::ObLLVMHelper helper_;
+  common::ObSEArray<const ObExpr *, 8> leaves_;
+  FilterKernel kernel_;
+  DISALLOW_COPY_AND_ASSIGN(ObExprFilterJit);
+};
+
+} // end namespace sql
+} // end namespace oceanbase
+#endif // OCEANBASE_EXPR_OB_EXPR_FILTER_JIT_H_
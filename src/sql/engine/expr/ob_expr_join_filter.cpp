@@ -123,7 +123,13 @@ int ObExprJoinFilter::eval_bloom_filter(const ObExpr &expr, ObEvalCtx &ctx,
             hash_val = hash_func.hash_func_(*datum, hash_val);
           }
         }
-        if (OB_SUCC(ret)) {
+        if (OB_FAIL(ret)) {
+        } else if (can_use_range_filter(expr, bloom_filter_ptr_->get_range_filter())
+                   && !datum->is_null()
+                   && !bloom_filter_ptr_->get_range_filter().might_contain(datum->get_int())) {
+          is_match = false;
+          join_filter_ctx->check_count_++;
+        } else {
           if (OB_FAIL(bloom_filter_ptr_->might_contain(hash_val, is_match))) {
             LOG_WARN("fail to check filter might contain value", K(ret), K(hash_val));
           } else {
@@ -211,13 +217,23 @@ int ObExprJoinFilter::eval_bloom_filter_batch(
             }
           }
         }
-        if (OB_FAIL(ObBitVector::flip_foreach(skip, batch_size,
+        const ObPxRangeInFilter &range_filter = bloom_filter_ptr_->get_range_filter();
+        const bool use_range_filter = OB_SUCC(ret) && can_use_range_filter(expr, range_filter);
+        const ObDatum *key_datums = use_range_filter ? expr.args_[0]->locate_batch_datums(ctx) : NULL;
+        const bool is_batch_key = use_range_filter && expr.args_[0]->is_batch_result();
+        if (OB_FAIL(ret)) {
+        } else if (OB_FAIL(ObBitVector::flip_foreach(skip, batch_size,
               [&](int64_t idx) __attribute__((always_inline)) {
                 bloom_filter_ptr_->prefetch_bits_block(hash_values[idx]); return OB_SUCCESS;
               }))) {
         } else if (OB_FAIL(ObBitVector::flip_foreach(skip, batch_size,
             [&](int64_t idx) __attribute__((always_inline)) {
-              ret = bloom_filter_ptr_->might_contain(hash_values[idx], is_match);
+              const ObDatum *key = use_range_filter ? &key_datums[is_batch_key ? idx : 0] : NULL;
+              if (NULL != key && !key->is_null() && !range_filter.might_contain(key->get_int())) {
+                is_match = false;
+              } else {
+                ret = bloom_filter_ptr_->might_contain(hash_values[idx], is_match);
+              }
               if (OB_SUCC(ret)) {
                 join_filter_ctx->filter_count_ += !is_match;
                 eval_flags.set(idx);
@@ -274,6 +290,54 @@ int ObExprJoinFilter::cg_expr(ObExprCGCtx &expr_cg_ctx, const ObRawExpr &raw_exp
   return ret;
 }
 
+int ObExprJoinFilter::get_ready_range_filter(const ObExpr &expr,
+                                             ObEvalCtx &ctx,
+                                             const ObPxRangeInFilter *&range_filter,
+                                             bool &is_ready)
+{
+  int ret = OB_SUCCESS;
+  range_filter = NULL;
+  is_ready = false;
+  ObExprJoinFilterContext *join_filter_ctx = NULL;
+  if (OB_ISNULL(join_filter_ctx = static_cast<ObExprJoinFilterContext *>(
+          ctx.exec_ctx_.get_expr_op_ctx(expr.expr_ctx_id_)))) {
+    // join filter ctx may be null in das.
+  } else {
+    ObPxBloomFilter *&bloom_filter_ptr_ = join_filter_ctx->bloom_filter_ptr_;
+    if (OB_ISNULL(bloom_filter_ptr_)) {
+      if (OB_FAIL(ObPxBloomFilterManager::instance().get_px_bloom_filter(join_filter_ctx->bf_key_,
+            bloom_filter_ptr_))) {
+        ret = OB_SUCCESS;
+      }
+    }
+    // called once per micro block, check the filter directly instead of
+    // sampling by n_times_ as check_bf_ready() does.
+    if (OB_ISNULL(bloom_filter_ptr_)) {
+    } else if (!join_filter_ctx->is_ready() && bloom_filter_ptr_->check_ready()) {
+      join_filter_ctx->ready_ts_ = ObTimeUtility::current_time();
+      join_filter_ctx->is_ready_ = true;
+    }
+    if (OB_NOT_NULL(bloom_filter_ptr_) && join_filter_ctx->is_ready()) {
+      is_ready = true;
+      if (can_use_range_filter(expr, bloom_filter_ptr_->get_range_filter())) {
+        range_filter = &bloom_filter_ptr_->get_range_filter();
+      }
+    }
+  }
+  return ret;
+}
+
+bool ObExprJoinFilter::can_use_range_filter(const ObExpr &expr,
+                                            const ObPxRangeInFilter &range_filter)
+{
+  bool can_use = false;
+  if (1 == expr.arg_cnt_ && range_filter.is_valid()) {
+    const ObObjTypeClass tc = ob_obj_type_class(expr.args_[0]->datum_meta_.type_);
+    can_use = range_filter.is_unsigned() ? ObUIntTC == tc : ObIntTC == tc;
+  }
+  return can_use;
+}
+
 int ObExprJoinFilter::check_bf_ready(
     ObExecContext &exec_ctx,
     ObExprJoinFilter::ObExprJoinFilterContext *join_filter_ctx)
@@ -76,6 +76,15 @@ public:
   virtual int cg_expr(ObExprCGCtx &expr_cg_ctx, const ObRawExpr &raw_expr,
                       ObExpr &rt_expr) const override;
   virtual bool need_rt_ctx() const override { return true; }
+  // Range and in-list of the join filter once it is ready, NULL before that or
+  // if they can not be applied to the single column argument of %expr, in which
+  // case %is_ready tells whether the join filter is ready at all.
+  // Used by the runtime white filter pushed down to the storage.
+  static int get_ready_range_filter(const ObExpr &expr,
+                                    ObEvalCtx &ctx,
+                                    const ObPxRangeInFilter *&range_filter,
+                                    bool &is_ready);
+  static bool can_use_range_filter(const ObExpr &expr, const ObPxRangeInFilter &range_filter);
   // hard code seed, 32 bit max prime number
   static const int64_t JOIN_FILTER_SEED = 4294967279;
 private:
@@ -97,6 +97,7 @@ int ObExprLength::cg_expr(ObExprCGCtx &op_cg_ctx, const ObRawExpr &raw_expr, ObE
         CK(ObVarcharType == text_type);
       }
       rt_expr.eval_func_ = ObExprLength::calc_mysql_mode;
+      rt_expr.eval_batch_func_ = ObExprLength::calc_mysql_mode_batch;
     }
   }
   return ret;
@@ -161,5 +162,43 @@ int ObExprLength::calc_mysql_mode(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &e
   return ret;
 }
 
+int ObExprLength::calc_mysql_mode_batch(const ObExpr &expr, ObEvalCtx &ctx,
+                                        const ObBitVector &skip, const int64_t batch_size)
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(expr.args_[0]->eval_batch(ctx, skip, batch_size))) {
+    LOG_WARN("eval param batch failed", K(ret));
+  } else {
+    ObDatum *res_datums = expr.locate_batch_datums(ctx);
+    ObDatumVector text_datums = expr.args_[0]->locate_expr_datumvector(ctx);
+    ObBitVector &eval_flags = expr.get_evaluated_flags(ctx);
+    const bool is_lob = is_lob_storage(expr.args_[0]->datum_meta_.type_);
+    const bool has_lob_header = expr.args_[0]->obj_meta_.has_lob_header();
+    for (int64_t i = 0; OB_SUCC(ret) && i < batch_size; ++i) {
+      if (skip.at(i) || eval_flags.at(i)) {
+        continue;
+      }
+      const ObDatum *text_datum = text_datums.at(i);
+      if (text_datum->is_null()) {
+        res_datums[i].set_null();
+      } else if (!is_lob) {
+        res_datums[i].set_int(static_cast<int64_t>(text_datum->len_));
+      } else {
+        ObLobLocatorV2 locator(text_datum->get_string(), has_lob_header);
+        int64_t lob_data_byte_len = 0;
+        if (OB_FAIL(locator.get_lob_data_byte_len(lob_data_byte_len))) {
+          LOG_WARN("get lob data byte length failed", K(ret), K(locator));
+        } else {
+          res_datums[i].set_int(static_cast<int64_t>(lob_data_byte_len));
+        }
+      }
+      if (OB_SUCC(ret)) {
+        eval_flags.set(i);
+      }
+    }
+  }
+  return ret;
+}
+
 }
 }
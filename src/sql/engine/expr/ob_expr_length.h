@@ -33,6 +33,8 @@ public:
   static int calc_null(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &expr_datum);
   static int calc_oracle_mode(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &expr_datum);
   static int calc_mysql_mode(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &expr_datum);
+  static int calc_mysql_mode_batch(const ObExpr &expr, ObEvalCtx &ctx,
+                                   const ObBitVector &skip, const int64_t batch_size);
 private:
   DISALLOW_COPY_AND_ASSIGN(ObExprLength);
 };
@@ -320,6 +320,9 @@ int ObExprLower::cg_expr(ObExprCGCtx &op_cg_ctx,
     LOG_WARN("lower expr cg expr failed", K(ret));
   } else {
     rt_expr.eval_func_ = ObExprLower::calc_lower;
+    if (!ob_is_text_tc(rt_expr.args_[0]->datum_meta_.type_)) {
+      rt_expr.eval_batch_func_ = ObExprLower::calc_lower_batch;
+    }
   }
   return ret;
 }
@@ -333,6 +336,9 @@ int ObExprUpper::cg_expr(ObExprCGCtx &op_cg_ctx,
     LOG_WARN("upper expr cg expr failed", K(ret));
   } else {
     rt_expr.eval_func_ = ObExprUpper::calc_upper;
+    if (!ob_is_text_tc(rt_expr.args_[0]->datum_meta_.type_)) {
+      rt_expr.eval_batch_func_ = ObExprUpper::calc_upper_batch;
+    }
   }
   return ret;
 }
@@ -452,6 +458,52 @@ int ObExprLowerUpper::calc_common(const ObExpr &expr, ObEvalCtx &ctx,
   return ret;
 }
 
+int ObExprLowerUpper::calc_common_batch(const ObExpr &expr, ObEvalCtx &ctx,
+                                        const ObBitVector &skip, const int64_t batch_size,
+                                        bool lower)
+{
+  int ret = OB_SUCCESS;
+  const ObCollationType cs_type = expr.datum_meta_.cs_type_;
+  if (OB_FAIL(expr.args_[0]->eval_batch(ctx, skip, batch_size))) {
+    LOG_WARN("eval param batch failed", K(ret));
+  } else if (OB_UNLIKELY(!ObCharset::is_valid_collation(cs_type))) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("charset is null", K(ret), K(cs_type));
+  } else {
+    ObDatum *res_datums = expr.locate_batch_datums(ctx);
+    ObDatumVector text_datums = expr.args_[0]->locate_expr_datumvector(ctx);
+    ObBitVector &eval_flags = expr.get_evaluated_flags(ctx);
+    const uchar multiply = lower ? ObCharset::get_charset(cs_type)->casedn_multiply
+                                 : ObCharset::get_charset(cs_type)->caseup_multiply;
+    for (int64_t i = 0; OB_SUCC(ret) && i < batch_size; ++i) {
+      if (skip.at(i) || eval_flags.at(i)) {
+        continue;
+      }
+      const ObDatum *text_datum = text_datums.at(i);
+      if (text_datum->is_null()) {
+        res_datums[i].set_null();
+      } else if (0 == text_datum->len_) {
+        res_datums[i].set_string(ObString());
+      } else {
+        const ObString m_text = text_datum->get_string();
+        const int32_t buf_len = m_text.length() * multiply;
+        char *buf = expr.get_str_res_mem(ctx, buf_len, i);
+        if (OB_ISNULL(buf)) {
+          ret = OB_ALLOCATE_MEMORY_FAILED;
+          LOG_ERROR("alloc memory failed", "size", buf_len);
+        } else {
+          const int32_t out_len = calc_common_inner(buf, buf_len, m_text, cs_type, lower);
+          res_datums[i].set_string(buf, out_len);
+        }
+      }
+      if (OB_SUCC(ret)) {
+        eval_flags.set(i);
+      }
+    }
+  }
+  return ret;
+}
+
 int ObExprLowerUpper::calc_nls_common(const ObExpr &expr, ObEvalCtx &ctx,
                                       ObDatum &expr_datum, bool lower)
 {
@@ -520,6 +572,18 @@ int ObExprUpper::calc_upper(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &expr_da
   return calc_common(expr, ctx, expr_datum, false, CS_TYPE_INVALID);
 }
 
+int ObExprLower::calc_lower_batch(const ObExpr &expr, ObEvalCtx &ctx,
+                                  const ObBitVector &skip, const int64_t batch_size)
+{
+  return calc_common_batch(expr, ctx, skip, batch_size, true);
+}
+
+int ObExprUpper::calc_upper_batch(const ObExpr &expr, ObEvalCtx &ctx,
+                                  const ObBitVector &skip, const int64_t batch_size)
+{
+  return calc_common_batch(expr, ctx, skip, batch_size, false);
+}
+
 int ObExprNlsLower::calc(const ObCollationType cs_type, char *src, int32_t src_len,
                          char *dst, int32_t dst_len, int32_t &out_len) const
 {
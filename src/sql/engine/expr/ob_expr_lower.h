@@ -38,6 +38,10 @@ public:
                          ObDatum &expr_datum, bool lower, common::ObCollationType cs_type);
   static int calc_nls_common(const ObExpr &expr, ObEvalCtx &ctx,
                              ObDatum &expr_datum, bool lower);
+  // batch version of calc_common, only for non text tc
+  static int calc_common_batch(const ObExpr &expr, ObEvalCtx &ctx,
+                               const ObBitVector &skip, const int64_t batch_size,
+                               bool lower);
   int cg_expr_common(ObExprCGCtx &op_cg_ctx, const ObRawExpr &raw_expr, ObExpr &rt_expr) const;
   int cg_expr_nls_common(ObExprCGCtx &op_cg_ctx,
                          const ObRawExpr &raw_expr,
@@ -66,6 +70,8 @@ public:
                       const ObRawExpr &raw_expr,
                       ObExpr &rt_expr) const override;
   static int calc_lower(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &expr_datum);
+  static int calc_lower_batch(const ObExpr &expr, ObEvalCtx &ctx,
+                              const ObBitVector &skip, const int64_t batch_size);
 private:
   DISALLOW_COPY_AND_ASSIGN(ObExprLower);
 };
@@ -82,6 +88,8 @@ public:
                       const ObRawExpr &raw_expr,
                       ObExpr &rt_expr) const override;
   static int calc_upper(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &expr_datum);
+  static int calc_upper_batch(const ObExpr &expr, ObEvalCtx &ctx,
+                              const ObBitVector &skip, const int64_t batch_size);
 private:
   DISALLOW_COPY_AND_ASSIGN(ObExprUpper);
 };
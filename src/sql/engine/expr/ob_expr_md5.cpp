@@ -110,6 +110,7 @@ int ObExprMd5::cg_expr(ObExprCGCtx &op_cg_ctx, const ObRawExpr &raw_expr, ObExpr
   } else {
     CK(ObVarcharType == rt_expr.args_[0]->datum_meta_.type_);
     rt_expr.eval_func_ = ObExprMd5::calc_md5;
+    rt_expr.eval_batch_func_ = ObExprMd5::calc_md5_batch;
   }
   return ret;
 }
@@ -164,6 +165,53 @@ int ObExprMd5::calc_md5(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &expr_datum)
   return ret;
 }
 
+int ObExprMd5::calc_md5_batch(const ObExpr &expr, ObEvalCtx &ctx,
+                              const ObBitVector &skip, const int64_t batch_size)
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(expr.args_[0]->eval_batch(ctx, skip, batch_size))) {
+    LOG_WARN("eval param batch failed", K(ret));
+  } else {
+    ObDatum *res_datums = expr.locate_batch_datums(ctx);
+    ObDatumVector param_datums = expr.args_[0]->locate_expr_datumvector(ctx);
+    ObBitVector &eval_flags = expr.get_evaluated_flags(ctx);
+    const ObString::obstr_size_t md5_hex_res_len = MD5_LENGTH * 2 + 1;
+    unsigned char md5_raw_res_buf[MD5_LENGTH];
+    for (int64_t i = 0; OB_SUCC(ret) && i < batch_size; ++i) {
+      if (skip.at(i) || eval_flags.at(i)) {
+        continue;
+      }
+      const ObDatum *param_datum = param_datums.at(i);
+      char *md5_hex_res_buf = NULL;
+      if (param_datum->is_null()) {
+        res_datums[i].set_null();
+      } else if (OB_ISNULL(md5_hex_res_buf = expr.get_str_res_mem(ctx, md5_hex_res_len, i))) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_ERROR("alloc memory failed", K(ret), K(md5_hex_res_len));
+      } else {
+        MD5(reinterpret_cast<const unsigned char *>(param_datum->ptr_), param_datum->len_,
+            md5_raw_res_buf);
+        if (OB_FAIL(to_hex_cstr(md5_raw_res_buf, MD5_LENGTH,
+                                md5_hex_res_buf, md5_hex_res_len))) {
+          LOG_WARN("to hex cstr error", K(ret));
+        } else {
+          size_t tmp_len = ObCharset::casedn(CS_TYPE_UTF8MB4_BIN,
+                                             md5_hex_res_buf,
+                                             md5_hex_res_len,
+                                             md5_hex_res_buf,
+                                             md5_hex_res_len);
+          // do not contain \0 in the result
+          res_datums[i].set_string(md5_hex_res_buf, static_cast<int64_t>(tmp_len) - 1);
+        }
+      }
+      if (OB_SUCC(ret)) {
+        eval_flags.set(i);
+      }
+    }
+  }
+  return ret;
+}
+
 }
 }
 
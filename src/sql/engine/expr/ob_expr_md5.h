@@ -34,6 +34,8 @@ public:
                       const ObRawExpr &raw_expr,
                       ObExpr &rt_expr) const override;
   static int calc_md5(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &expr_datum);
+  static int calc_md5_batch(const ObExpr &expr, ObEvalCtx &ctx,
+                            const ObBitVector &skip, const int64_t batch_size);
 private:
   int calc_md5(common::ObObj &result,
                const common::ObString &str,
@@ -196,6 +196,7 @@ int ObExprRegexp::eval_regexp(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &expr_
       int64_t start_pos = 1;
       bool is_case_sensitive = ObCharset::is_bin_sort(expr.args_[0]->datum_meta_.cs_type_);
       ObString text_utf16;
+      bool done = false;
       if (OB_FAIL(ObExprRegexContext::get_regexp_flags(match_string, is_case_sensitive, flags))) {
         LOG_WARN("failed to get regexp flags", K(ret));
       } else if (OB_FAIL(regex_ctx->init(reusable ? ctx.exec_ctx_.get_allocator() : tmp_alloc,
@@ -204,7 +205,9 @@ int ObExprRegexp::eval_regexp(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &expr_
         LOG_WARN("init regex context failed", K(ret), K(pattern->get_string()));
       } else if (expr.args_[0]->datum_meta_.cs_type_ == CS_TYPE_UTF8MB4_BIN ||
                  expr.args_[0]->datum_meta_.cs_type_ == CS_TYPE_UTF8MB4_GENERAL_CI) {
-        if (OB_FAIL(ObExprUtil::convert_string_collation(text->get_string(),
+        regex_ctx->fast_match(text->get_string(), match, done);
+        if (done) {
+        } else if (OB_FAIL(ObExprUtil::convert_string_collation(text->get_string(),
                                                          expr.args_[0]->datum_meta_.cs_type_,
                                                          text_utf16,
                                                          is_case_sensitive ? CS_TYPE_UTF16_BIN : CS_TYPE_UTF16_GENERAL_CI,
@@ -214,10 +217,11 @@ int ObExprRegexp::eval_regexp(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &expr_
       } else {
         text_utf16 = text->get_string();
       }
-      if (OB_FAIL(ret)) {
+      if (OB_FAIL(ret) || done) {
       } else if (OB_FAIL(regex_ctx->match(tmp_alloc, text_utf16, start_pos - 1, match))) {
         LOG_WARN("regex match failed", K(ret));
-      } else {
+      }
+      if (OB_SUCC(ret)) {
         expr_datum.set_int32(match);
       }
     }
@@ -18,6 +18,7 @@
 #include "lib/allocator/ob_malloc.h"
 #include "lib/charset/ob_charset.h"
 #include "sql/engine/expr/ob_expr_regexp_context.h"
+#include "share/config/ob_server_config.h"
 #include "sql/engine/expr/ob_expr_util.h"
 #include "sql/session/ob_sql_session_info.h"
 namespace oceanbase
@@ -53,6 +54,7 @@ void ObExprRegexContext::destroy()
       uregex_close(regexp_engine_);
       regexp_engine_ = NULL;
     }
+    fast_matcher_.reset();
   }
 }
 
@@ -156,6 +158,14 @@ int ObExprRegexContext::init(ObExprStringBuf &string_buf,
         inited_ = true;
       }
     }
+    // the ".{0}" substitution above is kept on the ICU path.
+    if (OB_SUCC(ret) && reusable && GCONF._enable_regexp_fast_path
+        && lib::is_mysql_mode() && origin_pattern.length() >= 2
+        && (CS_TYPE_UTF8MB4_BIN == pattern_cs_type
+            || CS_TYPE_UTF8MB4_GENERAL_CI == pattern_cs_type)
+        && OB_FAIL(fast_matcher_.init(string_buf, origin_pattern, cflags))) {
+      LOG_WARN("init regexp fast matcher failed", K(ret));
+    }
   }
   return ret;
 }
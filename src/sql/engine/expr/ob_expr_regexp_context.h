@@ -21,6 +21,7 @@
 #include "lib/charset/ob_charset.h"
 #include <icu/i18n/unicode/uregex.h>
 #include "sql/engine/expr/ob_expr_operator.h"
+#include "sql/engine/expr/ob_expr_regexp_fast_matcher.h"
 
 // this regex is compatible with mysql 8.0
 
@@ -54,6 +55,16 @@ public:
             const int64_t start,
             bool &result) const;
 
+  // Match the utf8mb4 %text from the beginning without ICU, %done is false if
+  // the fast matcher can not decide and match() should be used.
+  inline void fast_match(const ObString &text, bool &result, bool &done) const
+  {
+    done = false;
+    if (fast_matcher_.is_valid()) {
+      fast_matcher_.match(text, result, done);
+    }
+  }
+
   int find(ObExprStringBuf &string_buf,
            const ObString &text,
            const int64_t start,
@@ -126,6 +137,8 @@ private:
   int cflags_;
   ObInplaceAllocator pattern_wc_allocator_;
   URegularExpression *regexp_engine_;
+  // only built for the reusable utf8mb4 patterns in mysql mode.
+  ObExprRegexFastMatcher fast_matcher_;
 };
 }
 }
@@ -0,0 +1,1215 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_ENG
+#include "sql/engine/expr/ob_expr_regexp_fast_matcher.h"
+#include <icu/i18n/unicode/uregex.h>
+#if defined(__x86_64__)
+#include <emmintrin.h>
+#endif
+#include "lib/hash_func/murmur_hash.h"
+#include "lib/oblog/ob_log.h"
+#include "common/ob_smart_call.h"
+#include "share/ob_define.h"
+
+namespace oceanbase
+{
+using namespace common;
+namespace sql
+{
+
+// UTF-8 sequences of the multi-byte characters, the text is validated before
+// matching so the continuation ranges need not be exact.
+static const uint8_t MB_ANY_SEQS[][4][2] = {
+  {{0xC2, 0xDF}, {0x80, 0xBF}},
+  {{0xE0, 0xEF}, {0x80, 0xBF}, {0x80, 0xBF}},
+  {{0xF0, 0xF4}, {0x80, 0xBF}, {0x80, 0xBF}, {0x80, 0xBF}},
+};
+static const int64_t MB_ANY_SEQ_LENS[] = { 2, 3, 4 };
+
+// same as MB_ANY_SEQS but U+0085 (C2 85), U+2028 (E2 80 A8) and U+2029 (E2 80 A9).
+static const uint8_t MB_DOT_SEQS[][4][2] = {
+  {{0xC2, 0xC2}, {0x80, 0x84}},
+  {{0xC2, 0xC2}, {0x86, 0xBF}},
+  {{0xC3, 0xDF}, {0x80, 0xBF}},
+  {{0xE0, 0xE1}, {0x80, 0xBF}, {0x80, 0xBF}},
+  {{0xE2, 0xE2}, {0x80, 0x80}, {0x80, 0xA7}},
+  {{0xE2, 0xE2}, {0x80, 0x80}, {0xAA, 0xBF}},
+  {{0xE2, 0xE2}, {0x81, 0xBF}, {0x80, 0xBF}},
+  {{0xE3, 0xEF}, {0x80, 0xBF}, {0x80, 0xBF}},
+  {{0xF0, 0xF4}, {0x80, 0xBF}, {0x80, 0xBF}, {0x80, 0xBF}},
+};
+static const int64_t MB_DOT_SEQ_LENS[] = { 2, 2, 2, 3, 3, 3, 3, 3, 4 };
+
+static const int64_t MAX_PARSE_DEPTH = 32;
+static const int32_t MAX_REPEAT_BOUND = 1000;
+
+static inline bool is_ascii_alpha(const uint8_t c)
+{
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+static inline bool is_ascii_alnum(const uint8_t c)
+{
+  return is_ascii_alpha(c) || (c >= '0' && c <= '9');
+}
+
+static inline bool is_quantifier(const char c)
+{
+  return '*' == c || '+' == c || '?' == c || '{' == c;
+}
+
+// control characters escaped by a letter: \t \n \r \f \a \e
+static inline int32_t get_escaped_control(const char c)
+{
+  int32_t value = -1;
+  switch (c) {
+    case 't': value = '\t'; break;
+    case 'n': value = '\n'; break;
+    case 'r': value = '\r'; break;
+    case 'f': value = '\f'; break;
+    case 'a': value = 0x07; break;
+    case 'e': value = 0x1B; break;
+    default: break;
+  }
+  return value;
+}
+
+static inline void set_ascii_bit(uint64_t *bits, const uint8_t c)
+{
+  bits[c / 64] |= (1ULL << (c % 64));
+}
+
+static inline bool test_ascii_bit(const uint64_t *bits, const uint8_t c)
+{
+  return 0 != (bits[c / 64] & (1ULL << (c % 64)));
+}
+
+int ObExprRegexFastMatcher::Parser::parse(int32_t &root)
+{
+  int ret = OB_SUCCESS;
+  root = -1;
+  if (pos_ < len_ && '^' == ptr_[pos_]) {
+    anchored_start_ = true;
+    ++pos_;
+  }
+  if (OB_FAIL(parse_alter(0, root))) {
+    LOG_WARN("parse pattern failed", K(ret));
+  } else if (!supported_) {
+  } else if (pos_ != len_) {
+    // unbalanced ')'
+    unsupported();
+  } else if ((anchored_start_ || anchored_end_)
+             && (NODE_ALTER == nodes_.at(root).type_ || 0 != (flags_ & UREGEX_MULTILINE))) {
+    // the anchor binds the first or last alternative only, or matches at every line.
+    unsupported();
+  }
+  return ret;
+}
+
+int ObExprRegexFastMatcher::Parser::parse_alter(const int64_t depth, int32_t &node)
+{
+  int ret = OB_SUCCESS;
+  int32_t child = -1;
+  node = -1;
+  if (depth > MAX_PARSE_DEPTH) {
+    unsupported();
+  } else if (OB_FAIL(parse_concat(depth, child))) {
+    LOG_WARN("parse concat failed", K(ret));
+  } else if (!supported_ || pos_ >= len_ || '|' != ptr_[pos_]) {
+    node = child;
+  } else if (OB_FAIL(new_node(NODE_ALTER, node))) {
+    LOG_WARN("new node failed", K(ret));
+  } else if (OB_FAIL(add_child(node, child))) {
+    LOG_WARN("add child failed", K(ret));
+  } else {
+    while (OB_SUCC(ret) && supported_ && pos_ < len_ && '|' == ptr_[pos_]) {
+      ++pos_;
+      if (OB_FAIL(parse_concat(depth, child))) {
+        LOG_WARN("parse concat failed", K(ret));
+      } else if (supported_ && OB_FAIL(add_child(node, child))) {
+        LOG_WARN("add child failed", K(ret));
+      }
+    }
+  }
+  return ret;
+}
+
+int ObExprRegexFastMatcher::Parser::parse_concat(const int64_t depth, int32_t &node)
+{
+  int ret = OB_SUCCESS;
+  node = -1;
+  if (OB_FAIL(new_node(NODE_CONCAT, node))) {
+    LOG_WARN("new node failed", K(ret));
+  }
+  while (OB_SUCC(ret) && supported_ && pos_ < len_ && '|' != ptr_[pos_] && ')' != ptr_[pos_]) {
+    int32_t atom = -1;
+    bool quantifiable = true;
+    if (OB_FAIL(parse_atom(depth, atom, quantifiable))) {
+      LOG_WARN("parse atom failed", K(ret));
+    } else if (!supported_) {
+    } else if (pos_ < len_ && is_quantifier(ptr_[pos_])) {
+      if (!quantifiable) {
+        unsupported();
+      } else if (OB_FAIL(parse_quantifier(atom))) {
+        LOG_WARN("parse quantifier failed", K(ret));
+      }
+    }
+    if (OB_SUCC(ret) && supported_ && OB_FAIL(add_child(node, atom))) {
+      LOG_WARN("add child failed", K(ret));
+    }
+  }
+  return ret;
+}
+
+int ObExprRegexFastMatcher::Parser::parse_atom(const int64_t depth,
+                                               int32_t &node,
+                                               bool &quantifiable)
+{
+  int ret = OB_SUCCESS;
+  const uint8_t c = static_cast<uint8_t>(ptr_[pos_]);
+  quantifiable = true;
+  node = -1;
+  switch (c) {
+    case '(': {
+      ++pos_;
+      if (pos_ < len_ && '?' == ptr_[pos_]) {
+        // only the non-capturing group, no look around, flags or named groups.
+        if (pos_ + 1 < len_ && ':' == ptr_[pos_ + 1]) {
+          pos_ += 2;
+        } else {
+          unsupported();
+        }
+      }
+      if (!supported_) {
+      } else if (OB_FAIL(parse_alter(depth + 1, node))) {
+        LOG_WARN("parse group failed", K(ret));
+      } else if (!supported_) {
+      } else if (pos_ < len_ && ')' == ptr_[pos_]) {
+        ++pos_;
+      } else {
+        unsupported();
+      }
+      break;
+    }
+    case '[': {
+      if (OB_FAIL(parse_class(node))) {
+        LOG_WARN("parse class failed", K(ret));
+      }
+      break;
+    }
+    case '.': {
+      ++pos_;
+      if (OB_FAIL(new_node(NODE_CHARSET, node))) {
+        LOG_WARN("new node failed", K(ret));
+      } else {
+        Node &dot = nodes_.at(node);
+        dot.ascii_[0] = UINT64_MAX;
+        dot.ascii_[1] = UINT64_MAX;
+        dot.mb_set_ = MB_ANY;
+        if (0 != (flags_ & UREGEX_DOTALL)) {
+          has_dotall_ = true;
+        } else {
+          dot.ascii_[0] &= ~(1ULL << '\n');
+          if (0 == (flags_ & UREGEX_UNIX_LINES)) {
+            dot.ascii_[0] &= ~((1ULL << 0x0B) | (1ULL << 0x0C) | (1ULL << '\r'));
+            dot.mb_set_ = MB_DOT;
+          }
+        }
+      }
+      break;
+    }
+    case '\\': {
+      if (OB_FAIL(parse_escape(node))) {
+        LOG_WARN("parse escape failed", K(ret));
+      }
+      break;
+    }
+    case '$': {
+      if (0 == depth && pos_ + 1 == len_) {
+        ++pos_;
+        anchored_end_ = true;
+        quantifiable = false;
+        if (OB_FAIL(new_node(NODE_EMPTY, node))) {
+          LOG_WARN("new node failed", K(ret));
+        }
+      } else {
+        unsupported();
+      }
+      break;
+    }
+    case '^':
+    case '*':
+    case '+':
+    case '?':
+    case '{':
+    case '}':
+    case ']': {
+      unsupported();
+      break;
+    }
+    default: {
+      if (c < 0x80) {
+        ++pos_;
+        if (OB_FAIL(new_ascii_literal(c, node))) {
+          LOG_WARN("new literal failed", K(ret));
+        }
+      } else {
+        const int64_t char_len = (c >= 0xC2 && c <= 0xDF) ? 2
+            : ((c >= 0xE0 && c <= 0xEF) ? 3 : ((c >= 0xF0 && c <= 0xF4) ? 4 : 0));
+        bool valid = char_len > 0 && pos_ + char_len <= len_
+            && 0 == (flags_ & UREGEX_CASE_INSENSITIVE);
+        for (int64_t i = 1; valid && i < char_len; ++i) {
+          valid = (static_cast<uint8_t>(ptr_[pos_ + i]) & 0xC0) == 0x80;
+        }
+        if (!valid) {
+          unsupported();
+        } else if (OB_FAIL(new_node(NODE_LITERAL, node))) {
+          LOG_WARN("new node failed", K(ret));
+        } else {
+          Node &lit = nodes_.at(node);
+          lit.lit_len_ = static_cast<uint8_t>(char_len);
+          MEMCPY(lit.lit_, ptr_ + pos_, char_len);
+          pos_ += char_len;
+        }
+      }
+      break;
+    }
+  }
+  return ret;
+}
+
+int ObExprRegexFastMatcher::Parser::parse_quantifier(int32_t &node)
+{
+  int ret = OB_SUCCESS;
+  int32_t min = 0;
+  int32_t max = -1;
+  const char c = ptr_[pos_++];
+  if ('+' == c) {
+    min = 1;
+  } else if ('?' == c) {
+    max = 1;
+  } else if ('{' == c) {
+    if (OB_FAIL(parse_bound(min))) {
+      LOG_WARN("parse bound failed", K(ret));
+    } else if (!supported_ || pos_ >= len_) {
+      unsupported();
+    } else if (',' == ptr_[pos_]) {
+      ++pos_;
+      if (pos_ < len_ && '}' != ptr_[pos_] && OB_FAIL(parse_bound(max))) {
+        LOG_WARN("parse bound failed", K(ret));
+      }
+    } else {
+      max = min;
+    }
+    if (OB_FAIL(ret) || !supported_) {
+    } else if (pos_ < len_ && '}' == ptr_[pos_] && (max < 0 || max >= min)) {
+      ++pos_;
+    } else {
+      unsupported();
+    }
+  }
+  if (OB_SUCC(ret) && supported_ && pos_ < len_) {
+    if ('?' == ptr_[pos_]) {
+      // lazy quantifier, makes no difference for a boolean match.
+      ++pos_;
+    } else if ('+' == ptr_[pos_]) {
+      // possessive quantifier may reject texts the greedy one accepts.
+      unsupported();
+    }
+  }
+  if (OB_SUCC(ret) && supported_ && pos_ < len_ && is_quantifier(ptr_[pos_])) {
+    unsupported();
+  }
+  if (OB_SUCC(ret) && supported_) {
+    int32_t repeat = -1;
+    if (OB_FAIL(new_node(NODE_REPEAT, repeat))) {
+      LOG_WARN("new node failed", K(ret));
+    } else if (OB_FAIL(add_child(repeat, node))) {
+      LOG_WARN("add child failed", K(ret));
+    } else {
+      nodes_.at(repeat).min_ = min;
+      nodes_.at(repeat).max_ = max;
+      node = repeat;
+    }
+  }
+  return ret;
+}
+
+int ObExprRegexFastMatcher::Parser::parse_bound(int32_t &value)
+{
+  int ret = OB_SUCCESS;
+  const int64_t begin = pos_;
+  value = 0;
+  while (supported_ && pos_ < len_ && ptr_[pos_] >= '0' && ptr_[pos_] <= '9') {
+    value = value * 10 + (ptr_[pos_] - '0');
+    if (value > MAX_REPEAT_BOUND) {
+      unsupported();
+    }
+    ++pos_;
+  }
+  if (begin == pos_) {
+    unsupported();
+  }
+  return ret;
+}
+
+int ObExprRegexFastMatcher::Parser::parse_class(int32_t &node)
+{
+  int ret = OB_SUCCESS;
+  uint64_t bits[2] = {0, 0};
+  bool negated = false;
+  bool opaque = false;
+  ++pos_;
+  if (pos_ < len_ && '^' == ptr_[pos_]) {
+    negated = true;
+    ++pos_;
+  }
+  if (pos_ < len_ && ']' == ptr_[pos_]) {
+    unsupported();
+  }
+  while (OB_SUCC(ret) && supported_ && pos_ < len_ && ']' != ptr_[pos_]) {
+    int32_t lo = -1;
+    int32_t hi = -1;
+    if (OB_FAIL(parse_class_char(lo))) {
+      LOG_WARN("parse class char failed", K(ret));
+    } else if (!supported_) {
+    } else if (lo < 0) {
+      opaque = true;
+    } else if (pos_ + 1 < len_ && '-' == ptr_[pos_] && ']' != ptr_[pos_ + 1]) {
+      ++pos_;
+      if (OB_FAIL(parse_class_char(hi))) {
+        LOG_WARN("parse class char failed", K(ret));
+      } else if (supported_ && (hi < lo)) {
+        unsupported();
+      }
+    } else {
+      hi = lo;
+    }
+    for (int32_t c = lo; OB_SUCC(ret) && supported_ && c >= 0 && c <= hi; ++c) {
+      if (!is_case_sensitive_safe(static_cast<uint8_t>(c))) {
+        unsupported();
+      } else {
+        set_ascii_bit(bits, static_cast<uint8_t>(c));
+      }
+    }
+  }
+  if (OB_FAIL(ret) || !supported_) {
+  } else if (pos_ >= len_) {
+    unsupported();
+  } else {
+    ++pos_;
+    if (opaque) {
+      has_opaque_ = true;
+      if (OB_FAIL(new_node(NODE_OPAQUE, node))) {
+        LOG_WARN("new node failed", K(ret));
+      }
+    } else if (OB_FAIL(new_node(NODE_CHARSET, node))) {
+      LOG_WARN("new node failed", K(ret));
+    } else {
+      Node &set = nodes_.at(node);
+      set.ascii_[0] = negated ? ~bits[0] : bits[0];
+      set.ascii_[1] = negated ? ~bits[1] : bits[1];
+      set.mb_set_ = negated ? MB_ANY : MB_NONE;
+    }
+  }
+  return ret;
+}
+
+int ObExprRegexFastMatcher::Parser::parse_class_char(int32_t &value)
+{
+  int ret = OB_SUCCESS;
+  const uint8_t c = static_cast<uint8_t>(ptr_[pos_]);
+  value = -1;
+  if (c >= 0x80 || '[' == c
+      || (('&' == c || '-' == c) && pos_ + 1 < len_ && c == ptr_[pos_ + 1])) {
+    // non-ASCII members, nested sets, POSIX classes and set operations.
+    unsupported();
+  } else if ('\\' != c) {
+    value = c;
+    ++pos_;
+  } else if (pos_ + 1 >= len_) {
+    unsupported();
+  } else {
+    const uint8_t e = static_cast<uint8_t>(ptr_[pos_ + 1]);
+    pos_ += 2;
+    if (e < 0x80 && !is_ascii_alnum(e)) {
+      value = e;
+    } else if (get_escaped_control(e) >= 0) {
+      value = get_escaped_control(e);
+    } else if (NULL != strchr("dDwWsShHvV", e)) {
+      value = -1;
+    } else if ('p' == e || 'P' == e) {
+      if (pos_ < len_ && '{' == ptr_[pos_]) {
+        while (pos_ < len_ && '}' != ptr_[pos_]) {
+          ++pos_;
+        }
+      }
+      if (pos_ < len_) {
+        ++pos_;
+      } else {
+        unsupported();
+      }
+    } else {
+      unsupported();
+    }
+  }
+  return ret;
+}
+
+int ObExprRegexFastMatcher::Parser::parse_escape(int32_t &node)
+{
+  int ret = OB_SUCCESS;
+  int32_t value = -1;
+  bool opaque = false;
+  if (pos_ + 1 >= len_) {
+    unsupported();
+  } else {
+    const uint8_t e = static_cast<uint8_t>(ptr_[pos_ + 1]);
+    pos_ += 2;
+    if (e < 0x80 && !is_ascii_alnum(e)) {
+      value = e;
+    } else if (get_escaped_control(e) >= 0) {
+      value = get_escaped_control(e);
+    } else if (NULL != strchr("dDwWsSbBAzZGXRhHvV", e)) {
+      opaque = true;
+    } else if ('p' == e || 'P' == e) {
+      opaque = true;
+      if (pos_ < len_ && '{' == ptr_[pos_]) {
+        while (pos_ < len_ && '}' != ptr_[pos_]) {
+          ++pos_;
+        }
+      }
+      if (pos_ < len_) {
+        ++pos_;
+      } else {
+        unsupported();
+      }
+    } else {
+      // back references, \x \u \N{..} \Q..\E and so on.
+      unsupported();
+    }
+  }
+  if (!supported_) {
+  } else if (opaque) {
+    has_opaque_ = true;
+    if (OB_FAIL(new_node(NODE_OPAQUE, node))) {
+      LOG_WARN("new node failed", K(ret));
+    }
+  } else if (OB_FAIL(new_ascii_literal(static_cast<uint8_t>(value), node))) {
+    LOG_WARN("new literal failed", K(ret));
+  }
+  return ret;
+}
+
+int ObExprRegexFastMatcher::Parser::new_node(const NodeType type, int32_t &node)
+{
+  int ret = OB_SUCCESS;
+  Node new_node;
+  new_node.type_ = static_cast<int8_t>(type);
+  if (OB_FAIL(nodes_.push_back(new_node))) {
+    LOG_WARN("push back failed", K(ret));
+  } else {
+    node = static_cast<int32_t>(nodes_.count() - 1);
+  }
+  return ret;
+}
+
+int ObExprRegexFastMatcher::Parser::add_child(const int32_t parent, const int32_t child)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(parent < 0 || parent >= nodes_.count() || child < 0 || child >= nodes_.count())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("invalid node", K(ret), K(parent), K(child));
+  } else if (nodes_.at(parent).first_child_ < 0) {
+    nodes_.at(parent).first_child_ = child;
+    nodes_.at(parent).last_child_ = child;
+  } else {
+    nodes_.at(nodes_.at(parent).last_child_).next_ = child;
+    nodes_.at(parent).last_child_ = child;
+  }
+  return ret;
+}
+
+int ObExprRegexFastMatcher::Parser::new_ascii_literal(const uint8_t c, int32_t &node)
+{
+  int ret = OB_SUCCESS;
+  if (!is_case_sensitive_safe(c)) {
+    unsupported();
+  } else if (OB_FAIL(new_node(NODE_LITERAL, node))) {
+    LOG_WARN("new node failed", K(ret));
+  } else {
+    nodes_.at(node).lit_len_ = 1;
+    nodes_.at(node).lit_[0] = c;
+  }
+  return ret;
+}
+
+// ICU folds case on full Unicode case folding (e.g. 'k' matches KELVIN SIGN,
+// 's' matches LONG S), so only the characters without case are safe to be
+// compared byte by byte in case insensitive mode.
+bool ObExprRegexFastMatcher::Parser::is_case_sensitive_safe(const uint8_t c) const
+{
+  return 0 == (flags_ & UREGEX_CASE_INSENSITIVE) || !is_ascii_alpha(c);
+}
+
+ObExprRegexFastMatcher::ObExprRegexFastMatcher()
+  : flags_(0),
+    anchored_start_(false),
+    anchored_end_(false),
+    crlf_sensitive_(false),
+    dfa_state_cnt_(0),
+    class_cnt_(0),
+    start_state_(0),
+    trans_(NULL),
+    accept_(NULL),
+    literal_(NULL),
+    literal_len_(0)
+{
+  MEMSET(byte_class_, 0, sizeof(byte_class_));
+}
+
+// the tables are allocated from the allocator passed to init(), which
+// is released with the owner of this matcher.
+void ObExprRegexFastMatcher::reset()
+{
+  flags_ = 0;
+  anchored_start_ = false;
+  anchored_end_ = false;
+  crlf_sensitive_ = false;
+  dfa_state_cnt_ = 0;
+  class_cnt_ = 0;
+  start_state_ = 0;
+  trans_ = NULL;
+  accept_ = NULL;
+  literal_ = NULL;
+  literal_len_ = 0;
+}
+
+int ObExprRegexFastMatcher::init(ObIAllocator &alloc, const ObString &pattern, const uint32_t flags)
+{
+  int ret = OB_SUCCESS;
+  const uint32_t supported_flags = UREGEX_CASE_INSENSITIVE | UREGEX_DOTALL
+      | UREGEX_MULTILINE | UREGEX_UNIX_LINES;
+  NodeArray nodes;
+  Parser parser(pattern, flags, nodes);
+  int32_t root = -1;
+  reset();
+  if (pattern.empty() || 0 != (flags & ~supported_flags)) {
+    // leave to ICU
+  } else if (OB_FAIL(parser.parse(root))) {
+    LOG_WARN("parse regexp pattern failed", K(ret), K(pattern));
+  } else if (!parser.supported_ || root < 0) {
+    LOG_TRACE("regexp pattern not supported by fast matcher", K(pattern));
+  } else {
+    flags_ = flags;
+    anchored_start_ = parser.anchored_start_;
+    anchored_end_ = parser.anchored_end_;
+    crlf_sensitive_ = parser.has_dotall_;
+    char run[MAX_LITERAL_LEN];
+    char best[MAX_LITERAL_LEN];
+    int64_t run_len = 0;
+    int64_t best_len = 0;
+    extract_literal(nodes, root, run, run_len, best, best_len);
+    flush_literal(run, run_len, best, best_len);
+    if (best_len > 0) {
+      if (OB_ISNULL(literal_ = static_cast<char *>(alloc.alloc(best_len)))) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("allocate memory failed", K(ret), K(best_len));
+      } else {
+        MEMCPY(literal_, best, best_len);
+        literal_len_ = best_len;
+      }
+    }
+    if (OB_SUCC(ret) && !parser.has_opaque_) {
+      NfaArray nfa;
+      int32_t match_state = -1;
+      int32_t start = -1;
+      bool supported = true;
+      if (OB_FAIL(add_nfa_state(nfa, NFA_MATCH, 0, 0, -1, -1, match_state, supported))) {
+        LOG_WARN("add nfa state failed", K(ret));
+      } else if (OB_FAIL(build_nfa(nodes, root, match_state, nfa, start, supported))) {
+        LOG_WARN("build nfa failed", K(ret));
+      } else if (!supported) {
+        LOG_TRACE("regexp pattern too complex for dfa", K(pattern), K(nfa.count()));
+      } else if (OB_FAIL(build_dfa(alloc, nfa, start, match_state))) {
+        LOG_WARN("build dfa failed", K(ret));
+      }
+    }
+    LOG_TRACE("regexp fast matcher inited", K(ret), K(pattern), K(*this));
+  }
+  if (OB_FAIL(ret)) {
+    reset();
+  }
+  return ret;
+}
+
+int ObExprRegexFastMatcher::add_nfa_state(NfaArray &nfa,
+                                          const NfaStateType type,
+                                          const uint8_t lo,
+                                          const uint8_t hi,
+                                          const int32_t out,
+                                          const int32_t out1,
+                                          int32_t &idx,
+                                          bool &supported)
+{
+  int ret = OB_SUCCESS;
+  NfaState state;
+  state.type_ = static_cast<int8_t>(type);
+  state.lo_ = lo;
+  state.hi_ = hi;
+  state.out_ = out;
+  state.out1_ = out1;
+  if (nfa.count() >= MAX_NFA_STATE_CNT) {
+    supported = false;
+  } else if (OB_FAIL(nfa.push_back(state))) {
+    LOG_WARN("push back failed", K(ret));
+  } else {
+    idx = static_cast<int32_t>(nfa.count() - 1);
+  }
+  return ret;
+}
+
+// Thompson construction from the end: %start is the entry of %node which
+// continues at %next when the node matched.
+int ObExprRegexFastMatcher::build_nfa(const NodeArray &nodes,
+                                      const int32_t node_idx,
+                                      const int32_t next,
+                                      NfaArray &nfa,
+                                      int32_t &start,
+                                      bool &supported)
+{
+  int ret = OB_SUCCESS;
+  const Node &node = nodes.at(node_idx);
+  start = next;
+  switch (node.type_) {
+    case NODE_EMPTY: {
+      break;
+    }
+    case NODE_LITERAL: {
+      for (int64_t i = node.lit_len_ - 1; OB_SUCC(ret) && supported && i >= 0; --i) {
+        if (OB_FAIL(add_nfa_state(nfa, NFA_RANGE, node.lit_[i], node.lit_[i],
+                                  start, -1, start, supported))) {
+          LOG_WARN("add nfa state failed", K(ret));
+        }
+      }
+      break;
+    }
+    case NODE_CHARSET: {
+      if (OB_FAIL(build_charset_nfa(node, next, nfa, start, supported))) {
+        LOG_WARN("build charset nfa failed", K(ret));
+      }
+      break;
+    }
+    case NODE_CONCAT: {
+      ObSEArray<int32_t, 16> children;
+      for (int32_t c = node.first_child_; OB_SUCC(ret) && c >= 0; c = nodes.at(c).next_) {
+        if (OB_FAIL(children.push_back(c))) {
+          LOG_WARN("push back failed", K(ret));
+        }
+      }
+      for (int64_t i = children.count() - 1; OB_SUCC(ret) && supported && i >= 0; --i) {
+        if (OB_FAIL(SMART_CALL(build_nfa(nodes, children.at(i), start, nfa,
+                                         start, supported)))) {
+          LOG_WARN("build nfa failed", K(ret));
+        }
+      }
+      break;
+    }
+    case NODE_ALTER: {
+      start = -1;
+      for (int32_t c = node.first_child_; OB_SUCC(ret) && supported && c >= 0;
+           c = nodes.at(c).next_) {
+        int32_t child_start = -1;
+        if (OB_FAIL(SMART_CALL(build_nfa(nodes, c, next, nfa,
+                                         child_start, supported)))) {
+          LOG_WARN("build nfa failed", K(ret));
+        } else if (!supported) {
+        } else if (start < 0) {
+          start = child_start;
+        } else if (OB_FAIL(add_nfa_state(nfa, NFA_SPLIT, 0, 0, child_start, start,
+                                         start, supported))) {
+          LOG_WARN("add nfa state failed", K(ret));
+        }
+      }
+      break;
+    }
+    case NODE_REPEAT: {
+      // x{min,max} = x...x (min times) followed by (x(x...)?)? or x*
+      const int32_t child = node.first_child_;
+      if (node.max_ < 0) {
+        int32_t loop = -1;
+        int32_t body = -1;
+        if (OB_FAIL(add_nfa_state(nfa, NFA_SPLIT, 0, 0, -1, next, loop, supported))) {
+          LOG_WARN("add nfa state failed", K(ret));
+        } else if (!supported) {
+        } else if (OB_FAIL(SMART_CALL(build_nfa(nodes, child, loop, nfa,
+                                                body, supported)))) {
+          LOG_WARN("build nfa failed", K(ret));
+        } else {
+          nfa.at(loop).out_ = body;
+          start = loop;
+        }
+      } else {
+        for (int32_t i = node.min_; OB_SUCC(ret) && supported && i < node.max_; ++i) {
+          int32_t body = -1;
+          if (OB_FAIL(SMART_CALL(build_nfa(nodes, child, start, nfa,
+                                           body, supported)))) {
+            LOG_WARN("build nfa failed", K(ret));
+          } else if (supported && OB_FAIL(add_nfa_state(nfa, NFA_SPLIT, 0, 0, body, next,
+                                                        start, supported))) {
+            LOG_WARN("add nfa state failed", K(ret));
+          }
+        }
+      }
+      for (int32_t i = 0; OB_SUCC(ret) && supported && i < node.min_; ++i) {
+        if (OB_FAIL(SMART_CALL(build_nfa(nodes, child, start, nfa,
+                                         start, supported)))) {
+          LOG_WARN("build nfa failed", K(ret));
+        }
+      }
+      break;
+    }
+    default: {
+      supported = false;
+      break;
+    }
+  }
+  return ret;
+}
+
+int ObExprRegexFastMatcher::build_charset_nfa(const Node &node,
+                                              const int32_t next,
+                                              NfaArray &nfa,
+                                              int32_t &start,
+                                              bool &supported)
+{
+  int ret = OB_SUCCESS;
+  start = -1;
+  // one branch per run of ASCII members and per multi-byte sequence.
+  for (int32_t c = 0; OB_SUCC(ret) && supported && c < 128; ++c) {
+    if (test_ascii_bit(node.ascii_, static_cast<uint8_t>(c))) {
+      int32_t hi = c;
+      while (hi + 1 < 128 && test_ascii_bit(node.ascii_, static_cast<uint8_t>(hi + 1))) {
+        ++hi;
+      }
+      int32_t branch = -1;
+      if (OB_FAIL(add_nfa_state(nfa, NFA_RANGE, static_cast<uint8_t>(c), static_cast<uint8_t>(hi),
+                                next, -1, branch, supported))) {
+        LOG_WARN("add nfa state failed", K(ret));
+      } else if (!supported) {
+      } else if (start < 0) {
+        start = branch;
+      } else if (OB_FAIL(add_nfa_state(nfa, NFA_SPLIT, 0, 0, branch, start, start, supported))) {
+        LOG_WARN("add nfa state failed", K(ret));
+      }
+      c = hi;
+    }
+  }
+  const uint8_t (*seqs)[4][2] = MB_DOT == node.mb_set_ ? MB_DOT_SEQS : MB_ANY_SEQS;
+  const int64_t *seq_lens = MB_DOT == node.mb_set_ ? MB_DOT_SEQ_LENS : MB_ANY_SEQ_LENS;
+  const int64_t seq_cnt = MB_NONE == node.mb_set_ ? 0
+      : (MB_DOT == node.mb_set_ ? ARRAYSIZEOF(MB_DOT_SEQ_LENS) : ARRAYSIZEOF(MB_ANY_SEQ_LENS));
+  for (int64_t i = 0; OB_SUCC(ret) && supported && i < seq_cnt; ++i) {
+    int32_t branch = -1;
+    if (OB_FAIL(build_seq_nfa(seqs[i], seq_lens[i], next, nfa, branch, supported))) {
+      LOG_WARN("build sequence nfa failed", K(ret));
+    } else if (!supported) {
+    } else if (start < 0) {
+      start = branch;
+    } else if (OB_FAIL(add_nfa_state(nfa, NFA_SPLIT, 0, 0, branch, start, start, supported))) {
+      LOG_WARN("add nfa state failed", K(ret));
+    }
+  }
+  if (OB_SUCC(ret) && start < 0) {
+    // empty set, never happens for a pattern accepted by ICU.
+    supported = false;
+  }
+  return ret;
+}
+
+int ObExprRegexFastMatcher::build_seq_nfa(const uint8_t (*ranges)[2],
+                                          const int64_t len,
+                                          const int32_t next,
+                                          NfaArray &nfa,
+                                          int32_t &start,
+                                          bool &supported)
+{
+  int ret = OB_SUCCESS;
+  start = next;
+  for (int64_t i = len - 1; OB_SUCC(ret) && supported && i >= 0; --i) {
+    if (OB_FAIL(add_nfa_state(nfa, NFA_RANGE, ranges[i][0], ranges[i][1],
+                              start, -1, start, supported))) {
+      LOG_WARN("add nfa state failed", K(ret));
+    }
+  }
+  return ret;
+}
+
+// add the byte consuming and match states reachable from %state through
+// epsilon edges into %set.
+int ObExprRegexFastMatcher::add_closure(const NfaArray &nfa,
+                                        const int32_t state,
+                                        ObIArray<int32_t> &stack,
+                                        uint64_t *visited,
+                                        uint64_t *set)
+{
+  int ret = OB_SUCCESS;
+  stack.reuse();
+  if (OB_FAIL(stack.push_back(state))) {
+    LOG_WARN("push back failed", K(ret));
+  }
+  while (OB_SUCC(ret) && !stack.empty()) {
+    int32_t s = -1;
+    if (OB_FAIL(stack.pop_back(s))) {
+      LOG_WARN("pop back failed", K(ret));
+    } else if (s < 0 || 0 != (visited[s / 64] & (1ULL << (s % 64)))) {
+    } else {
+      visited[s / 64] |= (1ULL << (s % 64));
+      const NfaState &st = nfa.at(s);
+      if (NFA_SPLIT != st.type_) {
+        set[s / 64] |= (1ULL << (s % 64));
+      } else if (OB_FAIL(stack.push_back(st.out_))) {
+        LOG_WARN("push back failed", K(ret));
+      } else if (OB_FAIL(stack.push_back(st.out1_))) {
+        LOG_WARN("push back failed", K(ret));
+      }
+    }
+  }
+  return ret;
+}
+
+// Subset construction over byte classes. Bytes never distinguished by any NFA
+// range share a class, which keeps both the construction and the table small.
+// For an unanchored pattern the start closure is added after every byte, so a
+// match may begin at any position; ASCII and lead bytes begin every branch so
+// a match never begins inside a multi-byte character.
+int ObExprRegexFastMatcher::build_dfa(ObIAllocator &alloc,
+                                      const NfaArray &nfa,
+                                      const int32_t start,
+                                      const int32_t match_state)
+{
+  int ret = OB_SUCCESS;
+  bool boundary[257];
+  uint8_t class_rep[256];
+  MEMSET(boundary, 0, sizeof(boundary));
+  boundary[0] = true;
+  for (int64_t i = 0; i < nfa.count(); ++i) {
+    if (NFA_RANGE == nfa.at(i).type_) {
+      boundary[nfa.at(i).lo_] = true;
+      boundary[nfa.at(i).hi_ + 1] = true;
+    }
+  }
+  int32_t class_cnt = 0;
+  for (int32_t b = 0; b < 256; ++b) {
+    if (boundary[b]) {
+      class_rep[class_cnt++] = static_cast<uint8_t>(b);
+    }
+    byte_class_[b] = static_cast<uint8_t>(class_cnt - 1);
+  }
+
+  const int64_t word_cnt = (nfa.count() + 63) / 64;
+  ObSEArray<uint64_t, 256> sets;
+  ObSEArray<uint64_t, 32> hashes;
+  ObSEArray<uint16_t, 1024> trans;
+  ObSEArray<bool, 32> accepts;
+  ObSEArray<int32_t, 64> stack;
+  ObSEArray<uint64_t, 16> cur;
+  ObSEArray<uint64_t, 16> tmp;
+  ObSEArray<uint64_t, 16> visited;
+  ObSEArray<uint64_t, 16> start_set;
+  bool supported = true;
+  if (OB_FAIL(cur.prepare_allocate(word_cnt))
+      || OB_FAIL(tmp.prepare_allocate(word_cnt))
+      || OB_FAIL(visited.prepare_allocate(word_cnt))
+      || OB_FAIL(start_set.prepare_allocate(word_cnt))) {
+    LOG_WARN("prepare allocate failed", K(ret), K(word_cnt));
+  } else {
+    MEMSET(&start_set.at(0), 0, word_cnt * sizeof(uint64_t));
+    MEMSET(&visited.at(0), 0, word_cnt * sizeof(uint64_t));
+    MEMSET(&tmp.at(0), 0, word_cnt * sizeof(uint64_t));
+    // dead state
+    for (int64_t i = 0; OB_SUCC(ret) && i < word_cnt; ++i) {
+      OZ(sets.push_back(0));
+    }
+    OZ(hashes.push_back(murmurhash(&tmp.at(0), static_cast<int32_t>(word_cnt * sizeof(uint64_t)), 0)));
+    OZ(accepts.push_back(false));
+    OZ(add_closure(nfa, start, stack, &visited.at(0), &start_set.at(0)));
+    for (int64_t i = 0; OB_SUCC(ret) && i < word_cnt; ++i) {
+      OZ(sets.push_back(start_set.at(i)));
+    }
+    OZ(hashes.push_back(murmurhash(&start_set.at(0), static_cast<int32_t>(word_cnt * sizeof(uint64_t)), 0)));
+    OZ(accepts.push_back(0 != (start_set.at(match_state / 64) & (1ULL << (match_state % 64)))));
+  }
+  for (int64_t d = 0; OB_SUCC(ret) && supported && d < accepts.count(); ++d) {
+    MEMCPY(&cur.at(0), &sets.at(d * word_cnt), word_cnt * sizeof(uint64_t));
+    // the match is decided once accepted if it need not end at the end of text.
+    const bool absorbing = 0 == d || (accepts.at(d) && !anchored_end_);
+    for (int32_t c = 0; OB_SUCC(ret) && supported && c < class_cnt; ++c) {
+      int64_t next_state = d;
+      if (!absorbing) {
+        const uint8_t b = class_rep[c];
+        MEMSET(&tmp.at(0), 0, word_cnt * sizeof(uint64_t));
+        MEMSET(&visited.at(0), 0, word_cnt * sizeof(uint64_t));
+        for (int64_t s = 0; OB_SUCC(ret) && s < nfa.count(); ++s) {
+          if (0 != (cur.at(s / 64) & (1ULL << (s % 64)))
+              && NFA_RANGE == nfa.at(s).type_
+              && b >= nfa.at(s).lo_ && b <= nfa.at(s).hi_) {
+            OZ(add_closure(nfa, nfa.at(s).out_, stack, &visited.at(0), &tmp.at(0)));
+          }
+        }
+        if (OB_SUCC(ret) && !anchored_start_) {
+          for (int64_t i = 0; i < word_cnt; ++i) {
+            tmp.at(i) |= start_set.at(i);
+          }
+        }
+        const uint64_t hash = murmurhash(&tmp.at(0), static_cast<int32_t>(word_cnt * sizeof(uint64_t)), 0);
+        next_state = -1;
+        for (int64_t i = 0; OB_SUCC(ret) && next_state < 0 && i < hashes.count(); ++i) {
+          if (hash == hashes.at(i)
+              && 0 == MEMCMP(&tmp.at(0), &sets.at(i * word_cnt), word_cnt * sizeof(uint64_t))) {
+            next_state = i;
+          }
+        }
+        if (OB_FAIL(ret) || next_state >= 0) {
+        } else if (accepts.count() >= MAX_DFA_STATE_CNT) {
+          supported = false;
+        } else {
+          for (int64_t i = 0; OB_SUCC(ret) && i < word_cnt; ++i) {
+            OZ(sets.push_back(tmp.at(i)));
+          }
+          OZ(hashes.push_back(hash));
+          OZ(accepts.push_back(0 != (tmp.at(match_state / 64) & (1ULL << (match_state % 64)))));
+          next_state = accepts.count() - 1;
+        }
+      }
+      if (OB_SUCC(ret) && supported) {
+        OZ(trans.push_back(static_cast<uint16_t>(next_state)));
+      }
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (!supported) {
+    LOG_TRACE("too many dfa states", K(accepts.count()), K(nfa.count()));
+  } else if (OB_ISNULL(trans_ = static_cast<uint16_t *>(alloc.alloc(trans.count() * sizeof(uint16_t))))
+             || OB_ISNULL(accept_ = static_cast<bool *>(alloc.alloc(accepts.count() * sizeof(bool))))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("allocate memory failed", K(ret), K(trans.count()), K(accepts.count()));
+  } else {
+    MEMCPY(trans_, &trans.at(0), trans.count() * sizeof(uint16_t));
+    MEMCPY(accept_, &accepts.at(0), accepts.count() * sizeof(bool));
+    dfa_state_cnt_ = static_cast<int32_t>(accepts.count());
+    class_cnt_ = class_cnt;
+    start_state_ = 1;
+  }
+  if (OB_FAIL(ret) || !supported) {
+    trans_ = NULL;
+    accept_ = NULL;
+  }
+  return ret;
+}
+
+// Collect the literal runs every match must contain, the longest one is kept
+// in %best. A run is broken by anything not matching exactly one fixed string.
+void ObExprRegexFastMatcher::extract_literal(const NodeArray &nodes,
+                                             const int32_t node_idx,
+                                             char *run,
+                                             int64_t &run_len,
+                                             char *best,
+                                             int64_t &best_len) const
+{
+  const Node &node = nodes.at(node_idx);
+  switch (node.type_) {
+    case NODE_EMPTY: {
+      break;
+    }
+    case NODE_LITERAL: {
+      if (run_len + node.lit_len_ > MAX_LITERAL_LEN) {
+        flush_literal(run, run_len, best, best_len);
+      }
+      MEMCPY(run + run_len, node.lit_, node.lit_len_);
+      run_len += node.lit_len_;
+      break;
+    }
+    case NODE_CONCAT: {
+      for (int32_t c = node.first_child_; c >= 0; c = nodes.at(c).next_) {
+        extract_literal(nodes, c, run, run_len, best, best_len);
+      }
+      break;
+    }
+    case NODE_REPEAT: {
+      const Node &child = nodes.at(node.first_child_);
+      if (node.min_ < 1) {
+        flush_literal(run, run_len, best, best_len);
+      } else if (1 == node.max_) {
+        extract_literal(nodes, node.first_child_, run, run_len, best, best_len);
+      } else if (NODE_LITERAL == child.type_) {
+        // "ab+c": the "ab" is adjacent, the following one may be not.
+        extract_literal(nodes, node.first_child_, run, run_len, best, best_len);
+        flush_literal(run, run_len, best, best_len);
+      } else {
+        flush_literal(run, run_len, best, best_len);
+        extract_literal(nodes, node.first_child_, run, run_len, best, best_len);
+        flush_literal(run, run_len, best, best_len);
+      }
+      break;
+    }
+    default: {
+      flush_literal(run, run_len, best, best_len);
+      break;
+    }
+  }
+}
+
+void ObExprRegexFastMatcher::flush_literal(char *run, int64_t &run_len,
+                                           char *best, int64_t &best_len)
+{
+  if (run_len > best_len) {
+    MEMCPY(best, run, run_len);
+    best_len = run_len;
+  }
+  run_len = 0;
+}
+
+void ObExprRegexFastMatcher::match(const ObString &text, bool &result, bool &done) const
+{
+  const unsigned char *ptr = reinterpret_cast<const unsigned char *>(text.ptr());
+  const int64_t len = text.length();
+  result = false;
+  done = false;
+  // invalid texts are reported by the charset convert of the ICU path.
+  if (!is_valid() || (len > 0 && !is_valid_utf8(ptr, len))) {
+  } else if (literal_len_ > 0 && NULL == find_literal(text.ptr(), len, literal_, literal_len_)) {
+    done = true;
+  } else if (NULL != trans_ && (!crlf_sensitive_ || NULL == memchr(ptr, '\r', len))) {
+    result = dfa_match(ptr, len);
+    done = true;
+  }
+}
+
+bool ObExprRegexFastMatcher::dfa_match(const unsigned char *text, const int64_t len) const
+{
+  const int64_t stop = anchored_end_ ? len - get_trailing_terminator_len(text, len) : -1;
+  int64_t state = start_state_;
+  bool matched = !anchored_end_ && accept_[state];
+  for (int64_t i = 0; !matched && 0 != state && i < len; ++i) {
+    if (i == stop && accept_[state]) {
+      matched = true;
+    } else {
+      state = trans_[state * class_cnt_ + byte_class_[text[i]]];
+      matched = !anchored_end_ && accept_[state];
+    }
+  }
+  return matched || accept_[state];
+}
+
+// '$' matches at the end of text and before the line terminator at the end of
+// text, see URX_DOLLAR and URX_DOLLAR_D of ICU.
+int64_t ObExprRegexFastMatcher::get_trailing_terminator_len(const unsigned char *text,
+                                                            const int64_t len) const
+{
+  int64_t tail = 0;
+  if (len <= 0) {
+  } else if (0 != (flags_ & UREGEX_UNIX_LINES)) {
+    tail = '\n' == text[len - 1] ? 1 : 0;
+  } else if (len >= 2 && '\r' == text[len - 2] && '\n' == text[len - 1]) {
+    tail = 2;
+  } else if (text[len - 1] >= 0x0A && text[len - 1] <= 0x0D) {
+    tail = 1;
+  } else if (len >= 2 && 0xC2 == text[len - 2] && 0x85 == text[len - 1]) {
+    tail = 2;
+  } else if (len >= 3 && 0xE2 == text[len - 3] && 0x80 == text[len - 2]
+             && (0xA8 == text[len - 1] || 0xA9 == text[len - 1])) {
+    tail = 3;
+  }
+  return tail;
+}
+
+const char *ObExprRegexFastMatcher::find_literal(const char *text,
+                                                 const int64_t text_len,
+                                                 const char *literal,
+                                                 const int64_t literal_len)
+{
+  const char *pos = NULL;
+  if (text_len < literal_len) {
+  } else if (1 == literal_len) {
+    pos = static_cast<const char *>(memchr(text, literal[0], text_len));
+  } else {
+    int64_t i = 0;
+#if defined(__x86_64__)
+    // compare the first and the last byte of 16 candidates at once, see
+    // "SIMD-friendly algorithms for substring searching" by Wojciech Mula.
+    const __m128i first = _mm_set1_epi8(literal[0]);
+    const __m128i last = _mm_set1_epi8(literal[literal_len - 1]);
+    for (; NULL == pos && i + literal_len - 1 + 16 <= text_len; i += 16) {
+      const __m128i block_first = _mm_loadu_si128(reinterpret_cast<const __m128i *>(text + i));
+      const __m128i block_last = _mm_loadu_si128(
+          reinterpret_cast<const __m128i *>(text + i + literal_len - 1));
+      uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(
+          _mm_and_si128(_mm_cmpeq_epi8(first, block_first), _mm_cmpeq_epi8(last, block_last))));
+      while (NULL == pos && 0 != mask) {
+        const int64_t offset = i + __builtin_ctz(mask);
+        if (0 == MEMCMP(text + offset + 1, literal + 1, literal_len - 2)) {
+          pos = text + offset;
+        }
+        mask &= mask - 1;
+      }
+    }
+    if (NULL != pos) {
+      i = text_len;
+    }
+#endif
+    if (NULL == pos && i < text_len) {
+      pos = static_cast<const char *>(memmem(text + i, text_len - i, literal, literal_len));
+    }
+  }
+  return pos;
+}
+
+bool ObExprRegexFastMatcher::is_valid_utf8(const unsigned char *text, const int64_t len)
+{
+  bool valid = true;
+  int64_t i = 0;
+  while (valid && i < len) {
+    uint64_t word = 0;
+    if (i + 8 <= len) {
+      MEMCPY(&word, text + i, sizeof(word));
+    }
+    if (i + 8 <= len && 0 == (word & 0x8080808080808080ULL)) {
+      // skip 8 ASCII bytes at once
+      i += 8;
+    } else if (text[i] < 0x80) {
+      ++i;
+    } else if (text[i] >= 0xC2 && text[i] <= 0xDF) {
+      valid = i + 1 < len && (text[i + 1] & 0xC0) == 0x80;
+      i += 2;
+    } else if (text[i] >= 0xE0 && text[i] <= 0xEF) {
+      const unsigned char lo = 0xE0 == text[i] ? 0xA0 : 0x80;
+      const unsigned char hi = 0xED == text[i] ? 0x9F : 0xBF;
+      valid = i + 2 < len && text[i + 1] >= lo && text[i + 1] <= hi
+          && (text[i + 2] & 0xC0) == 0x80;
+      i += 3;
+    } else if (text[i] >= 0xF0 && text[i] <= 0xF4) {
+      const unsigned char lo = 0xF0 == text[i] ? 0x90 : 0x80;
+      const unsigned char hi = 0xF4 == text[i] ? 0x8F : 0xBF;
+      valid = i + 3 < len && text[i + 1] >= lo && text[i + 1] <= hi
+          && (text[i + 2] & 0xC0) == 0x80 && (text[i + 3] & 0xC0) == 0x80;
+      i += 4;
+    } else {
+      valid = false;
+    }
+  }
+  return valid;
+}
+
+} // end namespace sql
+} // end namespace oceanbase
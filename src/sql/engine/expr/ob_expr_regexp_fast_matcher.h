@@ -0,0 +1,191 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_SQL_ENGINE_EXPR_OB_EXPR_REGEXP_FAST_MATCHER_H_
+#define OCEANBASE_SQL_ENGINE_EXPR_OB_EXPR_REGEXP_FAST_MATCHER_H_
+
+#include "lib/allocator/ob_allocator.h"
+#include "lib/container/ob_se_array.h"
+#include "lib/string/ob_string.h"
+#include "lib/utility/ob_print_utils.h"
+
+namespace oceanbase
+{
+namespace sql
+{
+
+// Byte level matcher of the simple REGEXP patterns, tried before ICU so that
+// most rows need not be converted to UTF-16.
+//
+// The utf8mb4 pattern is parsed into a small syntax tree (literals, classes, '.',
+// groups, alternation, quantifiers, '^' at the beginning and '$' at the end) and
+// compiled into a DFA over UTF-8 bytes. The longest literal every match must
+// contain is kept as a prefilter, a text without it is rejected by one memmem.
+// Patterns with constructs the DFA can not express (\d, \w, \b, \p{..} ...) may
+// still get the prefilter, everything else is left to ICU.
+//
+// Only match() from the beginning of the text is answered, search with start
+// offset, occurrence and sub expressions always go to ICU.
+class ObExprRegexFastMatcher
+{
+public:
+  const static int64_t MAX_NFA_STATE_CNT = 1024;
+  const static int64_t MAX_DFA_STATE_CNT = 256;
+  const static int64_t MAX_LITERAL_LEN = 64;
+
+  ObExprRegexFastMatcher();
+  ~ObExprRegexFastMatcher() { reset(); }
+  void reset();
+
+  // %flags are the ICU flags of the pattern. The matcher stays invalid if
+  // nothing can be done for the pattern, which is not an error.
+  int init(common::ObIAllocator &alloc, const common::ObString &pattern, const uint32_t flags);
+  inline bool is_valid() const { return NULL != trans_ || literal_len_ > 0; }
+  // %done is false if the result can not be decided here and ICU should be used.
+  void match(const common::ObString &text, bool &result, bool &done) const;
+
+  TO_STRING_KV(K_(dfa_state_cnt), K_(class_cnt), K_(anchored_start), K_(anchored_end),
+               K_(literal_len));
+
+private:
+  enum NodeType
+  {
+    NODE_EMPTY = 0,
+    NODE_LITERAL,
+    NODE_CHARSET,
+    NODE_CONCAT,
+    NODE_ALTER,
+    NODE_REPEAT,
+    // parsed but not expressible by the DFA, e.g. \d or \b.
+    NODE_OPAQUE,
+  };
+  // multi-byte characters matched by a charset.
+  enum MultiByteSet
+  {
+    MB_NONE = 0,
+    MB_ANY,
+    // all except the line terminators U+0085, U+2028 and U+2029.
+    MB_DOT,
+  };
+  struct Node
+  {
+    Node() { MEMSET(this, 0, sizeof(*this)); first_child_ = -1; last_child_ = -1; next_ = -1; }
+    int8_t type_;
+    int8_t mb_set_;
+    uint8_t lit_len_;
+    uint8_t lit_[4];
+    int32_t min_;
+    // -1 for unbounded.
+    int32_t max_;
+    int32_t first_child_;
+    int32_t last_child_;
+    int32_t next_;
+    uint64_t ascii_[2];
+  };
+  enum NfaStateType
+  {
+    NFA_RANGE = 0,
+    NFA_SPLIT,
+    NFA_MATCH,
+  };
+  struct NfaState
+  {
+    int8_t type_;
+    uint8_t lo_;
+    uint8_t hi_;
+    int32_t out_;
+    // second branch of NFA_SPLIT, -1 for plain epsilon.
+    int32_t out1_;
+  };
+  typedef common::ObSEArray<Node, 32> NodeArray;
+  typedef common::ObSEArray<NfaState, 64> NfaArray;
+
+  class Parser
+  {
+  public:
+    Parser(const common::ObString &pattern, const uint32_t flags, NodeArray &nodes)
+      : supported_(true), has_opaque_(false), has_dotall_(false),
+        anchored_start_(false), anchored_end_(false),
+        ptr_(pattern.ptr()), len_(pattern.length()), pos_(0), flags_(flags), nodes_(nodes) {}
+    int parse(int32_t &root);
+    bool supported_;
+    bool has_opaque_;
+    // '.' in DOTALL mode, which consumes a CRLF as a whole.
+    bool has_dotall_;
+    bool anchored_start_;
+    bool anchored_end_;
+  private:
+    int parse_alter(const int64_t depth, int32_t &node);
+    int parse_concat(const int64_t depth, int32_t &node);
+    int parse_atom(const int64_t depth, int32_t &node, bool &quantifiable);
+    int parse_quantifier(int32_t &node);
+    int parse_class(int32_t &node);
+    // %value is -1 for the opaque class items like \d.
+    int parse_class_char(int32_t &value);
+    int parse_escape(int32_t &node);
+    int parse_bound(int32_t &value);
+    int new_node(const NodeType type, int32_t &node);
+    int add_child(const int32_t parent, const int32_t child);
+    int new_ascii_literal(const uint8_t c, int32_t &node);
+    bool is_case_sensitive_safe(const uint8_t c) const;
+    void unsupported() { supported_ = false; }
+  private:
+    const char *ptr_;
+    const int64_t len_;
+    int64_t pos_;
+    const uint32_t flags_;
+    NodeArray &nodes_;
+  };
+
+  int build_nfa(const NodeArray &nodes, const int32_t node, const int32_t next,
+                NfaArray &nfa, int32_t &start, bool &supported);
+  int build_charset_nfa(const Node &node, const int32_t next, NfaArray &nfa,
+                        int32_t &start, bool &supported);
+  int build_seq_nfa(const uint8_t (*ranges)[2], const int64_t len, const int32_t next,
+                    NfaArray &nfa, int32_t &start, bool &supported);
+  static int add_nfa_state(NfaArray &nfa, const NfaStateType type, const uint8_t lo,
+                           const uint8_t hi, const int32_t out, const int32_t out1,
+                           int32_t &idx, bool &supported);
+  int build_dfa(common::ObIAllocator &alloc, const NfaArray &nfa, const int32_t start,
+                const int32_t match_state);
+  static int add_closure(const NfaArray &nfa, const int32_t state,
+                         common::ObIArray<int32_t> &stack, uint64_t *visited, uint64_t *set);
+  void extract_literal(const NodeArray &nodes, const int32_t node,
+                       char *run, int64_t &run_len, char *best, int64_t &best_len) const;
+  static void flush_literal(char *run, int64_t &run_len, char *best, int64_t &best_len);
+  bool dfa_match(const unsigned char *text, const int64_t len) const;
+  int64_t get_trailing_terminator_len(const unsigned char *text, const int64_t len) const;
+  static const char *find_literal(const char *text, const int64_t text_len,
+                                  const char *literal, const int64_t literal_len);
+  static bool is_valid_utf8(const unsigned char *text, const int64_t len);
+
+private:
+  uint32_t flags_;
+  bool anchored_start_;
+  bool anchored_end_;
+  // texts with '\r' are left to ICU, see Parser::has_dotall_.
+  bool crlf_sensitive_;
+  int32_t dfa_state_cnt_;
+  int32_t class_cnt_;
+  int32_t start_state_;
+  uint8_t byte_class_[256];
+  // dfa_state_cnt_ * class_cnt_ transitions, state 0 is the dead state.
+  uint16_t *trans_;
+  bool *accept_;
+  char *literal_;
+  int64_t literal_len_;
+  DISALLOW_COPY_AND_ASSIGN(ObExprRegexFastMatcher);
+};
+
+} // end namespace sql
+} // end namespace oceanbase
+#endif // OCEANBASE_SQL_ENGINE_EXPR_OB_EXPR_REGEXP_FAST_MATCHER_H_
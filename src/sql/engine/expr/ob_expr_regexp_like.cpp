@@ -197,9 +197,12 @@ int ObExprRegexpLike::eval_regexp_like(
                (lib::is_mysql_mode() && NULL != match_type && match_type->is_null())) {
       expr_datum.set_null();
     } else {
+      bool done = false;
       if (expr.args_[0]->datum_meta_.cs_type_ == CS_TYPE_UTF8MB4_BIN ||
         expr.args_[0]->datum_meta_.cs_type_ == CS_TYPE_UTF8MB4_GENERAL_CI) {
-        if (OB_FAIL(ObExprUtil::convert_string_collation(text_str, expr.args_[0]->datum_meta_.cs_type_, text_utf16,
+        regexp_ctx->fast_match(text_str, match, done);
+        if (done) {
+        } else if (OB_FAIL(ObExprUtil::convert_string_collation(text_str, expr.args_[0]->datum_meta_.cs_type_, text_utf16,
                                         ObCharset::is_bin_sort(expr.args_[0]->datum_meta_.cs_type_) ? CS_TYPE_UTF16_BIN : CS_TYPE_UTF16_GENERAL_CI,
                                         tmp_alloc))) {
           LOG_WARN("convert charset failed", K(ret));
@@ -207,10 +210,11 @@ int ObExprRegexpLike::eval_regexp_like(
       } else {
         text_utf16 = text_str;
       }
-      if (OB_FAIL(ret)) {
+      if (OB_FAIL(ret) || done) {
       } else if (OB_FAIL(regexp_ctx->match(tmp_alloc, text_utf16, start_pos - 1, match))) {
         LOG_WARN("fail to match", K(ret), K(text));
-      } else {
+      }
+      if (OB_SUCC(ret)) {
         expr_datum.set_int32(match);
       }
     }
@@ -60,6 +60,7 @@ int ObExprSha::cg_expr(ObExprCGCtx &, const ObRawExpr &, ObExpr &rt_expr) const
 {
   int ret = OB_SUCCESS;
   rt_expr.eval_func_ = &ObExprSha::eval_sha;
+  rt_expr.eval_batch_func_ = &ObExprSha::eval_sha_batch;
   return ret;
 }
 
@@ -85,6 +86,43 @@ int ObExprSha::eval_sha(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &expr_datum)
   return ret;
 }
 
+int ObExprSha::eval_sha_batch(const ObExpr &expr, ObEvalCtx &ctx,
+                              const ObBitVector &skip, const int64_t batch_size)
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(expr.args_[0]->eval_batch(ctx, skip, batch_size))) {
+    LOG_WARN("evaluate parameter batch failed", K(ret));
+  } else {
+    ObDatum *res_datums = expr.locate_batch_datums(ctx);
+    ObDatumVector arg_datums = expr.args_[0]->locate_expr_datumvector(ctx);
+    ObBitVector &eval_flags = expr.get_evaluated_flags(ctx);
+    ObEvalCtx::BatchInfoScopeGuard batch_info_guard(ctx);
+    batch_info_guard.set_batch_size(batch_size);
+    ObEvalCtx::TempAllocGuard alloc_guard(ctx);
+    for (int64_t i = 0; OB_SUCC(ret) && i < batch_size; ++i) {
+      if (skip.at(i) || eval_flags.at(i)) {
+        continue;
+      }
+      const ObDatum *arg = arg_datums.at(i);
+      ObString sha_str;
+      batch_info_guard.set_batch_idx(i);
+      if (arg->is_null()) {
+        res_datums[i].set_null();
+      } else if (OB_FAIL(ObHashUtil::hash(OB_HASH_SH1, arg->get_string(),
+                                          alloc_guard.get_allocator(), sha_str))) {
+        LOG_WARN("fail to calc sha", K(ret));
+      } else if (OB_FAIL(ObDatumHexUtils::hex(expr, sha_str, ctx, alloc_guard.get_allocator(),
+                                              res_datums[i], false))) {
+        LOG_WARN("fail to conver sha_str to hex", K(sha_str), K(ret));
+      }
+      if (OB_SUCC(ret)) {
+        eval_flags.set(i);
+      }
+    }
+  }
+  return ret;
+}
+
 ObExprSha2::ObExprSha2(ObIAllocator &alloc)
     : ObStringExprOperator(alloc, T_FUN_SYS_SHA2, N_SHA2, 2)
 {
@@ -119,6 +157,7 @@ int ObExprSha2::cg_expr(ObExprCGCtx &, const ObRawExpr &, ObExpr &rt_expr) const
 {
   int ret = OB_SUCCESS;
   rt_expr.eval_func_ = &ObExprSha2::eval_sha2;
+  rt_expr.eval_batch_func_ = &ObExprSha2::eval_sha2_batch;
   return ret;
 }
 
@@ -154,5 +193,54 @@ int ObExprSha2::eval_sha2(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &expr_datu
   return ret;
 }
 
+int ObExprSha2::eval_sha2_batch(const ObExpr &expr, ObEvalCtx &ctx,
+                                const ObBitVector &skip, const int64_t batch_size)
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(expr.args_[0]->eval_batch(ctx, skip, batch_size))) {
+    LOG_WARN("evaluate parameter batch failed", K(ret));
+  } else if (OB_FAIL(expr.args_[1]->eval_batch(ctx, skip, batch_size))) {
+    LOG_WARN("evaluate parameter batch failed", K(ret));
+  } else {
+    ObDatum *res_datums = expr.locate_batch_datums(ctx);
+    ObDatumVector text_datums = expr.args_[0]->locate_expr_datumvector(ctx);
+    ObDatumVector len_datums = expr.args_[1]->locate_expr_datumvector(ctx);
+    ObBitVector &eval_flags = expr.get_evaluated_flags(ctx);
+    ObEvalCtx::BatchInfoScopeGuard batch_info_guard(ctx);
+    batch_info_guard.set_batch_size(batch_size);
+    ObEvalCtx::TempAllocGuard alloc_guard(ctx);
+    for (int64_t i = 0; OB_SUCC(ret) && i < batch_size; ++i) {
+      if (skip.at(i) || eval_flags.at(i)) {
+        continue;
+      }
+      const ObDatum *arg0 = text_datums.at(i);
+      const ObDatum *arg1 = len_datums.at(i);
+      batch_info_guard.set_batch_idx(i);
+      if (arg0->is_null() || arg1->is_null()) {
+        res_datums[i].set_null();
+      } else {
+        int64_t sha_bit_len = 0 == arg1->get_int() ? 256 : arg1->get_int();
+        ObHashAlgorithm algo = OB_HASH_INVALID;
+        ObString sha_str;
+        if (OB_FAIL(ObHashUtil::get_sha_hash_algorightm(sha_bit_len, algo))) {
+          ret = OB_SUCCESS;
+          res_datums[i].set_null();
+          LOG_WARN("fail to get hash algorithm", K(sha_bit_len), K(ret));
+        } else if (OB_FAIL(ObHashUtil::hash(algo, arg0->get_string(),
+                                            alloc_guard.get_allocator(), sha_str))) {
+          LOG_WARN("fail to calc sha", K(ret));
+        } else if (OB_FAIL(ObDatumHexUtils::hex(expr, sha_str, ctx, alloc_guard.get_allocator(),
+                                                res_datums[i], false))) {
+          LOG_WARN("fail to convert sha_str to hex", K(sha_str), K(ret));
+        }
+      }
+      if (OB_SUCC(ret)) {
+        eval_flags.set(i);
+      }
+    }
+  }
+  return ret;
+}
+
 }
 }
@@ -32,6 +32,8 @@ public:
                       const ObRawExpr &raw_expr,
                       ObExpr &rt_expr) const override;
   static int eval_sha(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &expr_datum);
+  static int eval_sha_batch(const ObExpr &expr, ObEvalCtx &ctx,
+                            const ObBitVector &skip, const int64_t batch_size);
 private:
   DISALLOW_COPY_AND_ASSIGN(ObExprSha);
 };
@@ -50,6 +52,8 @@ public:
                       const ObRawExpr &raw_expr,
                       ObExpr &rt_expr) const override;
   static int eval_sha2(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &expr_datum);
+  static int eval_sha2_batch(const ObExpr &expr, ObEvalCtx &ctx,
+                             const ObBitVector &skip, const int64_t batch_size);
 private:
   DISALLOW_COPY_AND_ASSIGN(ObExprSha2);
 };
@@ -219,25 +219,20 @@ int ObExprOracleToDate::set_my_result_from_ob_time(ObExprCtx &expr_ctx,
   return ret;
 }
 
-static int calc(const ObExpr &expr, ObEvalCtx &ctx, bool &is_null, int64_t &res_int)
+static int calc_datetime(const ObSQLSessionInfo *session,
+                         const ObDatum &date_datum,
+                         const ObDatum &fmt_datum,
+                         bool &is_null,
+                         int64_t &res_int)
 {
   int ret = OB_SUCCESS;
   is_null = false;
   res_int = 0;
-  ObDatum *date_datum = NULL;
-  ObDatum *fmt_datum = NULL;
-  const ObSQLSessionInfo *session = ctx.exec_ctx_.get_my_session();
-  if (OB_ISNULL(session)) {
-    ret = OB_ERR_UNEXPECTED;
-    LOG_WARN("session is NULL", K(ret));
-  } else if (OB_FAIL(expr.args_[0]->eval(ctx, date_datum)) ||
-             OB_FAIL(expr.args_[1]->eval(ctx, fmt_datum))) {
-    LOG_WARN("eval arg failed", K(ret), KP(date_datum), KP(fmt_datum), K(expr));
-  } else if (date_datum->is_null() || fmt_datum->is_null()) {
+  if (date_datum.is_null() || fmt_datum.is_null()) {
     is_null = true;
   } else {
-    const ObString &date_str = date_datum->get_string();
-    const ObString &fmt_str = fmt_datum->get_string();
+    const ObString &date_str = date_datum.get_string();
+    const ObString &fmt_str = fmt_datum.get_string();
     ObTimeConvertCtx cvrt_ctx(TZ_INFO(session), false);
     ObDateSqlMode date_sql_mode;
     const bool no_zero_in_date = is_no_zero_in_date(session->get_sql_mode());
@@ -274,6 +269,26 @@ static int calc(const ObExpr &expr, ObEvalCtx &ctx, bool &is_null, int64_t &res_
   return ret;
 }
 
+static int calc(const ObExpr &expr, ObEvalCtx &ctx, bool &is_null, int64_t &res_int)
+{
+  int ret = OB_SUCCESS;
+  is_null = false;
+  res_int = 0;
+  ObDatum *date_datum = NULL;
+  ObDatum *fmt_datum = NULL;
+  const ObSQLSessionInfo *session = ctx.exec_ctx_.get_my_session();
+  if (OB_ISNULL(session)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("session is NULL", K(ret));
+  } else if (OB_FAIL(expr.args_[0]->eval(ctx, date_datum)) ||
+             OB_FAIL(expr.args_[1]->eval(ctx, fmt_datum))) {
+    LOG_WARN("eval arg failed", K(ret), KP(date_datum), KP(fmt_datum), K(expr));
+  } else {
+    ret = calc_datetime(session, *date_datum, *fmt_datum, is_null, res_int);
+  }
+  return ret;
+}
+
 int calc_str_to_date_expr_date(const ObExpr &expr, ObEvalCtx &ctx,
                                  ObDatum &res_datum)
 {
@@ -328,6 +343,60 @@ int calc_str_to_date_expr_datetime(const ObExpr &expr, ObEvalCtx &ctx,
   return ret;
 }
 
+int calc_str_to_date_expr_batch(const ObExpr &expr, ObEvalCtx &ctx,
+                                const ObBitVector &skip, const int64_t batch_size)
+{
+  int ret = OB_SUCCESS;
+  const ObSQLSessionInfo *session = ctx.exec_ctx_.get_my_session();
+  if (OB_ISNULL(session)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("session is NULL", K(ret));
+  } else if (OB_FAIL(expr.args_[0]->eval_batch(ctx, skip, batch_size))) {
+    LOG_WARN("eval date arg batch failed", K(ret));
+  } else if (OB_FAIL(expr.args_[1]->eval_batch(ctx, skip, batch_size))) {
+    LOG_WARN("eval format arg batch failed", K(ret));
+  } else {
+    ObDatum *res_datums = expr.locate_batch_datums(ctx);
+    ObDatumVector date_datums = expr.args_[0]->locate_expr_datumvector(ctx);
+    ObDatumVector fmt_datums = expr.args_[1]->locate_expr_datumvector(ctx);
+    ObBitVector &eval_flags = expr.get_evaluated_flags(ctx);
+    const ObObjType res_type = expr.datum_meta_.type_;
+    for (int64_t i = 0; OB_SUCC(ret) && i < batch_size; ++i) {
+      if (skip.at(i) || eval_flags.at(i)) {
+        continue;
+      }
+      bool is_null = false;
+      int64_t datetime_int = 0;
+      int32_t date_int = 0;
+      int64_t time_int = 0;
+      if (OB_FAIL(calc_datetime(session, *date_datums.at(i), *fmt_datums.at(i),
+                                is_null, datetime_int))) {
+        LOG_WARN("calc str_to_date failed", K(ret), K(expr));
+      } else if (is_null) {
+        res_datums[i].set_null();
+      } else if (ObDateType == res_type) {
+        if (OB_FAIL(ObTimeConverter::datetime_to_date(datetime_int, NULL, date_int))) {
+          LOG_WARN("datetime_to_date failed", K(ret), K(datetime_int));
+        } else {
+          res_datums[i].set_date(date_int);
+        }
+      } else if (ObTimeType == res_type) {
+        if (OB_FAIL(ObTimeConverter::datetime_to_time(datetime_int, NULL, time_int))) {
+          LOG_WARN("datetime_to_time failed", K(ret), K(datetime_int));
+        } else {
+          res_datums[i].set_time(time_int);
+        }
+      } else {
+        res_datums[i].set_datetime(datetime_int);
+      }
+      if (OB_SUCC(ret)) {
+        eval_flags.set(i);
+      }
+    }
+  }
+  return ret;
+}
+
 int ObExprStrToDate::cg_expr(ObExprCGCtx &expr_cg_ctx, const ObRawExpr &raw_expr,
                              ObExpr &rt_expr) const
 {
@@ -344,6 +413,9 @@ int ObExprStrToDate::cg_expr(ObExprCGCtx &expr_cg_ctx, const ObRawExpr &raw_expr
     ret = OB_ERR_UNEXPECTED;
     LOG_WARN("unexpected res type", K(ret), K(rt_expr.datum_meta_.type_));
   }
+  if (OB_SUCC(ret)) {
+    rt_expr.eval_batch_func_ = calc_str_to_date_expr_batch;
+  }
   return ret;
 }
 
@@ -20,6 +20,7 @@
 #include "observer/omt/ob_tenant_config_mgr.h"
 #include "sql/engine/px/ob_px_util.h"
 #include "share/diagnosis/ob_sql_monitor_statname.h"
+#include "sql/engine/table/ob_table_scan_op.h"
 
 namespace oceanbase
 {
@@ -101,7 +102,8 @@ ObHashJoinSpec::ObHashJoinSpec(common::ObIAllocator &alloc, const ObPhyOperatorT
   is_naaj_(false),
   is_sna_(false),
   is_shared_ht_(false),
-  is_ns_equal_cond_(alloc)
+  is_ns_equal_cond_(alloc),
+  probe_by_build_keys_(false)
 {
 }
 
@@ -113,7 +115,8 @@ OB_SERIALIZE_MEMBER((ObHashJoinSpec, ObJoinSpec),
                     is_naaj_,
                     is_sna_,
                     is_shared_ht_,
-                    is_ns_equal_cond_);
+                    is_ns_equal_cond_,
+                    probe_by_build_keys_);
 
 int ObHashJoinOp::PartHashJoinTable::init(ObIAllocator &alloc)
 {
@@ -250,7 +253,10 @@ ObHashJoinOp::ObHashJoinOp(ObExecContext &ctx_, const ObOpSpec &spec, ObOpInput
   non_preserved_side_is_not_empty_(false),
   null_random_hash_value_(0),
   skip_left_null_(false),
-  skip_right_null_(false)
+  skip_right_null_(false),
+  probe_key_threshold_(0),
+  collect_probe_keys_(false),
+  probe_keys_()
 {
   /*
                         read_left_row -> build_hash_table
@@ -412,6 +418,8 @@ int ObHashJoinOp::inner_open()
     if (tenant_config.is_valid()) {
       force_hash_join_spill_ = tenant_config->_force_hash_join_spill;
       hash_join_processor_ = tenant_config->_enable_hash_join_processor;
+      probe_key_threshold_ = MY_SPEC.probe_by_build_keys_
+          ? tenant_config->_hash_join_index_probe_threshold : 0;
       if (0 == (hash_join_processor_ & HJ_PROCESSOR_MASK)) {
         ret = OB_ERR_UNEXPECTED;
         LOG_WARN("unexpect hash join processor", K(ret), K(hash_join_processor_));
@@ -946,6 +954,7 @@ void ObHashJoinOp::destroy()
     DESTROY_CONTEXT(mem_context_);
     mem_context_ = NULL;
   }
+  probe_keys_.reset();
   ObJoinOp::destroy();
 }
 
@@ -2431,6 +2440,9 @@ int ObHashJoinOp::fill_partition(int64_t &num_left_rows)
           LOG_WARN("get left row hash_value failed", K(ret));
         } else if (skipped) {
           continue;
+        } else if (collect_probe_keys_
+                   && OB_FAIL(add_probe_key(left_join_keys_.at(0)->locate_expr_datum(eval_ctx_)))) {
+          LOG_WARN("failed to add probe key", K(ret));
         }
       } else {
         hash_value = left_read_row_->get_hash_value();
@@ -2474,6 +2486,15 @@ int ObHashJoinOp::fill_partition_batch(int64_t &num_left_rows)
                                             hash_vals_, hj_part_stored_rows_,
                                             is_left_side))) {
       LOG_WARN("fail to calc hash value batch", K(ret));
+    } else if (collect_probe_keys_ && !is_from_row_store) {
+      for (int64_t i = 0; OB_SUCC(ret) && collect_probe_keys_ && i < child_brs->size_; i++) {
+        if (!child_brs->skip_->exist(i)
+            && OB_FAIL(add_probe_key(left_join_keys_.at(0)->locate_expr_datum(eval_ctx_, i)))) {
+          LOG_WARN("failed to add probe key", K(ret));
+        }
+      }
+    }
+    if (OB_FAIL(ret)) {
     } else if (child_brs->size_ > 16 * part_count_) {
       // add partition by batch
       if (OB_FAIL(calc_part_idx_batch(hash_vals_, *child_brs))) {
@@ -3606,6 +3627,8 @@ int ObHashJoinOp::recursive_process(bool &need_not_read_right)
   int ret = OB_SUCCESS;
   need_not_read_right = false;
   int64_t num_left_rows = 0;
+  collect_probe_keys_ = top_part_level() && probe_key_threshold_ > 0;
+  probe_keys_.reuse();
   if (OB_FAIL(init_join_partition())) {
     LOG_WARN("fail to init join ctx", K(ret));
   } else if (OB_FAIL(split_partition_and_build_hash_table(num_left_rows))) {
@@ -3621,6 +3644,83 @@ int ObHashJoinOp::recursive_process(bool &need_not_read_right)
     LOG_DEBUG("[HASH JOIN]Left table is empty, skip reading right table.",
       K(num_left_rows), K(MY_SPEC.join_type_));
   }
+  if (OB_SUCC(ret) && collect_probe_keys_ && !need_not_read_right
+      && OB_FAIL(probe_by_build_keys())) {
+    LOG_WARN("failed to probe by build keys", K(ret));
+  }
+  collect_probe_keys_ = false;
+  return ret;
+}
+
+int ObHashJoinOp::add_probe_key(const ObDatum &datum)
+{
+  int ret = OB_SUCCESS;
+  if (datum.is_null()) {
+    // null key never matches
+  } else if (OB_FAIL(probe_keys_.push_back(datum.get_int()))) {
+    LOG_WARN("failed to push back probe key", K(ret));
+  } else if (probe_keys_.count() >= 2 * probe_key_threshold_) {
+    sort_probe_keys();
+    if (probe_keys_.count() > probe_key_threshold_) {
+      // build side is not tiny, give up
+      collect_probe_keys_ = false;
+      probe_keys_.reset();
+    }
+  }
+  return ret;
+}
+
+void ObHashJoinOp::sort_probe_keys()
+{
+  if (ob_is_uint_tc(left_join_keys_.at(0)->datum_meta_.type_)) {
+    std::sort(probe_keys_.begin(), probe_keys_.end(), [](const int64_t l, const int64_t r) {
+        return static_cast<uint64_t>(l) < static_cast<uint64_t>(r); });
+  } else {
+    std::sort(probe_keys_.begin(), probe_keys_.end());
+  }
+  int64_t cnt = std::unique(probe_keys_.begin(), probe_keys_.end()) - probe_keys_.begin();
+  while (probe_keys_.count() > cnt) {
+    probe_keys_.pop_back();
+  }
+}
+
+// The build side is fully read and tiny, so it is cheaper to get the matched rows of the
+// right table by the index than to scan it all. The right table scan turns its whole
+// range into the index prefixes of the build keys, which are probed in one multi range
+// das scan, and the rows are joined by the hash table as usual.
+int ObHashJoinOp::probe_by_build_keys()
+{
+  int ret = OB_SUCCESS;
+  bool accepted = false;
+  ObSEArray<ObObj, 16> keys;
+  sort_probe_keys();
+  if (probe_keys_.empty() || probe_keys_.count() > probe_key_threshold_) {
+    // do nothing
+  } else if (OB_ISNULL(right_) || OB_UNLIKELY(PHY_TABLE_SCAN != right_->get_spec().type_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("right child is not table scan", K(ret));
+  } else {
+    const ObObjMeta &meta = right_join_keys_.at(0)->obj_meta_;
+    const bool is_unsigned = ob_is_uint_tc(meta.get_type());
+    ObObj obj;
+    for (int64_t i = 0; OB_SUCC(ret) && i < probe_keys_.count(); ++i) {
+      if (is_unsigned) {
+        obj.set_uint(meta.get_type(), static_cast<uint64_t>(probe_keys_.at(i)));
+      } else {
+        obj.set_int(meta.get_type(), probe_keys_.at(i));
+      }
+      if (OB_FAIL(keys.push_back(obj))) {
+        LOG_WARN("failed to push back key", K(ret));
+      }
+    }
+    if (OB_FAIL(ret)) {
+    } else if (OB_FAIL(static_cast<ObTableScanOp *>(right_)->set_runtime_probe_keys(
+                keys, accepted))) {
+      LOG_WARN("failed to set runtime probe keys", K(ret));
+    }
+  }
+  LOG_TRACE("hash join probe by build keys", K(ret), K(accepted), K(probe_keys_.count()));
+  probe_keys_.reuse();
   return ret;
 }
 
@@ -256,6 +256,9 @@ public:
   bool is_shared_ht_;
   // record which equal cond is null safe equal
   common::ObFixedArray<bool, common::ObIAllocator> is_ns_equal_cond_;
+  // right child is a table scan whose index begins with the single integer join key,
+  // a tiny build side can restrict the scan to the build keys, see probe_by_build_keys()
+  bool probe_by_build_keys_;
 };
 
 // hash join has no expression result overwrite problem:
@@ -950,6 +953,9 @@ private:
 private:
   using PredFunc = std::function<bool(int64_t)>;
   int fill_partition(int64_t &num_left_rows);
+  int add_probe_key(const common::ObDatum &datum);
+  void sort_probe_keys();
+  int probe_by_build_keys();
   OB_INLINE int64_t get_part_idx(const uint64_t hash_value)
   { return (hash_value >> part_shift_) & (part_count_ - 1); }
   OB_INLINE bool top_part_level() { return 0 == part_level_; }
@@ -1251,6 +1257,10 @@ private:
   */
   bool skip_left_null_;
   bool skip_right_null_;
+  // distinct build keys collected at the top level, 0 threshold means disabled
+  int64_t probe_key_threshold_;
+  bool collect_probe_keys_;
+  common::ObSEArray<int64_t, 16> probe_keys_;
 };
 
 inline int ObHashJoinOp::init_mem_context(uint64_t tenant_id)
@@ -195,7 +195,8 @@ ObJoinFilterOp::ObJoinFilterOp(ObExecContext &exec_ctx, const ObOpSpec &spec, Ob
     filter_use_(NULL),
     filter_create_(NULL),
     bf_ch_sets_(NULL),
-    batch_hash_values_(NULL)
+    batch_hash_values_(NULL),
+    range_filter_()
 {
 }
 
@@ -231,6 +232,9 @@ int ObJoinFilterOp::inner_open()
       ret = OB_NOT_INIT;
       LOG_WARN("the bloom filter is not init", K(ret));
     }
+    if (OB_SUCC(ret)) {
+      init_range_filter();
+    }
     if (OB_SUCC(ret) && MY_SPEC.max_batch_size_ > 0) {
       if (OB_ISNULL(batch_hash_values_ =
               (uint64_t *)ctx_.get_allocator().alloc(sizeof(uint64_t) * MY_SPEC.max_batch_size_))) {
@@ -280,6 +284,7 @@ int ObJoinFilterOp::do_create_filter_rescan()
     LOG_WARN("filter create is unexpected", K(ret));
   } else {
     filter_create_->reset_filter();
+    init_range_filter();
   }
   return ret;
 }
@@ -324,6 +329,7 @@ int ObJoinFilterOp::inner_get_next_row()
         // 说明本 sqc 上的 filter 数据已经收集完毕，可以执行发送。
         // 对于local filter计划, 将filter写入manager
         // 对于shuffle filter计划, 将filter信息写入exec_ctx,由recieve算子发送rpc.
+        filter_create_->merge_range_filter(range_filter_);
         if (OB_FAIL(filter_input_->check_finish(all_is_finished, MY_SPEC.is_shared_join_filter()))) {
           LOG_WARN("fail to check all worker end", K(ret));
         } else if (all_is_finished && OB_FAIL(send_filter())) {
@@ -414,6 +420,7 @@ int ObJoinFilterOp::inner_get_next_batch(const int64_t max_row_cnt)
   if (OB_SUCC(ret) && brs_.end_) {
     if (MY_SPEC.is_create_mode()) {
       bool all_is_finished = false;
+      filter_create_->merge_range_filter(range_filter_);
       if (OB_FAIL(filter_input_->check_finish(all_is_finished, MY_SPEC.is_shared_join_filter()))) {
         LOG_WARN("fail to check all worker end", K(ret));
       } else if (all_is_finished && OB_FAIL(send_filter())) {
@@ -620,6 +627,8 @@ int ObJoinFilterOp::insert_by_row()
     /*do nothing*/
   } else if (OB_FAIL(filter_create_->put(hash_value))) {
     LOG_WARN("fail to put  hash value to px bloom filter", K(ret));
+  } else if (!range_filter_.is_disabled()) {
+    put_range_filter(MY_SPEC.join_keys_.at(0)->locate_expr_datum(eval_ctx_));
   }
   return ret;
 }
@@ -673,6 +682,8 @@ int ObJoinFilterOp::insert_by_row_batch(const ObBatchRows *child_brs)
           continue;
         } else if (OB_FAIL(filter_create_->put(batch_hash_values_[i]))) {
           LOG_WARN("fail to put  hash value to px bloom filter", K(ret));
+        } else if (!range_filter_.is_disabled()) {
+          put_range_filter(MY_SPEC.join_keys_.at(0)->locate_expr_datum(eval_ctx_, i));
         }
       }
     }
@@ -680,6 +691,31 @@ int ObJoinFilterOp::insert_by_row_batch(const ObBatchRows *child_brs)
   return ret;
 }
 
+void ObJoinFilterOp::init_range_filter()
+{
+  range_filter_.reset();
+  ObObjTypeClass tc = ObMaxTC;
+  if (MY_SPEC.is_partition_filter() || 1 != MY_SPEC.join_keys_.count()
+      || OB_ISNULL(MY_SPEC.join_keys_.at(0))) {
+    range_filter_.set_disabled();
+  } else if (FALSE_IT(tc = ob_obj_type_class(MY_SPEC.join_keys_.at(0)->datum_meta_.type_))) {
+  } else if (ObIntTC != tc && ObUIntTC != tc) {
+    range_filter_.set_disabled();
+  } else {
+    range_filter_.set_unsigned(ObUIntTC == tc);
+  }
+}
+
+void ObJoinFilterOp::put_range_filter(const ObDatum &datum)
+{
+  if (datum.is_null()) {
+    // NULL can be matched by the null safe equal, give up the range filter.
+    range_filter_.set_disabled();
+  } else {
+    range_filter_.put(datum.get_int());
+  }
+}
+
 int ObJoinFilterOp::check_contain_row(bool &match)
 {
   int ret = OB_SUCCESS;
@@ -158,6 +158,9 @@ private:
 
   int insert_by_row();
   int insert_by_row_batch(const ObBatchRows *child_brs);
+  // range and in-list are only built for a single integer join key.
+  void init_range_filter();
+  void put_range_filter(const common::ObDatum &datum);
   int check_contain_row(bool &match);
   int calc_hash_value(uint64_t &hash_value, bool &ignore);
   int calc_hash_value(uint64_t &hash_value);
@@ -172,6 +175,8 @@ public:
   ObPxBloomFilter *filter_create_;
   ObPxBloomFilterChSets *bf_ch_sets_;
   uint64_t *batch_hash_values_;
+  // built by this worker without lock, merged into filter_create_ at the end.
+  ObPxRangeInFilter range_filter_;
 };
 
 }
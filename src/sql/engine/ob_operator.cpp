@@ -18,6 +18,7 @@
 #include "sql/engine/ob_exec_context.h"
 #include "common/ob_smart_call.h"
 #include "sql/monitor/ob_plan_real_info_manager.h"
+#include "sql/engine/expr/ob_expr_filter_jit.h"
 
 namespace oceanbase
 {
@@ -127,7 +128,8 @@ ObOpSpec::ObOpSpec(ObIAllocator &alloc, const ObPhyOperatorType type)
     px_est_size_factor_(),
     plan_depth_(0),
     max_batch_size_(0),
-    need_check_output_datum_(false)
+    need_check_output_datum_(false),
+    filter_jit_(NULL)
 {
 }
 
@@ -1068,10 +1070,19 @@ int ObOperator::get_next_batch(const int64_t max_row_cnt, const ObBatchRows *&ba
           LOG_WARN("check status failed", K(ret));
         } else if (!spec_.filters_.empty()) {
           bool all_filtered = false;
-          if (OB_FAIL(filter_batch_rows(spec_.filters_,
-                                        *brs_.skip_,
-                                        brs_.size_,
-                                        all_filtered))) {
+          bool jit_done = false;
+          const ObExprFilterJit *filter_jit = ATOMIC_LOAD(&spec_.filter_jit_);
+          if (NULL != filter_jit
+              && OB_FAIL(filter_jit->filter_batch(eval_ctx_,
+                                                  *brs_.skip_,
+                                                  brs_.size_,
+                                                  all_filtered,
+                                                  jit_done))) {
+            LOG_WARN("filter batch rows by jit failed", K(ret), K_(eval_ctx));
+          } else if (!jit_done && OB_FAIL(filter_batch_rows(spec_.filters_,
+                                                            *brs_.skip_,
+                                                            brs_.size_,
+                                                            all_filtered))) {
             LOG_WARN("filter batch rows failed", K(ret), K_(eval_ctx));
           } else if (all_filtered) {
             brs_.skip_->reset(brs_.size_);
@@ -38,6 +38,7 @@ struct ObExpr;
 class ObPhysicalPlan;
 class ObOpSpec;
 class ObOperator;
+class ObExprFilterJit;
 class ObOpInput;
 class ObTaskInfo;
 
@@ -365,6 +366,9 @@ public:
   int64_t plan_depth_;
   int64_t max_batch_size_;
   bool need_check_output_datum_;
+  // Native kernel of %filters_ compiled by ObPhysicalPlan after the plan gets
+  // hot, owned by the plan and not serialized.
+  ObExprFilterJit *filter_jit_;
 
 private:
   DISALLOW_COPY_AND_ASSIGN(ObOpSpec);
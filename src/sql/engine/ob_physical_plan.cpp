@@ -31,6 +31,8 @@
 #include "sql/engine/ob_operator_factory.h"
 #include "share/stat/ob_opt_stat_manager.h"
 #include "share/ob_truncated_string.h"
+#include "sql/engine/expr/ob_expr_filter_jit.h"
+#include "common/ob_smart_call.h"
 
 namespace oceanbase
 {
@@ -100,6 +102,7 @@ ObPhysicalPlan::ObPhysicalPlan(MemoryContext &mem_context /* = CURRENT_CONTEXT *
     is_dep_base_table_(false),
     is_insert_select_(false),
     is_plain_insert_(false),
+    hot_row_update_info_(),
     flashback_query_items_(allocator_),
     contain_paramed_column_field_(false),
     first_array_index_(OB_INVALID_INDEX),
@@ -125,7 +128,9 @@ ObPhysicalPlan::ObPhysicalPlan(MemoryContext &mem_context /* = CURRENT_CONTEXT *
     min_cluster_version_(GET_MIN_CLUSTER_VERSION()),
     need_record_plan_info_(false),
     enable_append_(false),
-    append_table_id_(0)
+    append_table_id_(0),
+    filter_jit_compiled_(false),
+    filter_jits_()
 {
 }
 
@@ -185,6 +190,7 @@ void ObPhysicalPlan::reset()
   is_dep_base_table_ = false;
   is_insert_select_ = false;
   is_plain_insert_ = false;
+  hot_row_update_info_.reset();
   base_constraints_.reset();
   strict_constrinats_.reset();
   non_strict_constrinats_.reset();
@@ -215,6 +221,7 @@ void ObPhysicalPlan::reset()
   tx_id_ = -1;
   tm_sessid_ = -1;
   need_record_plan_info_ = false;
+  destroy_filter_jit();
 }
 
 void ObPhysicalPlan::destroy()
@@ -226,6 +233,71 @@ void ObPhysicalPlan::destroy()
   expr_op_factory_.destroy();
   stat_.expected_worker_map_.destroy();
   stat_.minimal_worker_map_.destroy();
+  destroy_filter_jit();
+}
+
+void ObPhysicalPlan::destroy_filter_jit()
+{
+  for (int64_t i = 0; i < filter_jits_.count(); i++) {
+    ObExprFilterJit *filter_jit = filter_jits_.at(i);
+    OB_DELETE(ObExprFilterJit, "SqlFilterJit", filter_jit);
+  }
+  filter_jits_.reset();
+  filter_jit_compiled_ = false;
+}
+
+void ObPhysicalPlan::try_compile_filter_jit(const int64_t hit_count)
+{
+  int ret = OB_SUCCESS;
+  const int64_t threshold = GCONF._sql_filter_jit_threshold;
+  if (threshold <= 0 || hit_count < threshold || NULL == root_op_spec_
+      || ATOMIC_LOAD(&filter_jit_compiled_)
+      || !ATOMIC_BCAS(&filter_jit_compiled_, false, true)) {
+    // disabled, not hot yet or compiled by another thread
+  } else if (OB_FAIL(compile_filter_jit(*root_op_spec_))) {
+    LOG_WARN("compile filter jit failed, keep the interpreted filters", K(ret),
+             K(get_plan_id()), K(hit_count));
+  }
+}
+
+int ObPhysicalPlan::compile_filter_jit(ObOpSpec &spec)
+{
+  int ret = OB_SUCCESS;
+  if (spec.is_vectorized()
+      && NULL == spec.filter_jit_
+      && ObExprFilterJit::is_supported(spec.filters_)) {
+    ObExprFilterJit *filter_jit = OB_NEW(ObExprFilterJit,
+                                         ObMemAttr(get_tenant_id(), "SqlFilterJit"),
+                                         get_tenant_id());
+    if (OB_ISNULL(filter_jit)) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("allocate filter jit failed", K(ret));
+    } else if (OB_FAIL(filter_jit->compile(spec.filters_, spec.get_id()))) {
+      LOG_WARN("compile filters failed", K(ret), K(spec.get_id()));
+    } else if (OB_FAIL(filter_jits_.push_back(filter_jit))) {
+      LOG_WARN("push back failed", K(ret));
+    } else {
+      ATOMIC_STORE(&spec.filter_jit_, filter_jit);
+    }
+    if (OB_FAIL(ret)) {
+      OB_DELETE(ObExprFilterJit, "SqlFilterJit", filter_jit);
+      // an unsupported filter should not stop the other operators
+      ret = OB_NOT_SUPPORTED == ret ? OB_SUCCESS : ret;
+    }
+  }
+  // px workers run on a deserialized copy of the dfo, kernels below the
+  // coordinator would never be used.
+  if (OB_SUCC(ret) && !IS_PX_COORD(spec.get_type())) {
+    for (int64_t i = 0; OB_SUCC(ret) && i < spec.get_child_cnt(); i++) {
+      if (OB_ISNULL(spec.get_child(i))) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("child is null", K(ret), K(i));
+      } else if (OB_FAIL(SMART_CALL(compile_filter_jit(*spec.get_child(i))))) {
+        LOG_WARN("compile filter jit failed", K(ret), K(i));
+      }
+    }
+  }
+  return ret;
 }
 
 int ObPhysicalPlan::copy_common_info(ObPhysicalPlan &src)
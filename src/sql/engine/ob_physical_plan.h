@@ -51,6 +51,7 @@ class ObTablePartitionInfo;
 class ObPhyOperatorMonnitorInfo;
 struct ObAuditRecordData;
 class ObOpSpec;
+class ObExprFilterJit;
 
 //class ObPhysicalPlan: public common::ObDLinkBase<ObPhysicalPlan>
 typedef common::ObFixedArray<common::ObFixedArray<int64_t, common::ObIAllocator>, common::ObIAllocator> PhyRowParamMap;
@@ -85,6 +86,33 @@ public:
   FlashBackQueryItemType type_;
 };
 
+// UPDATE t SET c = c +/- ? WHERE <every rowkey column> = ?, the statements of this shape
+// on the same row may be merged by ObHotRowUpdateCombiner.
+struct ObHotRowUpdateInfo
+{
+  static const int64_t MAX_ROWKEY_CNT = 4;
+  ObHotRowUpdateInfo() { reset(); }
+  void reset()
+  {
+    table_id_ = common::OB_INVALID_ID;
+    column_id_ = common::OB_INVALID_ID;
+    delta_param_idx_ = common::OB_INVALID_INDEX;
+    is_minus_ = false;
+    rowkey_cnt_ = 0;
+  }
+  bool is_valid() const { return common::OB_INVALID_ID != table_id_; }
+  TO_STRING_KV(K_(table_id), K_(column_id), K_(delta_param_idx), K_(is_minus), K_(rowkey_cnt));
+
+  uint64_t table_id_;
+  // the updated column
+  uint64_t column_id_;
+  int64_t delta_param_idx_;
+  bool is_minus_;
+  int64_t rowkey_cnt_;
+  uint64_t rowkey_column_ids_[MAX_ROWKEY_CNT];
+  int64_t rowkey_param_idxs_[MAX_ROWKEY_CNT];
+};
+
 class ObPhysicalPlan : public ObPlanCacheObject
 {
 public:
@@ -124,6 +152,11 @@ public:
                         const bool is_first,
                         const bool is_evolution,
                         const ObIArray<ObTableRowCount> *table_row_count_list);
+  // Compile the vectorized filters of the plan into native kernels once the plan
+  // has been hit _sql_filter_jit_threshold times. Only tried once per plan, called
+  // by the plan cache evict task, never on the execution path.
+  void try_compile_filter_jit(const int64_t hit_count);
+  int64_t get_hit_count() const { return ATOMIC_LOAD(&stat_.hit_count_); }
   void update_cache_access_stat(const ObTableScanStat &scan_stat)
   {
     stat_.update_cache_stat(scan_stat);
@@ -416,6 +449,8 @@ public:
   inline bool is_insert_select() const { return is_insert_select_; }
   inline void set_is_plain_insert(bool v) { is_plain_insert_ = v; }
   inline bool is_plain_insert() const { return is_plain_insert_; }
+  inline void set_hot_row_update_info(const ObHotRowUpdateInfo &info) { hot_row_update_info_ = info; }
+  inline const ObHotRowUpdateInfo &get_hot_row_update_info() const { return hot_row_update_info_; }
   inline bool should_add_baseline() const {
     return (ObStmt::is_dml_stmt(stmt_type_)
             && (stmt::T_INSERT != stmt_type_ || is_insert_select_)
@@ -473,6 +508,8 @@ private:
   static const int64_t SAMPLE_TIMES = 10;
 private:
   DISALLOW_COPY_AND_ASSIGN(ObPhysicalPlan);
+  int compile_filter_jit(ObOpSpec &spec);
+  void destroy_filter_jit();
 private:
   ObPhyPlanHint phy_hint_; //hints for this plan
   // root operator spec for static typing engine.
@@ -595,6 +632,8 @@ private:
   // insert into values(x),(x)...(x)
   bool is_plain_insert_;
   // **** for spm end ***
+  // only used by the local mysql protocol processor, not serialized
+  ObHotRowUpdateInfo hot_row_update_info_;
   //已经废弃，兼容保留
   common::ObFixedArray<FlashBackQueryItem, common::ObIAllocator> flashback_query_items_;
   // column field数组中是否有参数化的column
@@ -630,6 +669,9 @@ public:
   bool need_record_plan_info_;
   bool enable_append_; // for APPEND hint
   uint64_t append_table_id_;
+  // filter kernels compiled after the plan gets hot, see try_compile_filter_jit()
+  bool filter_jit_compiled_;
+  common::ObSEArray<ObExprFilterJit *, 4> filter_jits_;
 };
 
 inline void ObPhysicalPlan::set_affected_last_insert_id(bool affected_last_insert_id)
@@ -0,0 +1,217 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_ENG
+#include "sql/engine/px/datahub/components/ob_dh_skew_key.h"
+#include "sql/engine/px/datahub/ob_dh_msg_ctx.h"
+#include "sql/engine/px/ob_dfo.h"
+#include "sql/engine/px/ob_px_util.h"
+#include "sql/engine/px/datahub/ob_dh_msg.h"
+
+using namespace oceanbase::sql;
+using namespace oceanbase::common;
+
+OB_SERIALIZE_MEMBER(ObSkewKeyCount, hash_val_, cnt_);
+OB_SERIALIZE_MEMBER((ObSkewKeyPieceMsg, ObDatahubPieceMsg), is_build_, sample_cnt_, keys_);
+OB_SERIALIZE_MEMBER((ObSkewKeyWholeMsg, ObDatahubWholeMsg), popular_values_hash_);
+
+int ObSkewKeyPieceMsgListener::on_message(
+    ObSkewKeyPieceMsgCtx &ctx,
+    common::ObIArray<ObPxSqcMeta *> &sqcs,
+    const ObSkewKeyPieceMsg &pkt)
+{
+  int ret = OB_SUCCESS;
+  if (pkt.op_id_ != ctx.op_id_) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("unexpected piece msg", K(pkt), K(ctx));
+  } else if (pkt.is_build_) {
+    // sqcs of the build side dfo
+    if (0 == ctx.build_task_cnt_ && OB_FAIL(get_task_cnt(sqcs, ctx.build_task_cnt_))) {
+      LOG_WARN("fail to get build task count", K(ret));
+    } else if (OB_FAIL(ctx.merge_piece(pkt))) {
+      LOG_WARN("fail to merge build piece", K(ret));
+    } else if (ctx.build_received_ == ctx.build_task_cnt_) {
+      if (OB_FAIL(ctx.decide_popular_values())) {
+        LOG_WARN("fail to decide popular values", K(ret));
+      } else if (OB_FAIL(send_whole_msg(ctx, sqcs, ctx.whole_msg_))) {
+        LOG_WARN("fail to send whole msg", K(ret));
+      }
+    }
+  } else {
+    // sqcs of the probe side dfo
+    ObSkewKeyWholeMsg probe_msg;
+    if (0 == ctx.probe_task_cnt_ && OB_FAIL(get_task_cnt(sqcs, ctx.probe_task_cnt_))) {
+      LOG_WARN("fail to get probe task count", K(ret));
+    } else if (OB_FAIL(ctx.merge_piece(pkt))) {
+      LOG_WARN("fail to merge probe piece", K(ret));
+    } else if (ctx.probe_received_ < ctx.probe_task_cnt_) {
+      // wait for the other probe workers
+    } else if (OB_FAIL(ctx.get_probe_whole_msg(probe_msg))) {
+      LOG_WARN("fail to get probe whole msg", K(ret));
+    } else if (OB_FAIL(send_whole_msg(ctx, sqcs, probe_msg))) {
+      LOG_WARN("fail to send whole msg", K(ret));
+    }
+  }
+  return ret;
+}
+
+int ObSkewKeyPieceMsgListener::get_task_cnt(
+    common::ObIArray<ObPxSqcMeta *> &sqcs,
+    int64_t &task_cnt)
+{
+  int ret = OB_SUCCESS;
+  task_cnt = 0;
+  ARRAY_FOREACH_X(sqcs, idx, cnt, OB_SUCC(ret)) {
+    if (OB_ISNULL(sqcs.at(idx))) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("null sqc", K(ret));
+    } else {
+      task_cnt += sqcs.at(idx)->get_task_count();
+    }
+  }
+  return ret;
+}
+
+int ObSkewKeyPieceMsgListener::send_whole_msg(
+    ObSkewKeyPieceMsgCtx &ctx,
+    common::ObIArray<ObPxSqcMeta *> &sqcs,
+    const ObSkewKeyWholeMsg &whole_msg)
+{
+  int ret = OB_SUCCESS;
+  ARRAY_FOREACH_X(sqcs, idx, cnt, OB_SUCC(ret)) {
+    dtl::ObDtlChannel *ch = sqcs.at(idx)->get_qc_channel();
+    if (OB_ISNULL(ch)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("null expected", K(ret));
+    } else if (OB_FAIL(ch->send(whole_msg, ctx.timeout_ts_))) {
+      LOG_WARN("fail push data to channel", K(ret));
+    } else if (OB_FAIL(ch->flush(true, false))) {
+      LOG_WARN("fail flush dtl data", K(ret));
+    } else {
+      LOG_DEBUG("dispatched skew key whole msg", K(idx), K(cnt), K(whole_msg), K(*ch));
+    }
+  }
+  if (OB_SUCC(ret) && OB_FAIL(ObPxChannelUtil::sqcs_channles_asyn_wait(sqcs))) {
+    LOG_WARN("failed to wait response", K(ret));
+  }
+  return ret;
+}
+
+int ObSkewKeyPieceMsgCtx::merge_piece(const ObSkewKeyPieceMsg &pkt)
+{
+  int ret = OB_SUCCESS;
+  if (pkt.is_build_) {
+    if (build_received_ >= build_task_cnt_) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("should not receive any more pkt. already get all pkt expected",
+               K(ret), K(pkt), KPC(this));
+    } else if (OB_FAIL(append(keys_, pkt.keys_))) {
+      LOG_WARN("fail to append keys", K(ret));
+    } else {
+      sample_cnt_ += pkt.sample_cnt_;
+      build_received_++;
+      LOG_TRACE("got a skew key build piece msg", "all_got", build_received_,
+                "expected", build_task_cnt_);
+    }
+  } else if (probe_received_ >= probe_task_cnt_) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("should not receive any more pkt. already get all pkt expected",
+             K(ret), K(pkt), KPC(this));
+  } else {
+    probe_received_++;
+  }
+  return ret;
+}
+
+// the probe side gets the build side decision, or an empty set when the build side
+// has not decided yet, which falls back to plain hash distribution
+int ObSkewKeyPieceMsgCtx::get_probe_whole_msg(ObSkewKeyWholeMsg &whole_msg) const
+{
+  int ret = OB_SUCCESS;
+  whole_msg.reset();
+  whole_msg.op_id_ = op_id_;
+  if (decided_ && OB_FAIL(whole_msg.assign(whole_msg_))) {
+    LOG_WARN("fail to assign whole msg", K(ret));
+  }
+  return ret;
+}
+
+// keys whose frequency in the whole sample reach min_freq_ are popular
+int ObSkewKeyPieceMsgCtx::decide_popular_values()
+{
+  int ret = OB_SUCCESS;
+  whole_msg_.reset();
+  whole_msg_.op_id_ = op_id_;
+  if (sample_cnt_ >= MIN_SAMPLE_ROW_CNT && !keys_.empty()) {
+    // merge the counts of the same key reported by different workers
+    std::sort(keys_.begin(), keys_.end(), [](const ObSkewKeyCount &l, const ObSkewKeyCount &r) {
+        return l.hash_val_ < r.hash_val_; });
+    int64_t merged_cnt = 0;
+    for (int64_t i = 0; i < keys_.count(); ++i) {
+      if (merged_cnt > 0 && keys_.at(merged_cnt - 1).hash_val_ == keys_.at(i).hash_val_) {
+        keys_.at(merged_cnt - 1).cnt_ += keys_.at(i).cnt_;
+      } else {
+        keys_.at(merged_cnt++) = keys_.at(i);
+      }
+    }
+    std::sort(keys_.begin(), keys_.begin() + merged_cnt,
+              [](const ObSkewKeyCount &l, const ObSkewKeyCount &r) { return l.cnt_ > r.cnt_; });
+    for (int64_t i = 0; OB_SUCC(ret) && i < merged_cnt
+         && whole_msg_.popular_values_hash_.count() < MAX_POPULAR_VALUE_CNT; ++i) {
+      const ObSkewKeyCount &key = keys_.at(i);
+      if (key.cnt_ * 100 < min_freq_ * sample_cnt_) {
+        break;
+      } else if (OB_FAIL(whole_msg_.popular_values_hash_.push_back(key.hash_val_))) {
+        LOG_WARN("fail to push back popular value", K(ret));
+      }
+    }
+  }
+  if (OB_SUCC(ret)) {
+    decided_ = true;
+    LOG_TRACE("skew key decided", K(sample_cnt_), K(min_freq_), K(whole_msg_));
+  }
+  return ret;
+}
+
+int ObSkewKeyPieceMsgCtx::alloc_piece_msg_ctx(const ObSkewKeyPieceMsg &pkt,
+                                              ObPxCoordInfo &,
+                                              ObExecContext &ctx,
+                                              int64_t task_cnt,
+                                              ObPieceMsgCtx *&msg_ctx)
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(ctx.get_my_session()) ||
+      OB_ISNULL(ctx.get_physical_plan_ctx())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("session is null or physical plan ctx is null", K(ret));
+  } else {
+    void *buf = ctx.get_allocator().alloc(sizeof(ObSkewKeyPieceMsgCtx));
+    if (OB_ISNULL(buf)) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+    } else {
+      msg_ctx = new (buf) ObSkewKeyPieceMsgCtx(pkt.op_id_, task_cnt,
+          ctx.get_physical_plan_ctx()->get_timeout_timestamp(),
+          ctx.get_my_session()->get_px_join_skew_minfreq());
+    }
+  }
+  return ret;
+}
+
+int ObSkewKeyWholeMsg::assign(const ObSkewKeyWholeMsg &other)
+{
+  int ret = OB_SUCCESS;
+  op_id_ = other.op_id_;
+  if (OB_FAIL(popular_values_hash_.assign(other.popular_values_hash_))) {
+    LOG_WARN("fail to assign popular values", K(ret));
+  }
+  return ret;
+}
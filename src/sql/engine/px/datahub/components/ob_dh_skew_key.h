@@ -0,0 +1,166 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef __OB_SQL_ENG_PX_DH_SKEW_KEY_H__
+#define __OB_SQL_ENG_PX_DH_SKEW_KEY_H__
+
+#include "sql/engine/px/datahub/ob_dh_msg.h"
+#include "sql/engine/px/datahub/ob_dh_dtl_proc.h"
+#include "sql/engine/px/datahub/ob_dh_msg_ctx.h"
+#include "sql/engine/px/datahub/ob_dh_msg_provider.h"
+
+namespace oceanbase
+{
+namespace sql
+{
+
+class ObSkewKeyPieceMsg;
+class ObSkewKeyWholeMsg;
+typedef ObPieceMsgP<ObSkewKeyPieceMsg> ObSkewKeyPieceMsgP;
+typedef ObWholeMsgP<ObSkewKeyWholeMsg> ObSkewKeyWholeMsgP;
+class ObSkewKeyPieceMsgListener;
+class ObSkewKeyPieceMsgCtx;
+class ObPxCoordInfo;
+
+// hash value of a join key and its count in the sample
+struct ObSkewKeyCount
+{
+  OB_UNIS_VERSION_V(1);
+public:
+  ObSkewKeyCount() : hash_val_(0), cnt_(0) {}
+  ObSkewKeyCount(const uint64_t hash_val, const int64_t cnt) : hash_val_(hash_val), cnt_(cnt) {}
+  TO_STRING_KV(K_(hash_val), K_(cnt));
+  uint64_t hash_val_;
+  int64_t cnt_;
+};
+
+/*
+ * 运行时的 join 倾斜检测，用于 hybrid hash 分发：
+ *  - build 侧 transmit 对第一个 batch 的 join key 采样，上报出现次数最多的若干个 key，
+ *    QC 汇总全部 build 侧 worker 的采样后，把占比达到 _px_join_skew_minfreq 的 key
+ *    作为 popular value 下发。build 侧 popular value 的行广播，其余的行按 hash 分发。
+ *  - probe 侧 transmit 不上报 key，只等待 popular value，它使用 build 侧 transmit 的
+ *    op id 发送 piece，从而与 build 侧落在同一个 ctx 里。probe 侧 popular value 的行
+ *    随机分发。
+ *  probe 侧的 popular value 必须是 build 侧的子集。如果 probe 侧的 piece 收齐时
+ *  build 侧还没有决定，直接给 probe 侧下发空集，退化为普通的 hash 分发，结果依然正确，
+ *  也不会让 probe 侧等待 build 侧。
+ */
+class ObSkewKeyPieceMsg
+  : public ObDatahubPieceMsg<dtl::ObDtlMsgType::DH_SKEW_KEY_PIECE_MSG>
+{
+  OB_UNIS_VERSION_V(1);
+public:
+  using PieceMsgListener = ObSkewKeyPieceMsgListener;
+  using PieceMsgCtx = ObSkewKeyPieceMsgCtx;
+public:
+  ObSkewKeyPieceMsg() : is_build_(true), sample_cnt_(0), keys_() {}
+  ~ObSkewKeyPieceMsg() = default;
+  void reset()
+  {
+    is_build_ = true;
+    sample_cnt_ = 0;
+    keys_.reset();
+  }
+  INHERIT_TO_STRING_KV("meta", ObDatahubPieceMsg<dtl::ObDtlMsgType::DH_SKEW_KEY_PIECE_MSG>,
+                       K_(op_id), K_(is_build), K_(sample_cnt), K_(keys));
+public:
+  bool is_build_;
+  // rows sampled by this worker
+  int64_t sample_cnt_;
+  // the most frequent keys in the sample, build side only
+  common::ObSEArray<ObSkewKeyCount, 8> keys_;
+};
+
+class ObSkewKeyWholeMsg
+    : public ObDatahubWholeMsg<dtl::ObDtlMsgType::DH_SKEW_KEY_WHOLE_MSG>
+{
+  OB_UNIS_VERSION_V(1);
+public:
+  using WholeMsgProvider = ObWholeMsgProvider<ObSkewKeyWholeMsg>;
+public:
+  ObSkewKeyWholeMsg() : popular_values_hash_() {}
+  ~ObSkewKeyWholeMsg() = default;
+  int assign(const ObSkewKeyWholeMsg &other);
+  void reset() { popular_values_hash_.reset(); }
+  VIRTUAL_TO_STRING_KV(K_(op_id), K_(popular_values_hash));
+  common::ObSEArray<uint64_t, 8> popular_values_hash_;
+};
+
+class ObSkewKeyPieceMsgCtx : public ObPieceMsgCtx
+{
+public:
+  ObSkewKeyPieceMsgCtx(uint64_t op_id, int64_t task_cnt, int64_t timeout_ts, int64_t min_freq)
+    : ObPieceMsgCtx(op_id, task_cnt, timeout_ts), min_freq_(min_freq),
+      build_task_cnt_(0), build_received_(0), probe_task_cnt_(0), probe_received_(0),
+      sample_cnt_(0), decided_(false), keys_(), whole_msg_() {}
+  ~ObSkewKeyPieceMsgCtx() = default;
+  virtual void destroy()
+  {
+    keys_.reset();
+    whole_msg_.reset();
+  }
+  INHERIT_TO_STRING_KV("meta", ObPieceMsgCtx, K_(min_freq), K_(build_task_cnt),
+                       K_(build_received), K_(probe_task_cnt), K_(probe_received),
+                       K_(sample_cnt), K_(decided));
+
+  static int alloc_piece_msg_ctx(const ObSkewKeyPieceMsg &pkt,
+                                 ObPxCoordInfo &coord_info,
+                                 ObExecContext &ctx,
+                                 int64_t task_cnt,
+                                 ObPieceMsgCtx *&msg_ctx);
+
+  // count the piece of a build or probe worker, the task count of its side must be set
+  int merge_piece(const ObSkewKeyPieceMsg &pkt);
+  int decide_popular_values();
+  int get_probe_whole_msg(ObSkewKeyWholeMsg &whole_msg) const;
+
+  // keys reported by each build worker
+  static const int64_t MAX_REPORT_KEY_CNT = 16;
+  static const int64_t MAX_POPULAR_VALUE_CNT = 16;
+  // too few rows tell nothing about the skew
+  static const int64_t MIN_SAMPLE_ROW_CNT = 256;
+public:
+  int64_t min_freq_; // percent
+  int64_t build_task_cnt_;
+  int64_t build_received_;
+  int64_t probe_task_cnt_;
+  int64_t probe_received_;
+  int64_t sample_cnt_;
+  bool decided_;
+  common::ObArray<ObSkewKeyCount> keys_;
+  ObSkewKeyWholeMsg whole_msg_;
+private:
+  DISALLOW_COPY_AND_ASSIGN(ObSkewKeyPieceMsgCtx);
+};
+
+class ObSkewKeyPieceMsgListener
+{
+public:
+  ObSkewKeyPieceMsgListener() = default;
+  ~ObSkewKeyPieceMsgListener() = default;
+  static int on_message(
+      ObSkewKeyPieceMsgCtx &ctx,
+      common::ObIArray<ObPxSqcMeta *> &sqcs,
+      const ObSkewKeyPieceMsg &pkt);
+private:
+  static int get_task_cnt(common::ObIArray<ObPxSqcMeta *> &sqcs, int64_t &task_cnt);
+  static int send_whole_msg(ObSkewKeyPieceMsgCtx &ctx,
+                            common::ObIArray<ObPxSqcMeta *> &sqcs,
+                            const ObSkewKeyWholeMsg &whole_msg);
+  DISALLOW_COPY_AND_ASSIGN(ObSkewKeyPieceMsgListener);
+};
+
+}
+}
+#endif /* __OB_SQL_ENG_PX_DH_SKEW_KEY_H__ */
+//// end of header file
@@ -29,7 +29,8 @@ namespace sql
 OB_SERIALIZE_MEMBER((ObPxDistTransmitOpInput, ObPxTransmitOpInput));
 
 OB_SERIALIZE_MEMBER((ObPxDistTransmitSpec, ObPxTransmitSpec), dist_exprs_,
-    dist_hash_funcs_, sort_cmp_funs_, sort_collations_, calc_tablet_id_expr_, popular_values_hash_);
+    dist_hash_funcs_, sort_cmp_funs_, sort_collations_, calc_tablet_id_expr_, popular_values_hash_,
+    skew_sample_op_id_);
 
 int ObPxDistTransmitOp::inner_open()
 {
@@ -315,13 +316,23 @@ int ObPxDistTransmitOp::do_broadcast_dist()
 int ObPxDistTransmitOp::do_hybrid_hash_random_dist()
 {
   int ret = OB_SUCCESS;
-  ObHybridHashRandomSliceIdCalc slice_id_calc(
-      ctx_.get_allocator(), task_channels_.count(),
-      MY_SPEC.null_row_dist_method_,
-      &MY_SPEC.dist_exprs_, &MY_SPEC.dist_hash_funcs_,
-      &MY_SPEC.popular_values_hash_);
-  if (OB_FAIL(send_rows(slice_id_calc))) {
-    LOG_WARN("row distribution failed", K(ret));
+  if (OB_INVALID_ID != MY_SPEC.skew_sample_op_id_ && !skew_sampled_) {
+    if (OB_FAIL(do_datahub_skew_sample())) {
+      LOG_WARN("fail to do skew sample", K(ret));
+    } else {
+      skew_sampled_ = true;
+    }
+  }
+  if (OB_SUCC(ret)) {
+    ObHybridHashRandomSliceIdCalc slice_id_calc(
+        ctx_.get_allocator(), task_channels_.count(),
+        MY_SPEC.null_row_dist_method_,
+        &MY_SPEC.dist_exprs_, &MY_SPEC.dist_hash_funcs_,
+        skew_sampled_ ? static_cast<const ObIArray<uint64_t> *>(&skew_values_hash_)
+                      : &MY_SPEC.popular_values_hash_);
+    if (OB_FAIL(send_rows(slice_id_calc))) {
+      LOG_WARN("row distribution failed", K(ret));
+    }
   }
   return ret;
 }
@@ -329,13 +340,127 @@ int ObPxDistTransmitOp::do_hybrid_hash_random_dist()
 int ObPxDistTransmitOp::do_hybrid_hash_broadcast_dist()
 {
   int ret = OB_SUCCESS;
-  ObHybridHashBroadcastSliceIdCalc slice_id_calc(
-      ctx_.get_allocator(), task_channels_.count(),
-      MY_SPEC.null_row_dist_method_,
-      &MY_SPEC.dist_exprs_, &MY_SPEC.dist_hash_funcs_,
-      &MY_SPEC.popular_values_hash_);
-  if (OB_FAIL(send_rows(slice_id_calc))) {
-    LOG_WARN("row distribution failed", K(ret));
+  if (OB_INVALID_ID != MY_SPEC.skew_sample_op_id_ && !skew_sampled_) {
+    if (OB_FAIL(do_datahub_skew_sample())) {
+      LOG_WARN("fail to do skew sample", K(ret));
+    } else {
+      skew_sampled_ = true;
+    }
+  }
+  if (OB_SUCC(ret)) {
+    ObHybridHashBroadcastSliceIdCalc slice_id_calc(
+        ctx_.get_allocator(), task_channels_.count(),
+        MY_SPEC.null_row_dist_method_,
+        &MY_SPEC.dist_exprs_, &MY_SPEC.dist_hash_funcs_,
+        skew_sampled_ ? static_cast<const ObIArray<uint64_t> *>(&skew_values_hash_)
+                      : &MY_SPEC.popular_values_hash_);
+    if (OB_FAIL(send_rows(slice_id_calc))) {
+      LOG_WARN("row distribution failed", K(ret));
+    }
+  }
+  return ret;
+}
+
+// The build side reports the join keys of the first batch fetched in inner_open(),
+// which is still in the output and will be sent as usual. The probe side reports
+// nothing, see ObSkewKeyPieceMsg. Popular values from the datahub are added to the
+// ones from the histogram.
+int ObPxDistTransmitOp::do_datahub_skew_sample()
+{
+  int ret = OB_SUCCESS;
+  ObPxSqcHandler *handler = ctx_.get_sqc_handler();
+  if (OB_ISNULL(handler)) {
+    ret = OB_NOT_SUPPORTED;
+    LOG_WARN("skew sample only supported in parallel execution mode", K(ret));
+    LOG_USER_ERROR(OB_NOT_SUPPORTED, "skew sample in non-px mode");
+  } else if (OB_FAIL(skew_values_hash_.assign(MY_SPEC.popular_values_hash_))) {
+    LOG_WARN("fail to assign popular values", K(ret));
+  } else {
+    ObPxSQCProxy &proxy = handler->get_sqc_proxy();
+    const ObSkewKeyWholeMsg *whole_msg = NULL;
+    ObSkewKeyPieceMsg piece;
+    piece.op_id_ = MY_SPEC.skew_sample_op_id_;
+    piece.thread_id_ = GETTID();
+    piece.source_dfo_id_ = proxy.get_dfo_id();
+    piece.target_dfo_id_ = proxy.get_dfo_id();
+    piece.is_build_ = ObPQDistributeMethod::HYBRID_HASH_BROADCAST == MY_SPEC.dist_method_;
+    if (piece.is_build_ && OB_FAIL(build_skew_key_piece_msg(piece))) {
+      LOG_WARN("fail to build skew key piece msg", K(ret));
+    } else if (OB_FAIL(proxy.get_dh_msg(MY_SPEC.skew_sample_op_id_,
+        dtl::DH_SKEW_KEY_WHOLE_MSG,
+        piece,
+        whole_msg,
+        ctx_.get_physical_plan_ctx()->get_timeout_timestamp()))) {
+      LOG_WARN("fail get skew key msg", K(ret));
+    } else if (OB_ISNULL(whole_msg)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("whole msg is unexpected", K(ret));
+    } else {
+      for (int64_t i = 0; OB_SUCC(ret) && i < whole_msg->popular_values_hash_.count(); ++i) {
+        const uint64_t hash_val = whole_msg->popular_values_hash_.at(i);
+        if (has_exist_in_array(skew_values_hash_, hash_val)) {
+          // already popular in histogram
+        } else if (OB_FAIL(skew_values_hash_.push_back(hash_val))) {
+          LOG_WARN("fail to push back popular value", K(ret));
+        }
+      }
+      LOG_TRACE("skew sample done", K(piece), K(*whole_msg), K(skew_values_hash_));
+    }
+  }
+  return ret;
+}
+
+int ObPxDistTransmitOp::build_skew_key_piece_msg(ObSkewKeyPieceMsg &piece_msg)
+{
+  int ret = OB_SUCCESS;
+  ObSEArray<uint64_t, 256> hash_vals;
+  ObHashSliceIdCalc hash_calc(ctx_.get_allocator(), task_channels_.count(),
+                              MY_SPEC.null_row_dist_method_,
+                              &MY_SPEC.dist_exprs_, &MY_SPEC.dist_hash_funcs_);
+  if (iter_end_) {
+    // no rows, report an empty sample
+  } else if (is_vectorized()) {
+    ObEvalCtx::BatchInfoScopeGuard batch_info_guard(eval_ctx_);
+    batch_info_guard.set_batch_size(brs_.size_);
+    for (int64_t i = 0; OB_SUCC(ret) && i < brs_.size_; i++) {
+      uint64_t hash_val = 0;
+      if (brs_.skip_->at(i)) {
+        continue;
+      }
+      batch_info_guard.set_batch_idx(i);
+      if (OB_FAIL(hash_calc.calc_hash_value(eval_ctx_, hash_val))) {
+        LOG_WARN("fail to calc hash value", K(ret));
+      } else if (OB_FAIL(hash_vals.push_back(hash_val))) {
+        LOG_WARN("fail to push back hash value", K(ret));
+      }
+    }
+  } else {
+    uint64_t hash_val = 0;
+    if (OB_FAIL(hash_calc.calc_hash_value(eval_ctx_, hash_val))) {
+      LOG_WARN("fail to calc hash value", K(ret));
+    } else if (OB_FAIL(hash_vals.push_back(hash_val))) {
+      LOG_WARN("fail to push back hash value", K(ret));
+    }
+  }
+  if (OB_SUCC(ret) && !hash_vals.empty()) {
+    // count each key and report the most frequent ones
+    std::sort(hash_vals.begin(), hash_vals.end());
+    for (int64_t i = 0, j = 0; OB_SUCC(ret) && i < hash_vals.count(); i = j) {
+      while (j < hash_vals.count() && hash_vals.at(j) == hash_vals.at(i)) {
+        ++j;
+      }
+      if (OB_FAIL(piece_msg.keys_.push_back(ObSkewKeyCount(hash_vals.at(i), j - i)))) {
+        LOG_WARN("fail to push back key", K(ret));
+      }
+    }
+    if (OB_SUCC(ret)) {
+      std::sort(piece_msg.keys_.begin(), piece_msg.keys_.end(),
+                [](const ObSkewKeyCount &l, const ObSkewKeyCount &r) { return l.cnt_ > r.cnt_; });
+      while (piece_msg.keys_.count() > ObSkewKeyPieceMsgCtx::MAX_REPORT_KEY_CNT) {
+        piece_msg.keys_.pop_back();
+      }
+      piece_msg.sample_cnt_ = hash_vals.count();
+    }
   }
   return ret;
 }
@@ -473,6 +598,7 @@ void ObPxDistTransmitOp::destroy()
     mem_context_ = NULL;
   }
   sampled_input_rows_.set_mem_stat(NULL);
+  skew_values_hash_.reset();
   ObPxTransmitOp::destroy();
 }
 
@@ -590,6 +716,26 @@ int ObPxDistTransmitSpec::register_to_datahub(ObExecContext &ctx) const
         }
       }
     }
+  } else if (OB_INVALID_ID != skew_sample_op_id_) {
+    if (OB_ISNULL(ctx.get_sqc_handler())) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("null unexpected", K(ret));
+    } else {
+      void *buf = ctx.get_allocator().alloc(sizeof(ObSkewKeyWholeMsg::WholeMsgProvider));
+      if (OB_ISNULL(buf)) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+      } else {
+        ObSkewKeyWholeMsg::WholeMsgProvider *provider =
+          new (buf)ObSkewKeyWholeMsg::WholeMsgProvider();
+        ObSqcCtx &sqc_ctx = ctx.get_sqc_handler()->get_sqc_ctx();
+        // the probe side registers with the op id of the build side transmit
+        if (OB_FAIL(sqc_ctx.add_whole_msg_provider(skew_sample_op_id_,
+                                                   dtl::DH_SKEW_KEY_WHOLE_MSG,
+                                                   *provider))) {
+          LOG_WARN("fail add whole msg provider", K(ret));
+        }
+      }
+    }
   }
   return ret;
 }
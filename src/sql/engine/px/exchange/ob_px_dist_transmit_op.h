@@ -16,6 +16,7 @@
 #include "ob_px_transmit_op.h"
 #include "sql/engine/sort/ob_sort_basic_info.h"
 #include "sql/engine/ob_tenant_sql_memory_manager.h"
+#include "sql/engine/px/datahub/components/ob_dh_skew_key.h"
 
 namespace oceanbase
 {
@@ -44,7 +45,8 @@ public:
     sort_cmp_funs_(alloc),
     sort_collations_(alloc),
     popular_values_hash_(alloc),
-    calc_tablet_id_expr_(NULL)
+    calc_tablet_id_expr_(NULL),
+    skew_sample_op_id_(common::OB_INVALID_ID)
   {}
   ~ObPxDistTransmitSpec() {}
   virtual int register_to_datahub(ObExecContext &ctx) const override;
@@ -54,6 +56,10 @@ public:
   ObSortCollations sort_collations_;
   common::ObFixedArray<uint64_t, ObIAllocator> popular_values_hash_; // for hybrid hash distribution
   ObExpr *calc_tablet_id_expr_;   // for slave mapping
+  // for hybrid hash distribution, detect popular values by sampling at runtime.
+  // it's the op id of the build side transmit for both sides of the join,
+  // OB_INVALID_ID if disabled.
+  uint64_t skew_sample_op_id_;
 };
 
 class ObPxDistTransmitOp : public ObPxTransmitOp
@@ -63,7 +69,9 @@ public:
   : ObPxTransmitOp(exec_ctx, spec, input),
     mem_context_(NULL),
     profile_(ObSqlWorkAreaType::HASH_WORK_AREA),
-    sql_mem_processor_(profile_, op_monitor_info_)
+    sql_mem_processor_(profile_, op_monitor_info_),
+    skew_sampled_(false),
+    skew_values_hash_()
   {}
   virtual ~ObPxDistTransmitOp() {}
 public:
@@ -101,6 +109,9 @@ protected:
 private:
   int build_row_sample_piece_msg(int64_t expected_range_count,
     ObDynamicSamplePieceMsg &piece_msg);
+  // get popular values of hybrid hash distribution from the datahub
+  int do_datahub_skew_sample();
+  int build_skew_key_piece_msg(ObSkewKeyPieceMsg &piece_msg);
 
   // for range distribution to backup && restore last row/batch
   ObChunkDatumStore::ShadowStoredRow last_row_;
@@ -111,6 +122,11 @@ private:
   lib::MemoryContext mem_context_;
   ObSqlWorkAreaProfile profile_;
   ObSqlMemMgrProcessor sql_mem_processor_;
+
+  // for runtime skew detection of hybrid hash distribution, sampled only once
+  // and kept across rescan, since the datahub won't answer twice.
+  bool skew_sampled_;
+  common::ObSEArray<uint64_t, 8> skew_values_hash_;
 };
 
 } // end namespace sql
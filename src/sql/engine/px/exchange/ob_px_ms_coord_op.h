@@ -161,6 +161,7 @@ private:
   ObInitChannelPieceMsgP init_channel_piece_msg_proc_;
   ObReportingWFPieceMsgP reporting_wf_piece_msg_proc_;
   ObOptStatsGatherPieceMsgP opt_stats_gather_piece_msg_proc_;
+  ObSkewKeyPieceMsgP skew_key_piece_msg_proc_;
   // 存储merge sort的每一路的当前行
   ObArray<ObChunkDatumStore::LastStoredRow*> store_rows_;
   ObChunkDatumStore::LastStoredRow* last_pop_row_;
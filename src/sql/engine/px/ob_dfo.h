@@ -377,6 +377,7 @@ public:
     is_fulltree_(false),
     is_rpc_worker_(false),
     earlier_sched_(false),
+    bushy_sched_(false),
     qc_server_id_(common::OB_INVALID_ID),
     parent_dfo_id_(common::OB_INVALID_ID),
     px_sequence_id_(common::OB_INVALID_ID),
@@ -500,6 +501,8 @@ public:
   bool is_active() const { return is_active_; }
   void set_scheduled() { is_scheduled_ = true; }
   bool is_scheduled() const { return is_scheduled_; }
+  void set_bushy_sched() { bushy_sched_ = true; }
+  bool is_bushy_sched() const { return bushy_sched_; }
   void set_thread_inited(bool v) { thread_inited_ = v; }
   bool is_thread_inited() const { return thread_inited_; }
   void set_thread_finish(bool v) { thread_finish_ = v; }
@@ -566,6 +569,7 @@ public:
                K_(dfo_id),
                K_(is_active),
                K_(earlier_sched),
+               K_(bushy_sched),
                K_(is_scheduled),
                K_(thread_inited),
                K_(thread_finish),
@@ -640,6 +644,7 @@ private:
   bool is_fulltree_;
   bool is_rpc_worker_;
   bool earlier_sched_; // 标记本 dfo 是否是因为 3 DFO 调度策略而被提前调度起来了
+  bool bushy_sched_; // 标记本 dfo 是否是 bushy 调度额外调度起来的
   uint64_t qc_server_id_;
   int64_t parent_dfo_id_;
   uint64_t px_sequence_id_;
@@ -65,7 +65,7 @@ int ObDfoSchedDepthGenerator::generate_sched_depth(ObExecContext &exec_ctx,
                                                    ObDfoMgr &dfo_mgr)
 {
   int ret = OB_SUCCESS;
-  if (GCONF._px_max_pipeline_depth > 2) {
+  if (GCONF._px_max_pipeline_depth > 2 || GCONF._px_enable_bushy_dfo_scheduling) {
     ObDfo *dfo_tree = dfo_mgr.get_root_dfo();
     if (OB_ISNULL(dfo_tree)) {
       ret = OB_ERR_UNEXPECTED;
@@ -92,7 +92,7 @@ int ObDfoSchedDepthGenerator::do_generate_sched_depth(ObExecContext &exec_ctx,
     } else if (OB_FAIL(do_generate_sched_depth(exec_ctx, dfo_mgr, *child))) {
       LOG_WARN("fail do generate edge", K(*child), K(ret));
     } else {
-      bool need_earlier_sched = check_if_need_do_earlier_sched(*child);
+      bool need_earlier_sched = check_if_need_do_earlier_sched(dfo_mgr, *child, parent);
       if (need_earlier_sched) {
         // child 里面的 material 被改造成了 bypass 的，所以 parent 必须提前调度起来
         // 同时，parent 中如果也有 material，必须标记为 block，不可 bypass。否则会 hang。
@@ -114,7 +114,9 @@ int ObDfoSchedDepthGenerator::do_generate_sched_depth(ObExecContext &exec_ctx,
   return ret;
 }
 
-bool ObDfoSchedDepthGenerator::check_if_need_do_earlier_sched(ObDfo &child)
+bool ObDfoSchedDepthGenerator::check_if_need_do_earlier_sched(ObDfoMgr &dfo_mgr,
+                                                               ObDfo &child,
+                                                               ObDfo &parent)
 {
   bool do_earlier_sched = false;
   if (child.is_earlier_sched() == false) {
@@ -123,6 +125,21 @@ bool ObDfoSchedDepthGenerator::check_if_need_do_earlier_sched(ObDfo &child)
       phy_op = static_cast<const ObTransmitSpec *>(phy_op)->get_child();
       do_earlier_sched = phy_op && PHY_MATERIAL == phy_op->type_;
     }
+    if (do_earlier_sched && GCONF._px_max_pipeline_depth <= 2) {
+      // bushy 调度下，只有 child 的孩子、child、parent 三个 DFO 同时调度
+      // 不超过 admission 分得的线程数时，才让 child 的 material bypass
+      int64_t max_grandchild_worker = 0;
+      for (int64_t i = 0; i < child.get_child_count(); ++i) {
+        ObDfo *grandchild = NULL;
+        if (OB_SUCCESS == child.get_child_dfo(i, grandchild) && OB_NOT_NULL(grandchild)) {
+          max_grandchild_worker = std::max(max_grandchild_worker,
+                                           grandchild->get_assigned_worker_count());
+        }
+      }
+      do_earlier_sched = dfo_mgr.get_admited_worker_count() > 0
+          && max_grandchild_worker + child.get_assigned_worker_count()
+             + parent.get_assigned_worker_count() <= dfo_mgr.get_admited_worker_count();
+    }
   } else {
     // dfo (child) 是 earlier sched，那么可以知道 dfo 的 material 会阻塞对外吐数据.
     // 此时 dfo 的 parent 没有必要提前调度，因为没有任何数据给它消费. parent 依靠
@@ -321,6 +338,7 @@ int ObDfoMgr::init(ObExecContext &exec_ctx,
 {
   int ret = OB_SUCCESS;
   root_dfo_ = NULL;
+  admited_worker_count_ = admited_worker_count;
   ObDfo *rpc_dfo = nullptr;
   if (inited_) {
     ret = OB_INIT_TWICE;
@@ -332,13 +350,14 @@ int ObDfoMgr::init(ObExecContext &exec_ctx,
     LOG_WARN("NULL dfo unexpected", K(ret));
   } else if (OB_FAIL(ObDfoSchedOrderGenerator::generate_sched_order(*this))) {
     LOG_WARN("fail init dfo mgr", K(ret));
-  } else if (OB_FAIL(ObDfoSchedDepthGenerator::generate_sched_depth(exec_ctx, *this))) {
-    LOG_WARN("fail init dfo mgr", K(ret));
   } else if (OB_FAIL(ObDfoWorkerAssignment::assign_worker(*this,
                                                           expected_worker_count,
                                                           admited_worker_count))) {
     LOG_WARN("fail assign worker to dfos",
              K(admited_worker_count), K(expected_worker_count), K(ret));
+  } else if (OB_FAIL(ObDfoSchedDepthGenerator::generate_sched_depth(exec_ctx, *this))) {
+    // 依赖 assign_worker 分配的线程数来判断 bushy 调度下能否提前调度
+    LOG_WARN("fail init dfo mgr", K(ret));
   } else {
     if (1 == edges_.count() && OB_NOT_NULL(rpc_dfo = edges_.at(0))) {
       rpc_dfo->set_rpc_worker(1 == rpc_dfo->get_dop());
@@ -564,6 +583,7 @@ int ObDfoMgr::get_ready_dfos(ObIArray<ObDfo*> &dfos) const
   int ret = OB_SUCCESS;
   bool all_finish = true;
   bool got_pair_dfo = false;
+  bool wait_bushy_dfo = false;
   dfos.reset();
 
   LOG_TRACE("ready dfos", K(edges_.count()));
@@ -580,11 +600,13 @@ int ObDfoMgr::get_ready_dfos(ObIArray<ObDfo*> &dfos) const
       //  - edge 已经调度起来，则看这个 edge 是否依赖其它 dfo 才能完成执行
       all_finish = false;
       if (!edge->is_active()) {
-        if (OB_FAIL(dfos.push_back(edge))) {
-          LOG_WARN("fail push dfo", K(ret));
-        } else if (NULL == edge->parent()) {
+        if (NULL == edge->parent()) {
           ret = OB_ERR_UNEXPECTED;
           LOG_WARN("parent is NULL, unexpected", K(ret));
+        } else if (need_wait_bushy_dfo(*edge, *edge->parent())) {
+          wait_bushy_dfo = true;
+        } else if (OB_FAIL(dfos.push_back(edge))) {
+          LOG_WARN("fail push dfo", K(ret));
         } else if (OB_FAIL(dfos.push_back(edge->parent()))) {
           LOG_WARN("fail push dfo", K(ret));
         } else {
@@ -605,11 +627,13 @@ int ObDfoMgr::get_ready_dfos(ObIArray<ObDfo*> &dfos) const
         } else if (sibling_edge->is_active()) {
           // nop, wait for a sibling finish.
           // after then can we shedule next edge
-        } else if (OB_FAIL(dfos.push_back(sibling_edge))) {
-          LOG_WARN("fail push dfo", K(ret));
         } else if (NULL == sibling_edge->parent()) {
           ret = OB_ERR_UNEXPECTED;
           LOG_WARN("parent is NULL, unexpected", K(ret));
+        } else if (need_wait_bushy_dfo(*sibling_edge, *sibling_edge->parent())) {
+          wait_bushy_dfo = true;
+        } else if (OB_FAIL(dfos.push_back(sibling_edge))) {
+          LOG_WARN("fail push dfo", K(ret));
         } else if (OB_FAIL(dfos.push_back(sibling_edge->parent()))) {
           LOG_WARN("fail push dfo", K(ret));
         } else {
@@ -624,7 +648,8 @@ int ObDfoMgr::get_ready_dfos(ObIArray<ObDfo*> &dfos) const
       // 三层 DFO 调度逻辑
       // 注意：即使上面有 sibling 被调度起来了，已经调度了 3 个 DFO
       // 也还是会去尝试调度第 4 个 depend parent dfo
-      if (OB_SUCC(ret) && !got_pair_dfo && GCONF._px_max_pipeline_depth > 2) {
+      if (OB_SUCC(ret) && !got_pair_dfo && !wait_bushy_dfo &&
+          (GCONF._px_max_pipeline_depth > 2 || GCONF._px_enable_bushy_dfo_scheduling)) {
         ObDfo *parent_edge = edge->parent();
         if (NULL != parent_edge &&
             !parent_edge->is_active() &&
@@ -640,7 +665,9 @@ int ObDfoMgr::get_ready_dfos(ObIArray<ObDfo*> &dfos) const
            * 并且，parent 的执行依赖于 parent-parent 也被调度（2+dfo调度优化，hash join 的
            * 结果可以直接输出，无需在上面加 material 算子）
            */
-          if (OB_FAIL(dfos.push_back(parent_edge))) {
+          if (need_wait_bushy_dfo(*parent_edge, *parent_edge->parent())) {
+            wait_bushy_dfo = true;
+          } else if (OB_FAIL(dfos.push_back(parent_edge))) {
             LOG_WARN("fail push dfo", K(ret));
           } else if (OB_FAIL(dfos.push_back(parent_edge->parent()))) {
             LOG_WARN("fail push dfo", K(ret));
@@ -689,12 +716,128 @@ int ObDfoMgr::get_ready_dfos(ObIArray<ObDfo*> &dfos) const
       break;
     }
   }
+  if (OB_SUCC(ret) && !all_finish && !got_pair_dfo && !wait_bushy_dfo
+      && GCONF._px_enable_bushy_dfo_scheduling) {
+    if (OB_FAIL(get_bushy_ready_dfos(dfos))) {
+      LOG_WARN("fail get bushy ready dfos", K(ret));
+    }
+  }
   if (all_finish && OB_SUCCESS == ret) {
     ret = OB_ITER_END;
   }
   return ret;
 }
 
+// 按调度顺序找到第一个可以和正在运行的 DFO 并发执行的 DFO 对：
+//   - child 是叶子 DFO，且不在 depend sibling 链表的后继位置上
+//   - parent 已经调度，即 parent 的前一个孩子已经调度起来了，child 不会抢在它前面执行
+//   - 新增的线程数加上正在运行的 DFO 的线程数不超过 admission 分得的线程数
+int ObDfoMgr::get_bushy_ready_dfos(ObIArray<ObDfo*> &dfos) const
+{
+  int ret = OB_SUCCESS;
+  if (admited_worker_count_ > 0) {
+    int64_t running_worker_count = 0;
+    int64_t bushy_worker_count = 0;
+    get_running_worker_count(running_worker_count, bushy_worker_count);
+    for (int64_t i = 0; OB_SUCC(ret) && dfos.empty() && i < edges_.count(); ++i) {
+      ObDfo *edge = edges_.at(i);
+      if (is_bushy_candidate(*edge)) {
+        ObDfo *parent = edge->parent();
+        const int64_t need_worker_count = edge->get_assigned_worker_count();
+        if (running_worker_count + need_worker_count > admited_worker_count_) {
+          // 线程不够，后面的 DFO 对也不再尝试，保持调度顺序
+          break;
+        } else if (OB_FAIL(dfos.push_back(edge))) {
+          LOG_WARN("fail push dfo", K(ret));
+        } else if (OB_FAIL(dfos.push_back(parent))) {
+          LOG_WARN("fail push dfo", K(ret));
+        } else {
+          edge->set_active();
+          edge->set_bushy_sched();
+          LOG_TRACE("bushy schedule dfo", K(running_worker_count), K(need_worker_count),
+                    K_(admited_worker_count), K(*edge), K(*parent));
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+bool ObDfoMgr::is_bushy_candidate(ObDfo &edge) const
+{
+  bool bret = !edge.is_active()
+      && !edge.is_thread_finish()
+      && !edge.has_child_dfo()
+      && !edge.has_dml_op()
+      && !edge.has_temp_table_scan()
+      && !edge.is_px_use_bloom_filter()
+      && NULL != edge.parent()
+      && root_dfo_ != edge.parent();
+  if (bret) {
+    ObDfo *parent = edge.parent();
+    bret = parent->is_scheduled()
+        && !parent->is_thread_finish()
+        && !parent->has_dml_op()
+        && !parent->has_temp_table_scan();
+  }
+  // depend sibling 链表上的后继需要等前驱执行完成，由正常的调度流程推进
+  for (int64_t i = 0; bret && i < edges_.count(); ++i) {
+    const ObDfo *other = edges_.at(i);
+    if (other != &edge && other->has_depend_sibling()) {
+      for (const ObDfo *sibling = other->depend_sibling();
+           bret && NULL != sibling;
+           sibling = sibling->depend_sibling()) {
+        bret = (sibling != &edge);
+      }
+    }
+  }
+  return bret;
+}
+
+// bushy 调度开启时，正常调度流程同样受 admission 分得的线程数约束：
+// 如果是 bushy 调度额外调度起来的 DFO 占着线程，使得 child、parent 放不下，
+// 就等这些 DFO 执行完成再调度。它们的 parent 已经调度，不依赖正常流程推进，一定能执行完。
+// 不算 bushy 调度的 DFO 也放不下时，和关闭 bushy 调度的行为保持一致，直接调度
+bool ObDfoMgr::need_wait_bushy_dfo(const ObDfo &child, const ObDfo &parent) const
+{
+  bool bret = false;
+  if (GCONF._px_enable_bushy_dfo_scheduling && admited_worker_count_ > 0) {
+    int64_t running_worker_count = 0;
+    int64_t bushy_worker_count = 0;
+    int64_t need_worker_count = 0;
+    get_running_worker_count(running_worker_count, bushy_worker_count);
+    if (!child.is_active() && !child.is_scheduled()) {
+      need_worker_count += child.get_assigned_worker_count();
+    }
+    if (root_dfo_ != &parent && !parent.is_active() && !parent.is_scheduled()) {
+      need_worker_count += parent.get_assigned_worker_count();
+    }
+    bret = bushy_worker_count > 0
+        && running_worker_count + need_worker_count > admited_worker_count_
+        && running_worker_count - bushy_worker_count + need_worker_count <= admited_worker_count_;
+    if (bret) {
+      LOG_TRACE("wait bushy dfo to release workers", K(running_worker_count),
+                K(bushy_worker_count), K(need_worker_count), K_(admited_worker_count));
+    }
+  }
+  return bret;
+}
+
+void ObDfoMgr::get_running_worker_count(int64_t &worker_count, int64_t &bushy_worker_count) const
+{
+  worker_count = 0;
+  bushy_worker_count = 0;
+  for (int64_t i = 0; i < edges_.count(); ++i) {
+    const ObDfo *edge = edges_.at(i);
+    if ((edge->is_active() || edge->is_scheduled()) && !edge->is_thread_finish()) {
+      worker_count += edge->get_assigned_worker_count();
+      if (edge->is_bushy_sched()) {
+        bushy_worker_count += edge->get_assigned_worker_count();
+      }
+    }
+  }
+}
+
 int ObDfoMgr::add_dfo_edge(ObDfo *edge)
 {
   int ret = OB_SUCCESS;
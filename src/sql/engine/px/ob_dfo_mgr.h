@@ -27,7 +27,7 @@ class ObDfoMgr
 public:
   explicit ObDfoMgr(common::ObIAllocator &allocator) :
       allocator_(allocator), inited_(false),
-      root_dfo_(NULL)
+      root_dfo_(NULL), admited_worker_count_(0)
   {}
   virtual ~ObDfoMgr() = default;
   void destroy();
@@ -38,6 +38,7 @@ public:
                    int64_t admited_worker_count,
                    const ObDfoInterruptIdGen &dfo_int_gen);
   ObDfo *get_root_dfo() { return root_dfo_; }
+  int64_t get_admited_worker_count() const { return admited_worker_count_; }
   
   virtual int get_ready_dfo(ObDfo *&dfo) const; // 仅用于单层dfo调度
   // 可以入选即将调度队列的 DFO
@@ -64,10 +65,16 @@ private:
   int create_dfo(common::ObIAllocator &allocator,
                  const ObOpSpec *dfo_root_op,
                  ObDfo *&dfo) const;
+  // 并发调度与当前 DFO 对相互独立的 DFO 对，只要 admission 分得的线程还有富余
+  int get_bushy_ready_dfos(common::ObIArray<ObDfo *> &dfos) const;
+  bool is_bushy_candidate(ObDfo &edge) const;
+  bool need_wait_bushy_dfo(const ObDfo &child, const ObDfo &parent) const;
+  void get_running_worker_count(int64_t &worker_count, int64_t &bushy_worker_count) const;
 protected:
   common::ObIAllocator &allocator_;
   bool inited_;
   ObDfo *root_dfo_;
+  int64_t admited_worker_count_;
   common::ObSEArray<ObDfo *, 2> edges_;
 private:
   DISALLOW_COPY_AND_ASSIGN(ObDfoMgr);
@@ -89,7 +96,7 @@ private:
   static int do_generate_sched_depth(ObExecContext &ctx, ObDfoMgr &dfo_mgr, ObDfo &root);
   static int try_set_dfo_block(ObExecContext &exec_ctx, ObDfo &dfo, bool block = true);
   static int try_set_dfo_unblock(ObExecContext &exec_ctx, ObDfo &dfo);
-  static bool check_if_need_do_earlier_sched(ObDfo &child);
+  static bool check_if_need_do_earlier_sched(ObDfoMgr &dfo_mgr, ObDfo &child, ObDfo &parent);
 };
 
 class ObDfoWorkerAssignment
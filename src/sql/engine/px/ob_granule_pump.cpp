@@ -211,6 +211,108 @@ int ObGITaskSet::set_block_order(bool desc)
   return ret;
 }
 
+// Merge the tasks of the shared pool in the manner of guided self scheduling: a
+// fetch at the head of the pool takes up to %max_merge_cnt tasks of one tablet
+// to keep the fetch and rescan overhead low, while the tasks near the tail are
+// handed out one by one, so that a worker getting the last task does not hold
+// the whole DFO.
+int ObGITaskSet::adjust_granule_size(int64_t parallelism, int64_t max_merge_cnt)
+{
+  int ret = OB_SUCCESS;
+  // [task_begins[i], task_begins[i + 1]) is the i-th task in gi_task_set_
+  ObArray<int64_t> task_begins;
+  ObArray<int64_t> tablet_order;
+  ObArray<int64_t> next_in_tablet;
+  ObArray<bool> merged;
+  common::ObArray<ObGITaskInfo> new_task_set;
+  if (parallelism <= 0 || max_merge_cnt <= 1 || gi_task_set_.count() <= 1) {
+    // do nothing
+  } else {
+    for (int64_t i = 0; OB_SUCC(ret) && i < gi_task_set_.count(); i++) {
+      if (OB_ISNULL(gi_task_set_.at(i).tablet_loc_)) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("tablet loc is null", K(ret), K(i));
+      } else if ((0 == i || gi_task_set_.at(i).idx_ != gi_task_set_.at(i - 1).idx_)
+                 && OB_FAIL(task_begins.push_back(i))) {
+        LOG_WARN("failed to push back task begin", K(ret));
+      }
+    }
+    const int64_t task_cnt = task_begins.count();
+    if (OB_FAIL(ret)) {
+    } else if (task_cnt <= parallelism * 2) {
+      // every task is already at the tail, do nothing
+    } else if (OB_FAIL(task_begins.push_back(gi_task_set_.count()))) {
+      LOG_WARN("failed to push back task end", K(ret));
+    } else if (OB_FAIL(tablet_order.reserve(task_cnt))
+               || OB_FAIL(next_in_tablet.prepare_allocate(task_cnt))
+               || OB_FAIL(merged.prepare_allocate(task_cnt))
+               || OB_FAIL(new_task_set.reserve(gi_task_set_.count()))) {
+      LOG_WARN("failed to reserve memory", K(ret), K(task_cnt));
+    } else {
+      for (int64_t i = 0; OB_SUCC(ret) && i < task_cnt; i++) {
+        merged.at(i) = false;
+        if (OB_FAIL(tablet_order.push_back(i))) {
+          LOG_WARN("failed to push back task", K(ret));
+        }
+      }
+      if (OB_SUCC(ret)) {
+        // chain the tasks of each tablet in their order in the pool
+        auto compare_fun = [&](const int64_t l, const int64_t r) -> bool {
+          const uint64_t l_tablet = gi_task_set_.at(task_begins.at(l)).tablet_loc_->tablet_id_.id();
+          const uint64_t r_tablet = gi_task_set_.at(task_begins.at(r)).tablet_loc_->tablet_id_.id();
+          return l_tablet < r_tablet || (l_tablet == r_tablet && l < r);
+        };
+        std::sort(tablet_order.begin(), tablet_order.end(), compare_fun);
+        for (int64_t i = 0; i < task_cnt; i++) {
+          const int64_t task = tablet_order.at(i);
+          next_in_tablet.at(task) = -1;
+          if (i + 1 < task_cnt) {
+            const int64_t next = tablet_order.at(i + 1);
+            if (gi_task_set_.at(task_begins.at(task)).tablet_loc_->tablet_id_ ==
+                gi_task_set_.at(task_begins.at(next)).tablet_loc_->tablet_id_) {
+              next_in_tablet.at(task) = next;
+            }
+          }
+        }
+      }
+      // The first task not merged yet is always the head of its tablet chain,
+      // so the following tasks of the chain are not merged either.
+      int64_t remain_cnt = task_cnt;
+      int64_t head = 0;
+      while (OB_SUCC(ret) && remain_cnt > 0) {
+        while (merged.at(head)) {
+          head++;
+        }
+        const int64_t merge_cnt = min(max_merge_cnt, max(1L, remain_cnt / (parallelism * 2)));
+        const int64_t new_idx = gi_task_set_.at(task_begins.at(head)).idx_;
+        int64_t task = head;
+        for (int64_t i = 0; OB_SUCC(ret) && i < merge_cnt && task >= 0; i++) {
+          for (int64_t j = task_begins.at(task); OB_SUCC(ret) && j < task_begins.at(task + 1); j++) {
+            ObGITaskInfo task_info = gi_task_set_.at(j);
+            task_info.idx_ = new_idx;
+            if (OB_FAIL(new_task_set.push_back(task_info))) {
+              LOG_WARN("failed to push back task info", K(ret));
+            }
+          }
+          merged.at(task) = true;
+          remain_cnt--;
+          task = next_in_tablet.at(task);
+        }
+      }
+      if (OB_SUCC(ret)) {
+        if (OB_FAIL(gi_task_set_.assign(new_task_set))) {
+          LOG_WARN("failed to assign task info", K(ret));
+        } else {
+          cur_pos_ = 0;
+        }
+      }
+      LOG_TRACE("adjust granule size", K(ret), K(task_cnt), K(parallelism), K(max_merge_cnt),
+                K(gi_task_set_.count()));
+    }
+  }
+  return ret;
+}
+
 int ObGITaskSet::construct_taskset(ObIArray<ObDASTabletLoc*> &taskset_tablets,
                                    ObIArray<ObNewRange> &taskset_ranges,
                                    ObIArray<ObNewRange> &ss_ranges,
@@ -715,7 +817,8 @@ int ObGranuleSplitter::split_gi_task(ObGranulePumpArgs &args,
                                      const common::ObIArray<ObDASTabletLoc*> &tablets,
                                      bool partition_granule,
                                      ObGITaskSet &task_set,
-                                     ObGITaskSet::ObGIRandomType random_type)
+                                     ObGITaskSet::ObGIRandomType random_type,
+                                     int64_t split_factor /* = 1 */)
 {
   int ret = OB_SUCCESS;
   ObSEArray<ObNewRange, 16> ranges;
@@ -744,7 +847,7 @@ int ObGranuleSplitter::split_gi_task(ObGranulePumpArgs &args,
                                                        ranges,
                                                        tablets,
                                                        args.parallelism_,
-                                                       args.tablet_size_,
+                                                       max(args.tablet_size_ / max(split_factor, 1L), 1L),
                                                        partition_granule,
                                                        taskset_tablets,
                                                        taskset_ranges,
@@ -931,6 +1034,10 @@ int ObRandomGranuleSplitter::split_granule(ObGranulePumpArgs &args,
       ObGITaskSet total_task_set;
       ObGITaskArray &taskset_array = gi_task_array_result.at(idx).taskset_array_;
       partition_granule = is_virtual_table(scan_key_id) || partition_granule;
+      const int64_t split_factor = get_split_factor(partition_granule,
+                                                    random_type,
+                                                    args.gi_attri_flag_,
+                                                    GCONF._px_adaptive_granule_factor);
       if (OB_FAIL(split_gi_task(args,
                                 tsc,
                                 scan_key_id,
@@ -938,11 +1045,15 @@ int ObRandomGranuleSplitter::split_granule(ObGranulePumpArgs &args,
                                 tablet_arrays.at(idx),
                                 partition_granule,
                                 total_task_set,
-                                random_type))) {
+                                random_type,
+                                split_factor))) {
         LOG_WARN("failed to init granule iter pump", K(ret), K(idx), K(tablet_arrays));
       } else if (OB_FAIL(total_task_set.set_block_order(
             ObGranuleUtil::desc_order(args.gi_attri_flag_)))) {
         LOG_WARN("fail set block order", K(ret));
+      } else if (split_factor > 1
+                 && OB_FAIL(total_task_set.adjust_granule_size(args.parallelism_, split_factor))) {
+        LOG_WARN("fail to adjust granule size", K(ret), K(split_factor));
       } else if (OB_FAIL(taskset_array.push_back(total_task_set))) {
         LOG_WARN("failed to push back task set", K(ret));
       } else {
@@ -955,6 +1066,23 @@ int ObRandomGranuleSplitter::split_granule(ObGranulePumpArgs &args,
   return ret;
 }
 
+// Split the block granules finer and merge them back by adjust_granule_size(),
+// only for the unordered scans whose tasks are taken in block order.
+int64_t ObRandomGranuleSplitter::get_split_factor(bool partition_granule,
+                                                  ObGITaskSet::ObGIRandomType random_type,
+                                                  uint64_t gi_attri_flag,
+                                                  int64_t adaptive_granule_factor)
+{
+  int64_t split_factor = 1;
+  if (!partition_granule
+      && ObGITaskSet::GI_RANDOM_NONE == random_type
+      && !ObGranuleUtil::asc_order(gi_attri_flag)
+      && !ObGranuleUtil::desc_order(gi_attri_flag)) {
+    split_factor = max(adaptive_granule_factor, 1L);
+  }
+  return split_factor;
+}
+
 // duplicate all scan ranges to each worker, so that every worker can
 // access all data
 int ObAccessAllGranuleSplitter::split_tasks_access_all(ObGITaskSet &taskset,
@@ -140,6 +140,9 @@ public:
   int assign(const ObGITaskSet &other);
   int set_pw_affi_partition_order(bool asc);
   int set_block_order(bool asc);
+  // merge the tasks of the same tablet so that the task size decreases from
+  // %max_merge_cnt tasks at the head to a single task at the tail.
+  int adjust_granule_size(int64_t parallelism, int64_t max_merge_cnt);
   int construct_taskset(common::ObIArray<ObDASTabletLoc*> &taskset_tablets,
                         common::ObIArray<ObNewRange> &taskset_ranges,
                         common::ObIArray<ObNewRange> &ss_ranges,
@@ -202,7 +205,8 @@ protected :
                     const common::ObIArray<ObDASTabletLoc*> &tablets,
                     bool partition_granule,
                     ObGITaskSet &task_set,
-                    ObGITaskSet::ObGIRandomType random_type);
+                    ObGITaskSet::ObGIRandomType random_type,
+                    int64_t split_factor = 1);
 
 public :
   ObSEArray<ObPxTabletInfo, 8> partitions_info_;
@@ -218,6 +222,11 @@ public :
                     GITaskArrayMap &gi_task_array_result,
                     ObGITaskSet::ObGIRandomType random_type,
                     bool partition_granule = true);
+  // the factor the block granules are split finer by, 1 if the scan is not split adaptively
+  static int64_t get_split_factor(bool partition_granule,
+                                  ObGITaskSet::ObGIRandomType random_type,
+                                  uint64_t gi_attri_flag,
+                                  int64_t adaptive_granule_factor);
 private:
 };
 
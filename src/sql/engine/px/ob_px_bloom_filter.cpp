@@ -35,9 +35,133 @@ using namespace obrpc;
 #define LOG_HASH_COUNT 2        // = log2(FIXED_HASH_COUNT)
 #define WORD_SIZE 64            // WORD_SIZE * FIXED_HASH_COUNT = BF_BLOCK_SIZE
 
+void ObPxRangeInFilter::put(const int64_t v)
+{
+  if (DISABLED == state_) {
+  } else if (EMPTY == state_) {
+    state_ = VALID;
+    min_ = v;
+    max_ = v;
+    in_cnt_ = 1;
+    in_values_[0] = v;
+  } else {
+    if (less(v, min_)) {
+      min_ = v;
+    } else if (less(max_, v)) {
+      max_ = v;
+    }
+    add_in_value(v);
+  }
+}
+
+void ObPxRangeInFilter::merge(const ObPxRangeInFilter &other)
+{
+  if (DISABLED == state_ || EMPTY == other.state_) {
+  } else if (DISABLED == other.state_ || (VALID == state_ && is_unsigned_ != other.is_unsigned_)) {
+    state_ = DISABLED;
+  } else if (EMPTY == state_) {
+    *this = other;
+  } else {
+    if (less(other.min_, min_)) {
+      min_ = other.min_;
+    }
+    if (less(max_, other.max_)) {
+      max_ = other.max_;
+    }
+    if (!other.has_in_list()) {
+      in_cnt_ = MAX_IN_CNT + 1;
+    } else {
+      for (int64_t i = 0; has_in_list() && i < other.in_cnt_; ++i) {
+        add_in_value(other.in_values_[i]);
+      }
+    }
+  }
+}
+
+int64_t ObPxRangeInFilter::lower_bound(const int64_t v) const
+{
+  int64_t lo = 0;
+  int64_t hi = in_cnt_;
+  while (lo < hi) {
+    const int64_t mid = (lo + hi) / 2;
+    if (less(in_values_[mid], v)) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+void ObPxRangeInFilter::add_in_value(const int64_t v)
+{
+  if (has_in_list()) {
+    const int64_t pos = lower_bound(v);
+    if (pos < in_cnt_ && v == in_values_[pos]) {
+    } else if (in_cnt_ == MAX_IN_CNT) {
+      in_cnt_ = MAX_IN_CNT + 1;
+    } else {
+      MEMMOVE(in_values_ + pos + 1, in_values_ + pos, (in_cnt_ - pos) * sizeof(int64_t));
+      in_values_[pos] = v;
+      ++in_cnt_;
+    }
+  }
+}
+
+OB_DEF_SERIALIZE(ObPxRangeInFilter)
+{
+  int ret = OB_SUCCESS;
+  LST_DO_CODE(OB_UNIS_ENCODE,
+              state_,
+              is_unsigned_,
+              min_,
+              max_,
+              in_cnt_);
+  for (int64_t i = 0; OB_SUCC(ret) && has_in_list() && i < in_cnt_; ++i) {
+    OB_UNIS_ENCODE(in_values_[i]);
+  }
+  return ret;
+}
+
+OB_DEF_DESERIALIZE(ObPxRangeInFilter)
+{
+  int ret = OB_SUCCESS;
+  LST_DO_CODE(OB_UNIS_DECODE,
+              state_,
+              is_unsigned_,
+              min_,
+              max_,
+              in_cnt_);
+  if (OB_FAIL(ret)) {
+  } else if (OB_UNLIKELY(in_cnt_ < 0 || in_cnt_ > MAX_IN_CNT + 1)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("invalid in cnt of range filter", K(ret), K(in_cnt_));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && has_in_list() && i < in_cnt_; ++i) {
+    OB_UNIS_DECODE(in_values_[i]);
+  }
+  return ret;
+}
+
+OB_DEF_SERIALIZE_SIZE(ObPxRangeInFilter)
+{
+  int64_t len = 0;
+  LST_DO_CODE(OB_UNIS_ADD_LEN,
+              state_,
+              is_unsigned_,
+              min_,
+              max_,
+              in_cnt_);
+  for (int64_t i = 0; has_in_list() && i < in_cnt_; ++i) {
+    OB_UNIS_ADD_LEN(in_values_[i]);
+  }
+  return len;
+}
+
 ObPxBloomFilter::ObPxBloomFilter() : data_length_(0), bits_count_(0), fpp_(0.0),
     hash_func_count_(0), is_inited_(false), bits_array_length_(0),
-    bits_array_(NULL), true_count_(0), begin_idx_(0), end_idx_(0), allocator_(),
+    bits_array_(NULL), true_count_(0), begin_idx_(0), end_idx_(0), range_filter_(),
+    allocator_(), range_filter_lock_(),
     px_bf_recieve_count_(0), px_bf_recieve_size_(0), px_bf_merge_filter_count_(0)
 {
 
@@ -93,12 +217,14 @@ int ObPxBloomFilter::init(ObPxBloomFilter *filter)
     bits_array_ = filter->bits_array_;
     true_count_ = filter->true_count_;
     might_contain_ = filter->might_contain_;
+    range_filter_ = filter->range_filter_;
   }
   return ret;
 }
 void ObPxBloomFilter::reset_filter()
 {
   MEMSET(bits_array_, 0, bits_array_length_ * sizeof(int64_t));
+  range_filter_.reset();
   px_bf_recieve_count_ = 0;
   px_bf_recieve_size_ = 0;
 }
@@ -203,10 +329,17 @@ int ObPxBloomFilter::merge_filter(ObPxBloomFilter *filter)
         new_v = old_v | filter->bits_array_[i];
       } while(ATOMIC_CAS(&bits_array_[i + filter->begin_idx_], old_v, new_v) != old_v);
     }
+    merge_range_filter(filter->range_filter_);
   }
   return ret;
 }
 
+void ObPxBloomFilter::merge_range_filter(const ObPxRangeInFilter &other)
+{
+  ObSpinLockGuard guard(range_filter_lock_);
+  range_filter_.merge(other);
+}
+
 bool ObPxBloomFilter::check_ready()
 {
   return px_bf_recieve_count_ > 0 &&
@@ -320,6 +453,7 @@ OB_DEF_SERIALIZE(ObPxBloomFilter)
       LOG_WARN("fail to encode bits data", K(ret), K(bits_array_[i]));
     }
   }
+  OB_UNIS_ENCODE(range_filter_);
   return ret;
 }
 
@@ -358,6 +492,9 @@ OB_DEF_DESERIALIZE(ObPxBloomFilter)
                        : &ObPxBloomFilter::might_contain_nonsimd;
     }
   }
+  // the sender without range filter can not be trusted to be empty.
+  range_filter_.set_disabled();
+  OB_UNIS_DECODE(range_filter_);
   return ret;
 }
 
@@ -377,6 +514,7 @@ OB_DEF_SERIALIZE_SIZE(ObPxBloomFilter)
   for (int i = begin_idx_; i <= end_idx_; ++i) {
     len += serialization::encoded_length(bits_array_[i]);
   }
+  OB_UNIS_ADD_LEN(range_filter_);
   return len;
 }
 
@@ -52,6 +52,89 @@ struct BloomFilterIndex
   TO_STRING_KV(K_(begin_idx), K_(end_idx));
 };
 
+// Min/max and small sorted IN-list of a single integer join key, built along
+// with the bloom filter. Unlike the bloom filter they are exact, so the probe
+// side can push them down to the storage as white filters (between / in) that
+// are evaluated on the encoded columns.
+class ObPxRangeInFilter
+{
+  OB_UNIS_VERSION(1);
+public:
+  enum State
+  {
+    // no key put or merged yet, the identity of merge.
+    EMPTY = 0,
+    VALID,
+    // key type not supported or NULL key met, can not filter anything.
+    DISABLED,
+  };
+  static const int64_t MAX_IN_CNT = 64;
+  ObPxRangeInFilter() { reset(); }
+  void reset()
+  {
+    state_ = EMPTY;
+    is_unsigned_ = false;
+    min_ = 0;
+    max_ = 0;
+    in_cnt_ = 0;
+  }
+  void set_unsigned(const bool is_unsigned) { is_unsigned_ = is_unsigned; }
+  void set_disabled() { state_ = DISABLED; }
+  bool is_valid() const { return VALID == state_; }
+  bool is_disabled() const { return DISABLED == state_; }
+  bool is_unsigned() const { return is_unsigned_; }
+  // in_cnt_ > MAX_IN_CNT means the in-list overflowed and only the range is kept.
+  bool has_in_list() const { return in_cnt_ <= MAX_IN_CNT; }
+  int64_t get_in_cnt() const { return in_cnt_; }
+  int64_t get_in_value(const int64_t idx) const { return in_values_[idx]; }
+  int64_t get_min() const { return min_; }
+  int64_t get_max() const { return max_; }
+  void put(const int64_t v);
+  void merge(const ObPxRangeInFilter &other);
+  // always true if the filter is not valid.
+  bool might_contain(const int64_t v) const
+  {
+    bool contain = true;
+    if (!is_valid()) {
+    } else if (less(v, min_) || less(max_, v)) {
+      contain = false;
+    } else if (has_in_list()) {
+      const int64_t pos = lower_bound(v);
+      contain = pos < in_cnt_ && v == in_values_[pos];
+    }
+    return contain;
+  }
+  ObPxRangeInFilter &operator=(const ObPxRangeInFilter &other)
+  {
+    if (this != &other) {
+      state_ = other.state_;
+      is_unsigned_ = other.is_unsigned_;
+      min_ = other.min_;
+      max_ = other.max_;
+      in_cnt_ = other.in_cnt_;
+      if (has_in_list()) {
+        MEMCPY(in_values_, other.in_values_, in_cnt_ * sizeof(int64_t));
+      }
+    }
+    return *this;
+  }
+  TO_STRING_KV(K_(state), K_(is_unsigned), K_(min), K_(max), K_(in_cnt));
+private:
+  bool less(const int64_t l, const int64_t r) const
+  {
+    return is_unsigned_ ? static_cast<uint64_t>(l) < static_cast<uint64_t>(r) : l < r;
+  }
+  int64_t lower_bound(const int64_t v) const;
+  void add_in_value(const int64_t v);
+private:
+  int8_t state_;
+  bool is_unsigned_;
+  int64_t min_;
+  int64_t max_;
+  int64_t in_cnt_;
+  int64_t in_values_[MAX_IN_CNT];
+};
+
 class ObPxBloomFilter
 {
 OB_UNIS_VERSION_V(1);
@@ -89,8 +172,11 @@ public:
   typedef int (ObPxBloomFilter::*GetFunc)(uint64_t hash, bool &is_match);
   int generate_receive_count_array();
   void reset();
+  const ObPxRangeInFilter &get_range_filter() const { return range_filter_; }
+  // called by each worker building the filter and for each piece received.
+  void merge_range_filter(const ObPxRangeInFilter &other);
   TO_STRING_KV(K_(data_length), K_(bits_count), K_(fpp), K_(hash_func_count), K_(is_inited),
-      K_(bits_array_length), K_(true_count));
+      K_(bits_array_length), K_(true_count), K_(range_filter));
 private:
   bool get(uint64_t pos, uint64_t index) { return (bits_array_[pos] & index) != 0; }
   bool set(uint64_t block_begin, uint64_t index);
@@ -111,8 +197,10 @@ private:
   int64_t begin_idx_;            // join filter begin position
   int64_t end_idx_;              // join filter end position
   GetFunc might_contain_;       // function pointer for might contain
+  ObPxRangeInFilter range_filter_; // carried as a whole by every piece sent
 private:
   common::ObArenaAllocator allocator_;
+  common::ObSpinLock range_filter_lock_;
 public:
   //无需序列化
    int64_t px_bf_recieve_count_;  // 当前收到bloom filter的个数
@@ -668,6 +668,7 @@ int ObPxCoordOp::wait_all_running_dfos_exit()
     ObReportingWFPieceMsgP reporting_wf_piece_msg_proc(ctx_, terminate_msg_proc);
     ObPxQcInterruptedP interrupt_proc(ctx_, terminate_msg_proc);
     ObOptStatsGatherPieceMsgP opt_stats_gather_piece_msg_proc(ctx_, terminate_msg_proc);
+    ObSkewKeyPieceMsgP skew_key_piece_msg_proc(ctx_, terminate_msg_proc);
 
     // 这个注册会替换掉旧的proc.
     (void)msg_loop_.clear_all_proc();
@@ -683,7 +684,8 @@ int ObPxCoordOp::wait_all_running_dfos_exit()
       .register_processor(rd_wf_piece_msg_proc)
       .register_processor(init_channel_piece_msg_proc)
       .register_processor(reporting_wf_piece_msg_proc)
-      .register_processor(opt_stats_gather_piece_msg_proc);
+      .register_processor(opt_stats_gather_piece_msg_proc)
+      .register_processor(skew_key_piece_msg_proc);
     loop.ignore_interrupt();
 
     ObPxControlChannelProc control_channels;
@@ -745,6 +747,7 @@ int ObPxCoordOp::wait_all_running_dfos_exit()
           case ObDtlMsgType::DH_INIT_CHANNEL_PIECE_MSG:
           case ObDtlMsgType::DH_SECOND_STAGE_REPORTING_WF_PIECE_MSG:
           case ObDtlMsgType::DH_OPT_STATS_GATHER_PIECE_MSG:
+          case ObDtlMsgType::DH_SKEW_KEY_PIECE_MSG:
             break;
           default:
             ret = OB_ERR_UNEXPECTED;
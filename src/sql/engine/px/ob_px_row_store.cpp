@@ -190,7 +190,8 @@ int ObReceiveRowReader::add_buffer(dtl::ObDtlLinkedBuffer &buf, bool &transferre
     if (dtl::PX_DATUM_ROW == buf.msg_type()) {
       auto block = reinterpret_cast<ObChunkDatumStore::Block *>(buf.buf());
       rows = block->rows_;
-      if (rows > 0 && OB_FAIL(block->swizzling(NULL))) {
+      // rows from the local channel keep the absolute pointers.
+      if (rows > 0 && !buf.is_swizzled() && OB_FAIL(block->swizzling(NULL))) {
         LOG_WARN("block swizzling failed", K(ret));
       }
     } else {
@@ -446,6 +446,14 @@ int ObPxMsgProc::on_piece_msg(
   return proc.on_piece_msg(coord_info_, ctx, pkt);
 }
 
+int ObPxMsgProc::on_piece_msg(
+    ObExecContext &ctx,
+    const ObSkewKeyPieceMsg &pkt)
+{
+  ObDhPieceMsgProc<ObSkewKeyPieceMsg> proc;
+  return proc.on_piece_msg(coord_info_, ctx, pkt);
+}
+
 int ObPxMsgProc::on_eof_row(ObExecContext &ctx)
 {
   int ret = OB_SUCCESS;
@@ -832,5 +840,12 @@ int ObPxTerminateMsgProc::on_piece_msg(
   return common::OB_SUCCESS;
 }
 
+int ObPxTerminateMsgProc::on_piece_msg(
+    ObExecContext &,
+    const ObSkewKeyPieceMsg &)
+{
+  return common::OB_SUCCESS;
+}
+
 } // end namespace sql
 } // end namespace oceanbase
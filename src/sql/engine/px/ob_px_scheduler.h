@@ -29,6 +29,7 @@
 #include "sql/engine/px/datahub/components/ob_dh_range_dist_wf.h"
 #include "sql/engine/px/datahub/components/ob_dh_second_stage_reporting_wf.h"
 #include "sql/engine/px/datahub/components/ob_dh_opt_stats_gather.h"
+#include "sql/engine/px/datahub/components/ob_dh_skew_key.h"
 
 namespace oceanbase
 {
@@ -127,6 +128,7 @@ public:
   int on_piece_msg(ObExecContext &ctx, const ObInitChannelPieceMsg &pkt);
   int on_piece_msg(ObExecContext &ctx, const ObReportingWFPieceMsg &pkt);
   int on_piece_msg(ObExecContext &ctx, const ObOptStatsGatherPieceMsg &pkt);
+  int on_piece_msg(ObExecContext &ctx, const ObSkewKeyPieceMsg &pkt);
   // end DATAHUB msg processing
 
   ObPxCoordInfo &coord_info_;
@@ -166,6 +168,7 @@ public:
   int on_piece_msg(ObExecContext &ctx, const ObInitChannelPieceMsg &pkt);
   int on_piece_msg(ObExecContext &ctx, const ObReportingWFPieceMsg &pkt);
   int on_piece_msg(ObExecContext &ctx, const ObOptStatsGatherPieceMsg &pkt);
+  int on_piece_msg(ObExecContext &ctx, const ObSkewKeyPieceMsg &pkt);
   // end DATAHUB msg processing
 private:
   int do_cleanup_dfo(ObDfo &dfo);
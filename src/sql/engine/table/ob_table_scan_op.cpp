@@ -597,7 +597,8 @@ ObTableScanOp::ObTableScanOp(ObExecContext &exec_ctx, const ObOpSpec &spec, ObOp
     group_size_(0),
     max_group_size_(0),
     global_index_lookup_op_(NULL),
-    spat_index_()
+    spat_index_(),
+    runtime_probe_keys_()
 {
 }
 
@@ -1016,6 +1017,67 @@ int ObTableScanOp::build_bnlj_params()
   return ret;
 }
 
+int ObTableScanOp::set_runtime_probe_keys(const ObIArray<ObObj> &keys, bool &accepted)
+{
+  int ret = OB_SUCCESS;
+  accepted = false;
+  runtime_probe_keys_.reuse();
+  if (!need_init_before_get_row_ || MY_SPEC.gi_above_ || MY_SPEC.batch_scan_flag_
+      || MY_SPEC.is_global_index_back() || !need_extract_range()
+      || NULL != MY_SPEC.limit_ || NULL != MY_SPEC.offset_
+      || MY_CTDEF.pre_query_range_.get_column_count() <= 0) {
+    // the scan is started, or the ranges or the limit are not decided here
+  } else if (OB_FAIL(runtime_probe_keys_.assign(keys))) {
+    LOG_WARN("failed to assign runtime probe keys", K(ret));
+  } else {
+    accepted = true;
+  }
+  return ret;
+}
+
+// Replace the whole range by [(key, MIN, ...), (key, MAX, ...)] of each probe key, the
+// keys are distinct and sorted in the scan order, so that the rows come out in the
+// same order as the whole range scan.
+int ObTableScanOp::build_runtime_probe_ranges(ObIAllocator &allocator,
+                                              ObQueryRangeArray &key_ranges)
+{
+  int ret = OB_SUCCESS;
+  const int64_t column_count = MY_CTDEF.pre_query_range_.get_column_count();
+  const bool is_reverse = ObQueryFlag::Reverse == MY_CTDEF.scan_flags_.scan_order_;
+  const int64_t key_count = runtime_probe_keys_.count();
+  void *buf = NULL;
+  if (OB_ISNULL(buf = allocator.alloc((sizeof(ObNewRange) + sizeof(ObObj) * column_count * 2)
+                                      * key_count))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("failed to allocate probe ranges", K(ret), K(column_count), K(key_count));
+  } else {
+    ObNewRange *ranges = static_cast<ObNewRange *>(buf);
+    ObObj *objs = reinterpret_cast<ObObj *>(ranges + key_count);
+    key_ranges.reuse();
+    for (int64_t i = 0; OB_SUCC(ret) && i < key_count; ++i) {
+      const ObObj &key = runtime_probe_keys_.at(is_reverse ? key_count - 1 - i : i);
+      ObObj *start = objs + i * column_count * 2;
+      ObObj *end = start + column_count;
+      ObNewRange *range = new (ranges + i) ObNewRange();
+      start[0] = key;
+      end[0] = key;
+      for (int64_t j = 1; j < column_count; ++j) {
+        start[j].set_min_value();
+        end[j].set_max_value();
+      }
+      range->start_key_.assign(start, column_count);
+      range->end_key_.assign(end, column_count);
+      range->border_flag_.set_inclusive_start();
+      range->border_flag_.set_inclusive_end();
+      if (OB_FAIL(key_ranges.push_back(range))) {
+        LOG_WARN("failed to push back probe range", K(ret));
+      }
+    }
+    LOG_TRACE("scan by runtime probe keys", K(ret), K(key_count), K(is_reverse));
+  }
+  return ret;
+}
+
 int ObTableScanOp::prepare_single_scan_range(int64_t group_idx)
 {
   int ret = OB_SUCCESS;
@@ -1069,6 +1131,12 @@ int ObTableScanOp::prepare_single_scan_range(int64_t group_idx)
                                   ss_key_ranges,
                                   ObBasicSessionInfo::create_dtc_params(ctx_.get_my_session())))) {
       LOG_WARN("failed to final extract index skip query range", K(ret));
+    } else if (!runtime_probe_keys_.empty()
+               && ss_key_ranges.empty()
+               && 1 == key_ranges.count()
+               && key_ranges.at(0)->is_whole_range()
+               && OB_FAIL(build_runtime_probe_ranges(range_allocator, key_ranges))) {
+      LOG_WARN("failed to build runtime probe ranges", K(ret));
     }
   }
   if (OB_FAIL(ret)) {
@@ -1335,6 +1403,7 @@ int ObTableScanOp::do_init_before_get_row()
 
 void ObTableScanOp::destroy()
 {
+  runtime_probe_keys_.reset();
   tsc_rtdef_.~ObTableScanRtDef();
   ObOperator::destroy();
   das_ref_.reset();
@@ -1447,6 +1516,7 @@ int ObTableScanOp::inner_rescan_for_tsc()
   MY_INPUT.key_ranges_.reuse();
   MY_INPUT.ss_key_ranges_.reuse();
   MY_INPUT.mbr_filters_.reuse();
+  runtime_probe_keys_.reuse();
   if (OB_FAIL(ObOperator::inner_rescan())) {
     LOG_WARN("rescan operator failed", K(ret));
   } else if (OB_FAIL(build_bnlj_params())) {
@@ -381,6 +381,10 @@ public:
   void set_report_checksum(bool flag) { report_checksum_ = flag; }
   int reset_sample_scan() { tsc_rtdef_.scan_rtdef_.sample_info_ = nullptr; return close_and_reopen(); }
   virtual void set_need_sample(bool flag) { UNUSED(flag); }
+  // Restrict the coming scan to the index prefixes of %keys, which are the distinct
+  // join keys of a tiny hash join build side. %accepted is false if the scan has
+  // already been started, the keys take effect only if the scan is a whole range scan.
+  int set_runtime_probe_keys(const common::ObIArray<common::ObObj> &keys, bool &accepted);
   static int transform_physical_rowid(common::ObIAllocator &allocator,
                                       const common::ObTabletID &scan_tablet_id,
                                       const common::ObArrayWrap<share::schema::ObColDesc> &rowkey_descs,
@@ -406,6 +410,8 @@ protected:
   int single_equal_scan_check_type(const ParamStore &param_store, bool& is_same_type);
   bool need_extract_range() const { return MY_SPEC.tsc_ctdef_.pre_query_range_.has_range(); }
   int prepare_single_scan_range(int64_t group_idx = 0);
+  int build_runtime_probe_ranges(common::ObIAllocator &allocator,
+                                 ObQueryRangeArray &key_ranges);
 
   int reuse_table_rescan_allocator();
 
@@ -516,6 +522,8 @@ protected:
   int64_t max_group_size_;
   ObGlobalIndexLookupOpImpl *global_index_lookup_op_;
   ObSpatialIndexCache spat_index_;
+  // set by the hash join above, see set_runtime_probe_keys()
+  common::ObSEArray<common::ObObj, 16> runtime_probe_keys_;
  };
 
 class ObGlobalIndexLookupOpImpl : public ObIndexLookupOpImpl
@@ -142,6 +142,23 @@ int ObExecuteResult::get_next_row() const
   return ret;
 }
 
+int ObExecuteResult::get_next_batch(const int64_t max_row_cnt, const ObBatchRows *&brs) const
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(static_engine_root_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret), KP(static_engine_root_));
+  } else if (OB_UNLIKELY(!static_engine_root_->get_spec().is_vectorized())) {
+    ret = OB_NOT_SUPPORTED;
+    LOG_WARN("root operator is not vectorized", K(ret));
+  } else if (OB_FAIL(static_engine_root_->get_next_batch(max_row_cnt, brs))) {
+    if (OB_TRY_LOCK_ROW_CONFLICT != ret) {
+      LOG_WARN("get next batch from operator failed", K(ret));
+    }
+  }
+  return ret;
+}
+
 int ObExecuteResult::close() const
 {
   int ret = OB_SUCCESS;
@@ -55,8 +55,11 @@ public:
   // interface for static typing engine
   int open() const;
   int get_next_row() const;
+  // only for the vectorized root, the rows are left in the output exprs of the root
+  int get_next_batch(const int64_t max_row_cnt, const ObBatchRows *&brs) const;
   int close() const;
   const ObOperator *get_static_engine_root() const { return static_engine_root_; }
+  ObOperator *get_static_engine_root() { return static_engine_root_; }
   void set_static_engine_root(ObOperator *op)
   {
     static_engine_root_ = op;
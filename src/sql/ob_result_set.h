@@ -117,6 +117,12 @@ public:
   /// get the next result row
   /// @return OB_ITER_END when no more data available
   int get_next_row(const common::ObNewRow *&row);
+  /// the root operator if the rows can be fetched by get_next_batch(), i.e. the plan
+  /// is executed by the local static engine with a vectorized root, NULL otherwise
+  ObOperator *get_batch_fetch_root();
+  /// get the next batch, the rows are left in the output exprs of the root operator,
+  /// never mixed with get_next_row() in the same result set
+  int get_next_batch(const int64_t max_row_cnt, const ObBatchRows *&brs);
   /// close the result set after get all the rows
   int close();
   /// get number of rows affected by INSERT/UPDATE/DELETE
@@ -3309,6 +3309,15 @@ int ObSql::code_generate(
                                    && !insert_stmt->is_insert_up()
                                    && insert_stmt->get_subquery_exprs().empty()
                                    && !insert_stmt->is_replace());
+      } else if (stmt->is_update_stmt() && OB_NOT_NULL(sql_ctx.schema_guard_)) {
+        int tmp_ret = OB_SUCCESS;
+        if (OB_SUCCESS != (tmp_ret = generate_hot_row_update_info(
+                    sql_ctx.session_info_->get_effective_tenant_id(),
+                    *static_cast<ObUpdateStmt *>(stmt),
+                    *sql_ctx.schema_guard_,
+                    *phy_plan))) {
+          LOG_WARN("failed to generate hot row update info", K(tmp_ret));
+        }
       }
       last_mem_usage = phy_plan->get_mem_size();
     }
@@ -3426,6 +3435,125 @@ int ObSql::code_generate(
   return ret;
 }
 
+int ObSql::generate_hot_row_update_info(const uint64_t tenant_id,
+                                        const ObUpdateStmt &stmt,
+                                        ObSchemaGetterGuard &schema_guard,
+                                        ObPhysicalPlan &phy_plan)
+{
+  int ret = OB_SUCCESS;
+  ObHotRowUpdateInfo info;
+  const ObUpdateTableInfo *table_info = NULL;
+  const ObTableSchema *table_schema = NULL;
+  bool is_valid = lib::is_mysql_mode()
+                  && !stmt.is_ignore()
+                  && !stmt.is_returning()
+                  && !stmt.has_order_by()
+                  && !stmt.has_limit()
+                  && !stmt.has_subquery()
+                  && !phy_plan.contain_pl_udf_or_trigger()
+                  && 1 == stmt.get_table_size()
+                  && 1 == stmt.get_update_table_info().count();
+  if (is_valid) {
+    if (OB_ISNULL(table_info = stmt.get_update_table_info().at(0))) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("table info is null", K(ret));
+    } else if (1 != table_info->assignments_.count()
+               || !table_info->check_constraint_exprs_.empty()) {
+      is_valid = false;
+    } else if (OB_FAIL(schema_guard.get_table_schema(tenant_id,
+                                                     table_info->ref_table_id_,
+                                                     table_schema))) {
+      LOG_WARN("failed to get table schema", K(ret), K(tenant_id), KPC(table_info));
+    } else if (OB_ISNULL(table_schema)) {
+      ret = OB_TABLE_NOT_EXIST;
+      LOG_WARN("table schema is null", K(ret), KPC(table_info));
+    } else if (!table_schema->is_user_table()
+               || table_schema->is_heap_table()
+               || table_schema->has_generated_column()
+               || table_schema->get_rowkey_column_num() > ObHotRowUpdateInfo::MAX_ROWKEY_CNT
+               || table_schema->get_rowkey_column_num() != stmt.get_condition_size()) {
+      is_valid = false;
+    } else {
+      info.table_id_ = table_info->ref_table_id_;
+      info.rowkey_cnt_ = table_schema->get_rowkey_column_num();
+      for (int64_t i = 0; OB_SUCC(ret) && i < info.rowkey_cnt_; ++i) {
+        info.rowkey_param_idxs_[i] = OB_INVALID_INDEX;
+        if (OB_FAIL(table_schema->get_rowkey_info().get_column_id(i, info.rowkey_column_ids_[i]))) {
+          LOG_WARN("failed to get rowkey column id", K(ret), K(i));
+        }
+      }
+    }
+  }
+  // c = c + ? or c = c - ? on an integer column
+  if (OB_SUCC(ret) && is_valid) {
+    const ObAssignment &assign = table_info->assignments_.at(0);
+    const ObRawExpr *value = assign.expr_;
+    const ObRawExpr *left = NULL;
+    const ObRawExpr *right = NULL;
+    if (OB_ISNULL(assign.column_expr_) || OB_ISNULL(value)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("invalid assignment", K(ret), K(assign));
+    } else if (!ob_is_int_tc(assign.column_expr_->get_result_type().get_type())
+               || (T_OP_ADD != value->get_expr_type() && T_OP_MINUS != value->get_expr_type())
+               || 2 != value->get_param_count()
+               || OB_ISNULL(left = value->get_param_expr(0))
+               || OB_ISNULL(right = value->get_param_expr(1))) {
+      is_valid = false;
+    } else if (!left->is_column_ref_expr()
+               || static_cast<const ObColumnRefRawExpr *>(left)->get_column_id()
+                  != assign.column_expr_->get_column_id()
+               || T_QUESTIONMARK != right->get_expr_type()
+               || !right->has_flag(IS_STATIC_PARAM)) {
+      is_valid = false;
+    } else {
+      info.column_id_ = assign.column_expr_->get_column_id();
+      info.delta_param_idx_ = static_cast<const ObConstRawExpr *>(right)->get_value().get_unknown();
+      info.is_minus_ = T_OP_MINUS == value->get_expr_type();
+    }
+  }
+  // every rowkey column = ?, exactly once
+  for (int64_t i = 0; OB_SUCC(ret) && is_valid && i < stmt.get_condition_size(); ++i) {
+    const ObRawExpr *cond = stmt.get_condition_expr(i);
+    const ObRawExpr *column = NULL;
+    const ObRawExpr *param = NULL;
+    if (OB_ISNULL(cond)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("condition is null", K(ret), K(i));
+    } else if (T_OP_EQ != cond->get_expr_type()
+               || 2 != cond->get_param_count()
+               || OB_ISNULL(column = cond->get_param_expr(0))
+               || OB_ISNULL(param = cond->get_param_expr(1))) {
+      is_valid = false;
+    } else {
+      if (!column->is_column_ref_expr()) {
+        std::swap(column, param);
+      }
+      is_valid = column->is_column_ref_expr()
+                 && T_QUESTIONMARK == param->get_expr_type()
+                 && param->has_flag(IS_STATIC_PARAM);
+      bool found = false;
+      for (int64_t j = 0; is_valid && !found && j < info.rowkey_cnt_; ++j) {
+        if (static_cast<const ObColumnRefRawExpr *>(column)->get_column_id()
+            == info.rowkey_column_ids_[j]) {
+          found = true;
+          if (OB_INVALID_INDEX != info.rowkey_param_idxs_[j]) {
+            is_valid = false;
+          } else {
+            info.rowkey_param_idxs_[j] =
+                static_cast<const ObConstRawExpr *>(param)->get_value().get_unknown();
+          }
+        }
+      }
+      is_valid = is_valid && found;
+    }
+  }
+  if (OB_SUCC(ret) && is_valid) {
+    phy_plan.set_hot_row_update_info(info);
+    LOG_TRACE("hot row update plan", K(info));
+  }
+  return ret;
+}
+
 inline int ObSql::sanity_check(ObSqlCtx &context)
 {
   int ret = OB_SUCCESS;
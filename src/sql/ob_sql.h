@@ -60,6 +60,7 @@ class ObIVirtualTableIteratorFactory;
 struct ObSqlCtx;
 class ObResultSet;
 class ObLogPlan;
+class ObUpdateStmt;
 
 class ObPlanBaseKeyGuard
 {
@@ -385,6 +386,11 @@ private:
                            common::ObIArray<ObAuditUnit> &audit_units,
                            ObLogPlan *logical_plan,
                            ObPhysicalPlan *&phy_plan);
+  // recognize the update that ObHotRowUpdateCombiner may merge
+  static int generate_hot_row_update_info(const uint64_t tenant_id,
+                                          const ObUpdateStmt &stmt,
+                                          share::schema::ObSchemaGetterGuard &schema_guard,
+                                          ObPhysicalPlan &phy_plan);
 
   int prepare_outline_for_phy_plan(ObLogPlan *logical_plan,
                                    ObPhysicalPlan *phy_plan);
@@ -4819,14 +4819,16 @@ int JoinPath::compute_hash_hash_sharding_info()
       // should check is_naaj - #issue/46230785
       if (OB_SUCC(ret) && !is_naaj_ && 1 == equal_join_conditions_.count()) {
         ObArray<ObObj> popular_values;
+        bool need_skew_sample = false;
         if (OB_FAIL(log_plan->check_if_use_hybrid_hash_distribution(
                     log_plan->get_optimizer_context(),
                     log_plan->get_stmt(),
                     join_type_,
                     *right_expr,
-                    popular_values))) {
+                    popular_values,
+                    need_skew_sample))) {
           LOG_WARN("fail check if use hybrid hash distribution", K(ret));
-        } else if (popular_values.count() > 0) {
+        } else if (popular_values.count() > 0 || need_skew_sample) {
           use_hybrid_hash_dm_ = true;
         }
       }
@@ -240,6 +240,9 @@ int ObLogExchange::get_plan_special_expr_info(PlanText &plan_text,
         EXPLAIN_PRINT_POPULAR_VALUES(popular_values_);
       }
     }
+    if (OB_SUCC(ret) && EXPLAIN_EXTENDED == type && need_skew_sample_) {
+      ret = BUF_PRINTF(", skew_sample");
+    }
   } else {
     if (is_task_order_) {
       ret = BUF_PRINTF("task_order");
@@ -582,6 +585,7 @@ int ObLogExchange::set_exchange_info(const ObExchangeInfo &exch_info)
     } else {
       is_rollup_hybrid_ = exch_info.is_rollup_hybrid_;
       need_null_aware_shuffle_ = exch_info.need_null_aware_shuffle_;
+      need_skew_sample_ = exch_info.need_skew_sample_;
       calc_part_id_expr_ = exch_info.calc_part_id_expr_;
       is_wf_hybrid_ = exch_info.is_wf_hybrid_;
       if (is_wf_hybrid_) {
@@ -57,6 +57,7 @@ public:
       partition_id_expr_(NULL),
       random_expr_(NULL),
       need_null_aware_shuffle_(false),
+      need_skew_sample_(false),
       is_old_unblock_mode_(true),
       sample_type_(NOT_INIT_SAMPLE_TYPE)
   {
@@ -166,6 +167,7 @@ public:
   bool need_null_aware_shuffle() const { return need_null_aware_shuffle_; }
   void set_need_null_aware_shuffle(const bool need_null_aware_shuffle)
                     { need_null_aware_shuffle_ = need_null_aware_shuffle; }
+  bool need_skew_sample() const { return need_skew_sample_; }
   void set_sample_type(ObPxSampleType type) { sample_type_ = type; }
   ObPxSampleType get_sample_type() { return sample_type_; }
 
@@ -254,6 +256,8 @@ private:
   // new shuffle method for non-preserved side in naaj
   // broadcast 1st line && null join key
   bool need_null_aware_shuffle_;
+  // for hybrid hash distr, detect popular values by sampling at runtime
+  bool need_skew_sample_;
   bool is_old_unblock_mode_;
   // -for pkey range/range
   ObPxSampleType sample_type_;
@@ -4860,11 +4860,13 @@ int ObLogPlan::check_if_use_hybrid_hash_distribution(ObOptimizerContext &optimiz
                                                      const ObDMLStmt *stmt,
                                                      ObJoinType join_type,
                                                      ObRawExpr  &expr,
-                                                     ObIArray<ObObj> &popular_values) const
+                                                     ObIArray<ObObj> &popular_values,
+                                                     bool &need_skew_sample) const
 {
   int ret = OB_SUCCESS;
   ObSQLSessionInfo* session_info = optimizer_ctx.get_session_info();
   bool enable_skew_handling = optimizer_ctx.get_session_info()->get_px_join_skew_handling();
+  need_skew_sample = false;
   if (OB_SUCC(ret)
       && enable_skew_handling
       && expr.is_column_ref_expr()
@@ -4881,6 +4883,13 @@ int ObLogPlan::check_if_use_hybrid_hash_distribution(ObOptimizerContext &optimiz
       LOG_WARN("fail get hisstogram by join exprs", K(ret));
     } else if (OB_FAIL(get_popular_values_hash(get_allocator(), handle, popular_values))) {
       LOG_WARN("fail get popular values hash", K(ret));
+    } else {
+      // the histogram may be missing or stale, popular values found by sampling
+      // the build side at runtime are added to the ones above.
+      omt::ObTenantConfigGuard tenant_config(TENANT_CONF(session_info->get_effective_tenant_id()));
+      if (tenant_config.is_valid()) {
+        need_skew_sample = tenant_config->_px_join_skew_sampling;
+      }
     }
   }
   return ret;
@@ -4966,11 +4975,13 @@ int ObLogPlan::compute_hash_distribution_info(const ObJoinType &join_type,
                     get_stmt(),
                     join_type,
                     *right_exch_info.hash_dist_exprs_.at(0).expr_,
-                    right_exch_info.popular_values_))) {
+                    right_exch_info.popular_values_,
+                    right_exch_info.need_skew_sample_))) {
           LOG_WARN("fail check use hybrid hash dist", K(ret));
         } else if (OB_FAIL(left_exch_info.popular_values_.assign(right_exch_info.popular_values_))) {
           LOG_WARN("fail assign exch info", K(ret));
         } else {
+          left_exch_info.need_skew_sample_ = right_exch_info.need_skew_sample_;
           left_exch_info.dist_method_ = ObPQDistributeMethod::HYBRID_HASH_BROADCAST;
           right_exch_info.dist_method_ = ObPQDistributeMethod::HYBRID_HASH_RANDOM;
         }
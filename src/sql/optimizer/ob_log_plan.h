@@ -430,7 +430,8 @@ public:
                                             const ObDMLStmt *stmt,
                                             ObJoinType join_type,
                                             ObRawExpr  &expr,
-                                            common::ObIArray<common::ObObj> &popular_values) const;
+                                            common::ObIArray<common::ObObj> &popular_values,
+                                            bool &need_skew_sample) const;
   int get_source_table_info(ObLogicalOperator &child_op,
                                uint64_t source_table_id,
                                ObShardingInfo *&sharding_info,
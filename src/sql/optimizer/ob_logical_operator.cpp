@@ -188,6 +188,7 @@ int ObExchangeInfo::assign(ObExchangeInfo &other)
     repartition_table_id_ = other.repartition_table_id_;
     repartition_table_name_ = other.repartition_table_name_;
     calc_part_id_expr_ = other.calc_part_id_expr_;
+    need_skew_sample_ = other.need_skew_sample_;
     dist_method_ = other.dist_method_;
     unmatch_row_dist_method_ = other.unmatch_row_dist_method_;
     null_row_dist_method_ = other.null_row_dist_method_;
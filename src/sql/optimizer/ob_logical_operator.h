@@ -435,6 +435,7 @@ struct ObExchangeInfo
     calc_part_id_expr_(NULL),
     hash_dist_exprs_(),
     popular_values_(),
+    need_skew_sample_(false),
     dist_method_(ObPQDistributeMethod::LOCAL), // pull to local
     unmatch_row_dist_method_(ObPQDistributeMethod::LOCAL),
     null_row_dist_method_(ObNullDistributeMethod::NONE),
@@ -488,6 +489,8 @@ struct ObExchangeInfo
   common::ObSEArray<HashExpr, 4> hash_dist_exprs_;
   // for hybrid hash distr
   common::ObSEArray<ObObj, 20> popular_values_;
+  // detect popular values by sampling at runtime, see ObSkewKeyPieceMsg
+  bool need_skew_sample_;
   ObPQDistributeMethod::Type dist_method_;
   ObPQDistributeMethod::Type unmatch_row_dist_method_;
   ObNullDistributeMethod::Type null_row_dist_method_;
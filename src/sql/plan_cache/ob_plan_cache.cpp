@@ -33,6 +33,7 @@
 #include "sql/engine/ob_physical_plan.h"
 #include "sql/plan_cache/ob_plan_cache_callback.h"
 #include "sql/plan_cache/ob_cache_object_factory.h"
+#include "sql/plan_cache/ob_raw_sql_cache.h"
 #include "sql/udr/ob_udr_mgr.h"
 #include "pl/ob_pl.h"
 #include "pl/ob_pl_package.h"
@@ -591,12 +592,41 @@ int ObPlanCache::construct_fast_parser_result(common::ObIAllocator &allocator,
       FPContext fp_ctx(conn_coll);
       fp_ctx.enable_batched_multi_stmt_ = pc_ctx.sql_ctx_.handle_batched_multi_stmt();
       fp_ctx.sql_mode_ = sql_mode;
-      if (OB_FAIL(ObSqlParameterization::fast_parser(allocator,
-                                                    fp_ctx,
-                                                    raw_sql,
-                                                    fp_result))) {
+      // exact repeats of the statements without parameters skip the fast parser
+      ObRawSqlCache *raw_sql_cache = NULL;
+      ObRawSqlCacheKey raw_sql_key;
+      ObString param_sql;
+      bool hit = false;
+      if (GCONF._enable_raw_sql_cache
+          && raw_sql.length() <= ObRawSqlCache::MAX_RAW_SQL_LEN
+          && OB_NOT_NULL(raw_sql_cache = ObRawSqlCache::get_instance())) {
+        raw_sql_key.tenant_id_ = pc_ctx.sql_ctx_.session_info_->get_effective_tenant_id();
+        raw_sql_key.sql_mode_ = sql_mode;
+        raw_sql_key.conn_coll_ = conn_coll;
+        raw_sql_key.is_oracle_mode_ = lib::is_oracle_mode();
+        raw_sql_key.enable_batched_multi_stmt_ = fp_ctx.enable_batched_multi_stmt_;
+        raw_sql_key.enable_fast_parser_ = GCONF._ob_enable_fast_parser;
+        if (OB_FAIL(raw_sql_cache->get(raw_sql_key, raw_sql, allocator, param_sql, hit))) {
+          LOG_WARN("failed to get raw sql cache", K(ret));
+        }
+      }
+      if (OB_FAIL(ret)) {
+      } else if (hit) {
+        fp_result.pc_key_.name_ = param_sql;
+      } else if (OB_FAIL(ObSqlParameterization::fast_parser(allocator,
+                                                           fp_ctx,
+                                                           raw_sql,
+                                                           fp_result))) {
         LOG_WARN("failed to fast parser", K(ret), K(sql_mode), K(pc_ctx.raw_sql_));
-      } else { /*do nothing*/ }
+      } else if (NULL != raw_sql_cache
+                 && fp_result.raw_params_.empty()
+                 && 0 == fp_result.question_mark_ctx_.count_) {
+        int tmp_ret = OB_SUCCESS;
+        if (OB_SUCCESS != (tmp_ret = raw_sql_cache->put(raw_sql_key, raw_sql,
+                                                        fp_result.pc_key_.name_))) {
+          LOG_WARN("failed to put raw sql cache", K(tmp_ret));
+        }
+      }
     }
   }
   return ret;
@@ -1037,6 +1067,35 @@ int ObPlanCache::cache_evict()
   return ret;
 }
 
+int ObPlanCache::asyn_compile_filter_jit()
+{
+  int ret = OB_SUCCESS;
+  if (GCONF._sql_filter_jit_threshold <= 0) {
+    // disabled
+  } else {
+    ObGlobalReqTimeService::check_req_timeinfo();
+    SMART_VAR(PlanIdArray, plan_ids) {
+      ObGetAllPlanIdOp plan_id_op(&plan_ids);
+      if (OB_FAIL(co_mgr_.foreach_cache_obj(plan_id_op))) {
+        LOG_WARN("fail to traverse id2stat_map", K(ret));
+      } else {
+        for (int64_t i = 0; i < plan_ids.count(); i++) {
+          ObCacheObjGuard guard(ASYN_BASELINE_HANDLE);
+          ObPhysicalPlan *plan = NULL;
+          int tmp_ret = ref_plan(plan_ids.at(i), guard);
+          if (OB_SUCCESS != tmp_ret
+              || OB_ISNULL(plan = static_cast<ObPhysicalPlan*>(guard.cache_obj_))) {
+            LOG_DEBUG("get plan failed", K(tmp_ret), K(plan_ids.at(i)));
+          } else {
+            plan->try_compile_filter_jit(plan->get_hit_count());
+          }
+        }
+      }
+    }
+  }
+  return ret;
+}
+
 int ObPlanCache::asyn_update_baseline()
 {
   int ret = OB_SUCCESS;
@@ -2071,6 +2130,9 @@ void ObPlanCacheEliminationTask::run_plan_cache_task()
   if (OB_FAIL(plan_cache_->asyn_update_baseline())) {
     SQL_PC_LOG(ERROR, "asyn replace plan baseline failed", K(ret));
   }
+  if (OB_FAIL(plan_cache_->asyn_compile_filter_jit())) {
+    SQL_PC_LOG(WARN, "asyn compile filter jit failed", K(ret));
+  }
 }
 
 void ObPlanCacheEliminationTask::run_free_cache_obj_task()
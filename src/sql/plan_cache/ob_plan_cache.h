@@ -329,6 +329,8 @@ public:
   int foreach_cache_evict(CallBack &cb);
   //asynchronous update plan baseline
   int asyn_update_baseline();
+  // compile the filters of hot plans into native kernels, see ObPhysicalPlan::try_compile_filter_jit()
+  int asyn_compile_filter_jit();
   void destroy();
   common::ObAddr &get_host() { return host_; }
   void set_host(common::ObAddr &addr) { host_ = addr; }
@@ -140,6 +140,7 @@ ObPlanCacheValue::ObPlanCacheValue()
   : pcv_set_(NULL),
     pc_alloc_(NULL),
     last_plan_id_(OB_INVALID_ID),
+    use_sig_index_(false),
     //use_global_location_cache_(true),
     tenant_schema_version_(OB_INVALID_VERSION),
     sys_schema_version_(OB_INVALID_VERSION),
@@ -155,6 +156,7 @@ ObPlanCacheValue::ObPlanCacheValue()
     stmt_type_(stmt::T_MAX)
 {
   MEMSET(sql_id_, 0, sizeof(sql_id_));
+  MEMSET(sig_bucket_heads_, 0, sizeof(sig_bucket_heads_));
 }
 
 int ObPlanCacheValue::assign_udr_infos(ObPlanCacheCtx &pc_ctx)
@@ -506,10 +508,31 @@ int ObPlanCacheValue::choose_plan(ObPlanCacheCtx &pc_ctx,
         org_param_count = params->count();
       }
 
-      DLIST_FOREACH(plan_set, plan_sets_) {
+      // the plan sets of other signatures differ in some param type checked by
+      // match_params_info, only the sets in the bucket of the request need to be matched
+      bool use_sig_index = use_sig_index_
+                           && NULL != params
+                           && !pc_ctx.sql_ctx_.multi_stmt_item_.is_batched_multi_stmt()
+                           && !plan_sets_.is_empty()
+                           && params->count() == plan_sets_.get_first()->get_sig_param_cnt();
+      uint64_t param_type_sig = 0;
+      ObPlanSet *plan_set = plan_sets_.get_first();
+      if (!use_sig_index) {
+        // do nothing
+      } else if (OB_FAIL(plan_sets_.get_first()->calc_param_type_sig(*params,
+                                                                     outline_param_idx,
+                                                                     param_type_sig))) {
+        LOG_WARN("fail to calc param type signature", K(ret));
+      } else {
+        plan_set = sig_bucket_heads_[param_type_sig % PLAN_SET_SIG_BUCKET_CNT];
+      }
+      for (; OB_SUCC(ret) && NULL != plan_set && plan_set != plan_sets_.get_header();
+           plan_set = use_sig_index ? plan_set->next_same_sig_ : plan_set->get_next()) {
         plan = NULL;
         bool is_same = false;
-        if (OB_FAIL(match_all_params_info(plan_set, pc_ctx, outline_param_idx, is_same))) {
+        if (use_sig_index && param_type_sig != plan_set->get_param_type_sig()) {
+          // another signature in the same bucket
+        } else if (OB_FAIL(match_all_params_info(plan_set, pc_ctx, outline_param_idx, is_same))) {
           SQL_PC_LOG(WARN, "fail to match params info", K(ret));
         } else if (!is_same) {        //do nothing
           LOG_TRACE("params info does not match", KPC(params));
@@ -1160,6 +1183,7 @@ int ObPlanCacheValue::add_plan(ObPlanCacheObject &plan,
           ret = OB_ERROR;
           SQL_PC_LOG(WARN, "failed to add plan set to plan cache value", K(ret));
         } else {
+          add_plan_set_to_sig_index(*plan_set);
           ret = OB_SUCCESS;
           SQL_PC_LOG(DEBUG, "plan set added", K(ret));
         }
@@ -1193,6 +1217,32 @@ int ObPlanCacheValue::add_plan(ObPlanCacheObject &plan,
   return ret;
 }
 
+// plan sets are only appended to plan_sets_ and removed all together in reset(),
+// so a chain kept in the order of addition is searched in the same order as plan_sets_
+void ObPlanCacheValue::add_plan_set_to_sig_index(ObPlanSet &plan_set)
+{
+  ObPlanSet *first = plan_sets_.get_first();
+  plan_set.next_same_sig_ = NULL;
+  if (&plan_set == first) {
+    use_sig_index_ = OB_INVALID_COUNT != plan_set.get_sig_param_cnt();
+  } else if (use_sig_index_ && !plan_set.has_same_sig_params(*first)) {
+    use_sig_index_ = false;
+  }
+  if (use_sig_index_) {
+    ObPlanSet **tail = &sig_bucket_heads_[plan_set.get_param_type_sig() % PLAN_SET_SIG_BUCKET_CNT];
+    while (NULL != *tail) {
+      tail = &(*tail)->next_same_sig_;
+    }
+    *tail = &plan_set;
+  }
+}
+
+void ObPlanCacheValue::reset_sig_index()
+{
+  MEMSET(sig_bucket_heads_, 0, sizeof(sig_bucket_heads_));
+  use_sig_index_ = false;
+}
+
 //删除对应的该plan cache value中某一个plan
 /*void ObPlanCacheValue::remove_plan(ObExecContext &exec_context, ObPhysicalPlan &plan)*/
 //{
@@ -1231,6 +1281,7 @@ void ObPlanCacheValue::reset()
     }
   }
   plan_sets_.clear();
+  reset_sig_index();
   // free plan_cache_key
   if (NULL == pc_alloc_) {
     SQL_PC_LOG(DEBUG, "pc alloc not init, may be reset before", K(pc_alloc_));
@@ -21,6 +21,7 @@ namespace test
 {
 class TestPlanSet_basic_Test;
 class TestPlanCacheValue_basic_Test;
+class TestPlanCacheValue_sig_index_Test;
 }
 
 namespace oceanbase
@@ -342,9 +343,14 @@ private:
                          const NotParamInfoList &r_param_info_list,
                          bool &is_equal);
 
+  void add_plan_set_to_sig_index(ObPlanSet &plan_set);
+  void reset_sig_index();
+
   friend class ::test::TestPlanSet_basic_Test;
   friend class ::test::TestPlanCacheValue_basic_Test;
+  friend class ::test::TestPlanCacheValue_sig_index_Test;
 private:
+  static const int64_t PLAN_SET_SIG_BUCKET_CNT = 16;
   //***********  for match **************
   //记录不需要参数化的常量信息及常量为负数的信息
   common::ObSEArray<NotParamInfo, 4> not_param_info_;
@@ -370,6 +376,12 @@ private:
   int64_t last_plan_id_;
   // a list of plan sets with different param types combination
   common::ObDList<ObPlanSet> plan_sets_;
+  // plan sets chained by their param type signature in the order of plan_sets_,
+  // usable only when all the plan sets have the same sig params. It only narrows the
+  // candidates by param types: const param and pre-calc constraints, and the choice
+  // among the ObDistPlans of a plan set, are still checked on each plan set of the bucket.
+  ObPlanSet *sig_bucket_heads_[PLAN_SET_SIG_BUCKET_CNT];
+  bool use_sig_index_;
   //if there is no virtual table in ObPhysicalPlan, set true(default), or set false
   //bool use_global_location_cache_;
   int64_t tenant_schema_version_;
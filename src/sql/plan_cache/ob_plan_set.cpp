@@ -15,6 +15,7 @@
 
 #include "lib/trace/ob_trace_event.h"
 #include "lib/number/ob_number_v2.h"
+#include "lib/hash_func/murmur_hash.h"
 #include "common/ob_role.h"
 #include "observer/ob_server_struct.h"
 #include "sql/ob_phy_table_location.h"
@@ -574,6 +575,10 @@ void ObPlanSet::reset()
   all_equal_param_constraints_.reset();
   all_pre_calc_constraints_.reset();
   all_priv_constraints_.reset();
+  sig_param_cnt_ = OB_INVALID_COUNT;
+  sig_param_idxs_.reset();
+  param_type_sig_ = 0;
+  next_same_sig_ = NULL;
   alloc_.reset();
 }
 
@@ -725,11 +730,94 @@ int ObPlanSet::init_new_set(const ObPlanCacheCtx &pc_ctx,
         LOG_WARN("failed to append multi stmt rowkey pos", K(ret));
       } else { /*do nothing*/ }
     }
+
+    if (OB_SUCC(ret) && OB_FAIL(init_param_type_sig(pc_ctx))) {
+      LOG_WARN("failed to init param type signature", K(ret));
+    }
   }
 
  return ret;
 }
 
+uint64_t ObPlanSet::hash_param_type(const ObObjType type,
+                                    const ObCollationType cs_type,
+                                    const uint64_t seed)
+{
+  uint64_t hash_val = murmurhash(&type, sizeof(type), seed);
+  return murmurhash(&cs_type, sizeof(cs_type), hash_val);
+}
+
+// only the params of the original sql are matched by type before the pre calculation,
+// so the signature covers the params before the original param count
+int ObPlanSet::init_param_type_sig(const ObPlanCacheCtx &pc_ctx)
+{
+  int ret = OB_SUCCESS;
+  const ObPhysicalPlanCtx *phy_ctx = pc_ctx.exec_ctx_.get_physical_plan_ctx();
+  sig_param_cnt_ = OB_INVALID_COUNT;
+  sig_param_idxs_.reset();
+  sig_param_idxs_.set_allocator(&alloc_);
+  param_type_sig_ = 0;
+  if (NULL == phy_ctx || phy_ctx->get_original_param_cnt() > params_info_.count()) {
+    // no signature, the plan cache value falls back to match every plan set
+  } else {
+    const int64_t param_cnt = phy_ctx->get_original_param_cnt();
+    int64_t sig_cnt = 0;
+    for (int64_t i = 0; i < param_cnt; ++i) {
+      if (params_info_.at(i).flag_.need_to_check_type_) {
+        ++sig_cnt;
+      }
+    }
+    if (sig_cnt > 0 && OB_FAIL(sig_param_idxs_.init(sig_cnt))) {
+      LOG_WARN("failed to init sig param idxs", K(ret), K(sig_cnt));
+    }
+    param_type_sig_ = murmurhash(&outline_param_idx_, sizeof(outline_param_idx_), 0);
+    for (int64_t i = 0; OB_SUCC(ret) && i < param_cnt; ++i) {
+      const ObParamInfo &param_info = params_info_.at(i);
+      if (!param_info.flag_.need_to_check_type_) {
+        // do nothing
+      } else if (OB_FAIL(sig_param_idxs_.push_back(i))) {
+        LOG_WARN("failed to push back sig param idx", K(ret));
+      } else {
+        param_type_sig_ = hash_param_type(param_info.type_, param_info.col_type_, param_type_sig_);
+      }
+    }
+    if (OB_SUCC(ret)) {
+      sig_param_cnt_ = param_cnt;
+    }
+  }
+  return ret;
+}
+
+bool ObPlanSet::has_same_sig_params(const ObPlanSet &other) const
+{
+  bool is_same = OB_INVALID_COUNT != sig_param_cnt_
+                 && sig_param_cnt_ == other.sig_param_cnt_
+                 && sig_param_idxs_.count() == other.sig_param_idxs_.count();
+  for (int64_t i = 0; is_same && i < sig_param_idxs_.count(); ++i) {
+    is_same = sig_param_idxs_.at(i) == other.sig_param_idxs_.at(i);
+  }
+  return is_same;
+}
+
+// the same hash as init_param_type_sig but with the types of the request params,
+// compared with the same fields as match_param_info
+int ObPlanSet::calc_param_type_sig(const ParamStore &params,
+                                   int64_t outline_param_idx,
+                                   uint64_t &sig) const
+{
+  int ret = OB_SUCCESS;
+  sig = murmurhash(&outline_param_idx, sizeof(outline_param_idx), 0);
+  if (OB_UNLIKELY(params.count() != sig_param_cnt_)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("param count differs from the signature", K(ret), K(params.count()), K(sig_param_cnt_));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < sig_param_idxs_.count(); ++i) {
+    const ObObjParam &param = params.at(sig_param_idxs_.at(i));
+    sig = hash_param_type(param.get_param_meta().get_type(), param.get_collation_type(), sig);
+  }
+  return ret;
+}
+
 int ObPlanSet::set_const_param_constraint(ObIArray<ObPCConstParamInfo> &const_param_constraint,
                                           const bool is_all_constraint)
 {
@@ -27,6 +27,7 @@
 namespace test
 {
 class TestPlanSet_basic_Test;
+class TestPlanCacheValue_sig_index_Test;
 }
 namespace oceanbase
 {
@@ -112,8 +113,12 @@ public:
         all_priv_constraints_(),
         multi_stmt_rowkey_pos_(alloc_),
         pre_cal_expr_handler_(NULL),
+        sig_param_cnt_(common::OB_INVALID_COUNT),
+        sig_param_idxs_(alloc_),
+        param_type_sig_(0),
         res_map_rule_id_(common::OB_INVALID_ID),
-        res_map_rule_param_idx_(common::OB_INVALID_INDEX)
+        res_map_rule_param_idx_(common::OB_INVALID_INDEX),
+        next_same_sig_(NULL)
   {}
   virtual ~ObPlanSet();
 
@@ -167,7 +172,24 @@ public:
                /*bool &same_bool_param);*/
   inline bool is_multi_stmt_plan() const { return !multi_stmt_rowkey_pos_.empty(); }
   int remove_cache_obj_entry(const ObCacheObjID obj_id);
+  // The signature of a plan set is the hash of the outline param index and the types of
+  // the params whose type it checks. A request can only match the plan sets whose
+  // signature equals the one calculated from its params, ObPlanCacheValue indexes the
+  // plan sets by it. The signature is only meaningful for requests with
+  // get_sig_param_cnt() params, and only comparable between plan sets with the same
+  // sig params. Params matched by value (const params, pre-calc results) and the dist
+  // plans are not part of it.
+  int64_t get_sig_param_cnt() const { return sig_param_cnt_; }
+  uint64_t get_param_type_sig() const { return param_type_sig_; }
+  bool has_same_sig_params(const ObPlanSet &other) const;
+  int calc_param_type_sig(const ParamStore &params,
+                          int64_t outline_param_idx,
+                          uint64_t &sig) const;
 private:
+  int init_param_type_sig(const ObPlanCacheCtx &pc_ctx);
+  static uint64_t hash_param_type(const common::ObObjType type,
+                                  const common::ObCollationType cs_type,
+                                  const uint64_t seed);
   bool is_match_outline_param(int64_t param_idx)
   {
     return outline_param_idx_ == param_idx;
@@ -209,6 +231,7 @@ private:
 
   DISALLOW_COPY_AND_ASSIGN(ObPlanSet);
   friend class ::test::TestPlanSet_basic_Test;
+  friend class ::test::TestPlanCacheValue_sig_index_Test;
 protected:
   common::ObArenaAllocator alloc_;
   ObPlanCacheValue *plan_cache_value_;
@@ -232,11 +255,18 @@ protected:
   common::ObFixedArray<int64_t, common::ObIAllocator> multi_stmt_rowkey_pos_;
   // pre calculable expression list handler.
   PreCalcExprHandler* pre_cal_expr_handler_;
+  // param count and indexes of the params covered by param_type_sig_,
+  // OB_INVALID_COUNT means the plan set has no signature
+  int64_t sig_param_cnt_;
+  common::ObFixedArray<int64_t, common::ObIAllocator> sig_param_idxs_;
+  uint64_t param_type_sig_;
 
 public:
   //variables for resource map rule
   uint64_t res_map_rule_id_;
   int64_t res_map_rule_param_idx_;
+  // next plan set in the same signature bucket of the plan cache value
+  ObPlanSet *next_same_sig_;
 };
 
 class ObSqlPlanSet : public ObPlanSet
@@ -0,0 +1,128 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_PC
+#include "sql/plan_cache/ob_raw_sql_cache.h"
+#include "lib/atomic/ob_atomic.h"
+#include "lib/allocator/ob_malloc.h"
+#include "lib/hash_func/murmur_hash.h"
+#include "lib/thread_local/ob_tsi_factory.h"
+
+using namespace oceanbase::common;
+
+namespace oceanbase
+{
+namespace sql
+{
+
+uint64_t ObRawSqlCacheKey::hash(const ObString &raw_sql) const
+{
+  uint64_t hash_val = murmurhash(&tenant_id_, sizeof(tenant_id_), 0);
+  hash_val = murmurhash(&sql_mode_, sizeof(sql_mode_), hash_val);
+  hash_val = murmurhash(&conn_coll_, sizeof(conn_coll_), hash_val);
+  return murmurhash(raw_sql.ptr(), raw_sql.length(), hash_val);
+}
+
+int64_t ObRawSqlCache::total_size_ = 0;
+
+ObRawSqlCache::ObRawSqlCache()
+{
+}
+
+void ObRawSqlCache::destroy()
+{
+  for (int64_t i = 0; i < SLOT_CNT; ++i) {
+    if (NULL != slots_[i].buf_) {
+      ob_free(slots_[i].buf_);
+      (void)ATOMIC_SAF(&total_size_, slots_[i].buf_size_);
+    }
+    slots_[i] = Slot();
+  }
+}
+
+ObRawSqlCache *ObRawSqlCache::get_instance()
+{
+  return GET_TSI(ObRawSqlCache);
+}
+
+int ObRawSqlCache::get(const ObRawSqlCacheKey &key,
+                       const ObString &raw_sql,
+                       ObIAllocator &allocator,
+                       ObString &param_sql,
+                       bool &found)
+{
+  int ret = OB_SUCCESS;
+  found = false;
+  const uint64_t hash_val = key.hash(raw_sql);
+  const Slot &slot = slots_[hash_val % SLOT_CNT];
+  if (NULL != slot.buf_
+      && hash_val == slot.hash_
+      && raw_sql.length() == slot.raw_sql_len_
+      && key == slot.key_
+      && 0 == MEMCMP(slot.buf_, raw_sql.ptr(), raw_sql.length())) {
+    if (OB_FAIL(ob_write_string(allocator,
+                                ObString(slot.param_sql_len_, slot.buf_ + slot.raw_sql_len_),
+                                param_sql))) {
+      LOG_WARN("failed to copy param sql", K(ret));
+    } else {
+      found = true;
+    }
+  }
+  return ret;
+}
+
+int ObRawSqlCache::put(const ObRawSqlCacheKey &key,
+                       const ObString &raw_sql,
+                       const ObString &param_sql)
+{
+  int ret = OB_SUCCESS;
+  const uint64_t hash_val = key.hash(raw_sql);
+  Slot &slot = slots_[hash_val % SLOT_CNT];
+  const int64_t need_size = raw_sql.length() + param_sql.length();
+  bool is_full = false;
+  if (raw_sql.length() > MAX_RAW_SQL_LEN || param_sql.length() > MAX_RAW_SQL_LEN) {
+    // do nothing
+  } else {
+    if (need_size > slot.buf_size_) {
+      const int64_t inc_size = need_size - slot.buf_size_;
+      ObMemAttr attr(OB_SERVER_TENANT_ID, "RawSqlCache");
+      char *buf = NULL;
+      if (ATOMIC_AAF(&total_size_, inc_size) > MAX_TOTAL_SIZE) {
+        (void)ATOMIC_SAF(&total_size_, inc_size);
+        is_full = true;
+      } else if (OB_ISNULL(buf = static_cast<char *>(ob_malloc(need_size, attr)))) {
+        (void)ATOMIC_SAF(&total_size_, inc_size);
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("failed to allocate raw sql cache slot", K(ret), K(need_size));
+      } else {
+        if (NULL != slot.buf_) {
+          ob_free(slot.buf_);
+        }
+        slot.buf_ = buf;
+        slot.buf_size_ = need_size;
+      }
+    }
+    if (OB_FAIL(ret) || is_full) {
+    } else {
+      MEMCPY(slot.buf_, raw_sql.ptr(), raw_sql.length());
+      MEMCPY(slot.buf_ + raw_sql.length(), param_sql.ptr(), param_sql.length());
+      slot.hash_ = hash_val;
+      slot.key_ = key;
+      slot.raw_sql_len_ = raw_sql.length();
+      slot.param_sql_len_ = param_sql.length();
+    }
+  }
+  return ret;
+}
+
+} // namespace sql
+} // namespace oceanbase
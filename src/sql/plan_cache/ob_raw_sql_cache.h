@@ -0,0 +1,104 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_SQL_PLAN_CACHE_OB_RAW_SQL_CACHE_
+#define OCEANBASE_SQL_PLAN_CACHE_OB_RAW_SQL_CACHE_
+
+#include "lib/allocator/ob_allocator.h"
+#include "lib/string/ob_string.h"
+#include "lib/utility/ob_print_utils.h"
+#include "common/sql_mode/ob_sql_mode.h"
+#include "lib/charset/ob_charset.h"
+
+namespace oceanbase
+{
+namespace sql
+{
+
+// everything the fast parser result depends on besides the raw sql
+struct ObRawSqlCacheKey
+{
+  ObRawSqlCacheKey()
+    : tenant_id_(common::OB_INVALID_TENANT_ID), sql_mode_(0),
+      conn_coll_(common::CS_TYPE_INVALID), is_oracle_mode_(false),
+      enable_batched_multi_stmt_(false), enable_fast_parser_(false) {}
+  bool operator==(const ObRawSqlCacheKey &other) const
+  {
+    return tenant_id_ == other.tenant_id_
+        && sql_mode_ == other.sql_mode_
+        && conn_coll_ == other.conn_coll_
+        && is_oracle_mode_ == other.is_oracle_mode_
+        && enable_batched_multi_stmt_ == other.enable_batched_multi_stmt_
+        && enable_fast_parser_ == other.enable_fast_parser_;
+  }
+  uint64_t hash(const common::ObString &raw_sql) const;
+  TO_STRING_KV(K_(tenant_id), K_(sql_mode), K_(conn_coll), K_(is_oracle_mode),
+               K_(enable_batched_multi_stmt), K_(enable_fast_parser));
+
+  uint64_t tenant_id_;
+  ObSQLMode sql_mode_;
+  common::ObCollationType conn_coll_;
+  bool is_oracle_mode_;
+  bool enable_batched_multi_stmt_;
+  bool enable_fast_parser_;
+};
+
+// Per thread cache from the raw text of the statements without any parameter to their
+// plan cache key. Such a statement is fast parsed into the same key every time, so a
+// byte identical repeat takes the key from here and skips the fast parser.
+// Slots are direct mapped by the hash of the raw sql, a conflict replaces the old one.
+// The slots of all the threads are allocated from the server tenant, so they are capped
+// by MAX_TOTAL_SIZE altogether, a put which would exceed it is dropped.
+class ObRawSqlCache
+{
+public:
+  static const int64_t SLOT_CNT = 64;
+  static const int64_t MAX_RAW_SQL_LEN = 4096;
+  static const int64_t MAX_TOTAL_SIZE = 64L << 20;
+
+  ObRawSqlCache();
+  ~ObRawSqlCache() { destroy(); }
+  void destroy();
+  static ObRawSqlCache *get_instance();
+
+  // %param_sql is deep copied into %allocator, %found is false on a miss.
+  int get(const ObRawSqlCacheKey &key,
+          const common::ObString &raw_sql,
+          common::ObIAllocator &allocator,
+          common::ObString &param_sql,
+          bool &found);
+  int put(const ObRawSqlCacheKey &key,
+          const common::ObString &raw_sql,
+          const common::ObString &param_sql);
+
+private:
+  struct Slot
+  {
+    Slot() : hash_(0), key_(), buf_(NULL), buf_size_(0), raw_sql_len_(0), param_sql_len_(0) {}
+    uint64_t hash_;
+    ObRawSqlCacheKey key_;
+    // raw sql followed by the param sql
+    char *buf_;
+    int64_t buf_size_;
+    int64_t raw_sql_len_;
+    int64_t param_sql_len_;
+  };
+  Slot slots_[SLOT_CNT];
+  // memory held by the slots of all the threads
+  static int64_t total_size_;
+  DISALLOW_COPY_AND_ASSIGN(ObRawSqlCache);
+};
+
+} // namespace sql
+} // namespace oceanbase
+
+#endif // OCEANBASE_SQL_PLAN_CACHE_OB_RAW_SQL_CACHE_
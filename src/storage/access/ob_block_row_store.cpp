@@ -173,7 +173,14 @@ int ObBlockRowStore::filter_micro_block(
   } else if (nullptr != parent && OB_FAIL(parent->prepare_skip_filter())) {
     LOG_WARN("Failed to check parent blockscan", K(ret));
   } else if (filter->is_filter_node()) {
-    if (OB_FAIL(micro_scanner.filter_pushdown_filter(parent, filter, pd_filter_info_, *result))) {
+    bool filter_all_pass = false;
+    if (filter->is_filter_white_node()
+        && static_cast<sql::ObWhiteFilterExecutor *>(filter)->is_runtime_filter()
+        && OB_FAIL(static_cast<sql::ObWhiteFilterExecutor *>(filter)->prepare_runtime_filter(filter_all_pass))) {
+      LOG_WARN("Failed to prepare runtime filter", K(ret), KPC(filter));
+    } else if (filter_all_pass) {
+      result->reuse(true);
+    } else if (OB_FAIL(micro_scanner.filter_pushdown_filter(parent, filter, pd_filter_info_, *result))) {
       LOG_WARN("Failed to filter pushdown filter", K(ret), KPC(filter));
     }
   } else if (filter->is_logic_op_node()) {
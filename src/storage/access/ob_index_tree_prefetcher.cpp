@@ -396,6 +396,7 @@ void ObIndexTreeMultiPrefetcher::reset()
   prefetched_rowkey_cnt_ = 0;
   rowkeys_ = nullptr;
   ext_read_handles_.reset();
+  inflight_index_handles_.reset();
   ObIndexTreePrefetcher::reset();
 }
 
@@ -405,6 +406,7 @@ void ObIndexTreeMultiPrefetcher::reuse()
   prefetch_rowkey_idx_ = 0;
   prefetched_rowkey_cnt_ = 0;
   rowkeys_ = nullptr;
+  inflight_index_handles_.reset();
   ObIndexTreePrefetcher::reuse();
 }
 
@@ -472,6 +474,8 @@ int ObIndexTreeMultiPrefetcher::switch_context(
     index_read_info_ = &index_read_info;
     index_tree_height_ = sstable_->get_meta().get_index_tree_height();
     max_handle_prefetching_cnt_ = min(rowkeys_->count(), MAX_MULTIGET_MICRO_DATA_HANDLE_CNT);
+    // the blocks in flight belong to the previous sstable
+    inflight_index_handles_.reset();
     if (OB_FAIL(ext_read_handles_.prepare_reallocate(max_handle_prefetching_cnt_))) {
       LOG_WARN("Fail to init read_handles", K(ret), K(max_handle_prefetching_cnt_));
     } else if (!is_rescan_) {
@@ -500,74 +504,90 @@ int ObIndexTreeMultiPrefetcher::multi_prefetch()
     ret = OB_NOT_INIT;
     LOG_WARN("ObIndexTreeMultiPrefetcher not init", K(ret));
   } else {
+    // issue the reads of all rowkeys in the window without waiting first, so their
+    // index block ios are in flight together, then wait only for the rowkey to be fetched
     const int64_t rowkey_cnt = rowkeys_->count();
+    inflight_index_handles_.release_fetched(fetch_rowkey_idx_);
     for (int64_t i = fetch_rowkey_idx_;
          OB_SUCC(ret) && prefetched_rowkey_cnt_ < rowkey_cnt && i < fetch_rowkey_idx_ + max_handle_prefetching_cnt_;
          ++i) {
-      const bool is_rowkey_to_fetched = i == fetch_rowkey_idx_;
-      const bool is_empty_handle = i >= prefetch_rowkey_idx_;
-      ObSSTableReadHandleExt &read_handle = ext_read_handles_[i % max_handle_prefetching_cnt_];
-      if (is_empty_handle && prefetch_rowkey_idx_ < rowkey_cnt) {
-        read_handle.reuse();
-        read_handle.rowkey_ = &rowkeys_->at(prefetch_rowkey_idx_);
-        read_handle.range_idx_ = prefetch_rowkey_idx_;
-        read_handle.is_get_ = true;
-        prefetch_rowkey_idx_++;
+      if (OB_FAIL(prefetch_rowkey(i, false))) {
+        LOG_WARN("Fail to prefetch rowkey", K(ret), K(i));
+      }
+    }
+    if (OB_SUCC(ret) && prefetched_rowkey_cnt_ < rowkey_cnt && fetch_rowkey_idx_ < prefetch_rowkey_idx_) {
+      if (OB_FAIL(prefetch_rowkey(fetch_rowkey_idx_, true))) {
+        LOG_WARN("Fail to prefetch rowkey to be fetched", K(ret), K_(fetch_rowkey_idx));
+      }
+    }
+  }
+  return ret;
+}
 
-        if (OB_FAIL(lookup_in_cache(read_handle))) {
-          LOG_WARN("Failed to lookup_in_cache", K(ret));
-        } else if (ObSSTableRowState::IN_BLOCK == read_handle.row_state_) {
-          if (OB_FAIL(sstable_->get_index_tree_root(*index_read_info_, index_block_))) {
-            LOG_WARN("Fail to get index block root", K(ret));
-          } else if (!index_scanner_.is_valid() && OB_FAIL(init_index_scanner(index_scanner_))) {
-            LOG_WARN("Fail to init index scanner", K(ret));
-          } else if (OB_FAIL(drill_down(ObIndexBlockRowHeader::DEFAULT_IDX_ROW_MACRO_ID, read_handle, false, is_rowkey_to_fetched))) {
-            LOG_WARN("Fail to prefetch next level", K(ret), K(index_block_), K(read_handle), KPC(this));
-          } else {
-            EVENT_INC(ObStatEventIds::INDEX_BLOCK_READ_CNT);
-          }
-        } else {
-          mark_cur_rowkey_prefetched(read_handle);
-        }
-      } else if (read_handle.cur_prefetch_end_) {
-        continue;
-      } else if (read_handle.cur_level_ >= index_tree_height_) {
-        ret = OB_ERR_UNEXPECTED;
-        LOG_WARN("Fail to prefetch, unexpected cur level", K(ret), K(read_handle.cur_level_), K(index_tree_height_), K(read_handle), KPC(this));
-      } else if (ObSSTableRowState::IN_BLOCK == read_handle.row_state_) {
-        bool stop_prefetch = false;
-        int64_t tenant_id = MTL_ID();
-        ObMicroIndexInfo &cur_index_info = read_handle.index_block_info_;
-        ObMicroBlockDataHandle &next_handle = read_handle.get_read_handle();
-        if (OB_UNLIKELY(!cur_index_info.is_valid() ||
-            nullptr == read_handle.micro_handle_ ||
-            &next_handle == read_handle.micro_handle_ ||
-            ObSSTableMicroBlockState::IN_BLOCK_IO != read_handle.micro_handle_->block_state_)) {
-          ret = OB_ERR_UNEXPECTED;
-          LOG_WARN("Fail to prefetch, unexpected read handle", K(ret), K(read_handle), KPC(this));
-        } else if (OB_FAIL(micro_block_handle_mgr_.get_micro_block_handle(
-                    tenant_id,
-                    cur_index_info,
-                    cur_index_info.is_data_block(),
-                    next_handle))) {
-          //not in cache yet, stop this rowkey prefetching if it's not the rowkey to be feteched
-          ret = OB_SUCCESS;
-          if (is_rowkey_to_fetched) {
-            if (OB_FAIL(read_handle.micro_handle_->get_index_block_data(*index_read_info_, index_block_))) {
-              LOG_WARN("Fail to get index block data", K(ret), KPC(read_handle.micro_handle_));
-            }
-          } else {
-            stop_prefetch = true;
-          }
-        } else if (FALSE_IT(read_handle.set_cur_micro_handle(next_handle))) {
-        } else if (OB_FAIL(read_handle.micro_handle_->get_cached_index_block_data(*index_read_info_, index_block_))) {
-          LOG_WARN("Fail to get cached index block data", K(ret), KPC(read_handle.micro_handle_));
-        }
-        if (OB_SUCC(ret) && !stop_prefetch) {
-          if (OB_FAIL(drill_down(cur_index_info.get_macro_id(), read_handle, cur_index_info.is_leaf_block(), is_rowkey_to_fetched))) {
-            LOG_WARN("Fail to prefetch next level", K(ret), K(index_block_), K(read_handle), KPC(this));
-          }
+int ObIndexTreeMultiPrefetcher::prefetch_rowkey(const int64_t rowkey_idx, const bool is_rowkey_to_fetched)
+{
+  int ret = OB_SUCCESS;
+  const int64_t rowkey_cnt = rowkeys_->count();
+  const bool is_empty_handle = rowkey_idx >= prefetch_rowkey_idx_;
+  ObSSTableReadHandleExt &read_handle = ext_read_handles_[rowkey_idx % max_handle_prefetching_cnt_];
+  if (is_empty_handle && prefetch_rowkey_idx_ < rowkey_cnt) {
+    read_handle.reuse();
+    read_handle.rowkey_ = &rowkeys_->at(prefetch_rowkey_idx_);
+    read_handle.range_idx_ = prefetch_rowkey_idx_;
+    read_handle.is_get_ = true;
+    prefetch_rowkey_idx_++;
+
+    if (OB_FAIL(lookup_in_cache(read_handle))) {
+      LOG_WARN("Failed to lookup_in_cache", K(ret));
+    } else if (ObSSTableRowState::IN_BLOCK == read_handle.row_state_) {
+      if (OB_FAIL(sstable_->get_index_tree_root(*index_read_info_, index_block_))) {
+        LOG_WARN("Fail to get index block root", K(ret));
+      } else if (!index_scanner_.is_valid() && OB_FAIL(init_index_scanner(index_scanner_))) {
+        LOG_WARN("Fail to init index scanner", K(ret));
+      } else if (OB_FAIL(drill_down(ObIndexBlockRowHeader::DEFAULT_IDX_ROW_MACRO_ID, read_handle, false, is_rowkey_to_fetched))) {
+        LOG_WARN("Fail to prefetch next level", K(ret), K(index_block_), K(read_handle), KPC(this));
+      } else {
+        EVENT_INC(ObStatEventIds::INDEX_BLOCK_READ_CNT);
+      }
+    } else {
+      mark_cur_rowkey_prefetched(read_handle);
+    }
+  } else if (read_handle.cur_prefetch_end_) {
+  } else if (read_handle.cur_level_ >= index_tree_height_) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("Fail to prefetch, unexpected cur level", K(ret), K(read_handle.cur_level_), K(index_tree_height_), K(read_handle), KPC(this));
+  } else if (ObSSTableRowState::IN_BLOCK == read_handle.row_state_) {
+    bool stop_prefetch = false;
+    int64_t tenant_id = MTL_ID();
+    ObMicroIndexInfo &cur_index_info = read_handle.index_block_info_;
+    ObMicroBlockDataHandle &next_handle = read_handle.get_read_handle();
+    if (OB_UNLIKELY(!cur_index_info.is_valid() ||
+        nullptr == read_handle.micro_handle_ ||
+        &next_handle == read_handle.micro_handle_ ||
+        ObSSTableMicroBlockState::IN_BLOCK_IO != read_handle.micro_handle_->block_state_)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("Fail to prefetch, unexpected read handle", K(ret), K(read_handle), KPC(this));
+    } else if (OB_FAIL(micro_block_handle_mgr_.get_micro_block_handle(
+                tenant_id,
+                cur_index_info,
+                cur_index_info.is_data_block(),
+                next_handle))) {
+      //not in cache yet, stop this rowkey prefetching if it's not the rowkey to be feteched
+      ret = OB_SUCCESS;
+      if (is_rowkey_to_fetched) {
+        if (OB_FAIL(read_handle.micro_handle_->get_index_block_data(*index_read_info_, index_block_))) {
+          LOG_WARN("Fail to get index block data", K(ret), KPC(read_handle.micro_handle_));
         }
+      } else {
+        stop_prefetch = true;
+      }
+    } else if (FALSE_IT(read_handle.set_cur_micro_handle(next_handle))) {
+    } else if (OB_FAIL(read_handle.micro_handle_->get_cached_index_block_data(*index_read_info_, index_block_))) {
+      LOG_WARN("Fail to get cached index block data", K(ret), KPC(read_handle.micro_handle_));
+    }
+    if (OB_SUCC(ret) && !stop_prefetch) {
+      if (OB_FAIL(drill_down(cur_index_info.get_macro_id(), read_handle, cur_index_info.is_leaf_block(), is_rowkey_to_fetched))) {
+        LOG_WARN("Fail to prefetch next level", K(ret), K(index_block_), K(read_handle), KPC(this));
       }
     }
   }
@@ -608,8 +628,10 @@ int ObIndexTreeMultiPrefetcher::drill_down(
   } else {
     // hold block cache of the parent temporaliy to avoid freed
     ObMicroBlockDataHandle &next_handle = read_handle.get_read_handle();
-    if (OB_FAIL(prefetch_block_data(index_block_info, next_handle, cur_level_is_leaf))) {
+    if (cur_level_is_leaf && OB_FAIL(prefetch_block_data(index_block_info, next_handle, true))) {
       LOG_WARN("fail to prefetch_block_data", K(ret), K(read_handle), K(index_block_info), K(cur_level_is_leaf));
+    } else if (!cur_level_is_leaf && OB_FAIL(prefetch_index_block_data(read_handle.range_idx_, index_block_info, next_handle))) {
+      LOG_WARN("fail to prefetch index block data", K(ret), K(read_handle), K(index_block_info));
     } else if (FALSE_IT(read_handle.set_cur_micro_handle(next_handle))) {
     } else if (cur_level_is_leaf) {
       mark_cur_rowkey_prefetched(read_handle);
@@ -643,6 +665,86 @@ int ObIndexTreeMultiPrefetcher::drill_down(
   return ret;
 }
 
+int ObIndexTreeMultiPrefetcher::prefetch_index_block_data(
+    const int64_t rowkey_idx,
+    ObMicroIndexInfo &index_block_info,
+    ObMicroBlockDataHandle &micro_handle)
+{
+  int ret = OB_SUCCESS;
+  if (inflight_index_handles_.share(MTL_ID(),
+                                    index_block_info.get_macro_id(),
+                                    index_block_info.get_block_offset(),
+                                    index_block_info.get_block_size(),
+                                    micro_handle)) {
+    // another rowkey has submitted io for this block, no read of its own
+    LOG_DEBUG("share inflight index block io", K(index_block_info), K(micro_handle));
+  } else if (OB_FAIL(prefetch_block_data(index_block_info, micro_handle, false))) {
+    LOG_WARN("fail to prefetch index block data", K(ret), K(index_block_info));
+  } else if (ObSSTableMicroBlockState::IN_BLOCK_IO == micro_handle.block_state_) {
+    inflight_index_handles_.add(rowkey_idx, micro_handle);
+  }
+  return ret;
+}
+
+void ObInflightIndexBlockHandles::reset()
+{
+  for (int64_t i = 0; i < MAX_INFLIGHT_CNT; ++i) {
+    entries_[i].rowkey_idx_ = -1;
+    entries_[i].handle_.reset();
+  }
+  next_idx_ = 0;
+}
+
+bool ObInflightIndexBlockHandles::share(
+    const uint64_t tenant_id,
+    const MacroBlockId &macro_id,
+    const int64_t offset,
+    const int64_t size,
+    ObMicroBlockDataHandle &micro_handle) const
+{
+  bool found = false;
+  for (int64_t i = 0; !found && i < MAX_INFLIGHT_CNT; ++i) {
+    const ObMicroBlockDataHandle &handle = entries_[i].handle_;
+    if (ObSSTableMicroBlockState::IN_BLOCK_IO == handle.block_state_ &&
+        tenant_id == handle.tenant_id_ &&
+        macro_id == handle.macro_block_id_ &&
+        offset == handle.micro_info_.offset_ &&
+        size == handle.micro_info_.size_) {
+      micro_handle.share_io(handle);
+      found = true;
+    }
+  }
+  return found;
+}
+
+void ObInflightIndexBlockHandles::add(const int64_t rowkey_idx, const ObMicroBlockDataHandle &micro_handle)
+{
+  Entry &entry = entries_[next_idx_++ % MAX_INFLIGHT_CNT];
+  entry.rowkey_idx_ = rowkey_idx;
+  entry.handle_.share_io(micro_handle);
+}
+
+void ObInflightIndexBlockHandles::release_fetched(const int64_t fetch_rowkey_idx)
+{
+  for (int64_t i = 0; i < MAX_INFLIGHT_CNT; ++i) {
+    if (entries_[i].rowkey_idx_ >= 0 && entries_[i].rowkey_idx_ < fetch_rowkey_idx) {
+      entries_[i].rowkey_idx_ = -1;
+      entries_[i].handle_.reset();
+    }
+  }
+}
+
+int64_t ObInflightIndexBlockHandles::count() const
+{
+  int64_t cnt = 0;
+  for (int64_t i = 0; i < MAX_INFLIGHT_CNT; ++i) {
+    if (entries_[i].rowkey_idx_ >= 0) {
+      ++cnt;
+    }
+  }
+  return cnt;
+}
+
 ////////////////////////////////// MultiPassPrefetcher /////////////////////////////////////////////
 
 void ObIndexTreeMultiPassPrefetcher::reset()
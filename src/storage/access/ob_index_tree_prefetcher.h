@@ -192,10 +192,45 @@ protected:
   MacroBlockId macro_id_;
 };
 
+// Index micro blocks submitted for io by the rowkeys of a multi-get window. A rowkey that
+// reaches a block still in flight shares its io instead of reading the block again.
+// An entry is dropped once the rowkey that submitted it has been fetched, the block is in
+// the block cache by then, so no more than MAX_INFLIGHT_CNT io buffers are pinned.
+class ObInflightIndexBlockHandles
+{
+public:
+  static const int64_t MAX_INFLIGHT_CNT = 16;
+  ObInflightIndexBlockHandles() : next_idx_(0) {}
+  ~ObInflightIndexBlockHandles() { reset(); }
+  void reset();
+  // shares the io of the block into %micro_handle if it is in flight
+  bool share(
+      const uint64_t tenant_id,
+      const MacroBlockId &macro_id,
+      const int64_t offset,
+      const int64_t size,
+      ObMicroBlockDataHandle &micro_handle) const;
+  void add(const int64_t rowkey_idx, const ObMicroBlockDataHandle &micro_handle);
+  // drops the blocks submitted by the rowkeys before %fetch_rowkey_idx
+  void release_fetched(const int64_t fetch_rowkey_idx);
+  int64_t count() const;
+  TO_STRING_KV(K_(next_idx), "count", count());
+private:
+  struct Entry
+  {
+    Entry() : rowkey_idx_(-1), handle_() {}
+    int64_t rowkey_idx_;
+    ObMicroBlockDataHandle handle_;
+  };
+  Entry entries_[MAX_INFLIGHT_CNT];
+  int64_t next_idx_;
+  DISALLOW_COPY_AND_ASSIGN(ObInflightIndexBlockHandles);
+};
+
 class ObIndexTreeMultiPrefetcher : public ObIndexTreePrefetcher
 {
 public:
-  static const int32_t MAX_MULTIGET_MICRO_DATA_HANDLE_CNT = 32;
+  static const int32_t MAX_MULTIGET_MICRO_DATA_HANDLE_CNT = 64;
   struct ObSSTableReadHandleExt : public ObSSTableReadHandle {
     ObSSTableReadHandleExt() :
       ObSSTableReadHandle(),
@@ -252,7 +287,8 @@ public:
       prefetched_rowkey_cnt_(0),
       max_handle_prefetching_cnt_(0),
       rowkeys_(nullptr),
-      ext_read_handles_()
+      ext_read_handles_(),
+      inflight_index_handles_()
   {}
   virtual ~ObIndexTreeMultiPrefetcher() { reset(); }
   virtual void reset() override;
@@ -293,7 +329,13 @@ public:
   int32_t max_handle_prefetching_cnt_;
   const common::ObIArray<blocksstable::ObDatumRowkey> *rowkeys_;
   ReadHandleExtArray ext_read_handles_;
+  ObInflightIndexBlockHandles inflight_index_handles_;
 private:
+  int prefetch_rowkey(const int64_t rowkey_idx, const bool is_rowkey_to_fetched);
+  int prefetch_index_block_data(
+      const int64_t rowkey_idx,
+      ObMicroIndexInfo &index_block_info,
+      ObMicroBlockDataHandle &micro_handle);
   int drill_down(
       const MacroBlockId &macro_id,
       ObSSTableReadHandleExt &read_handle,
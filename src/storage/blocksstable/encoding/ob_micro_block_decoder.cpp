@@ -1681,7 +1681,8 @@ int ObMicroBlockDecoder::compare_rowkey(const ObDatumRange &range,
 int ObMicroBlockDecoder::get_decoder_cache_size(
     const char *block,
     const int64_t block_size,
-    int64_t &size)
+    int64_t &size,
+    const int64_t max_size)
 {
   int ret = OB_SUCCESS;
   if (OB_UNLIKELY(nullptr == block || block_size <= 0)) {
@@ -1696,9 +1697,8 @@ int ObMicroBlockDecoder::get_decoder_cache_size(
       LOG_WARN("get micro block meta failed", K(ret), KP(block), K(block_size));
     } else {
       const int64_t offset_size = sizeof(ObBlockCachedDecoderHeader::Col);
-      for (int64_t i = 0; size < MAX_CACHED_DECODER_BUF_SIZE && i < header->column_count_; i++) {
-        if (size + offset_size + decoder_sizes[col_header[i].type_]
-            > MAX_CACHED_DECODER_BUF_SIZE) {
+      for (int64_t i = 0; size < max_size && i < header->column_count_; i++) {
+        if (size + offset_size + decoder_sizes[col_header[i].type_] > max_size) {
           break;
         }
         size += offset_size + decoder_sizes[col_header[i].type_];
@@ -1714,22 +1714,42 @@ int ObMicroBlockDecoder::cache_decoders(
     const char *block,
     const int64_t block_size,
     const ObColDescIArray &full_schema_cols)
+{
+  int ret = OB_SUCCESS;
+  const ObMicroBlockHeader *header = nullptr;
+  const ObColumnHeader *col_header = nullptr;
+  const char *meta_data = nullptr;
+  if (OB_UNLIKELY(nullptr == block || block_size <= 0 || 0 >= full_schema_cols.count())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(block), K(block_size), K(full_schema_cols));
+  } else if (OB_FAIL(get_micro_metas(header, col_header, meta_data, block, block_size))) {
+    LOG_WARN("get micro block meta failed", K(ret), KP(block), K(block_size));
+  } else if (OB_UNLIKELY(full_schema_cols.count() < header->column_count_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("Unexpected full_schema_cols", K(ret), K(full_schema_cols), K(header->column_count_));
+  } else if (OB_FAIL(cache_decoders(buf, size, block, block_size))) {
+    LOG_WARN("cache decoders failed", K(ret), KP(buf), K(size), KP(block), K(block_size));
+  }
+  return ret;
+}
+
+int ObMicroBlockDecoder::cache_decoders(
+    char *buf,
+    const int64_t size,
+    const char *block,
+    const int64_t block_size)
 {
   int ret = OB_SUCCESS;
   if (OB_UNLIKELY(nullptr == buf || size <= sizeof(ObBlockCachedDecoderHeader) ||
-                  nullptr == block || block_size <= 0 || 0 >= full_schema_cols.count())) {
+                  nullptr == block || block_size <= 0)) {
     ret = OB_INVALID_ARGUMENT;
-    LOG_WARN("invalid argument", K(ret), KP(buf), K(size),
-             KP(block), K(block_size), K(full_schema_cols));
+    LOG_WARN("invalid argument", K(ret), KP(buf), K(size), KP(block), K(block_size));
   } else {
     const ObMicroBlockHeader *header = nullptr;
     const ObColumnHeader *col_header = nullptr;
     const char *meta_data = nullptr;
     if (OB_FAIL(get_micro_metas(header, col_header, meta_data, block, block_size))) {
       LOG_WARN("get micro block meta failed", K(ret), KP(block), K(block_size));
-    } else if (OB_UNLIKELY(full_schema_cols.count() < header->column_count_)) {
-      ret = OB_ERR_UNEXPECTED;
-      LOG_WARN("Unexpected full_schema_cols", K(ret), K(full_schema_cols), K(header->column_count_));
     } else {
       MEMSET(buf, 0, size);
       ObBlockCachedDecoderHeader *h = reinterpret_cast<ObBlockCachedDecoderHeader *>(buf);
@@ -1764,6 +1784,19 @@ int ObMicroBlockDecoder::cache_decoders(
   return ret;
 }
 
+int ObMicroBlockDecoder::get_cached_decoder_count(const char *buf, const int64_t size, int64_t &count)
+{
+  int ret = OB_SUCCESS;
+  count = 0;
+  if (OB_UNLIKELY(nullptr == buf || size < sizeof(ObBlockCachedDecoderHeader))) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(buf), K(size));
+  } else {
+    count = reinterpret_cast<const ObBlockCachedDecoderHeader *>(buf)->count_;
+  }
+  return ret;
+}
+
 int ObMicroBlockDecoder::update_cached_decoders(char *cache, const int64_t cache_size,
     const char *old_block, const char *cur_block, const int64_t block_size)
 {
@@ -187,6 +187,8 @@ public:
   static const int64_t ROW_CACHE_BUF_SIZE = 64 * 1024;
   static const int64_t CPU_CACHE_LINE_SIZE = 64;
   static const int64_t MAX_CACHED_DECODER_BUF_SIZE = 1L << 10;
+  // decoders of all columns kept in ObDecodedMicroBlockCache, bounded by the 16 bit decoder offset
+  static const int64_t MAX_DECODED_BLOCK_BUF_SIZE = 32L << 10;
 
   ObMicroBlockDecoder();
   virtual ~ObMicroBlockDecoder();
@@ -218,13 +220,20 @@ public:
   static int get_decoder_cache_size(
       const char *block,
       const int64_t block_size,
-      int64_t &size);
+      int64_t &size,
+      const int64_t max_size = MAX_CACHED_DECODER_BUF_SIZE);
   static int cache_decoders(
       char *buf,
       const int64_t size,
       const char *block,
       const int64_t block_size,
       const ObColDescIArray &full_schema_cols);
+  static int cache_decoders(
+      char *buf,
+      const int64_t size,
+      const char *block,
+      const int64_t block_size);
+  static int get_cached_decoder_count(const char *buf, const int64_t size, int64_t &count);
   static int update_cached_decoders(char *cache, const int64_t cache_size,
       const char *old_block, const char *cur_block, const int64_t block_size);
   // Filter interface for filter pushdown
@@ -521,13 +521,18 @@ int ObIMicroBlockIOCallback::assign(const ObIMicroBlockIOCallback &other)
 ObSingleMicroBlockIOCallback::ObSingleMicroBlockIOCallback()
   : ObIMicroBlockIOCallback(),
     micro_block_(nullptr),
-    cache_handle_()
+    cache_handle_(),
+    kvpair_(nullptr),
+    inst_handle_()
 {
   STATIC_ASSERT(sizeof(*this) <= CALLBACK_BUF_SIZE, "IOCallback buf size not enough");
 }
 
 ObSingleMicroBlockIOCallback::~ObSingleMicroBlockIOCallback()
 {
+  if (OB_NOT_NULL(kvpair_)) {
+    release_cache_io_buf();
+  }
   if (OB_NOT_NULL(allocator_) && OB_NOT_NULL(micro_block_) && !cache_handle_.is_valid()) {
     allocator_->free(const_cast<ObMicroBlockCacheValue *>(micro_block_));
     micro_block_ = nullptr;
@@ -551,11 +556,20 @@ int ObSingleMicroBlockIOCallback::inner_process(const bool is_success)
     if (OB_ISNULL(reader = GET_TSI_MULT(ObMacroBlockReader, 1))) {
       ret = OB_ALLOCATE_MEMORY_FAILED;
       LOG_WARN("Fail to allocate ObMacroBlockReader, ", K(ret));
+    } else if (OB_NOT_NULL(micro_block_)) {
+      // found in cache before the io was issued, see alloc_io_buf_in_cache
+    } else if (OB_NOT_NULL(kvpair_)) {
+      if (OB_FAIL(put_io_buf_to_cache(reader))) {
+        LOG_WARN("Fail to put io buffer to block cache", K(ret));
+      }
     } else if (OB_FAIL(process_block(reader, data_buffer_, offset_, size_, micro_block_, cache_handle_))) {
       LOG_WARN("process_block failed", K(ret));
     }
   }
 
+  if (OB_NOT_NULL(kvpair_)) {
+    release_cache_io_buf();
+  }
   if (OB_NOT_NULL(allocator_) && OB_NOT_NULL(io_buffer_)) {
     allocator_->free(io_buffer_);
     io_buffer_ = nullptr;
@@ -563,6 +577,145 @@ int ObSingleMicroBlockIOCallback::inner_process(const bool is_success)
   return ret;
 }
 
+int ObSingleMicroBlockIOCallback::alloc_io_buf(
+    char *&io_buf, int64_t &align_size, int64_t &align_offset)
+{
+  int ret = OB_SUCCESS;
+  align_size = 0;
+  align_offset = 0;
+  common::align_offset_size(offset_, size_, align_offset, align_size);
+  if (!can_read_into_cache(align_size)) {
+    ret = ObIMicroBlockIOCallback::alloc_io_buf(io_buf, align_size, align_offset);
+  } else if (OB_FAIL(alloc_io_buf_in_cache(io_buf, align_size, align_offset))) {
+    if (OB_ENTRY_EXIST != ret) {
+      LOG_TRACE("Fail to alloc io buffer in block cache, use normal io buffer", K(ret), K_(offset), K_(size));
+    }
+    ret = ObIMicroBlockIOCallback::alloc_io_buf(io_buf, align_size, align_offset);
+  }
+  return ret;
+}
+
+bool ObSingleMicroBlockIOCallback::can_read_into_cache(const int64_t align_size) const
+{
+  // An uncompressed block is stored in cache as it is on disk, so the slot can be reserved before
+  // the io and used as io buffer. The slot must be large enough to align the io, at most three
+  // pages more than the block, so blocks smaller than the padding still take the copying path.
+  // Compressed blocks are decompressed straight into a slot reserved after the io, see process_block.
+  return use_block_cache_
+      && OB_NOT_NULL(cache_)
+      && OB_NOT_NULL(read_info_)
+      && ObMicroBlockData::DATA_BLOCK == cache_->get_type()
+      && ObCompressorType::NONE_COMPRESSOR == block_des_meta_.compressor_type_
+      && (align_size + DIO_READ_ALIGN_SIZE - size_) * 100 <= size_ * MAX_CACHE_IO_BUF_PADDING_PCT;
+}
+
+int ObSingleMicroBlockIOCallback::alloc_io_buf_in_cache(
+    char *&io_buf, const int64_t align_size, const int64_t align_offset)
+{
+  int ret = OB_SUCCESS;
+  ObIMicroBlockCache::BaseBlockCache *kvcache = nullptr;
+  int64_t extra_size = 0;
+  bool need_decoder = false;
+  const int64_t value_size = DIO_READ_ALIGN_SIZE + align_size - size_ + cache_->calc_value_size(
+      size_, row_store_type_, 0, read_info_->get_request_count(), extra_size, need_decoder);
+  ObMicroBlockCacheKey key(tenant_id_, block_id_, offset_, size_);
+  if (OB_FAIL(cache_->get_cache(kvcache))) {
+    LOG_WARN("Fail to get kvcache", K(ret));
+  } else if (OB_SUCCESS == kvcache->get(key, micro_block_, cache_handle_)) {
+    // entry exist, keep it and read into a normal io buffer, which is dropped after the io
+    ret = OB_ENTRY_EXIST;
+  } else if (FALSE_IT(micro_block_ = nullptr)) {
+  } else if (OB_FAIL(kvcache->alloc(tenant_id_, sizeof(ObMicroBlockCacheKey), value_size,
+                                    kvpair_, cache_handle_, inst_handle_))) {
+    LOG_TRACE("Fail to alloc cache buf", K(ret), K_(tenant_id), K(value_size));
+  } else {
+    char *value_buf = reinterpret_cast<char *>(kvpair_->value_) + sizeof(ObMicroBlockCacheValue);
+    io_buf = reinterpret_cast<char *>(upper_align(reinterpret_cast<int64_t>(value_buf),
+                                                  DIO_READ_ALIGN_SIZE));
+    data_buffer_ = io_buf + (offset_ - align_offset);
+  }
+  if (OB_FAIL(ret) && OB_ENTRY_EXIST != ret) {
+    release_cache_io_buf();
+  }
+  return ret;
+}
+
+int ObSingleMicroBlockIOCallback::put_io_buf_to_cache(ObMacroBlockReader *reader)
+{
+  int ret = OB_SUCCESS;
+  ObIMicroBlockCache::BaseBlockCache *kvcache = nullptr;
+  ObMicroBlockHeader header;
+  int64_t pos = 0;
+  int64_t payload_size = 0;
+  const char *payload_buf = nullptr;
+  if (OB_FAIL(header.deserialize(data_buffer_, size_, pos))) {
+    LOG_ERROR("Fail to deserialize record header", K(ret), K_(block_id), K_(offset));
+  } else if (OB_FAIL(header.check_and_get_record(
+      data_buffer_, size_, MICRO_BLOCK_HEADER_MAGIC, payload_buf, payload_size))) {
+    LOG_ERROR("Micro block data is corrupted", K(ret), K_(block_id), K_(offset), K_(size),
+        K_(tenant_id), KP_(data_buffer), KP(this));
+  } else if (OB_UNLIKELY(header.header_size_ + header.data_length_ != size_)) {
+    // block is compressed though the table is not, decompress it into a new cache value instead,
+    // the reserved slot holding the io buffer is pinned until then
+    ObKVCacheHandle io_buf_handle;
+    io_buf_handle = cache_handle_;
+    cache_handle_.reset();
+    kvpair_ = nullptr;
+    inst_handle_.reset();
+    if (OB_FAIL(process_block(reader, data_buffer_, offset_, size_, micro_block_, cache_handle_))) {
+      LOG_WARN("process_block failed", K(ret));
+    }
+  } else if (OB_FAIL(cache_->get_cache(kvcache))) {
+    LOG_WARN("Fail to get kvcache", K(ret));
+  } else {
+    kvpair_->key_ = new (kvpair_->key_) ObMicroBlockCacheKey(tenant_id_, block_id_, offset_, size_);
+    ObMicroBlockCacheValue *cache_value = new (kvpair_->value_) ObMicroBlockCacheValue(data_buffer_, size_);
+    ObMicroBlockData &micro_data = cache_value->get_block_data();
+    micro_data.type_ = cache_->get_type();
+    int64_t align_offset = 0;
+    int64_t align_size = 0;
+    common::align_offset_size(offset_, size_, align_offset, align_size);
+    char *extra_buf = data_buffer_ - (offset_ - align_offset) + align_size;
+    int64_t extra_size = 0;
+    bool need_decoder = false;
+    cache_->calc_value_size(size_, row_store_type_, header.row_count_,
+                            read_info_->get_request_count(), extra_size, need_decoder);
+    if (need_write_extra_buf_ && OB_FAIL(cache_->write_extra_buf(*read_info_, data_buffer_, size_,
+                                                                 extra_size, extra_buf, micro_data))) {
+      LOG_WARN("Fail to writer extra buffer of block data", K(ret), K(header), KPC(cache_value));
+    } else if (FALSE_IT(micro_block_ = cache_value)) {
+    } else if (OB_FAIL(kvcache->put_kvpair(inst_handle_, kvpair_, cache_handle_, false /* overwrite */))) {
+      if (OB_ENTRY_EXIST != ret) {
+        LOG_WARN("Fail to put micro block cache", K(ret));
+      } else {
+        ret = OB_SUCCESS;
+      }
+    } else {
+      const int64_t put_size = ObKVStoreMemBlock::get_align_size(*kvpair_->key_, *cache_value);
+      if (OB_FAIL(put_size_stat_->add_put_size(put_size))) {
+        LOG_WARN("add_put_size failed", K(ret), K(put_size));
+      }
+    }
+    if (OB_FAIL(ret)) {
+      cache_handle_.reset();
+      micro_block_ = nullptr;
+    }
+    kvpair_ = nullptr;
+    inst_handle_.reset();
+  }
+  return ret;
+}
+
+void ObSingleMicroBlockIOCallback::release_cache_io_buf()
+{
+  // the reserved slot is dropped with the handles if it is never put into cache
+  kvpair_ = nullptr;
+  inst_handle_.reset();
+  cache_handle_.reset();
+  micro_block_ = nullptr;
+  data_buffer_ = nullptr;
+}
+
 int ObSingleMicroBlockIOCallback::inner_deep_copy(
     char *buf,
     const int64_t buf_len,
@@ -1278,5 +1431,189 @@ ObMicroBlockData::Type ObIndexMicroBlockCache::get_type()
 }
 
 
+/*-----------------------------------ObDecodedMicroBlockCache-------------------------------------*/
+ObDecodedMicroBlockCacheKey::ObDecodedMicroBlockCacheKey(
+    const ObMicroBlockCacheKey &block_key,
+    const ObKVCacheHandle &block_cache_handle)
+  : block_key_(block_key),
+    mb_id_(reinterpret_cast<uint64_t>(block_cache_handle.get_mb_handle())),
+    mb_seq_num_(block_cache_handle.get_mb_seq_num())
+{
+}
+
+ObDecodedMicroBlockCacheKey::ObDecodedMicroBlockCacheKey()
+  : block_key_(),
+    mb_id_(0),
+    mb_seq_num_(0)
+{
+}
+
+ObDecodedMicroBlockCacheKey::~ObDecodedMicroBlockCacheKey()
+{
+}
+
+bool ObDecodedMicroBlockCacheKey::operator ==(const ObIKVCacheKey &other) const
+{
+  const ObDecodedMicroBlockCacheKey &other_key = reinterpret_cast<const ObDecodedMicroBlockCacheKey &>(other);
+  return block_key_ == other_key.block_key_
+      && mb_id_ == other_key.mb_id_
+      && mb_seq_num_ == other_key.mb_seq_num_;
+}
+
+uint64_t ObDecodedMicroBlockCacheKey::get_tenant_id() const
+{
+  return block_key_.get_tenant_id();
+}
+
+uint64_t ObDecodedMicroBlockCacheKey::hash() const
+{
+  uint64_t hash_val = block_key_.hash();
+  hash_val = murmurhash(&mb_id_, sizeof(mb_id_), hash_val);
+  hash_val = murmurhash(&mb_seq_num_, sizeof(mb_seq_num_), hash_val);
+  return hash_val;
+}
+
+int64_t ObDecodedMicroBlockCacheKey::size() const
+{
+  return sizeof(*this);
+}
+
+int ObDecodedMicroBlockCacheKey::deep_copy(char *buf, const int64_t buf_len, ObIKVCacheKey *&key) const
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(nullptr == buf || buf_len < size())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("Invalid argument", K(ret), KP(buf), K(buf_len));
+  } else if (OB_UNLIKELY(!is_valid())) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("The decoded micro block cache key is invalid", K(ret), K(*this));
+  } else {
+    ObDecodedMicroBlockCacheKey *new_key = new (buf) ObDecodedMicroBlockCacheKey();
+    new_key->block_key_ = block_key_;
+    new_key->mb_id_ = mb_id_;
+    new_key->mb_seq_num_ = mb_seq_num_;
+    key = new_key;
+  }
+  return ret;
+}
+
+ObDecodedMicroBlockCacheValue::ObDecodedMicroBlockCacheValue(
+    const char *block_buf,
+    const char *decoder_buf,
+    const int64_t decoder_size)
+  : block_buf_(block_buf),
+    decoder_buf_(decoder_buf),
+    decoder_size_(decoder_size)
+{
+}
+
+ObDecodedMicroBlockCacheValue::~ObDecodedMicroBlockCacheValue()
+{
+}
+
+int64_t ObDecodedMicroBlockCacheValue::size() const
+{
+  return sizeof(ObDecodedMicroBlockCacheValue) + decoder_size_;
+}
+
+int ObDecodedMicroBlockCacheValue::deep_copy(char *buf, const int64_t buf_len, ObIKVCacheValue *&value) const
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(nullptr == buf || buf_len < size())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("Invalid argument", K(ret), KP(buf), K(buf_len), "size", size());
+  } else if (OB_UNLIKELY(nullptr == block_buf_ || nullptr == decoder_buf_ || decoder_size_ <= 0)) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("The decoded micro block cache value is not valid", K(ret), K(*this));
+  } else {
+    char *new_buf = buf + sizeof(ObDecodedMicroBlockCacheValue);
+    MEMCPY(new_buf, decoder_buf_, decoder_size_);
+    value = new (buf) ObDecodedMicroBlockCacheValue(block_buf_, new_buf, decoder_size_);
+  }
+  return ret;
+}
+
+int ObDecodedMicroBlockCache::get_decoders(
+    const ObMicroBlockCacheKey &block_key,
+    const ObMicroBlockBufferHandle &block_handle,
+    ObMicroBlockData &block_data,
+    ObKVCacheHandle &handle)
+{
+  int ret = OB_SUCCESS;
+  const ObMicroBlockHeader *header = block_data.get_micro_header();
+  const ObDecodedMicroBlockCacheValue *value = nullptr;
+  int64_t cached_cnt = 0;
+  handle.reset();
+  if (!block_handle.is_valid() || block_handle.get_block_data()->get_buf() != block_data.get_buf()) {
+    // only blocks in block cache are admitted, cold reads do not fill this cache
+  } else if (ObMicroBlockData::DATA_BLOCK != block_data.type_ || nullptr == header
+      || nullptr == block_data.get_extra_buf() || block_data.get_extra_size() <= 0) {
+    // only encoded blocks in block cache, which come with the first decoders cached
+  } else if (OB_FAIL(ObMicroBlockDecoder::get_cached_decoder_count(
+      block_data.get_extra_buf(), block_data.get_extra_size(), cached_cnt))) {
+    LOG_WARN("Fail to get cached decoder count", K(ret), K(block_data));
+  } else if (cached_cnt >= header->column_count_) {
+    // decoders of all columns are cached with the block already
+  } else {
+    const ObDecodedMicroBlockCacheKey key(block_key, block_handle.get_cache_handle());
+    if (OB_FAIL(get(key, value, handle))) {
+      if (OB_UNLIKELY(OB_ENTRY_NOT_EXIST != ret)) {
+        LOG_WARN("Fail to get decoded micro block", K(ret), K(key));
+      } else if (OB_FAIL(put_decoders(key, block_data, value, handle))) {
+        LOG_WARN("Fail to put decoded micro block", K(ret), K(key));
+      }
+    } else if (OB_UNLIKELY(value->get_block_buf() != block_data.get_buf())) {
+      // another copy of the block put by a concurrent load into the same memory block
+      value = nullptr;
+    }
+  }
+  if (OB_SUCC(ret) && nullptr != value) {
+    block_data.get_extra_buf() = value->get_decoder_buf();
+    block_data.get_extra_size() = value->get_decoder_size();
+  } else {
+    handle.reset();
+  }
+  return ret;
+}
+
+int ObDecodedMicroBlockCache::put_decoders(
+    const ObDecodedMicroBlockCacheKey &key,
+    const ObMicroBlockData &block_data,
+    const ObDecodedMicroBlockCacheValue *&value,
+    ObKVCacheHandle &handle)
+{
+  int ret = OB_SUCCESS;
+  int64_t decoder_size = 0;
+  ObKVCachePair *kvpair = nullptr;
+  ObKVCacheInstHandle inst_handle;
+  value = nullptr;
+  handle.reset();
+  if (OB_FAIL(ObMicroBlockDecoder::get_decoder_cache_size(block_data.get_buf(), block_data.get_buf_size(),
+      decoder_size, ObMicroBlockDecoder::MAX_DECODED_BLOCK_BUF_SIZE))) {
+    LOG_WARN("Fail to get decoder cache size", K(ret), K(block_data));
+  } else if (OB_FAIL(alloc(key.get_tenant_id(), sizeof(ObDecodedMicroBlockCacheKey),
+      sizeof(ObDecodedMicroBlockCacheValue) + decoder_size, kvpair, handle, inst_handle))) {
+    LOG_WARN("Fail to alloc cache buf", K(ret), K(decoder_size));
+  } else {
+    char *decoder_buf = reinterpret_cast<char *>(kvpair->value_) + sizeof(ObDecodedMicroBlockCacheValue);
+    if (OB_FAIL(ObMicroBlockDecoder::cache_decoders(decoder_buf, decoder_size,
+        block_data.get_buf(), block_data.get_buf_size()))) {
+      LOG_WARN("Fail to cache decoders", K(ret), K(block_data), K(decoder_size));
+    } else if (OB_FAIL(key.deep_copy(reinterpret_cast<char *>(kvpair->key_), key.size(), kvpair->key_))) {
+      LOG_WARN("Fail to copy decoded micro block key", K(ret), K(key));
+    } else {
+      value = new (kvpair->value_) ObDecodedMicroBlockCacheValue(block_data.get_buf(), decoder_buf, decoder_size);
+      if (OB_FAIL(put_kvpair(inst_handle, kvpair, handle, true /* overwrite */))) {
+        LOG_WARN("Fail to put decoded micro block", K(ret), K(key));
+      }
+    }
+  }
+  if (OB_FAIL(ret)) {
+    handle.reset();
+    value = nullptr;
+  }
+  return ret;
+}
+
 }//end namespace blocksstable
 }//end namespace oceanbase
@@ -89,6 +89,7 @@ public:
   inline const ObMicroBlockData* get_block_data() const
   { return is_valid() ? &(micro_block_->get_block_data()) : NULL; }
   inline bool is_valid() const { return NULL != micro_block_ && handle_.is_valid(); }
+  inline const common::ObKVCacheHandle &get_cache_handle() const { return handle_; }
   TO_STRING_KV(K_(handle), KP_(micro_block));
 private:
   friend class ObIMicroBlockCache;
@@ -201,14 +202,25 @@ public:
       char *buf, const int64_t buf_len,
       ObIOCallback *&callback) const override;
   virtual const char *get_data() override;
+  virtual int alloc_io_buf(char *&io_buf, int64_t &io_buf_size, int64_t &aligned_offset) override;
   INHERIT_TO_STRING_KV("ObIMicroBlockIOCallback", ObIMicroBlockIOCallback, KP_(micro_block),
-                       K_(tablet_handle), K_(cache_handle), K_(need_write_extra_buf));
+                       K_(tablet_handle), K_(cache_handle), K_(need_write_extra_buf), KP_(kvpair));
 private:
   friend class ObIMicroBlockCache;
+  bool can_read_into_cache(const int64_t align_size) const;
+  int alloc_io_buf_in_cache(char *&io_buf, const int64_t align_size, const int64_t align_offset);
+  int put_io_buf_to_cache(ObMacroBlockReader *reader);
+  void release_cache_io_buf();
+  // largest alignment padding allowed for a cache slot used as io buffer, in percent of block size,
+  // blocks of the default 16KB size always fit
+  static const int64_t MAX_CACHE_IO_BUF_PADDING_PCT = 100;
   // Notice: lifetime shoule be longer than AIO or deep copy here
   const ObMicroBlockCacheValue *micro_block_;
   ObTabletHandle tablet_handle_;
   common::ObKVCacheHandle cache_handle_;
+  // uncompressed blocks are read directly into this reserved cache slot, see alloc_io_buf
+  common::ObKVCachePair *kvpair_;
+  common::ObKVCacheInstHandle inst_handle_;
 };
 
 class ObMultiDataBlockIOCallback : public ObIMicroBlockIOCallback
@@ -352,6 +364,80 @@ public:
   virtual ObMicroBlockData::Type get_type() override;
 };
 
+// The decoders keep pointers into the block they are built on, so besides the micro block
+// they are keyed on the copy of the block in the block cache, that is the memory block
+// holding it and the sequence number of that memory block. A reloaded block gets a new
+// key and the entries of the old copies age out.
+class ObDecodedMicroBlockCacheKey : public common::ObIKVCacheKey
+{
+public:
+  ObDecodedMicroBlockCacheKey(
+      const ObMicroBlockCacheKey &block_key,
+      const common::ObKVCacheHandle &block_cache_handle);
+  ObDecodedMicroBlockCacheKey();
+  virtual ~ObDecodedMicroBlockCacheKey();
+  virtual bool operator ==(const ObIKVCacheKey &other) const;
+  virtual uint64_t get_tenant_id() const;
+  virtual uint64_t hash() const;
+  virtual int64_t size() const;
+  virtual int deep_copy(char *buf, const int64_t buf_len, ObIKVCacheKey *&key) const;
+  bool is_valid() const { return 0 != mb_id_; }
+  TO_STRING_KV(K_(block_key), K_(mb_id), K_(mb_seq_num));
+private:
+  ObMicroBlockCacheKey block_key_;
+  uint64_t mb_id_;
+  uint32_t mb_seq_num_;
+};
+
+class ObDecodedMicroBlockCacheValue : public common::ObIKVCacheValue
+{
+public:
+  ObDecodedMicroBlockCacheValue(
+      const char *block_buf,
+      const char *decoder_buf,
+      const int64_t decoder_size);
+  virtual ~ObDecodedMicroBlockCacheValue();
+  virtual int64_t size() const;
+  virtual int deep_copy(char *buf, const int64_t buf_len, ObIKVCacheValue *&value) const;
+  inline const char *get_block_buf() const { return block_buf_; }
+  inline const char *get_decoder_buf() const { return decoder_buf_; }
+  inline int64_t get_decoder_size() const { return decoder_size_; }
+  TO_STRING_KV(KP_(block_buf), KP_(decoder_buf), K_(decoder_size));
+private:
+  // the block the decoders are built on, checked before use in case the same block is
+  // put into one memory block twice by concurrent loads
+  const char *block_buf_;
+  const char *decoder_buf_;
+  int64_t decoder_size_;
+private:
+  DISALLOW_COPY_AND_ASSIGN(ObDecodedMicroBlockCacheValue);
+};
+
+// Column decoders of all columns for hot encoded data micro blocks. The decoders cached
+// with the block in ObDataMicroBlockCache only cover the first columns that fit in
+// MAX_CACHED_DECODER_BUF_SIZE, this cache keeps the rest for point gets on wide tables.
+class ObDecodedMicroBlockCache
+  : public common::ObKVCache<ObDecodedMicroBlockCacheKey, ObDecodedMicroBlockCacheValue>
+{
+public:
+  ObDecodedMicroBlockCache() {}
+  virtual ~ObDecodedMicroBlockCache() {}
+  // replace the extra buffer of block_data with decoders of all columns if possible,
+  // handle pins the decoders and must live as long as block_data is used.
+  // Only blocks read from the block cache through block_handle are admitted.
+  int get_decoders(
+      const ObMicroBlockCacheKey &key,
+      const ObMicroBlockBufferHandle &block_handle,
+      ObMicroBlockData &block_data,
+      common::ObKVCacheHandle &handle);
+private:
+  int put_decoders(
+      const ObDecodedMicroBlockCacheKey &key,
+      const ObMicroBlockData &block_data,
+      const ObDecodedMicroBlockCacheValue *&value,
+      common::ObKVCacheHandle &handle);
+  DISALLOW_COPY_AND_ASSIGN(ObDecodedMicroBlockCache);
+};
 
 }//end namespace blocksstable
 }//end namespace oceanbase
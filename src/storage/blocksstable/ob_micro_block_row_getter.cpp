@@ -245,6 +245,7 @@ int ObMicroBlockRowGetter::get_block_row(
   ObMicroBlockData block_data;
   if (OB_FAIL(read_handle.get_block_data(block_reader, block_data))) {
     LOG_WARN("Fail to get block data", K(ret), K(read_handle));
+  } else if (FALSE_IT(get_decoded_block(*read_handle.micro_handle_, block_data))) {
   } else if (OB_FAIL(inner_get_row(
               read_handle.micro_handle_->macro_block_id_,
               *read_handle.rowkey_,
@@ -277,6 +278,27 @@ int ObMicroBlockRowGetter::get_block_row(
   return ret;
 }
 
+void ObMicroBlockRowGetter::get_decoded_block(
+    const storage::ObMicroBlockDataHandle &micro_handle,
+    ObMicroBlockData &block_data)
+{
+  int tmp_ret = OB_SUCCESS;
+  decoded_cache_handle_.reset();
+  // only blocks hit in block cache, blocks read by io are used once and not admitted
+  if (storage::ObSSTableMicroBlockState::IN_BLOCK_CACHE == micro_handle.block_state_
+      && (ENCODING_ROW_STORE == block_data.get_store_type()
+          || SELECTIVE_ENCODING_ROW_STORE == block_data.get_store_type())) {
+    ObMicroBlockCacheKey key(micro_handle.tenant_id_,
+                             micro_handle.macro_block_id_,
+                             micro_handle.micro_info_.offset_,
+                             micro_handle.micro_info_.size_);
+    if (OB_TMP_FAIL(OB_STORE_CACHE.get_decoded_block_cache().get_decoders(
+        key, micro_handle.cache_handle_, block_data, decoded_cache_handle_))) {
+      LOG_DEBUG("Fail to get decoded block, build decoders on open", K(tmp_ret), K(key));
+    }
+  }
+}
+
 int ObMicroBlockRowGetter::get_cached_row(
     const ObDatumRowkey &rowkey,
     const ObRowCacheValue &value,
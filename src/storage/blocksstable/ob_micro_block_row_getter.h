@@ -23,6 +23,7 @@ namespace oceanbase
 {
 namespace storage {
 struct ObSSTableReadHandle;
+struct ObMicroBlockDataHandle;
 }
 
 namespace blocksstable
@@ -55,7 +56,7 @@ protected:
 class ObMicroBlockRowGetter : public ObIMicroBlockRowFetcher
 {
 public:
-  ObMicroBlockRowGetter() : read_info_(nullptr), row_(), cache_project_row_() {};
+  ObMicroBlockRowGetter() : read_info_(nullptr), row_(), cache_project_row_(), decoded_cache_handle_() {};
   virtual ~ObMicroBlockRowGetter() {};
   virtual int init(
       const storage::ObTableIterParam &param,
@@ -71,6 +72,7 @@ public:
       const blocksstable::ObSSTable *sstable) override;
 private:
   int get_block_row(ObSSTableReadHandle &read_handle, ObMacroBlockReader &block_reader, const ObDatumRow *&store_row);
+  void get_decoded_block(const storage::ObMicroBlockDataHandle &micro_handle, ObMicroBlockData &block_data);
   int get_cached_row(const ObDatumRowkey &rowkey, const ObRowCacheValue &value, const ObDatumRow *&row);
   int get_not_exist_row(const ObDatumRowkey &rowkey, const ObDatumRow *&row);
   int project_cache_row(const ObRowCacheValue &value, ObDatumRow &row);
@@ -83,6 +85,8 @@ private:
   const ObTableReadInfo *read_info_;
   ObDatumRow row_;
   ObDatumRow cache_project_row_;
+  // pins decoders from ObDecodedMicroBlockCache used by the current block row
+  common::ObKVCacheHandle decoded_cache_handle_;
 };
 
 }
@@ -21,6 +21,7 @@ namespace blocksstable
 ObStorageCacheSuite::ObStorageCacheSuite()
   : index_block_cache_(),
     user_block_cache_(),
+    decoded_block_cache_(),
     user_row_cache_(),
     bf_cache_(),
     fuse_row_cache_(),
@@ -55,6 +56,8 @@ int ObStorageCacheSuite::init(
     STORAGE_LOG(ERROR, "init infrc block cache failed", K(ret));
   } else if (OB_FAIL(user_block_cache_.init("user_block_cache", user_block_cache_priority))) {
     STORAGE_LOG(ERROR, "init user block cache failed, ", K(ret));
+  } else if (OB_FAIL(decoded_block_cache_.init("decoded_block_cache", user_block_cache_priority))) {
+    STORAGE_LOG(ERROR, "init decoded block cache failed, ", K(ret));
   } else if (OB_FAIL(user_row_cache_.init("user_row_cache", user_row_cache_priority))) {
     STORAGE_LOG(ERROR, "init user sstable row cache failed, ", K(ret));
   } else if (OB_FAIL(bf_cache_.init("bf_cache", bf_cache_priority))) {
@@ -89,6 +92,8 @@ int ObStorageCacheSuite::reset_priority(
     STORAGE_LOG(ERROR, "set priority for index block cache failed", K(ret));
   } else if (OB_FAIL(user_block_cache_.set_priority(user_block_cache_priority))) {
     STORAGE_LOG(ERROR, "set priority for user block cache failed, ", K(ret));
+  } else if (OB_FAIL(decoded_block_cache_.set_priority(user_block_cache_priority))) {
+    STORAGE_LOG(ERROR, "set priority for decoded block cache failed, ", K(ret));
   } else if (OB_FAIL(user_row_cache_.set_priority(user_row_cache_priority))) {
     STORAGE_LOG(ERROR, "set priority for user sstable row cache failed, ", K(ret));
   } else if (OB_FAIL(bf_cache_.set_priority(bf_cache_priority))) {
@@ -112,6 +117,7 @@ void ObStorageCacheSuite::destroy()
 {
   index_block_cache_.destroy();
   user_block_cache_.destroy();
+  decoded_block_cache_.destroy();
   user_row_cache_.destroy();
   bf_cache_.destroy();
   fuse_row_cache_.destroy();
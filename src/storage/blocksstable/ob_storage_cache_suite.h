@@ -46,6 +46,7 @@ public:
   int set_bf_cache_miss_count_threshold(const int64_t bf_cache_miss_count_threshold);
   ObDataMicroBlockCache &get_block_cache() { return user_block_cache_; }
   ObIndexMicroBlockCache &get_index_block_cache() { return index_block_cache_; }
+  ObDecodedMicroBlockCache &get_decoded_block_cache() { return decoded_block_cache_; }
   ObRowCache &get_row_cache() { return user_row_cache_; }
   ObBloomFilterCache &get_bf_cache() { return bf_cache_; }
   ObFuseRowCache &get_fuse_row_cache() { return fuse_row_cache_; }
@@ -57,6 +58,7 @@ private:
   virtual ~ObStorageCacheSuite();
   ObIndexMicroBlockCache index_block_cache_;
   ObDataMicroBlockCache user_block_cache_;
+  ObDecodedMicroBlockCache decoded_block_cache_;
   ObRowCache user_row_cache_;
   ObBloomFilterCache bf_cache_;
   ObFuseRowCache fuse_row_cache_;
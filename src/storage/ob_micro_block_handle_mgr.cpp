@@ -59,6 +59,23 @@ void ObMicroBlockDataHandle::reset()
   allocator_ = nullptr;
 }
 
+void ObMicroBlockDataHandle::share_io(const ObMicroBlockDataHandle &other)
+{
+  if (this != &other) {
+    reset();
+    tenant_id_ = other.tenant_id_;
+    macro_block_id_ = other.macro_block_id_;
+    block_state_ = other.block_state_;
+    block_index_ = other.block_index_;
+    micro_info_ = other.micro_info_;
+    des_meta_ = other.des_meta_;
+    MEMCPY(encrypt_key_, other.encrypt_key_, sizeof(encrypt_key_));
+    des_meta_.encrypt_key_ = encrypt_key_;
+    io_handle_ = other.io_handle_;
+    allocator_ = other.allocator_;
+  }
+}
+
 int ObMicroBlockDataHandle::get_data_block_data(
     ObMacroBlockReader &block_reader,
     ObMicroBlockData &block_data)
@@ -37,6 +37,9 @@ struct ObMicroBlockDataHandle {
   ObMicroBlockDataHandle();
   virtual ~ObMicroBlockDataHandle();
   void reset();
+  // refers to the io of %other still in flight, the index block %other loaded by itself is
+  // not shared, it is freed by %other only
+  void share_io(const ObMicroBlockDataHandle &other);
 
   int get_data_block_data(
       blocksstable::ObMacroBlockReader &block_reader,
@@ -25,6 +25,8 @@ namespace transaction
 OB_SERIALIZE_MEMBER(ObGtsRequest, tenant_id_, srr_.mts_, range_size_, sender_);
 // ObGtsErrResponse
 OB_SERIALIZE_MEMBER(ObGtsErrResponse, tenant_id_, srr_.mts_, status_, sender_);
+// ObGtsBatchRequest
+OB_SERIALIZE_MEMBER(ObGtsBatchRequest, requests_);
 
 int ObGtsRequest::init(const uint64_t tenant_id, const MonotonicTs srr, const int64_t range_size,
     const ObAddr &sender)
@@ -70,5 +72,28 @@ bool ObGtsErrResponse::is_valid() const
   return is_valid_tenant_id(tenant_id_) && srr_.is_valid() && OB_SUCCESS != status_ && sender_.is_valid();
 }
 
+int ObGtsBatchRequest::add_request(const ObGtsRequest &request)
+{
+  int ret = OB_SUCCESS;
+  if (!request.is_valid()) {
+    ret = OB_INVALID_ARGUMENT;
+    TRANS_LOG(WARN, "invalid argument", KR(ret), K(request));
+  } else if (is_full()) {
+    ret = OB_SIZE_OVERFLOW;
+  } else if (OB_FAIL(requests_.push_back(request))) {
+    TRANS_LOG(WARN, "push back gts request failed", KR(ret), K(request));
+  }
+  return ret;
+}
+
+bool ObGtsBatchRequest::is_valid() const
+{
+  bool bool_ret = requests_.count() > 0 && requests_.count() <= MAX_BATCH_COUNT;
+  for (int64_t i = 0; bool_ret && i < requests_.count(); ++i) {
+    bool_ret = requests_.at(i).is_valid();
+  }
+  return bool_ret;
+}
+
 } // transaction
 } // oceanbase
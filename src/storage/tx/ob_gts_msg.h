@@ -16,6 +16,7 @@
 #include "share/ob_define.h"
 #include "lib/utility/ob_unify_serialize.h"
 #include "lib/net/ob_addr.h"
+#include "lib/container/ob_se_array.h"
 #include "ob_gts_define.h"
 
 namespace oceanbase
@@ -69,6 +70,27 @@ private:
   common::ObAddr sender_;
 };
 
+// gts requests of different tenants towards the same server, sent in one rpc
+class ObGtsBatchRequest
+{
+  OB_UNIS_VERSION(1);
+public:
+  static const int64_t MAX_BATCH_COUNT = 64;
+public:
+  ObGtsBatchRequest() : requests_() {}
+  ~ObGtsBatchRequest() {}
+  int add_request(const ObGtsRequest &request);
+  void reset() { requests_.reset(); }
+  bool is_valid() const;
+public:
+  int64_t count() const { return requests_.count(); }
+  bool is_full() const { return requests_.count() >= MAX_BATCH_COUNT; }
+  const ObGtsRequest &at(const int64_t idx) const { return requests_.at(idx); }
+  TO_STRING_KV(K_(requests));
+private:
+  common::ObSEArray<ObGtsRequest, 16> requests_;
+};
+
 } // transaction
 } // oceanbase
 
@@ -21,6 +21,7 @@
 #include "ob_timestamp_access.h"
 #include "share/rc/ob_tenant_base.h"
 #include "share/resource_manager/ob_cgroup_ctrl.h"
+#include "share/config/ob_server_config.h"
 
 namespace oceanbase
 {
@@ -37,6 +38,7 @@ namespace obrpc
 {
 
 OB_SERIALIZE_MEMBER(ObGtsRpcResult, tenant_id_, status_, srr_.mts_, gts_start_, gts_end_);
+OB_SERIALIZE_MEMBER(ObGtsBatchRpcResult, results_);
 
 int ObGtsRpcResult::init(const uint64_t tenant_id, const int status,
     const MonotonicTs srr, const int64_t gts_start, const int64_t gts_end)
@@ -96,6 +98,136 @@ int ObGtsP::process()
   return ret;
 }
 
+int ObGtsBatchP::process()
+{
+  int ret = OB_SUCCESS;
+  ObTimeGuard timeguard("gts_batch_request", 100000);
+  for (int64_t i = 0; OB_SUCC(ret) && i < arg_.count(); ++i) {
+    const ObGtsRequest &request = arg_.at(i);
+    const uint64_t tenant_id = request.get_tenant_id();
+    ObGtsRpcResult result;
+    int tmp_ret = OB_SUCCESS;
+    MTL_SWITCH(tenant_id) {
+      ObTimestampAccess *timestamp_access = MTL(ObTimestampAccess *);
+      if (OB_ISNULL(timestamp_access)) {
+        tmp_ret = OB_ERR_UNEXPECTED;
+        TRANS_LOG(WARN, "timestamp access is null", K(tmp_ret), K(request));
+      } else if (OB_SUCCESS != (tmp_ret = timestamp_access->handle_request(request, result))) {
+        if (REACH_TIME_INTERVAL(100 * 1000)) {
+          TRANS_LOG(WARN, "handle request failed", K(tmp_ret), K(request));
+        }
+      }
+    } else {
+      tmp_ret = ret;
+      ret = OB_SUCCESS;
+    }
+    // the failure of one tenant is returned as its own status
+    if (OB_SUCCESS != tmp_ret) {
+      result.reset();
+      if (OB_FAIL(result.init(tenant_id, tmp_ret, request.get_srr(), 0, 0))) {
+        TRANS_LOG(WARN, "gts result init failed", KR(ret), K(request));
+      }
+    }
+    if (OB_SUCC(ret) && OB_FAIL(result_.add_result(result))) {
+      TRANS_LOG(WARN, "add gts result failed", KR(ret), K(result));
+    }
+  }
+  return ret;
+}
+
+int ObGtsBatchRPCCB::init(ObTsMgr *ts_mgr, ObTsWorker *ts_worker)
+{
+  int ret = OB_SUCCESS;
+  if (is_inited_) {
+    ret = OB_INIT_TWICE;
+    TRANS_LOG(WARN, "ObGtsBatchRPCCB inited twice", KR(ret));
+  } else if (OB_ISNULL(ts_mgr) || OB_ISNULL(ts_worker)) {
+    ret = OB_INVALID_ARGUMENT;
+    TRANS_LOG(WARN, "invalid argument", KR(ret), KP(ts_mgr), KP(ts_worker));
+  } else if (OB_FAIL(request_cb_.init(ts_mgr, ts_worker))) {
+    TRANS_LOG(WARN, "gts request callback init failed", KR(ret));
+  } else {
+    ts_mgr_ = ts_mgr;
+    ts_worker_ = ts_worker;
+    is_inited_ = true;
+  }
+  return ret;
+}
+
+void ObGtsBatchRPCCB::set_args(const ObGtsRpcProxy::AsyncCB<OB_GET_GTS_BATCH_REQUEST>::Request &args)
+{
+  tenant_cnt_ = min(args.count(), ObGtsBatchRequest::MAX_BATCH_COUNT);
+  for (int64_t i = 0; i < tenant_cnt_; ++i) {
+    tenant_ids_[i] = args.at(i).get_tenant_id();
+  }
+}
+
+oceanbase::rpc::frame::ObReqTransport::AsyncCB *ObGtsBatchRPCCB::clone(
+    const oceanbase::rpc::frame::SPAlloc &alloc) const
+{
+  ObGtsBatchRPCCB *newcb = NULL;
+  void *buf = alloc(sizeof (*this));
+  if (NULL != buf) {
+    newcb = new (buf) ObGtsBatchRPCCB();
+    if (is_inited_ && OB_SUCCESS != newcb->init(ts_mgr_, ts_worker_)) {
+      newcb->~ObGtsBatchRPCCB();
+      newcb = NULL;
+    }
+  }
+  return newcb;
+}
+
+int ObGtsBatchRPCCB::process()
+{
+  int ret = OB_SUCCESS;
+  const ObGtsBatchRpcResult &result = result_;
+  const ObAddr &dst = dst_;
+
+  if (!is_inited_) {
+    ret = OB_NOT_INIT;
+    TRANS_LOG(WARN, "ObGtsBatchRPCCB not inited", KR(ret));
+  } else if (OB_SUCCESS != rcode_.rcode_) {
+    TRANS_LOG(WARN, "gts batch rpc error", K_(rcode), K(dst), K_(tenant_cnt));
+    refresh_gts_location_();
+  } else {
+    for (int64_t i = 0; i < result.count(); ++i) {
+      const ObGtsRpcResult &tenant_result = result.at(i);
+      ObRpcResultCode rcode;
+      // a failed tenant goes the same way as a failed single request
+      rcode.rcode_ = tenant_result.get_status();
+      request_cb_.set_tenant_id(tenant_result.get_tenant_id());
+      if (OB_FAIL(request_cb_.process(tenant_result, dst, rcode))) {
+        TRANS_LOG(WARN, "handle gts result failed", KR(ret), K(tenant_result), K(dst));
+      }
+    }
+    // rewrite ret
+    ret = OB_SUCCESS;
+  }
+  return ret;
+}
+
+void ObGtsBatchRPCCB::on_timeout()
+{
+  if (!is_inited_) {
+    TRANS_LOG(WARN, "ObGtsBatchRPCCB not inited");
+  } else {
+    if (EXECUTE_COUNT_PER_SEC(16)) {
+      TRANS_LOG(WARN, "gts batch rpc timeout", K_(dst), K_(tenant_cnt));
+    }
+    refresh_gts_location_();
+  }
+}
+
+void ObGtsBatchRPCCB::refresh_gts_location_()
+{
+  int tmp_ret = OB_SUCCESS;
+  for (int64_t i = 0; i < tenant_cnt_; ++i) {
+    if (OB_SUCCESS != (tmp_ret = ts_mgr_->refresh_gts_location(tenant_ids_[i]))) {
+      TRANS_LOG(WARN, "refresh gts location fail", K(tmp_ret), "tenant_id", tenant_ids_[i]);
+    }
+  }
+}
+
 int ObGtsErrRespP::process()
 {
   int ret = OB_SUCCESS;
@@ -130,6 +262,8 @@ int ObGtsRequestRpc::init(ObGtsRpcProxy *rpc_proxy, const ObAddr &self,
     TRANS_LOG(WARN, "invalid argument", KR(ret), KP(rpc_proxy), K(self), KP(ts_mgr), KP(ts_worker));
   } else if (OB_SUCCESS != (ret = gts_request_cb_.init(ts_mgr, ts_worker))) {
     TRANS_LOG(WARN, "gts request callback inited failed", KR(ret));
+  } else if (OB_FAIL(gts_batch_request_cb_.init(ts_mgr, ts_worker))) {
+    TRANS_LOG(WARN, "gts batch request callback inited failed", KR(ret));
   } else {
     rpc_proxy_ = rpc_proxy;
     self_ = self;
@@ -200,6 +334,11 @@ void ObGtsRequestRpc::destroy()
     is_inited_ = false;
     rpc_proxy_ = NULL;
     self_.reset();
+    batch_tid_ = 0;
+    for (int64_t i = 0; i < pending_batch_cnt_; ++i) {
+      pending_batches_[i].batch_.reset();
+    }
+    pending_batch_cnt_ = 0;
     TRANS_LOG(INFO, "gts request rpc destroy");
   }
 }
@@ -217,7 +356,109 @@ int ObGtsRequestRpc::post(const uint64_t tenant_id, const ObAddr &server,
   } else if (!is_valid_tenant_id(tenant_id) || !server.is_valid() || !msg.is_valid()) {
     ret = OB_INVALID_ARGUMENT;
     TRANS_LOG(WARN, "invalid argument", KR(ret), K(tenant_id), K(server), K(msg));
-  } else if (server == self_) {
+  } else {
+    bool added = false;
+    if (need_batch_(server) && OB_FAIL(add_to_batch_(server, msg, added))) {
+      TRANS_LOG(WARN, "add gts request to batch failed", KR(ret), K(server), K(msg));
+    } else if (!added) {
+      ret = post_(tenant_id, server, msg);
+    }
+  }
+  return ret;
+}
+
+void ObGtsRequestRpc::begin_batch()
+{
+  ATOMIC_STORE(&batch_tid_, GETTID());
+}
+
+int ObGtsRequestRpc::end_batch()
+{
+  int ret = OB_SUCCESS;
+  int tmp_ret = OB_SUCCESS;
+  for (int64_t i = 0; i < pending_batch_cnt_; ++i) {
+    PendingBatch &pending = pending_batches_[i];
+    if (pending.batch_.count() > 0 &&
+        OB_SUCCESS != (tmp_ret = post_batch_(pending.server_, pending.batch_))) {
+      TRANS_LOG(WARN, "post gts batch request failed", K(tmp_ret), "server", pending.server_);
+      ret = tmp_ret;
+    }
+    pending.batch_.reset();
+    pending.server_.reset();
+  }
+  pending_batch_cnt_ = 0;
+  ATOMIC_STORE(&batch_tid_, 0);
+  return ret;
+}
+
+// The batch rpc is new in the current cluster version, which is not distinguishable
+// from the previous one, peers not upgraded yet would refuse it. So it is only sent
+// when _enable_gts_batch_request is turned on by hand after the upgrade.
+bool ObGtsRequestRpc::need_batch_(const ObAddr &server) const
+{
+  return server != self_
+      && GETTID() == ATOMIC_LOAD(&batch_tid_)
+      && GCONF._enable_gts_batch_request;
+}
+
+int ObGtsRequestRpc::add_to_batch_(const ObAddr &server, const ObGtsRequest &msg, bool &added)
+{
+  int ret = OB_SUCCESS;
+  PendingBatch *pending = NULL;
+  added = false;
+  for (int64_t i = 0; NULL == pending && i < pending_batch_cnt_; ++i) {
+    if (server == pending_batches_[i].server_) {
+      pending = &pending_batches_[i];
+    }
+  }
+  if (NULL == pending && pending_batch_cnt_ < MAX_BATCH_SERVER_COUNT) {
+    pending = &pending_batches_[pending_batch_cnt_++];
+    pending->server_ = server;
+  }
+  if (NULL == pending) {
+    // too many servers, sent alone
+  } else {
+    if (pending->batch_.is_full()) {
+      if (OB_FAIL(post_batch_(server, pending->batch_))) {
+        TRANS_LOG(WARN, "post gts batch request failed", KR(ret), K(server));
+      }
+      // requests failed to post are refreshed again in the next round
+      pending->batch_.reset();
+      ret = OB_SUCCESS;
+    }
+    if (OB_FAIL(pending->batch_.add_request(msg))) {
+      TRANS_LOG(WARN, "add gts request failed", KR(ret), K(server), K(msg));
+    } else {
+      added = true;
+    }
+  }
+  return ret;
+}
+
+int ObGtsRequestRpc::post_batch_(const ObAddr &server, const ObGtsBatchRequest &batch)
+{
+  int ret = OB_SUCCESS;
+  if (1 == batch.count()) {
+    ret = post_(batch.at(0).get_tenant_id(), server, batch.at(0));
+  } else if (OB_FAIL(rpc_proxy_->to(server).by(OB_SYS_TENANT_ID)
+                                           .timeout(ObGtsRpcResult::OB_GTS_RPC_TIMEOUT)
+                                           .group_id(OBCG_ID_SERVICE)
+                                           .post(batch, &gts_batch_request_cb_))) {
+    TRANS_LOG(WARN, "post gts batch request failed", KR(ret), K(server), "count", batch.count());
+    for (int64_t i = 0; i < batch.count(); ++i) {
+      (void)ts_mgr_->refresh_gts_location(batch.at(i).get_tenant_id());
+    }
+  } else {
+    TRANS_LOG(DEBUG, "post gts batch request success", K(server), "count", batch.count());
+  }
+  return ret;
+}
+
+int ObGtsRequestRpc::post_(const uint64_t tenant_id, const ObAddr &server,
+    const ObGtsRequest &msg)
+{
+  int ret = OB_SUCCESS;
+  if (server == self_) {
     // Use local calls instead of rpc
     ObGtsRpcResult gts_rpc_result;
     MTL_SWITCH(tenant_id) {
@@ -71,6 +71,21 @@ private:
   int64_t gts_end_;
 };
 
+class ObGtsBatchRpcResult
+{
+  OB_UNIS_VERSION(1);
+public:
+  ObGtsBatchRpcResult() : results_() {}
+  ~ObGtsBatchRpcResult() {}
+  int add_result(const ObGtsRpcResult &result) { return results_.push_back(result); }
+  int64_t count() const { return results_.count(); }
+  const ObGtsRpcResult &at(const int64_t idx) const { return results_.at(idx); }
+  void reset() { results_.reset(); }
+  TO_STRING_KV(K_(results));
+private:
+  common::ObSEArray<ObGtsRpcResult, 16> results_;
+};
+
 class ObGtsRpcProxy : public obrpc::ObRpcProxy
 {
 public:
@@ -78,6 +93,7 @@ public:
 
   RPC_AP(PR1 post, OB_GET_GTS_REQUEST, (transaction::ObGtsRequest), ObGtsRpcResult);
   RPC_AP(PR1 post, OB_GET_GTS_ERR_RESPONSE, (transaction::ObGtsErrResponse), ObGtsRpcResult);
+  RPC_AP(PR1 post, OB_GET_GTS_BATCH_REQUEST, (transaction::ObGtsBatchRequest), ObGtsBatchRpcResult);
 };
 
 class ObGtsP : public ObRpcProcessor< obrpc::ObGtsRpcProxy::ObRpc<OB_GET_GTS_REQUEST> >
@@ -90,6 +106,16 @@ private:
   DISALLOW_COPY_AND_ASSIGN(ObGtsP);
 };
 
+class ObGtsBatchP : public ObRpcProcessor< obrpc::ObGtsRpcProxy::ObRpc<OB_GET_GTS_BATCH_REQUEST> >
+{
+public:
+  ObGtsBatchP() {}
+protected:
+  int process();
+private:
+  DISALLOW_COPY_AND_ASSIGN(ObGtsBatchP);
+};
+
 class ObGtsErrRespP : public ObRpcProcessor< obrpc::ObGtsRpcProxy::ObRpc<OB_GET_GTS_ERR_RESPONSE> >
 {
 public:
@@ -255,6 +281,32 @@ private:
   transaction::ObTsWorker *ts_worker_;
 };
 
+// Every result of the batch is handled as if it came back from a single gts request,
+// the tenants of the batch refresh their gts location when the whole rpc fails.
+class ObGtsBatchRPCCB : public ObGtsRpcProxy::AsyncCB<OB_GET_GTS_BATCH_REQUEST>
+{
+public:
+  ObGtsBatchRPCCB() : is_inited_(false), tenant_cnt_(0), ts_mgr_(NULL), ts_worker_(NULL),
+                      request_cb_() {}
+  ~ObGtsBatchRPCCB() {}
+  int init(transaction::ObTsMgr *ts_mgr, transaction::ObTsWorker *ts_worker);
+  void set_args(const ObGtsRpcProxy::AsyncCB<OB_GET_GTS_BATCH_REQUEST>::Request &args);
+  oceanbase::rpc::frame::ObReqTransport::AsyncCB *clone(
+      const oceanbase::rpc::frame::SPAlloc &alloc) const;
+public:
+  int process();
+  void on_timeout();
+private:
+  void refresh_gts_location_();
+private:
+  bool is_inited_;
+  int64_t tenant_cnt_;
+  uint64_t tenant_ids_[transaction::ObGtsBatchRequest::MAX_BATCH_COUNT];
+  transaction::ObTsMgr *ts_mgr_;
+  transaction::ObTsWorker *ts_worker_;
+  ObGtsRPCCB<OB_GET_GTS_REQUEST> request_cb_;
+};
+
 } // obrpc
 
 namespace transaction
@@ -277,7 +329,8 @@ public:
 class ObGtsRequestRpc : public ObIGtsRequestRpc
 {
 public:
-  ObGtsRequestRpc() : is_inited_(false), is_running_(false), rpc_proxy_(NULL), ts_mgr_(NULL) {}
+  ObGtsRequestRpc() : is_inited_(false), is_running_(false), rpc_proxy_(NULL), ts_mgr_(NULL),
+                      batch_tid_(0), pending_batch_cnt_(0) {}
   ~ObGtsRequestRpc() { destroy(); }
   int init(obrpc::ObGtsRpcProxy *rpc_proxy, const common::ObAddr &self,
            transaction::ObTsMgr *ts_mgr,
@@ -288,13 +341,36 @@ public:
   void destroy();
 public:
   int post(const uint64_t tenant_id, const common::ObAddr &server, const ObGtsRequest &msg);
+  // Requests to remote servers posted by the calling thread between begin_batch() and
+  // end_batch() are coalesced into one batch rpc per server, which is sent by end_batch().
+  // Requests of other threads are not affected.
+  void begin_batch();
+  int end_batch();
+private:
+  bool need_batch_(const common::ObAddr &server) const;
+  int add_to_batch_(const common::ObAddr &server, const ObGtsRequest &msg, bool &added);
+  int post_(const uint64_t tenant_id, const common::ObAddr &server, const ObGtsRequest &msg);
+  int post_batch_(const common::ObAddr &server, const ObGtsBatchRequest &batch);
+private:
+  static const int64_t MAX_BATCH_SERVER_COUNT = 16;
+  struct PendingBatch
+  {
+    PendingBatch() : server_(), batch_() {}
+    common::ObAddr server_;
+    ObGtsBatchRequest batch_;
+  };
 private:
   bool is_inited_;
   bool is_running_;
   obrpc::ObGtsRpcProxy *rpc_proxy_;
   obrpc::ObGtsRPCCB<obrpc::OB_GET_GTS_REQUEST> gts_request_cb_;
+  obrpc::ObGtsBatchRPCCB gts_batch_request_cb_;
   common::ObAddr self_;
   transaction::ObTsMgr *ts_mgr_;
+  // the thread collecting batches, only touched by itself
+  int64_t batch_tid_;
+  int64_t pending_batch_cnt_;
+  PendingBatch pending_batches_[MAX_BATCH_SERVER_COUNT];
 };
 
 class ObIGtsResponseRpc
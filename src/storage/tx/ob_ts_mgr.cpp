@@ -268,7 +268,14 @@ void ObTsMgr::run1()
   while (!has_set_stop()) {
     // sleep 100 * 1000 us
     ob_usleep(REFRESH_GTS_INTERVEL_US);
+    // the refresh of all tenants towards the same gts leader goes in one rpc
+    gts_request_rpc_->begin_batch();
     ts_source_info_map_.for_each(gts_refresh_funtor);
+    if (OB_FAIL(gts_request_rpc_->end_batch())) {
+      TRANS_LOG(WARN, "post gts batch request failed", K(ret));
+      // ignore ret
+      ret = OB_SUCCESS;
+    }
     ts_source_info_map_.for_each(get_obsolete_tenant_functor);
     ts_source_info_map_.for_each(check_tenant_functor);
     for (int64_t i = 0; i < ids.count(); i++) {
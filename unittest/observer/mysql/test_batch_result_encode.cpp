@@ -0,0 +1,224 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SERVER
+
+#include <gtest/gtest.h>
+#include "observer/mysql/obsm_row.h"
+#include "sql/engine/ob_exec_context.h"
+#include "sql/engine/expr/ob_expr.h"
+
+namespace oceanbase
+{
+namespace observer
+{
+using namespace common;
+using namespace sql;
+
+// Every row written by ObSMDatumRow from the batch datums must be byte identical to
+// the one ObSMRow writes from the same values converted to ObObj.
+class TestBatchResultEncode : public ::testing::Test
+{
+public:
+  static const int64_t BATCH_SIZE = 64;
+  static const int64_t COL_CNT = 5;
+  static const int64_t FRAME_SIZE = 128 << 10;
+  static const int64_t RES_BUF_LEN = 64;
+
+  TestBatchResultEncode()
+    : allocator_(ObModIds::TEST), exec_ctx_(allocator_), eval_ctx_(exec_ctx_), frame_(NULL)
+  {}
+  virtual void SetUp() override
+  {
+    frame_ = static_cast<char *>(allocator_.alloc(FRAME_SIZE));
+    ASSERT_TRUE(NULL != frame_);
+    MEMSET(frame_, 0, FRAME_SIZE);
+    eval_ctx_.frames_ = &frame_;
+    eval_ctx_.max_batch_size_ = BATCH_SIZE;
+    eval_ctx_.batch_size_ = BATCH_SIZE;
+    int64_t pos = 0;
+    for (int64_t i = 0; i < COL_CNT; i++) {
+      init_expr(exprs_[i], pos);
+      ASSERT_EQ(OB_SUCCESS, expr_array_.push_back(&exprs_[i]));
+    }
+    ASSERT_LE(pos, FRAME_SIZE);
+  }
+
+  void init_expr(ObExpr &expr, int64_t &pos)
+  {
+    new (&expr) ObExpr();
+    expr.frame_idx_ = 0;
+    expr.batch_result_ = true;
+    expr.batch_idx_mask_ = UINT64_MAX;
+    expr.datum_off_ = static_cast<uint32_t>(pos);
+    pos += sizeof(ObDatum) * BATCH_SIZE;
+    expr.eval_info_off_ = static_cast<uint32_t>(pos);
+    pos += sizeof(ObEvalInfo);
+    expr.eval_flags_off_ = static_cast<uint32_t>(pos);
+    pos += ObBitVector::memory_size(BATCH_SIZE);
+    expr.pvt_skip_off_ = static_cast<uint32_t>(pos);
+    pos += ObBitVector::memory_size(BATCH_SIZE);
+    expr.res_buf_off_ = static_cast<uint32_t>(pos);
+    expr.res_buf_len_ = RES_BUF_LEN;
+    ObDatum *datums = expr.locate_batch_datums(eval_ctx_);
+    for (int64_t i = 0; i < BATCH_SIZE; i++) {
+      datums[i].ptr_ = frame_ + pos;
+      pos += RES_BUF_LEN;
+    }
+  }
+
+  void set_meta(ObExpr &expr, ObField &field, const ObObjType type,
+                const ObCollationType cs_type, const int16_t scale = 0)
+  {
+    expr.obj_meta_.set_type(type);
+    expr.obj_meta_.set_collation_type(cs_type);
+    expr.datum_meta_.type_ = type;
+    expr.datum_meta_.cs_type_ = cs_type;
+    field.type_.set_type(type);
+    field.accuracy_.set_scale(scale);
+    field.charsetnr_ = static_cast<uint16_t>(cs_type);
+  }
+
+  // int, uint, number, varchar, zerofill int, with a NULL every 7 rows in each column
+  void fill_batch()
+  {
+    fields_.reuse();
+    ObField fields[COL_CNT];
+    set_meta(exprs_[0], fields[0], ObIntType, CS_TYPE_BINARY);
+    set_meta(exprs_[1], fields[1], ObUInt64Type, CS_TYPE_BINARY);
+    set_meta(exprs_[2], fields[2], ObNumberType, CS_TYPE_BINARY, 3);
+    set_meta(exprs_[3], fields[3], ObVarcharType, CS_TYPE_UTF8MB4_GENERAL_CI);
+    set_meta(exprs_[4], fields[4], ObInt32Type, CS_TYPE_BINARY);
+    fields[4].flags_ |= ZEROFILL_FLAG;
+    fields[4].length_ = 8;
+    for (int64_t i = 0; i < COL_CNT; i++) {
+      ASSERT_EQ(OB_SUCCESS, fields_.push_back(fields[i]));
+    }
+    static const char *numbers[] = { "0", "-1", "123.456", "-0.001", "99999999999999999999.5" };
+    static const char *strings[] = { "", "a", "abc", "中文", "x y z" };
+    for (int64_t i = 0; i < BATCH_SIZE; i++) {
+      for (int64_t j = 0; j < COL_CNT; j++) {
+        ObDatum &datum = exprs_[j].locate_batch_datums(eval_ctx_)[i];
+        if (0 == (i + j) % 7) {
+          datum.set_null();
+        } else if (0 == j) {
+          datum.set_int((i % 2 ? -1 : 1) * (INT64_MAX / BATCH_SIZE) * i);
+        } else if (1 == j) {
+          datum.set_uint(UINT64_MAX - i * 104729);
+        } else if (2 == j) {
+          number::ObNumber nmb;
+          ASSERT_EQ(OB_SUCCESS, nmb.from(numbers[i % ARRAYSIZEOF(numbers)], allocator_));
+          datum.set_number(nmb);
+        } else if (3 == j) {
+          datum.set_string(ObString(strings[i % ARRAYSIZEOF(strings)]));
+        } else {
+          datum.set_int(i * 37);
+        }
+      }
+    }
+  }
+
+  void check_rows()
+  {
+    ObSEArray<ObSMDatumRow::ColumnFormat, COL_CNT> formats;
+    bool is_supported = false;
+    ASSERT_EQ(OB_SUCCESS, ObSMDatumRow::init_formats(expr_array_, fields_, CHARSET_UTF8MB4,
+                                                     formats, is_supported));
+    ASSERT_TRUE(is_supported);
+    ObSMDatumRow datum_row(formats, eval_ctx_);
+    ObObj cells[COL_CNT];
+    ObNewRow new_row;
+    new_row.cells_ = cells;
+    new_row.count_ = COL_CNT;
+    ObDataTypeCastParams dtc_params;
+    ObSMRow obj_row(obmysql::TEXT, new_row, dtc_params, &fields_);
+    char expected[4096];
+    char result[4096];
+    for (int64_t i = 0; i < BATCH_SIZE; i++) {
+      for (int64_t j = 0; j < COL_CNT; j++) {
+        const ObDatum &datum = exprs_[j].locate_batch_datums(eval_ctx_)[i];
+        ASSERT_EQ(OB_SUCCESS, datum.to_obj(cells[j], exprs_[j].obj_meta_));
+      }
+      int64_t expected_len = 0;
+      int64_t result_len = 0;
+      datum_row.set_batch_idx(i);
+      ASSERT_EQ(OB_SUCCESS, obj_row.serialize(expected, sizeof(expected), expected_len));
+      ASSERT_EQ(OB_SUCCESS, datum_row.serialize(result, sizeof(result), result_len));
+      ASSERT_EQ(expected_len, result_len) << "row " << i;
+      ASSERT_EQ(0, MEMCMP(expected, result, result_len)) << "row " << i;
+    }
+  }
+
+protected:
+  ObArenaAllocator allocator_;
+  ObExecContext exec_ctx_;
+  ObEvalCtx eval_ctx_;
+  char *frame_;
+  ObExpr exprs_[COL_CNT];
+  ObSEArray<ObExpr *, COL_CNT> expr_array_;
+  ObSEArray<ObField, COL_CNT> fields_;
+};
+
+TEST_F(TestBatchResultEncode, same_as_row)
+{
+  fill_batch();
+  check_rows();
+}
+
+TEST_F(TestBatchResultEncode, all_null)
+{
+  fill_batch();
+  for (int64_t i = 0; i < BATCH_SIZE; i++) {
+    for (int64_t j = 0; j < COL_CNT; j++) {
+      exprs_[j].locate_batch_datums(eval_ctx_)[i].set_null();
+    }
+  }
+  check_rows();
+}
+
+TEST_F(TestBatchResultEncode, unsupported)
+{
+  fill_batch();
+  ObSEArray<ObSMDatumRow::ColumnFormat, COL_CNT> formats;
+  bool is_supported = true;
+  // strings converted to another result charset keep the row path
+  ASSERT_EQ(OB_SUCCESS, ObSMDatumRow::init_formats(expr_array_, fields_, CHARSET_GBK,
+                                                   formats, is_supported));
+  ASSERT_FALSE(is_supported);
+  ASSERT_EQ(0, formats.count());
+  // binary strings are never converted
+  exprs_[3].obj_meta_.set_collation_type(CS_TYPE_BINARY);
+  ASSERT_EQ(OB_SUCCESS, ObSMDatumRow::init_formats(expr_array_, fields_, CHARSET_GBK,
+                                                   formats, is_supported));
+  ASSERT_TRUE(is_supported);
+  // types without datum formatter keep the row path as well
+  exprs_[0].obj_meta_.set_type(ObDoubleType);
+  ASSERT_EQ(OB_SUCCESS, ObSMDatumRow::init_formats(expr_array_, fields_, CHARSET_UTF8MB4,
+                                                   formats, is_supported));
+  ASSERT_FALSE(is_supported);
+  // and so does a field count other than the expr count
+  exprs_[0].obj_meta_.set_type(ObIntType);
+  fields_.pop_back();
+  ASSERT_EQ(OB_SUCCESS, ObSMDatumRow::init_formats(expr_array_, fields_, CHARSET_UTF8MB4,
+                                                   formats, is_supported));
+  ASSERT_FALSE(is_supported);
+}
+
+} // end namespace observer
+} // end namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,297 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SERVER
+
+#include <gtest/gtest.h>
+#define private public
+#define protected public
+#include "observer/mysql/ob_hot_row_update_combiner.h"
+#include "lib/time/ob_time_utility.h"
+#include "lib/worker.h"
+#include "lib/timezone/ob_timezone_info.h"
+#include "common/sql_mode/ob_sql_mode.h"
+
+namespace oceanbase
+{
+namespace observer
+{
+using namespace common;
+
+typedef ObHotRowUpdateCombiner Combiner;
+
+class TestHotRowUpdateCombiner : public ::testing::Test
+{
+public:
+  virtual void SetUp() override
+  {
+    timeout_ts_ = THIS_WORKER.get_timeout_ts();
+  }
+  virtual void TearDown() override
+  {
+    THIS_WORKER.set_timeout_ts(timeout_ts_);
+  }
+
+  static void init_group(Combiner::Group &group, const uint64_t hash, const char *key,
+                         const int64_t delta)
+  {
+    group.tenant_id_ = 1001;
+    group.hash_ = hash;
+    group.key_ = ObString(key);
+    group.delta_ = delta;
+    group.member_cnt_ = 1;
+  }
+
+protected:
+  int64_t timeout_ts_;
+};
+
+TEST_F(TestHotRowUpdateCombiner, can_join)
+{
+  Combiner::Group group;
+  init_group(group, 7, "k1", 5);
+  ASSERT_TRUE(group.can_join(1001, 7, ObString("k1"), 3));
+  // deltas of the other sign are never merged
+  ASSERT_FALSE(group.can_join(1001, 7, ObString("k1"), -3));
+  // another tenant or another row
+  ASSERT_FALSE(group.can_join(1002, 7, ObString("k1"), 3));
+  ASSERT_FALSE(group.can_join(1001, 8, ObString("k1"), 3));
+  // keys of the same hash, colliding in the slot
+  ASSERT_FALSE(group.can_join(1001, 7, ObString("k2"), 3));
+  group.delta_ = -5;
+  ASSERT_TRUE(group.can_join(1001, 7, ObString("k1"), -3));
+  ASSERT_FALSE(group.can_join(1001, 7, ObString("k1"), 3));
+  // the group is full
+  group.member_cnt_ = Combiner::MAX_GROUP_SIZE;
+  ASSERT_FALSE(group.can_join(1001, 7, ObString("k1"), -3));
+}
+
+TEST_F(TestHotRowUpdateCombiner, can_join_overflow)
+{
+  Combiner::Group group;
+  init_group(group, 7, "k1", INT64_MAX - 1);
+  ASSERT_TRUE(group.can_join(1001, 7, ObString("k1"), 1));
+  ASSERT_FALSE(group.can_join(1001, 7, ObString("k1"), 2));
+  group.delta_ = INT64_MAX;
+  ASSERT_FALSE(group.can_join(1001, 7, ObString("k1"), 1));
+  group.delta_ = INT64_MIN + 1;
+  ASSERT_TRUE(group.can_join(1001, 7, ObString("k1"), -1));
+  ASSERT_FALSE(group.can_join(1001, 7, ObString("k1"), -2));
+  group.delta_ = INT64_MIN;
+  ASSERT_FALSE(group.can_join(1001, 7, ObString("k1"), -1));
+}
+
+TEST_F(TestHotRowUpdateCombiner, enter_slot)
+{
+  const int64_t window_us = 1000000;
+  Combiner::Slot slot;
+  Combiner::Group g1;
+  Combiner::Group g2;
+  Combiner::Group g3;
+  Combiner::Group *joined = NULL;
+  bool is_leader = false;
+  // the first update of a row is executed at once
+  Combiner::enter_slot_(slot, g1, 1001, 7, ObString("k1"), 5, window_us, joined, is_leader);
+  ASSERT_FALSE(is_leader);
+  ASSERT_TRUE(NULL == joined);
+  ASSERT_TRUE(NULL == slot.group_);
+  ASSERT_EQ(7, slot.last_hash_);
+  // another row in the same slot is not contention
+  Combiner::enter_slot_(slot, g1, 1001, 9, ObString("k2"), 5, window_us, joined, is_leader);
+  ASSERT_FALSE(is_leader);
+  ASSERT_TRUE(NULL == slot.group_);
+  // the second update of the row within the window opens a group
+  Combiner::enter_slot_(slot, g1, 1001, 9, ObString("k2"), 5, window_us, joined, is_leader);
+  ASSERT_TRUE(is_leader);
+  ASSERT_TRUE(NULL == joined);
+  ASSERT_EQ(&g1, slot.group_);
+  // the third one joins it
+  Combiner::enter_slot_(slot, g2, 1001, 9, ObString("k2"), 3, window_us, joined, is_leader);
+  ASSERT_FALSE(is_leader);
+  ASSERT_EQ(&g1, joined);
+  ASSERT_EQ(8, g1.delta_);
+  ASSERT_EQ(2, g1.member_cnt_);
+  ASSERT_EQ(1, g1.waiter_cnt_);
+  // the other sign and the other row of the slot are executed by themselves
+  Combiner::enter_slot_(slot, g2, 1001, 9, ObString("k2"), -3, window_us, joined, is_leader);
+  ASSERT_FALSE(is_leader);
+  ASSERT_TRUE(NULL == joined);
+  Combiner::enter_slot_(slot, g3, 1001, 7, ObString("k1"), 3, window_us, joined, is_leader);
+  ASSERT_FALSE(is_leader);
+  ASSERT_TRUE(NULL == joined);
+  ASSERT_EQ(&g1, slot.group_);
+  ASSERT_EQ(8, g1.delta_);
+  ASSERT_EQ(2, g1.member_cnt_);
+  // updates further apart than the window never wait
+  slot.group_ = NULL;
+  ob_usleep(1000);
+  Combiner::enter_slot_(slot, g3, 1001, 7, ObString("k1"), 3, 1, joined, is_leader);
+  ASSERT_FALSE(is_leader);
+  ASSERT_TRUE(NULL == slot.group_);
+}
+
+TEST_F(TestHotRowUpdateCombiner, lead_alone)
+{
+  Combiner &combiner = Combiner::get_instance();
+  Combiner::Slot slot;
+  Combiner::Group group;
+  ObSqlString prefix;
+  ObSqlString suffix;
+  ASSERT_EQ(OB_SUCCESS, group.cond_.init(ObWaitEventIds::DEFAULT_COND_WAIT));
+  init_group(group, 7, "k1", 5);
+  slot.group_ = &group;
+  slot.last_hash_ = 7;
+  slot.last_arrival_ts_ = ObTimeUtility::current_time();
+  combiner.lead_group_(slot, group, prefix, suffix, 1000);
+  ASSERT_TRUE(group.is_done_);
+  ASSERT_FALSE(group.combined_);
+  ASSERT_TRUE(NULL == slot.group_);
+  // nobody joined, the next update of the row does not wait
+  ASSERT_EQ(0, slot.last_arrival_ts_);
+}
+
+TEST_F(TestHotRowUpdateCombiner, wait_done)
+{
+  Combiner &combiner = Combiner::get_instance();
+  Combiner::Slot slot;
+  Combiner::Group group;
+  bool combined = false;
+  int result_code = OB_SUCCESS;
+  int64_t affected_rows = 0;
+  ASSERT_EQ(OB_SUCCESS, group.cond_.init(ObWaitEventIds::DEFAULT_COND_WAIT));
+  init_group(group, 7, "k1", 5);
+  group.member_cnt_ = 2;
+  group.waiter_cnt_ = 1;
+  group.is_done_ = true;
+  group.combined_ = true;
+  group.affected_rows_ = 1;
+  combiner.wait_group_(slot, group, 2, combined, result_code, affected_rows);
+  ASSERT_TRUE(combined);
+  ASSERT_EQ(OB_SUCCESS, result_code);
+  ASSERT_EQ(1, affected_rows);
+  ASSERT_EQ(0, group.waiter_cnt_);
+}
+
+TEST_F(TestHotRowUpdateCombiner, wait_timeout)
+{
+  Combiner &combiner = Combiner::get_instance();
+  Combiner::Slot slot;
+  Combiner::Group group;
+  bool combined = true;
+  int result_code = OB_SUCCESS;
+  int64_t affected_rows = 0;
+  ASSERT_EQ(OB_SUCCESS, group.cond_.init(ObWaitEventIds::DEFAULT_COND_WAIT));
+  init_group(group, 7, "k1", 5);
+  group.member_cnt_ = 2;
+  group.waiter_cnt_ = 1;
+  THIS_WORKER.set_timeout_ts(ObTimeUtility::current_time() - 1);
+  // the group is still open, the member takes its delta back
+  slot.group_ = &group;
+  combiner.wait_group_(slot, group, 2, combined, result_code, affected_rows);
+  ASSERT_FALSE(combined);
+  ASSERT_EQ(3, group.delta_);
+  ASSERT_EQ(1, group.member_cnt_);
+  ASSERT_EQ(0, group.waiter_cnt_);
+  // the combined update is running, its outcome is unknown to the member
+  group.delta_ = 5;
+  group.member_cnt_ = 2;
+  group.waiter_cnt_ = 1;
+  slot.group_ = NULL;
+  combiner.wait_group_(slot, group, 2, combined, result_code, affected_rows);
+  ASSERT_TRUE(combined);
+  ASSERT_EQ(OB_TRANS_UNKNOWN, result_code);
+  ASSERT_EQ(5, group.delta_);
+  ASSERT_EQ(0, group.waiter_cnt_);
+}
+
+TEST_F(TestHotRowUpdateCombiner, group_key)
+{
+  ObSqlString prefix;
+  ObSqlString suffix;
+  ObSqlString key;
+  ObSqlString other;
+  ObTimeZoneInfoWrap tz;
+  ObTimeZoneInfoWrap other_tz;
+  ASSERT_EQ(OB_SUCCESS, prefix.append("UPDATE `db`.`t` SET `c` = `c` + "));
+  ASSERT_EQ(OB_SUCCESS, suffix.append(" WHERE `id` = 1"));
+  tz.set_tz_info_offset(8 * 3600);
+  other_tz.set_tz_info_offset(8 * 3600);
+  ASSERT_EQ(OB_SUCCESS, Combiner::build_key_(prefix, suffix, SMO_STRICT_ALL_TABLES,
+                                             CS_TYPE_UTF8MB4_GENERAL_CI, tz, key));
+  ASSERT_EQ(0, STRNCMP("UPDATE `db`.`t` SET `c` = `c` + ? WHERE `id` = 1", key.ptr(),
+                       prefix.length() + suffix.length() + 1)) << key.ptr();
+  ASSERT_EQ(OB_SUCCESS, Combiner::build_key_(prefix, suffix, SMO_STRICT_ALL_TABLES,
+                                             CS_TYPE_UTF8MB4_GENERAL_CI, other_tz, other));
+  ASSERT_TRUE(key.string() == other.string());
+  // statements of another sql_mode, collation or time zone are not merged
+  ASSERT_EQ(OB_SUCCESS, Combiner::build_key_(prefix, suffix, 0,
+                                             CS_TYPE_UTF8MB4_GENERAL_CI, tz, other));
+  ASSERT_FALSE(key.string() == other.string());
+  ASSERT_EQ(OB_SUCCESS, Combiner::build_key_(prefix, suffix, SMO_STRICT_ALL_TABLES,
+                                             CS_TYPE_UTF8MB4_BIN, tz, other));
+  ASSERT_FALSE(key.string() == other.string());
+  other_tz.set_tz_info_offset(0);
+  ASSERT_EQ(OB_SUCCESS, Combiner::build_key_(prefix, suffix, SMO_STRICT_ALL_TABLES,
+                                             CS_TYPE_UTF8MB4_GENERAL_CI, other_tz, other));
+  ASSERT_FALSE(key.string() == other.string());
+}
+
+TEST_F(TestHotRowUpdateCombiner, quote_name)
+{
+  ObSqlString sql;
+  bool is_valid = true;
+  ASSERT_EQ(OB_SUCCESS, Combiner::append_name_(ObString("my col"), sql, is_valid));
+  ASSERT_TRUE(is_valid);
+  ASSERT_EQ(0, STRCMP("`my col`", sql.ptr()));
+  // a back quote can not be quoted, such a statement is not merged
+  sql.reset();
+  ASSERT_EQ(OB_SUCCESS, Combiner::append_name_(ObString("a`b"), sql, is_valid));
+  ASSERT_FALSE(is_valid);
+}
+
+TEST_F(TestHotRowUpdateCombiner, quote_literal)
+{
+  ObSqlString suffix;
+  ObObjParam value;
+  bool is_valid = true;
+  value.set_int(-42);
+  ASSERT_EQ(OB_SUCCESS, Combiner::append_predicate_(ObString("id"), value, suffix, is_valid));
+  ASSERT_TRUE(is_valid);
+  value.set_varchar(ObString("it's \\ \"x\""));
+  value.set_collation_type(CS_TYPE_UTF8MB4_GENERAL_CI);
+  ASSERT_EQ(OB_SUCCESS, Combiner::append_predicate_(ObString("name"), value, suffix, is_valid));
+  ASSERT_TRUE(is_valid);
+  ASSERT_EQ(0, STRCMP(" WHERE `id` = -42 AND `name` = 'it\\'s \\\\ \\\"x\\\"'", suffix.ptr()))
+      << suffix.ptr();
+  // a literal too long is not merged
+  char buf[Combiner::MAX_LITERAL_LEN];
+  MEMSET(buf, '\'', sizeof(buf));
+  value.set_varchar(ObString(sizeof(buf), buf));
+  value.set_collation_type(CS_TYPE_UTF8MB4_GENERAL_CI);
+  ASSERT_EQ(OB_SUCCESS, Combiner::append_predicate_(ObString("name"), value, suffix, is_valid));
+  ASSERT_FALSE(is_valid);
+  // and neither are the types without an exact literal
+  is_valid = true;
+  value.set_double(1.5);
+  ASSERT_EQ(OB_SUCCESS, Combiner::append_predicate_(ObString("id"), value, suffix, is_valid));
+  ASSERT_FALSE(is_valid);
+}
+
+} // end namespace observer
+} // end namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,144 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#define private public
+#define protected public
+#include "observer/omt/ob_tenant.h"
+#include "observer/omt/ob_th_worker.h"
+#include "observer/omt/ob_cgroup_ctrl.h"
+#undef protected
+#undef private
+#include "lib/time/ob_time_utility.h"
+
+using namespace oceanbase::common;
+using namespace oceanbase::share;
+using namespace oceanbase::omt;
+
+class TestRunSlot
+    : public ::testing::Test
+{
+public:
+  TestRunSlot()
+      : tenant_(1001, 10, cgroup_ctrl_)
+  {}
+
+  virtual void SetUp()
+  {
+    tenant_.run_slot_limit_ = 2;
+    worker_.tenant_ = &tenant_;
+  }
+
+  virtual void TearDown()
+  {
+    worker_.tenant_ = nullptr;
+  }
+
+  int32_t running() { return ATOMIC_LOAD(&tenant_.run_slots_.val()); }
+
+protected:
+  ObCgroupCtrl cgroup_ctrl_;
+  ObTenant tenant_;
+  ObThWorker worker_;
+};
+
+TEST_F(TestRunSlot, Acquire)
+{
+  ASSERT_TRUE(tenant_.acquire_run_slot());
+  ASSERT_TRUE(tenant_.acquire_run_slot());
+  ASSERT_EQ(2, running());
+  // no slot frees, the worker overcommits after the wait
+  const int64_t start = ObTimeUtility::current_time();
+  ASSERT_FALSE(tenant_.acquire_run_slot());
+  ASSERT_GE(ObTimeUtility::current_time() - start, ObTenant::RUN_SLOT_WAIT_TIME);
+  ASSERT_EQ(3, running());
+  tenant_.release_run_slot();
+  tenant_.release_run_slot();
+  tenant_.release_run_slot();
+  ASSERT_EQ(0, running());
+  // no limit
+  tenant_.run_slot_limit_ = 0;
+  ASSERT_TRUE(tenant_.acquire_run_slot());
+  ASSERT_TRUE(tenant_.acquire_run_slot());
+  ASSERT_TRUE(tenant_.acquire_run_slot());
+  ASSERT_EQ(3, running());
+  tenant_.release_run_slot();
+  tenant_.release_run_slot();
+  tenant_.release_run_slot();
+  ASSERT_EQ(0, running());
+}
+
+TEST_F(TestRunSlot, SchedWait)
+{
+  worker_.acquire_run_slot();
+  ASSERT_EQ(1, running());
+  worker_.sched_wait();
+  ASSERT_EQ(0, running());
+  worker_.sched_run();
+  ASSERT_EQ(1, running());
+  worker_.release_run_slot();
+  ASSERT_EQ(0, running());
+  // a sched_run without a sched_wait keeps what the worker has
+  worker_.sched_run();
+  ASSERT_EQ(0, running());
+  worker_.acquire_run_slot();
+  worker_.sched_run();
+  ASSERT_EQ(1, running());
+  worker_.release_run_slot();
+  ASSERT_EQ(0, running());
+}
+
+TEST_F(TestRunSlot, NestedSchedWait)
+{
+  worker_.acquire_run_slot();
+  worker_.sched_wait();
+  ASSERT_EQ(0, running());
+  // the inner pair leaves the slot out
+  worker_.sched_wait();
+  ASSERT_EQ(0, running());
+  worker_.sched_run();
+  ASSERT_EQ(0, running());
+  worker_.sched_wait();
+  worker_.sched_wait();
+  worker_.sched_run();
+  worker_.sched_run();
+  ASSERT_EQ(0, running());
+  // only the outermost takes it back
+  worker_.sched_run();
+  ASSERT_EQ(1, running());
+  // a request ending inside a wait leaves nothing behind for the next one
+  worker_.sched_wait();
+  worker_.sched_wait();
+  worker_.release_run_slot();
+  ASSERT_EQ(0, running());
+  worker_.acquire_run_slot();
+  worker_.sched_wait();
+  ASSERT_EQ(0, running());
+  worker_.sched_run();
+  ASSERT_EQ(1, running());
+  worker_.release_run_slot();
+  ASSERT_EQ(0, running());
+}
+
+TEST_F(TestRunSlot, NoRequest)
+{
+  // waits outside of a request never take a slot
+  worker_.sched_wait();
+  worker_.sched_run();
+  ASSERT_EQ(0, running());
+}
+
+int main(int argc, char *argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,201 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL
+
+#include <gtest/gtest.h>
+#define private public
+#define protected public
+#include "sql/engine/expr/ob_expr_cast.h"
+#include "sql/engine/ob_exec_context.h"
+
+namespace oceanbase
+{
+namespace sql
+{
+using namespace common;
+
+// row versions, defined in ob_datum_cast.cpp
+extern int cast_eval_arg(const ObExpr &, ObEvalCtx &, ObDatum &);
+extern int int_int(const ObExpr &, ObEvalCtx &, ObDatum &);
+extern int uint_uint(const ObExpr &, ObEvalCtx &, ObDatum &);
+extern int int_double(const ObExpr &, ObEvalCtx &, ObDatum &);
+extern int uint_double(const ObExpr &, ObEvalCtx &, ObDatum &);
+
+// Compares the batch cast kernels with the row by row fallback (cast_eval_arg_batch).
+class TestCastBatch : public ::testing::Test
+{
+public:
+  static const int64_t BATCH_SIZE = 256;
+  static const int64_t FRAME_SIZE = 64 << 10;
+  static const int64_t RES_BUF_LEN = 16;
+
+  TestCastBatch()
+    : allocator_(ObModIds::TEST), exec_ctx_(allocator_), eval_ctx_(exec_ctx_), frame_(NULL)
+  {}
+  virtual void SetUp() override
+  {
+    frame_ = static_cast<char *>(allocator_.alloc(FRAME_SIZE));
+    ASSERT_TRUE(NULL != frame_);
+    MEMSET(frame_, 0, FRAME_SIZE);
+    eval_ctx_.frames_ = &frame_;
+    eval_ctx_.max_batch_size_ = BATCH_SIZE;
+    eval_ctx_.batch_size_ = BATCH_SIZE;
+    int64_t pos = 0;
+    init_expr(arg_, true, pos);
+    init_expr(type_, false, pos);
+    init_expr(cast_, true, pos);
+    ASSERT_LE(pos, FRAME_SIZE);
+    args_[0] = &arg_;
+    args_[1] = &type_;
+    cast_.args_ = args_;
+    cast_.arg_cnt_ = 2;
+    arg_.get_eval_info(eval_ctx_).projected_ = true;
+    type_.get_eval_info(eval_ctx_).evaluated_ = true;
+  }
+
+  void init_expr(ObExpr &expr, const bool batch, int64_t &pos)
+  {
+    new (&expr) ObExpr();
+    const int64_t cnt = batch ? BATCH_SIZE : 1;
+    expr.frame_idx_ = 0;
+    expr.batch_result_ = batch;
+    expr.batch_idx_mask_ = batch ? UINT64_MAX : 0;
+    expr.datum_off_ = static_cast<uint32_t>(pos);
+    pos += sizeof(ObDatum) * cnt;
+    expr.eval_info_off_ = static_cast<uint32_t>(pos);
+    pos += sizeof(ObEvalInfo);
+    expr.eval_flags_off_ = static_cast<uint32_t>(pos);
+    pos += ObBitVector::memory_size(cnt);
+    expr.pvt_skip_off_ = static_cast<uint32_t>(pos);
+    pos += ObBitVector::memory_size(cnt);
+    expr.res_buf_off_ = static_cast<uint32_t>(pos);
+    expr.res_buf_len_ = RES_BUF_LEN;
+    ObDatum *datums = expr.locate_batch_datums(eval_ctx_);
+    for (int64_t i = 0; i < cnt; i++) {
+      datums[i].ptr_ = frame_ + pos;
+      pos += RES_BUF_LEN;
+    }
+  }
+
+  void set_types(const ObObjType in_type, const ObObjType out_type)
+  {
+    arg_.datum_meta_.type_ = in_type;
+    cast_.datum_meta_.type_ = out_type;
+    ObDatum *datums = arg_.locate_batch_datums(eval_ctx_);
+    for (int64_t i = 0; i < BATCH_SIZE; i++) {
+      if (0 == i % 17) {
+        datums[i].set_null();
+      } else if (ob_is_unsigned_type(in_type)) {
+        datums[i].set_uint(static_cast<uint64_t>(i * 7919));
+      } else {
+        datums[i].set_int((i % 2 ? -1 : 1) * i * 7919);
+      }
+    }
+  }
+
+  int eval(ObExpr::EvalBatchFunc func, const ObBitVector &skip)
+  {
+    cast_.eval_batch_func_ = func;
+    cast_.get_eval_info(eval_ctx_).clear_evaluated_flag();
+    return cast_.eval_batch(eval_ctx_, skip, BATCH_SIZE);
+  }
+
+  void check(ObExpr::EvalFunc row_func, ObExpr::EvalBatchFunc batch_func)
+  {
+    void *skip_buf = allocator_.alloc(ObBitVector::memory_size(BATCH_SIZE));
+    ASSERT_TRUE(NULL != skip_buf);
+    ObBitVector &skip = *to_bit_vector(skip_buf);
+    skip.reset(BATCH_SIZE);
+    for (int64_t i = 0; i < BATCH_SIZE; i += 5) {
+      skip.set(i);
+    }
+    ObDatum expected[BATCH_SIZE];
+    char expected_buf[BATCH_SIZE][RES_BUF_LEN];
+    cast_.eval_func_ = row_func;
+    ASSERT_EQ(OB_SUCCESS, eval(cast_eval_arg_batch, skip));
+    ObDatum *res = cast_.locate_batch_datums(eval_ctx_);
+    for (int64_t i = 0; i < BATCH_SIZE; i++) {
+      if (!skip.at(i)) {
+        expected[i] = res[i];
+        if (!res[i].is_null()) {
+          MEMCPY(expected_buf[i], res[i].ptr_, res[i].len_);
+          expected[i].ptr_ = expected_buf[i];
+        }
+      }
+    }
+    ASSERT_EQ(OB_SUCCESS, eval(batch_func, skip));
+    ObBitVector &eval_flags = cast_.get_evaluated_flags(eval_ctx_);
+    for (int64_t i = 0; i < BATCH_SIZE; i++) {
+      if (skip.at(i)) {
+        ASSERT_FALSE(eval_flags.at(i));
+      } else {
+        ASSERT_TRUE(eval_flags.at(i));
+        ASSERT_EQ(expected[i].is_null(), res[i].is_null()) << i;
+        if (!expected[i].is_null()) {
+          ASSERT_EQ(expected[i].len_, res[i].len_) << i;
+          ASSERT_EQ(0, MEMCMP(expected[i].ptr_, res[i].ptr_, res[i].len_)) << i;
+        }
+      }
+    }
+  }
+
+protected:
+  ObArenaAllocator allocator_;
+  ObExecContext exec_ctx_;
+  ObEvalCtx eval_ctx_;
+  char *frame_;
+  ObExpr arg_;
+  ObExpr type_;
+  ObExpr cast_;
+  ObExpr *args_[2];
+};
+
+TEST_F(TestCastBatch, eval_arg)
+{
+  set_types(ObIntType, ObIntType);
+  check(cast_eval_arg, cast_eval_arg_batch_direct);
+}
+
+TEST_F(TestCastBatch, int_int)
+{
+  set_types(ObInt32Type, ObIntType);
+  check(int_int, int_int_batch);
+}
+
+TEST_F(TestCastBatch, uint_uint)
+{
+  set_types(ObUInt32Type, ObUInt64Type);
+  check(uint_uint, uint_uint_batch);
+}
+
+TEST_F(TestCastBatch, int_double)
+{
+  set_types(ObIntType, ObDoubleType);
+  check(int_double, int_double_batch);
+}
+
+TEST_F(TestCastBatch, uint_double)
+{
+  set_types(ObUInt64Type, ObDoubleType);
+  check(uint_double, uint_double_batch);
+}
+
+} // end namespace sql
+} // end namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
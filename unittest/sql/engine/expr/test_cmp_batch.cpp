@@ -0,0 +1,261 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL
+
+#include <gtest/gtest.h>
+#define private public
+#define protected public
+#include "sql/engine/expr/ob_expr_cmp_func.h"
+#include "sql/engine/ob_exec_context.h"
+
+namespace oceanbase
+{
+namespace sql
+{
+using namespace common;
+
+// Compares the batch comparison of fixed width arguments, which runs the raw kernel when
+// both arguments are in the frame and not null, with the datum compare function.
+class TestCmpBatch : public ::testing::Test
+{
+public:
+  static const int64_t BATCH_SIZE = 256;
+  static const int64_t FRAME_SIZE = 64 << 10;
+  static const int64_t RES_BUF_LEN = sizeof(int64_t);
+
+  TestCmpBatch()
+    : allocator_(ObModIds::TEST), exec_ctx_(allocator_), eval_ctx_(exec_ctx_), frame_(NULL)
+  {}
+  virtual void SetUp() override
+  {
+    frame_ = static_cast<char *>(allocator_.alloc(FRAME_SIZE));
+    ASSERT_TRUE(NULL != frame_);
+    MEMSET(frame_, 0, FRAME_SIZE);
+    eval_ctx_.frames_ = &frame_;
+    eval_ctx_.max_batch_size_ = BATCH_SIZE;
+    eval_ctx_.batch_size_ = BATCH_SIZE;
+    int64_t pos = 0;
+    init_expr(left_, pos);
+    init_expr(right_, pos);
+    init_expr(cmp_, pos);
+    ASSERT_LE(pos, FRAME_SIZE);
+    args_[0] = &left_;
+    args_[1] = &right_;
+    cmp_.args_ = args_;
+    cmp_.arg_cnt_ = 2;
+    cmp_.datum_meta_.type_ = ObIntType;
+    left_.get_eval_info(eval_ctx_).projected_ = true;
+    right_.get_eval_info(eval_ctx_).projected_ = true;
+  }
+
+  void init_expr(ObExpr &expr, int64_t &pos)
+  {
+    new (&expr) ObExpr();
+    expr.frame_idx_ = 0;
+    expr.batch_result_ = true;
+    expr.batch_idx_mask_ = UINT64_MAX;
+    expr.datum_off_ = static_cast<uint32_t>(pos);
+    pos += sizeof(ObDatum) * BATCH_SIZE;
+    expr.eval_info_off_ = static_cast<uint32_t>(pos);
+    pos += sizeof(ObEvalInfo);
+    expr.eval_flags_off_ = static_cast<uint32_t>(pos);
+    pos += ObBitVector::memory_size(BATCH_SIZE);
+    expr.pvt_skip_off_ = static_cast<uint32_t>(pos);
+    pos += ObBitVector::memory_size(BATCH_SIZE);
+    pos = upper_align(pos, RES_BUF_LEN);
+    expr.res_buf_off_ = static_cast<uint32_t>(pos);
+    expr.res_buf_len_ = RES_BUF_LEN;
+    ObDatum *datums = expr.locate_batch_datums(eval_ctx_);
+    for (int64_t i = 0; i < BATCH_SIZE; i++) {
+      datums[i].ptr_ = frame_ + pos;
+      pos += RES_BUF_LEN;
+    }
+  }
+
+  // Every pair of the boundary values, %null_step > 0 makes every %null_step-th left
+  // and right argument null.
+  template <typename T>
+  void fill(ObExpr &expr, const ObObjType type, const T *values, const int64_t cnt,
+            const bool is_left, const int64_t null_step)
+  {
+    expr.datum_meta_.type_ = type;
+    ObDatum *datums = expr.locate_batch_datums(eval_ctx_);
+    bool has_null = false;
+    for (int64_t i = 0; i < BATCH_SIZE; i++) {
+      const T v = values[is_left ? i % cnt : (i / cnt) % cnt];
+      MEMCPY(const_cast<char *>(datums[i].ptr_), &v, sizeof(v));
+      datums[i].pack_ = sizeof(v);
+      if (null_step > 0 && 0 == (i + (is_left ? 0 : 3)) % null_step) {
+        datums[i].set_null();
+        has_null = true;
+      }
+    }
+    ObEvalInfo &info = expr.get_eval_info(eval_ctx_);
+    info.point_to_frame_ = true;
+    info.notnull_ = !has_null;
+  }
+
+  static int expected_cmp(const ObCmpOp op, const int cmp)
+  {
+    int res = 0;
+    switch (op) {
+      case CO_EQ: res = (0 == cmp); break;
+      case CO_LE: res = (cmp <= 0); break;
+      case CO_LT: res = (cmp < 0); break;
+      case CO_GE: res = (cmp >= 0); break;
+      case CO_GT: res = (cmp > 0); break;
+      case CO_NE: res = (0 != cmp); break;
+      default: break;
+    }
+    return res;
+  }
+
+  void check(const ObCmpOp op)
+  {
+    const ObObjType ltype = left_.datum_meta_.type_;
+    const ObObjType rtype = right_.datum_meta_.type_;
+    ObExpr::EvalBatchFunc batch_func = ObExprCmpFuncsHelper::get_eval_batch_expr_cmp_func(
+        ltype, rtype, 0, 0, op, false, CS_TYPE_BINARY, false);
+    DatumCmpFunc datum_func = ObExprCmpFuncsHelper::get_datum_expr_cmp_func(
+        ltype, rtype, 0, 0, false, CS_TYPE_BINARY, false);
+    ASSERT_TRUE(NULL != batch_func);
+    ASSERT_TRUE(NULL != datum_func);
+    void *skip_buf = allocator_.alloc(ObBitVector::memory_size(BATCH_SIZE));
+    ASSERT_TRUE(NULL != skip_buf);
+    ObBitVector &skip = *to_bit_vector(skip_buf);
+    skip.reset(BATCH_SIZE);
+    // leave the first batches whole, so that the 16 rows steps are taken
+    for (int64_t i = BATCH_SIZE / 2; i < BATCH_SIZE; i += 5) {
+      skip.set(i);
+    }
+    cmp_.eval_batch_func_ = batch_func;
+    cmp_.get_eval_info(eval_ctx_).clear_evaluated_flag();
+    ASSERT_EQ(OB_SUCCESS, cmp_.eval_batch(eval_ctx_, skip, BATCH_SIZE));
+
+    const ObDatum *l = left_.locate_batch_datums(eval_ctx_);
+    const ObDatum *r = right_.locate_batch_datums(eval_ctx_);
+    const ObDatum *res = cmp_.locate_batch_datums(eval_ctx_);
+    ObBitVector &eval_flags = cmp_.get_evaluated_flags(eval_ctx_);
+    for (int64_t i = 0; i < BATCH_SIZE; i++) {
+      if (skip.at(i)) {
+        ASSERT_FALSE(eval_flags.at(i)) << i;
+      } else if (l[i].is_null() || r[i].is_null()) {
+        ASSERT_TRUE(eval_flags.at(i)) << i;
+        ASSERT_TRUE(res[i].is_null()) << i;
+      } else {
+        ASSERT_TRUE(eval_flags.at(i)) << i;
+        ASSERT_FALSE(res[i].is_null()) << i;
+        ASSERT_EQ(expected_cmp(op, datum_func(l[i], r[i])), res[i].get_int())
+            << "op " << op << " row " << i;
+      }
+    }
+  }
+
+  void check_all_ops()
+  {
+    const ObCmpOp ops[] = { CO_EQ, CO_LE, CO_LT, CO_GE, CO_GT, CO_NE };
+    for (int64_t i = 0; i < ARRAYSIZEOF(ops); i++) {
+      check(ops[i]);
+    }
+  }
+
+protected:
+  ObArenaAllocator allocator_;
+  ObExecContext exec_ctx_;
+  ObEvalCtx eval_ctx_;
+  char *frame_;
+  ObExpr left_;
+  ObExpr right_;
+  ObExpr cmp_;
+  ObExpr *args_[2];
+};
+
+static const int64_t INT_VALUES[] = {
+  INT64_MIN, INT64_MIN + 1, INT32_MIN, -1, 0, 1, INT32_MAX, INT64_MAX - 1, INT64_MAX
+};
+static const uint64_t UINT_VALUES[] = {
+  0, 1, UINT32_MAX, static_cast<uint64_t>(INT64_MAX), static_cast<uint64_t>(INT64_MAX) + 1,
+  UINT64_MAX - 1, UINT64_MAX
+};
+
+TEST_F(TestCmpBatch, int_int_notnull)
+{
+  fill(left_, ObIntType, INT_VALUES, ARRAYSIZEOF(INT_VALUES), true, 0);
+  fill(right_, ObIntType, INT_VALUES, ARRAYSIZEOF(INT_VALUES), false, 0);
+  ASSERT_TRUE(left_.get_eval_info(eval_ctx_).in_frame_notnull());
+  ASSERT_TRUE(right_.get_eval_info(eval_ctx_).in_frame_notnull());
+  check_all_ops();
+}
+
+TEST_F(TestCmpBatch, int_int_null)
+{
+  fill(left_, ObIntType, INT_VALUES, ARRAYSIZEOF(INT_VALUES), true, 7);
+  fill(right_, ObIntType, INT_VALUES, ARRAYSIZEOF(INT_VALUES), false, 11);
+  ASSERT_FALSE(left_.get_eval_info(eval_ctx_).in_frame_notnull());
+  check_all_ops();
+  // only one side has nulls
+  fill(left_, ObIntType, INT_VALUES, ARRAYSIZEOF(INT_VALUES), true, 0);
+  check_all_ops();
+}
+
+TEST_F(TestCmpBatch, uint_uint_notnull)
+{
+  fill(left_, ObUInt64Type, UINT_VALUES, ARRAYSIZEOF(UINT_VALUES), true, 0);
+  fill(right_, ObUInt64Type, UINT_VALUES, ARRAYSIZEOF(UINT_VALUES), false, 0);
+  check_all_ops();
+}
+
+TEST_F(TestCmpBatch, uint_uint_null)
+{
+  fill(left_, ObUInt64Type, UINT_VALUES, ARRAYSIZEOF(UINT_VALUES), true, 5);
+  fill(right_, ObUInt64Type, UINT_VALUES, ARRAYSIZEOF(UINT_VALUES), false, 0);
+  check_all_ops();
+}
+
+TEST_F(TestCmpBatch, int_uint)
+{
+  // mixed signedness has no raw kernel, the values above INT64_MAX must not wrap
+  fill(left_, ObIntType, INT_VALUES, ARRAYSIZEOF(INT_VALUES), true, 0);
+  fill(right_, ObUInt64Type, UINT_VALUES, ARRAYSIZEOF(UINT_VALUES), false, 0);
+  check_all_ops();
+  fill(left_, ObUInt64Type, UINT_VALUES, ARRAYSIZEOF(UINT_VALUES), true, 0);
+  fill(right_, ObIntType, INT_VALUES, ARRAYSIZEOF(INT_VALUES), false, 13);
+  check_all_ops();
+}
+
+TEST_F(TestCmpBatch, raw_kernel_boundary)
+{
+  // the raw kernel must compare unsigned values above INT64_MAX as unsigned
+  fill(left_, ObUInt64Type, UINT_VALUES, ARRAYSIZEOF(UINT_VALUES), true, 0);
+  fill(right_, ObUInt64Type, UINT_VALUES, ARRAYSIZEOF(UINT_VALUES), false, 0);
+  check(CO_LT);
+  const ObDatum *res = cmp_.locate_batch_datums(eval_ctx_);
+  const int64_t cnt = ARRAYSIZEOF(UINT_VALUES);
+  // row 3: left INT64_MAX, right 0; row 4 + cnt: left INT64_MAX + 1, right 1
+  ASSERT_EQ(0, res[3].get_int());
+  ASSERT_EQ(0, res[4 + cnt].get_int());
+  // row 3 * cnt + 4: left INT64_MAX + 1, right INT64_MAX
+  ASSERT_EQ(0, res[3 * cnt + 4].get_int());
+  // row 4 * cnt + 3: left INT64_MAX, right INT64_MAX + 1
+  ASSERT_EQ(1, res[4 * cnt + 3].get_int());
+}
+
+} // end namespace sql
+} // end namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
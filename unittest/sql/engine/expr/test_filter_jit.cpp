@@ -0,0 +1,341 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL
+
+#include <gtest/gtest.h>
+#define private public
+#define protected public
+#include "sql/engine/expr/ob_expr_filter_jit.h"
+#include "sql/engine/expr/ob_expr_cmp_func.h"
+#include "sql/engine/expr/ob_expr_and.h"
+#include "sql/engine/expr/ob_expr_or.h"
+#include "sql/engine/ob_exec_context.h"
+
+namespace oceanbase
+{
+namespace sql
+{
+using namespace common;
+
+// Runs the same filters through the compiled kernel and through the interpreted
+// expressions (the way ObOperator::filter_batch_rows() does) and compares the skip
+// bits left by both.
+class TestFilterJit : public ::testing::Test
+{
+public:
+  static const int64_t BATCH_SIZE = 256;
+  static const int64_t FRAME_SIZE = 1 << 20;
+  static const int64_t RES_BUF_LEN = 16;
+  static const int64_t MAX_EXPR_CNT = 64;
+
+  TestFilterJit()
+    : allocator_(ObModIds::TEST), exec_ctx_(allocator_), eval_ctx_(exec_ctx_),
+      frame_(NULL), pos_(0), expr_cnt_(0)
+  {}
+  virtual void SetUp() override
+  {
+    frame_ = static_cast<char *>(allocator_.alloc(FRAME_SIZE));
+    ASSERT_TRUE(NULL != frame_);
+    MEMSET(frame_, 0, FRAME_SIZE);
+    eval_ctx_.frames_ = &frame_;
+    eval_ctx_.max_batch_size_ = BATCH_SIZE;
+    eval_ctx_.batch_size_ = BATCH_SIZE;
+
+    c1_ = new_column(ObIntType);
+    c2_ = new_column(ObIntType);
+    u1_ = new_column(ObUInt64Type);
+    p_ = new_param(ObIntType);
+    pu_ = new_param(ObUInt64Type);
+    ObDatum *c1 = c1_->locate_batch_datums(eval_ctx_);
+    ObDatum *c2 = c2_->locate_batch_datums(eval_ctx_);
+    ObDatum *u1 = u1_->locate_batch_datums(eval_ctx_);
+    for (int64_t i = 0; i < BATCH_SIZE; i++) {
+      if (0 == i % 7) {
+        c1[i].set_null();
+      } else {
+        c1[i].set_int((i * 37) % 101 - 50);
+      }
+      if (0 == i % 11) {
+        c2[i].set_null();
+      } else {
+        c2[i].set_int((i * 53) % 97 - 48);
+      }
+      if (0 == i % 13) {
+        u1[i].set_null();
+      } else {
+        u1[i].set_uint((i % 2 ? (1ULL << 63) : 0) + i);
+      }
+    }
+    p_->locate_expr_datum(eval_ctx_).set_int(5);
+    pu_->locate_expr_datum(eval_ctx_).set_uint((1ULL << 63) + 100);
+  }
+
+  ObExpr *new_expr(const ObItemType type, const ObObjType res_type, const bool batch)
+  {
+    ObExpr *expr = static_cast<ObExpr *>(allocator_.alloc(sizeof(ObExpr)));
+    OB_ASSERT(NULL != expr && expr_cnt_ < MAX_EXPR_CNT);
+    new (expr) ObExpr();
+    const int64_t cnt = batch ? BATCH_SIZE : 1;
+    expr->type_ = type;
+    expr->datum_meta_.type_ = res_type;
+    expr->frame_idx_ = 0;
+    expr->batch_result_ = batch;
+    expr->batch_idx_mask_ = batch ? UINT64_MAX : 0;
+    expr->datum_off_ = static_cast<uint32_t>(pos_);
+    pos_ += sizeof(ObDatum) * cnt;
+    expr->eval_info_off_ = static_cast<uint32_t>(pos_);
+    pos_ += sizeof(ObEvalInfo);
+    expr->eval_flags_off_ = static_cast<uint32_t>(pos_);
+    pos_ += ObBitVector::memory_size(cnt);
+    expr->pvt_skip_off_ = static_cast<uint32_t>(pos_);
+    pos_ += ObBitVector::memory_size(cnt);
+    expr->res_buf_off_ = static_cast<uint32_t>(pos_);
+    expr->res_buf_len_ = RES_BUF_LEN;
+    ObDatum *datums = expr->locate_batch_datums(eval_ctx_);
+    for (int64_t i = 0; i < cnt; i++) {
+      datums[i].ptr_ = frame_ + pos_;
+      pos_ += RES_BUF_LEN;
+    }
+    OB_ASSERT(pos_ <= FRAME_SIZE);
+    exprs_[expr_cnt_++] = expr;
+    return expr;
+  }
+
+  ObExpr *new_column(const ObObjType type)
+  {
+    ObExpr *expr = new_expr(T_REF_COLUMN, type, true);
+    expr->get_eval_info(eval_ctx_).projected_ = true;
+    return expr;
+  }
+
+  ObExpr *new_param(const ObObjType type)
+  {
+    ObExpr *expr = new_expr(T_QUESTIONMARK, type, false);
+    expr->get_eval_info(eval_ctx_).evaluated_ = true;
+    return expr;
+  }
+
+  ObExpr *new_cmp(const ObItemType type, ObExpr *l, ObExpr *r)
+  {
+    ObCmpOp cmp_op = CO_EQ;
+    switch (type) {
+      case T_OP_EQ: cmp_op = CO_EQ; break;
+      case T_OP_NE: cmp_op = CO_NE; break;
+      case T_OP_LT: cmp_op = CO_LT; break;
+      case T_OP_LE: cmp_op = CO_LE; break;
+      case T_OP_GT: cmp_op = CO_GT; break;
+      default: cmp_op = CO_GE; break;
+    }
+    ObExpr *expr = new_expr(type, ObInt32Type, true);
+    set_args(expr, l, r);
+    expr->eval_func_ = ObExprCmpFuncsHelper::get_eval_expr_cmp_func(
+        l->datum_meta_.type_, r->datum_meta_.type_, 0, 0, cmp_op, false, CS_TYPE_BINARY, false);
+    expr->eval_batch_func_ = ObExprCmpFuncsHelper::get_eval_batch_expr_cmp_func(
+        l->datum_meta_.type_, r->datum_meta_.type_, 0, 0, cmp_op, false, CS_TYPE_BINARY, false);
+    return expr;
+  }
+
+  ObExpr *new_logic(const ObItemType type, ObExpr *l, ObExpr *r)
+  {
+    ObExpr *expr = new_expr(type, ObInt32Type, true);
+    set_args(expr, l, r);
+    expr->eval_batch_func_ = T_OP_AND == type
+        ? ObExprAnd::eval_and_batch_exprN : ObExprOr::eval_or_batch_exprN;
+    return expr;
+  }
+
+  void set_args(ObExpr *expr, ObExpr *l, ObExpr *r)
+  {
+    expr->args_ = static_cast<ObExpr **>(allocator_.alloc(2 * sizeof(ObExpr *)));
+    OB_ASSERT(NULL != expr->args_);
+    expr->args_[0] = l;
+    expr->args_[1] = r;
+    expr->arg_cnt_ = 2;
+  }
+
+  ObBitVector *new_skip()
+  {
+    void *buf = allocator_.alloc(ObBitVector::memory_size(BATCH_SIZE));
+    OB_ASSERT(NULL != buf);
+    ObBitVector *skip = to_bit_vector(buf);
+    skip->reset(BATCH_SIZE);
+    for (int64_t i = 0; i < BATCH_SIZE; i += 9) {
+      skip->set(i);
+    }
+    return skip;
+  }
+
+  void clear_evaluated()
+  {
+    for (int64_t i = 0; i < expr_cnt_; i++) {
+      if (exprs_[i]->arg_cnt_ > 0) {
+        exprs_[i]->get_eval_info(eval_ctx_).clear_evaluated_flag();
+      }
+    }
+  }
+
+  // same as ObOperator::filter_batch_rows()
+  int interpret(const ObIArray<ObExpr *> &filters, ObBitVector &skip, bool &all_filtered)
+  {
+    int ret = OB_SUCCESS;
+    all_filtered = false;
+    clear_evaluated();
+    for (int64_t f = 0; OB_SUCC(ret) && !all_filtered && f < filters.count(); f++) {
+      ObExpr *e = filters.at(f);
+      if (OB_FAIL(e->eval_batch(eval_ctx_, skip, BATCH_SIZE))) {
+        LOG_WARN("evaluate batch failed", K(ret));
+      } else {
+        int64_t output_rows = 0;
+        const ObDatum *datums = e->locate_batch_datums(eval_ctx_);
+        for (int64_t i = 0; i < BATCH_SIZE; i++) {
+          if (!skip.at(i)) {
+            if (datums[i].null_ || 0 == *datums[i].int_) {
+              skip.set(i);
+            } else {
+              output_rows += 1;
+            }
+          }
+        }
+        all_filtered = (0 == output_rows);
+      }
+    }
+    return ret;
+  }
+
+  void check(const ObIArray<ObExpr *> &filters)
+  {
+    ASSERT_TRUE(ObExprFilterJit::is_supported(filters));
+    ObExprFilterJit filter_jit(OB_SYS_TENANT_ID);
+    ASSERT_EQ(OB_SUCCESS, filter_jit.compile(filters, 1));
+    ObBitVector *expected = new_skip();
+    ObBitVector *skip = new_skip();
+    bool expected_all_filtered = false;
+    bool all_filtered = false;
+    bool done = false;
+    ASSERT_EQ(OB_SUCCESS, interpret(filters, *expected, expected_all_filtered));
+    clear_evaluated();
+    ASSERT_EQ(OB_SUCCESS, filter_jit.filter_batch(eval_ctx_, *skip, BATCH_SIZE, all_filtered, done));
+    ASSERT_TRUE(done);
+    ASSERT_EQ(expected_all_filtered, all_filtered);
+    int64_t passed = 0;
+    for (int64_t i = 0; i < BATCH_SIZE; i++) {
+      ASSERT_EQ(expected->at(i), skip->at(i)) << "row " << i;
+      passed += skip->at(i) ? 0 : 1;
+    }
+    LOG_INFO("filter jit checked", K(filters.count()), K(passed));
+  }
+
+protected:
+  ObArenaAllocator allocator_;
+  ObExecContext exec_ctx_;
+  ObEvalCtx eval_ctx_;
+  char *frame_;
+  int64_t pos_;
+  ObExpr *exprs_[MAX_EXPR_CNT];
+  int64_t expr_cnt_;
+  ObExpr *c1_;
+  ObExpr *c2_;
+  ObExpr *u1_;
+  ObExpr *p_;
+  ObExpr *pu_;
+};
+
+TEST_F(TestFilterJit, compare_columns)
+{
+  const ObItemType types[] = { T_OP_EQ, T_OP_NE, T_OP_LT, T_OP_LE, T_OP_GT, T_OP_GE };
+  for (int64_t i = 0; i < ARRAYSIZEOF(types); i++) {
+    ObSEArray<ObExpr *, 1> filters;
+    ASSERT_EQ(OB_SUCCESS, filters.push_back(new_cmp(types[i], c1_, c2_)));
+    check(filters);
+  }
+}
+
+TEST_F(TestFilterJit, compare_param)
+{
+  const ObItemType types[] = { T_OP_EQ, T_OP_NE, T_OP_LT, T_OP_LE, T_OP_GT, T_OP_GE };
+  for (int64_t i = 0; i < ARRAYSIZEOF(types); i++) {
+    ObSEArray<ObExpr *, 2> filters;
+    ASSERT_EQ(OB_SUCCESS, filters.push_back(new_cmp(types[i], c1_, p_)));
+    ASSERT_EQ(OB_SUCCESS, filters.push_back(new_cmp(types[i], p_, c2_)));
+    check(filters);
+  }
+}
+
+TEST_F(TestFilterJit, compare_unsigned)
+{
+  ObSEArray<ObExpr *, 1> filters;
+  ASSERT_EQ(OB_SUCCESS, filters.push_back(new_cmp(T_OP_GT, u1_, pu_)));
+  check(filters);
+  filters.reset();
+  ASSERT_EQ(OB_SUCCESS, filters.push_back(new_cmp(T_OP_LE, u1_, pu_)));
+  check(filters);
+}
+
+TEST_F(TestFilterJit, and_or)
+{
+  // (c1 = c2 OR c1 > ?) AND c2 <> ?, then c1 <= ? OR (c2 < c1 AND c2 >= ?)
+  ObSEArray<ObExpr *, 2> filters;
+  ObExpr *or_expr = new_logic(T_OP_OR, new_cmp(T_OP_EQ, c1_, c2_), new_cmp(T_OP_GT, c1_, p_));
+  ASSERT_EQ(OB_SUCCESS, filters.push_back(new_logic(T_OP_AND, or_expr, new_cmp(T_OP_NE, c2_, p_))));
+  check(filters);
+  filters.reset();
+  ObExpr *and_expr = new_logic(T_OP_AND, new_cmp(T_OP_LT, c2_, c1_), new_cmp(T_OP_GE, c2_, p_));
+  ASSERT_EQ(OB_SUCCESS, filters.push_back(new_logic(T_OP_OR, new_cmp(T_OP_LE, c1_, p_), and_expr)));
+  check(filters);
+}
+
+TEST_F(TestFilterJit, all_filtered)
+{
+  ObSEArray<ObExpr *, 2> filters;
+  ASSERT_EQ(OB_SUCCESS, filters.push_back(new_cmp(T_OP_GT, c1_, p_)));
+  ASSERT_EQ(OB_SUCCESS, filters.push_back(new_cmp(T_OP_LT, c1_, p_)));
+  check(filters);
+}
+
+TEST_F(TestFilterJit, null_param)
+{
+  ObSEArray<ObExpr *, 1> filters;
+  ASSERT_EQ(OB_SUCCESS, filters.push_back(new_cmp(T_OP_EQ, c1_, p_)));
+  ObExprFilterJit filter_jit(OB_SYS_TENANT_ID);
+  ASSERT_EQ(OB_SUCCESS, filter_jit.compile(filters, 1));
+  p_->locate_expr_datum(eval_ctx_).set_null();
+  ObBitVector *skip = new_skip();
+  bool all_filtered = false;
+  bool done = true;
+  ASSERT_EQ(OB_SUCCESS, filter_jit.filter_batch(eval_ctx_, *skip, BATCH_SIZE, all_filtered, done));
+  // left to the interpreted filters
+  ASSERT_FALSE(done);
+}
+
+TEST_F(TestFilterJit, not_supported)
+{
+  ObSEArray<ObExpr *, 1> filters;
+  ASSERT_FALSE(ObExprFilterJit::is_supported(filters));
+  ObExpr *d1 = new_column(ObDoubleType);
+  ASSERT_EQ(OB_SUCCESS, filters.push_back(new_cmp(T_OP_EQ, d1, d1)));
+  ASSERT_FALSE(ObExprFilterJit::is_supported(filters));
+  filters.reset();
+  ASSERT_EQ(OB_SUCCESS, filters.push_back(new_cmp(T_OP_EQ, c1_, u1_)));
+  ASSERT_FALSE(ObExprFilterJit::is_supported(filters));
+}
+
+} // end namespace sql
+} // end namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  OB_LOGGER.set_log_level("INFO");
+  oceanbase::jit::ObLLVMHelper::initialize();
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
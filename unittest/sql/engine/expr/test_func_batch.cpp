@@ -0,0 +1,337 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL
+
+#include <gtest/gtest.h>
+#define private public
+#define protected public
+#include "sql/engine/expr/ob_expr_lower.h"
+#include "sql/engine/expr/ob_expr_length.h"
+#include "sql/engine/expr/ob_expr_md5.h"
+#include "sql/engine/expr/ob_expr_sha.h"
+#include "sql/engine/expr/ob_expr_concat.h"
+#include "sql/engine/expr/ob_expr_date_format.h"
+#include "sql/engine/expr/ob_expr_date_add.h"
+#include "sql/engine/ob_exec_context.h"
+#include "sql/session/ob_sql_session_info.h"
+
+namespace oceanbase
+{
+namespace sql
+{
+using namespace common;
+
+// defined in ob_expr_str_to_date.cpp
+extern int calc_str_to_date_expr_datetime(const ObExpr &, ObEvalCtx &, ObDatum &);
+extern int calc_str_to_date_expr_batch(const ObExpr &, ObEvalCtx &, const ObBitVector &,
+                                       const int64_t);
+
+// Compares the batch kernels of the string and temporal functions with the row by row
+// fallback (expr_default_eval_batch_func) on the same batch, nulls and skipped rows included.
+class TestFuncBatch : public ::testing::Test
+{
+public:
+  static const int64_t BATCH_SIZE = 256;
+  static const int64_t FRAME_SIZE = 512 << 10;
+  static const int64_t MAX_ARG_CNT = 3;
+  static const int64_t ARG_RES_BUF_LEN = 16;
+  // date_format reserves OB_MAX_DATE_FORMAT_BUF_LEN for each row
+  static const int64_t RES_BUF_LEN = 1024;
+
+  TestFuncBatch()
+    : allocator_(ObModIds::TEST), exec_ctx_(allocator_), eval_ctx_(exec_ctx_), frame_(NULL)
+  {}
+  virtual void SetUp() override
+  {
+    ASSERT_EQ(OB_SUCCESS, session_.test_init(0, 0, 0, NULL));
+    ASSERT_EQ(OB_SUCCESS, ObPreProcessSysVars::init_sys_var());
+    ASSERT_EQ(OB_SUCCESS, session_.load_default_sys_variable(false, true));
+    ASSERT_EQ(OB_SUCCESS, session_.init_tenant("test", OB_SYS_TENANT_ID));
+    exec_ctx_.set_my_session(&session_);
+    frame_ = static_cast<char *>(allocator_.alloc(FRAME_SIZE));
+    ASSERT_TRUE(NULL != frame_);
+    MEMSET(frame_, 0, FRAME_SIZE);
+    eval_ctx_.frames_ = &frame_;
+    eval_ctx_.max_batch_size_ = BATCH_SIZE;
+    eval_ctx_.batch_size_ = BATCH_SIZE;
+    int64_t pos = 0;
+    for (int64_t i = 0; i < MAX_ARG_CNT; i++) {
+      init_expr(arg_exprs_[i], ARG_RES_BUF_LEN, pos);
+      arg_exprs_[i].get_eval_info(eval_ctx_).projected_ = true;
+      args_[i] = &arg_exprs_[i];
+    }
+    init_expr(func_, RES_BUF_LEN, pos);
+    ASSERT_LE(pos, FRAME_SIZE);
+    func_.args_ = args_;
+  }
+
+  void init_expr(ObExpr &expr, const int64_t res_buf_len, int64_t &pos)
+  {
+    new (&expr) ObExpr();
+    expr.frame_idx_ = 0;
+    expr.batch_result_ = true;
+    expr.batch_idx_mask_ = UINT64_MAX;
+    expr.datum_off_ = static_cast<uint32_t>(pos);
+    pos += sizeof(ObDatum) * BATCH_SIZE;
+    expr.eval_info_off_ = static_cast<uint32_t>(pos);
+    pos += sizeof(ObEvalInfo);
+    expr.eval_flags_off_ = static_cast<uint32_t>(pos);
+    pos += ObBitVector::memory_size(BATCH_SIZE);
+    expr.pvt_skip_off_ = static_cast<uint32_t>(pos);
+    pos += ObBitVector::memory_size(BATCH_SIZE);
+    pos = upper_align(pos, sizeof(int64_t));
+    expr.res_buf_off_ = static_cast<uint32_t>(pos);
+    expr.res_buf_len_ = static_cast<uint32_t>(res_buf_len);
+    ObDatum *datums = expr.locate_batch_datums(eval_ctx_);
+    for (int64_t i = 0; i < BATCH_SIZE; i++) {
+      datums[i].ptr_ = frame_ + pos;
+      pos += res_buf_len;
+    }
+  }
+
+  void init_func(const ObObjType type, const int64_t arg_cnt)
+  {
+    func_.datum_meta_.type_ = type;
+    func_.datum_meta_.cs_type_ = ob_is_string_type(type) ? CS_TYPE_UTF8MB4_GENERAL_CI
+                                                         : CS_TYPE_BINARY;
+    func_.obj_meta_.set_type(type);
+    func_.obj_meta_.set_collation_type(func_.datum_meta_.cs_type_);
+    func_.arg_cnt_ = static_cast<uint32_t>(arg_cnt);
+  }
+
+  // The values of argument %idx repeat every %cnt rows, so that the arguments filled
+  // with the same %cnt stay paired. Every %null_step-th row from %null_off is null.
+  void fill_str(const int64_t idx, const char *const *values, const int64_t cnt,
+                const int64_t null_step, const int64_t null_off = 0)
+  {
+    ObExpr &arg = arg_exprs_[idx];
+    arg.datum_meta_.type_ = ObVarcharType;
+    arg.datum_meta_.cs_type_ = CS_TYPE_UTF8MB4_GENERAL_CI;
+    arg.obj_meta_.set_varchar();
+    arg.obj_meta_.set_collation_type(CS_TYPE_UTF8MB4_GENERAL_CI);
+    ObDatum *datums = arg.locate_batch_datums(eval_ctx_);
+    for (int64_t i = 0; i < BATCH_SIZE; i++) {
+      if (null_step > 0 && 0 == (i + null_off) % null_step) {
+        datums[i].set_null();
+      } else {
+        datums[i].set_string(values[i % cnt], static_cast<int32_t>(STRLEN(values[i % cnt])));
+      }
+    }
+  }
+
+  void fill_int(const int64_t idx, const ObObjType type, const int64_t *values,
+                const int64_t cnt, const int64_t null_step, const int64_t null_off = 0)
+  {
+    ObExpr &arg = arg_exprs_[idx];
+    arg.datum_meta_.type_ = type;
+    arg.datum_meta_.cs_type_ = CS_TYPE_BINARY;
+    arg.obj_meta_.set_type(type);
+    ObDatum *datums = arg.locate_batch_datums(eval_ctx_);
+    for (int64_t i = 0; i < BATCH_SIZE; i++) {
+      if (null_step > 0 && 0 == (i + null_off) % null_step) {
+        datums[i].set_null();
+      } else {
+        datums[i].set_int(values[i % cnt]);
+      }
+    }
+  }
+
+  int eval(ObExpr::EvalBatchFunc func, const ObBitVector &skip)
+  {
+    func_.eval_batch_func_ = func;
+    func_.get_eval_info(eval_ctx_).clear_evaluated_flag();
+    return func_.eval_batch(eval_ctx_, skip, BATCH_SIZE);
+  }
+
+  void check(ObExpr::EvalFunc row_func, ObExpr::EvalBatchFunc batch_func)
+  {
+    void *skip_buf = allocator_.alloc(ObBitVector::memory_size(BATCH_SIZE));
+    char *expected_buf = static_cast<char *>(allocator_.alloc(BATCH_SIZE * RES_BUF_LEN));
+    ASSERT_TRUE(NULL != skip_buf);
+    ASSERT_TRUE(NULL != expected_buf);
+    ObBitVector &skip = *to_bit_vector(skip_buf);
+    skip.reset(BATCH_SIZE);
+    for (int64_t i = 0; i < BATCH_SIZE; i += 5) {
+      skip.set(i);
+    }
+    ObDatum expected[BATCH_SIZE];
+    func_.eval_func_ = row_func;
+    ASSERT_EQ(OB_SUCCESS, eval(expr_default_eval_batch_func, skip));
+    ObDatum *res = func_.locate_batch_datums(eval_ctx_);
+    int64_t not_null_cnt = 0;
+    for (int64_t i = 0; i < BATCH_SIZE; i++) {
+      if (!skip.at(i)) {
+        expected[i] = res[i];
+        if (!res[i].is_null()) {
+          ASSERT_LE(res[i].len_, RES_BUF_LEN);
+          MEMCPY(expected_buf + i * RES_BUF_LEN, res[i].ptr_, res[i].len_);
+          expected[i].ptr_ = expected_buf + i * RES_BUF_LEN;
+          not_null_cnt++;
+        }
+      }
+    }
+    // the rows are not all null, the kernel is not checked on nulls only
+    ASSERT_LT(0, not_null_cnt);
+    ASSERT_EQ(OB_SUCCESS, eval(batch_func, skip));
+    ObBitVector &eval_flags = func_.get_evaluated_flags(eval_ctx_);
+    for (int64_t i = 0; i < BATCH_SIZE; i++) {
+      if (skip.at(i)) {
+        ASSERT_FALSE(eval_flags.at(i));
+      } else {
+        ASSERT_TRUE(eval_flags.at(i));
+        ASSERT_EQ(expected[i].is_null(), res[i].is_null()) << i;
+        if (!expected[i].is_null()) {
+          ASSERT_EQ(expected[i].len_, res[i].len_) << i;
+          ASSERT_EQ(0, MEMCMP(expected[i].ptr_, res[i].ptr_, res[i].len_)) << i;
+        }
+      }
+    }
+  }
+
+protected:
+  ObArenaAllocator allocator_;
+  ObSQLSessionInfo session_;
+  ObExecContext exec_ctx_;
+  ObEvalCtx eval_ctx_;
+  char *frame_;
+  ObExpr arg_exprs_[MAX_ARG_CNT];
+  ObExpr func_;
+  ObExpr *args_[MAX_ARG_CNT];
+};
+
+static const char *const TEXTS[] = {
+  "", "a", "OceanBase", "MiXeD cAsE 123", "ÀÉÎÕÜ àéîõü", "Straße", "中文字符", " \t trailing  ",
+  "select * from t1 where c1 = 'ABC'"
+};
+static const int64_t TEXT_CNT = ARRAYSIZEOF(TEXTS);
+
+TEST_F(TestFuncBatch, lower_upper)
+{
+  init_func(ObVarcharType, 1);
+  fill_str(0, TEXTS, TEXT_CNT, 7);
+  check(ObExprLower::calc_lower, ObExprLower::calc_lower_batch);
+  check(ObExprUpper::calc_upper, ObExprUpper::calc_upper_batch);
+}
+
+TEST_F(TestFuncBatch, length)
+{
+  init_func(ObIntType, 1);
+  fill_str(0, TEXTS, TEXT_CNT, 7);
+  check(ObExprLength::calc_mysql_mode, ObExprLength::calc_mysql_mode_batch);
+}
+
+TEST_F(TestFuncBatch, md5)
+{
+  init_func(ObVarcharType, 1);
+  fill_str(0, TEXTS, TEXT_CNT, 7);
+  check(ObExprMd5::calc_md5, ObExprMd5::calc_md5_batch);
+}
+
+TEST_F(TestFuncBatch, sha)
+{
+  init_func(ObVarcharType, 1);
+  fill_str(0, TEXTS, TEXT_CNT, 7);
+  check(ObExprSha::eval_sha, ObExprSha::eval_sha_batch);
+
+  // all the hash lengths, 0 for 256 and an invalid one which gives null
+  const int64_t lens[] = { 0, 224, 256, 384, 512, 100 };
+  init_func(ObVarcharType, 2);
+  fill_str(0, TEXTS, TEXT_CNT, 7);
+  fill_int(1, ObIntType, lens, ARRAYSIZEOF(lens), 11, 3);
+  check(ObExprSha2::eval_sha2, ObExprSha2::eval_sha2_batch);
+}
+
+TEST_F(TestFuncBatch, concat)
+{
+  init_func(ObVarcharType, 3);
+  fill_str(0, TEXTS, TEXT_CNT, 7);
+  fill_str(1, TEXTS + 1, TEXT_CNT - 1, 11, 3);
+  fill_str(2, TEXTS + 2, TEXT_CNT - 2, 0);
+  check(ObExprConcat::eval_concat, ObExprConcat::eval_concat_batch);
+
+  // a single argument is shadow copied
+  init_func(ObVarcharType, 1);
+  check(ObExprConcat::eval_concat, ObExprConcat::eval_concat_batch);
+}
+
+TEST_F(TestFuncBatch, date_format)
+{
+  // 1970-01-01 00:00:00 and a few dates of different years, months and times of day
+  const int64_t datetimes[] = {
+    0, 1262304000000000, 1700000000123456, 951782400000000, 4102444799999999, 1000000000000
+  };
+  const char *const formats[] = {
+    "%Y-%m-%d %H:%i:%s", "%W %M %D %Y", "%j %U %u %V %v %X %x", "%a %b %e %c %f %p %r %T",
+    "%y%m%d", "no specifier", "%%"
+  };
+  init_func(ObVarcharType, 2);
+  fill_int(0, ObDateTimeType, datetimes, ARRAYSIZEOF(datetimes), 7);
+  fill_str(1, formats, ARRAYSIZEOF(formats), 13, 5);
+  check(ObExprDateFormat::calc_date_format, ObExprDateFormat::calc_date_format_batch);
+
+  // dates in strings are converted with the session time zone and sql mode
+  const char *const dates[] = {
+    "2023-11-14 22:13:20", "2000-02-29", "1999-12-31 23:59:59.999999", "20240101"
+  };
+  fill_str(0, dates, ARRAYSIZEOF(dates), 7);
+  check(ObExprDateFormat::calc_date_format, ObExprDateFormat::calc_date_format_batch);
+}
+
+TEST_F(TestFuncBatch, str_to_date)
+{
+  const char *const dates[] = {
+    "2023-11-14 22:13:20", "29/02/2000", "1999-12-31", "Jan 5 2024 10:00", "20240101"
+  };
+  const char *const formats[] = {
+    "%Y-%m-%d %H:%i:%s", "%d/%m/%Y", "%Y-%m-%d", "%b %e %Y %H:%i", "%Y%m%d"
+  };
+  init_func(ObDateTimeType, 2);
+  fill_str(0, dates, ARRAYSIZEOF(dates), 7);
+  fill_str(1, formats, ARRAYSIZEOF(formats), 11, 3);
+  check(calc_str_to_date_expr_datetime, calc_str_to_date_expr_batch);
+}
+
+TEST_F(TestFuncBatch, date_add_sub)
+{
+  const int64_t datetimes[] = {
+    1262304000000000, 1700000000123456, 951782400000000, 1000000000000, 1709164800000000
+  };
+  const char *const intervals[] = { "1", "-3", "1-2", "25", "5 10" };
+  const int64_t units[] = {
+    DATE_UNIT_DAY, DATE_UNIT_MONTH, DATE_UNIT_YEAR_MONTH, DATE_UNIT_HOUR, DATE_UNIT_DAY_HOUR
+  };
+  init_func(ObDateTimeType, 3);
+  fill_int(0, ObDateTimeType, datetimes, ARRAYSIZEOF(datetimes), 7);
+  fill_str(1, intervals, ARRAYSIZEOF(intervals), 11, 3);
+  fill_int(2, ObIntType, units, ARRAYSIZEOF(units), 0);
+  check(ObExprDateAdd::calc_date_add, ObExprDateAdd::calc_date_add_batch);
+  check(ObExprDateSub::calc_date_sub, ObExprDateSub::calc_date_sub_batch);
+
+  // dates in strings
+  const char *const dates[] = {
+    "2010-01-01", "2023-11-14 22:13:20.123456", "2000-02-29", "1970-01-12", "2024-02-29"
+  };
+  fill_str(0, dates, ARRAYSIZEOF(dates), 7);
+  check(ObExprDateAdd::calc_date_add, ObExprDateAdd::calc_date_add_batch);
+  check(ObExprDateSub::calc_date_sub, ObExprDateSub::calc_date_sub_batch);
+}
+
+} // end namespace sql
+} // end namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,239 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL
+
+#include <gtest/gtest.h>
+#include <icu/i18n/unicode/uregex.h>
+#include <icu/common/unicode/ustring.h>
+#define private public
+#define protected public
+#include "sql/engine/expr/ob_expr_regexp_fast_matcher.h"
+#include "lib/allocator/page_arena.h"
+
+namespace oceanbase
+{
+namespace sql
+{
+using namespace common;
+
+// Every answer of the fast matcher must be the one of ICU, which REGEXP and
+// REGEXP_LIKE use when the fast matcher can not decide.
+class TestRegexpFastMatcher : public ::testing::Test
+{
+public:
+  TestRegexpFastMatcher() : allocator_(ObModIds::TEST) {}
+
+  static int to_utf16(const char *str, const int64_t len, UChar *buf,
+                      const int32_t buf_len, int32_t &u_len)
+  {
+    int ret = OB_SUCCESS;
+    UErrorCode status = U_ZERO_ERROR;
+    u_strFromUTF8(buf, buf_len, &u_len, str, static_cast<int32_t>(len), &status);
+    if (U_FAILURE(status)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("convert to utf16 failed", K(ret), K(u_errorName(status)));
+    }
+    return ret;
+  }
+
+  // the same as ObExprRegexContext::match() with start 0
+  static int icu_match(const char *pattern, const char *text, const int64_t text_len,
+                       const uint32_t flags, bool &result)
+  {
+    int ret = OB_SUCCESS;
+    UChar u_pattern[256];
+    UChar u_text[256];
+    int32_t u_pattern_len = 0;
+    int32_t u_text_len = 0;
+    UParseError parse_error;
+    UErrorCode status = U_ZERO_ERROR;
+    URegularExpression *regex = NULL;
+    if (OB_FAIL(to_utf16(pattern, strlen(pattern), u_pattern, 256, u_pattern_len))) {
+    } else if (OB_FAIL(to_utf16(text, text_len, u_text, 256, u_text_len))) {
+    } else if (OB_ISNULL(regex = uregex_open(u_pattern, u_pattern_len, flags,
+                                             &parse_error, &status))
+               || U_FAILURE(status)) {
+      ret = OB_ERR_REGEXP_ERROR;
+      LOG_WARN("open regex failed", K(ret), K(pattern), K(u_errorName(status)));
+    } else {
+      uregex_setText(regex, u_text, u_text_len, &status);
+      result = uregex_find(regex, 0, &status);
+      if (U_FAILURE(status)) {
+        ret = OB_ERR_REGEXP_ERROR;
+        LOG_WARN("regex find failed", K(ret), K(pattern), K(u_errorName(status)));
+      }
+    }
+    if (NULL != regex) {
+      uregex_close(regex);
+    }
+    return ret;
+  }
+
+  // returns the count of texts decided by the fast matcher
+  int64_t check(const char *pattern, const uint32_t flags,
+                const char *const *texts, const int64_t text_cnt)
+  {
+    int64_t done_cnt = 0;
+    ObExprRegexFastMatcher matcher;
+    EXPECT_EQ(OB_SUCCESS, matcher.init(allocator_, ObString(pattern), flags));
+    for (int64_t i = 0; i < text_cnt; i++) {
+      const ObString text(texts[i]);
+      bool expected = false;
+      bool result = false;
+      bool done = false;
+      EXPECT_EQ(OB_SUCCESS, icu_match(pattern, text.ptr(), text.length(), flags, expected));
+      matcher.match(text, result, done);
+      if (done) {
+        done_cnt++;
+        EXPECT_EQ(expected, result) << "pattern: " << pattern << ", text: " << texts[i]
+                                    << ", flags: " << flags;
+      }
+    }
+    return done_cnt;
+  }
+
+protected:
+  ObArenaAllocator allocator_;
+};
+
+static const char *const TEXTS[] = {
+  "", "a", "abc", "xxabcxx", "ab", "ABC", "aBc", "abcabc", "abd", "cd", "abab", "ababe",
+  "cdcde", "abcdabcde", "abc\n", "abc\r\n", "abc\r", "abc\n\n", "\nabc", "xabc", "abcx",
+  "a\nc", "a\rc", "a\r\nc", "a中c", "中文", "中.文", "中x文", "中文\n", "文中", "😀", "a😀c",
+  "0", "123", "12-34", "12-", "-34", "a1b2", "x", "xyy", "yyy", "b", "a\nb", "\n", "  ",
+  "a\xC2\x85", "abc\xE2\x80\xA8", "\xE2\x84\xAA", "k", "K", "\xC5\xBF", "s", "S",
+};
+static const int64_t TEXT_CNT = ARRAYSIZEOF(TEXTS);
+
+TEST_F(TestRegexpFastMatcher, literal)
+{
+  ASSERT_GT(check("abc", 0, TEXTS, TEXT_CNT), 0);
+  ASSERT_GT(check("ab", 0, TEXTS, TEXT_CNT), 0);
+  ASSERT_GT(check("abcde", 0, TEXTS, TEXT_CNT), 0);
+  ASSERT_GT(check("a\\.c", 0, TEXTS, TEXT_CNT), 0);
+  ASSERT_GT(check("12-34", 0, TEXTS, TEXT_CNT), 0);
+}
+
+TEST_F(TestRegexpFastMatcher, anchor)
+{
+  const char *patterns[] = { "^abc", "abc$", "^abc$", "^a", "c$", "^$", "^", "$", "^.*$" };
+  for (int64_t i = 0; i < ARRAYSIZEOF(patterns); i++) {
+    check(patterns[i], 0, TEXTS, TEXT_CNT);
+    check(patterns[i], UREGEX_UNIX_LINES, TEXTS, TEXT_CNT);
+    check(patterns[i], UREGEX_MULTILINE, TEXTS, TEXT_CNT);
+  }
+  ASSERT_GT(check("^abc$", 0, TEXTS, TEXT_CNT), 0);
+}
+
+TEST_F(TestRegexpFastMatcher, char_class)
+{
+  const char *patterns[] = { "[a-c]+d", "[^0-9]x", "a.c", "[abc]{3}", "[0-9]+-[0-9]+",
+                             "[^a-z]", "[-a]", "[]a]", "[a-]", "[.]", "[中文]+", "[^中]文",
+                             "[[:alpha:]]c" };
+  for (int64_t i = 0; i < ARRAYSIZEOF(patterns); i++) {
+    check(patterns[i], 0, TEXTS, TEXT_CNT);
+    check(patterns[i], UREGEX_DOTALL, TEXTS, TEXT_CNT);
+  }
+  ASSERT_GT(check("a.c", 0, TEXTS, TEXT_CNT), 0);
+  ASSERT_GT(check("[0-9]+-[0-9]+", 0, TEXTS, TEXT_CNT), 0);
+}
+
+TEST_F(TestRegexpFastMatcher, multibyte)
+{
+  const char *patterns[] = { "中文", "^中.文$", "中.?文", "a.c$", "😀", "^.$", "^..$", "文$" };
+  for (int64_t i = 0; i < ARRAYSIZEOF(patterns); i++) {
+    check(patterns[i], 0, TEXTS, TEXT_CNT);
+    check(patterns[i], UREGEX_DOTALL, TEXTS, TEXT_CNT);
+  }
+  ASSERT_GT(check("^中.文$", 0, TEXTS, TEXT_CNT), 0);
+}
+
+TEST_F(TestRegexpFastMatcher, alternation_and_quantifier)
+{
+  const char *patterns[] = { "(ab|cd){2,3}e", "ab|cd", "x?y+", "(ab)*c", "a{2}", "a{0}",
+                             "(a|b)+$", "^(abc|ab)c", "y{2,}", "ab*?c", "(?:ab)+" };
+  for (int64_t i = 0; i < ARRAYSIZEOF(patterns); i++) {
+    check(patterns[i], 0, TEXTS, TEXT_CNT);
+  }
+  ASSERT_GT(check("(ab|cd){2,3}e", 0, TEXTS, TEXT_CNT), 0);
+}
+
+TEST_F(TestRegexpFastMatcher, empty_match)
+{
+  const char *patterns[] = { "a*", "(|a)", "^$", "x?", "()", "(a*)*" };
+  for (int64_t i = 0; i < ARRAYSIZEOF(patterns); i++) {
+    check(patterns[i], 0, TEXTS, TEXT_CNT);
+    check(patterns[i], UREGEX_MULTILINE, TEXTS, TEXT_CNT);
+  }
+}
+
+TEST_F(TestRegexpFastMatcher, case_insensitive)
+{
+  // letters are refused: ICU folds KELVIN SIGN to k and LONG S to s
+  const char *patterns[] = { "k", "s", "abc", "[a-z]+", "[0-9]+-[0-9]+", "^-?[0-9]+$", "中文" };
+  for (int64_t i = 0; i < ARRAYSIZEOF(patterns); i++) {
+    check(patterns[i], UREGEX_CASE_INSENSITIVE, TEXTS, TEXT_CNT);
+  }
+  ObExprRegexFastMatcher matcher;
+  ASSERT_EQ(OB_SUCCESS, matcher.init(allocator_, ObString("k"), UREGEX_CASE_INSENSITIVE));
+  ASSERT_FALSE(matcher.is_valid());
+  ASSERT_GT(check("[0-9]+-[0-9]+", UREGEX_CASE_INSENSITIVE, TEXTS, TEXT_CNT), 0);
+}
+
+TEST_F(TestRegexpFastMatcher, line_terminator)
+{
+  const char *patterns[] = { "a.c", "a.b", "^a.*c$", "c$", "b$" };
+  const uint32_t flags[] = { 0, UREGEX_DOTALL, UREGEX_UNIX_LINES, UREGEX_DOTALL | UREGEX_UNIX_LINES,
+                             UREGEX_MULTILINE };
+  for (int64_t i = 0; i < ARRAYSIZEOF(patterns); i++) {
+    for (int64_t j = 0; j < ARRAYSIZEOF(flags); j++) {
+      check(patterns[i], flags[j], TEXTS, TEXT_CNT);
+    }
+  }
+}
+
+TEST_F(TestRegexpFastMatcher, fallback)
+{
+  // not expressible by the DFA, only the prefilter may answer, and only with false
+  const char *patterns[] = { "(a)\\1", "a(?=b)", "\\d+x", "\\w+c", "\\bab", "\\p{L}bc",
+                             "(?i)abc", "a++" };
+  for (int64_t i = 0; i < ARRAYSIZEOF(patterns); i++) {
+    ObExprRegexFastMatcher matcher;
+    ASSERT_EQ(OB_SUCCESS, matcher.init(allocator_, ObString(patterns[i]), 0));
+    ASSERT_TRUE(NULL == matcher.trans_) << patterns[i];
+    for (int64_t j = 0; j < TEXT_CNT; j++) {
+      bool result = true;
+      bool done = false;
+      matcher.match(ObString(TEXTS[j]), result, done);
+      ASSERT_FALSE(done && result) << patterns[i] << " " << TEXTS[j];
+    }
+    check(patterns[i], 0, TEXTS, TEXT_CNT);
+  }
+  // invalid utf8 is left to the charset conversion of the ICU path
+  ObExprRegexFastMatcher matcher;
+  bool result = false;
+  bool done = true;
+  ASSERT_EQ(OB_SUCCESS, matcher.init(allocator_, ObString("abc"), 0));
+  matcher.match(ObString("ab\xFF" "c"), result, done);
+  ASSERT_FALSE(done);
+}
+
+} // end namespace sql
+} // end namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,305 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL
+#include <gtest/gtest.h>
+#include <thread>
+#define private public
+#define protected public
+#include "sql/engine/cmd/ob_load_data_direct_impl.h"
+#include "lib/allocator/page_arena.h"
+#undef private
+#undef protected
+
+using namespace oceanbase;
+using namespace oceanbase::common;
+using namespace oceanbase::sql;
+
+typedef ObLoadDataDirectImpl::DataBuffer DataBuffer;
+typedef ObLoadDataDirectImpl::DataPrefetcher DataPrefetcher;
+typedef ObLoadDataDirectImpl::DataReader DataReader;
+
+// serves the file from memory, the reads beyond fail_offset_ fail
+class MockIODevice : public ObLoadDataDirectImpl::IRandomIODevice
+{
+public:
+  MockIODevice() : data_(), fail_offset_(INT64_MAX) {}
+  virtual ~MockIODevice() = default;
+  int open(const ObLoadDataDirectImpl::DataAccessParam &, const ObString &) override
+  {
+    return OB_SUCCESS;
+  }
+  int pread(char *buf, int64_t count, int64_t offset, int64_t &read_size) override
+  {
+    int ret = OB_SUCCESS;
+    read_size = 0;
+    if (offset + count > fail_offset_) {
+      ret = OB_IO_ERROR;
+    } else {
+      read_size = MAX(0, MIN(count, data_.length() - offset));
+      MEMCPY(buf, data_.ptr() + offset, read_size);
+    }
+    return ret;
+  }
+  int get_file_size(int64_t &file_size) override
+  {
+    file_size = data_.length();
+    return OB_SUCCESS;
+  }
+  ObString data_;
+  int64_t fail_offset_;
+};
+
+class MockExecuteContext : public ObLoadDataDirectImpl::LoadExecuteContext
+{
+public:
+  MockExecuteContext() : status_(OB_SUCCESS) {}
+  int check_status() override { return status_; }
+  int status_;
+};
+
+class ObLoadDataPrefetcherTest : public ::testing::Test
+{
+public:
+  ObLoadDataPrefetcherTest() : allocator_(ObModIds::TEST) {}
+  virtual ~ObLoadDataPrefetcherTest() = default;
+  virtual void SetUp() override
+  {
+    execute_ctx_.allocator_ = &allocator_;
+    execute_ctx_.job_stat_ = &job_stat_;
+    accessor_.random_io_device_ = &device_;
+    accessor_.offset_ = 0;
+    accessor_.is_inited_ = true;
+  }
+
+  // %len bytes of tab separated lines of different lengths
+  void make_data(const int64_t len)
+  {
+    char *buf = static_cast<char *>(allocator_.alloc(len));
+    ASSERT_TRUE(NULL != buf);
+    int64_t line_no = 0;
+    int64_t pos = 0;
+    while (pos < len) {
+      const int64_t line_len = MIN(len - pos, 5 + (line_no * 7) % 31);
+      for (int64_t i = 0; i < line_len; ++i) {
+        buf[pos + i] = static_cast<char>('a' + (line_no + i) % 26);
+      }
+      buf[pos + line_len / 2] = '\t';
+      buf[pos + line_len - 1] = '\n';
+      pos += line_len;
+      ++line_no;
+    }
+    device_.data_.assign_ptr(buf, static_cast<int32_t>(len));
+  }
+
+  // as DataPrefetcher::init, without the scheduler which needs a tenant,
+  // the prefetch runs in a thread of the test instead
+  void init_prefetcher(DataPrefetcher &prefetcher, const int64_t end_offset,
+                       const int64_t buffer_count, const int64_t buffer_capacity)
+  {
+    prefetcher.execute_ctx_ = &execute_ctx_;
+    prefetcher.io_accessor_ = &accessor_;
+    prefetcher.end_offset_ = end_offset;
+    void *buf = allocator_.alloc(sizeof(DataBuffer) * buffer_count);
+    ASSERT_TRUE(NULL != buf);
+    prefetcher.buffers_ = new (buf) DataBuffer[buffer_count];
+    prefetcher.buffer_count_ = buffer_count;
+    ASSERT_EQ(OB_SUCCESS, prefetcher.free_queue_.init(buffer_count, "TLD_ReadQueue"));
+    ASSERT_EQ(OB_SUCCESS, prefetcher.ready_queue_.init(buffer_count, "TLD_ReadQueue"));
+    for (int64_t i = 0; i < buffer_count; ++i) {
+      ASSERT_EQ(OB_SUCCESS, prefetcher.buffers_[i].init(buffer_capacity));
+      ASSERT_EQ(OB_SUCCESS, prefetcher.free_queue_.push(prefetcher.buffers_ + i));
+    }
+    prefetcher.is_inited_ = true;
+  }
+
+  // the prefetch task and its callback
+  static void run_prefetch(DataPrefetcher *prefetcher)
+  {
+    prefetcher->on_prefetch_finished(prefetcher->prefetch());
+  }
+
+  // read everything in pieces of %count bytes, return the error which stops it
+  int read_all(DataPrefetcher &prefetcher, const int64_t count, ObString &read_data)
+  {
+    int ret = OB_SUCCESS;
+    char *buf = static_cast<char *>(allocator_.alloc(device_.data_.length() + count));
+    int64_t pos = 0;
+    int64_t read_size = count;
+    while (OB_SUCC(ret) && read_size == count) {
+      ret = prefetcher.read(buf + pos, count, read_size);
+      pos += read_size;
+    }
+    read_data.assign_ptr(buf, static_cast<int32_t>(pos));
+    return ret;
+  }
+
+protected:
+  ObArenaAllocator allocator_;
+  ObLoadDataStat job_stat_;
+  MockExecuteContext execute_ctx_;
+  MockIODevice device_;
+  ObLoadDataDirectImpl::SequentialDataAccessor accessor_;
+};
+
+TEST_F(ObLoadDataPrefetcherTest, end_of_file)
+{
+  make_data(1000);
+  {
+    DataPrefetcher prefetcher;
+    init_prefetcher(prefetcher, device_.data_.length(), 3, 64);
+    std::thread prefetch_thread(run_prefetch, &prefetcher);
+    ObString read_data;
+    ASSERT_EQ(OB_SUCCESS, read_all(prefetcher, 100, read_data));
+    prefetch_thread.join();
+    ASSERT_EQ(device_.data_, read_data);
+    ASSERT_EQ(OB_SUCCESS, prefetcher.prefetch_ret_);
+    // nothing more after the end
+    char buf[16];
+    int64_t read_size = 1;
+    ASSERT_EQ(OB_SUCCESS, prefetcher.read(buf, sizeof(buf), read_size));
+    ASSERT_EQ(0, read_size);
+  }
+  {
+    // the range of the reader ends before the file
+    DataPrefetcher prefetcher;
+    accessor_.seek(100);
+    init_prefetcher(prefetcher, 700, 2, 64);
+    std::thread prefetch_thread(run_prefetch, &prefetcher);
+    ObString read_data;
+    ASSERT_EQ(OB_SUCCESS, read_all(prefetcher, 33, read_data));
+    prefetch_thread.join();
+    ASSERT_EQ(ObString(600, device_.data_.ptr() + 100), read_data);
+  }
+  {
+    // an empty range
+    DataPrefetcher prefetcher;
+    accessor_.seek(0);
+    init_prefetcher(prefetcher, 0, 2, 64);
+    std::thread prefetch_thread(run_prefetch, &prefetcher);
+    ObString read_data;
+    ASSERT_EQ(OB_SUCCESS, read_all(prefetcher, 10, read_data));
+    prefetch_thread.join();
+    ASSERT_EQ(0, read_data.length());
+  }
+}
+
+TEST_F(ObLoadDataPrefetcherTest, read_error)
+{
+  make_data(1000);
+  device_.fail_offset_ = 300;
+  DataPrefetcher prefetcher;
+  init_prefetcher(prefetcher, device_.data_.length(), 2, 64);
+  std::thread prefetch_thread(run_prefetch, &prefetcher);
+  ObString read_data;
+  // the buffers read before the error are handed out, then the error
+  ASSERT_EQ(OB_IO_ERROR, read_all(prefetcher, 50, read_data));
+  prefetch_thread.join();
+  ASSERT_EQ(OB_IO_ERROR, prefetcher.prefetch_ret_);
+  ASSERT_EQ(256, read_data.length());
+  ASSERT_EQ(ObString(256, device_.data_.ptr()), read_data);
+}
+
+TEST_F(ObLoadDataPrefetcherTest, stop)
+{
+  make_data(10000);
+  DataPrefetcher prefetcher;
+  init_prefetcher(prefetcher, device_.data_.length(), 2, 64);
+  std::thread prefetch_thread(run_prefetch, &prefetcher);
+  // all the buffers are filled, the prefetch waits for a free one
+  while (prefetcher.ready_queue_.size() < 2) {
+    ob_usleep(1000);
+  }
+  prefetcher.stop();
+  prefetch_thread.join();
+  ASSERT_TRUE(prefetcher.is_finished_);
+  ASSERT_EQ(OB_CANCELED, prefetcher.prefetch_ret_);
+  ObString read_data;
+  ASSERT_EQ(OB_CANCELED, read_all(prefetcher, 50, read_data));
+  ASSERT_EQ(ObString(128, device_.data_.ptr()), read_data);
+}
+
+TEST_F(ObLoadDataPrefetcherTest, canceled_query)
+{
+  make_data(1000);
+  DataPrefetcher prefetcher;
+  // the prefetch never runs, the reader gives up once the query is canceled
+  init_prefetcher(prefetcher, device_.data_.length(), 2, 64);
+  execute_ctx_.status_ = OB_CANCELED;
+  char buf[16];
+  int64_t read_size = 0;
+  ASSERT_EQ(OB_CANCELED, prefetcher.read(buf, sizeof(buf), read_size));
+  ASSERT_EQ(0, read_size);
+}
+
+TEST_F(ObLoadDataPrefetcherTest, line_spans_buffers)
+{
+  const int64_t data_len = 3000;
+  const int64_t file_buffer_size = 128;
+  make_data(data_len);
+  int64_t total_lines = 0;
+  for (int64_t i = 0; i < data_len; ++i) {
+    total_lines += ('\n' == device_.data_.ptr()[i]) ? 1 : 0;
+  }
+  DataPrefetcher prefetcher;
+  // prefetch buffers shorter than most of the lines
+  init_prefetcher(prefetcher, data_len, 3, 16);
+  DataReader reader;
+  ObDataInFileStruct file_format;
+  ObCSVFormats formats;
+  formats.init(file_format);
+  ASSERT_EQ(OB_SUCCESS, reader.csv_parser_.init(file_format, 2, CS_TYPE_UTF8MB4_BIN));
+  ASSERT_EQ(OB_SUCCESS, reader.data_trimer_.init(allocator_, formats));
+  reader.execute_ctx_ = &execute_ctx_;
+  reader.end_offset_ = data_len;
+  reader.offset_ = 0;
+  reader.set_prefetcher(&prefetcher);
+  reader.is_inited_ = true;
+  std::thread prefetch_thread(run_prefetch, &prefetcher);
+
+  void *buf = allocator_.alloc(sizeof(ObLoadFileBuffer) + file_buffer_size);
+  ASSERT_TRUE(NULL != buf);
+  ObLoadFileBuffer *file_buffer = new (buf) ObLoadFileBuffer(file_buffer_size);
+  int ret = OB_SUCCESS;
+  int64_t pos = 0;
+  int64_t line_cnt = 0;
+  int64_t buffer_cnt = 0;
+  while (OB_SUCC(ret)) {
+    int64_t line_count = 0;
+    if (OB_FAIL(reader.get_next_buffer(*file_buffer, line_count))) {
+      ASSERT_EQ(OB_ITER_END, ret);
+    } else {
+      // only complete lines are handed out, the rest waits for the next buffer
+      const int64_t len = file_buffer->get_data_len();
+      ASSERT_LT(0, line_count);
+      ASSERT_EQ('\n', file_buffer->begin_ptr()[len - 1]);
+      ASSERT_LE(pos + len, data_len);
+      ASSERT_EQ(0, MEMCMP(device_.data_.ptr() + pos, file_buffer->begin_ptr(), len));
+      pos += len;
+      line_cnt += line_count;
+      ++buffer_cnt;
+    }
+  }
+  prefetch_thread.join();
+  ASSERT_EQ(data_len, pos);
+  ASSERT_EQ(total_lines, line_cnt);
+  ASSERT_EQ(total_lines, reader.get_lines_count());
+  ASSERT_FALSE(reader.has_incomplate_data());
+  ASSERT_LT(data_len / file_buffer_size, buffer_cnt);
+}
+
+int main(int argc, char **argv)
+{
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,237 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_EXE
+#include <gtest/gtest.h>
+#include "sql/engine/px/ob_granule_pump.h"
+#include "sql/engine/px/ob_granule_util.h"
+
+using namespace oceanbase;
+using namespace oceanbase::common;
+using namespace oceanbase::sql;
+
+// The tasks of a shared GI pool are built as the block splitter does: the
+// tasks of each tablet follow each other, a task may hold several ranges.
+// The table id of a range records its position in the pool before the merge.
+class ObAdaptiveGranuleTest : public ::testing::Test
+{
+public:
+  static const int64_t MAX_TABLET_CNT = 4;
+
+  ObAdaptiveGranuleTest() = default;
+  virtual ~ObAdaptiveGranuleTest() = default;
+  virtual void SetUp() override
+  {
+    for (int64_t i = 0; i < MAX_TABLET_CNT; ++i) {
+      tablets_[i].tablet_id_ = ObTabletID(200001 + i);
+    }
+    task_of_range_.reset();
+  }
+
+  // add %task_cnt tasks of %range_cnt ranges each to the pool
+  void add_tasks(ObGITaskSet &task_set, const int64_t tablet, const int64_t task_cnt,
+                 const int64_t range_cnt = 1)
+  {
+    for (int64_t i = 0; i < task_cnt; ++i) {
+      const int64_t idx = task_set.gi_task_set_.empty()
+          ? 0 : task_set.gi_task_set_.at(task_set.gi_task_set_.count() - 1).idx_ + 1;
+      for (int64_t j = 0; j < range_cnt; ++j) {
+        ObNewRange range;
+        range.table_id_ = task_set.gi_task_set_.count();
+        ASSERT_EQ(OB_SUCCESS, task_of_range_.push_back(idx));
+        ASSERT_EQ(OB_SUCCESS, task_set.gi_task_set_.push_back(
+            ObGITaskSet::ObGITaskInfo(&tablets_[tablet], range, ObNewRange(), idx)));
+      }
+    }
+  }
+
+  // fetch every task of the pool the way the workers do, check that each
+  // range is handed out once, with its tablet and the other ranges of its
+  // task, in block order, and return how many tasks each fetch merged
+  void fetch_all(ObGITaskSet &task_set, ObIArray<int64_t> &fetch_sizes)
+  {
+    int ret = OB_SUCCESS;
+    const int64_t range_cnt = task_of_range_.count();
+    ObArray<bool> fetched;
+    int64_t last_in_tablet[MAX_TABLET_CNT];
+    for (int64_t i = 0; i < MAX_TABLET_CNT; ++i) {
+      last_in_tablet[i] = -1;
+    }
+    ASSERT_EQ(OB_SUCCESS, fetched.prepare_allocate(range_cnt));
+    for (int64_t i = 0; i < range_cnt; ++i) {
+      fetched.at(i) = false;
+    }
+    fetch_sizes.reset();
+    ObGranuleTaskInfo info;
+    while (OB_SUCC(task_set.get_next_gi_task(info))) {
+      ASSERT_TRUE(NULL != info.tablet_loc_);
+      const int64_t tablet = info.tablet_loc_ - tablets_;
+      ASSERT_TRUE(tablet >= 0 && tablet < MAX_TABLET_CNT);
+      ASSERT_LT(0, info.ranges_.count());
+      int64_t task_cnt = 0;
+      for (int64_t i = 0; i < info.ranges_.count(); ++i) {
+        const int64_t pos = info.ranges_.at(i).table_id_;
+        ASSERT_TRUE(pos >= 0 && pos < range_cnt);
+        ASSERT_FALSE(fetched.at(pos));
+        ASSERT_LT(last_in_tablet[tablet], pos);
+        // the ranges of a task are never handed out apart
+        const int64_t task = task_of_range_.at(pos);
+        if (0 == i || task != task_of_range_.at(info.ranges_.at(i - 1).table_id_)) {
+          ASSERT_TRUE(0 == pos || task != task_of_range_.at(pos - 1));
+          ++task_cnt;
+        }
+        if (info.ranges_.count() - 1 == i
+            || task != task_of_range_.at(info.ranges_.at(i + 1).table_id_)) {
+          ASSERT_TRUE(range_cnt - 1 == pos || task != task_of_range_.at(pos + 1));
+        }
+        fetched.at(pos) = true;
+        last_in_tablet[tablet] = pos;
+      }
+      ASSERT_EQ(OB_SUCCESS, fetch_sizes.push_back(task_cnt));
+    }
+    ASSERT_EQ(OB_ITER_END, ret);
+    for (int64_t i = 0; i < range_cnt; ++i) {
+      ASSERT_TRUE(fetched.at(i)) << "range " << i << " is lost";
+    }
+  }
+
+protected:
+  ObDASTabletLoc tablets_[MAX_TABLET_CNT];
+  // the task each range is added with, by the position of the range
+  ObArray<int64_t> task_of_range_;
+};
+
+TEST_F(ObAdaptiveGranuleTest, split_factor)
+{
+  const uint64_t none = 0;
+  // only the unordered block granules without random task order are split
+  ASSERT_EQ(4, ObRandomGranuleSplitter::get_split_factor(false, ObGITaskSet::GI_RANDOM_NONE, none, 4));
+  ASSERT_EQ(1, ObRandomGranuleSplitter::get_split_factor(false, ObGITaskSet::GI_RANDOM_NONE, none, 1));
+  ASSERT_EQ(1, ObRandomGranuleSplitter::get_split_factor(false, ObGITaskSet::GI_RANDOM_NONE, none, 0));
+  ASSERT_EQ(1, ObRandomGranuleSplitter::get_split_factor(true, ObGITaskSet::GI_RANDOM_NONE, none, 4));
+  ASSERT_EQ(1, ObRandomGranuleSplitter::get_split_factor(false, ObGITaskSet::GI_RANDOM_TASK, none, 4));
+  ASSERT_EQ(1, ObRandomGranuleSplitter::get_split_factor(false, ObGITaskSet::GI_RANDOM_RANGE, none, 4));
+  ASSERT_EQ(1, ObRandomGranuleSplitter::get_split_factor(false, ObGITaskSet::GI_RANDOM_NONE,
+                                                         GI_ASC_ORDER, 4));
+  ASSERT_EQ(1, ObRandomGranuleSplitter::get_split_factor(false, ObGITaskSet::GI_RANDOM_NONE,
+                                                         GI_DESC_ORDER, 4));
+}
+
+TEST_F(ObAdaptiveGranuleTest, empty_pool)
+{
+  ObGITaskSet task_set;
+  ObArray<int64_t> fetch_sizes;
+  ASSERT_EQ(OB_SUCCESS, task_set.adjust_granule_size(4, 4));
+  ASSERT_EQ(0, task_set.gi_task_set_.count());
+  fetch_all(task_set, fetch_sizes);
+  ASSERT_EQ(0, fetch_sizes.count());
+
+  // a single task is kept
+  add_tasks(task_set, 0, 1, 3);
+  ASSERT_EQ(OB_SUCCESS, task_set.adjust_granule_size(4, 4));
+  ASSERT_EQ(3, task_set.gi_task_set_.count());
+  fetch_all(task_set, fetch_sizes);
+  ASSERT_EQ(1, fetch_sizes.count());
+}
+
+TEST_F(ObAdaptiveGranuleTest, nothing_to_merge)
+{
+  ObGITaskSet task_set;
+  ObArray<int64_t> fetch_sizes;
+  add_tasks(task_set, 0, 4);
+  add_tasks(task_set, 1, 4);
+  // no more than two tasks per worker, all of them are at the tail
+  ASSERT_EQ(OB_SUCCESS, task_set.adjust_granule_size(4, 4));
+  fetch_all(task_set, fetch_sizes);
+  ASSERT_EQ(8, fetch_sizes.count());
+}
+
+TEST_F(ObAdaptiveGranuleTest, disabled)
+{
+  ObGITaskSet task_set;
+  ObArray<int64_t> fetch_sizes;
+  add_tasks(task_set, 0, 64);
+  // a factor of 1 or no parallelism merges nothing
+  ASSERT_EQ(OB_SUCCESS, task_set.adjust_granule_size(2, 1));
+  ASSERT_EQ(OB_SUCCESS, task_set.adjust_granule_size(0, 4));
+  fetch_all(task_set, fetch_sizes);
+  ASSERT_EQ(64, fetch_sizes.count());
+}
+
+TEST_F(ObAdaptiveGranuleTest, shrink_towards_tail)
+{
+  const int64_t parallelism = 2;
+  const int64_t factor = 4;
+  ObGITaskSet task_set;
+  ObArray<int64_t> fetch_sizes;
+  add_tasks(task_set, 0, 32);
+  add_tasks(task_set, 1, 32);
+  ASSERT_EQ(OB_SUCCESS, task_set.adjust_granule_size(parallelism, factor));
+  ASSERT_EQ(0, task_set.cur_pos_);
+  fetch_all(task_set, fetch_sizes);
+  // factor tasks at the head, single tasks at the tail, never growing
+  ASSERT_EQ(22, fetch_sizes.count());
+  ASSERT_EQ(factor, fetch_sizes.at(0));
+  for (int64_t i = 1; i < fetch_sizes.count(); ++i) {
+    ASSERT_LE(fetch_sizes.at(i), fetch_sizes.at(i - 1)) << i;
+  }
+  for (int64_t i = fetch_sizes.count() - 2 * parallelism; i < fetch_sizes.count(); ++i) {
+    ASSERT_EQ(1, fetch_sizes.at(i)) << i;
+  }
+}
+
+TEST_F(ObAdaptiveGranuleTest, skewed_tablets)
+{
+  const int64_t parallelism = 2;
+  const int64_t factor = 8;
+  ObGITaskSet task_set;
+  ObArray<int64_t> fetch_sizes;
+  // small tablets around a large one, some tasks of several ranges
+  add_tasks(task_set, 0, 2);
+  add_tasks(task_set, 1, 50);
+  add_tasks(task_set, 1, 4, 3);
+  add_tasks(task_set, 2, 1);
+  add_tasks(task_set, 3, 3, 2);
+  ASSERT_EQ(OB_SUCCESS, task_set.adjust_granule_size(parallelism, factor));
+  fetch_all(task_set, fetch_sizes);
+  ASSERT_EQ(17, fetch_sizes.count());
+  // the small tablet at the head can not fill a large granule, the large
+  // tablet is merged up to the factor and shrinks from then on
+  ASSERT_EQ(2, fetch_sizes.at(0));
+  ASSERT_EQ(factor, fetch_sizes.at(1));
+  for (int64_t i = 2; i < fetch_sizes.count(); ++i) {
+    ASSERT_LE(fetch_sizes.at(i), fetch_sizes.at(i - 1)) << i;
+  }
+  for (int64_t i = fetch_sizes.count() - 2 * parallelism; i < fetch_sizes.count(); ++i) {
+    ASSERT_EQ(1, fetch_sizes.at(i)) << i;
+  }
+}
+
+TEST_F(ObAdaptiveGranuleTest, one_task_per_tablet)
+{
+  ObGITaskSet task_set;
+  ObArray<int64_t> fetch_sizes;
+  // every tablet holds a single task, there is nothing to merge with
+  for (int64_t i = 0; i < MAX_TABLET_CNT; ++i) {
+    add_tasks(task_set, i, 1, 2);
+  }
+  ASSERT_EQ(OB_SUCCESS, task_set.adjust_granule_size(1, 4));
+  fetch_all(task_set, fetch_sizes);
+  ASSERT_EQ(MAX_TABLET_CNT, fetch_sizes.count());
+}
+
+int main(int argc, char **argv)
+{
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
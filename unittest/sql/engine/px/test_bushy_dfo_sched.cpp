@@ -0,0 +1,281 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_EXE
+#include <gtest/gtest.h>
+#define private public
+#define protected public
+#include "sql/engine/px/ob_dfo_mgr.h"
+#include "share/config/ob_server_config.h"
+#include "lib/allocator/page_arena.h"
+#undef private
+#undef protected
+
+using namespace oceanbase;
+using namespace oceanbase::common;
+using namespace oceanbase::sql;
+
+// Walks DFO trees through ObDfoMgr::get_ready_dfos the way the scheduler does,
+// each DFO takes WORKER_CNT workers.
+class ObBushyDfoSchedTest : public ::testing::Test
+{
+public:
+  static const int64_t WORKER_CNT = 2;
+
+  ObBushyDfoSchedTest() : allocator_(ObModIds::TEST) {}
+  virtual ~ObBushyDfoSchedTest() = default;
+  virtual void SetUp() override
+  {
+    GCONF._px_enable_bushy_dfo_scheduling.set_value("True");
+  }
+  virtual void TearDown() override
+  {
+    GCONF._px_enable_bushy_dfo_scheduling.set_value("False");
+  }
+
+  static void link(ObDfo &parent, ObDfo &child)
+  {
+    ASSERT_EQ(OB_SUCCESS, parent.append_child_dfo(&child));
+    child.set_parent(&parent);
+  }
+
+  static void init_mgr(ObDfoMgr &dfo_mgr, ObDfo &qc, const int64_t admited_worker_count)
+  {
+    qc.set_root_dfo(true);
+    dfo_mgr.root_dfo_ = &qc;
+    dfo_mgr.admited_worker_count_ = admited_worker_count;
+    ASSERT_EQ(OB_SUCCESS, ObDfoSchedOrderGenerator::generate_sched_order(dfo_mgr));
+    for (int64_t i = 0; i < dfo_mgr.edges_.count(); ++i) {
+      dfo_mgr.edges_.at(i)->set_assigned_worker_count(WORKER_CNT);
+    }
+  }
+
+  // the scheduler starts every dfo it gets
+  static void schedule(const ObIArray<ObDfo *> &dfos)
+  {
+    for (int64_t i = 0; i < dfos.count(); ++i) {
+      dfos.at(i)->set_scheduled();
+    }
+  }
+
+  static void check_pair(const ObIArray<ObDfo *> &dfos, const ObDfo &child, const ObDfo &parent)
+  {
+    ASSERT_EQ(2, dfos.count());
+    ASSERT_EQ(&child, dfos.at(0));
+    ASSERT_EQ(&parent, dfos.at(1));
+  }
+
+protected:
+  ObArenaAllocator allocator_;
+};
+
+/*
+ *          qc
+ *          |
+ *          s
+ *          |
+ *          j
+ *        /   \
+ *       a     b
+ */
+TEST_F(ObBushyDfoSchedTest, probe_side_of_scheduled_parent)
+{
+  ObDfoMgr dfo_mgr(allocator_);
+  ObDfo qc(allocator_), s(allocator_), j(allocator_), a(allocator_), b(allocator_);
+  link(qc, s);
+  link(s, j);
+  link(j, a);
+  link(j, b);
+  init_mgr(dfo_mgr, qc, 3 * WORKER_CNT);
+
+  ObArray<ObDfo *> dfos;
+  ASSERT_EQ(OB_SUCCESS, dfo_mgr.get_ready_dfos(dfos));
+  check_pair(dfos, a, j);
+  schedule(dfos);
+  // the build side is running, the probe side fits into the admitted workers
+  ASSERT_EQ(OB_SUCCESS, dfo_mgr.get_ready_dfos(dfos));
+  check_pair(dfos, b, j);
+  ASSERT_TRUE(b.is_bushy_sched());
+  schedule(dfos);
+  ASSERT_EQ(OB_SUCCESS, dfo_mgr.get_ready_dfos(dfos));
+  ASSERT_EQ(0, dfos.count());
+
+  a.set_thread_finish(true);
+  b.set_thread_finish(true);
+  ASSERT_EQ(OB_SUCCESS, dfo_mgr.get_ready_dfos(dfos));
+  check_pair(dfos, j, s);
+  schedule(dfos);
+  j.set_thread_finish(true);
+  ASSERT_EQ(OB_SUCCESS, dfo_mgr.get_ready_dfos(dfos));
+  check_pair(dfos, s, qc);
+  s.set_thread_finish(true);
+  ASSERT_EQ(OB_ITER_END, dfo_mgr.get_ready_dfos(dfos));
+}
+
+TEST_F(ObBushyDfoSchedTest, disabled)
+{
+  GCONF._px_enable_bushy_dfo_scheduling.set_value("False");
+  ObDfoMgr dfo_mgr(allocator_);
+  ObDfo qc(allocator_), s(allocator_), j(allocator_), a(allocator_), b(allocator_);
+  link(qc, s);
+  link(s, j);
+  link(j, a);
+  link(j, b);
+  init_mgr(dfo_mgr, qc, 3 * WORKER_CNT);
+
+  ObArray<ObDfo *> dfos;
+  ASSERT_EQ(OB_SUCCESS, dfo_mgr.get_ready_dfos(dfos));
+  check_pair(dfos, a, j);
+  schedule(dfos);
+  ASSERT_EQ(OB_SUCCESS, dfo_mgr.get_ready_dfos(dfos));
+  ASSERT_EQ(0, dfos.count());
+  a.set_thread_finish(true);
+  ASSERT_EQ(OB_SUCCESS, dfo_mgr.get_ready_dfos(dfos));
+  check_pair(dfos, b, j);
+  ASSERT_FALSE(b.is_bushy_sched());
+}
+
+TEST_F(ObBushyDfoSchedTest, admited_worker_budget)
+{
+  ObDfoMgr dfo_mgr(allocator_);
+  ObDfo qc(allocator_), s(allocator_), j(allocator_), a(allocator_), b(allocator_);
+  link(qc, s);
+  link(s, j);
+  link(j, a);
+  link(j, b);
+  init_mgr(dfo_mgr, qc, 2 * WORKER_CNT);
+
+  ObArray<ObDfo *> dfos;
+  ASSERT_EQ(OB_SUCCESS, dfo_mgr.get_ready_dfos(dfos));
+  check_pair(dfos, a, j);
+  schedule(dfos);
+  // a and j take all the admitted workers
+  ASSERT_EQ(OB_SUCCESS, dfo_mgr.get_ready_dfos(dfos));
+  ASSERT_EQ(0, dfos.count());
+  a.set_thread_finish(true);
+  ASSERT_EQ(OB_SUCCESS, dfo_mgr.get_ready_dfos(dfos));
+  check_pair(dfos, b, j);
+  ASSERT_FALSE(b.is_bushy_sched());
+}
+
+/*
+ *            qc
+ *            |
+ *            s
+ *            |
+ *            j3
+ *         /      \
+ *       j1        j2
+ *      /  \      /  \
+ *     a    b    c    d
+ */
+TEST_F(ObBushyDfoSchedTest, unscheduled_parent)
+{
+  ObDfoMgr dfo_mgr(allocator_);
+  ObDfo qc(allocator_), s(allocator_), j3(allocator_), j1(allocator_), j2(allocator_);
+  ObDfo a(allocator_), b(allocator_), c(allocator_), d(allocator_);
+  link(qc, s);
+  link(s, j3);
+  link(j3, j1);
+  link(j3, j2);
+  link(j1, a);
+  link(j1, b);
+  link(j2, c);
+  link(j2, d);
+  init_mgr(dfo_mgr, qc, 100 * WORKER_CNT);
+
+  ObArray<ObDfo *> dfos;
+  ASSERT_EQ(OB_SUCCESS, dfo_mgr.get_ready_dfos(dfos));
+  check_pair(dfos, a, j1);
+  schedule(dfos);
+  ASSERT_EQ(OB_SUCCESS, dfo_mgr.get_ready_dfos(dfos));
+  check_pair(dfos, b, j1);
+  schedule(dfos);
+  // j3 running does not let c start ahead of j2's own schedule
+  j3.set_scheduled();
+  ASSERT_EQ(OB_SUCCESS, dfo_mgr.get_ready_dfos(dfos));
+  ASSERT_EQ(0, dfos.count());
+  ASSERT_FALSE(c.is_active());
+  ASSERT_FALSE(d.is_active());
+}
+
+/*
+ *          qc
+ *          |
+ *          s
+ *          |
+ *          p2 (earlier sched)
+ *        /    \
+ *      p1      g
+ *     /  \
+ *    e    f
+ */
+TEST_F(ObBushyDfoSchedTest, normal_walk_waits_for_bushy_dfo)
+{
+  ObDfoMgr dfo_mgr(allocator_);
+  ObDfo qc(allocator_), s(allocator_), p2(allocator_), p1(allocator_);
+  ObDfo e(allocator_), f(allocator_), g(allocator_);
+  link(qc, s);
+  link(s, p2);
+  link(p2, p1);
+  link(p2, g);
+  link(p1, e);
+  link(p1, f);
+  init_mgr(dfo_mgr, qc, 3 * WORKER_CNT);
+  p2.set_earlier_sched(true);
+
+  ObArray<ObDfo *> dfos;
+  ASSERT_EQ(OB_SUCCESS, dfo_mgr.get_ready_dfos(dfos));
+  check_pair(dfos, e, p1);
+  schedule(dfos);
+  // f was started by the bushy pass and holds the last admitted workers
+  f.set_active();
+  f.set_bushy_sched();
+  f.set_scheduled();
+  ASSERT_EQ(OB_SUCCESS, dfo_mgr.get_ready_dfos(dfos));
+  ASSERT_EQ(0, dfos.count());
+  ASSERT_FALSE(p1.is_active());
+  // the depth 3 pair is scheduled once the bushy dfo returns its workers
+  f.set_thread_finish(true);
+  ASSERT_EQ(OB_SUCCESS, dfo_mgr.get_ready_dfos(dfos));
+  check_pair(dfos, p1, p2);
+}
+
+TEST_F(ObBushyDfoSchedTest, normal_walk_keeps_old_behavior)
+{
+  ObDfoMgr dfo_mgr(allocator_);
+  ObDfo qc(allocator_), s(allocator_), p2(allocator_), p1(allocator_);
+  ObDfo e(allocator_), f(allocator_), g(allocator_);
+  link(qc, s);
+  link(s, p2);
+  link(p2, p1);
+  link(p2, g);
+  link(p1, e);
+  link(p1, f);
+  // not even e, p1 and p2 fit, bushy dfos are not the reason to wait
+  init_mgr(dfo_mgr, qc, 2 * WORKER_CNT);
+  p2.set_earlier_sched(true);
+
+  ObArray<ObDfo *> dfos;
+  ASSERT_EQ(OB_SUCCESS, dfo_mgr.get_ready_dfos(dfos));
+  check_pair(dfos, e, p1);
+  schedule(dfos);
+  ASSERT_EQ(OB_SUCCESS, dfo_mgr.get_ready_dfos(dfos));
+  check_pair(dfos, p1, p2);
+}
+
+int main(int argc, char **argv)
+{
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
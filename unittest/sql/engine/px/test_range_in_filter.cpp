@@ -0,0 +1,232 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_EXE
+#include <gtest/gtest.h>
+
+#include "sql/engine/px/ob_px_bloom_filter.h"
+#include "lib/allocator/page_arena.h"
+
+using namespace oceanbase;
+using namespace oceanbase::common;
+using namespace oceanbase::sql;
+
+class ObPxRangeInFilterTest : public ::testing::Test
+{
+public:
+  ObPxRangeInFilterTest() = default;
+  virtual ~ObPxRangeInFilterTest() = default;
+  virtual void SetUp() {};
+  virtual void TearDown() {};
+
+  static void check_same(const ObPxRangeInFilter &l, const ObPxRangeInFilter &r)
+  {
+    ASSERT_EQ(l.is_valid(), r.is_valid());
+    ASSERT_EQ(l.is_disabled(), r.is_disabled());
+    ASSERT_EQ(l.is_unsigned(), r.is_unsigned());
+    ASSERT_EQ(l.get_in_cnt(), r.get_in_cnt());
+    if (l.is_valid()) {
+      ASSERT_EQ(l.get_min(), r.get_min());
+      ASSERT_EQ(l.get_max(), r.get_max());
+      for (int64_t i = 0; l.has_in_list() && i < l.get_in_cnt(); ++i) {
+        ASSERT_EQ(l.get_in_value(i), r.get_in_value(i));
+      }
+    }
+  }
+
+  static void round_trip(const ObPxRangeInFilter &filter)
+  {
+    char buf[4096];
+    int64_t pos = 0;
+    ObPxRangeInFilter decoded;
+    ASSERT_EQ(OB_SUCCESS, filter.serialize(buf, sizeof(buf), pos));
+    ASSERT_EQ(filter.get_serialize_size(), pos);
+    const int64_t data_len = pos;
+    pos = 0;
+    ASSERT_EQ(OB_SUCCESS, decoded.deserialize(buf, data_len, pos));
+    ASSERT_EQ(data_len, pos);
+    check_same(filter, decoded);
+  }
+
+private:
+  // disallow copy
+  ObPxRangeInFilterTest(const ObPxRangeInFilterTest &other);
+  ObPxRangeInFilterTest& operator=(const ObPxRangeInFilterTest &other);
+};
+
+TEST_F(ObPxRangeInFilterTest, empty_and_disabled)
+{
+  ObPxRangeInFilter filter;
+  ASSERT_FALSE(filter.is_valid());
+  ASSERT_FALSE(filter.is_disabled());
+  // not valid filters pass everything
+  ASSERT_TRUE(filter.might_contain(0));
+  ASSERT_TRUE(filter.might_contain(INT64_MIN));
+  filter.put(10);
+  ASSERT_TRUE(filter.is_valid());
+  ASSERT_FALSE(filter.might_contain(11));
+  filter.set_disabled();
+  ASSERT_FALSE(filter.is_valid());
+  ASSERT_TRUE(filter.might_contain(11));
+  // no way back from disabled
+  filter.put(11);
+  ASSERT_TRUE(filter.is_disabled());
+  round_trip(filter);
+}
+
+TEST_F(ObPxRangeInFilterTest, in_list)
+{
+  ObPxRangeInFilter filter;
+  const int64_t values[] = { 5, -3, 100, 5, 42, -3, 0 };
+  for (int64_t i = 0; i < ARRAYSIZEOF(values); ++i) {
+    filter.put(values[i]);
+  }
+  ASSERT_TRUE(filter.is_valid());
+  ASSERT_TRUE(filter.has_in_list());
+  ASSERT_EQ(5, filter.get_in_cnt());
+  ASSERT_EQ(-3, filter.get_min());
+  ASSERT_EQ(100, filter.get_max());
+  for (int64_t i = 1; i < filter.get_in_cnt(); ++i) {
+    ASSERT_LT(filter.get_in_value(i - 1), filter.get_in_value(i));
+  }
+  for (int64_t i = 0; i < ARRAYSIZEOF(values); ++i) {
+    ASSERT_TRUE(filter.might_contain(values[i]));
+  }
+  ASSERT_FALSE(filter.might_contain(-4));
+  ASSERT_FALSE(filter.might_contain(1));
+  ASSERT_FALSE(filter.might_contain(99));
+  ASSERT_FALSE(filter.might_contain(101));
+  round_trip(filter);
+}
+
+TEST_F(ObPxRangeInFilterTest, range_only)
+{
+  ObPxRangeInFilter filter;
+  for (int64_t i = 0; i <= ObPxRangeInFilter::MAX_IN_CNT; ++i) {
+    filter.put(i * 2);
+  }
+  ASSERT_TRUE(filter.is_valid());
+  ASSERT_FALSE(filter.has_in_list());
+  ASSERT_EQ(0, filter.get_min());
+  ASSERT_EQ(ObPxRangeInFilter::MAX_IN_CNT * 2, filter.get_max());
+  // the range keeps the values missed by the in-list
+  ASSERT_TRUE(filter.might_contain(1));
+  ASSERT_TRUE(filter.might_contain(ObPxRangeInFilter::MAX_IN_CNT * 2));
+  ASSERT_FALSE(filter.might_contain(-1));
+  ASSERT_FALSE(filter.might_contain(ObPxRangeInFilter::MAX_IN_CNT * 2 + 1));
+  // min and max keep moving after the in-list overflowed
+  filter.put(-10);
+  filter.put(1000);
+  ASSERT_EQ(-10, filter.get_min());
+  ASSERT_EQ(1000, filter.get_max());
+  round_trip(filter);
+}
+
+TEST_F(ObPxRangeInFilterTest, unsigned_key)
+{
+  ObPxRangeInFilter filter;
+  filter.set_unsigned(true);
+  filter.put(1);
+  filter.put(static_cast<int64_t>(UINT64_MAX));
+  ASSERT_EQ(1, filter.get_min());
+  ASSERT_EQ(UINT64_MAX, static_cast<uint64_t>(filter.get_max()));
+  ASSERT_TRUE(filter.might_contain(static_cast<int64_t>(UINT64_MAX)));
+  ASSERT_FALSE(filter.might_contain(0));
+  ASSERT_FALSE(filter.might_contain(2));
+  round_trip(filter);
+}
+
+TEST_F(ObPxRangeInFilterTest, merge)
+{
+  ObPxRangeInFilter empty;
+  ObPxRangeInFilter l;
+  ObPxRangeInFilter r;
+  l.put(1);
+  l.put(3);
+  r.put(2);
+  r.put(8);
+  // empty is the identity of merge
+  ObPxRangeInFilter merged;
+  merged.merge(l);
+  merged.merge(empty);
+  check_same(l, merged);
+  merged.merge(r);
+  ASSERT_TRUE(merged.is_valid());
+  ASSERT_EQ(4, merged.get_in_cnt());
+  ASSERT_EQ(1, merged.get_min());
+  ASSERT_EQ(8, merged.get_max());
+  ASSERT_FALSE(merged.might_contain(4));
+  // an overflowed side drops the in-list and keeps the range
+  ObPxRangeInFilter wide;
+  for (int64_t i = 0; i <= ObPxRangeInFilter::MAX_IN_CNT; ++i) {
+    wide.put(100 + i);
+  }
+  merged.merge(wide);
+  ASSERT_FALSE(merged.has_in_list());
+  ASSERT_EQ(1, merged.get_min());
+  ASSERT_EQ(100 + ObPxRangeInFilter::MAX_IN_CNT, merged.get_max());
+  ASSERT_TRUE(merged.might_contain(50));
+  // in-lists of both sides overflow together
+  ObPxRangeInFilter a;
+  ObPxRangeInFilter b;
+  for (int64_t i = 0; i < ObPxRangeInFilter::MAX_IN_CNT; ++i) {
+    a.put(i);
+    b.put(-i - 1);
+  }
+  a.merge(b);
+  ASSERT_FALSE(a.has_in_list());
+  ASSERT_EQ(-ObPxRangeInFilter::MAX_IN_CNT, a.get_min());
+  ASSERT_EQ(ObPxRangeInFilter::MAX_IN_CNT - 1, a.get_max());
+  // signed and unsigned keys can not be merged
+  ObPxRangeInFilter u;
+  u.set_unsigned(true);
+  u.put(5);
+  l.merge(u);
+  ASSERT_TRUE(l.is_disabled());
+  // disabled wins on both sides
+  ObPxRangeInFilter d;
+  d.set_disabled();
+  r.merge(d);
+  ASSERT_TRUE(r.is_disabled());
+  d.merge(wide);
+  ASSERT_TRUE(d.is_disabled());
+}
+
+TEST_F(ObPxRangeInFilterTest, bloom_filter_serialize)
+{
+  ObArenaAllocator allocator;
+  ObPxBloomFilter bf;
+  ASSERT_EQ(OB_SUCCESS, bf.init(1000, allocator));
+  bf.set_begin_idx(0);
+  bf.set_end_idx(bf.get_bits_array_length() - 1);
+  ObPxRangeInFilter range_filter;
+  range_filter.put(7);
+  range_filter.put(-7);
+  bf.merge_range_filter(range_filter);
+  const int64_t buf_len = bf.get_serialize_size();
+  char *buf = static_cast<char *>(allocator.alloc(buf_len));
+  ASSERT_TRUE(NULL != buf);
+  int64_t pos = 0;
+  ASSERT_EQ(OB_SUCCESS, bf.serialize(buf, buf_len, pos));
+  ASSERT_EQ(buf_len, pos);
+  ObPxBloomFilter decoded;
+  pos = 0;
+  ASSERT_EQ(OB_SUCCESS, decoded.deserialize(buf, buf_len, pos));
+  check_same(range_filter, decoded.get_range_filter());
+}
+
+int main(int argc, char **argv)
+{
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc,argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,252 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_EXE
+#include <gtest/gtest.h>
+#include "sql/engine/px/datahub/components/ob_dh_skew_key.h"
+
+using namespace oceanbase;
+using namespace oceanbase::common;
+using namespace oceanbase::sql;
+
+static const uint64_t OP_ID = 7;
+// percent
+static const int64_t MIN_FREQ = 10;
+
+class ObSkewKeyDhTest : public ::testing::Test
+{
+public:
+  ObSkewKeyDhTest() = default;
+  virtual ~ObSkewKeyDhTest() = default;
+
+  static void make_build_piece(const int64_t sample_cnt, ObSkewKeyPieceMsg &piece)
+  {
+    piece.reset();
+    piece.op_id_ = OP_ID;
+    piece.is_build_ = true;
+    piece.sample_cnt_ = sample_cnt;
+  }
+
+  static void add_key(const uint64_t hash_val, const int64_t cnt, ObSkewKeyPieceMsg &piece)
+  {
+    ASSERT_EQ(OB_SUCCESS, piece.keys_.push_back(ObSkewKeyCount(hash_val, cnt)));
+  }
+
+  static void check_popular(const ObSkewKeyWholeMsg &whole_msg,
+                            const uint64_t *hash_vals, const int64_t cnt)
+  {
+    ASSERT_EQ(OP_ID, whole_msg.op_id_);
+    ASSERT_EQ(cnt, whole_msg.popular_values_hash_.count());
+    for (int64_t i = 0; i < cnt; ++i) {
+      ASSERT_EQ(hash_vals[i], whole_msg.popular_values_hash_.at(i)) << i;
+    }
+  }
+};
+
+TEST_F(ObSkewKeyDhTest, serialize)
+{
+  char buf[4096];
+  int64_t pos = 0;
+  ObSkewKeyPieceMsg piece;
+  ObSkewKeyPieceMsg decoded_piece;
+  make_build_piece(1000, piece);
+  piece.source_dfo_id_ = 3;
+  piece.thread_id_ = 11;
+  add_key(UINT64_MAX, 500, piece);
+  add_key(0, 20, piece);
+  add_key(42, 1, piece);
+  ASSERT_EQ(OB_SUCCESS, piece.serialize(buf, sizeof(buf), pos));
+  ASSERT_EQ(piece.get_serialize_size(), pos);
+  int64_t data_len = pos;
+  pos = 0;
+  ASSERT_EQ(OB_SUCCESS, decoded_piece.deserialize(buf, data_len, pos));
+  ASSERT_EQ(data_len, pos);
+  ASSERT_EQ(OP_ID, decoded_piece.op_id_);
+  ASSERT_EQ(3U, decoded_piece.source_dfo_id_);
+  ASSERT_TRUE(decoded_piece.is_build_);
+  ASSERT_EQ(1000, decoded_piece.sample_cnt_);
+  ASSERT_EQ(piece.keys_.count(), decoded_piece.keys_.count());
+  for (int64_t i = 0; i < piece.keys_.count(); ++i) {
+    ASSERT_EQ(piece.keys_.at(i).hash_val_, decoded_piece.keys_.at(i).hash_val_);
+    ASSERT_EQ(piece.keys_.at(i).cnt_, decoded_piece.keys_.at(i).cnt_);
+  }
+
+  // the probe side reports no key
+  piece.reset();
+  piece.op_id_ = OP_ID;
+  piece.is_build_ = false;
+  pos = 0;
+  ASSERT_EQ(OB_SUCCESS, piece.serialize(buf, sizeof(buf), pos));
+  data_len = pos;
+  pos = 0;
+  ASSERT_EQ(OB_SUCCESS, decoded_piece.deserialize(buf, data_len, pos));
+  ASSERT_FALSE(decoded_piece.is_build_);
+  ASSERT_EQ(0, decoded_piece.sample_cnt_);
+  ASSERT_EQ(0, decoded_piece.keys_.count());
+
+  ObSkewKeyWholeMsg whole_msg;
+  ObSkewKeyWholeMsg decoded_whole;
+  whole_msg.op_id_ = OP_ID;
+  const uint64_t hash_vals[] = {UINT64_MAX, 0, 42};
+  for (int64_t i = 0; i < 3; ++i) {
+    ASSERT_EQ(OB_SUCCESS, whole_msg.popular_values_hash_.push_back(hash_vals[i]));
+  }
+  pos = 0;
+  ASSERT_EQ(OB_SUCCESS, whole_msg.serialize(buf, sizeof(buf), pos));
+  ASSERT_EQ(whole_msg.get_serialize_size(), pos);
+  data_len = pos;
+  pos = 0;
+  ASSERT_EQ(OB_SUCCESS, decoded_whole.deserialize(buf, data_len, pos));
+  ASSERT_EQ(data_len, pos);
+  check_popular(decoded_whole, hash_vals, 3);
+
+  // an empty set goes through as well
+  whole_msg.reset();
+  pos = 0;
+  ASSERT_EQ(OB_SUCCESS, whole_msg.serialize(buf, sizeof(buf), pos));
+  data_len = pos;
+  pos = 0;
+  ASSERT_EQ(OB_SUCCESS, decoded_whole.deserialize(buf, data_len, pos));
+  check_popular(decoded_whole, hash_vals, 0);
+}
+
+TEST_F(ObSkewKeyDhTest, merge_pieces)
+{
+  ObSkewKeyPieceMsgCtx ctx(OP_ID, 0, INT64_MAX, MIN_FREQ);
+  ctx.build_task_cnt_ = 3;
+  ObSkewKeyPieceMsg piece;
+  // the same key reported by several workers is counted once, with the sum of its counts
+  make_build_piece(400, piece);
+  add_key(1, 30, piece);
+  add_key(2, 90, piece);
+  ASSERT_EQ(OB_SUCCESS, ctx.merge_piece(piece));
+  make_build_piece(400, piece);
+  add_key(1, 50, piece);
+  add_key(3, 20, piece);
+  ASSERT_EQ(OB_SUCCESS, ctx.merge_piece(piece));
+  // a worker without a sample
+  make_build_piece(0, piece);
+  ASSERT_EQ(OB_SUCCESS, ctx.merge_piece(piece));
+  ASSERT_EQ(3, ctx.build_received_);
+  ASSERT_EQ(800, ctx.sample_cnt_);
+  ASSERT_EQ(4, ctx.keys_.count());
+  // no more build pieces than build workers
+  make_build_piece(400, piece);
+  ASSERT_EQ(OB_ERR_UNEXPECTED, ctx.merge_piece(piece));
+  ASSERT_EQ(3, ctx.build_received_);
+  ASSERT_EQ(800, ctx.sample_cnt_);
+
+  // 80 of 800 reaches 10%, 90 goes first, 20 does not
+  ASSERT_EQ(OB_SUCCESS, ctx.decide_popular_values());
+  ASSERT_TRUE(ctx.decided_);
+  const uint64_t popular[] = {2, 1};
+  check_popular(ctx.whole_msg_, popular, 2);
+
+  // probe pieces are only counted
+  ctx.probe_task_cnt_ = 2;
+  piece.reset();
+  piece.op_id_ = OP_ID;
+  piece.is_build_ = false;
+  ASSERT_EQ(OB_SUCCESS, ctx.merge_piece(piece));
+  ASSERT_EQ(OB_SUCCESS, ctx.merge_piece(piece));
+  ASSERT_EQ(OB_ERR_UNEXPECTED, ctx.merge_piece(piece));
+  ASSERT_EQ(2, ctx.probe_received_);
+  ASSERT_EQ(800, ctx.sample_cnt_);
+}
+
+TEST_F(ObSkewKeyDhTest, decide_popular_values)
+{
+  ObSkewKeyPieceMsg piece;
+  {
+    // too few rows to tell
+    ObSkewKeyPieceMsgCtx ctx(OP_ID, 0, INT64_MAX, MIN_FREQ);
+    ctx.build_task_cnt_ = 1;
+    make_build_piece(ObSkewKeyPieceMsgCtx::MIN_SAMPLE_ROW_CNT - 1, piece);
+    add_key(1, ObSkewKeyPieceMsgCtx::MIN_SAMPLE_ROW_CNT - 1, piece);
+    ASSERT_EQ(OB_SUCCESS, ctx.merge_piece(piece));
+    ASSERT_EQ(OB_SUCCESS, ctx.decide_popular_values());
+    ASSERT_TRUE(ctx.decided_);
+    check_popular(ctx.whole_msg_, NULL, 0);
+  }
+  {
+    // a key is popular from exactly min_freq on
+    ObSkewKeyPieceMsgCtx ctx(OP_ID, 0, INT64_MAX, MIN_FREQ);
+    ctx.build_task_cnt_ = 1;
+    make_build_piece(1000, piece);
+    add_key(5, 99, piece);
+    add_key(6, 100, piece);
+    add_key(7, 101, piece);
+    ASSERT_EQ(OB_SUCCESS, ctx.merge_piece(piece));
+    ASSERT_EQ(OB_SUCCESS, ctx.decide_popular_values());
+    const uint64_t popular[] = {7, 6};
+    check_popular(ctx.whole_msg_, popular, 2);
+  }
+  {
+    // no more than MAX_POPULAR_VALUE_CNT keys, the most frequent ones
+    const int64_t key_cnt = ObSkewKeyPieceMsgCtx::MAX_POPULAR_VALUE_CNT + 4;
+    ObSkewKeyPieceMsgCtx ctx(OP_ID, 0, INT64_MAX, 1);
+    ctx.build_task_cnt_ = 2;
+    uint64_t popular[key_cnt];
+    for (int64_t w = 0; w < 2; ++w) {
+      make_build_piece(150, piece);
+      for (int64_t i = 0; i < key_cnt / 2; ++i) {
+        const int64_t key = w * key_cnt / 2 + i;
+        add_key(key, 10 + key, piece);
+      }
+      ASSERT_EQ(OB_SUCCESS, ctx.merge_piece(piece));
+    }
+    for (int64_t i = 0; i < key_cnt; ++i) {
+      popular[i] = key_cnt - 1 - i;
+    }
+    ASSERT_EQ(OB_SUCCESS, ctx.decide_popular_values());
+    check_popular(ctx.whole_msg_, popular, ObSkewKeyPieceMsgCtx::MAX_POPULAR_VALUE_CNT);
+  }
+  {
+    // nothing reported
+    ObSkewKeyPieceMsgCtx ctx(OP_ID, 0, INT64_MAX, MIN_FREQ);
+    ctx.build_task_cnt_ = 1;
+    make_build_piece(1000, piece);
+    ASSERT_EQ(OB_SUCCESS, ctx.merge_piece(piece));
+    ASSERT_EQ(OB_SUCCESS, ctx.decide_popular_values());
+    ASSERT_TRUE(ctx.decided_);
+    check_popular(ctx.whole_msg_, NULL, 0);
+  }
+}
+
+TEST_F(ObSkewKeyDhTest, probe_whole_msg)
+{
+  ObSkewKeyPieceMsgCtx ctx(OP_ID, 0, INT64_MAX, MIN_FREQ);
+  ObSkewKeyPieceMsg piece;
+  ObSkewKeyWholeMsg probe_msg;
+  ctx.build_task_cnt_ = 1;
+  make_build_piece(1000, piece);
+  add_key(9, 500, piece);
+  ASSERT_EQ(OB_SUCCESS, ctx.merge_piece(piece));
+  // the build side has not decided, the probe side gets an empty set and
+  // falls back to plain hash distribution
+  ASSERT_EQ(OB_SUCCESS, probe_msg.popular_values_hash_.push_back(1));
+  ASSERT_EQ(OB_SUCCESS, ctx.get_probe_whole_msg(probe_msg));
+  check_popular(probe_msg, NULL, 0);
+  // once decided, the probe side gets the build side set
+  ASSERT_EQ(OB_SUCCESS, ctx.decide_popular_values());
+  ASSERT_EQ(OB_SUCCESS, ctx.get_probe_whole_msg(probe_msg));
+  const uint64_t popular[] = {9};
+  check_popular(probe_msg, popular, 1);
+  check_popular(ctx.whole_msg_, popular, 1);
+}
+
+int main(int argc, char **argv)
+{
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -188,6 +188,122 @@ TEST_F(TestPlanCacheValue, basic)
   plan_cache_value->reset();
   pcv_set.free_pcv(plan_cache_value);
 }
+void add_param_info(ObPlanSet &plan_set, const bool check_type,
+                    const ObObjType type, const ObCollationType cs_type)
+{
+  ObParamInfo param_info;
+  param_info.flag_.need_to_check_type_ = check_type;
+  param_info.type_ = type;
+  param_info.col_type_ = cs_type;
+  ASSERT_EQ(OB_SUCCESS, plan_set.params_info_.push_back(param_info));
+}
+
+void init_param_infos(ObPlanSet &plan_set, ObPlanCacheCtx &pc_ctx,
+                      const ObObjType type0, const ObObjType type1)
+{
+  add_param_info(plan_set, true, type0, CS_TYPE_UTF8MB4_GENERAL_CI);
+  add_param_info(plan_set, true, type1, CS_TYPE_UTF8MB4_GENERAL_CI);
+  // pre-calc result, not part of the signature
+  add_param_info(plan_set, false, ObIntType, CS_TYPE_BINARY);
+  ASSERT_EQ(OB_SUCCESS, plan_set.init_param_type_sig(pc_ctx));
+}
+
+TEST_F(TestPlanCacheValue, sig_index)
+{
+  ObArenaAllocator allocator(ObModIds::TEST);
+  ObSQLSessionInfo session;
+  ObExecContext exec_ctx(allocator);
+  ObSqlCtx sql_ctx;
+  sql_ctx.session_info_ = &session;
+  ASSERT_EQ(OB_SUCCESS, exec_ctx.create_physical_plan_ctx());
+  exec_ctx.set_my_session(&session);
+  exec_ctx.set_sql_ctx(&sql_ctx);
+  exec_ctx.get_physical_plan_ctx()->set_original_param_cnt(2);
+  ObString sql = ObString::make_string("select * from t1 where c1 = ? and c2 = ?");
+  ObPlanCacheCtx pc_ctx(sql, PC_TEXT_MODE, allocator, sql_ctx, exec_ctx, OB_SYS_TENANT_ID);
+
+  ObSqlPlanSet int_int;
+  ObSqlPlanSet int_varchar;
+  ObSqlPlanSet int_int_2;
+  init_param_infos(int_int, pc_ctx, ObIntType, ObIntType);
+  init_param_infos(int_varchar, pc_ctx, ObIntType, ObVarcharType);
+  init_param_infos(int_int_2, pc_ctx, ObIntType, ObIntType);
+  ASSERT_EQ(2, int_int.get_sig_param_cnt());
+  ASSERT_TRUE(int_int.has_same_sig_params(int_varchar));
+  ASSERT_NE(int_int.get_param_type_sig(), int_varchar.get_param_type_sig());
+  ASSERT_EQ(int_int.get_param_type_sig(), int_int_2.get_param_type_sig());
+
+  // the signature of a request equals the one of the plan set it matches by type
+  ParamStore params((ObWrapperAllocator(allocator)));
+  ObObjParam param;
+  param.set_int(1);
+  param.set_param_meta();
+  ASSERT_EQ(OB_SUCCESS, params.push_back(param));
+  ASSERT_EQ(OB_SUCCESS, params.push_back(param));
+  uint64_t sig = 0;
+  ASSERT_EQ(OB_SUCCESS, int_int.calc_param_type_sig(params, OB_INVALID_INDEX, sig));
+  ASSERT_EQ(int_int.get_param_type_sig(), sig);
+  params.at(1).set_varchar("1");
+  params.at(1).set_collation_type(CS_TYPE_UTF8MB4_GENERAL_CI);
+  params.at(1).set_param_meta();
+  ASSERT_EQ(OB_SUCCESS, int_int.calc_param_type_sig(params, OB_INVALID_INDEX, sig));
+  ASSERT_EQ(int_varchar.get_param_type_sig(), sig);
+  // the outline param index is part of the signature
+  ASSERT_EQ(OB_SUCCESS, int_int.calc_param_type_sig(params, 0, sig));
+  ASSERT_NE(int_varchar.get_param_type_sig(), sig);
+  // a request with another param count can not use the signature
+  ASSERT_EQ(OB_SUCCESS, params.push_back(param));
+  ASSERT_EQ(OB_INVALID_ARGUMENT, int_int.calc_param_type_sig(params, OB_INVALID_INDEX, sig));
+
+  // plan sets of the same signature are chained in the order of plan_sets_
+  ObPlanCacheValue pcv;
+  ObPlanSet *sets[] = { &int_int, &int_varchar, &int_int_2 };
+  for (int64_t i = 0; i < ARRAYSIZEOF(sets); ++i) {
+    ASSERT_TRUE(pcv.plan_sets_.add_last(sets[i]));
+    pcv.add_plan_set_to_sig_index(*sets[i]);
+  }
+  ASSERT_TRUE(pcv.use_sig_index_);
+  const int64_t bucket_cnt = ObPlanCacheValue::PLAN_SET_SIG_BUCKET_CNT;
+  ObPlanSet *head = pcv.sig_bucket_heads_[int_int.get_param_type_sig() % bucket_cnt];
+  ASSERT_EQ(&int_int, head);
+  while (head->next_same_sig_ != NULL && head->next_same_sig_->get_param_type_sig()
+                                         != int_int.get_param_type_sig()) {
+    head = head->next_same_sig_;
+  }
+  ASSERT_EQ(&int_int_2, head->next_same_sig_);
+  ASSERT_EQ(NULL, int_int_2.next_same_sig_);
+  head = pcv.sig_bucket_heads_[int_varchar.get_param_type_sig() % bucket_cnt];
+  while (head != &int_varchar && head != NULL) {
+    head = head->next_same_sig_;
+  }
+  ASSERT_EQ(&int_varchar, head);
+
+  // a plan set checking the types of other params turns the index off
+  ObSqlPlanSet varchar_only;
+  add_param_info(varchar_only, false, ObIntType, CS_TYPE_BINARY);
+  add_param_info(varchar_only, true, ObVarcharType, CS_TYPE_UTF8MB4_GENERAL_CI);
+  ASSERT_EQ(OB_SUCCESS, varchar_only.init_param_type_sig(pc_ctx));
+  ASSERT_FALSE(varchar_only.has_same_sig_params(int_int));
+  ASSERT_TRUE(pcv.plan_sets_.add_last(&varchar_only));
+  pcv.add_plan_set_to_sig_index(varchar_only);
+  ASSERT_FALSE(pcv.use_sig_index_);
+
+  // a plan set without signature keeps the index off from the start
+  ObPlanCacheValue pcv_no_sig;
+  ObSqlPlanSet no_sig;
+  add_param_info(no_sig, true, ObIntType, CS_TYPE_BINARY);
+  ASSERT_EQ(OB_SUCCESS, no_sig.init_param_type_sig(pc_ctx));
+  ASSERT_EQ(OB_INVALID_COUNT, no_sig.get_sig_param_cnt());
+  ASSERT_TRUE(pcv_no_sig.plan_sets_.add_last(&no_sig));
+  pcv_no_sig.add_plan_set_to_sig_index(no_sig);
+  ASSERT_FALSE(pcv_no_sig.use_sig_index_);
+
+  // the plan sets live on the stack, unlink them before the values are reset
+  pcv.plan_sets_.clear();
+  pcv.reset_sig_index();
+  pcv_no_sig.plan_sets_.clear();
+  pcv_no_sig.reset_sig_index();
+}
 }
 
 int main(int argc, char **argv)
@@ -0,0 +1,213 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_PC
+#include <gtest/gtest.h>
+#define private public
+#define protected public
+#include "sql/plan_cache/ob_raw_sql_cache.h"
+#include "lib/allocator/page_arena.h"
+#undef private
+#undef protected
+
+using namespace oceanbase;
+using namespace oceanbase::common;
+using namespace oceanbase::sql;
+
+class ObRawSqlCacheTest : public ::testing::Test
+{
+public:
+  ObRawSqlCacheTest() : allocator_(ObModIds::TEST) {}
+  virtual ~ObRawSqlCacheTest() = default;
+  virtual void SetUp() override
+  {
+    key_.tenant_id_ = 1001;
+    key_.sql_mode_ = DEFAULT_MYSQL_MODE;
+    key_.conn_coll_ = CS_TYPE_UTF8MB4_GENERAL_CI;
+    key_.is_oracle_mode_ = false;
+    key_.enable_batched_multi_stmt_ = false;
+    key_.enable_fast_parser_ = true;
+  }
+
+  void check_hit(ObRawSqlCache &cache, const ObRawSqlCacheKey &key,
+                 const ObString &raw_sql, const ObString &param_sql)
+  {
+    ObString got;
+    bool found = false;
+    ASSERT_EQ(OB_SUCCESS, cache.get(key, raw_sql, allocator_, got, found));
+    ASSERT_TRUE(found);
+    ASSERT_EQ(param_sql, got);
+  }
+
+  void check_miss(ObRawSqlCache &cache, const ObRawSqlCacheKey &key, const ObString &raw_sql)
+  {
+    ObString got;
+    bool found = true;
+    ASSERT_EQ(OB_SUCCESS, cache.get(key, raw_sql, allocator_, got, found));
+    ASSERT_FALSE(found);
+    ASSERT_TRUE(got.empty());
+  }
+
+  static int64_t slot_of(const ObRawSqlCacheKey &key, const ObString &raw_sql)
+  {
+    return key.hash(raw_sql) % ObRawSqlCache::SLOT_CNT;
+  }
+
+protected:
+  ObArenaAllocator allocator_;
+  ObRawSqlCacheKey key_;
+};
+
+TEST_F(ObRawSqlCacheTest, hit_and_miss)
+{
+  ObRawSqlCache cache;
+  const ObString raw_sql("select * from t1 where c1 = 1");
+  const ObString param_sql("select * from t1 where c1 = ?");
+  check_miss(cache, key_, raw_sql);
+  ASSERT_EQ(OB_SUCCESS, cache.put(key_, raw_sql, param_sql));
+  check_hit(cache, key_, raw_sql, param_sql);
+
+  // the param sql is copied out of the slot
+  ObString got;
+  bool found = false;
+  ASSERT_EQ(OB_SUCCESS, cache.get(key_, raw_sql, allocator_, got, found));
+  ASSERT_TRUE(found);
+  const ObRawSqlCache::Slot &slot = cache.slots_[slot_of(key_, raw_sql)];
+  ASSERT_TRUE(got.ptr() < slot.buf_ || got.ptr() >= slot.buf_ + slot.buf_size_);
+
+  // only byte identical statements hit
+  check_miss(cache, key_, ObString("select * from t1 where c1 = 2"));
+  check_miss(cache, key_, ObString("SELECT * from t1 where c1 = 1"));
+  check_miss(cache, key_, ObString("select * from t1 where c1 = 1 "));
+  check_miss(cache, key_, ObString("select * from t1 where c1 ="));
+
+  // a put of the same statement replaces the param sql
+  const ObString other_param_sql("select * from t1 where c1 = ? ");
+  ASSERT_EQ(OB_SUCCESS, cache.put(key_, raw_sql, other_param_sql));
+  check_hit(cache, key_, raw_sql, other_param_sql);
+}
+
+TEST_F(ObRawSqlCacheTest, key_invalidation)
+{
+  ObRawSqlCache cache;
+  const ObString raw_sql("select c1 from t1 order by c1");
+  const ObString param_sql("select c1 from t1 order by c1");
+  ASSERT_EQ(OB_SUCCESS, cache.put(key_, raw_sql, param_sql));
+  check_hit(cache, key_, raw_sql, param_sql);
+
+  ObRawSqlCacheKey key = key_;
+  key.sql_mode_ = key_.sql_mode_ | SMO_ANSI_QUOTES;
+  check_miss(cache, key, raw_sql);
+  key = key_;
+  key.conn_coll_ = CS_TYPE_BINARY;
+  check_miss(cache, key, raw_sql);
+  key = key_;
+  key.tenant_id_ = key_.tenant_id_ + 1;
+  check_miss(cache, key, raw_sql);
+  key = key_;
+  key.is_oracle_mode_ = true;
+  check_miss(cache, key, raw_sql);
+  key = key_;
+  key.enable_batched_multi_stmt_ = true;
+  check_miss(cache, key, raw_sql);
+  key = key_;
+  key.enable_fast_parser_ = false;
+  check_miss(cache, key, raw_sql);
+
+  // the flags which are not hashed share the slot, the later put wins
+  key = key_;
+  key.enable_fast_parser_ = false;
+  ASSERT_EQ(slot_of(key_, raw_sql), slot_of(key, raw_sql));
+  ASSERT_EQ(OB_SUCCESS, cache.put(key, raw_sql, param_sql));
+  check_hit(cache, key, raw_sql, param_sql);
+  check_miss(cache, key_, raw_sql);
+  key_ = key;
+  check_hit(cache, key_, raw_sql, param_sql);
+}
+
+TEST_F(ObRawSqlCacheTest, slot_conflict)
+{
+  ObRawSqlCache cache;
+  char first_buf[64];
+  char second_buf[64];
+  const int64_t first_len = snprintf(first_buf, sizeof(first_buf), "select 0");
+  const ObString first(first_len, first_buf);
+  const int64_t slot = slot_of(key_, first);
+  // find another statement of the same slot
+  ObString second;
+  for (int64_t i = 1; second.empty() && i < 100 * ObRawSqlCache::SLOT_CNT; ++i) {
+    const int64_t len = snprintf(second_buf, sizeof(second_buf), "select %ld", i);
+    if (slot == slot_of(key_, ObString(len, second_buf))) {
+      second.assign_ptr(second_buf, static_cast<int32_t>(len));
+    }
+  }
+  ASSERT_FALSE(second.empty());
+  ASSERT_EQ(OB_SUCCESS, cache.put(key_, first, first));
+  check_hit(cache, key_, first, first);
+  ASSERT_EQ(OB_SUCCESS, cache.put(key_, second, second));
+  check_hit(cache, key_, second, second);
+  check_miss(cache, key_, first);
+}
+
+TEST_F(ObRawSqlCacheTest, too_long)
+{
+  ObRawSqlCache cache;
+  ObArenaAllocator allocator(ObModIds::TEST);
+  char *buf = static_cast<char *>(allocator.alloc(ObRawSqlCache::MAX_RAW_SQL_LEN + 1));
+  ASSERT_TRUE(NULL != buf);
+  MEMSET(buf, ' ', ObRawSqlCache::MAX_RAW_SQL_LEN + 1);
+  MEMCPY(buf, "select 1", 8);
+  const ObString max_sql(ObRawSqlCache::MAX_RAW_SQL_LEN, buf);
+  const ObString long_sql(ObRawSqlCache::MAX_RAW_SQL_LEN + 1, buf);
+  const int64_t total_size = ObRawSqlCache::total_size_;
+  ASSERT_EQ(OB_SUCCESS, cache.put(key_, long_sql, ObString("select ?")));
+  check_miss(cache, key_, long_sql);
+  ASSERT_EQ(OB_SUCCESS, cache.put(key_, ObString("select 1"), long_sql));
+  check_miss(cache, key_, ObString("select 1"));
+  ASSERT_EQ(total_size, ObRawSqlCache::total_size_);
+  ASSERT_EQ(OB_SUCCESS, cache.put(key_, max_sql, max_sql));
+  check_hit(cache, key_, max_sql, max_sql);
+}
+
+TEST_F(ObRawSqlCacheTest, size_cap)
+{
+  const int64_t total_size = ObRawSqlCache::total_size_;
+  const ObString first("select 1");
+  const ObString second("select 22");
+  {
+    ObRawSqlCache cache;
+    ASSERT_EQ(OB_SUCCESS, cache.put(key_, first, first));
+    ASSERT_EQ(total_size + 2 * first.length(), ObRawSqlCache::total_size_);
+    // the memory of all the caches is capped, a put which would exceed it is dropped
+    ObRawSqlCache::total_size_ = ObRawSqlCache::MAX_TOTAL_SIZE - 1;
+    ASSERT_EQ(OB_SUCCESS, cache.put(key_, second, second));
+    check_miss(cache, key_, second);
+    ASSERT_EQ(ObRawSqlCache::MAX_TOTAL_SIZE - 1, ObRawSqlCache::total_size_);
+    check_hit(cache, key_, first, first);
+    // a slot large enough is reused without more memory
+    ASSERT_EQ(OB_SUCCESS, cache.put(key_, first, ObString("select ?")));
+    check_hit(cache, key_, first, ObString("select ?"));
+    ASSERT_EQ(ObRawSqlCache::MAX_TOTAL_SIZE - 1, ObRawSqlCache::total_size_);
+    ObRawSqlCache::total_size_ = total_size + 2 * first.length();
+    ASSERT_EQ(OB_SUCCESS, cache.put(key_, second, second));
+    check_hit(cache, key_, second, second);
+  }
+  // the memory goes back with the cache
+  ASSERT_EQ(total_size, ObRawSqlCache::total_size_);
+}
+
+int main(int argc, char **argv)
+{
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
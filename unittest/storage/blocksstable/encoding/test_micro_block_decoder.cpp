@@ -209,6 +209,46 @@ TEST_F(TestMicroBlockDecoder, read)
   }
 }
 
+TEST_F(TestMicroBlockDecoder, cache_all_decoders)
+{
+  const char *block = encoder_.get_data().data();
+  const int64_t block_size = encoder_.get_data().pos();
+  int64_t default_size = 0;
+  int64_t all_size = 0;
+  int64_t cached_cnt = 0;
+  ASSERT_EQ(OB_SUCCESS, ObMicroBlockDecoder::get_decoder_cache_size(block, block_size, default_size));
+  ASSERT_EQ(OB_SUCCESS, ObMicroBlockDecoder::get_decoder_cache_size(block, block_size, all_size,
+      ObMicroBlockDecoder::MAX_DECODED_BLOCK_BUF_SIZE));
+  ASSERT_LE(default_size, ObMicroBlockDecoder::MAX_CACHED_DECODER_BUF_SIZE);
+  ASSERT_LT(default_size, all_size);
+
+  char *default_buf = static_cast<char *>(allocator_.alloc(default_size));
+  char *all_buf = static_cast<char *>(allocator_.alloc(all_size));
+  ASSERT_EQ(OB_SUCCESS, ObMicroBlockDecoder::cache_decoders(default_buf, default_size, block, block_size));
+  ASSERT_EQ(OB_SUCCESS, ObMicroBlockDecoder::get_cached_decoder_count(default_buf, default_size, cached_cnt));
+  ASSERT_LT(cached_cnt, COLUMN_CNT);
+  ASSERT_EQ(OB_SUCCESS, ObMicroBlockDecoder::cache_decoders(all_buf, all_size, block, block_size));
+  ASSERT_EQ(OB_SUCCESS, ObMicroBlockDecoder::get_cached_decoder_count(all_buf, all_size, cached_cnt));
+  ASSERT_EQ(COLUMN_CNT, cached_cnt);
+
+  // rows decoded with the decoders of all columns cached equal the ones decoded from scratch
+  ObMicroBlockDecoder decoder;
+  ObMicroBlockDecoder cached_decoder;
+  ObMicroBlockData data(block, block_size);
+  ObMicroBlockData cached_data(block, block_size, all_buf, all_size);
+  ASSERT_EQ(OB_SUCCESS, decoder.init(data, read_info_));
+  ASSERT_EQ(OB_SUCCESS, cached_decoder.init(cached_data, read_info_));
+  ObDatumRow row;
+  ObDatumRow cached_row;
+  ASSERT_EQ(OB_SUCCESS, row.init(allocator_, COLUMN_CNT));
+  ASSERT_EQ(OB_SUCCESS, cached_row.init(allocator_, COLUMN_CNT));
+  for (int64_t i = 0; i < ROW_CNT; ++i) {
+    ASSERT_EQ(OB_SUCCESS, decoder.get_row(i, row));
+    ASSERT_EQ(OB_SUCCESS, cached_decoder.get_row(i, cached_row));
+    ASSERT_TRUE(row == cached_row) << "\n index: " << i;
+  }
+}
+
 } // end namespace blocksstable
 } // end namespace oceanbase
 
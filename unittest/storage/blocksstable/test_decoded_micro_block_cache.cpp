@@ -0,0 +1,97 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#define private public
+#include "storage/blocksstable/ob_micro_block_cache.h"
+#undef private
+
+namespace oceanbase
+{
+using namespace common;
+
+namespace blocksstable
+{
+
+class TestDecodedMicroBlockCache : public ::testing::Test
+{
+public:
+  virtual void SetUp() {}
+  virtual void TearDown() {}
+};
+
+TEST_F(TestDecodedMicroBlockCache, key)
+{
+  MacroBlockId macro_id(0, 1001, 0);
+  ObMicroBlockCacheKey block_key(1, macro_id, 4096, 512);
+  ObMicroBlockCacheKey other_block_key(1, macro_id, 8192, 512);
+  ObKVCacheHandle handle;
+
+  // a block not pinned in block cache has no copy to key the decoders on
+  ObDecodedMicroBlockCacheKey invalid_key(block_key, handle);
+  ASSERT_FALSE(invalid_key.is_valid());
+  char buf[sizeof(ObDecodedMicroBlockCacheKey)];
+  ObIKVCacheKey *copied = nullptr;
+  ASSERT_EQ(OB_INVALID_DATA, invalid_key.deep_copy(buf, sizeof(buf), copied));
+
+  ObDecodedMicroBlockCacheKey key(block_key, handle);
+  key.mb_id_ = 0x1000;
+  key.mb_seq_num_ = 1;
+  ASSERT_TRUE(key.is_valid());
+  ASSERT_EQ(1UL, key.get_tenant_id());
+  ASSERT_EQ(OB_INVALID_ARGUMENT, key.deep_copy(buf, sizeof(buf) - 1, copied));
+  ASSERT_EQ(OB_SUCCESS, key.deep_copy(buf, sizeof(buf), copied));
+  ASSERT_TRUE(key == *copied);
+  ASSERT_EQ(key.hash(), copied->hash());
+
+  // the same block in a reused memory block or in another memory block is another copy
+  ObDecodedMicroBlockCacheKey reused_key(block_key, handle);
+  reused_key.mb_id_ = 0x1000;
+  reused_key.mb_seq_num_ = 2;
+  ASSERT_FALSE(key == reused_key);
+  ObDecodedMicroBlockCacheKey moved_key(block_key, handle);
+  moved_key.mb_id_ = 0x2000;
+  moved_key.mb_seq_num_ = 1;
+  ASSERT_FALSE(key == moved_key);
+  ObDecodedMicroBlockCacheKey other_key(other_block_key, handle);
+  other_key.mb_id_ = 0x1000;
+  other_key.mb_seq_num_ = 1;
+  ASSERT_FALSE(key == other_key);
+}
+
+TEST_F(TestDecodedMicroBlockCache, admit_cached_block_only)
+{
+  ObDecodedMicroBlockCache cache;
+  MacroBlockId macro_id(0, 1001, 0);
+  ObMicroBlockCacheKey block_key(1, macro_id, 4096, 512);
+  ObMicroBlockBufferHandle block_handle;
+  char block_buf[512];
+  char extra_buf[64];
+  ObMicroBlockData block_data(block_buf, sizeof(block_buf), extra_buf, sizeof(extra_buf));
+  ObKVCacheHandle handle;
+
+  // a block read by io is not in block cache, the decoders cached with it are kept
+  ASSERT_EQ(OB_SUCCESS, cache.get_decoders(block_key, block_handle, block_data, handle));
+  ASSERT_FALSE(handle.is_valid());
+  ASSERT_EQ(extra_buf, block_data.get_extra_buf());
+  ASSERT_EQ(static_cast<int64_t>(sizeof(extra_buf)), block_data.get_extra_size());
+}
+
+}//namespace blocksstable
+}//namespace oceanbase
+
+int main(int argc, char** argv)
+{
+  OB_LOGGER.set_log_level("WARN");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
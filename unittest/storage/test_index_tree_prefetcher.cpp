@@ -0,0 +1,177 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#define private public
+#define protected public
+#include "storage/access/ob_index_tree_prefetcher.h"
+#undef private
+#undef protected
+
+namespace oceanbase
+{
+using namespace common;
+using namespace blocksstable;
+
+namespace storage
+{
+
+class CountingAllocator : public ObIAllocator
+{
+public:
+  CountingAllocator() : alloc_cnt_(0), free_cnt_(0) {}
+  virtual void *alloc(const int64_t size) override { return alloc(size, ObMemAttr()); }
+  virtual void *alloc(const int64_t size, const ObMemAttr &attr) override
+  {
+    ++alloc_cnt_;
+    return ob_malloc(size, attr);
+  }
+  virtual void free(void *ptr) override
+  {
+    ++free_cnt_;
+    ob_free(ptr);
+  }
+  int64_t alloc_cnt_;
+  int64_t free_cnt_;
+};
+
+class TestIndexTreePrefetcher : public ::testing::Test
+{
+public:
+  virtual void SetUp() {}
+  virtual void TearDown() {}
+
+  static void make_io_handle(const int64_t block_seq, const int32_t offset, const int32_t size,
+                             ObMicroBlockDataHandle &handle)
+  {
+    handle.reset();
+    handle.tenant_id_ = 1;
+    handle.macro_block_id_ = MacroBlockId(0, block_seq, 0);
+    handle.micro_info_.set(offset, size);
+    handle.block_state_ = ObSSTableMicroBlockState::IN_BLOCK_IO;
+  }
+};
+
+TEST_F(TestIndexTreePrefetcher, share_io_not_loaded_block)
+{
+  CountingAllocator allocator;
+  ObMicroBlockDataHandle src;
+  ObMicroBlockDataHandle dst;
+  make_io_handle(1, 4096, 512, src);
+  src.encrypt_key_[0] = 'k';
+  src.allocator_ = &allocator;
+  char *buf = static_cast<char *>(allocator.alloc(512));
+  ASSERT_TRUE(nullptr != buf);
+  src.loaded_index_block_data_ = ObMicroBlockData(buf, 512);
+  src.is_loaded_index_block_ = true;
+
+  dst.share_io(src);
+  ASSERT_EQ(ObSSTableMicroBlockState::IN_BLOCK_IO, dst.block_state_);
+  ASSERT_EQ(src.macro_block_id_, dst.macro_block_id_);
+  ASSERT_EQ(4096, dst.micro_info_.offset_);
+  ASSERT_EQ(512, dst.micro_info_.size_);
+  ASSERT_EQ('k', dst.encrypt_key_[0]);
+  // the key is copied, not referred to
+  ASSERT_EQ(dst.encrypt_key_, dst.des_meta_.encrypt_key_);
+  // the block loaded by the source stays with the source
+  ASSERT_FALSE(dst.is_loaded_index_block_);
+  ASSERT_FALSE(dst.loaded_index_block_data_.is_valid());
+  dst.reset();
+  ASSERT_EQ(0, allocator.free_cnt_);
+  src.reset();
+  ASSERT_EQ(1, allocator.free_cnt_);
+  // sharing with itself keeps the handle
+  make_io_handle(1, 4096, 512, src);
+  src.share_io(src);
+  ASSERT_EQ(ObSSTableMicroBlockState::IN_BLOCK_IO, src.block_state_);
+}
+
+TEST_F(TestIndexTreePrefetcher, multi_get_share_inflight)
+{
+  ObInflightIndexBlockHandles inflight;
+  ObMicroBlockDataHandle submitted;
+  ObMicroBlockDataHandle shared;
+  ASSERT_EQ(0, inflight.count());
+  ASSERT_FALSE(inflight.share(1, MacroBlockId(0, 1, 0), 4096, 512, shared));
+
+  // rowkey 0 submits the io, rowkey 1 reaching the same block shares it
+  make_io_handle(1, 4096, 512, submitted);
+  inflight.add(0, submitted);
+  ASSERT_EQ(1, inflight.count());
+  ASSERT_TRUE(inflight.share(1, MacroBlockId(0, 1, 0), 4096, 512, shared));
+  ASSERT_EQ(ObSSTableMicroBlockState::IN_BLOCK_IO, shared.block_state_);
+  // another block, another tenant or another micro block of the macro block is not shared
+  ASSERT_FALSE(inflight.share(1, MacroBlockId(0, 2, 0), 4096, 512, shared));
+  ASSERT_FALSE(inflight.share(2, MacroBlockId(0, 1, 0), 4096, 512, shared));
+  ASSERT_FALSE(inflight.share(1, MacroBlockId(0, 1, 0), 8192, 512, shared));
+  ASSERT_FALSE(inflight.share(1, MacroBlockId(0, 1, 0), 4096, 256, shared));
+
+  // the block is dropped once rowkey 0 has been fetched
+  inflight.release_fetched(0);
+  ASSERT_EQ(1, inflight.count());
+  inflight.release_fetched(1);
+  ASSERT_EQ(0, inflight.count());
+  ASSERT_FALSE(inflight.share(1, MacroBlockId(0, 1, 0), 4096, 512, shared));
+}
+
+TEST_F(TestIndexTreePrefetcher, multi_get_bounded)
+{
+  ObInflightIndexBlockHandles inflight;
+  ObMicroBlockDataHandle submitted;
+  ObMicroBlockDataHandle shared;
+  const int64_t block_cnt = ObInflightIndexBlockHandles::MAX_INFLIGHT_CNT * 4;
+  for (int64_t i = 0; i < block_cnt; ++i) {
+    make_io_handle(i + 1, 4096, 512, submitted);
+    inflight.add(i, submitted);
+    ASSERT_LE(inflight.count(), ObInflightIndexBlockHandles::MAX_INFLIGHT_CNT);
+  }
+  ASSERT_EQ(ObInflightIndexBlockHandles::MAX_INFLIGHT_CNT, inflight.count());
+  // the oldest ios are no longer shared, the latest are
+  ASSERT_FALSE(inflight.share(1, MacroBlockId(0, 1, 0), 4096, 512, shared));
+  ASSERT_TRUE(inflight.share(1, MacroBlockId(0, block_cnt, 0), 4096, 512, shared));
+  inflight.release_fetched(block_cnt - 1);
+  ASSERT_EQ(1, inflight.count());
+}
+
+TEST_F(TestIndexTreePrefetcher, rescan_reuse)
+{
+  ObIndexTreeMultiPrefetcher prefetcher;
+  ObMicroBlockDataHandle submitted;
+  ObMicroBlockDataHandle shared;
+  for (int64_t i = 0; i < 4; ++i) {
+    make_io_handle(i + 1, 4096, 512, submitted);
+    prefetcher.inflight_index_handles_.add(i, submitted);
+  }
+  ASSERT_EQ(4, prefetcher.inflight_index_handles_.count());
+  // a reused prefetcher holds no io of the previous get
+  prefetcher.reuse();
+  ASSERT_EQ(0, prefetcher.inflight_index_handles_.count());
+  ASSERT_FALSE(prefetcher.inflight_index_handles_.share(1, MacroBlockId(0, 1, 0), 4096, 512, shared));
+
+  make_io_handle(1, 4096, 512, submitted);
+  prefetcher.inflight_index_handles_.add(0, submitted);
+  prefetcher.reset();
+  ASSERT_EQ(0, prefetcher.inflight_index_handles_.count());
+  ASSERT_EQ(0, prefetcher.inflight_index_handles_.next_idx_);
+}
+
+} // end namespace storage
+} // end namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_index_tree_prefetcher.log*");
+  OB_LOGGER.set_file_name("test_index_tree_prefetcher.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
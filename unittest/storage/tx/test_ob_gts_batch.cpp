@@ -0,0 +1,170 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#define private public
+#include "storage/tx/ob_gts_rpc.h"
+#include "storage/tx/ob_gts_msg.h"
+#undef private
+#include "share/ob_errno.h"
+#include "lib/oblog/ob_log.h"
+#include "lib/net/ob_addr.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace transaction;
+using namespace obrpc;
+namespace unittest
+{
+
+class TestObGtsBatch : public ::testing::Test
+{
+public :
+  virtual void SetUp() {}
+  virtual void TearDown() {}
+
+  static ObAddr addr(const int32_t port) { return ObAddr(ObAddr::IPV4, "127.0.0.1", port); }
+
+  static void make_request(const uint64_t tenant_id, ObGtsRequest &request)
+  {
+    ASSERT_EQ(OB_SUCCESS, request.init(tenant_id, MonotonicTs(1000 + tenant_id), 1, addr(8080)));
+  }
+};
+
+TEST_F(TestObGtsBatch, batch_request_serialize)
+{
+  ObGtsBatchRequest batch;
+  ASSERT_FALSE(batch.is_valid());
+  for (uint64_t tenant_id = 1001; tenant_id <= 1003; ++tenant_id) {
+    ObGtsRequest request;
+    make_request(tenant_id, request);
+    ASSERT_EQ(OB_SUCCESS, batch.add_request(request));
+  }
+  ASSERT_TRUE(batch.is_valid());
+  char buf[1024];
+  int64_t pos = 0;
+  ASSERT_EQ(OB_SUCCESS, batch.serialize(buf, sizeof(buf), pos));
+  ASSERT_EQ(batch.get_serialize_size(), pos);
+  const int64_t data_len = pos;
+  pos = 0;
+  ObGtsBatchRequest decoded;
+  ASSERT_EQ(OB_SUCCESS, decoded.deserialize(buf, data_len, pos));
+  ASSERT_EQ(data_len, pos);
+  ASSERT_TRUE(decoded.is_valid());
+  ASSERT_EQ(3, decoded.count());
+  for (int64_t i = 0; i < decoded.count(); ++i) {
+    ASSERT_EQ(batch.at(i).get_tenant_id(), decoded.at(i).get_tenant_id());
+    ASSERT_EQ(batch.at(i).get_srr(), decoded.at(i).get_srr());
+    ASSERT_EQ(batch.at(i).get_sender(), decoded.at(i).get_sender());
+    ASSERT_EQ(batch.at(i).range_size_, decoded.at(i).range_size_);
+  }
+}
+
+TEST_F(TestObGtsBatch, batch_request_limit)
+{
+  ObGtsBatchRequest batch;
+  ObGtsRequest invalid;
+  ASSERT_EQ(OB_INVALID_ARGUMENT, batch.add_request(invalid));
+  for (int64_t i = 0; i < ObGtsBatchRequest::MAX_BATCH_COUNT; ++i) {
+    ObGtsRequest request;
+    make_request(1001 + i, request);
+    ASSERT_EQ(OB_SUCCESS, batch.add_request(request));
+  }
+  ASSERT_TRUE(batch.is_full());
+  ASSERT_TRUE(batch.is_valid());
+  ObGtsRequest request;
+  make_request(1001, request);
+  ASSERT_EQ(OB_SIZE_OVERFLOW, batch.add_request(request));
+  batch.reset();
+  ASSERT_EQ(0, batch.count());
+}
+
+TEST_F(TestObGtsBatch, batch_result_serialize)
+{
+  ObGtsBatchRpcResult result;
+  ObGtsRpcResult ok;
+  ObGtsRpcResult err;
+  ASSERT_EQ(OB_SUCCESS, ok.init(1001, OB_SUCCESS, MonotonicTs(100), 200, 300));
+  // a tenant that failed on the leader carries its own status
+  ASSERT_EQ(OB_SUCCESS, err.init(1002, OB_NOT_MASTER, MonotonicTs(100), 0, 0));
+  ASSERT_EQ(OB_SUCCESS, result.add_result(ok));
+  ASSERT_EQ(OB_SUCCESS, result.add_result(err));
+  char buf[1024];
+  int64_t pos = 0;
+  ASSERT_EQ(OB_SUCCESS, result.serialize(buf, sizeof(buf), pos));
+  ASSERT_EQ(result.get_serialize_size(), pos);
+  const int64_t data_len = pos;
+  pos = 0;
+  ObGtsBatchRpcResult decoded;
+  ASSERT_EQ(OB_SUCCESS, decoded.deserialize(buf, data_len, pos));
+  ASSERT_EQ(2, decoded.count());
+  ASSERT_EQ(1001, decoded.at(0).get_tenant_id());
+  ASSERT_EQ(OB_SUCCESS, decoded.at(0).get_status());
+  ASSERT_EQ(MonotonicTs(100), decoded.at(0).get_srr());
+  ASSERT_EQ(200, decoded.at(0).get_gts_start());
+  ASSERT_EQ(300, decoded.at(0).get_gts_end());
+  ASSERT_TRUE(decoded.at(0).is_valid());
+  ASSERT_EQ(1002, decoded.at(1).get_tenant_id());
+  ASSERT_EQ(OB_NOT_MASTER, decoded.at(1).get_status());
+  ASSERT_TRUE(decoded.at(1).is_valid());
+}
+
+TEST_F(TestObGtsBatch, group_by_server)
+{
+  ObGtsRequestRpc rpc;
+  bool added = false;
+  for (uint64_t tenant_id = 1001; tenant_id <= 1004; ++tenant_id) {
+    ObGtsRequest request;
+    make_request(tenant_id, request);
+    // two leaders
+    ASSERT_EQ(OB_SUCCESS, rpc.add_to_batch_(addr(2880 + tenant_id % 2), request, added));
+    ASSERT_TRUE(added);
+  }
+  ASSERT_EQ(2, rpc.pending_batch_cnt_);
+  ASSERT_EQ(2, rpc.pending_batches_[0].batch_.count());
+  ASSERT_EQ(2, rpc.pending_batches_[1].batch_.count());
+  ASSERT_NE(rpc.pending_batches_[0].server_, rpc.pending_batches_[1].server_);
+  // requests towards more servers than a round batches are sent alone
+  for (int64_t i = 2; i < ObGtsRequestRpc::MAX_BATCH_SERVER_COUNT; ++i) {
+    ObGtsRequest request;
+    make_request(1001, request);
+    ASSERT_EQ(OB_SUCCESS, rpc.add_to_batch_(addr(3000 + i), request, added));
+    ASSERT_TRUE(added);
+  }
+  ObGtsRequest request;
+  make_request(1001, request);
+  ASSERT_EQ(OB_SUCCESS, rpc.add_to_batch_(addr(4000), request, added));
+  ASSERT_FALSE(added);
+  ASSERT_EQ(ObGtsRequestRpc::MAX_BATCH_SERVER_COUNT, rpc.pending_batch_cnt_);
+  for (int64_t i = 0; i < rpc.pending_batch_cnt_; ++i) {
+    rpc.pending_batches_[i].batch_.reset();
+  }
+  rpc.pending_batch_cnt_ = 0;
+}
+
+}//end of unittest
+}//end of oceanbase
+
+using namespace oceanbase;
+using namespace oceanbase::common;
+
+int main(int argc, char **argv)
+{
+  int ret = 1;
+  ObLogger &logger = ObLogger::get_logger();
+  logger.set_file_name("test_ob_gts_batch.log", true);
+  logger.set_log_level(OB_LOG_LEVEL_INFO);
+  testing::InitGoogleTest(&argc, argv);
+  ret = RUN_ALL_TESTS();
+  return ret;
+}